@@ -20,36 +20,54 @@ limitations under the License.
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "common/log.h"
 #include "constants.h"
+#include "network/file_transfer.h"
 #include "trace_mgr.h"
 
 namespace Dive
 {
 
-absl::Status SendPong(Network::SocketConnection* client_conn)
+absl::Status SendPong(Network::SocketConnection* client_conn, uint32_t request_id)
 {
     Network::PongMessage response;
+    response.SetRequestId(request_id);
     return Network::SendSocketMessage(client_conn, response);
 }
 
 absl::Status Handshake(Network::HandshakeRequest* request, Network::SocketConnection* client_conn)
 {
-    Network::HandshakeResponse response;
-    response.SetMajorVersion(request->GetMajorVersion());
-    response.SetMinorVersion(request->GetMinorVersion());
-    return Network::SendSocketMessage(client_conn, response);
+    return Network::SendHandshakeResponse(*request, client_conn);
 }
 
-absl::Status StartPm4Capture(Network::SocketConnection* client_conn)
+namespace
+{
+// The server handles several clients, and several requests of a client, at the same time. A trace
+// manager only runs one trace at a time, so the captures are taken one after the other.
+std::mutex g_capture_mutex;
+}  // namespace
+
+absl::Status StartPm4Capture(Network::SocketConnection* client_conn, uint32_t request_id)
 {
-    GetTraceMgr().TriggerTrace();
-    GetTraceMgr().WaitForTraceDone();
-    std::string capture_file_path = GetTraceMgr().GetTraceFilePath();
+    return StartPm4Capture(GetTraceMgr(), client_conn, request_id);
+}
+
+absl::Status StartPm4Capture(TraceManager& trace_mgr, Network::SocketConnection* client_conn,
+                             uint32_t request_id)
+{
+    std::string capture_file_path;
+    {
+        std::lock_guard<std::mutex> lock(g_capture_mutex);
+        trace_mgr.TriggerTrace();
+        trace_mgr.WaitForTraceDone();
+        capture_file_path = trace_mgr.GetTraceFilePath();
+    }
 
     Network::Pm4CaptureResponse response;
+    response.SetRequestId(request_id);
     response.SetString(capture_file_path);
     return Network::SendSocketMessage(client_conn, response);
 }
@@ -57,38 +75,13 @@ absl::Status StartPm4Capture(Network::SocketConnection* client_conn)
 absl::Status DownloadFile(Network::DownloadFileRequest* request,
                           Network::SocketConnection* client_conn)
 {
-    Network::DownloadFileResponse response;
-    std::string file_path = request->GetString();
-
-    std::error_code ec;
-    auto file_size = std::filesystem::file_size(file_path, ec);
-    if (!ec)
-    {
-        response.SetFound(true);
-        response.SetFilePath(file_path);
-        response.SetFileSizeStr(std::to_string(file_size));
-    }
-    else
-    {
-        response.SetFound(false);
-        response.SetErrorReason(ec.message());
-    }
-
-    auto status = Network::SendSocketMessage(client_conn, response);
-    if (!status.ok())
-    {
-        return status;
-    }
-    if (!response.GetFound())
-    {
-        return absl::NotFoundError(response.GetErrorReason());
-    }
-    return client_conn->SendFile(file_path);
+    return Network::SendDownloadFileResponse(*request, client_conn);
 }
 
 absl::Status GetFileSize(Network::FileSizeRequest* request, Network::SocketConnection* client_conn)
 {
     Network::FileSizeResponse response;
+    response.SetRequestId(request->GetRequestId());
     std::string file_path = request->GetString();
 
     std::error_code ec;
@@ -96,7 +89,7 @@ absl::Status GetFileSize(Network::FileSizeRequest* request, Network::SocketConne
     if (!ec)
     {
         response.SetFound(true);
-        response.SetFileSizeStr(std::to_string(file_size));
+        response.SetFileSize(file_size);
     }
     else
     {
@@ -129,7 +122,7 @@ void ServerMessageHandler::HandleMessage(std::unique_ptr<Network::ISerializable>
         case Network::MessageType::PING_MESSAGE:
         {
             LOGI("Message received: Ping");
-            auto status = SendPong(client_conn);
+            auto status = SendPong(client_conn, message->GetRequestId());
             if (!status.ok())
             {
                 LOGI("Send pong failed: %.*s", (int)status.message().length(),
@@ -159,7 +152,7 @@ void ServerMessageHandler::HandleMessage(std::unique_ptr<Network::ISerializable>
         case Network::MessageType::PM4_CAPTURE_REQUEST:
         {
             LOGI("Message received: Pm4CaptureRequest");
-            auto status = StartPm4Capture(client_conn);
+            auto status = StartPm4Capture(client_conn, message->GetRequestId());
             if (!status.ok())
             {
                 LOGI("StartPm4Capture failed: %.*s", (int)status.message().length(),
@@ -205,6 +198,44 @@ void ServerMessageHandler::HandleMessage(std::unique_ptr<Network::ISerializable>
             }
             break;
         }
+        case Network::MessageType::DOWNLOAD_FILE_RANGE_REQUEST:
+        {
+            LOGI("Message received: DownloadFileRangeRequest");
+            auto* request = dynamic_cast<Network::DownloadFileRangeRequest*>(message.get());
+            if (request)
+            {
+                auto status = Network::SendFileRangeResponse(*request, client_conn);
+                if (!status.ok())
+                {
+                    LOGI("DownloadFileRange failed: %.*s", (int)status.message().length(),
+                         status.message().data());
+                }
+            }
+            else
+            {
+                LOGI("DownloadFileRangeRequest message is null.");
+            }
+            break;
+        }
+        case Network::MessageType::FILE_CHECKSUM_REQUEST:
+        {
+            LOGI("Message received: FileChecksumRequest");
+            auto* request = dynamic_cast<Network::FileChecksumRequest*>(message.get());
+            if (request)
+            {
+                auto status = Network::SendFileChecksumResponse(*request, client_conn);
+                if (!status.ok())
+                {
+                    LOGI("FileChecksum failed: %.*s", (int)status.message().length(),
+                         status.message().data());
+                }
+            }
+            else
+            {
+                LOGI("FileChecksumRequest message is null.");
+            }
+            break;
+        }
         default:
         {
             LOGW("Message type %d unhandled.", (int)message->GetMessageType());
@@ -22,11 +22,17 @@ limitations under the License.
 namespace Dive
 {
 
-absl::Status SendPong(Network::SocketConnection* client_conn);
+class TraceManager;
+
+absl::Status SendPong(Network::SocketConnection* client_conn, uint32_t request_id);
 
 absl::Status Handshake(Network::HandshakeRequest* request, Network::SocketConnection* client_conn);
 
-absl::Status StartPm4Capture(Network::SocketConnection* client_conn);
+absl::Status StartPm4Capture(Network::SocketConnection* client_conn, uint32_t request_id);
+// Captures with trace_mgr rather than with GetTraceMgr(). Captures requested at the same time are
+// taken one after the other, whichever trace manager they use.
+absl::Status StartPm4Capture(TraceManager& trace_mgr, Network::SocketConnection* client_conn,
+                             uint32_t request_id);
 
 absl::Status DownloadFile(Network::DownloadFileRequest* request,
                           Network::SocketConnection* client_conn);
@@ -0,0 +1,117 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "service.h"
+
+#include <sys/socket.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "network/messages.h"
+#include "network/socket_connection.h"
+#include "trace_mgr.h"
+
+namespace Dive
+{
+namespace
+{
+
+// Takes a while to trace, and fails the test if two traces overlap
+class SlowTraceManager : public TraceManager
+{
+ public:
+    void TriggerTrace() override
+    {
+        int active = ++m_active_traces;
+        EXPECT_EQ(active, 1);
+        SetTraceFilePath("trace-" + std::to_string(++m_num_traces) + ".rd");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    void WaitForTraceDone() override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        --m_active_traces;
+    }
+
+ private:
+    std::atomic<int> m_active_traces = 0;
+    int m_num_traces = 0;
+};
+
+TEST(StartPm4CaptureTest, ConcurrentRequestsGetTheirOwnCapture)
+{
+    constexpr int kNumClients = 2;
+    SlowTraceManager trace_mgr;
+    std::vector<std::unique_ptr<Network::SocketConnection>> server_conns;
+    std::vector<std::unique_ptr<Network::SocketConnection>> client_conns;
+    for (int i = 0; i < kNumClients; ++i)
+    {
+        int fds[2];
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+        auto server_conn = Network::SocketConnection::Create(fds[0]);
+        auto client_conn = Network::SocketConnection::Create(fds[1]);
+        ASSERT_TRUE(server_conn.ok());
+        ASSERT_TRUE(client_conn.ok());
+        server_conns.push_back(*std::move(server_conn));
+        client_conns.push_back(*std::move(client_conn));
+    }
+
+    // As the server would, one thread per client
+    std::vector<absl::Status> statuses(kNumClients);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumClients; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            statuses[i] = StartPm4Capture(trace_mgr, server_conns[i].get(), i + 1);
+        });
+    }
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < kNumClients; ++i)
+    {
+        auto message = Network::ReceiveSocketMessage(client_conns[i].get());
+        ASSERT_TRUE(message.ok()) << message.status();
+        auto* response = dynamic_cast<Network::Pm4CaptureResponse*>(message->get());
+        ASSERT_NE(response, nullptr);
+        EXPECT_EQ(response->GetRequestId(), static_cast<uint32_t>(i + 1));
+        paths.push_back(response->GetString());
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    for (const absl::Status& status : statuses)
+    {
+        EXPECT_TRUE(status.ok()) << status;
+    }
+
+    // Each client gets the path of the capture taken for it
+    EXPECT_NE(paths[0], paths[1]);
+    for (const std::string& path : paths)
+    {
+        EXPECT_TRUE(path == "trace-1.rd" || path == "trace-2.rd") << path;
+    }
+}
+
+}  // namespace
+}  // namespace Dive
@@ -52,6 +52,11 @@ std::string AvailableGpuTiming::GetObjectTypeString(ObjectType object_type) cons
             ss << "RenderPass";
             break;
         }
+        case ObjectType::kDraw:
+        {
+            ss << "Draw";
+            break;
+        }
         default:
         {
             std::cerr << "GetObjectTypeString() failed, object_type OOB: "
@@ -77,6 +82,10 @@ AvailableGpuTiming::ObjectType AvailableGpuTiming::GetObjectType(
     {
         return ObjectType::kRenderPass;
     }
+    else if (object_type_str == "Draw")
+    {
+        return ObjectType::kDraw;
+    }
 
     // Unrecognized object_type_str
     return ObjectType::nObjectTypes;
@@ -287,6 +296,17 @@ bool AvailableGpuTiming::LoadLine(uint32_t row, const std::string& line)
         return false;
     }
 
+    if (object_type == ObjectType::kCommandBuffer)
+    {
+        const std::vector<Stats>& draw_stats = m_stats[static_cast<uint8_t>(ObjectType::kDraw)];
+        m_command_buffer_first_draw_ids.push_back(static_cast<uint32_t>(draw_stats.size()));
+    }
+    else if ((object_type == ObjectType::kDraw) && m_command_buffer_first_draw_ids.empty())
+    {
+        std::cerr << "Draw on row (" << row << ") is not within a command buffer" << std::endl;
+        return false;
+    }
+
     m_stats[index].push_back(stats);
     m_ordered_entries.push_back(entry);
 
@@ -367,6 +387,41 @@ std::optional<AvailableGpuTiming::Stats> AvailableGpuTiming::GetStatsByRow(uint3
     return AvailableGpuTiming::GetStatsByType(entry.object_type, entry.per_frame_id);
 }
 
+std::optional<AvailableGpuTiming::Stats> AvailableGpuTiming::GetDrawStats(
+    uint32_t command_buffer_id, uint32_t draw_index) const
+{
+    if (!m_valid)
+    {
+        std::cerr << "Invalid AvailableGpuTiming object" << std::endl;
+        return std::nullopt;
+    }
+
+    if (command_buffer_id >= m_command_buffer_first_draw_ids.size())
+    {
+        std::cerr << "Out of bounds command_buffer_id: " << command_buffer_id << std::endl;
+        return std::nullopt;
+    }
+
+    const std::vector<Stats>& draw_stats = m_stats[static_cast<uint8_t>(ObjectType::kDraw)];
+    uint32_t first_draw_id = m_command_buffer_first_draw_ids[command_buffer_id];
+    uint32_t end_draw_id = (command_buffer_id + 1 < m_command_buffer_first_draw_ids.size())
+                               ? m_command_buffer_first_draw_ids[command_buffer_id + 1]
+                               : static_cast<uint32_t>(draw_stats.size());
+    if (draw_index >= end_draw_id - first_draw_id)
+    {
+        std::cerr << "Command buffer (" << command_buffer_id << ") does not contain draw ("
+                  << draw_index << ")" << std::endl;
+        return std::nullopt;
+    }
+
+    return draw_stats[first_draw_id + draw_index];
+}
+
+bool AvailableGpuTiming::HasDrawStats() const
+{
+    return m_valid && !m_stats[static_cast<uint8_t>(ObjectType::kDraw)].empty();
+}
+
 std::string AvailableGpuTiming::GetColumnHeader(int col) const
 {
     if ((col < 0) || (col >= static_cast<int>(ColumnType::nColumnTypes)))
@@ -47,7 +47,8 @@ class AvailableGpuTiming
         kFrame = 0,
         kCommandBuffer = 1,
         kRenderPass = 2,
-        nObjectTypes = 3,  // Also used for invalid ObjectTypes
+        kDraw = 3,         // Draws and dispatches, only present if GPUTime draw timing is enabled
+        nObjectTypes = 4,  // Also used for invalid ObjectTypes
     };
 
     // Columns expected in the .csv file
@@ -94,6 +95,14 @@ class AvailableGpuTiming
     // Get the statistic info with the row_id (representing the row in file order, header is row 0)
     std::optional<Stats> GetStatsByRow(uint32_t row_id) const;
 
+    // Get the statistic info of the draw_index-th draw (or dispatch) within the
+    // command_buffer_id-th command buffer of the frame, which is how PerfMetricsKey identifies
+    // draws
+    std::optional<Stats> GetDrawStats(uint32_t command_buffer_id, uint32_t draw_index) const;
+
+    // If true, there are rows for draws following their command buffer
+    bool HasDrawStats() const;
+
     // Validate entries to stats counts
     bool IsValid() const { return m_valid; }
 
@@ -135,6 +144,9 @@ class AvailableGpuTiming
     // Statistics from file, indexed by ObjectType
     std::vector<std::vector<Stats>> m_stats = {};
 
+    // Id of the first draw of each command buffer, draws follow their command buffer in the file
+    std::vector<uint32_t> m_command_buffer_first_draw_ids = {};
+
     uint32_t m_total_frames = 0;  // The number of frames the statistics were collected from
     bool m_loaded = false;        // If true, prevent further loading
     bool m_valid = false;         // Validated at loading time
@@ -0,0 +1,75 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "cache_directory.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+void TouchCacheFile(const std::string& file_name)
+{
+    std::error_code ec;
+    std::filesystem::last_write_time(file_name, std::filesystem::file_time_type::clock::now(), ec);
+}
+
+//--------------------------------------------------------------------------------------------------
+void PruneCacheDirectory(const std::string& dir, uint64_t max_size,
+                         const std::string& keep_file_name)
+{
+    struct CacheFile
+    {
+        std::filesystem::path m_path;
+        std::filesystem::file_time_type m_write_time;
+        uint64_t m_size;
+    };
+
+    std::error_code ec;
+    std::filesystem::path keep_path;
+    if (!keep_file_name.empty()) keep_path = std::filesystem::absolute(keep_file_name, ec);
+
+    std::vector<CacheFile> files;
+    uint64_t total_size = 0;
+    for (std::filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec))
+    {
+        if (!it->is_regular_file(ec)) continue;
+        uint64_t size = it->file_size(ec);
+        if (ec) continue;
+        total_size += size;
+
+        if (it->path().extension() == ".tmp") continue;
+        if (!keep_path.empty() && std::filesystem::absolute(it->path(), ec) == keep_path) continue;
+        auto write_time = it->last_write_time(ec);
+        if (ec) continue;
+        files.push_back({ it->path(), write_time, size });
+    }
+    if (total_size <= max_size) return;
+
+    std::sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b) {
+        return a.m_write_time < b.m_write_time;
+    });
+    for (const CacheFile& file : files)
+    {
+        if (total_size <= max_size) break;
+        if (std::filesystem::remove(file.m_path, ec)) total_size -= file.m_size;
+    }
+}
+
+}  // namespace Dive
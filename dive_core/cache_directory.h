@@ -0,0 +1,38 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+// Helpers for the on-disk caches, which are directories of files that can be deleted at any time.
+// A file's modification time is its last use, so the least recently used files go first
+
+// Mark the file as just used
+void TouchCacheFile(const std::string& file_name);
+
+// Delete the least recently used files in dir until the rest add up to at most max_size bytes.
+// Temporary files (".tmp") are skipped, since another process may still be writing them, and so
+// is keep_file_name, if given. Errors are ignored: a file that can't be deleted is just counted
+void PruneCacheDirectory(const std::string& dir, uint64_t max_size,
+                         const std::string& keep_file_name = "");
+
+}  // namespace Dive
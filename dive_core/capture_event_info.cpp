@@ -61,7 +61,7 @@ SyncType GetSyncType(const IMemoryManager& mem_manager, uint32_t submit_index, u
 
         if (packet.bitfields0.EVENT == vgt_event_type::CCU_RESOLVE)
         {
-            uint32_t rb_resolve_operation_offset = GetRegOffsetByName("RB_RESOLVE_OPERATION");
+            uint32_t rb_resolve_operation_offset = GetRegOffset(HotReg::RB_RESOLVE_OPERATION);
             if (state_tracker.IsRegSet(rb_resolve_operation_offset))
             {
                 RB_RESOLVE_OPERATION rb_resolve_operation;
@@ -0,0 +1,670 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "capture_index.h"
+
+#include <string.h>  // memcpy
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "data_core.h"
+#include "pm4_capture_data.h"
+#include "pm4_info.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+constexpr char kIndexMagic[8] = { 'D', 'I', 'V', 'E', 'I', 'D', 'X', '\0' };
+
+// Bump whenever anything written by CaptureIndex::Save() changes
+constexpr uint32_t kIndexVersion = 4;
+
+// Arrays in the file start at multiples of this, so they could be used in place
+constexpr uint64_t kIndexAlignment = 8;
+
+// Index of a RegInfo/PacketInfo in the tables written to the file, for descriptions without one
+constexpr uint32_t kNoInfo = UINT32_MAX;
+
+// Captures up to this size are hashed completely. Of larger ones only evenly spaced samples are,
+// since hashing several GB on every open would take about as long as processing the capture
+constexpr uint64_t kFullHashMaxSize = 16 << 20;
+constexpr uint64_t kNumHashSamples = 256;
+constexpr uint64_t kHashSampleSize = 64 << 10;
+
+// What identifies the contents of a capture file. A sampled hash on its own could miss changes in
+// between the samples, but not together with the modification time
+struct CaptureFileIdentity
+{
+    uint64_t m_size;
+    uint64_t m_mtime;
+    uint64_t m_hash;
+};
+
+struct IndexHeader
+{
+    char m_magic[8];
+    uint32_t m_version;
+    uint32_t m_reserved;
+    CaptureFileIdentity m_capture_identity;
+};
+
+// CommandHierarchy::Description, with the RegInfo/PacketInfo pointer replaced by an index into the
+// tables of register/packet names written to the file
+struct IndexDescription
+{
+    uint8_t m_type;
+    uint8_t m_reserved;
+    uint16_t m_field;
+    uint32_t m_data;
+    uint64_t m_value;
+    uint32_t m_info;
+    uint32_t m_reserved2;
+};
+
+struct IndexEventInfo
+{
+    uint32_t m_num_indices;
+    uint32_t m_submit_index;
+    uint8_t m_type;
+    uint8_t m_render_mode;
+    uint16_t m_reserved;
+    uint32_t m_reserved2;
+};
+
+struct IndexShader
+{
+    uint64_t m_address;
+    uint32_t m_submit_index;
+    // Event whose metadata log the shader's disassembly logs to, or UINT32_MAX
+    uint32_t m_log_event_index;
+};
+
+//--------------------------------------------------------------------------------------------------
+uint64_t HashCaptureFile(const MappedFile& file)
+{
+    uint64_t result = 0xcbf29ce484222325ull;
+    auto hash_range = [&](uint64_t offset, uint64_t size) {
+        std::string_view range((const char*)file.GetData() + offset, (size_t)size);
+        result = (result * 0x100000001b3ull) ^ std::hash<std::string_view>{}(range);
+    };
+
+    uint64_t size = file.GetSize();
+    if (size <= kFullHashMaxSize)
+    {
+        hash_range(0, size);
+        return result;
+    }
+    uint64_t stride = (size - kHashSampleSize) / (kNumHashSamples - 1);
+    for (uint64_t i = 0; i < kNumHashSamples; ++i) hash_range(i * stride, kHashSampleSize);
+    hash_range(size - kHashSampleSize, kHashSampleSize);
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+// The size and modification time are checked first, since they are much cheaper than the hash
+bool MatchCaptureFileIdentity(const std::string& file_name, const CaptureFileIdentity* expected,
+                              CaptureFileIdentity* identity)
+{
+    std::error_code error;
+    identity->m_size = std::filesystem::file_size(file_name, error);
+    if (error) return false;
+    auto mtime = std::filesystem::last_write_time(file_name, error);
+    if (error) return false;
+    identity->m_mtime = (uint64_t)mtime.time_since_epoch().count();
+    if (expected != nullptr &&
+        (identity->m_size != expected->m_size || identity->m_mtime != expected->m_mtime))
+        return false;
+
+    // Mapping avoids copying the whole capture through a read buffer just to hash it
+    std::shared_ptr<MappedFile> file = MappedFile::Open(file_name.c_str());
+    if (file == nullptr || file->GetSize() != identity->m_size) return false;
+    identity->m_hash = HashCaptureFile(*file);
+    return expected == nullptr || identity->m_hash == expected->m_hash;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Packet info is looked up by opcode, so find the opcode that leads back to packet_info
+uint32_t FindPacketInfoOpcode(const PacketInfo* packet_info)
+{
+    for (uint32_t opcode = 0; opcode <= UINT8_MAX; ++opcode)
+    {
+        if (GetPacketInfo(opcode) == packet_info ||
+            GetPacketInfo(opcode, packet_info->m_name) == packet_info)
+            return opcode;
+    }
+    return UINT32_MAX;
+}
+
+//--------------------------------------------------------------------------------------------------
+const PacketInfo* LookupPacketInfo(uint32_t opcode, const char* name)
+{
+    const PacketInfo* packet_info = GetPacketInfo(opcode, name);
+    if (packet_info != nullptr) return packet_info;
+    packet_info = GetPacketInfo(opcode);
+    if (packet_info != nullptr && strcmp(packet_info->m_name, name) == 0) return packet_info;
+    return nullptr;
+}
+
+// =================================================================================================
+// IndexWriter
+// =================================================================================================
+class IndexWriter
+{
+ public:
+    explicit IndexWriter(const std::string& file_name)
+        : m_file(file_name, std::ios::out | std::ios::binary | std::ios::trunc)
+    {
+    }
+
+    bool IsOk() const { return m_file.good(); }
+
+    void Write(const void* data, uint64_t size)
+    {
+        m_file.write(static_cast<const char*>(data), size);
+        m_offset += size;
+    }
+
+    template <typename T>
+    void WriteValue(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Write(&value, sizeof(T));
+    }
+
+    void WriteString(const std::string& str)
+    {
+        WriteValue<uint64_t>(str.size());
+        Write(str.data(), str.size());
+    }
+
+    // Element count, followed by the elements, aligned to kIndexAlignment
+    template <typename Container>
+    void WriteArray(const Container& container)
+    {
+        using T = std::remove_const_t<std::remove_reference_t<decltype(container[0])>>;
+        static_assert(std::is_trivially_copyable_v<T>);
+        WriteValue<uint64_t>(container.size());
+        Align();
+        Write(container.data(), container.size() * sizeof(T));
+        Align();
+    }
+
+    // Same layout as WriteArray() for an array of `size` bytes, which write_blocks(write) passes to
+    // write(data, size) a block at a time
+    template <typename WriteBlocksFn>
+    void WriteBlocks(uint64_t size, WriteBlocksFn&& write_blocks)
+    {
+        WriteValue<uint64_t>(size);
+        Align();
+        uint64_t start = m_offset;
+        write_blocks([this](const void* data, uint64_t block_size) { Write(data, block_size); });
+        if (m_offset - start != size) m_file.setstate(std::ios::failbit);
+        Align();
+    }
+
+ private:
+    void Align()
+    {
+        static const char kZeros[kIndexAlignment] = {};
+        Write(kZeros, (kIndexAlignment - m_offset % kIndexAlignment) % kIndexAlignment);
+    }
+
+    std::ofstream m_file;
+    uint64_t m_offset = 0;
+};
+
+// =================================================================================================
+// IndexReader
+// =================================================================================================
+// Reads from the mapped index file. Every read is bounds checked, and once one fails, all later
+// ones do too, so the result only needs to be checked at the end
+class IndexReader
+{
+ public:
+    IndexReader(const uint8_t* data, uint64_t size) : m_data(data), m_size(size) {}
+
+    bool IsOk() const { return m_ok; }
+
+    const uint8_t* Read(uint64_t size)
+    {
+        if (!m_ok || size > m_size - m_offset)
+        {
+            m_ok = false;
+            return nullptr;
+        }
+        const uint8_t* ptr = m_data + m_offset;
+        m_offset += size;
+        return ptr;
+    }
+
+    template <typename T>
+    T ReadValue()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value = {};
+        const uint8_t* ptr = Read(sizeof(T));
+        if (ptr != nullptr) memcpy(&value, ptr, sizeof(T));
+        return value;
+    }
+
+    std::string ReadString()
+    {
+        uint64_t size = ReadValue<uint64_t>();
+        const uint8_t* ptr = Read(size);
+        if (ptr == nullptr) return std::string();
+        return std::string(reinterpret_cast<const char*>(ptr), size);
+    }
+
+    // Reads the entry count of a table whose entries are written one by one, each taking at least
+    // min_entry_size bytes. Fails if that many entries could not fit in the rest of the file, so a
+    // corrupt count is never used to allocate the table
+    uint64_t ReadCount(uint64_t min_entry_size)
+    {
+        uint64_t count = ReadValue<uint64_t>();
+        if (!m_ok || count > (m_size - m_offset) / min_entry_size)
+        {
+            m_ok = false;
+            return 0;
+        }
+        return count;
+    }
+
+    // Returns the elements of an array written by IndexWriter::WriteArray() in place
+    template <typename T>
+    const T* ReadArrayInPlace(uint64_t* count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        *count = ReadValue<uint64_t>();
+        Align();
+        if (!m_ok || *count > (m_size - m_offset) / sizeof(T))
+        {
+            m_ok = false;
+            *count = 0;
+            return nullptr;
+        }
+        const uint8_t* ptr = Read(*count * sizeof(T));
+        Align();
+        return reinterpret_cast<const T*>(ptr);
+    }
+
+    template <typename Container>
+    void ReadArray(Container& container)
+    {
+        using T = std::remove_reference_t<decltype(container[0])>;
+        uint64_t count = 0;
+        const T* elements = ReadArrayInPlace<T>(&count);
+        container.resize(count);
+        if (count > 0) memcpy(container.data(), elements, count * sizeof(T));
+    }
+
+ private:
+    void Align() { Read((kIndexAlignment - m_offset % kIndexAlignment) % kIndexAlignment); }
+
+    const uint8_t* m_data;
+    uint64_t m_size;
+    uint64_t m_offset = 0;
+    bool m_ok = true;
+};
+
+}  // namespace
+
+// =================================================================================================
+// CaptureIndex
+// =================================================================================================
+std::string CaptureIndex::GetIndexFileName(const std::string& capture_file_name)
+{
+    return capture_file_name + ".dive.idx";
+}
+
+//--------------------------------------------------------------------------------------------------
+bool CaptureIndex::Save(const std::string& capture_file_name, const CaptureMetadata& metadata)
+{
+    IndexHeader header = {};
+    memcpy(header.m_magic, kIndexMagic, sizeof(kIndexMagic));
+    header.m_version = kIndexVersion;
+    if (!MatchCaptureFileIdentity(capture_file_name, nullptr, &header.m_capture_identity))
+        return false;
+
+    std::string index_file_name = GetIndexFileName(capture_file_name);
+    std::string temp_file_name = index_file_name + ".tmp";
+    {
+        IndexWriter writer(temp_file_name);
+        if (!writer.IsOk()) return false;
+        writer.WriteValue(header);
+
+        // Command hierarchy. Descriptions that point to register or packet info refer to it by
+        // name, which is looked up again on load. Should that not lead back to the same info, the
+        // description is stored as a string instead
+        const CommandHierarchy& hierarchy = metadata.m_command_hierarchy;
+        const CommandHierarchy::Nodes& nodes = hierarchy.m_nodes;
+        std::map<const RegInfo*, uint32_t> reg_indices;
+        std::map<const PacketInfo*, uint32_t> packet_indices;
+        std::vector<const RegInfo*> regs;
+        std::vector<std::pair<uint32_t, const PacketInfo*>> packets;
+        std::vector<std::string> extra_strings;
+        std::vector<IndexDescription> descriptions(nodes.m_description.size());
+        for (size_t i = 0; i < nodes.m_description.size(); ++i)
+        {
+            const CommandHierarchy::Description& desc = nodes.m_description[i];
+            IndexDescription& index_desc = descriptions[i];
+            index_desc.m_type = (uint8_t)desc.m_type;
+            index_desc.m_field = desc.m_field;
+            index_desc.m_data = desc.m_data;
+            index_desc.m_value = desc.m_value;
+            index_desc.m_info = kNoInfo;
+            switch (desc.m_type)
+            {
+                case CommandHierarchy::Description::Type::kRegister:
+                case CommandHierarchy::Description::Type::kRegisterField:
+                {
+                    auto [it, inserted] = reg_indices.try_emplace(desc.m_reg_info, kNoInfo);
+                    if (inserted && GetRegByName(desc.m_reg_info->m_name) == desc.m_reg_info)
+                    {
+                        it->second = (uint32_t)regs.size();
+                        regs.push_back(desc.m_reg_info);
+                    }
+                    index_desc.m_info = it->second;
+                    break;
+                }
+                case CommandHierarchy::Description::Type::kPacketField:
+                {
+                    auto [it, inserted] = packet_indices.try_emplace(desc.m_packet_info, kNoInfo);
+                    uint32_t opcode = inserted ? FindPacketInfoOpcode(desc.m_packet_info)
+                                               : UINT32_MAX;
+                    if (opcode != UINT32_MAX)
+                    {
+                        it->second = (uint32_t)packets.size();
+                        packets.emplace_back(opcode, desc.m_packet_info);
+                    }
+                    index_desc.m_info = it->second;
+                    break;
+                }
+                default:
+                    break;
+            }
+            bool has_info = desc.m_type == CommandHierarchy::Description::Type::kRegister ||
+                            desc.m_type == CommandHierarchy::Description::Type::kRegisterField ||
+                            desc.m_type == CommandHierarchy::Description::Type::kPacketField;
+            if (has_info && index_desc.m_info == kNoInfo)
+            {
+                index_desc = {};
+                index_desc.m_type = (uint8_t)CommandHierarchy::Description::Type::kString;
+                index_desc.m_data = (uint32_t)(nodes.m_desc_strings.size() + extra_strings.size());
+                index_desc.m_info = kNoInfo;
+                extra_strings.push_back(hierarchy.FormatNodeDesc(desc));
+            }
+        }
+
+        writer.WriteArray(nodes.m_node_type);
+        writer.WriteArray(descriptions);
+        writer.WriteValue<uint64_t>(regs.size());
+        for (const RegInfo* reg_info : regs) writer.WriteString(reg_info->m_name);
+        writer.WriteValue<uint64_t>(packets.size());
+        for (const auto& [opcode, packet_info] : packets)
+        {
+            writer.WriteValue(opcode);
+            writer.WriteString(packet_info->m_name);
+        }
+        writer.WriteValue<uint64_t>(nodes.m_desc_strings.size() + extra_strings.size());
+        for (size_t i = 0; i < nodes.m_desc_strings.size(); ++i)
+            writer.WriteString(nodes.m_desc_strings[i]);
+        for (const std::string& str : extra_strings) writer.WriteString(str);
+        writer.WriteArray(nodes.m_aux_info);
+        writer.WriteArray(nodes.m_event_node_indices);
+        for (const auto& exclude_indices : hierarchy.m_filter_exclude_indices_list)
+        {
+            writer.WriteArray(std::vector<uint64_t>(exclude_indices.begin(),
+                                                    exclude_indices.end()));
+        }
+        for (const SharedNodeTopology& topology : hierarchy.m_topology)
+        {
+            writer.WriteArray(topology.m_children_list);
+            writer.WriteArray(topology.m_node_children);
+            writer.WriteArray(topology.m_node_parent);
+            writer.WriteArray(topology.m_node_child_index);
+            writer.WriteArray(topology.m_shared_children_indices);
+            writer.WriteArray(topology.m_node_shared_children);
+            writer.WriteArray(topology.m_start_shared_child);
+            writer.WriteArray(topology.m_end_shared_child);
+            writer.WriteArray(topology.m_root_node_index);
+        }
+
+        // Events. Their metadata logs are not stored: only shader disassembly logs to them, and
+        // that happens again, on demand, after loading
+        writer.WriteValue<uint64_t>(metadata.m_num_pm4_packets);
+        writer.WriteValue<uint64_t>(metadata.m_event_info.size());
+        std::vector<uint32_t> shader_log_events(metadata.m_shaders.size(), UINT32_MAX);
+        for (size_t i = 0; i < metadata.m_event_info.size(); ++i)
+        {
+            const EventInfo& event_info = metadata.m_event_info[i];
+            IndexEventInfo index_event_info = {};
+            index_event_info.m_num_indices = event_info.m_num_indices;
+            index_event_info.m_submit_index = event_info.m_submit_index;
+            index_event_info.m_type = (uint8_t)event_info.m_type;
+            index_event_info.m_render_mode = (uint8_t)event_info.m_render_mode;
+            writer.WriteValue(index_event_info);
+            writer.WriteString(event_info.m_str);
+            writer.WriteArray(event_info.m_shader_references);
+
+            // A shader logs to the event that first referenced it
+            for (const ShaderReference& reference : event_info.m_shader_references)
+            {
+                if (reference.m_shader_index < shader_log_events.size() &&
+                    shader_log_events[reference.m_shader_index] == UINT32_MAX)
+                    shader_log_events[reference.m_shader_index] = (uint32_t)i;
+            }
+        }
+
+        std::vector<IndexShader> shaders(metadata.m_shaders.size());
+        for (size_t i = 0; i < metadata.m_shaders.size(); ++i)
+        {
+            shaders[i].m_address = metadata.m_shaders[i].GetShaderAddr();
+            shaders[i].m_submit_index = metadata.m_shaders[i].GetSubmitIndex();
+            shaders[i].m_log_event_index = shader_log_events[i];
+        }
+        writer.WriteArray(shaders);
+
+        const EventStateInfo& event_state = metadata.m_event_state;
+        writer.WriteValue<uint64_t>(event_state.size());
+        writer.WriteBlocks(event_state.RawDataSize(),
+                           [&event_state](auto&& write) { event_state.WriteRawData(write); });
+
+        if (!writer.IsOk())
+        {
+            std::filesystem::remove(temp_file_name);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_file_name, index_file_name, error);
+    if (error)
+    {
+        std::filesystem::remove(temp_file_name, error);
+        return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool CaptureIndex::Load(const std::string& capture_file_name, const Pm4CaptureData& capture_data,
+                        CaptureMetadata& metadata)
+{
+    std::string index_file_name = GetIndexFileName(capture_file_name);
+    std::error_code error;
+    if (!std::filesystem::exists(index_file_name, error)) return false;
+
+    std::shared_ptr<MappedFile> index_file = MappedFile::Open(index_file_name.c_str());
+    if (index_file == nullptr) return false;
+    IndexReader reader(index_file->GetData(), index_file->GetSize());
+
+    IndexHeader header = reader.ReadValue<IndexHeader>();
+    if (!reader.IsOk() || memcmp(header.m_magic, kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+        header.m_version != kIndexVersion)
+        return false;
+    CaptureFileIdentity capture_identity;
+    if (!MatchCaptureFileIdentity(capture_file_name, &header.m_capture_identity,
+                                  &capture_identity))
+        return false;
+
+    auto fail = [&metadata]() {
+        std::shared_ptr<ShaderCache> shader_cache = metadata.m_shader_cache;
+        metadata = CaptureMetadata();
+        metadata.m_shader_cache = shader_cache;
+        return false;
+    };
+
+    // Command hierarchy
+    CommandHierarchy& hierarchy = metadata.m_command_hierarchy;
+    CommandHierarchy::Nodes& nodes = hierarchy.m_nodes;
+    std::vector<IndexDescription> descriptions;
+    reader.ReadArray(nodes.m_node_type);
+    reader.ReadArray(descriptions);
+
+    // Each register is a name, and each packet an opcode and a name
+    std::vector<const RegInfo*> regs(reader.ReadCount(sizeof(uint64_t)));
+    for (const RegInfo*& reg_info : regs)
+    {
+        reg_info = GetRegByName(reader.ReadString().c_str());
+        if (reg_info == nullptr) return fail();
+    }
+    std::vector<const PacketInfo*> packets(reader.ReadCount(sizeof(uint32_t) + sizeof(uint64_t)));
+    for (const PacketInfo*& packet_info : packets)
+    {
+        uint32_t opcode = reader.ReadValue<uint32_t>();
+        std::string name = reader.ReadString();
+        packet_info = opcode <= UINT8_MAX ? LookupPacketInfo(opcode, name.c_str()) : nullptr;
+        if (packet_info == nullptr) return fail();
+    }
+
+    uint64_t num_strings = reader.ReadCount(sizeof(uint64_t));
+    for (uint64_t i = 0; i < num_strings && reader.IsOk(); ++i)
+        nodes.m_desc_strings.push_back(reader.ReadString());
+    if (!reader.IsOk()) return fail();
+
+    nodes.m_description.resize(descriptions.size());
+    for (size_t i = 0; i < descriptions.size(); ++i)
+    {
+        const IndexDescription& index_desc = descriptions[i];
+        CommandHierarchy::Description& desc = nodes.m_description[i];
+        desc = {};
+        desc.m_type = (CommandHierarchy::Description::Type)index_desc.m_type;
+        desc.m_field = index_desc.m_field;
+        desc.m_data = index_desc.m_data;
+        desc.m_value = index_desc.m_value;
+        switch (desc.m_type)
+        {
+            case CommandHierarchy::Description::Type::kString:
+                if (desc.m_data >= nodes.m_desc_strings.size()) return fail();
+                break;
+            case CommandHierarchy::Description::Type::kRegister:
+            case CommandHierarchy::Description::Type::kRegisterField:
+                if (index_desc.m_info >= regs.size()) return fail();
+                desc.m_reg_info = regs[index_desc.m_info];
+                break;
+            case CommandHierarchy::Description::Type::kPacketField:
+                if (index_desc.m_info >= packets.size()) return fail();
+                desc.m_packet_info = packets[index_desc.m_info];
+                break;
+            case CommandHierarchy::Description::Type::kPacket:
+            case CommandHierarchy::Description::Type::kArrayIndex:
+            case CommandHierarchy::Description::Type::kExtraDword:
+                break;
+            default:
+                return fail();
+        }
+    }
+
+    // AuxInfo has no default constructor, so it cannot go through ReadArray()
+    uint64_t num_aux_info = 0;
+    const auto* aux_info = reader.ReadArrayInPlace<CommandHierarchy::AuxInfo>(&num_aux_info);
+    nodes.m_aux_info.reserve(num_aux_info);
+    for (uint64_t i = 0; i < num_aux_info; ++i) nodes.m_aux_info.push_back(aux_info[i]);
+    reader.ReadArray(nodes.m_event_node_indices);
+    for (auto& exclude_indices : hierarchy.m_filter_exclude_indices_list)
+    {
+        std::vector<uint64_t> indices;
+        reader.ReadArray(indices);
+        exclude_indices.insert(indices.begin(), indices.end());
+    }
+    for (SharedNodeTopology& topology : hierarchy.m_topology)
+    {
+        reader.ReadArray(topology.m_children_list);
+        reader.ReadArray(topology.m_node_children);
+        reader.ReadArray(topology.m_node_parent);
+        reader.ReadArray(topology.m_node_child_index);
+        reader.ReadArray(topology.m_shared_children_indices);
+        reader.ReadArray(topology.m_node_shared_children);
+        reader.ReadArray(topology.m_start_shared_child);
+        reader.ReadArray(topology.m_end_shared_child);
+        reader.ReadArray(topology.m_root_node_index);
+    }
+    if (!reader.IsOk() || nodes.m_description.size() != nodes.m_node_type.size() ||
+        nodes.m_aux_info.size() != nodes.m_node_type.size())
+        return fail();
+
+    // Events
+    metadata.m_num_pm4_packets = reader.ReadValue<uint64_t>();
+    uint64_t num_events = reader.ReadValue<uint64_t>();
+    for (uint64_t i = 0; i < num_events && reader.IsOk(); ++i)
+    {
+        IndexEventInfo index_event_info = reader.ReadValue<IndexEventInfo>();
+        EventInfo event_info = {};
+        event_info.m_num_indices = index_event_info.m_num_indices;
+        event_info.m_submit_index = index_event_info.m_submit_index;
+        event_info.m_type = (Util::EventType)index_event_info.m_type;
+        event_info.m_render_mode = (RenderModeType)index_event_info.m_render_mode;
+        event_info.m_str = reader.ReadString();
+        reader.ReadArray(event_info.m_shader_references);
+        metadata.m_event_info.push_back(std::move(event_info));
+    }
+
+    // Now that m_event_info does not grow anymore, the shaders can point to the events' logs
+    std::vector<IndexShader> shaders;
+    reader.ReadArray(shaders);
+    if (!reader.IsOk()) return fail();
+    for (const IndexShader& shader : shaders)
+    {
+        ILog* log = nullptr;
+        if (shader.m_log_event_index < metadata.m_event_info.size())
+            log = &metadata.m_event_info[shader.m_log_event_index].m_metadata_log;
+        metadata.m_shaders.emplace_back(capture_data.GetMemoryManager(), shader.m_submit_index,
+                                        shader.m_address, log, metadata.m_shader_cache.get());
+    }
+
+    uint64_t event_state_size = reader.ReadValue<uint64_t>();
+    uint64_t event_state_data_size = 0;
+    const uint8_t* event_state_data = reader.ReadArrayInPlace<uint8_t>(&event_state_data_size);
+    using EventStateSize = EventStateInfo::Id::basic_type;
+    if (!reader.IsOk() || event_state_size > std::numeric_limits<EventStateSize>::max() ||
+        !metadata.m_event_state.SetRawData((EventStateSize)event_state_size, event_state_data,
+                                           event_state_data_size))
+        return fail();
+    if (metadata.m_event_state.size() != metadata.m_event_info.size()) return fail();
+    return true;
+}
+
+}  // namespace Dive
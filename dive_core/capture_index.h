@@ -0,0 +1,48 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <string>
+
+namespace Dive
+{
+
+struct CaptureMetadata;
+class Pm4CaptureData;
+
+//--------------------------------------------------------------------------------------------------
+// Sidecar file ("<capture>.dive.idx") that holds the CaptureMetadata parsed from a pm4 capture, so
+// later opens of the same capture can skip emulating it. An index is only used if the capture
+// still has the size, modification time and (sampled) hash it was created from, and if it was
+// written by a build with the same format version and struct layouts. Otherwise Load() fails and
+// the metadata has to be created from the capture again
+class CaptureIndex
+{
+ public:
+    static std::string GetIndexFileName(const std::string& capture_file_name);
+
+    // Write the index for the given capture. The file is written under a temporary name first,
+    // so other processes never see a partially written index
+    static bool Save(const std::string& capture_file_name, const CaptureMetadata& metadata);
+
+    // Fill in metadata from the index of the given capture, which has to be loaded into
+    // capture_data already. On failure, metadata is left empty
+    static bool Load(const std::string& capture_file_name, const Pm4CaptureData& capture_data,
+                     CaptureMetadata& metadata);
+};
+
+}  // namespace Dive
@@ -36,6 +36,9 @@
 namespace Dive
 {
 
+void OutputValue(std::ostringstream& string_stream, ValueType type, uint64_t value,
+                 uint32_t bit_width = 0, uint32_t radix = 0);
+
 // =================================================================================================
 // Topology
 // =================================================================================================
@@ -234,18 +237,102 @@ NodeType CommandHierarchy::GetNodeType(uint64_t node_index) const
 }
 
 //--------------------------------------------------------------------------------------------------
-const char* CommandHierarchy::GetNodeDesc(uint64_t node_index) const
+std::string CommandHierarchy::GetNodeDesc(uint64_t node_index) const
 {
     DIVE_ASSERT(node_index < m_nodes.m_description.size());
-    return m_nodes.m_description[node_index].c_str();
+    return FormatNodeDesc(m_nodes.m_description[node_index]);
 }
 
 //--------------------------------------------------------------------------------------------------
 void CommandHierarchy::SetNodeDesc(uint64_t node_index, const std::string& desc)
 {
     DIVE_ASSERT(node_index < m_nodes.m_description.size());
-    m_nodes.m_description[node_index] = desc;
-    return;
+    Description& cur_desc = m_nodes.m_description[node_index];
+    if (cur_desc.m_type == Description::Type::kString)
+        m_nodes.m_desc_strings[cur_desc.m_data] = desc;
+    else
+        cur_desc = m_nodes.AddDescString(std::string(desc));
+}
+
+//--------------------------------------------------------------------------------------------------
+std::string CommandHierarchy::FormatNodeDesc(const Description& desc) const
+{
+    std::ostringstream string_stream;
+    switch (desc.m_type)
+    {
+        case Description::Type::kString:
+            return m_nodes.m_desc_strings[desc.m_data];
+        case Description::Type::kPacket:
+        {
+            Pm4Header header;
+            header.u32All = desc.m_data;
+            if (header.type == 7)
+                string_stream << GetOpCodeString(header.type7.opcode);
+            else
+                string_stream << "TYPE4 REGWRITE";
+            string_stream << " 0x" << std::hex << header.u32All << std::dec;
+            break;
+        }
+        case Description::Type::kRegister:
+        {
+            const RegInfo* reg_info_ptr = desc.m_reg_info;
+            string_stream << reg_info_ptr->m_name << ": ";
+            if (reg_info_ptr->m_enum_handle != UINT8_MAX)
+            {
+                const char* enum_str = GetEnumString(reg_info_ptr->m_enum_handle,
+                                                     (uint32_t)desc.m_value);
+                DIVE_ASSERT(enum_str != nullptr);
+                string_stream << enum_str;
+            }
+            else
+            {
+                OutputValue(string_stream, (ValueType)reg_info_ptr->m_type, desc.m_value,
+                            reg_info_ptr->m_bit_width, reg_info_ptr->m_radix);
+            }
+            break;
+        }
+        case Description::Type::kRegisterField:
+        {
+            const RegField& reg_field = desc.m_reg_info->m_fields[desc.m_field];
+            uint64_t field_value = ((desc.m_value & reg_field.m_mask) >> reg_field.m_shift)
+                                   << reg_field.m_shr;
+            string_stream << reg_field.m_name << ": ";
+            if (reg_field.m_enum_handle != UINT8_MAX)
+            {
+                const char* enum_str = GetEnumString(reg_field.m_enum_handle,
+                                                     (uint32_t)field_value);
+                if (enum_str != nullptr)
+                    string_stream << enum_str;
+                else
+                    OutputValue(string_stream, (ValueType)reg_field.m_type, field_value);
+            }
+            else
+                OutputValue(string_stream, (ValueType)reg_field.m_type, field_value,
+                            reg_field.m_bit_width, reg_field.m_radix);
+            break;
+        }
+        case Description::Type::kPacketField:
+        {
+            const PacketField& packet_field = desc.m_packet_info->m_fields[desc.m_field];
+            uint32_t field_value = (uint32_t)desc.m_value;
+            string_stream << packet_field.m_name << ": ";
+            const char* enum_str = nullptr;
+            if (packet_field.m_enum_handle != UINT8_MAX)
+                enum_str = GetEnumString(packet_field.m_enum_handle, field_value);
+            if (enum_str != nullptr)
+                string_stream << enum_str;
+            else
+                OutputValue(string_stream, (ValueType)packet_field.m_type, field_value);
+            break;
+        }
+        case Description::Type::kArrayIndex:
+            string_stream << desc.m_data;
+            break;
+        case Description::Type::kExtraDword:
+            string_stream << "(DWORD " << desc.m_data << "): 0x" << std::hex << desc.m_value;
+            break;
+    }
+    return string_stream.str();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -388,6 +475,12 @@ uint64_t CommandHierarchy::AddNode(NodeType type, std::string&& desc, AuxInfo au
     return m_nodes.AddNode(type, std::move(desc), aux_info);
 }
 
+//--------------------------------------------------------------------------------------------------
+uint64_t CommandHierarchy::AddNode(NodeType type, Description desc, AuxInfo aux_info)
+{
+    return m_nodes.AddNode(type, desc, aux_info);
+}
+
 //--------------------------------------------------------------------------------------------------
 uint64_t CommandHierarchy::AddGfxrNode(NodeType type, std::string&& desc)
 {
@@ -410,12 +503,18 @@ size_t CommandHierarchy::GetEventIndex(uint64_t node_index) const
 // CommandHierarchy::Nodes
 // =================================================================================================
 uint64_t CommandHierarchy::Nodes::AddNode(NodeType type, std::string&& desc, AuxInfo aux_info)
+{
+    return AddNode(type, AddDescString(std::move(desc)), aux_info);
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t CommandHierarchy::Nodes::AddNode(NodeType type, Description desc, AuxInfo aux_info)
 {
     DIVE_ASSERT(m_node_type.size() == m_description.size());
     DIVE_ASSERT(m_node_type.size() == m_aux_info.size());
 
     m_node_type.push_back(type);
-    m_description.push_back(std::move(desc));
+    m_description.push_back(desc);
     m_aux_info.push_back(aux_info);
     return m_node_type.size() - 1;
 }
@@ -426,13 +525,93 @@ uint64_t CommandHierarchy::Nodes::AddGfxrNode(NodeType type, std::string&& desc)
     DIVE_ASSERT(m_node_type.size() == m_description.size());
 
     m_node_type.push_back(type);
-    m_description.push_back(std::move(desc));
+    m_description.push_back(AddDescString(std::move(desc)));
     // Adds a dummy AuxInfo object to ensure the m_node_type, m_description, and m_aux_info sizes
     // stay the same.
     m_aux_info.push_back(AuxInfo(0));
     return m_node_type.size() - 1;
 }
 
+//--------------------------------------------------------------------------------------------------
+CommandHierarchy::Description CommandHierarchy::Nodes::AddDescString(std::string&& desc)
+{
+    DIVE_ASSERT(m_desc_strings.size() < UINT32_MAX);
+    Description string_desc = {};
+    string_desc.m_type = Description::Type::kString;
+    string_desc.m_data = (uint32_t)m_desc_strings.size();
+    m_desc_strings.push_back(std::move(desc));
+    return string_desc;
+}
+
+// =================================================================================================
+// CommandHierarchy::Description
+// =================================================================================================
+CommandHierarchy::Description CommandHierarchy::Description::Packet(Pm4Header header)
+{
+    Description desc = {};
+    desc.m_type = Type::kPacket;
+    desc.m_data = header.u32All;
+    return desc;
+}
+
+//--------------------------------------------------------------------------------------------------
+CommandHierarchy::Description CommandHierarchy::Description::Register(const RegInfo* reg_info,
+                                                                      uint64_t reg_value)
+{
+    Description desc = {};
+    desc.m_type = Type::kRegister;
+    desc.m_value = reg_value;
+    desc.m_reg_info = reg_info;
+    return desc;
+}
+
+//--------------------------------------------------------------------------------------------------
+CommandHierarchy::Description CommandHierarchy::Description::RegisterField(const RegInfo* reg_info,
+                                                                           uint32_t field,
+                                                                           uint64_t reg_value)
+{
+    DIVE_ASSERT(field <= UINT16_MAX);
+    Description desc = {};
+    desc.m_type = Type::kRegisterField;
+    desc.m_field = (uint16_t)field;
+    desc.m_value = reg_value;
+    desc.m_reg_info = reg_info;
+    return desc;
+}
+
+//--------------------------------------------------------------------------------------------------
+CommandHierarchy::Description CommandHierarchy::Description::PacketField(
+    const PacketInfo* packet_info, uint32_t field, uint32_t field_value)
+{
+    DIVE_ASSERT(field <= UINT16_MAX);
+    Description desc = {};
+    desc.m_type = Type::kPacketField;
+    desc.m_field = (uint16_t)field;
+    desc.m_value = field_value;
+    desc.m_packet_info = packet_info;
+    return desc;
+}
+
+//--------------------------------------------------------------------------------------------------
+CommandHierarchy::Description CommandHierarchy::Description::ArrayIndex(uint32_t index)
+{
+    Description desc = {};
+    desc.m_type = Type::kArrayIndex;
+    desc.m_data = index;
+    return desc;
+}
+
+//--------------------------------------------------------------------------------------------------
+CommandHierarchy::Description CommandHierarchy::Description::ExtraDword(uint32_t dword_index,
+                                                                        uint32_t dword_value)
+{
+    Description desc = {};
+    desc.m_type = Type::kExtraDword;
+    desc.m_data = dword_index;
+    desc.m_value = dword_value;
+    return desc;
+}
+
 // =================================================================================================
 // CommandHierarchy::AuxInfo
 // =================================================================================================
@@ -1264,15 +1443,12 @@ uint64_t CommandHierarchyCreator::AddPacketNode(const IMemoryManager& mem_manage
 {
     if (header.type == 7)
     {
-        std::ostringstream packet_string_stream;
-        packet_string_stream << GetOpCodeString(header.type7.opcode);
-        packet_string_stream << " 0x" << std::hex << header.u32All << std::dec;
-
         CommandHierarchy::AuxInfo aux_info =
             CommandHierarchy::AuxInfo::PacketNode(va_addr, header.type7.opcode, m_cur_ib_level);
 
-        uint64_t packet_node_index =
-            AddNode(NodeType::kPacketNode, packet_string_stream.str(), aux_info);
+        uint64_t packet_node_index = AddNode(NodeType::kPacketNode,
+                                             CommandHierarchy::Description::Packet(header),
+                                             aux_info);
 
         if (header.type7.opcode == CP_CONTEXT_REG_BUNCH)
         {
@@ -1299,15 +1475,12 @@ uint64_t CommandHierarchyCreator::AddPacketNode(const IMemoryManager& mem_manage
     }
     else if (header.type == 4)
     {
-        std::ostringstream packet_string_stream;
-        packet_string_stream << "TYPE4 REGWRITE";
-        packet_string_stream << " 0x" << std::hex << header.u32All << std::dec;
-
         CommandHierarchy::AuxInfo aux_info =
             CommandHierarchy::AuxInfo::PacketNode(va_addr, UINT8_MAX, m_cur_ib_level);
 
-        uint64_t packet_node_index =
-            AddNode(NodeType::kPacketNode, packet_string_stream.str(), aux_info);
+        uint64_t packet_node_index = AddNode(NodeType::kPacketNode,
+                                             CommandHierarchy::Description::Packet(header),
+                                             aux_info);
 
         AppendRegNodes(mem_manager, submit_index, va_addr, header, packet_node_index);
         return packet_node_index;
@@ -1317,7 +1490,7 @@ uint64_t CommandHierarchyCreator::AddPacketNode(const IMemoryManager& mem_manage
 
 //--------------------------------------------------------------------------------------------------
 void OutputValue(std::ostringstream& string_stream, ValueType type, uint64_t value,
-                 uint32_t bit_width = 0, uint32_t radix = 0)
+                 uint32_t bit_width, uint32_t radix)
 {
     if (type == ValueType::kBoolean)
     {
@@ -1392,49 +1565,22 @@ uint64_t CommandHierarchyCreator::AddRegisterNode(uint32_t reg, uint64_t reg_val
     // Should never have an "unknown register" unless something is seriously wrong!
     DIVE_ASSERT(reg_info_ptr != nullptr);
     reg_value = reg_value << reg_info_ptr->m_shr;
-    // Reg item
-    std::ostringstream reg_string_stream;
-    if (reg_info_ptr->m_enum_handle != UINT8_MAX)
-    {
-        const char* enum_str = GetEnumString(reg_info_ptr->m_enum_handle, (uint32_t)reg_value);
-        DIVE_ASSERT(enum_str != nullptr);
-        reg_string_stream << reg_info_ptr->m_name << ": " << enum_str;
-    }
-    else
-    {
-        reg_string_stream << reg_info_ptr->m_name << ": ";
-        OutputValue(reg_string_stream, (ValueType)reg_info_ptr->m_type, reg_value,
-                    reg_info_ptr->m_bit_width, reg_info_ptr->m_radix);
-    }
 
+    // Reg item. The description is formatted on demand, from the register info and value
     CommandHierarchy::AuxInfo aux_info = CommandHierarchy::AuxInfo::RegFieldNode(false);
-    uint64_t reg_node_index = AddNode(NodeType::kRegNode, reg_string_stream.str(), aux_info);
+    uint64_t reg_node_index = AddNode(NodeType::kRegNode,
+                                      CommandHierarchy::Description::Register(reg_info_ptr,
+                                                                              reg_value),
+                                      aux_info);
 
     // Go through each field of this register, create a FieldNode out of it and append as child
     // to reg_node_ptr
     for (uint32_t field = 0; field < reg_info_ptr->m_fields.size(); ++field)
     {
-        const RegField& reg_field = reg_info_ptr->m_fields[field];
-        uint64_t field_value = ((reg_value & reg_field.m_mask) >> reg_field.m_shift)
-                               << reg_field.m_shr;
-
         // Field item
-        std::ostringstream field_string_stream;
-        field_string_stream << reg_field.m_name << ": ";
-        if (reg_field.m_enum_handle != UINT8_MAX)
-        {
-            const char* enum_str = GetEnumString(reg_field.m_enum_handle, (uint32_t)field_value);
-            if (enum_str != nullptr)
-                field_string_stream << enum_str;
-            else
-                OutputValue(field_string_stream, (ValueType)reg_field.m_type, field_value);
-        }
-        else
-            OutputValue(field_string_stream, (ValueType)reg_field.m_type, field_value,
-                        reg_field.m_bit_width, reg_field.m_radix);
-
-        uint64_t field_node_index =
-            AddNode(NodeType::kFieldNode, field_string_stream.str(), aux_info);
+        CommandHierarchy::Description desc =
+            CommandHierarchy::Description::RegisterField(reg_info_ptr, field, reg_value);
+        uint64_t field_node_index = AddNode(NodeType::kFieldNode, desc, aux_info);
 
         // Add it as child to reg_node
         AddChild(CommandHierarchy::kSubmitTopology, reg_node_index, field_node_index);
@@ -1632,11 +1778,10 @@ void CommandHierarchyCreator::AppendPacketFieldNodes(const IMemoryManager& mem_m
         uint64_t parent_node_index = packet_node_index;
         if ((packet_info_ptr->m_max_array_size > 1) && (base_dword < dword_count))
         {
-            std::ostringstream field_string_stream;
-            field_string_stream << array;
             CommandHierarchy::AuxInfo aux_info = CommandHierarchy::AuxInfo::RegFieldNode(false);
-            uint64_t array_node_index =
-                AddNode(NodeType::kFieldNode, field_string_stream.str(), aux_info);
+            uint64_t array_node_index = AddNode(NodeType::kFieldNode,
+                                                CommandHierarchy::Description::ArrayIndex(array),
+                                                aux_info);
 
             // Add it as child to packet_node
             AddChild(CommandHierarchy::kSubmitTopology, packet_node_index, array_node_index);
@@ -1670,23 +1815,33 @@ void CommandHierarchyCreator::AppendPacketFieldNodes(const IMemoryManager& mem_m
             uint32_t field_value = ((dword_value & packet_field.m_mask) >> packet_field.m_shift)
                                    << packet_field.m_shr;
 
-            // Field item
-            std::ostringstream field_string_stream;
-            field_string_stream << prefix << packet_field.m_name << ": ";
-            if (packet_field.m_enum_handle != UINT8_MAX)
+            // Field item. Without a prefix, the description is formatted on demand
+            CommandHierarchy::AuxInfo aux_info = CommandHierarchy::AuxInfo::RegFieldNode(false);
+            uint64_t field_node_index;
+            if (prefix[0] == '\0')
             {
-                const char* enum_str = GetEnumString(packet_field.m_enum_handle, field_value);
-                if (enum_str != nullptr)
-                    field_string_stream << enum_str;
+                CommandHierarchy::Description desc = CommandHierarchy::Description::PacketField(
+                    packet_info_ptr, (uint32_t)field, field_value);
+                field_node_index = AddNode(NodeType::kFieldNode, desc, aux_info);
+            }
+            else
+            {
+                std::ostringstream field_string_stream;
+                field_string_stream << prefix << packet_field.m_name << ": ";
+                if (packet_field.m_enum_handle != UINT8_MAX)
+                {
+                    const char* enum_str = GetEnumString(packet_field.m_enum_handle, field_value);
+                    if (enum_str != nullptr)
+                        field_string_stream << enum_str;
+                    else
+                        OutputValue(field_string_stream, (ValueType)packet_field.m_type,
+                                    field_value);
+                }
                 else
                     OutputValue(field_string_stream, (ValueType)packet_field.m_type, field_value);
+                field_node_index = AddNode(NodeType::kFieldNode, field_string_stream.str(),
+                                           aux_info);
             }
-            else
-                OutputValue(field_string_stream, (ValueType)packet_field.m_type, field_value);
-
-            CommandHierarchy::AuxInfo aux_info = CommandHierarchy::AuxInfo::RegFieldNode(false);
-            uint64_t field_node_index =
-                AddNode(NodeType::kFieldNode, field_string_stream.str(), aux_info);
 
             // Add it as child to packet_node
             AddChild(CommandHierarchy::kSubmitTopology, parent_node_index, field_node_index);
@@ -1709,13 +1864,22 @@ void CommandHierarchyCreator::AppendPacketFieldNodes(const IMemoryManager& mem_m
                 DIVE_VERIFY(mem_manager.RetrieveMemoryData(&dword_value, submit_index,
                                                            dword_va_addr, sizeof(uint32_t)));
 
-                std::ostringstream field_string_stream;
-                field_string_stream << prefix << "(DWORD " << i << "): 0x" << std::hex
-                                    << dword_value;
-
                 CommandHierarchy::AuxInfo aux_info = CommandHierarchy::AuxInfo::RegFieldNode(false);
-                uint64_t field_node_index =
-                    AddNode(NodeType::kFieldNode, field_string_stream.str(), aux_info);
+                uint64_t field_node_index;
+                if (prefix[0] == '\0')
+                {
+                    CommandHierarchy::Description desc =
+                        CommandHierarchy::Description::ExtraDword((uint32_t)i, dword_value);
+                    field_node_index = AddNode(NodeType::kFieldNode, desc, aux_info);
+                }
+                else
+                {
+                    std::ostringstream field_string_stream;
+                    field_string_stream << prefix << "(DWORD " << i << "): 0x" << std::hex
+                                        << dword_value;
+                    field_node_index = AddNode(NodeType::kFieldNode, field_string_stream.str(),
+                                               aux_info);
+                }
 
                 // Add it as child to packet_node
                 AddChild(CommandHierarchy::kSubmitTopology, packet_node_index, field_node_index);
@@ -1781,8 +1945,8 @@ void CommandHierarchyCreator::AppendLoadStateExtBufferNode(const IMemoryManager&
         {
             bindless = true;
             const uint32_t base_reg = is_compute
-                                          ? GetRegOffsetByName("HLSQ_CS_BINDLESS_BASE0_DESCRIPTOR")
-                                          : GetRegOffsetByName("HLSQ_BINDLESS_BASE0_DESCRIPTOR");
+                                          ? GetRegOffset(HotReg::HLSQ_CS_BINDLESS_BASE0_DESCRIPTOR)
+                                          : GetRegOffset(HotReg::HLSQ_BINDLESS_BASE0_DESCRIPTOR);
             const uint32_t reg = base_reg + (packet.u32All1 >> 28) * 2;
 
             DIVE_ASSERT(m_state_tracker.IsRegSet(reg));
@@ -1938,7 +2102,15 @@ void CommandHierarchyCreator::CacheSetDrawStateGroupInfo(const IMemoryManager& m
 uint64_t CommandHierarchyCreator::AddNode(NodeType type, std::string&& desc,
                                           CommandHierarchy::AuxInfo aux_info)
 {
-    uint64_t node_index = m_command_hierarchy.AddNode(type, std::move(desc), aux_info);
+    CommandHierarchy::Nodes& nodes = m_command_hierarchy.m_nodes;
+    return AddNode(type, nodes.AddDescString(std::move(desc)), aux_info);
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t CommandHierarchyCreator::AddNode(NodeType type, CommandHierarchy::Description desc,
+                                          CommandHierarchy::AuxInfo aux_info)
+{
+    uint64_t node_index = m_command_hierarchy.AddNode(type, desc, aux_info);
     for (uint32_t i = 0; i < CommandHierarchy::kTopologyTypeCount; ++i)
     {
         DIVE_ASSERT(m_node_children[i][kSingleParentNodeChildren].size() == node_index);
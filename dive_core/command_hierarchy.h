@@ -138,6 +138,7 @@ class Topology
     friend class CommandHierarchy;
     friend class GfxrVulkanCommandHierarchyCreator;
     friend class DiveCommandHierarchyCreator;
+    friend class CaptureIndex;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -168,6 +169,7 @@ class SharedNodeTopology : public Topology
     friend class CommandHierarchy;
     friend class CommandHierarchyCreator;
     friend class DiveCommandHierarchyCreator;
+    friend class CaptureIndex;
 
     // List of all children for shared nodes.
 
@@ -222,7 +224,9 @@ class CommandHierarchy
     const SharedNodeTopology& GetAllEventHierarchyTopology() const;
 
     NodeType GetNodeType(uint64_t node_index) const;
-    const char* GetNodeDesc(uint64_t node_index) const;
+    // Formats the description on demand for packet, register and field nodes, so this returns a
+    // new string rather than a pointer into the hierarchy
+    std::string GetNodeDesc(uint64_t node_index) const;
     void SetNodeDesc(uint64_t node_index, const std::string& desc);
 
     Dive::EngineType GetSubmitNodeEngineType(uint64_t node_index) const;
@@ -272,6 +276,7 @@ class CommandHierarchy
     friend class CommandHierarchyCreator;
     friend class GfxrVulkanCommandHierarchyCreator;
     friend class DiveCommandHierarchyCreator;
+    friend class CaptureIndex;
 
     enum TopologyType
     {
@@ -341,21 +346,65 @@ class CommandHierarchy
     };
     static_assert(sizeof(AuxInfo) == sizeof(uint64_t), "Unexpected size!");
 
+    // Packet, register and field nodes make up the vast majority of nodes, and most of them are
+    // never looked at. So rather than formatting their description up-front, the values needed
+    // to format it are stored, and the string is only built once it is asked for
+    struct Description
+    {
+        enum class Type : uint8_t
+        {
+            kString,         // m_data: index into Nodes::m_desc_strings
+            kPacket,         // m_data: Pm4Header
+            kRegister,       // m_reg_info, m_value: register value
+            kRegisterField,  // m_reg_info, m_field, m_value: register value
+            kPacketField,    // m_packet_info, m_field, m_value: field value
+            kArrayIndex,     // m_data: array index
+            kExtraDword      // m_data: dword index, m_value: dword value
+        };
+
+        Type m_type;
+        uint16_t m_field;
+        uint32_t m_data;
+        uint64_t m_value;
+        union
+        {
+            const RegInfo* m_reg_info;
+            const PacketInfo* m_packet_info;
+        };
+
+        static Description Packet(Pm4Header header);
+        static Description Register(const RegInfo* reg_info, uint64_t reg_value);
+        static Description RegisterField(const RegInfo* reg_info, uint32_t field,
+                                         uint64_t reg_value);
+        static Description PacketField(const PacketInfo* packet_info, uint32_t field,
+                                       uint32_t field_value);
+        static Description ArrayIndex(uint32_t index);
+        static Description ExtraDword(uint32_t dword_index, uint32_t dword_value);
+    };
+    static_assert(sizeof(Description) == 3 * sizeof(uint64_t), "Unexpected size!");
+
     // This is information about each node and contains no topology information
     // Arranged in structure-of-arrays for better locality
     struct Nodes
     {
         DiveVector<NodeType> m_node_type;
-        DiveVector<std::string> m_description;
+        DiveVector<Description> m_description;
+        DiveVector<std::string> m_desc_strings;
         DiveVector<AuxInfo> m_aux_info;
         DiveVector<uint64_t> m_event_node_indices;
 
         uint64_t AddNode(NodeType type, std::string&& desc, AuxInfo aux_info);
+        uint64_t AddNode(NodeType type, Description desc, AuxInfo aux_info);
         uint64_t AddGfxrNode(NodeType type, std::string&& desc);
+        // Stores a string description, for nodes that are not formatted on demand
+        Description AddDescString(std::string&& desc);
     };
 
+    std::string FormatNodeDesc(const Description& desc) const;
+
     // Add a node and returns index of the added node
     uint64_t AddNode(NodeType type, std::string&& desc, AuxInfo aux_info);
+    uint64_t AddNode(NodeType type, Description desc, AuxInfo aux_info);
     // Add a gfxr node and returns index of the added node
     uint64_t AddGfxrNode(NodeType type, std::string&& desc);
     void AddToFilterExcludeIndexList(uint64_t index, FilterListType filter_mode)
@@ -490,6 +539,8 @@ class CommandHierarchyCreator : public EmulateCallbacksBase
                                     uint64_t va_addr, uint64_t set_draw_state_node_index,
                                     Pm4Header header);
     uint64_t AddNode(NodeType type, std::string&& desc, CommandHierarchy::AuxInfo aux_info = 0);
+    uint64_t AddNode(NodeType type, CommandHierarchy::Description desc,
+                     CommandHierarchy::AuxInfo aux_info);
 
     void AppendEventNodeIndex(uint64_t node_index);
 
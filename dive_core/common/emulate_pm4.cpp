@@ -40,7 +40,10 @@ namespace Dive
 // =================================================================================================
 // EmulateStateTracker
 // =================================================================================================
-EmulateStateTracker::EmulateStateTracker() {}
+EmulateStateTracker::EmulateStateTracker()
+{
+    std::fill(std::begin(m_page_table), std::end(m_page_table), kInvalidPage);
+}
 
 //--------------------------------------------------------------------------------------------------
 bool EmulateStateTracker::OnPacket(const IMemoryManager& mem_manager, uint32_t submit_index,
@@ -214,8 +217,11 @@ uint32_t EmulateStateTracker::GetBufferSize() const
 //--------------------------------------------------------------------------------------------------
 void EmulateStateTracker::Reset()
 {
-    memset(m_reg, 0, sizeof(m_reg));
-    memset(m_reg_is_set, 0, sizeof(m_reg_is_set));
+    for (uint64_t i = 0; i < m_pages.size(); ++i)
+    {
+        m_page_table[m_pages[i].m_page_number] = kInvalidPage;
+    }
+    m_pages.resize(0);
     m_shader_enable_bit = std::nullopt;
 }
 
@@ -233,11 +239,33 @@ void EmulateStateTracker::PopEnableMask()
     m_enable_mask_stack.pop_back();
 }
 
+//--------------------------------------------------------------------------------------------------
+const EmulateStateTracker::RegPage* EmulateStateTracker::GetPage(uint32_t offset) const
+{
+    DIVE_ASSERT(offset < kNumRegs);
+    uint16_t page_index = m_page_table[offset >> kRegsPerPageShift];
+    return (page_index != kInvalidPage) ? &m_pages[page_index] : nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint16_t EmulateStateTracker::AllocatePage(uint32_t page_number)
+{
+    // Page storage is kept allocated across Reset(), so this is usually just a clear
+    uint16_t page_index = static_cast<uint16_t>(m_pages.size());
+    m_pages.resize(m_pages.size() + 1);
+    RegPage& page = m_pages.back();
+    memset(&page, 0, sizeof(page));
+    page.m_page_number = page_number;
+    m_page_table[page_number] = page_index;
+    return page_index;
+}
+
 //--------------------------------------------------------------------------------------------------
 uint32_t EmulateStateTracker::GetRegValue(uint32_t offset, ShaderEnableBit shader_enable_bit) const
 {
+    const RegPage* page = GetPage(offset);
     uint32_t i = static_cast<uint32_t>(shader_enable_bit);
-    return m_reg[i][offset];
+    return page ? page->m_reg[i][offset % kRegsPerPage] : 0;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -251,9 +279,8 @@ uint32_t EmulateStateTracker::GetRegValue(uint32_t offset) const
 uint64_t EmulateStateTracker::GetReg64Value(uint32_t offset,
                                             ShaderEnableBit shader_enable_bit) const
 {
-    uint32_t i = static_cast<uint32_t>(shader_enable_bit);
-    return (static_cast<uint64_t>(m_reg[i][offset])) |
-           ((static_cast<uint64_t>(m_reg[i][offset + 1])) << 32);
+    return (static_cast<uint64_t>(GetRegValue(offset, shader_enable_bit))) |
+           ((static_cast<uint64_t>(GetRegValue(offset + 1, shader_enable_bit))) << 32);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -266,12 +293,33 @@ uint64_t EmulateStateTracker::GetReg64Value(uint32_t offset) const
 //--------------------------------------------------------------------------------------------------
 void EmulateStateTracker::SetReg(uint32_t offset, uint32_t value)
 {
+    DIVE_ASSERT(offset < kNumRegs);
+    uint32_t page_number = offset >> kRegsPerPageShift;
+    uint16_t page_index = m_page_table[page_number];
+    if (page_index == kInvalidPage) page_index = AllocatePage(page_number);
+
+    RegPage& page = m_pages[page_index];
+    uint32_t page_offset = offset % kRegsPerPage;
+    uint32_t is_set_bit = 1u << (page_offset % 32);
+
+    // Nearly all writes happen outside of a masked IB, so write all banks without testing the mask
+    // bit by bit. This keeps large submits at least as fast as with the old dense register file
+    constexpr uint32_t kAllBanksMask = (1u << kShaderEnableBitCount) - 1;
+    if (m_enable_mask == kAllBanksMask)
+    {
+        for (unsigned int i = 0; i < kShaderEnableBitCount; ++i)
+        {
+            page.m_reg[i][page_offset] = value;
+            page.m_reg_is_set[i][page_offset / 32] |= is_set_bit;
+        }
+        return;
+    }
     for (unsigned int i = 0; i < kShaderEnableBitCount; ++i)
     {
         if (m_enable_mask & (1u << i))
         {
-            m_reg[i][offset] = value;
-            m_reg_is_set[i][offset / 8] |= (1 << (offset % 8));
+            page.m_reg[i][page_offset] = value;
+            page.m_reg_is_set[i][page_offset / 32] |= is_set_bit;
         }
     }
 }
@@ -286,9 +334,11 @@ bool EmulateStateTracker::IsRegSet(uint32_t offset) const
 //--------------------------------------------------------------------------------------------------
 bool EmulateStateTracker::IsRegSet(uint32_t offset, ShaderEnableBit shader_enable_bit) const
 {
-    uint32_t index = static_cast<uint32_t>(shader_enable_bit);
-    uint8_t is_reg_set = (m_reg_is_set[index][offset / 8] & (1 << (offset % 8)));
-    return static_cast<bool>(is_reg_set);
+    const RegPage* page = GetPage(offset);
+    if (!page) return false;
+    uint32_t i = static_cast<uint32_t>(shader_enable_bit);
+    uint32_t page_offset = offset % kRegsPerPage;
+    return (page->m_reg_is_set[i][page_offset / 32] & (1u << (page_offset % 32))) != 0;
 }
 
 // =================================================================================================
@@ -784,6 +834,9 @@ uint32_t GetPacketSize(Pm4Header header)
 bool EmulateCallbacksBase::ProcessSubmits(const DiveVector<SubmitInfo>& submits,
                                           const IMemoryManager& mem_manager)
 {
+    // TODO: emulate independent submits in parallel. Only running the walk itself on other threads
+    // does not help, since the callbacks take most of the time. The creators would need to build
+    // per-submit partial results (nodes, events, state rows) that are merged in submit order
     for (uint32_t submit_index = 0; submit_index < submits.size(); ++submit_index)
     {
         const Dive::SubmitInfo& submit_info = submits[submit_index];
@@ -814,4 +867,104 @@ bool EmulateCallbacksBase::ProcessSubmits(const DiveVector<SubmitInfo>& submits,
     return true;
 }
 
+// =================================================================================================
+// EmulateCallbacksMultiplexer
+// =================================================================================================
+void EmulateCallbacksMultiplexer::AddCallbacks(EmulateCallbacksBase* callbacks)
+{
+    DIVE_ASSERT(callbacks != nullptr && callbacks != this);
+    m_callbacks.push_back(callbacks);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool EmulateCallbacksMultiplexer::OnIbStart(uint32_t submit_index, uint32_t ib_index,
+                                            const IndirectBufferInfo& ib_info, IbType type)
+{
+    for (EmulateCallbacksBase* callbacks : m_callbacks)
+    {
+        if (!callbacks->OnIbStart(submit_index, ib_index, ib_info, type)) return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool EmulateCallbacksMultiplexer::OnIbEnd(uint32_t submit_index, uint32_t ib_index,
+                                          const IndirectBufferInfo& ib_info)
+{
+    for (EmulateCallbacksBase* callbacks : m_callbacks)
+    {
+        if (!callbacks->OnIbEnd(submit_index, ib_index, ib_info)) return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool EmulateCallbacksMultiplexer::OnPacket(const IMemoryManager& mem_manager,
+                                           uint32_t submit_index, uint32_t ib_index,
+                                           uint64_t va_addr, Pm4Header header)
+{
+    for (EmulateCallbacksBase* callbacks : m_callbacks)
+    {
+        if (!callbacks->OnPacket(mem_manager, submit_index, ib_index, va_addr, header))
+            return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+void EmulateCallbacksMultiplexer::OnSubmitStart(uint32_t submit_index,
+                                                const SubmitInfo& submit_info)
+{
+    for (EmulateCallbacksBase* callbacks : m_callbacks)
+    {
+        callbacks->OnSubmitStart(submit_index, submit_info);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void EmulateCallbacksMultiplexer::OnSubmitEnd(uint32_t submit_index, const SubmitInfo& submit_info)
+{
+    for (EmulateCallbacksBase* callbacks : m_callbacks)
+    {
+        callbacks->OnSubmitEnd(submit_index, submit_info);
+    }
+}
+
+// =================================================================================================
+// CountPm4Packets
+// =================================================================================================
+namespace
+{
+
+class PacketCounter : public EmulateCallbacksBase
+{
+ public:
+    ~PacketCounter() override = default;
+
+    bool OnPacket(const IMemoryManager& mem_manager, uint32_t submit_index, uint32_t ib_index,
+                  uint64_t va_addr, Pm4Header header) override
+    {
+        ++m_num_packets;
+        return EmulateCallbacksBase::OnPacket(mem_manager, submit_index, ib_index, va_addr, header);
+    }
+
+    void OnSubmitStart(uint32_t submit_index, const SubmitInfo& submit_info) override
+    {
+        m_state_tracker.Reset();
+    }
+    void OnSubmitEnd(uint32_t submit_index, const SubmitInfo& submit_info) override {}
+
+    uint64_t m_num_packets = 0;
+};
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+uint64_t CountPm4Packets(const DiveVector<SubmitInfo>& submits, const IMemoryManager& mem_manager)
+{
+    PacketCounter counter;
+    if (!counter.ProcessSubmits(submits, mem_manager)) return 0;
+    return counter.m_num_packets;
+}
+
 }  // namespace Dive
@@ -157,8 +157,30 @@ class EmulateStateTracker
 
  private:
     static constexpr size_t kNumRegs = 0xffff + 1;
-    uint32_t m_reg[kShaderEnableBitCount][kNumRegs];
-    uint8_t m_reg_is_set[kShaderEnableBitCount][(kNumRegs / 8) + 1];
+
+    // Registers are stored in fixed-size pages that are only allocated once a register in that
+    // range is written. Captures only touch a handful of clustered register ranges, so this keeps
+    // the working set small, and both Reset() and copies scale with the number of pages in use
+    // rather than with the size of the register space
+    static constexpr uint32_t kRegsPerPageShift = 8;
+    static constexpr uint32_t kRegsPerPage = 1u << kRegsPerPageShift;
+    static constexpr uint32_t kNumPages = kNumRegs / kRegsPerPage;
+    static constexpr uint16_t kInvalidPage = UINT16_MAX;
+
+    struct RegPage
+    {
+        uint32_t m_reg[kShaderEnableBitCount][kRegsPerPage];
+        uint32_t m_reg_is_set[kShaderEnableBitCount][kRegsPerPage / 32];
+        uint32_t m_page_number;  // Index into m_page_table, to undo the mapping on Reset()
+    };
+
+    const RegPage* GetPage(uint32_t offset) const;
+    uint16_t AllocatePage(uint32_t page_number);
+
+    // Index into m_pages of the page holding each register range
+    uint16_t m_page_table[kNumPages];
+    DiveVector<RegPage> m_pages;
+
     uint32_t m_enable_mask = (1u << kShaderEnableBitCount) - 1;
     DiveVector<uint32_t> m_enable_mask_stack;
     std::optional<ShaderEnableBit> m_shader_enable_bit = std::nullopt;
@@ -206,6 +228,40 @@ class EmulateCallbacksBase
     EmulateStateTracker m_state_tracker;
 };
 
+//--------------------------------------------------------------------------------------------------
+// Fans out a single emulation pass to several callback consumers, so that the submits are only
+// walked once no matter how many consumers are interested in them. Consumers are invoked in the
+// order they were added, and each keeps its own EmulateStateTracker.
+class EmulateCallbacksMultiplexer : public EmulateCallbacksBase
+{
+ public:
+    ~EmulateCallbacksMultiplexer() override = default;
+
+    // The consumer is not owned, and has to outlive this object
+    void AddCallbacks(EmulateCallbacksBase* callbacks);
+
+    bool OnIbStart(uint32_t submit_index, uint32_t ib_index, const IndirectBufferInfo& ib_info,
+                   IbType type) override;
+
+    bool OnIbEnd(uint32_t submit_index, uint32_t ib_index,
+                 const IndirectBufferInfo& ib_info) override;
+
+    bool OnPacket(const IMemoryManager& mem_manager, uint32_t submit_index, uint32_t ib_index,
+                  uint64_t va_addr, Pm4Header header) override;
+
+    void OnSubmitStart(uint32_t submit_index, const SubmitInfo& submit_info) override;
+    void OnSubmitEnd(uint32_t submit_index, const SubmitInfo& submit_info) override;
+
+ private:
+    DiveVector<EmulateCallbacksBase*> m_callbacks;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Number of packets an emulation pass over the submits reaches, or 0 if emulation fails. Only a
+// small fraction of the cost of a pass whose consumers build anything from the packets, so it can
+// be used to size their containers up front
+uint64_t CountPm4Packets(const DiveVector<SubmitInfo>& submits, const IMemoryManager& mem_manager);
+
 //--------------------------------------------------------------------------------------------------
 class EmulatePM4
 {
@@ -18,8 +18,12 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <filesystem>
 #include <optional>
 
+#include "absl/strings/str_format.h"
+#include "dive_core/capture_index.h"
 #include "dive_core/command_hierarchy.h"
 #include "dive_core/gfxr_vulkan_command_hierarchy.h"
 #include "pm4_info.h"
@@ -27,6 +31,27 @@
 namespace Dive
 {
 
+namespace
+{
+
+//--------------------------------------------------------------------------------------------------
+// The packet count that the metadata creator produces is only known once the shared emulation pass
+// is done, which is too late to size the vectors that the pass fills. Counting the packets ahead of
+// it is cheap, since nothing is built from them
+uint64_t GetCommandHierarchyReserveSize(const Pm4CaptureData& pm4_capture_data)
+{
+    uint64_t num_packets = CountPm4Packets(pm4_capture_data.GetSubmits(),
+                                           pm4_capture_data.GetMemoryManager());
+
+    // This is an educated guess that each PM4 packet results in x number of associated
+    // field/register nodes. Overguessing means more memory used during creation. Underguessing
+    // means more allocations. For big captures, this is easily in the multi-millions, so
+    // pre-reserving the space is a signficiant performance win
+    return num_packets * 10;
+}
+
+}  // namespace
+
 // =================================================================================================
 // DataCore
 // =================================================================================================
@@ -39,7 +64,7 @@ CaptureData::LoadResult DataCore::LoadDiveCaptureData(const std::string& file_na
 {
     std::filesystem::path rd_file_path(file_name);
     rd_file_path.replace_extension(".rd");
-    m_capture_metadata = CaptureMetadata();
+    ResetCaptureMetadata();
     return m_dive_capture_data.LoadFiles(rd_file_path.string(), file_name);
 }
 
@@ -47,7 +72,9 @@ CaptureData::LoadResult DataCore::LoadDiveCaptureData(const std::string& file_na
 CaptureData::LoadResult DataCore::LoadPm4CaptureData(const std::string& file_name)
 {
     m_pm4_capture_data = Pm4CaptureData(m_progress_tracker);  // Clear any previously loaded data
-    m_capture_metadata = CaptureMetadata();
+    m_pm4_capture_data.SetDecompressionCacheDirectory(m_rd_decompression_cache_dir);
+    ResetCaptureMetadata();
+    m_pm4_capture_file_name = file_name;
     return m_pm4_capture_data.LoadCaptureFile(file_name);
 }
 
@@ -55,26 +82,54 @@ CaptureData::LoadResult DataCore::LoadPm4CaptureData(const std::string& file_nam
 CaptureData::LoadResult DataCore::LoadGfxrCaptureData(const std::string& file_name)
 {
     m_gfxr_capture_data = GfxrCaptureData();
+    m_gfxr_capture_data.SetLazyCommandArgs(m_lazy_gfxr_command_args);
+    m_gfxr_lazy_args_commands.clear();
     return m_gfxr_capture_data.LoadCaptureFile(file_name);
 }
 
 //--------------------------------------------------------------------------------------------------
-bool DataCore::CreateDiveCommandHierarchy()
+void DataCore::SetRdDecompressionCacheDirectory(const std::string& cache_dir)
 {
-    std::unique_ptr<EmulateStateTracker> state_tracker(new EmulateStateTracker);
+    std::error_code error;
+    if (!cache_dir.empty()) std::filesystem::create_directories(cache_dir, error);
+    m_rd_decompression_cache_dir = cache_dir;
+}
 
-    // Optional: Reserve the internal vectors based on the number of pm4 packets in the capture
-    // This is an educated guess that each PM4 packet results in x number of associated
-    // field/register nodes. Overguessing means more memory used during creation. Underguessing
-    // means more allocations. For big captures, this is easily in the multi-millions, so
-    // pre-reserving the space is a signficiant performance win
-    uint64_t reserve_size = m_capture_metadata.m_num_pm4_packets * 10;
+//--------------------------------------------------------------------------------------------------
+void DataCore::SetUseCaptureIndex(bool use_capture_index)
+{
+    m_use_capture_index = use_capture_index;
+}
+
+//--------------------------------------------------------------------------------------------------
+void DataCore::SetShaderCacheDirectory(const std::string& cache_dir)
+{
+    m_shader_cache->SetDirectory(cache_dir);
+}
+
+//--------------------------------------------------------------------------------------------------
+void DataCore::ResetCaptureMetadata()
+{
+    m_capture_metadata = CaptureMetadata();
+    m_capture_metadata.m_shader_cache = m_shader_cache;
+}
 
-    // Command hierarchy tree creation
+//--------------------------------------------------------------------------------------------------
+bool DataCore::CreateDiveMetaDataAndCommandHierarchy()
+{
+    auto metadata_creator = CaptureMetadataCreator::Create(m_capture_metadata);
+    if (!metadata_creator)
+    {
+        return false;
+    }
 
+    // The metadata creator rides along on the command hierarchy creator's emulation pass, so the
+    // pm4 submits are only walked once by anything that builds from them
+    const Pm4CaptureData& pm4_capture_data = m_dive_capture_data.GetPm4CaptureData();
+    uint64_t reserve_size = GetCommandHierarchyReserveSize(pm4_capture_data);
     DiveCommandHierarchyCreator cmd_hier_creator(m_capture_metadata.m_command_hierarchy);
     if (!cmd_hier_creator.CreateTrees(m_capture_metadata.m_command_hierarchy, m_dive_capture_data,
-                                      true, reserve_size))
+                                      true, reserve_size, metadata_creator.get()))
     {
         return false;
     }
@@ -82,29 +137,39 @@ bool DataCore::CreateDiveCommandHierarchy()
 }
 
 //--------------------------------------------------------------------------------------------------
-bool DataCore::CreatePm4CommandHierarchy()
+bool DataCore::CreatePm4MetaDataAndCommandHierarchy()
 {
-    std::unique_ptr<EmulateStateTracker> state_tracker(new EmulateStateTracker);
-
-    // Optional: Reserve the internal vectors based on the number of pm4 packets in the capture
-    // This is an educated guess that each PM4 packet results in x number of associated
-    // field/register nodes. Overguessing means more memory used during creation. Underguessing
-    // means more allocations. For big captures, this is easily in the multi-millions, so
-    // pre-reserving the space is a signficiant performance win
-    uint64_t reserve_size = m_capture_metadata.m_num_pm4_packets * 10;
-
-    // Command hierarchy tree creation
+    auto metadata_creator = CaptureMetadataCreator::Create(m_capture_metadata);
+    if (!metadata_creator)
+    {
+        return false;
+    }
     auto cmd_hier_creator =
         CommandHierarchyCreator::Create(m_capture_metadata.m_command_hierarchy, m_pm4_capture_data);
     if (!cmd_hier_creator)
     {
         return false;
     }
-    if (!cmd_hier_creator->CreateTrees(m_pm4_capture_data,
-                                       /*flatten_chain_nodes=*/true, reserve_size))
+
+    uint64_t reserve_size = GetCommandHierarchyReserveSize(m_pm4_capture_data);
+    if (!cmd_hier_creator->CreateTrees(/*flatten_chain_nodes=*/true, /*createTopologies=*/false,
+                                       reserve_size))
     {
         return false;
     }
+
+    // Emulate the submits once, feeding both the metadata and the command hierarchy creators
+    EmulateCallbacksMultiplexer multiplexer;
+    multiplexer.AddCallbacks(metadata_creator.get());
+    multiplexer.AddCallbacks(cmd_hier_creator.get());
+    if (!multiplexer.ProcessSubmits(m_pm4_capture_data.GetSubmits(),
+                                    m_pm4_capture_data.GetMemoryManager()))
+    {
+        return false;
+    }
+
+    // Convert the info gathered during emulation into CommandHierarchy's topologies
+    cmd_hier_creator->CreateTopologies();
     return true;
 }
 
@@ -117,9 +182,27 @@ bool DataCore::CreateGfxrCommandHierarchy()
     {
         return false;
     }
+    m_gfxr_lazy_args_commands = vk_cmd_creator.TakeLazyArgsCommands();
     return true;
 }
 
+//--------------------------------------------------------------------------------------------------
+absl::StatusOr<nlohmann::ordered_json> DataCore::GetGfxrCommandArgs(
+    uint64_t node_index) const
+{
+    auto it = std::lower_bound(m_gfxr_lazy_args_commands.begin(), m_gfxr_lazy_args_commands.end(),
+                               node_index,
+                               [](const auto& command, uint64_t index) {
+                                   return command.first < index;
+                               });
+    if (it == m_gfxr_lazy_args_commands.end() || it->first != node_index)
+    {
+        return absl::NotFoundError(
+            absl::StrFormat("Node %d has no lazily loaded gfxr args", node_index));
+    }
+    return m_gfxr_capture_data.GetCommandArgs(*it->second);
+}
+
 //--------------------------------------------------------------------------------------------------
 bool DataCore::CreateDiveMetaData()
 {
@@ -161,12 +244,7 @@ bool DataCore::ParseDiveCaptureData()
         m_progress_tracker->sendMessage("Processing command buffers...");
     }
 
-    if (!CreateDiveMetaData())
-    {
-        return false;
-    }
-
-    if (!CreateDiveCommandHierarchy())
+    if (!CreateDiveMetaDataAndCommandHierarchy())
     {
         return false;
     }
@@ -177,21 +255,33 @@ bool DataCore::ParseDiveCaptureData()
 //--------------------------------------------------------------------------------------------------
 bool DataCore::ParsePm4CaptureData()
 {
+    if (m_use_capture_index)
+    {
+        if (m_progress_tracker)
+        {
+            m_progress_tracker->sendMessage("Loading capture index...");
+        }
+        if (CaptureIndex::Load(m_pm4_capture_file_name, m_pm4_capture_data, m_capture_metadata))
+        {
+            return true;
+        }
+    }
+
     if (m_progress_tracker)
     {
         m_progress_tracker->sendMessage("Processing command buffers...");
     }
 
-    if (!CreatePm4MetaData())
+    if (!CreatePm4MetaDataAndCommandHierarchy())
     {
         return false;
     }
 
-    if (!CreatePm4CommandHierarchy())
+    // Failing to write the index only means the next load has to process the capture again
+    if (m_use_capture_index)
     {
-        return false;
+        CaptureIndex::Save(m_pm4_capture_file_name, m_capture_metadata);
     }
-
     return true;
 }
 
@@ -445,12 +535,15 @@ bool CaptureMetadataCreator::HandleShaders(const IMemoryManager& mem_manager, ui
                 else
                 {
                     // We haven't seen this shader address before, so we need to create the shader
-                    // info.
+                    // info. Its disassembly is still shared with the shaders that have the same
+                    // code at other addresses, through the shader cache.
                     uint32_t shader_index =
                         static_cast<uint32_t>(m_capture_metadata.m_shaders.size());
 
+                    ShaderCache* shader_cache = m_capture_metadata.m_shader_cache.get();
                     m_capture_metadata.m_shaders.emplace_back(mem_manager, submit_index, addr,
-                                                              &cur_event_info.m_metadata_log);
+                                                              &cur_event_info.m_metadata_log,
+                                                              shader_cache);
                     m_shader_addrs.insert(std::make_pair(addr, shader_index));
 
                     // Add the shader index to the EventInfo
@@ -487,21 +580,21 @@ void CaptureMetadataCreator::FillResolveOrClearEventStateInfo(
     EventStateInfo::Iterator event_state_it)
 {
     uint32_t rb_resolve_gmem_buffer_base_reg_offset =
-        GetRegOffsetByName("RB_RESOLVE_GMEM_BUFFER_BASE");
+        GetRegOffset(HotReg::RB_RESOLVE_GMEM_BUFFER_BASE);
     if (m_state_tracker.IsRegSet(rb_resolve_gmem_buffer_base_reg_offset))
     {
         event_state_it->SetResolveBaseGmem(
             m_state_tracker.GetRegValue(rb_resolve_gmem_buffer_base_reg_offset));
     }
 
-    uint32_t rb_resolve_cntl_1_reg_offset = GetRegOffsetByName("RB_RESOLVE_CNTL_1");
+    uint32_t rb_resolve_cntl_1_reg_offset = GetRegOffset(HotReg::RB_RESOLVE_CNTL_1);
     DIVE_ASSERT(rb_resolve_cntl_1_reg_offset != kInvalidRegOffset);
     if (m_state_tracker.IsRegSet(rb_resolve_cntl_1_reg_offset))
     {
         // Assumption: These are all set together. All-or-nothing.
         RB_RESOLVE_CNTL_1 rb_resolve_cntl_1_reg;
         RB_RESOLVE_CNTL_2 rb_resolve_cntl_2_reg;
-        uint32_t rb_resolve_cntl_2_reg_offset = GetRegOffsetByName("RB_RESOLVE_CNTL_2");
+        uint32_t rb_resolve_cntl_2_reg_offset = GetRegOffset(HotReg::RB_RESOLVE_CNTL_2);
         if (m_state_tracker.IsRegSet(rb_resolve_cntl_2_reg_offset))
         {
             rb_resolve_cntl_1_reg.u32All =
@@ -523,7 +616,7 @@ void CaptureMetadataCreator::FillResolveOrClearEventStateInfo(
 void CaptureMetadataCreator::FillResolveEventStateInfo(EventStateInfo::Iterator event_state_it)
 {
     uint32_t rb_resolve_sysmem_buffer_base_reg_offset =
-        GetRegOffsetByName("RB_RESOLVE_SYSTEM_BUFFER_BASE");
+        GetRegOffset(HotReg::RB_RESOLVE_SYSTEM_BUFFER_BASE);
     if (m_state_tracker.IsRegSet(rb_resolve_sysmem_buffer_base_reg_offset))
     {
         uint64_t addr = m_state_tracker.GetReg64Value(rb_resolve_sysmem_buffer_base_reg_offset);
@@ -539,7 +632,7 @@ void CaptureMetadataCreator::FillInputAssemblyState(EventStateInfo::Iterator eve
 {
     // note that primtive topology is no longer set in the context regs,
     // it is set as part of the drawcall pm4 (see tu_draw_initiator)
-    uint32_t vpc_pc_cntl_reg_offset = GetRegOffsetByName("PC_CNTL");
+    uint32_t vpc_pc_cntl_reg_offset = GetRegOffset(HotReg::PC_CNTL);
     if (m_state_tracker.IsRegSet(vpc_pc_cntl_reg_offset))
     {
         VPC_PC_CNTL vpc_pc_cntl;
@@ -551,7 +644,7 @@ void CaptureMetadataCreator::FillInputAssemblyState(EventStateInfo::Iterator eve
 //--------------------------------------------------------------------------------------------------
 void CaptureMetadataCreator::FillTessellationState(EventStateInfo::Iterator event_state_it)
 {
-    uint32_t pc_hs_param_reg_offset = GetRegOffsetByName("PC_HS_PARAM_1");
+    uint32_t pc_hs_param_reg_offset = GetRegOffset(HotReg::PC_HS_PARAM_1);
     if (m_state_tracker.IsRegSet(pc_hs_param_reg_offset))
     {
         PC_HS_PARAM_1 pc_hs_param;
@@ -565,7 +658,7 @@ void CaptureMetadataCreator::FillViewportState(EventStateInfo::Iterator event_st
 {
     // Check if viewport is set. Up to 16 of them can be set.
     uint32_t viewport_id = 0;
-    uint32_t viewport_reg_start = GetRegOffsetByName("GRAS_CL_VIEWPORT0_XOFFSET");
+    uint32_t viewport_reg_start = GetRegOffset(HotReg::GRAS_CL_VIEWPORT0_XOFFSET);
     DIVE_ASSERT(viewport_reg_start != kInvalidRegOffset);
     while (viewport_id < 16 && m_state_tracker.IsRegSet(viewport_reg_start + 6 * viewport_id))
     {
@@ -604,7 +697,7 @@ void CaptureMetadataCreator::FillViewportState(EventStateInfo::Iterator event_st
     // Check if scissor is set. Up to 16 of them can be set.
     uint16_t scissor_id = 0;
     // TODO(wangra): there is also GRAS_SC_SCREEN_SCISSOR0_TL
-    uint32_t scissor_reg_start = GetRegOffsetByName("GRAS_SC_VIEWPORT_SCISSOR0_TL");
+    uint32_t scissor_reg_start = GetRegOffset(HotReg::GRAS_SC_VIEWPORT_SCISSOR0_TL);
     DIVE_ASSERT(scissor_reg_start != kInvalidRegOffset);
     while (scissor_id < 16 && m_state_tracker.IsRegSet(scissor_reg_start + 2 * scissor_id))
     {
@@ -632,7 +725,7 @@ void CaptureMetadataCreator::FillViewportState(EventStateInfo::Iterator event_st
 //--------------------------------------------------------------------------------------------------
 void CaptureMetadataCreator::FillRasterizerState(EventStateInfo::Iterator event_state_it)
 {
-    uint32_t gras_cl_cntl_reg_offset = GetRegOffsetByName("GRAS_CL_CNTL");
+    uint32_t gras_cl_cntl_reg_offset = GetRegOffset(HotReg::GRAS_CL_CNTL);
     if (m_state_tracker.IsRegSet(gras_cl_cntl_reg_offset))
     {
         GRAS_CL_CNTL gras_cl_clip_cntl;
@@ -640,7 +733,7 @@ void CaptureMetadataCreator::FillRasterizerState(EventStateInfo::Iterator event_
         event_state_it->SetDepthClampEnabled(gras_cl_clip_cntl.bitfields.Z_CLAMP_ENABLE != 1);
     }
 
-    uint32_t vpc_rast_stream_cntl_reg_offset = GetRegOffsetByName("VPC_RAST_STREAM_CNTL");
+    uint32_t vpc_rast_stream_cntl_reg_offset = GetRegOffset(HotReg::VPC_RAST_STREAM_CNTL);
     if (m_state_tracker.IsRegSet(vpc_rast_stream_cntl_reg_offset))
     {
         VPC_RAST_STREAM_CNTL vpc_rast_stream_cntl;
@@ -650,7 +743,7 @@ void CaptureMetadataCreator::FillRasterizerState(EventStateInfo::Iterator event_
 
     // TODO(wangra): Should we also check VPC_POLYGON_MODE and VPC_POLYGON_MODE2?
     // what is the difference between PC and VPC?
-    uint32_t pc_dgen_rast_cntl_reg_offset = GetRegOffsetByName("PC_DGEN_RAST_CNTL");
+    uint32_t pc_dgen_rast_cntl_reg_offset = GetRegOffset(HotReg::PC_DGEN_RAST_CNTL);
     if (m_state_tracker.IsRegSet(pc_dgen_rast_cntl_reg_offset))
     {
         PC_DGEN_RAST_CNTL pc_dgen_rast_cntl;
@@ -671,7 +764,7 @@ void CaptureMetadataCreator::FillRasterizerState(EventStateInfo::Iterator event_
         };
     }
 
-    uint32_t gras_su_cntl_reg_offset = GetRegOffsetByName("GRAS_SU_CNTL");
+    uint32_t gras_su_cntl_reg_offset = GetRegOffset(HotReg::GRAS_SU_CNTL);
     if (m_state_tracker.IsRegSet(gras_su_cntl_reg_offset))
     {
         GRAS_SU_CNTL gras_su_cntl;
@@ -690,7 +783,7 @@ void CaptureMetadataCreator::FillRasterizerState(EventStateInfo::Iterator event_
     }
 
     uint32_t gras_su_poly_offset_offset_reg_offset =
-        GetRegOffsetByName("GRAS_SU_POLY_OFFSET_OFFSET");
+        GetRegOffset(HotReg::GRAS_SU_POLY_OFFSET_OFFSET);
     if (m_state_tracker.IsRegSet(gras_su_poly_offset_offset_reg_offset))
     {
         GRAS_SU_POLY_OFFSET_OFFSET gras_su_poly_offset_offset;
@@ -700,7 +793,7 @@ void CaptureMetadataCreator::FillRasterizerState(EventStateInfo::Iterator event_
     }
 
     uint32_t gras_su_poly_offset_clamp_reg_offset =
-        GetRegOffsetByName("GRAS_SU_POLY_OFFSET_OFFSET_CLAMP");
+        GetRegOffset(HotReg::GRAS_SU_POLY_OFFSET_OFFSET_CLAMP);
     if (m_state_tracker.IsRegSet(gras_su_poly_offset_clamp_reg_offset))
     {
         GRAS_SU_POLY_OFFSET_OFFSET_CLAMP gras_su_poly_offset_clamp;
@@ -709,7 +802,7 @@ void CaptureMetadataCreator::FillRasterizerState(EventStateInfo::Iterator event_
         event_state_it->SetDepthBiasClamp(gras_su_poly_offset_clamp.f32All);
     }
 
-    uint32_t gras_su_poly_offset_scale_reg_offset = GetRegOffsetByName("GRAS_SU_POLY_OFFSET_SCALE");
+    uint32_t gras_su_poly_offset_scale_reg_offset = GetRegOffset(HotReg::GRAS_SU_POLY_OFFSET_SCALE);
     if (m_state_tracker.IsRegSet(gras_su_poly_offset_scale_reg_offset))
     {
         GRAS_SU_POLY_OFFSET_SCALE gras_su_poly_offset_scale;
@@ -722,7 +815,7 @@ void CaptureMetadataCreator::FillRasterizerState(EventStateInfo::Iterator event_
 //--------------------------------------------------------------------------------------------------
 void CaptureMetadataCreator::FillMultisamplingState(EventStateInfo::Iterator event_state_it)
 {
-    uint32_t gras_sc_ras_msaa_cntl_reg_offset = GetRegOffsetByName("GRAS_SC_RAS_MSAA_CNTL");
+    uint32_t gras_sc_ras_msaa_cntl_reg_offset = GetRegOffset(HotReg::GRAS_SC_RAS_MSAA_CNTL);
     if (m_state_tracker.IsRegSet(gras_sc_ras_msaa_cntl_reg_offset))
     {
         GRAS_SC_RAS_MSAA_CNTL gras_sc_ras_msaa_cntl;
@@ -733,7 +826,7 @@ void CaptureMetadataCreator::FillMultisamplingState(EventStateInfo::Iterator eve
     }
 
     // TODO(wangra): do we need to check SP_BLEND_CNTL?
-    uint32_t rb_blend_cntl_reg_offset = GetRegOffsetByName("RB_BLEND_CNTL");
+    uint32_t rb_blend_cntl_reg_offset = GetRegOffset(HotReg::RB_BLEND_CNTL);
     if (m_state_tracker.IsRegSet(rb_blend_cntl_reg_offset))
     {
         RB_BLEND_CNTL rb_blend_cntl;
@@ -746,7 +839,7 @@ void CaptureMetadataCreator::FillMultisamplingState(EventStateInfo::Iterator eve
 //--------------------------------------------------------------------------------------------------
 void CaptureMetadataCreator::FillDepthState(EventStateInfo::Iterator event_state_it)
 {
-    uint32_t rb_depth_cntl_reg_offset = GetRegOffsetByName("RB_DEPTH_CNTL");
+    uint32_t rb_depth_cntl_reg_offset = GetRegOffset(HotReg::RB_DEPTH_CNTL);
     if (m_state_tracker.IsRegSet(rb_depth_cntl_reg_offset))
     {
         RB_DEPTH_CNTL rb_depth_cntl;
@@ -758,7 +851,7 @@ void CaptureMetadataCreator::FillDepthState(EventStateInfo::Iterator event_state
         event_state_it->SetDepthBoundsTestEnabled(rb_depth_cntl.bitfields.Z_BOUNDS_ENABLE == 1);
 
         {
-            uint32_t rb_depth_bound_min_reg_offset = GetRegOffsetByName("RB_DEPTH_BOUND_MIN");
+            uint32_t rb_depth_bound_min_reg_offset = GetRegOffset(HotReg::RB_DEPTH_BOUND_MIN);
             if (m_state_tracker.IsRegSet(rb_depth_bound_min_reg_offset))
             {
                 RB_DEPTH_BOUND_MIN rb_depth_bounds_min;
@@ -766,7 +859,7 @@ void CaptureMetadataCreator::FillDepthState(EventStateInfo::Iterator event_state
                     m_state_tracker.GetRegValue(rb_depth_bound_min_reg_offset);
                 event_state_it->SetMinDepthBounds(rb_depth_bounds_min.f32All);
             }
-            uint32_t rb_depth_bound_max_reg_offset = GetRegOffsetByName("RB_DEPTH_BOUND_MAX");
+            uint32_t rb_depth_bound_max_reg_offset = GetRegOffset(HotReg::RB_DEPTH_BOUND_MAX);
             if (m_state_tracker.IsRegSet(rb_depth_bound_max_reg_offset))
             {
                 RB_DEPTH_BOUND_MAX rb_depth_bound_max;
@@ -777,7 +870,7 @@ void CaptureMetadataCreator::FillDepthState(EventStateInfo::Iterator event_state
         }
     }
 
-    uint32_t rb_stencil_cntl_reg_offset = GetRegOffsetByName("RB_STENCIL_CNTL");
+    uint32_t rb_stencil_cntl_reg_offset = GetRegOffset(HotReg::RB_STENCIL_CNTL);
     if (m_state_tracker.IsRegSet(rb_stencil_cntl_reg_offset))
     {
         RB_STENCIL_CNTL rb_stencil_cntl;
@@ -803,7 +896,7 @@ void CaptureMetadataCreator::FillDepthState(EventStateInfo::Iterator event_state
         // Be careful!!! Here we assume the enum `VkCompareOp` matches exactly `adreno_compare_func`
         back.compareOp = static_cast<VkCompareOp>(rb_stencil_cntl.bitfields.FUNC_BF);
 
-        uint32_t rb_stencil_ref_cntl_reg_offset = GetRegOffsetByName("RB_STENCIL_REF_CNTL");
+        uint32_t rb_stencil_ref_cntl_reg_offset = GetRegOffset(HotReg::RB_STENCIL_REF_CNTL);
         if (m_state_tracker.IsRegSet(rb_stencil_ref_cntl_reg_offset))
         {
             RB_STENCIL_REF_CNTL rb_stencil_ref_cntl;
@@ -813,7 +906,7 @@ void CaptureMetadataCreator::FillDepthState(EventStateInfo::Iterator event_state
             back.reference = rb_stencil_ref_cntl.bitfields.BFREF;
         }
 
-        uint32_t rb_stencil_mask_reg_offset = GetRegOffsetByName("RB_STENCIL_MASK");
+        uint32_t rb_stencil_mask_reg_offset = GetRegOffset(HotReg::RB_STENCIL_MASK);
         if (m_state_tracker.IsRegSet(rb_stencil_mask_reg_offset))
         {
             RB_STENCIL_MASK rb_stencil_mask;
@@ -821,7 +914,7 @@ void CaptureMetadataCreator::FillDepthState(EventStateInfo::Iterator event_state
             front.compareMask = rb_stencil_mask.bitfields.MASK;
             back.compareMask = rb_stencil_mask.bitfields.BFMASK;
         }
-        uint32_t rb_stencil_write_mask_reg_offset = GetRegOffsetByName("RB_STENCIL_WRITE_MASK");
+        uint32_t rb_stencil_write_mask_reg_offset = GetRegOffset(HotReg::RB_STENCIL_WRITE_MASK);
         if (m_state_tracker.IsRegSet(rb_stencil_write_mask_reg_offset))
         {
             RB_STENCIL_WRITE_MASK rb_stencil_write_mask;
@@ -839,7 +932,7 @@ void CaptureMetadataCreator::FillDepthState(EventStateInfo::Iterator event_state
 void CaptureMetadataCreator::FillColorBlendState(EventStateInfo::Iterator event_state_it)
 {
     uint32_t rt_id = 0;
-    uint32_t rb_mrt_ctl_reg_start = GetRegOffsetByName("RB_MRT0_CONTROL");
+    uint32_t rb_mrt_ctl_reg_start = GetRegOffset(HotReg::RB_MRT0_CONTROL);
     DIVE_ASSERT(rb_mrt_ctl_reg_start != kInvalidRegOffset);
     constexpr uint32_t kElemCount = 8;
     while (rt_id < 8 && m_state_tracker.IsRegSet(rb_mrt_ctl_reg_start + kElemCount * rt_id))
@@ -914,15 +1007,15 @@ void CaptureMetadataCreator::FillColorBlendState(EventStateInfo::Iterator event_
     // Assumption: The ICD sets all of the color channels together. So it is enough
     // to check whether just 1 of them is set or not. It's all or nothing.
     uint32_t rb_blend_constant_red_fp32_reg_offset =
-        GetRegOffsetByName("RB_BLEND_CONSTANT_RED_FP32");
+        GetRegOffset(HotReg::RB_BLEND_CONSTANT_RED_FP32);
     if (m_state_tracker.IsRegSet(rb_blend_constant_red_fp32_reg_offset))
     {
         uint32_t rb_blend_constant_green_fp32_offset =
-            GetRegOffsetByName("RB_BLEND_CONSTANT_GREEN_FP32");
+            GetRegOffset(HotReg::RB_BLEND_CONSTANT_GREEN_FP32);
         uint32_t rb_blend_constant_blue_fp32_offset =
-            GetRegOffsetByName("RB_BLEND_CONSTANT_BLUE_FP32");
+            GetRegOffset(HotReg::RB_BLEND_CONSTANT_BLUE_FP32);
         uint32_t rb_blend_constant_alpha_fp32_offset =
-            GetRegOffsetByName("RB_BLEND_CONSTANT_ALPHA_FP32");
+            GetRegOffset(HotReg::RB_BLEND_CONSTANT_ALPHA_FP32);
 
         RB_BLEND_CONSTANT_RED_FP32 rb_blend_red;
         RB_BLEND_CONSTANT_GREEN_FP32 rb_blend_green;
@@ -943,7 +1036,7 @@ void CaptureMetadataCreator::FillColorBlendState(EventStateInfo::Iterator event_
 void CaptureMetadataCreator::FillHardwareSpecificStates(EventStateInfo::Iterator event_state_it)
 {
     // LRZ related
-    uint32_t gras_lrz_cntl_reg_offset = GetRegOffsetByName("GRAS_LRZ_CNTL");
+    uint32_t gras_lrz_cntl_reg_offset = GetRegOffset(HotReg::GRAS_LRZ_CNTL);
     if (m_state_tracker.IsRegSet(gras_lrz_cntl_reg_offset))
     {
         GRAS_LRZ_CNTL gras_lrz_cntl;
@@ -963,7 +1056,7 @@ void CaptureMetadataCreator::FillHardwareSpecificStates(EventStateInfo::Iterator
         }
     }
 
-    uint32_t gras_su_depth_plane_cntl_reg_offset = GetRegOffsetByName("GRAS_SU_DEPTH_PLANE_CNTL");
+    uint32_t gras_su_depth_plane_cntl_reg_offset = GetRegOffset(HotReg::GRAS_SU_DEPTH_PLANE_CNTL);
     if (m_state_tracker.IsRegSet(gras_su_depth_plane_cntl_reg_offset))
     {
         GRAS_SU_DEPTH_PLANE_CNTL gras_su_depth_plane_cntl;
@@ -974,7 +1067,7 @@ void CaptureMetadataCreator::FillHardwareSpecificStates(EventStateInfo::Iterator
     }
 
     // binning related
-    uint32_t gras_sc_bin_cntl_reg_offset = GetRegOffsetByName("GRAS_SC_BIN_CNTL");
+    uint32_t gras_sc_bin_cntl_reg_offset = GetRegOffset(HotReg::GRAS_SC_BIN_CNTL);
     if (m_state_tracker.IsRegSet(gras_sc_bin_cntl_reg_offset))
     {
         const RegInfo* reg_info = GetRegInfo(gras_sc_bin_cntl_reg_offset);
@@ -1000,7 +1093,7 @@ void CaptureMetadataCreator::FillHardwareSpecificStates(EventStateInfo::Iterator
             event_state_it->SetBuffersLocation(buffers_location);
         }
     }
-    uint32_t gras_sc_window_scissor_tl_reg_offset = GetRegOffsetByName("GRAS_SC_WINDOW_SCISSOR_TL");
+    uint32_t gras_sc_window_scissor_tl_reg_offset = GetRegOffset(HotReg::GRAS_SC_WINDOW_SCISSOR_TL);
     if (m_state_tracker.IsRegSet(gras_sc_window_scissor_tl_reg_offset))
     {
         GRAS_SC_WINDOW_SCISSOR_TL gras_sc_window_scissor_tl;
@@ -1009,7 +1102,7 @@ void CaptureMetadataCreator::FillHardwareSpecificStates(EventStateInfo::Iterator
         event_state_it->SetWindowScissorTLX(gras_sc_window_scissor_tl.bitfields.X);
         event_state_it->SetWindowScissorTLY(gras_sc_window_scissor_tl.bitfields.Y);
     }
-    uint32_t gras_sc_window_scissor_br_reg_offset = GetRegOffsetByName("GRAS_SC_WINDOW_SCISSOR_BR");
+    uint32_t gras_sc_window_scissor_br_reg_offset = GetRegOffset(HotReg::GRAS_SC_WINDOW_SCISSOR_BR);
     if (m_state_tracker.IsRegSet(gras_sc_window_scissor_br_reg_offset))
     {
         GRAS_SC_WINDOW_SCISSOR_BR gras_sc_window_scissor_br;
@@ -1020,7 +1113,7 @@ void CaptureMetadataCreator::FillHardwareSpecificStates(EventStateInfo::Iterator
     }
 
     // helper lane related
-    uint32_t sp_ps_cntl_0_reg_offset = GetRegOffsetByName("SP_PS_CNTL_0");
+    uint32_t sp_ps_cntl_0_reg_offset = GetRegOffset(HotReg::SP_PS_CNTL_0);
     if (m_state_tracker.IsRegSet(sp_ps_cntl_0_reg_offset))
     {
         SP_PS_CNTL_0 sp_ps_cntl_0;
@@ -1041,7 +1134,7 @@ void CaptureMetadataCreator::FillHardwareSpecificStates(EventStateInfo::Iterator
     // field is enabled or not for current GPU
     uint32_t rt_id = 0;
     constexpr uint32_t kElemCount = 8;
-    uint32_t rb_mrt_buf_info_reg_start = GetRegOffsetByName("RB_MRT0_BUF_INFO");
+    uint32_t rb_mrt_buf_info_reg_start = GetRegOffset(HotReg::RB_MRT0_BUF_INFO);
     DIVE_ASSERT(rb_mrt_buf_info_reg_start != kInvalidRegOffset);
     while (rt_id < 8 && m_state_tracker.IsRegSet(rb_mrt_buf_info_reg_start + kElemCount * rt_id))
     {
@@ -1059,7 +1152,7 @@ void CaptureMetadataCreator::FillHardwareSpecificStates(EventStateInfo::Iterator
 
     if (GetGPUVariantType() >= kA7XX)
     {
-        uint32_t rb_depth_buf_info_offset = GetRegOffsetByName("RB_DEPTH_BUFFER_INFO");
+        uint32_t rb_depth_buf_info_offset = GetRegOffset(HotReg::RB_DEPTH_BUFFER_INFO);
         DIVE_ASSERT(rb_depth_buf_info_offset != kInvalidRegOffset);
         if (m_state_tracker.IsRegSet(rb_depth_buf_info_offset))
         {
@@ -27,6 +27,7 @@
 #include "dive_command_hierarchy.h"
 #include "event_state.h"
 #include "gfxr_capture_data.h"
+#include "gfxr_vulkan_command_hierarchy.h"
 #include "pm4_capture_data.h"
 #include "progress_tracker.h"
 
@@ -40,6 +41,10 @@ struct CaptureMetadata
     // Information about the command buffers, represented in a tree hierarchy
     CommandHierarchy m_command_hierarchy;
 
+    // Where the shaders look up and add their disassembly. Declared before m_shaders, which
+    // points to it
+    std::shared_ptr<ShaderCache> m_shader_cache;
+
     // Information about each shader in the capture
     // Note: deque is used here since Disassembly is not copyable nor movable.
     std::deque<Disassembly> m_shaders;
@@ -60,7 +65,7 @@ struct CaptureMetadata
 class DataCore
 {
  protected:
-    ProgressTracker* m_progress_tracker;
+    ProgressTracker* m_progress_tracker = nullptr;
 
  public:
     DataCore() = default;
@@ -72,6 +77,32 @@ class DataCore
     CaptureData::LoadResult LoadPm4CaptureData(const std::string& file_name);
     CaptureData::LoadResult LoadGfxrCaptureData(const std::string& file_name);
 
+    // If set, compressed .rd captures are decompressed into this directory once, and loaded from
+    // there. The directory is created if needed, and its size is bounded, see
+    // Pm4CaptureData::SetDecompressionCacheDirectory()
+    void SetRdDecompressionCacheDirectory(const std::string& cache_dir);
+
+    // If set, ParsePm4CaptureData() reuses the metadata from the capture's index file when it is
+    // still valid, and writes a new index file otherwise. See CaptureIndex
+    void SetUseCaptureIndex(bool use_capture_index);
+
+    // If set, LoadGfxrCaptureData() only keeps the args of the commands that name their nodes, and
+    // the command hierarchy has no arg nodes. Use GetGfxrCommandArgs() instead. See
+    // GfxrCaptureData::SetLazyCommandArgs
+    void SetLazyGfxrCommandArgs(bool lazy) { m_lazy_gfxr_command_args = lazy; }
+
+    // Returns the args of the gfxr command of the node, decoded from the file if they were not
+    // kept. Returns a NotFoundError if the node has no lazily loaded args, e.g. if it is not a
+    // command node or if its args are arg nodes of the command hierarchy
+    absl::StatusOr<nlohmann::ordered_json> GetGfxrCommandArgs(uint64_t node_index) const;
+
+    // If set, shader disassembly is also cached in this directory, for later sessions. See
+    // ShaderCache
+    void SetShaderCacheDirectory(const std::string& cache_dir);
+
+    // Shader disassembly shared by all the captures loaded by this DataCore
+    const ShaderCache& GetShaderCache() const { return *m_shader_cache; }
+
     // Parse the capture to generate info that describes the capture
     bool ParseDiveCaptureData();
     bool ParsePm4CaptureData();
@@ -99,16 +130,32 @@ class DataCore
     const CaptureMetadata& GetCaptureMetadata() const;
 
  private:
+    // Create meta data and command hierarchy from the captured data in a single emulation pass
+    bool CreateDiveMetaDataAndCommandHierarchy();
+    bool CreatePm4MetaDataAndCommandHierarchy();
+
     // Create command hierarchy from the captured data
-    bool CreateDiveCommandHierarchy();
-    bool CreatePm4CommandHierarchy();
     bool CreateGfxrCommandHierarchy();
+
+    // Clear the metadata of the previously loaded capture
+    void ResetCaptureMetadata();
+
     // The relatively raw captured dive data (memory & submit blocks)
     DiveCaptureData m_dive_capture_data;
     // The relatively raw captured pm4 data (memory & submit blocks)
     Pm4CaptureData m_pm4_capture_data;
+    // Where compressed .rd captures are decompressed to, if anywhere
+    std::string m_rd_decompression_cache_dir;
+    // Whether to use the index file of .rd captures, and the name of the loaded .rd capture
+    bool m_use_capture_index = false;
+    std::string m_pm4_capture_file_name;
     // The relatively raw captured gfxr data
     GfxrCaptureData m_gfxr_capture_data;
+    // Whether the gfxr args are loaded lazily, and the commands of the nodes without arg nodes
+    bool m_lazy_gfxr_command_args = false;
+    GfxrVulkanCommandHierarchyCreator::LazyArgsCommands m_gfxr_lazy_args_commands;
+    // Outlives the loaded captures, so that their shaders are only disassembled once
+    std::shared_ptr<ShaderCache> m_shader_cache = std::make_shared<ShaderCache>();
 
     // Metadata for the capture data in m_capture_data
     CaptureMetadata m_capture_metadata;
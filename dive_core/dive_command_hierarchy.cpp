@@ -34,7 +34,8 @@ DiveCommandHierarchyCreator::DiveCommandHierarchyCreator(CommandHierarchy& comma
 bool DiveCommandHierarchyCreator::CreateTrees(Dive::CommandHierarchy& command_hierarchy,
                                               DiveCaptureData& dive_capture_data,
                                               bool flatten_chain_nodes,
-                                              std::optional<uint64_t> reserve_size)
+                                              std::optional<uint64_t> reserve_size,
+                                              EmulateCallbacksBase* additional_callbacks)
 {
     auto pm4_command_hierarchy_creator =
         CommandHierarchyCreator::Create(m_command_hierarchy, dive_capture_data.GetPm4CaptureData());
@@ -50,7 +51,13 @@ bool DiveCommandHierarchyCreator::CreateTrees(Dive::CommandHierarchy& command_hi
                                                /*createTopologies=*/false, reserve_size);
     gfxr_command_hierarchy_creator->CreateTrees(/*used_in_mixed_command_hierarchy=*/true);
 
-    bool result = pm4_command_hierarchy_creator->ProcessSubmits(
+    EmulateCallbacksMultiplexer multiplexer;
+    if (additional_callbacks != nullptr)
+    {
+        multiplexer.AddCallbacks(additional_callbacks);
+    }
+    multiplexer.AddCallbacks(pm4_command_hierarchy_creator.get());
+    bool result = multiplexer.ProcessSubmits(
         dive_capture_data.GetPm4CaptureData().GetSubmits(),
         dive_capture_data.GetPm4CaptureData().GetMemoryManager());
     if (!result)
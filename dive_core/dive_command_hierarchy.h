@@ -42,8 +42,11 @@ class DiveCommandHierarchyCreator
     // deep tree of chain nodes when a capture chains together tons of IBs.
     // Optional: Passing a reserve_size will allow the creator to pre-reserve the memory needed and
     // potentially speed up the creation
+    // Optional: Passing additional_callbacks will have them invoked during the same pm4 emulation
+    // pass, ahead of the command hierarchy creator
     bool CreateTrees(Dive::CommandHierarchy& command_hierarchy, DiveCaptureData& dive_capture_data,
-                     bool flatten_chain_nodes, std::optional<uint64_t> reserve_size);
+                     bool flatten_chain_nodes, std::optional<uint64_t> reserve_size,
+                     EmulateCallbacksBase* additional_callbacks = nullptr);
 
     void CreateTopologies(CommandHierarchyCreator& pm4_command_hierarchy_creator,
                           GfxrVulkanCommandHierarchyCreator& gfxr_command_hierarchy_creator);
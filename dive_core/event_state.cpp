@@ -29,429 +29,138 @@
 namespace Dive
 {
 
+template <>
+std::unique_ptr<std::max_align_t[]> EventStateInfoT<EventStateInfo_CONFIG>::NewChunk()
+{
+    // Allocated as an array of `max_align_t`, to make sure the chunk is sufficiently aligned for
+    // the type of any possible field. Cleared with memset, since value-initializing `max_align_t`
+    // leaves its padding bytes undefined
+    size_t chunk_size = (kChunkBytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+    auto chunk = std::unique_ptr<std::max_align_t[]>(new std::max_align_t[chunk_size]);
+    memset(chunk.get(), 0, sizeof(std::max_align_t) * chunk_size);
+    return chunk;
+}
+
 template <>
 void EventStateInfoT<EventStateInfo_CONFIG>::Reserve(
     typename EventStateInfo::Id::basic_type new_cap)
 {
-    if (new_cap <= m_cap) return;
-
-    // Round up to next aligned capacity. The address of each field array is:
-    //     `m_buffer + field_offset * cap`
-    // - `m_buffer` satisfies the alignment of any basic type (from operator new)
-    // - `field_offset` has no alignment constraints at all (fields are tightly packed).
-    // - `cap`  must be aligned to ensure that `field_offset * cap` is aligned
-    new_cap = (new_cap + kAlignment - 1) & ~(kAlignment - 1);
-
-    // Allocate enough memory to store `new_cap` number of elements
-    size_t num_bytes = new_cap * kElemSize;
-    size_t is_set_num_bytes = (new_cap * kNumFields) / 8 + 1;
-    m_is_set_buffer.resize(is_set_num_bytes, 0);
-
-    // Allocate new buffer as an array of `max_align_t`, to make sure the buffer
-    // is sufficiently aligned for the type of any possible field.
-    size_t new_buffer_size = (num_bytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
-    auto new_buffer = std::unique_ptr<std::max_align_t[]>(new std::max_align_t[new_buffer_size]);
-    memset(new_buffer.get(), 0, sizeof(std::max_align_t) * new_buffer_size);
-
-    auto old_topology_ptr = TopologyPtr();
-    auto old_prim_restart_enabled_ptr = PrimRestartEnabledPtr();
-    auto old_patch_control_points_ptr = PatchControlPointsPtr();
-    auto old_viewport_ptr = ViewportPtr();
-    auto old_scissor_ptr = ScissorPtr();
-    auto old_depth_clamp_enabled_ptr = DepthClampEnabledPtr();
-    auto old_rasterizer_discard_enabled_ptr = RasterizerDiscardEnabledPtr();
-    auto old_polygon_mode_ptr = PolygonModePtr();
-    auto old_cull_mode_ptr = CullModePtr();
-    auto old_front_face_ptr = FrontFacePtr();
-    auto old_depth_bias_enabled_ptr = DepthBiasEnabledPtr();
-    auto old_depth_bias_constant_factor_ptr = DepthBiasConstantFactorPtr();
-    auto old_depth_bias_clamp_ptr = DepthBiasClampPtr();
-    auto old_depth_bias_slope_factor_ptr = DepthBiasSlopeFactorPtr();
-    auto old_line_width_ptr = LineWidthPtr();
-    auto old_rasterization_samples_ptr = RasterizationSamplesPtr();
-    auto old_sample_shading_enabled_ptr = SampleShadingEnabledPtr();
-    auto old_min_sample_shading_ptr = MinSampleShadingPtr();
-    auto old_sample_mask_ptr = SampleMaskPtr();
-    auto old_alpha_to_coverage_enabled_ptr = AlphaToCoverageEnabledPtr();
-    auto old_depth_test_enabled_ptr = DepthTestEnabledPtr();
-    auto old_depth_write_enabled_ptr = DepthWriteEnabledPtr();
-    auto old_depth_compare_op_ptr = DepthCompareOpPtr();
-    auto old_depth_bounds_test_enabled_ptr = DepthBoundsTestEnabledPtr();
-    auto old_min_depth_bounds_ptr = MinDepthBoundsPtr();
-    auto old_max_depth_bounds_ptr = MaxDepthBoundsPtr();
-    auto old_stencil_test_enabled_ptr = StencilTestEnabledPtr();
-    auto old_stencil_op_state_front_ptr = StencilOpStateFrontPtr();
-    auto old_stencil_op_state_back_ptr = StencilOpStateBackPtr();
-    auto old_logic_op_enabled_ptr = LogicOpEnabledPtr();
-    auto old_logic_op_ptr = LogicOpPtr();
-    auto old_attachment_ptr = AttachmentPtr();
-    auto old_blend_constant_ptr = BlendConstantPtr();
-    auto old_lrz_enabled_ptr = LRZEnabledPtr();
-    auto old_lrz_write_ptr = LRZWritePtr();
-    auto old_lrz_dir_status_ptr = LRZDirStatusPtr();
-    auto old_lrz_dir_write_ptr = LRZDirWritePtr();
-    auto old_z_test_mode_ptr = ZTestModePtr();
-    auto old_bin_w_ptr = BinWPtr();
-    auto old_bin_h_ptr = BinHPtr();
-    auto old_window_scissor_tlx_ptr = WindowScissorTLXPtr();
-    auto old_window_scissor_tly_ptr = WindowScissorTLYPtr();
-    auto old_window_scissor_brx_ptr = WindowScissorBRXPtr();
-    auto old_window_scissor_bry_ptr = WindowScissorBRYPtr();
-    auto old_render_mode_ptr = RenderModePtr();
-    auto old_buffers_location_ptr = BuffersLocationPtr();
-    auto old_thread_size_ptr = ThreadSizePtr();
-    auto old_enable_all_helper_lanes_ptr = EnableAllHelperLanesPtr();
-    auto old_enable_partial_helper_lanes_ptr = EnablePartialHelperLanesPtr();
-    auto old_ubwc_enabled_ptr = UBWCEnabledPtr();
-    auto old_ubwc_lossless_enabled_ptr = UBWCLosslessEnabledPtr();
-    auto old_ubwc_enabled_on_ds_ptr = UBWCEnabledOnDSPtr();
-    auto old_ubwc_lossless_enabled_on_ds_ptr = UBWCLosslessEnabledOnDSPtr();
-    auto old_resolve_scissor_ptr = ResolveScissorPtr();
-    auto old_resolve_base_gmem_ptr = ResolveBaseGmemPtr();
-    auto old_resolve_base_sysmem_ptr = ResolveBaseSysmemPtr();
-    auto old_resolve_format_ptr = ResolveFormatPtr();
-    auto old_resolve_tile_mode_ptr = ResolveTileModePtr();
-
-    // `old_buffer` keeps the old buffer from being deallocated before we have
-    // copied the data into the new buffer. The old buffer will be deallocated
-    // once `old_buffer` goes out of scope.
-    auto old_buffer(std::move(m_buffer));
-
-    m_buffer = std::move(new_buffer);
-    m_cap = new_cap;
-
-    // Copy all of the data from the old buffer to the new buffer
-    static_assert(std::is_trivially_copyable<uint32_t>::value,
-                  "Field type must be trivially copyable");
-    memcpy(TopologyPtr(), old_topology_ptr, kTopologySize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(PrimRestartEnabledPtr(), old_prim_restart_enabled_ptr, kPrimRestartEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<uint32_t>::value,
-                  "Field type must be trivially copyable");
-    memcpy(PatchControlPointsPtr(), old_patch_control_points_ptr, kPatchControlPointsSize * m_size);
-    static_assert(std::is_trivially_copyable<VkViewport>::value,
-                  "Field type must be trivially copyable");
-    memcpy(ViewportPtr(), old_viewport_ptr, kViewportSize * m_size);
-    static_assert(std::is_trivially_copyable<VkRect2D>::value,
-                  "Field type must be trivially copyable");
-    memcpy(ScissorPtr(), old_scissor_ptr, kScissorSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(DepthClampEnabledPtr(), old_depth_clamp_enabled_ptr, kDepthClampEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(RasterizerDiscardEnabledPtr(), old_rasterizer_discard_enabled_ptr,
-           kRasterizerDiscardEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<VkPolygonMode>::value,
-                  "Field type must be trivially copyable");
-    memcpy(PolygonModePtr(), old_polygon_mode_ptr, kPolygonModeSize * m_size);
-    static_assert(std::is_trivially_copyable<VkCullModeFlags>::value,
-                  "Field type must be trivially copyable");
-    memcpy(CullModePtr(), old_cull_mode_ptr, kCullModeSize * m_size);
-    static_assert(std::is_trivially_copyable<VkFrontFace>::value,
-                  "Field type must be trivially copyable");
-    memcpy(FrontFacePtr(), old_front_face_ptr, kFrontFaceSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(DepthBiasEnabledPtr(), old_depth_bias_enabled_ptr, kDepthBiasEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<float>::value,
-                  "Field type must be trivially copyable");
-    memcpy(DepthBiasConstantFactorPtr(), old_depth_bias_constant_factor_ptr,
-           kDepthBiasConstantFactorSize * m_size);
-    static_assert(std::is_trivially_copyable<float>::value,
-                  "Field type must be trivially copyable");
-    memcpy(DepthBiasClampPtr(), old_depth_bias_clamp_ptr, kDepthBiasClampSize * m_size);
-    static_assert(std::is_trivially_copyable<float>::value,
-                  "Field type must be trivially copyable");
-    memcpy(DepthBiasSlopeFactorPtr(), old_depth_bias_slope_factor_ptr,
-           kDepthBiasSlopeFactorSize * m_size);
-    static_assert(std::is_trivially_copyable<float>::value,
-                  "Field type must be trivially copyable");
-    memcpy(LineWidthPtr(), old_line_width_ptr, kLineWidthSize * m_size);
-    static_assert(std::is_trivially_copyable<VkSampleCountFlagBits>::value,
-                  "Field type must be trivially copyable");
-    memcpy(RasterizationSamplesPtr(), old_rasterization_samples_ptr,
-           kRasterizationSamplesSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(SampleShadingEnabledPtr(), old_sample_shading_enabled_ptr,
-           kSampleShadingEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<float>::value,
-                  "Field type must be trivially copyable");
-    memcpy(MinSampleShadingPtr(), old_min_sample_shading_ptr, kMinSampleShadingSize * m_size);
-    static_assert(std::is_trivially_copyable<VkSampleMask>::value,
-                  "Field type must be trivially copyable");
-    memcpy(SampleMaskPtr(), old_sample_mask_ptr, kSampleMaskSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(AlphaToCoverageEnabledPtr(), old_alpha_to_coverage_enabled_ptr,
-           kAlphaToCoverageEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(DepthTestEnabledPtr(), old_depth_test_enabled_ptr, kDepthTestEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(DepthWriteEnabledPtr(), old_depth_write_enabled_ptr, kDepthWriteEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<VkCompareOp>::value,
-                  "Field type must be trivially copyable");
-    memcpy(DepthCompareOpPtr(), old_depth_compare_op_ptr, kDepthCompareOpSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(DepthBoundsTestEnabledPtr(), old_depth_bounds_test_enabled_ptr,
-           kDepthBoundsTestEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<float>::value,
-                  "Field type must be trivially copyable");
-    memcpy(MinDepthBoundsPtr(), old_min_depth_bounds_ptr, kMinDepthBoundsSize * m_size);
-    static_assert(std::is_trivially_copyable<float>::value,
-                  "Field type must be trivially copyable");
-    memcpy(MaxDepthBoundsPtr(), old_max_depth_bounds_ptr, kMaxDepthBoundsSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(StencilTestEnabledPtr(), old_stencil_test_enabled_ptr, kStencilTestEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<VkStencilOpState>::value,
-                  "Field type must be trivially copyable");
-    memcpy(StencilOpStateFrontPtr(), old_stencil_op_state_front_ptr,
-           kStencilOpStateFrontSize * m_size);
-    static_assert(std::is_trivially_copyable<VkStencilOpState>::value,
-                  "Field type must be trivially copyable");
-    memcpy(StencilOpStateBackPtr(), old_stencil_op_state_back_ptr,
-           kStencilOpStateBackSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(LogicOpEnabledPtr(), old_logic_op_enabled_ptr, kLogicOpEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<VkLogicOp>::value,
-                  "Field type must be trivially copyable");
-    memcpy(LogicOpPtr(), old_logic_op_ptr, kLogicOpSize * m_size);
-    static_assert(std::is_trivially_copyable<VkPipelineColorBlendAttachmentState>::value,
-                  "Field type must be trivially copyable");
-    memcpy(AttachmentPtr(), old_attachment_ptr, kAttachmentSize * m_size);
-    static_assert(std::is_trivially_copyable<float>::value,
-                  "Field type must be trivially copyable");
-    memcpy(BlendConstantPtr(), old_blend_constant_ptr, kBlendConstantSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(LRZEnabledPtr(), old_lrz_enabled_ptr, kLRZEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(LRZWritePtr(), old_lrz_write_ptr, kLRZWriteSize * m_size);
-    static_assert(std::is_trivially_copyable<a6xx_lrz_dir_status>::value,
-                  "Field type must be trivially copyable");
-    memcpy(LRZDirStatusPtr(), old_lrz_dir_status_ptr, kLRZDirStatusSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(LRZDirWritePtr(), old_lrz_dir_write_ptr, kLRZDirWriteSize * m_size);
-    static_assert(std::is_trivially_copyable<a6xx_ztest_mode>::value,
-                  "Field type must be trivially copyable");
-    memcpy(ZTestModePtr(), old_z_test_mode_ptr, kZTestModeSize * m_size);
-    static_assert(std::is_trivially_copyable<uint32_t>::value,
-                  "Field type must be trivially copyable");
-    memcpy(BinWPtr(), old_bin_w_ptr, kBinWSize * m_size);
-    static_assert(std::is_trivially_copyable<uint32_t>::value,
-                  "Field type must be trivially copyable");
-    memcpy(BinHPtr(), old_bin_h_ptr, kBinHSize * m_size);
-    static_assert(std::is_trivially_copyable<uint16_t>::value,
-                  "Field type must be trivially copyable");
-    memcpy(WindowScissorTLXPtr(), old_window_scissor_tlx_ptr, kWindowScissorTLXSize * m_size);
-    static_assert(std::is_trivially_copyable<uint16_t>::value,
-                  "Field type must be trivially copyable");
-    memcpy(WindowScissorTLYPtr(), old_window_scissor_tly_ptr, kWindowScissorTLYSize * m_size);
-    static_assert(std::is_trivially_copyable<uint16_t>::value,
-                  "Field type must be trivially copyable");
-    memcpy(WindowScissorBRXPtr(), old_window_scissor_brx_ptr, kWindowScissorBRXSize * m_size);
-    static_assert(std::is_trivially_copyable<uint16_t>::value,
-                  "Field type must be trivially copyable");
-    memcpy(WindowScissorBRYPtr(), old_window_scissor_bry_ptr, kWindowScissorBRYSize * m_size);
-    static_assert(std::is_trivially_copyable<a6xx_render_mode>::value,
-                  "Field type must be trivially copyable");
-    memcpy(RenderModePtr(), old_render_mode_ptr, kRenderModeSize * m_size);
-    static_assert(std::is_trivially_copyable<a6xx_buffers_location>::value,
-                  "Field type must be trivially copyable");
-    memcpy(BuffersLocationPtr(), old_buffers_location_ptr, kBuffersLocationSize * m_size);
-    static_assert(std::is_trivially_copyable<a6xx_threadsize>::value,
-                  "Field type must be trivially copyable");
-    memcpy(ThreadSizePtr(), old_thread_size_ptr, kThreadSizeSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(EnableAllHelperLanesPtr(), old_enable_all_helper_lanes_ptr,
-           kEnableAllHelperLanesSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(EnablePartialHelperLanesPtr(), old_enable_partial_helper_lanes_ptr,
-           kEnablePartialHelperLanesSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(UBWCEnabledPtr(), old_ubwc_enabled_ptr, kUBWCEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(UBWCLosslessEnabledPtr(), old_ubwc_lossless_enabled_ptr,
-           kUBWCLosslessEnabledSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(UBWCEnabledOnDSPtr(), old_ubwc_enabled_on_ds_ptr, kUBWCEnabledOnDSSize * m_size);
-    static_assert(std::is_trivially_copyable<bool>::value, "Field type must be trivially copyable");
-    memcpy(UBWCLosslessEnabledOnDSPtr(), old_ubwc_lossless_enabled_on_ds_ptr,
-           kUBWCLosslessEnabledOnDSSize * m_size);
-    static_assert(std::is_trivially_copyable<VkRect2D>::value,
-                  "Field type must be trivially copyable");
-    memcpy(ResolveScissorPtr(), old_resolve_scissor_ptr, kResolveScissorSize * m_size);
-    static_assert(std::is_trivially_copyable<uint32_t>::value,
-                  "Field type must be trivially copyable");
-    memcpy(ResolveBaseGmemPtr(), old_resolve_base_gmem_ptr, kResolveBaseGmemSize * m_size);
-    static_assert(std::is_trivially_copyable<uint64_t>::value,
-                  "Field type must be trivially copyable");
-    memcpy(ResolveBaseSysmemPtr(), old_resolve_base_sysmem_ptr, kResolveBaseSysmemSize * m_size);
-    static_assert(std::is_trivially_copyable<a6xx_format>::value,
-                  "Field type must be trivially copyable");
-    memcpy(ResolveFormatPtr(), old_resolve_format_ptr, kResolveFormatSize * m_size);
-    static_assert(std::is_trivially_copyable<a6xx_tile_mode>::value,
-                  "Field type must be trivially copyable");
-    memcpy(ResolveTileModePtr(), old_resolve_tile_mode_ptr, kResolveTileModeSize * m_size);
-
-    // Update the debug-only ponters to the arrays
-#ifndef NDEBUG
-    DBG_topology = TopologyPtr();
-    DBG_prim_restart_enabled = PrimRestartEnabledPtr();
-    DBG_patch_control_points = PatchControlPointsPtr();
-    DBG_viewport = ViewportPtr();
-    DBG_scissor = ScissorPtr();
-    DBG_depth_clamp_enabled = DepthClampEnabledPtr();
-    DBG_rasterizer_discard_enabled = RasterizerDiscardEnabledPtr();
-    DBG_polygon_mode = PolygonModePtr();
-    DBG_cull_mode = CullModePtr();
-    DBG_front_face = FrontFacePtr();
-    DBG_depth_bias_enabled = DepthBiasEnabledPtr();
-    DBG_depth_bias_constant_factor = DepthBiasConstantFactorPtr();
-    DBG_depth_bias_clamp = DepthBiasClampPtr();
-    DBG_depth_bias_slope_factor = DepthBiasSlopeFactorPtr();
-    DBG_line_width = LineWidthPtr();
-    DBG_rasterization_samples = RasterizationSamplesPtr();
-    DBG_sample_shading_enabled = SampleShadingEnabledPtr();
-    DBG_min_sample_shading = MinSampleShadingPtr();
-    DBG_sample_mask = SampleMaskPtr();
-    DBG_alpha_to_coverage_enabled = AlphaToCoverageEnabledPtr();
-    DBG_depth_test_enabled = DepthTestEnabledPtr();
-    DBG_depth_write_enabled = DepthWriteEnabledPtr();
-    DBG_depth_compare_op = DepthCompareOpPtr();
-    DBG_depth_bounds_test_enabled = DepthBoundsTestEnabledPtr();
-    DBG_min_depth_bounds = MinDepthBoundsPtr();
-    DBG_max_depth_bounds = MaxDepthBoundsPtr();
-    DBG_stencil_test_enabled = StencilTestEnabledPtr();
-    DBG_stencil_op_state_front = StencilOpStateFrontPtr();
-    DBG_stencil_op_state_back = StencilOpStateBackPtr();
-    DBG_logic_op_enabled = LogicOpEnabledPtr();
-    DBG_logic_op = LogicOpPtr();
-    DBG_attachment = AttachmentPtr();
-    DBG_blend_constant = BlendConstantPtr();
-    DBG_lrz_enabled = LRZEnabledPtr();
-    DBG_lrz_write = LRZWritePtr();
-    DBG_lrz_dir_status = LRZDirStatusPtr();
-    DBG_lrz_dir_write = LRZDirWritePtr();
-    DBG_z_test_mode = ZTestModePtr();
-    DBG_bin_w = BinWPtr();
-    DBG_bin_h = BinHPtr();
-    DBG_window_scissor_tlx = WindowScissorTLXPtr();
-    DBG_window_scissor_tly = WindowScissorTLYPtr();
-    DBG_window_scissor_brx = WindowScissorBRXPtr();
-    DBG_window_scissor_bry = WindowScissorBRYPtr();
-    DBG_render_mode = RenderModePtr();
-    DBG_buffers_location = BuffersLocationPtr();
-    DBG_thread_size = ThreadSizePtr();
-    DBG_enable_all_helper_lanes = EnableAllHelperLanesPtr();
-    DBG_enable_partial_helper_lanes = EnablePartialHelperLanesPtr();
-    DBG_ubwc_enabled = UBWCEnabledPtr();
-    DBG_ubwc_lossless_enabled = UBWCLosslessEnabledPtr();
-    DBG_ubwc_enabled_on_ds = UBWCEnabledOnDSPtr();
-    DBG_ubwc_lossless_enabled_on_ds = UBWCLosslessEnabledOnDSPtr();
-    DBG_resolve_scissor = ResolveScissorPtr();
-    DBG_resolve_base_gmem = ResolveBaseGmemPtr();
-    DBG_resolve_base_sysmem = ResolveBaseSysmemPtr();
-    DBG_resolve_format = ResolveFormatPtr();
-    DBG_resolve_tile_mode = ResolveTileModePtr();
-#endif
+    while (m_chunks.size() * kChunkSize < new_cap) m_chunks.push_back(NewChunk());
 }
 
 template <>
 EventStateInfo::Iterator EventStateInfoT<EventStateInfo_CONFIG>::Add()
 {
-    if (m_size >= m_cap)
+    if (m_size == std::numeric_limits<typename Id::basic_type>::max())
     {
-        auto new_cap = m_cap > 0 ? m_cap * 2 : static_cast<typename Id::basic_type>(kAlignment);
-        if (new_cap <= m_cap)
+        // size has overflowed the `Id` type.
+        DIVE_ASSERT(false);
+        return end();
+    }
+    if (m_size % kChunkSize == 0)
+    {
+        size_t chunk_index = m_size / kChunkSize;
+        if (chunk_index < m_chunks.size())
         {
-            // capacity has overflowed the `Id` type.
-            DIVE_ASSERT(false);
-            return end();
+            // Chunk kept by `Clear()`, with the is-set bits of the previous elements
+            memset(m_chunks[chunk_index].get(), 0, kChunkBytes);
         }
         else
         {
-            Reserve(new_cap);
+            m_chunks.push_back(NewChunk());
         }
     }
 
-    new (TopologyPtr(Id(m_size))) uint32_t();
-    new (PrimRestartEnabledPtr(Id(m_size))) bool();
-    new (PatchControlPointsPtr(Id(m_size))) uint32_t();
-    for (uint32_t viewport = 0; viewport < 16; ++viewport)
-    {
-        new (ViewportPtr(Id(m_size), viewport)) VkViewport();
-    }
-    for (uint32_t scissor = 0; scissor < 16; ++scissor)
-    {
-        new (ScissorPtr(Id(m_size), scissor)) VkRect2D();
-    }
-    new (DepthClampEnabledPtr(Id(m_size))) bool();
-    new (RasterizerDiscardEnabledPtr(Id(m_size))) bool();
-    new (PolygonModePtr(Id(m_size))) VkPolygonMode();
-    new (CullModePtr(Id(m_size))) VkCullModeFlags();
-    new (FrontFacePtr(Id(m_size))) VkFrontFace();
-    new (DepthBiasEnabledPtr(Id(m_size))) bool();
-    new (DepthBiasConstantFactorPtr(Id(m_size))) float();
-    new (DepthBiasClampPtr(Id(m_size))) float();
-    new (DepthBiasSlopeFactorPtr(Id(m_size))) float();
-    new (LineWidthPtr(Id(m_size))) float();
-    new (RasterizationSamplesPtr(Id(m_size))) VkSampleCountFlagBits();
-    new (SampleShadingEnabledPtr(Id(m_size))) bool();
-    new (MinSampleShadingPtr(Id(m_size))) float();
-    new (SampleMaskPtr(Id(m_size))) VkSampleMask();
-    new (AlphaToCoverageEnabledPtr(Id(m_size))) bool();
-    new (DepthTestEnabledPtr(Id(m_size))) bool();
-    new (DepthWriteEnabledPtr(Id(m_size))) bool();
-    new (DepthCompareOpPtr(Id(m_size))) VkCompareOp();
-    new (DepthBoundsTestEnabledPtr(Id(m_size))) bool();
-    new (MinDepthBoundsPtr(Id(m_size))) float();
-    new (MaxDepthBoundsPtr(Id(m_size))) float();
-    new (StencilTestEnabledPtr(Id(m_size))) bool();
-    new (StencilOpStateFrontPtr(Id(m_size))) VkStencilOpState();
-    new (StencilOpStateBackPtr(Id(m_size))) VkStencilOpState();
-    for (uint32_t attachment = 0; attachment < 8; ++attachment)
-    {
-        new (LogicOpEnabledPtr(Id(m_size), attachment)) bool();
-    }
-    for (uint32_t attachment = 0; attachment < 8; ++attachment)
-    {
-        new (LogicOpPtr(Id(m_size), attachment)) VkLogicOp();
-    }
-    for (uint32_t attachment = 0; attachment < 8; ++attachment)
-    {
-        new (AttachmentPtr(Id(m_size), attachment)) VkPipelineColorBlendAttachmentState();
-    }
-    for (uint32_t channel = 0; channel < 4; ++channel)
-    {
-        new (BlendConstantPtr(Id(m_size), channel)) float();
-    }
-    new (LRZEnabledPtr(Id(m_size))) bool();
-    new (LRZWritePtr(Id(m_size))) bool();
-    new (LRZDirStatusPtr(Id(m_size))) a6xx_lrz_dir_status();
-    new (LRZDirWritePtr(Id(m_size))) bool();
-    new (ZTestModePtr(Id(m_size))) a6xx_ztest_mode();
-    new (BinWPtr(Id(m_size))) uint32_t();
-    new (BinHPtr(Id(m_size))) uint32_t();
-    new (WindowScissorTLXPtr(Id(m_size))) uint16_t();
-    new (WindowScissorTLYPtr(Id(m_size))) uint16_t();
-    new (WindowScissorBRXPtr(Id(m_size))) uint16_t();
-    new (WindowScissorBRYPtr(Id(m_size))) uint16_t();
-    new (RenderModePtr(Id(m_size))) a6xx_render_mode();
-    new (BuffersLocationPtr(Id(m_size))) a6xx_buffers_location();
-    new (ThreadSizePtr(Id(m_size))) a6xx_threadsize();
-    new (EnableAllHelperLanesPtr(Id(m_size))) bool();
-    new (EnablePartialHelperLanesPtr(Id(m_size))) bool();
-    for (uint32_t attachment = 0; attachment < 8; ++attachment)
-    {
-        new (UBWCEnabledPtr(Id(m_size), attachment)) bool();
-    }
-    for (uint32_t attachment = 0; attachment < 8; ++attachment)
-    {
-        new (UBWCLosslessEnabledPtr(Id(m_size), attachment)) bool();
-    }
-    new (UBWCEnabledOnDSPtr(Id(m_size))) bool();
-    new (UBWCLosslessEnabledOnDSPtr(Id(m_size))) bool();
-    new (ResolveScissorPtr(Id(m_size))) VkRect2D();
-    new (ResolveBaseGmemPtr(Id(m_size))) uint32_t();
-    new (ResolveBaseSysmemPtr(Id(m_size))) uint64_t();
-    new (ResolveFormatPtr(Id(m_size))) a6xx_format();
-    new (ResolveTileModePtr(Id(m_size))) a6xx_tile_mode();
+    m_topology_runs.Extend(uint32_t());
+    m_prim_restart_enabled_runs.Extend(bool());
+    m_patch_control_points_runs.Extend(uint32_t());
+    {
+        std::array<VkViewport, kViewportArrayCount> values;
+        values.fill(VkViewport());
+        m_viewport_runs.Extend(values);
+    }
+    {
+        std::array<VkRect2D, kScissorArrayCount> values;
+        values.fill(VkRect2D());
+        m_scissor_runs.Extend(values);
+    }
+    m_depth_clamp_enabled_runs.Extend(bool());
+    m_rasterizer_discard_enabled_runs.Extend(bool());
+    m_polygon_mode_runs.Extend(VkPolygonMode());
+    m_cull_mode_runs.Extend(VkCullModeFlags());
+    m_front_face_runs.Extend(VkFrontFace());
+    m_depth_bias_enabled_runs.Extend(bool());
+    m_depth_bias_constant_factor_runs.Extend(float());
+    m_depth_bias_clamp_runs.Extend(float());
+    m_depth_bias_slope_factor_runs.Extend(float());
+    m_line_width_runs.Extend(float());
+    m_rasterization_samples_runs.Extend(VkSampleCountFlagBits());
+    m_sample_shading_enabled_runs.Extend(bool());
+    m_min_sample_shading_runs.Extend(float());
+    m_sample_mask_runs.Extend(VkSampleMask());
+    m_alpha_to_coverage_enabled_runs.Extend(bool());
+    m_depth_test_enabled_runs.Extend(bool());
+    m_depth_write_enabled_runs.Extend(bool());
+    m_depth_compare_op_runs.Extend(VkCompareOp());
+    m_depth_bounds_test_enabled_runs.Extend(bool());
+    m_min_depth_bounds_runs.Extend(float());
+    m_max_depth_bounds_runs.Extend(float());
+    m_stencil_test_enabled_runs.Extend(bool());
+    m_stencil_op_state_front_runs.Extend(VkStencilOpState());
+    m_stencil_op_state_back_runs.Extend(VkStencilOpState());
+    {
+        std::array<bool, kLogicOpEnabledArrayCount> values;
+        values.fill(bool());
+        m_logic_op_enabled_runs.Extend(values);
+    }
+    {
+        std::array<VkLogicOp, kLogicOpArrayCount> values;
+        values.fill(VkLogicOp());
+        m_logic_op_runs.Extend(values);
+    }
+    {
+        std::array<VkPipelineColorBlendAttachmentState, kAttachmentArrayCount> values;
+        values.fill(VkPipelineColorBlendAttachmentState());
+        m_attachment_runs.Extend(values);
+    }
+    {
+        std::array<float, kBlendConstantArrayCount> values;
+        values.fill(float());
+        m_blend_constant_runs.Extend(values);
+    }
+    m_lrz_enabled_runs.Extend(bool());
+    m_lrz_write_runs.Extend(bool());
+    m_lrz_dir_status_runs.Extend(a6xx_lrz_dir_status());
+    m_lrz_dir_write_runs.Extend(bool());
+    m_z_test_mode_runs.Extend(a6xx_ztest_mode());
+    m_bin_w_runs.Extend(uint32_t());
+    m_bin_h_runs.Extend(uint32_t());
+    m_window_scissor_tlx_runs.Extend(uint16_t());
+    m_window_scissor_tly_runs.Extend(uint16_t());
+    m_window_scissor_brx_runs.Extend(uint16_t());
+    m_window_scissor_bry_runs.Extend(uint16_t());
+    m_render_mode_runs.Extend(a6xx_render_mode());
+    m_buffers_location_runs.Extend(a6xx_buffers_location());
+    m_thread_size_runs.Extend(a6xx_threadsize());
+    m_enable_all_helper_lanes_runs.Extend(bool());
+    m_enable_partial_helper_lanes_runs.Extend(bool());
+    {
+        std::array<bool, kUBWCEnabledArrayCount> values;
+        values.fill(bool());
+        m_ubwc_enabled_runs.Extend(values);
+    }
+    {
+        std::array<bool, kUBWCLosslessEnabledArrayCount> values;
+        values.fill(bool());
+        m_ubwc_lossless_enabled_runs.Extend(values);
+    }
+    m_ubwc_enabled_on_ds_runs.Extend(bool());
+    m_ubwc_lossless_enabled_on_ds_runs.Extend(bool());
+    m_resolve_scissor_runs.Extend(VkRect2D());
+    m_resolve_base_gmem_runs.Extend(uint32_t());
+    m_resolve_base_sysmem_runs.Extend(uint64_t());
+    m_resolve_format_runs.Extend(a6xx_format());
+    m_resolve_tile_mode_runs.Extend(a6xx_tile_mode());
 
     Id id(m_size);
     m_size += 1;
@@ -467,10 +176,10 @@ void EventStateInfoRefT<EventStateInfo_CONFIG>::assign(
     SetTopology(other_obj.Topology(other_id));
     SetPrimRestartEnabled(other_obj.PrimRestartEnabled(other_id));
     SetPatchControlPoints(other_obj.PatchControlPoints(other_id));
-    memcpy(m_obj_ptr->ViewportPtr(m_id), other_obj.ViewportPtr(other_id),
-           EventStateInfo::kViewportSize);
-    memcpy(m_obj_ptr->ScissorPtr(m_id), other_obj.ScissorPtr(other_id),
-           EventStateInfo::kScissorSize);
+    m_obj_ptr->m_viewport_runs.Set(static_cast<Id::basic_type>(m_id),
+                                   other_obj.ViewportValues(other_id));
+    m_obj_ptr->m_scissor_runs.Set(static_cast<Id::basic_type>(m_id),
+                                  other_obj.ScissorValues(other_id));
     SetDepthClampEnabled(other_obj.DepthClampEnabled(other_id));
     SetRasterizerDiscardEnabled(other_obj.RasterizerDiscardEnabled(other_id));
     SetPolygonMode(other_obj.PolygonMode(other_id));
@@ -495,14 +204,14 @@ void EventStateInfoRefT<EventStateInfo_CONFIG>::assign(
     SetStencilTestEnabled(other_obj.StencilTestEnabled(other_id));
     SetStencilOpStateFront(other_obj.StencilOpStateFront(other_id));
     SetStencilOpStateBack(other_obj.StencilOpStateBack(other_id));
-    memcpy(m_obj_ptr->LogicOpEnabledPtr(m_id), other_obj.LogicOpEnabledPtr(other_id),
-           EventStateInfo::kLogicOpEnabledSize);
-    memcpy(m_obj_ptr->LogicOpPtr(m_id), other_obj.LogicOpPtr(other_id),
-           EventStateInfo::kLogicOpSize);
-    memcpy(m_obj_ptr->AttachmentPtr(m_id), other_obj.AttachmentPtr(other_id),
-           EventStateInfo::kAttachmentSize);
-    memcpy(m_obj_ptr->BlendConstantPtr(m_id), other_obj.BlendConstantPtr(other_id),
-           EventStateInfo::kBlendConstantSize);
+    m_obj_ptr->m_logic_op_enabled_runs.Set(static_cast<Id::basic_type>(m_id),
+                                           other_obj.LogicOpEnabledValues(other_id));
+    m_obj_ptr->m_logic_op_runs.Set(static_cast<Id::basic_type>(m_id),
+                                   other_obj.LogicOpValues(other_id));
+    m_obj_ptr->m_attachment_runs.Set(static_cast<Id::basic_type>(m_id),
+                                     other_obj.AttachmentValues(other_id));
+    m_obj_ptr->m_blend_constant_runs.Set(static_cast<Id::basic_type>(m_id),
+                                         other_obj.BlendConstantValues(other_id));
     SetLRZEnabled(other_obj.LRZEnabled(other_id));
     SetLRZWrite(other_obj.LRZWrite(other_id));
     SetLRZDirStatus(other_obj.LRZDirStatus(other_id));
@@ -519,10 +228,10 @@ void EventStateInfoRefT<EventStateInfo_CONFIG>::assign(
     SetThreadSize(other_obj.ThreadSize(other_id));
     SetEnableAllHelperLanes(other_obj.EnableAllHelperLanes(other_id));
     SetEnablePartialHelperLanes(other_obj.EnablePartialHelperLanes(other_id));
-    memcpy(m_obj_ptr->UBWCEnabledPtr(m_id), other_obj.UBWCEnabledPtr(other_id),
-           EventStateInfo::kUBWCEnabledSize);
-    memcpy(m_obj_ptr->UBWCLosslessEnabledPtr(m_id), other_obj.UBWCLosslessEnabledPtr(other_id),
-           EventStateInfo::kUBWCLosslessEnabledSize);
+    m_obj_ptr->m_ubwc_enabled_runs.Set(static_cast<Id::basic_type>(m_id),
+                                       other_obj.UBWCEnabledValues(other_id));
+    m_obj_ptr->m_ubwc_lossless_enabled_runs.Set(static_cast<Id::basic_type>(m_id),
+                                                other_obj.UBWCLosslessEnabledValues(other_id));
     SetUBWCEnabledOnDS(other_obj.UBWCEnabledOnDS(other_id));
     SetUBWCLosslessEnabledOnDS(other_obj.UBWCLosslessEnabledOnDS(other_id));
     SetResolveScissor(other_obj.ResolveScissor(other_id));
@@ -555,20 +264,16 @@ void EventStateInfoRefT<EventStateInfo_CONFIG>::swap(const EventStateInfoRef& ot
         other.SetPatchControlPoints(val);
     }
     {
-        VkViewport val[EventStateInfo::kViewportArrayCount];
-        auto* ptr = m_obj_ptr->ViewportPtr(m_id);
-        auto* other_ptr = other.m_obj_ptr->ViewportPtr(other.m_id);
-        memcpy(val, ptr, EventStateInfo::kViewportSize);
-        memcpy(ptr, other_ptr, EventStateInfo::kViewportSize);
-        memcpy(other_ptr, val, EventStateInfo::kViewportSize);
+        auto val = m_obj_ptr->ViewportValues(m_id);
+        m_obj_ptr->m_viewport_runs.Set(static_cast<Id::basic_type>(m_id),
+                                       other.m_obj_ptr->ViewportValues(other.m_id));
+        other.m_obj_ptr->m_viewport_runs.Set(static_cast<Id::basic_type>(other.m_id), val);
     }
     {
-        VkRect2D val[EventStateInfo::kScissorArrayCount];
-        auto* ptr = m_obj_ptr->ScissorPtr(m_id);
-        auto* other_ptr = other.m_obj_ptr->ScissorPtr(other.m_id);
-        memcpy(val, ptr, EventStateInfo::kScissorSize);
-        memcpy(ptr, other_ptr, EventStateInfo::kScissorSize);
-        memcpy(other_ptr, val, EventStateInfo::kScissorSize);
+        auto val = m_obj_ptr->ScissorValues(m_id);
+        m_obj_ptr->m_scissor_runs.Set(static_cast<Id::basic_type>(m_id),
+                                      other.m_obj_ptr->ScissorValues(other.m_id));
+        other.m_obj_ptr->m_scissor_runs.Set(static_cast<Id::basic_type>(other.m_id), val);
     }
     {
         auto val = DepthClampEnabled();
@@ -691,36 +396,28 @@ void EventStateInfoRefT<EventStateInfo_CONFIG>::swap(const EventStateInfoRef& ot
         other.SetStencilOpStateBack(val);
     }
     {
-        bool val[EventStateInfo::kLogicOpEnabledArrayCount];
-        auto* ptr = m_obj_ptr->LogicOpEnabledPtr(m_id);
-        auto* other_ptr = other.m_obj_ptr->LogicOpEnabledPtr(other.m_id);
-        memcpy(val, ptr, EventStateInfo::kLogicOpEnabledSize);
-        memcpy(ptr, other_ptr, EventStateInfo::kLogicOpEnabledSize);
-        memcpy(other_ptr, val, EventStateInfo::kLogicOpEnabledSize);
+        auto val = m_obj_ptr->LogicOpEnabledValues(m_id);
+        m_obj_ptr->m_logic_op_enabled_runs.Set(static_cast<Id::basic_type>(m_id),
+                                               other.m_obj_ptr->LogicOpEnabledValues(other.m_id));
+        other.m_obj_ptr->m_logic_op_enabled_runs.Set(static_cast<Id::basic_type>(other.m_id), val);
     }
     {
-        VkLogicOp val[EventStateInfo::kLogicOpArrayCount];
-        auto* ptr = m_obj_ptr->LogicOpPtr(m_id);
-        auto* other_ptr = other.m_obj_ptr->LogicOpPtr(other.m_id);
-        memcpy(val, ptr, EventStateInfo::kLogicOpSize);
-        memcpy(ptr, other_ptr, EventStateInfo::kLogicOpSize);
-        memcpy(other_ptr, val, EventStateInfo::kLogicOpSize);
+        auto val = m_obj_ptr->LogicOpValues(m_id);
+        m_obj_ptr->m_logic_op_runs.Set(static_cast<Id::basic_type>(m_id),
+                                       other.m_obj_ptr->LogicOpValues(other.m_id));
+        other.m_obj_ptr->m_logic_op_runs.Set(static_cast<Id::basic_type>(other.m_id), val);
     }
     {
-        VkPipelineColorBlendAttachmentState val[EventStateInfo::kAttachmentArrayCount];
-        auto* ptr = m_obj_ptr->AttachmentPtr(m_id);
-        auto* other_ptr = other.m_obj_ptr->AttachmentPtr(other.m_id);
-        memcpy(val, ptr, EventStateInfo::kAttachmentSize);
-        memcpy(ptr, other_ptr, EventStateInfo::kAttachmentSize);
-        memcpy(other_ptr, val, EventStateInfo::kAttachmentSize);
+        auto val = m_obj_ptr->AttachmentValues(m_id);
+        m_obj_ptr->m_attachment_runs.Set(static_cast<Id::basic_type>(m_id),
+                                         other.m_obj_ptr->AttachmentValues(other.m_id));
+        other.m_obj_ptr->m_attachment_runs.Set(static_cast<Id::basic_type>(other.m_id), val);
     }
     {
-        float val[EventStateInfo::kBlendConstantArrayCount];
-        auto* ptr = m_obj_ptr->BlendConstantPtr(m_id);
-        auto* other_ptr = other.m_obj_ptr->BlendConstantPtr(other.m_id);
-        memcpy(val, ptr, EventStateInfo::kBlendConstantSize);
-        memcpy(ptr, other_ptr, EventStateInfo::kBlendConstantSize);
-        memcpy(other_ptr, val, EventStateInfo::kBlendConstantSize);
+        auto val = m_obj_ptr->BlendConstantValues(m_id);
+        m_obj_ptr->m_blend_constant_runs.Set(static_cast<Id::basic_type>(m_id),
+                                             other.m_obj_ptr->BlendConstantValues(other.m_id));
+        other.m_obj_ptr->m_blend_constant_runs.Set(static_cast<Id::basic_type>(other.m_id), val);
     }
     {
         auto val = LRZEnabled();
@@ -803,20 +500,18 @@ void EventStateInfoRefT<EventStateInfo_CONFIG>::swap(const EventStateInfoRef& ot
         other.SetEnablePartialHelperLanes(val);
     }
     {
-        bool val[EventStateInfo::kUBWCEnabledArrayCount];
-        auto* ptr = m_obj_ptr->UBWCEnabledPtr(m_id);
-        auto* other_ptr = other.m_obj_ptr->UBWCEnabledPtr(other.m_id);
-        memcpy(val, ptr, EventStateInfo::kUBWCEnabledSize);
-        memcpy(ptr, other_ptr, EventStateInfo::kUBWCEnabledSize);
-        memcpy(other_ptr, val, EventStateInfo::kUBWCEnabledSize);
+        auto val = m_obj_ptr->UBWCEnabledValues(m_id);
+        m_obj_ptr->m_ubwc_enabled_runs.Set(static_cast<Id::basic_type>(m_id),
+                                           other.m_obj_ptr->UBWCEnabledValues(other.m_id));
+        other.m_obj_ptr->m_ubwc_enabled_runs.Set(static_cast<Id::basic_type>(other.m_id), val);
     }
     {
-        bool val[EventStateInfo::kUBWCLosslessEnabledArrayCount];
-        auto* ptr = m_obj_ptr->UBWCLosslessEnabledPtr(m_id);
-        auto* other_ptr = other.m_obj_ptr->UBWCLosslessEnabledPtr(other.m_id);
-        memcpy(val, ptr, EventStateInfo::kUBWCLosslessEnabledSize);
-        memcpy(ptr, other_ptr, EventStateInfo::kUBWCLosslessEnabledSize);
-        memcpy(other_ptr, val, EventStateInfo::kUBWCLosslessEnabledSize);
+        auto val = m_obj_ptr->UBWCLosslessEnabledValues(m_id);
+        m_obj_ptr->m_ubwc_lossless_enabled_runs.Set(
+            static_cast<Id::basic_type>(m_id),
+            other.m_obj_ptr->UBWCLosslessEnabledValues(other.m_id));
+        other.m_obj_ptr->m_ubwc_lossless_enabled_runs.Set(static_cast<Id::basic_type>(other.m_id),
+                                                          val);
     }
     {
         auto val = UBWCEnabledOnDS();
@@ -855,4 +550,265 @@ void EventStateInfoRefT<EventStateInfo_CONFIG>::swap(const EventStateInfoRef& ot
     }
 }
 
+template <>
+size_t EventStateInfoT<EventStateInfo_CONFIG>::RawDataSize() const
+{
+    size_t size = NumUsedChunks(m_size) * kChunkBytes;
+    size += m_topology_runs.RawDataSize();
+    size += m_prim_restart_enabled_runs.RawDataSize();
+    size += m_patch_control_points_runs.RawDataSize();
+    size += m_viewport_runs.RawDataSize();
+    size += m_scissor_runs.RawDataSize();
+    size += m_depth_clamp_enabled_runs.RawDataSize();
+    size += m_rasterizer_discard_enabled_runs.RawDataSize();
+    size += m_polygon_mode_runs.RawDataSize();
+    size += m_cull_mode_runs.RawDataSize();
+    size += m_front_face_runs.RawDataSize();
+    size += m_depth_bias_enabled_runs.RawDataSize();
+    size += m_depth_bias_constant_factor_runs.RawDataSize();
+    size += m_depth_bias_clamp_runs.RawDataSize();
+    size += m_depth_bias_slope_factor_runs.RawDataSize();
+    size += m_line_width_runs.RawDataSize();
+    size += m_rasterization_samples_runs.RawDataSize();
+    size += m_sample_shading_enabled_runs.RawDataSize();
+    size += m_min_sample_shading_runs.RawDataSize();
+    size += m_sample_mask_runs.RawDataSize();
+    size += m_alpha_to_coverage_enabled_runs.RawDataSize();
+    size += m_depth_test_enabled_runs.RawDataSize();
+    size += m_depth_write_enabled_runs.RawDataSize();
+    size += m_depth_compare_op_runs.RawDataSize();
+    size += m_depth_bounds_test_enabled_runs.RawDataSize();
+    size += m_min_depth_bounds_runs.RawDataSize();
+    size += m_max_depth_bounds_runs.RawDataSize();
+    size += m_stencil_test_enabled_runs.RawDataSize();
+    size += m_stencil_op_state_front_runs.RawDataSize();
+    size += m_stencil_op_state_back_runs.RawDataSize();
+    size += m_logic_op_enabled_runs.RawDataSize();
+    size += m_logic_op_runs.RawDataSize();
+    size += m_attachment_runs.RawDataSize();
+    size += m_blend_constant_runs.RawDataSize();
+    size += m_lrz_enabled_runs.RawDataSize();
+    size += m_lrz_write_runs.RawDataSize();
+    size += m_lrz_dir_status_runs.RawDataSize();
+    size += m_lrz_dir_write_runs.RawDataSize();
+    size += m_z_test_mode_runs.RawDataSize();
+    size += m_bin_w_runs.RawDataSize();
+    size += m_bin_h_runs.RawDataSize();
+    size += m_window_scissor_tlx_runs.RawDataSize();
+    size += m_window_scissor_tly_runs.RawDataSize();
+    size += m_window_scissor_brx_runs.RawDataSize();
+    size += m_window_scissor_bry_runs.RawDataSize();
+    size += m_render_mode_runs.RawDataSize();
+    size += m_buffers_location_runs.RawDataSize();
+    size += m_thread_size_runs.RawDataSize();
+    size += m_enable_all_helper_lanes_runs.RawDataSize();
+    size += m_enable_partial_helper_lanes_runs.RawDataSize();
+    size += m_ubwc_enabled_runs.RawDataSize();
+    size += m_ubwc_lossless_enabled_runs.RawDataSize();
+    size += m_ubwc_enabled_on_ds_runs.RawDataSize();
+    size += m_ubwc_lossless_enabled_on_ds_runs.RawDataSize();
+    size += m_resolve_scissor_runs.RawDataSize();
+    size += m_resolve_base_gmem_runs.RawDataSize();
+    size += m_resolve_base_sysmem_runs.RawDataSize();
+    size += m_resolve_format_runs.RawDataSize();
+    size += m_resolve_tile_mode_runs.RawDataSize();
+    return size;
+}
+
+template <>
+bool EventStateInfoT<EventStateInfo_CONFIG>::SetRawData(typename Id::basic_type size,
+                                                        const void* data, size_t data_size)
+{
+    const uint8_t* ptr = static_cast<const uint8_t*>(data);
+    const uint8_t* data_end = ptr + data_size;
+    size_t num_chunks = NumUsedChunks(size);
+    if (data_size / kChunkBytes < num_chunks) return false;
+    std::vector<std::unique_ptr<std::max_align_t[]>> chunks;
+    for (size_t i = 0; i < num_chunks; ++i)
+    {
+        chunks.push_back(NewChunk());
+        memcpy(chunks.back().get(), ptr, kChunkBytes);
+        ptr += kChunkBytes;
+    }
+    decltype(m_topology_runs) topology_runs;
+    if (!topology_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_prim_restart_enabled_runs) prim_restart_enabled_runs;
+    if (!prim_restart_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_patch_control_points_runs) patch_control_points_runs;
+    if (!patch_control_points_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_viewport_runs) viewport_runs;
+    if (!viewport_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_scissor_runs) scissor_runs;
+    if (!scissor_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_depth_clamp_enabled_runs) depth_clamp_enabled_runs;
+    if (!depth_clamp_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_rasterizer_discard_enabled_runs) rasterizer_discard_enabled_runs;
+    if (!rasterizer_discard_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_polygon_mode_runs) polygon_mode_runs;
+    if (!polygon_mode_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_cull_mode_runs) cull_mode_runs;
+    if (!cull_mode_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_front_face_runs) front_face_runs;
+    if (!front_face_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_depth_bias_enabled_runs) depth_bias_enabled_runs;
+    if (!depth_bias_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_depth_bias_constant_factor_runs) depth_bias_constant_factor_runs;
+    if (!depth_bias_constant_factor_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_depth_bias_clamp_runs) depth_bias_clamp_runs;
+    if (!depth_bias_clamp_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_depth_bias_slope_factor_runs) depth_bias_slope_factor_runs;
+    if (!depth_bias_slope_factor_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_line_width_runs) line_width_runs;
+    if (!line_width_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_rasterization_samples_runs) rasterization_samples_runs;
+    if (!rasterization_samples_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_sample_shading_enabled_runs) sample_shading_enabled_runs;
+    if (!sample_shading_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_min_sample_shading_runs) min_sample_shading_runs;
+    if (!min_sample_shading_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_sample_mask_runs) sample_mask_runs;
+    if (!sample_mask_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_alpha_to_coverage_enabled_runs) alpha_to_coverage_enabled_runs;
+    if (!alpha_to_coverage_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_depth_test_enabled_runs) depth_test_enabled_runs;
+    if (!depth_test_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_depth_write_enabled_runs) depth_write_enabled_runs;
+    if (!depth_write_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_depth_compare_op_runs) depth_compare_op_runs;
+    if (!depth_compare_op_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_depth_bounds_test_enabled_runs) depth_bounds_test_enabled_runs;
+    if (!depth_bounds_test_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_min_depth_bounds_runs) min_depth_bounds_runs;
+    if (!min_depth_bounds_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_max_depth_bounds_runs) max_depth_bounds_runs;
+    if (!max_depth_bounds_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_stencil_test_enabled_runs) stencil_test_enabled_runs;
+    if (!stencil_test_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_stencil_op_state_front_runs) stencil_op_state_front_runs;
+    if (!stencil_op_state_front_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_stencil_op_state_back_runs) stencil_op_state_back_runs;
+    if (!stencil_op_state_back_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_logic_op_enabled_runs) logic_op_enabled_runs;
+    if (!logic_op_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_logic_op_runs) logic_op_runs;
+    if (!logic_op_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_attachment_runs) attachment_runs;
+    if (!attachment_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_blend_constant_runs) blend_constant_runs;
+    if (!blend_constant_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_lrz_enabled_runs) lrz_enabled_runs;
+    if (!lrz_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_lrz_write_runs) lrz_write_runs;
+    if (!lrz_write_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_lrz_dir_status_runs) lrz_dir_status_runs;
+    if (!lrz_dir_status_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_lrz_dir_write_runs) lrz_dir_write_runs;
+    if (!lrz_dir_write_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_z_test_mode_runs) z_test_mode_runs;
+    if (!z_test_mode_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_bin_w_runs) bin_w_runs;
+    if (!bin_w_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_bin_h_runs) bin_h_runs;
+    if (!bin_h_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_window_scissor_tlx_runs) window_scissor_tlx_runs;
+    if (!window_scissor_tlx_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_window_scissor_tly_runs) window_scissor_tly_runs;
+    if (!window_scissor_tly_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_window_scissor_brx_runs) window_scissor_brx_runs;
+    if (!window_scissor_brx_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_window_scissor_bry_runs) window_scissor_bry_runs;
+    if (!window_scissor_bry_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_render_mode_runs) render_mode_runs;
+    if (!render_mode_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_buffers_location_runs) buffers_location_runs;
+    if (!buffers_location_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_thread_size_runs) thread_size_runs;
+    if (!thread_size_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_enable_all_helper_lanes_runs) enable_all_helper_lanes_runs;
+    if (!enable_all_helper_lanes_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_enable_partial_helper_lanes_runs) enable_partial_helper_lanes_runs;
+    if (!enable_partial_helper_lanes_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_ubwc_enabled_runs) ubwc_enabled_runs;
+    if (!ubwc_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_ubwc_lossless_enabled_runs) ubwc_lossless_enabled_runs;
+    if (!ubwc_lossless_enabled_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_ubwc_enabled_on_ds_runs) ubwc_enabled_on_ds_runs;
+    if (!ubwc_enabled_on_ds_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_ubwc_lossless_enabled_on_ds_runs) ubwc_lossless_enabled_on_ds_runs;
+    if (!ubwc_lossless_enabled_on_ds_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_resolve_scissor_runs) resolve_scissor_runs;
+    if (!resolve_scissor_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_resolve_base_gmem_runs) resolve_base_gmem_runs;
+    if (!resolve_base_gmem_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_resolve_base_sysmem_runs) resolve_base_sysmem_runs;
+    if (!resolve_base_sysmem_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_resolve_format_runs) resolve_format_runs;
+    if (!resolve_format_runs.SetRawData(size, &ptr, data_end)) return false;
+    decltype(m_resolve_tile_mode_runs) resolve_tile_mode_runs;
+    if (!resolve_tile_mode_runs.SetRawData(size, &ptr, data_end)) return false;
+    if (ptr != data_end) return false;
+
+    m_chunks = std::move(chunks);
+    m_topology_runs = std::move(topology_runs);
+    m_prim_restart_enabled_runs = std::move(prim_restart_enabled_runs);
+    m_patch_control_points_runs = std::move(patch_control_points_runs);
+    m_viewport_runs = std::move(viewport_runs);
+    m_scissor_runs = std::move(scissor_runs);
+    m_depth_clamp_enabled_runs = std::move(depth_clamp_enabled_runs);
+    m_rasterizer_discard_enabled_runs = std::move(rasterizer_discard_enabled_runs);
+    m_polygon_mode_runs = std::move(polygon_mode_runs);
+    m_cull_mode_runs = std::move(cull_mode_runs);
+    m_front_face_runs = std::move(front_face_runs);
+    m_depth_bias_enabled_runs = std::move(depth_bias_enabled_runs);
+    m_depth_bias_constant_factor_runs = std::move(depth_bias_constant_factor_runs);
+    m_depth_bias_clamp_runs = std::move(depth_bias_clamp_runs);
+    m_depth_bias_slope_factor_runs = std::move(depth_bias_slope_factor_runs);
+    m_line_width_runs = std::move(line_width_runs);
+    m_rasterization_samples_runs = std::move(rasterization_samples_runs);
+    m_sample_shading_enabled_runs = std::move(sample_shading_enabled_runs);
+    m_min_sample_shading_runs = std::move(min_sample_shading_runs);
+    m_sample_mask_runs = std::move(sample_mask_runs);
+    m_alpha_to_coverage_enabled_runs = std::move(alpha_to_coverage_enabled_runs);
+    m_depth_test_enabled_runs = std::move(depth_test_enabled_runs);
+    m_depth_write_enabled_runs = std::move(depth_write_enabled_runs);
+    m_depth_compare_op_runs = std::move(depth_compare_op_runs);
+    m_depth_bounds_test_enabled_runs = std::move(depth_bounds_test_enabled_runs);
+    m_min_depth_bounds_runs = std::move(min_depth_bounds_runs);
+    m_max_depth_bounds_runs = std::move(max_depth_bounds_runs);
+    m_stencil_test_enabled_runs = std::move(stencil_test_enabled_runs);
+    m_stencil_op_state_front_runs = std::move(stencil_op_state_front_runs);
+    m_stencil_op_state_back_runs = std::move(stencil_op_state_back_runs);
+    m_logic_op_enabled_runs = std::move(logic_op_enabled_runs);
+    m_logic_op_runs = std::move(logic_op_runs);
+    m_attachment_runs = std::move(attachment_runs);
+    m_blend_constant_runs = std::move(blend_constant_runs);
+    m_lrz_enabled_runs = std::move(lrz_enabled_runs);
+    m_lrz_write_runs = std::move(lrz_write_runs);
+    m_lrz_dir_status_runs = std::move(lrz_dir_status_runs);
+    m_lrz_dir_write_runs = std::move(lrz_dir_write_runs);
+    m_z_test_mode_runs = std::move(z_test_mode_runs);
+    m_bin_w_runs = std::move(bin_w_runs);
+    m_bin_h_runs = std::move(bin_h_runs);
+    m_window_scissor_tlx_runs = std::move(window_scissor_tlx_runs);
+    m_window_scissor_tly_runs = std::move(window_scissor_tly_runs);
+    m_window_scissor_brx_runs = std::move(window_scissor_brx_runs);
+    m_window_scissor_bry_runs = std::move(window_scissor_bry_runs);
+    m_render_mode_runs = std::move(render_mode_runs);
+    m_buffers_location_runs = std::move(buffers_location_runs);
+    m_thread_size_runs = std::move(thread_size_runs);
+    m_enable_all_helper_lanes_runs = std::move(enable_all_helper_lanes_runs);
+    m_enable_partial_helper_lanes_runs = std::move(enable_partial_helper_lanes_runs);
+    m_ubwc_enabled_runs = std::move(ubwc_enabled_runs);
+    m_ubwc_lossless_enabled_runs = std::move(ubwc_lossless_enabled_runs);
+    m_ubwc_enabled_on_ds_runs = std::move(ubwc_enabled_on_ds_runs);
+    m_ubwc_lossless_enabled_on_ds_runs = std::move(ubwc_lossless_enabled_on_ds_runs);
+    m_resolve_scissor_runs = std::move(resolve_scissor_runs);
+    m_resolve_base_gmem_runs = std::move(resolve_base_gmem_runs);
+    m_resolve_base_sysmem_runs = std::move(resolve_base_sysmem_runs);
+    m_resolve_format_runs = std::move(resolve_format_runs);
+    m_resolve_tile_mode_runs = std::move(resolve_tile_mode_runs);
+    m_size = size;
+    return true;
+}
+
 }  // namespace Dive
@@ -4991,8 +4991,11 @@ class EventStateInfoT
 
     inline bool empty() const { return m_size == 0; }
 
-    // `capacity()` returns the maximum number of elements before re-allocating
-    inline typename Id::basic_type capacity() const { return m_cap; }
+    // `capacity()` returns the maximum number of elements before allocating another chunk
+    inline typename Id::basic_type capacity() const
+    {
+        return static_cast<typename Id::basic_type>(m_chunks.size() * kChunkSize);
+    }
 
     // `IsValidId` reports whether `id` identifies a valid element
     inline bool IsValidId(Id id) const { return static_cast<typename Id::basic_type>(id) < size(); }
@@ -5000,47 +5003,30 @@ class EventStateInfoT
     // 'MarkFieldSet()' marks whether a particular field was set with a value
     inline void MarkFieldSet(Id id, uint32_t field_index)
     {
-        uint32_t bit = static_cast<typename Id::basic_type>(id) * kNumFields + field_index;
-        m_is_set_buffer[bit / 8] |= (1 << (bit % 8));
+        uint32_t bit =
+            (static_cast<typename Id::basic_type>(id) % kChunkSize) * kNumFields + field_index;
+        ChunkPtr(id)[kIsSetOffset + bit / 8] |= (1 << (bit % 8));
     }
 
     // 'IsFieldSet()' indicates whether a given field was set
     inline bool IsFieldSet(Id id, uint32_t field_index) const
     {
-        uint32_t bit = static_cast<typename Id::basic_type>(id) * kNumFields + field_index;
-        return (m_is_set_buffer[bit / 8] & (1 << (bit % 8))) != 0;
+        uint32_t bit =
+            (static_cast<typename Id::basic_type>(id) % kChunkSize) * kNumFields + field_index;
+        return (ChunkPtr(id)[kIsSetOffset + bit / 8] & (1 << (bit % 8))) != 0;
     }
 
     //-----------------------------------------------
     // FIELD Topology: The primitive topology for this event
 
-    // `TopologyPtr()` returns a shared pointer to an array of `size()` elements
-    inline const uint32_t* TopologyPtr() const
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kTopologyOffset * m_cap);
-    }
-    inline uint32_t* TopologyPtr()
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kTopologyOffset * m_cap);
-    }
-    // `TopologyPtr()` returns a shared pointer to an array of `size()` elements
+    // `TopologyPtr(id)` returns a pointer to the `Topology` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const uint32_t* TopologyPtr(Id id) const
     {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kTopologyOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline uint32_t* TopologyPtr(Id id)
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kTopologyOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const uint32_t kDefault = uint32_t();
+        if (!IsFieldSet(id, kTopologyIndex)) return &kDefault;
+        return &m_topology_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `Topology(id)` retuns the `Topology` element of the object identified by `id`
     inline VkPrimitiveTopology Topology(Id id) const
@@ -5053,7 +5039,7 @@ class EventStateInfoT
     inline SOA& SetTopology(Id id, VkPrimitiveTopology value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *TopologyPtr(id) = static_cast<uint32_t>(value);
+        m_topology_runs.Set(static_cast<typename Id::basic_type>(id), static_cast<uint32_t>(value));
         MarkFieldSet(id, kTopologyIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5075,33 +5061,14 @@ class EventStateInfoT
     // FIELD PrimRestartEnabled: Controls whether a special vertex index value is treated as
     // restarting the assembly of primitives
 
-    // `PrimRestartEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* PrimRestartEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kPrimRestartEnabledOffset * m_cap);
-    }
-    inline bool* PrimRestartEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kPrimRestartEnabledOffset * m_cap);
-    }
-    // `PrimRestartEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `PrimRestartEnabledPtr(id)` returns a pointer to the `PrimRestartEnabled` element of the
+    // object identified by `id`, which is only valid until the field is set again
     inline const bool* PrimRestartEnabledPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kPrimRestartEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* PrimRestartEnabledPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kPrimRestartEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kPrimRestartEnabledIndex)) return &kDefault;
+        return &m_prim_restart_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `PrimRestartEnabled(id)` retuns the `PrimRestartEnabled` element of the object identified by
     // `id`
@@ -5116,7 +5083,7 @@ class EventStateInfoT
     inline SOA& SetPrimRestartEnabled(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *PrimRestartEnabledPtr(id) = value;
+        m_prim_restart_enabled_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kPrimRestartEnabledIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5138,33 +5105,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD PatchControlPoints: Number of control points per patch
 
-    // `PatchControlPointsPtr()` returns a shared pointer to an array of `size()` elements
-    inline const uint32_t* PatchControlPointsPtr() const
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kPatchControlPointsOffset * m_cap);
-    }
-    inline uint32_t* PatchControlPointsPtr()
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kPatchControlPointsOffset * m_cap);
-    }
-    // `PatchControlPointsPtr()` returns a shared pointer to an array of `size()` elements
+    // `PatchControlPointsPtr(id)` returns a pointer to the `PatchControlPoints` element of the
+    // object identified by `id`, which is only valid until the field is set again
     inline const uint32_t* PatchControlPointsPtr(Id id) const
     {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kPatchControlPointsOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline uint32_t* PatchControlPointsPtr(Id id)
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kPatchControlPointsOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const uint32_t kDefault = uint32_t();
+        if (!IsFieldSet(id, kPatchControlPointsIndex)) return &kDefault;
+        return &m_patch_control_points_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `PatchControlPoints(id)` retuns the `PatchControlPoints` element of the object identified by
     // `id`
@@ -5179,7 +5127,7 @@ class EventStateInfoT
     inline SOA& SetPatchControlPoints(Id id, uint32_t value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *PatchControlPointsPtr(id) = value;
+        m_patch_control_points_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kPatchControlPointsIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5200,33 +5148,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD Viewport: Defines the viewport transforms
 
-    // `ViewportPtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkViewport* ViewportPtr() const
-    {
-        return reinterpret_cast<VkViewport*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                             kViewportOffset * m_cap);
-    }
-    inline VkViewport* ViewportPtr()
-    {
-        return reinterpret_cast<VkViewport*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                             kViewportOffset * m_cap);
-    }
-    // `ViewportPtr()` returns a shared pointer to an array of `size()` elements
+    // `ViewportPtr(id)` returns a pointer to the `Viewport` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const VkViewport* ViewportPtr(Id id, uint32_t viewport = 0) const
     {
-        return reinterpret_cast<VkViewport*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                             kViewportOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 16 + viewport
-
-            ;
-    }
-    inline VkViewport* ViewportPtr(Id id, uint32_t viewport = 0)
-    {
-        return reinterpret_cast<VkViewport*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                             kViewportOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 16 + viewport
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkViewport kDefault = VkViewport();
+        if (!IsFieldSet(id, kViewportIndex + viewport)) return &kDefault;
+        return m_viewport_runs.Get(static_cast<typename Id::basic_type>(id)).data() + viewport;
     }
     // `Viewport(id)` retuns the `Viewport` element of the object identified by `id`
     inline VkViewport Viewport(Id id, uint32_t viewport) const
@@ -5247,7 +5176,10 @@ class EventStateInfoT
     inline SOA& SetViewport(Id id, uint32_t viewport, VkViewport value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *ViewportPtr(id, viewport) = value;
+        std::array<VkViewport, kViewportArrayCount> values =
+            m_viewport_runs.Get(static_cast<typename Id::basic_type>(id));
+        values[viewport] = value;
+        m_viewport_runs.Set(static_cast<typename Id::basic_type>(id), values);
         MarkFieldSet(id, kViewportIndex + viewport);
         return static_cast<SOA&>(*this);
     }
@@ -5265,33 +5197,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD Scissor: Defines the rectangular bounds of the scissor for the corresponding viewport
 
-    // `ScissorPtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkRect2D* ScissorPtr() const
-    {
-        return reinterpret_cast<VkRect2D*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kScissorOffset * m_cap);
-    }
-    inline VkRect2D* ScissorPtr()
-    {
-        return reinterpret_cast<VkRect2D*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kScissorOffset * m_cap);
-    }
-    // `ScissorPtr()` returns a shared pointer to an array of `size()` elements
+    // `ScissorPtr(id)` returns a pointer to the `Scissor` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const VkRect2D* ScissorPtr(Id id, uint32_t scissor = 0) const
     {
-        return reinterpret_cast<VkRect2D*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kScissorOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 16 + scissor
-
-            ;
-    }
-    inline VkRect2D* ScissorPtr(Id id, uint32_t scissor = 0)
-    {
-        return reinterpret_cast<VkRect2D*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kScissorOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 16 + scissor
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkRect2D kDefault = VkRect2D();
+        if (!IsFieldSet(id, kScissorIndex + scissor)) return &kDefault;
+        return m_scissor_runs.Get(static_cast<typename Id::basic_type>(id)).data() + scissor;
     }
     // `Scissor(id)` retuns the `Scissor` element of the object identified by `id`
     inline VkRect2D Scissor(Id id, uint32_t scissor) const
@@ -5312,7 +5225,10 @@ class EventStateInfoT
     inline SOA& SetScissor(Id id, uint32_t scissor, VkRect2D value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *ScissorPtr(id, scissor) = value;
+        std::array<VkRect2D, kScissorArrayCount> values =
+            m_scissor_runs.Get(static_cast<typename Id::basic_type>(id));
+        values[scissor] = value;
+        m_scissor_runs.Set(static_cast<typename Id::basic_type>(id), values);
         MarkFieldSet(id, kScissorIndex + scissor);
         return static_cast<SOA&>(*this);
     }
@@ -5333,33 +5249,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD DepthClampEnabled: Controls whether to clamp the fragment’s depth values
 
-    // `DepthClampEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* DepthClampEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthClampEnabledOffset * m_cap);
-    }
-    inline bool* DepthClampEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthClampEnabledOffset * m_cap);
-    }
-    // `DepthClampEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `DepthClampEnabledPtr(id)` returns a pointer to the `DepthClampEnabled` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const bool* DepthClampEnabledPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthClampEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* DepthClampEnabledPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthClampEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kDepthClampEnabledIndex)) return &kDefault;
+        return &m_depth_clamp_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `DepthClampEnabled(id)` retuns the `DepthClampEnabled` element of the object identified by
     // `id`
@@ -5374,7 +5271,7 @@ class EventStateInfoT
     inline SOA& SetDepthClampEnabled(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *DepthClampEnabledPtr(id) = value;
+        m_depth_clamp_enabled_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kDepthClampEnabledIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5396,33 +5293,14 @@ class EventStateInfoT
     // FIELD RasterizerDiscardEnabled: Controls whether primitives are discarded immediately before
     // the rasterization stage
 
-    // `RasterizerDiscardEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* RasterizerDiscardEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kRasterizerDiscardEnabledOffset * m_cap);
-    }
-    inline bool* RasterizerDiscardEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kRasterizerDiscardEnabledOffset * m_cap);
-    }
-    // `RasterizerDiscardEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `RasterizerDiscardEnabledPtr(id)` returns a pointer to the `RasterizerDiscardEnabled` element
+    // of the object identified by `id`, which is only valid until the field is set again
     inline const bool* RasterizerDiscardEnabledPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kRasterizerDiscardEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* RasterizerDiscardEnabledPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kRasterizerDiscardEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kRasterizerDiscardEnabledIndex)) return &kDefault;
+        return &m_rasterizer_discard_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `RasterizerDiscardEnabled(id)` retuns the `RasterizerDiscardEnabled` element of the object
     // identified by `id`
@@ -5437,7 +5315,7 @@ class EventStateInfoT
     inline SOA& SetRasterizerDiscardEnabled(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *RasterizerDiscardEnabledPtr(id) = value;
+        m_rasterizer_discard_enabled_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kRasterizerDiscardEnabledIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5462,33 +5340,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD PolygonMode: The triangle rendering mode
 
-    // `PolygonModePtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkPolygonMode* PolygonModePtr() const
-    {
-        return reinterpret_cast<VkPolygonMode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                kPolygonModeOffset * m_cap);
-    }
-    inline VkPolygonMode* PolygonModePtr()
-    {
-        return reinterpret_cast<VkPolygonMode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                kPolygonModeOffset * m_cap);
-    }
-    // `PolygonModePtr()` returns a shared pointer to an array of `size()` elements
+    // `PolygonModePtr(id)` returns a pointer to the `PolygonMode` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const VkPolygonMode* PolygonModePtr(Id id) const
     {
-        return reinterpret_cast<VkPolygonMode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                kPolygonModeOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline VkPolygonMode* PolygonModePtr(Id id)
-    {
-        return reinterpret_cast<VkPolygonMode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                kPolygonModeOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkPolygonMode kDefault = VkPolygonMode();
+        if (!IsFieldSet(id, kPolygonModeIndex)) return &kDefault;
+        return &m_polygon_mode_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `PolygonMode(id)` retuns the `PolygonMode` element of the object identified by `id`
     inline VkPolygonMode PolygonMode(Id id) const
@@ -5501,7 +5360,7 @@ class EventStateInfoT
     inline SOA& SetPolygonMode(Id id, VkPolygonMode value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *PolygonModePtr(id) = value;
+        m_polygon_mode_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kPolygonModeIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5519,33 +5378,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD CullMode: The triangle facing direction used for primitive culling
 
-    // `CullModePtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkCullModeFlags* CullModePtr() const
-    {
-        return reinterpret_cast<VkCullModeFlags*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                  kCullModeOffset * m_cap);
-    }
-    inline VkCullModeFlags* CullModePtr()
-    {
-        return reinterpret_cast<VkCullModeFlags*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                  kCullModeOffset * m_cap);
-    }
-    // `CullModePtr()` returns a shared pointer to an array of `size()` elements
+    // `CullModePtr(id)` returns a pointer to the `CullMode` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const VkCullModeFlags* CullModePtr(Id id) const
     {
-        return reinterpret_cast<VkCullModeFlags*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                  kCullModeOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline VkCullModeFlags* CullModePtr(Id id)
-    {
-        return reinterpret_cast<VkCullModeFlags*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                  kCullModeOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkCullModeFlags kDefault = VkCullModeFlags();
+        if (!IsFieldSet(id, kCullModeIndex)) return &kDefault;
+        return &m_cull_mode_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `CullMode(id)` retuns the `CullMode` element of the object identified by `id`
     inline VkCullModeFlags CullMode(Id id) const
@@ -5558,7 +5398,7 @@ class EventStateInfoT
     inline SOA& SetCullMode(Id id, VkCullModeFlags value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *CullModePtr(id) = value;
+        m_cull_mode_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kCullModeIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5580,33 +5420,14 @@ class EventStateInfoT
     // FIELD FrontFace: A VkFrontFace value specifying the front-facing triangle orientation to be
     // used for culling
 
-    // `FrontFacePtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkFrontFace* FrontFacePtr() const
-    {
-        return reinterpret_cast<VkFrontFace*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                              kFrontFaceOffset * m_cap);
-    }
-    inline VkFrontFace* FrontFacePtr()
-    {
-        return reinterpret_cast<VkFrontFace*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                              kFrontFaceOffset * m_cap);
-    }
-    // `FrontFacePtr()` returns a shared pointer to an array of `size()` elements
+    // `FrontFacePtr(id)` returns a pointer to the `FrontFace` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const VkFrontFace* FrontFacePtr(Id id) const
     {
-        return reinterpret_cast<VkFrontFace*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                              kFrontFaceOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline VkFrontFace* FrontFacePtr(Id id)
-    {
-        return reinterpret_cast<VkFrontFace*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                              kFrontFaceOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkFrontFace kDefault = VkFrontFace();
+        if (!IsFieldSet(id, kFrontFaceIndex)) return &kDefault;
+        return &m_front_face_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `FrontFace(id)` retuns the `FrontFace` element of the object identified by `id`
     inline VkFrontFace FrontFace(Id id) const
@@ -5619,7 +5440,7 @@ class EventStateInfoT
     inline SOA& SetFrontFace(Id id, VkFrontFace value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *FrontFacePtr(id) = value;
+        m_front_face_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kFrontFaceIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5641,33 +5462,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD DepthBiasEnabled: Whether to bias fragment depth values
 
-    // `DepthBiasEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* DepthBiasEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthBiasEnabledOffset * m_cap);
-    }
-    inline bool* DepthBiasEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthBiasEnabledOffset * m_cap);
-    }
-    // `DepthBiasEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `DepthBiasEnabledPtr(id)` returns a pointer to the `DepthBiasEnabled` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const bool* DepthBiasEnabledPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthBiasEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* DepthBiasEnabledPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthBiasEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kDepthBiasEnabledIndex)) return &kDefault;
+        return &m_depth_bias_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `DepthBiasEnabled(id)` retuns the `DepthBiasEnabled` element of the object identified by `id`
     inline bool DepthBiasEnabled(Id id) const
@@ -5681,7 +5483,7 @@ class EventStateInfoT
     inline SOA& SetDepthBiasEnabled(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *DepthBiasEnabledPtr(id) = value;
+        m_depth_bias_enabled_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kDepthBiasEnabledIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5703,33 +5505,14 @@ class EventStateInfoT
     // FIELD DepthBiasConstantFactor: A scalar factor controlling the constant depth value added to
     // each fragment.
 
-    // `DepthBiasConstantFactorPtr()` returns a shared pointer to an array of `size()` elements
-    inline const float* DepthBiasConstantFactorPtr() const
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kDepthBiasConstantFactorOffset * m_cap);
-    }
-    inline float* DepthBiasConstantFactorPtr()
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kDepthBiasConstantFactorOffset * m_cap);
-    }
-    // `DepthBiasConstantFactorPtr()` returns a shared pointer to an array of `size()` elements
+    // `DepthBiasConstantFactorPtr(id)` returns a pointer to the `DepthBiasConstantFactor` element
+    // of the object identified by `id`, which is only valid until the field is set again
     inline const float* DepthBiasConstantFactorPtr(Id id) const
     {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kDepthBiasConstantFactorOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline float* DepthBiasConstantFactorPtr(Id id)
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kDepthBiasConstantFactorOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const float kDefault = float();
+        if (!IsFieldSet(id, kDepthBiasConstantFactorIndex)) return &kDefault;
+        return &m_depth_bias_constant_factor_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `DepthBiasConstantFactor(id)` retuns the `DepthBiasConstantFactor` element of the object
     // identified by `id`
@@ -5744,7 +5527,7 @@ class EventStateInfoT
     inline SOA& SetDepthBiasConstantFactor(Id id, float value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *DepthBiasConstantFactorPtr(id) = value;
+        m_depth_bias_constant_factor_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kDepthBiasConstantFactorIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5765,33 +5548,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD DepthBiasClamp: The maximum (or minimum) depth bias of a fragment
 
-    // `DepthBiasClampPtr()` returns a shared pointer to an array of `size()` elements
-    inline const float* DepthBiasClampPtr() const
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kDepthBiasClampOffset * m_cap);
-    }
-    inline float* DepthBiasClampPtr()
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kDepthBiasClampOffset * m_cap);
-    }
-    // `DepthBiasClampPtr()` returns a shared pointer to an array of `size()` elements
+    // `DepthBiasClampPtr(id)` returns a pointer to the `DepthBiasClamp` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const float* DepthBiasClampPtr(Id id) const
     {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kDepthBiasClampOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline float* DepthBiasClampPtr(Id id)
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kDepthBiasClampOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const float kDefault = float();
+        if (!IsFieldSet(id, kDepthBiasClampIndex)) return &kDefault;
+        return &m_depth_bias_clamp_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `DepthBiasClamp(id)` retuns the `DepthBiasClamp` element of the object identified by `id`
     inline float DepthBiasClamp(Id id) const
@@ -5805,7 +5569,7 @@ class EventStateInfoT
     inline SOA& SetDepthBiasClamp(Id id, float value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *DepthBiasClampPtr(id) = value;
+        m_depth_bias_clamp_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kDepthBiasClampIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5827,33 +5591,14 @@ class EventStateInfoT
     // FIELD DepthBiasSlopeFactor: A scalar factor applied to a fragment’s slope in depth bias
     // calculations
 
-    // `DepthBiasSlopeFactorPtr()` returns a shared pointer to an array of `size()` elements
-    inline const float* DepthBiasSlopeFactorPtr() const
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kDepthBiasSlopeFactorOffset * m_cap);
-    }
-    inline float* DepthBiasSlopeFactorPtr()
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kDepthBiasSlopeFactorOffset * m_cap);
-    }
-    // `DepthBiasSlopeFactorPtr()` returns a shared pointer to an array of `size()` elements
+    // `DepthBiasSlopeFactorPtr(id)` returns a pointer to the `DepthBiasSlopeFactor` element of the
+    // object identified by `id`, which is only valid until the field is set again
     inline const float* DepthBiasSlopeFactorPtr(Id id) const
     {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kDepthBiasSlopeFactorOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline float* DepthBiasSlopeFactorPtr(Id id)
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kDepthBiasSlopeFactorOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const float kDefault = float();
+        if (!IsFieldSet(id, kDepthBiasSlopeFactorIndex)) return &kDefault;
+        return &m_depth_bias_slope_factor_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `DepthBiasSlopeFactor(id)` retuns the `DepthBiasSlopeFactor` element of the object identified
     // by `id`
@@ -5868,7 +5613,7 @@ class EventStateInfoT
     inline SOA& SetDepthBiasSlopeFactor(Id id, float value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *DepthBiasSlopeFactorPtr(id) = value;
+        m_depth_bias_slope_factor_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kDepthBiasSlopeFactorIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5889,33 +5634,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD LineWidth: The width of rasterized line segments
 
-    // `LineWidthPtr()` returns a shared pointer to an array of `size()` elements
-    inline const float* LineWidthPtr() const
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kLineWidthOffset * m_cap);
-    }
-    inline float* LineWidthPtr()
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kLineWidthOffset * m_cap);
-    }
-    // `LineWidthPtr()` returns a shared pointer to an array of `size()` elements
+    // `LineWidthPtr(id)` returns a pointer to the `LineWidth` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const float* LineWidthPtr(Id id) const
     {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kLineWidthOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline float* LineWidthPtr(Id id)
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kLineWidthOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const float kDefault = float();
+        if (!IsFieldSet(id, kLineWidthIndex)) return &kDefault;
+        return &m_line_width_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `LineWidth(id)` retuns the `LineWidth` element of the object identified by `id`
     inline float LineWidth(Id id) const
@@ -5928,7 +5654,7 @@ class EventStateInfoT
     inline SOA& SetLineWidth(Id id, float value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *LineWidthPtr(id) = value;
+        m_line_width_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kLineWidthIndex);
         return static_cast<SOA&>(*this);
     }
@@ -5950,33 +5676,14 @@ class EventStateInfoT
     // FIELD RasterizationSamples: A VkSampleCountFlagBits value specifying the number of samples
     // used in rasterization
 
-    // `RasterizationSamplesPtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkSampleCountFlagBits* RasterizationSamplesPtr() const
-    {
-        return reinterpret_cast<VkSampleCountFlagBits*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                        kRasterizationSamplesOffset * m_cap);
-    }
-    inline VkSampleCountFlagBits* RasterizationSamplesPtr()
-    {
-        return reinterpret_cast<VkSampleCountFlagBits*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                        kRasterizationSamplesOffset * m_cap);
-    }
-    // `RasterizationSamplesPtr()` returns a shared pointer to an array of `size()` elements
+    // `RasterizationSamplesPtr(id)` returns a pointer to the `RasterizationSamples` element of the
+    // object identified by `id`, which is only valid until the field is set again
     inline const VkSampleCountFlagBits* RasterizationSamplesPtr(Id id) const
     {
-        return reinterpret_cast<VkSampleCountFlagBits*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                        kRasterizationSamplesOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline VkSampleCountFlagBits* RasterizationSamplesPtr(Id id)
-    {
-        return reinterpret_cast<VkSampleCountFlagBits*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                        kRasterizationSamplesOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkSampleCountFlagBits kDefault = VkSampleCountFlagBits();
+        if (!IsFieldSet(id, kRasterizationSamplesIndex)) return &kDefault;
+        return &m_rasterization_samples_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `RasterizationSamples(id)` retuns the `RasterizationSamples` element of the object identified
     // by `id`
@@ -5991,7 +5698,7 @@ class EventStateInfoT
     inline SOA& SetRasterizationSamples(Id id, VkSampleCountFlagBits value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *RasterizationSamplesPtr(id) = value;
+        m_rasterization_samples_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kRasterizationSamplesIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6013,33 +5720,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD SampleShadingEnabled: Whether sample shading is enabled
 
-    // `SampleShadingEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* SampleShadingEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kSampleShadingEnabledOffset * m_cap);
-    }
-    inline bool* SampleShadingEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kSampleShadingEnabledOffset * m_cap);
-    }
-    // `SampleShadingEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `SampleShadingEnabledPtr(id)` returns a pointer to the `SampleShadingEnabled` element of the
+    // object identified by `id`, which is only valid until the field is set again
     inline const bool* SampleShadingEnabledPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kSampleShadingEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* SampleShadingEnabledPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kSampleShadingEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kSampleShadingEnabledIndex)) return &kDefault;
+        return &m_sample_shading_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `SampleShadingEnabled(id)` retuns the `SampleShadingEnabled` element of the object identified
     // by `id`
@@ -6054,7 +5742,7 @@ class EventStateInfoT
     inline SOA& SetSampleShadingEnabled(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *SampleShadingEnabledPtr(id) = value;
+        m_sample_shading_enabled_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kSampleShadingEnabledIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6076,33 +5764,14 @@ class EventStateInfoT
     // FIELD MinSampleShading: Specifies a minimum fraction of sample shading if SampleShadingEnable
     // is set to VK_TRUE
 
-    // `MinSampleShadingPtr()` returns a shared pointer to an array of `size()` elements
-    inline const float* MinSampleShadingPtr() const
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kMinSampleShadingOffset * m_cap);
-    }
-    inline float* MinSampleShadingPtr()
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kMinSampleShadingOffset * m_cap);
-    }
-    // `MinSampleShadingPtr()` returns a shared pointer to an array of `size()` elements
+    // `MinSampleShadingPtr(id)` returns a pointer to the `MinSampleShading` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const float* MinSampleShadingPtr(Id id) const
     {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kMinSampleShadingOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline float* MinSampleShadingPtr(Id id)
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kMinSampleShadingOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const float kDefault = float();
+        if (!IsFieldSet(id, kMinSampleShadingIndex)) return &kDefault;
+        return &m_min_sample_shading_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `MinSampleShading(id)` retuns the `MinSampleShading` element of the object identified by `id`
     inline float MinSampleShading(Id id) const
@@ -6116,7 +5785,7 @@ class EventStateInfoT
     inline SOA& SetMinSampleShading(Id id, float value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *MinSampleShadingPtr(id) = value;
+        m_min_sample_shading_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kMinSampleShadingIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6139,33 +5808,14 @@ class EventStateInfoT
     // FIELD SampleMask: Each bit in the sample mask is associated with a unique sample index as
     // defined for the coverage mask. If the bit is set to 0, the coverage mask bit is set to 0
 
-    // `SampleMaskPtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkSampleMask* SampleMaskPtr() const
-    {
-        return reinterpret_cast<VkSampleMask*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                               kSampleMaskOffset * m_cap);
-    }
-    inline VkSampleMask* SampleMaskPtr()
-    {
-        return reinterpret_cast<VkSampleMask*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                               kSampleMaskOffset * m_cap);
-    }
-    // `SampleMaskPtr()` returns a shared pointer to an array of `size()` elements
+    // `SampleMaskPtr(id)` returns a pointer to the `SampleMask` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const VkSampleMask* SampleMaskPtr(Id id) const
     {
-        return reinterpret_cast<VkSampleMask*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                               kSampleMaskOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline VkSampleMask* SampleMaskPtr(Id id)
-    {
-        return reinterpret_cast<VkSampleMask*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                               kSampleMaskOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkSampleMask kDefault = VkSampleMask();
+        if (!IsFieldSet(id, kSampleMaskIndex)) return &kDefault;
+        return &m_sample_mask_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `SampleMask(id)` retuns the `SampleMask` element of the object identified by `id`
     inline VkSampleMask SampleMask(Id id) const
@@ -6178,7 +5828,7 @@ class EventStateInfoT
     inline SOA& SetSampleMask(Id id, VkSampleMask value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *SampleMaskPtr(id) = value;
+        m_sample_mask_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kSampleMaskIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6201,33 +5851,14 @@ class EventStateInfoT
     // FIELD AlphaToCoverageEnabled: Whether a temporary coverage value is generated based on the
     // alpha component of the fragment’s first color output
 
-    // `AlphaToCoverageEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* AlphaToCoverageEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kAlphaToCoverageEnabledOffset * m_cap);
-    }
-    inline bool* AlphaToCoverageEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kAlphaToCoverageEnabledOffset * m_cap);
-    }
-    // `AlphaToCoverageEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `AlphaToCoverageEnabledPtr(id)` returns a pointer to the `AlphaToCoverageEnabled` element of
+    // the object identified by `id`, which is only valid until the field is set again
     inline const bool* AlphaToCoverageEnabledPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kAlphaToCoverageEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* AlphaToCoverageEnabledPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kAlphaToCoverageEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kAlphaToCoverageEnabledIndex)) return &kDefault;
+        return &m_alpha_to_coverage_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `AlphaToCoverageEnabled(id)` retuns the `AlphaToCoverageEnabled` element of the object
     // identified by `id`
@@ -6242,7 +5873,7 @@ class EventStateInfoT
     inline SOA& SetAlphaToCoverageEnabled(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *AlphaToCoverageEnabledPtr(id) = value;
+        m_alpha_to_coverage_enabled_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kAlphaToCoverageEnabledIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6264,33 +5895,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD DepthTestEnabled: Whether depth testing is enabled
 
-    // `DepthTestEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* DepthTestEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthTestEnabledOffset * m_cap);
-    }
-    inline bool* DepthTestEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthTestEnabledOffset * m_cap);
-    }
-    // `DepthTestEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `DepthTestEnabledPtr(id)` returns a pointer to the `DepthTestEnabled` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const bool* DepthTestEnabledPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthTestEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* DepthTestEnabledPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthTestEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kDepthTestEnabledIndex)) return &kDefault;
+        return &m_depth_test_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `DepthTestEnabled(id)` retuns the `DepthTestEnabled` element of the object identified by `id`
     inline bool DepthTestEnabled(Id id) const
@@ -6304,7 +5916,7 @@ class EventStateInfoT
     inline SOA& SetDepthTestEnabled(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *DepthTestEnabledPtr(id) = value;
+        m_depth_test_enabled_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kDepthTestEnabledIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6326,33 +5938,14 @@ class EventStateInfoT
     // FIELD DepthWriteEnabled: Whether depth writes are enabled. Depth writes are always disabled
     // when DepthTestEnable is false.
 
-    // `DepthWriteEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* DepthWriteEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthWriteEnabledOffset * m_cap);
-    }
-    inline bool* DepthWriteEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthWriteEnabledOffset * m_cap);
-    }
-    // `DepthWriteEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `DepthWriteEnabledPtr(id)` returns a pointer to the `DepthWriteEnabled` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const bool* DepthWriteEnabledPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthWriteEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* DepthWriteEnabledPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthWriteEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kDepthWriteEnabledIndex)) return &kDefault;
+        return &m_depth_write_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `DepthWriteEnabled(id)` retuns the `DepthWriteEnabled` element of the object identified by
     // `id`
@@ -6367,7 +5960,7 @@ class EventStateInfoT
     inline SOA& SetDepthWriteEnabled(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *DepthWriteEnabledPtr(id) = value;
+        m_depth_write_enabled_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kDepthWriteEnabledIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6389,33 +5982,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD DepthCompareOp: Comparison operator used for the depth test
 
-    // `DepthCompareOpPtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkCompareOp* DepthCompareOpPtr() const
-    {
-        return reinterpret_cast<VkCompareOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                              kDepthCompareOpOffset * m_cap);
-    }
-    inline VkCompareOp* DepthCompareOpPtr()
-    {
-        return reinterpret_cast<VkCompareOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                              kDepthCompareOpOffset * m_cap);
-    }
-    // `DepthCompareOpPtr()` returns a shared pointer to an array of `size()` elements
+    // `DepthCompareOpPtr(id)` returns a pointer to the `DepthCompareOp` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const VkCompareOp* DepthCompareOpPtr(Id id) const
     {
-        return reinterpret_cast<VkCompareOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                              kDepthCompareOpOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline VkCompareOp* DepthCompareOpPtr(Id id)
-    {
-        return reinterpret_cast<VkCompareOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                              kDepthCompareOpOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkCompareOp kDefault = VkCompareOp();
+        if (!IsFieldSet(id, kDepthCompareOpIndex)) return &kDefault;
+        return &m_depth_compare_op_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `DepthCompareOp(id)` retuns the `DepthCompareOp` element of the object identified by `id`
     inline VkCompareOp DepthCompareOp(Id id) const
@@ -6429,7 +6003,7 @@ class EventStateInfoT
     inline SOA& SetDepthCompareOp(Id id, VkCompareOp value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *DepthCompareOpPtr(id) = value;
+        m_depth_compare_op_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kDepthCompareOpIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6450,33 +6024,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD DepthBoundsTestEnabled: Whether depth bounds testing is enabled
 
-    // `DepthBoundsTestEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* DepthBoundsTestEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthBoundsTestEnabledOffset * m_cap);
-    }
-    inline bool* DepthBoundsTestEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthBoundsTestEnabledOffset * m_cap);
-    }
-    // `DepthBoundsTestEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `DepthBoundsTestEnabledPtr(id)` returns a pointer to the `DepthBoundsTestEnabled` element of
+    // the object identified by `id`, which is only valid until the field is set again
     inline const bool* DepthBoundsTestEnabledPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthBoundsTestEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* DepthBoundsTestEnabledPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kDepthBoundsTestEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kDepthBoundsTestEnabledIndex)) return &kDefault;
+        return &m_depth_bounds_test_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `DepthBoundsTestEnabled(id)` retuns the `DepthBoundsTestEnabled` element of the object
     // identified by `id`
@@ -6491,7 +6046,7 @@ class EventStateInfoT
     inline SOA& SetDepthBoundsTestEnabled(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *DepthBoundsTestEnabledPtr(id) = value;
+        m_depth_bounds_test_enabled_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kDepthBoundsTestEnabledIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6512,33 +6067,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD MinDepthBounds: Minimum depth bound used in the depth bounds test
 
-    // `MinDepthBoundsPtr()` returns a shared pointer to an array of `size()` elements
-    inline const float* MinDepthBoundsPtr() const
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kMinDepthBoundsOffset * m_cap);
-    }
-    inline float* MinDepthBoundsPtr()
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kMinDepthBoundsOffset * m_cap);
-    }
-    // `MinDepthBoundsPtr()` returns a shared pointer to an array of `size()` elements
+    // `MinDepthBoundsPtr(id)` returns a pointer to the `MinDepthBounds` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const float* MinDepthBoundsPtr(Id id) const
     {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kMinDepthBoundsOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline float* MinDepthBoundsPtr(Id id)
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kMinDepthBoundsOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const float kDefault = float();
+        if (!IsFieldSet(id, kMinDepthBoundsIndex)) return &kDefault;
+        return &m_min_depth_bounds_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `MinDepthBounds(id)` retuns the `MinDepthBounds` element of the object identified by `id`
     inline float MinDepthBounds(Id id) const
@@ -6552,7 +6088,7 @@ class EventStateInfoT
     inline SOA& SetMinDepthBounds(Id id, float value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *MinDepthBoundsPtr(id) = value;
+        m_min_depth_bounds_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kMinDepthBoundsIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6573,33 +6109,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD MaxDepthBounds: Maximum depth bound used in the depth bounds test
 
-    // `MaxDepthBoundsPtr()` returns a shared pointer to an array of `size()` elements
-    inline const float* MaxDepthBoundsPtr() const
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kMaxDepthBoundsOffset * m_cap);
-    }
-    inline float* MaxDepthBoundsPtr()
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kMaxDepthBoundsOffset * m_cap);
-    }
-    // `MaxDepthBoundsPtr()` returns a shared pointer to an array of `size()` elements
+    // `MaxDepthBoundsPtr(id)` returns a pointer to the `MaxDepthBounds` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const float* MaxDepthBoundsPtr(Id id) const
     {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kMaxDepthBoundsOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline float* MaxDepthBoundsPtr(Id id)
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kMaxDepthBoundsOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const float kDefault = float();
+        if (!IsFieldSet(id, kMaxDepthBoundsIndex)) return &kDefault;
+        return &m_max_depth_bounds_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `MaxDepthBounds(id)` retuns the `MaxDepthBounds` element of the object identified by `id`
     inline float MaxDepthBounds(Id id) const
@@ -6613,7 +6130,7 @@ class EventStateInfoT
     inline SOA& SetMaxDepthBounds(Id id, float value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *MaxDepthBoundsPtr(id) = value;
+        m_max_depth_bounds_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kMaxDepthBoundsIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6634,33 +6151,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD StencilTestEnabled: Whether stencil testing is enabled
 
-    // `StencilTestEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* StencilTestEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kStencilTestEnabledOffset * m_cap);
-    }
-    inline bool* StencilTestEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kStencilTestEnabledOffset * m_cap);
-    }
-    // `StencilTestEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `StencilTestEnabledPtr(id)` returns a pointer to the `StencilTestEnabled` element of the
+    // object identified by `id`, which is only valid until the field is set again
     inline const bool* StencilTestEnabledPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kStencilTestEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* StencilTestEnabledPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kStencilTestEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kStencilTestEnabledIndex)) return &kDefault;
+        return &m_stencil_test_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `StencilTestEnabled(id)` retuns the `StencilTestEnabled` element of the object identified by
     // `id`
@@ -6675,7 +6173,7 @@ class EventStateInfoT
     inline SOA& SetStencilTestEnabled(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *StencilTestEnabledPtr(id) = value;
+        m_stencil_test_enabled_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kStencilTestEnabledIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6696,33 +6194,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD StencilOpStateFront: Front parameter of the stencil test
 
-    // `StencilOpStateFrontPtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkStencilOpState* StencilOpStateFrontPtr() const
-    {
-        return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                   kStencilOpStateFrontOffset * m_cap);
-    }
-    inline VkStencilOpState* StencilOpStateFrontPtr()
-    {
-        return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                   kStencilOpStateFrontOffset * m_cap);
-    }
-    // `StencilOpStateFrontPtr()` returns a shared pointer to an array of `size()` elements
+    // `StencilOpStateFrontPtr(id)` returns a pointer to the `StencilOpStateFront` element of the
+    // object identified by `id`, which is only valid until the field is set again
     inline const VkStencilOpState* StencilOpStateFrontPtr(Id id) const
     {
-        return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                   kStencilOpStateFrontOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline VkStencilOpState* StencilOpStateFrontPtr(Id id)
-    {
-        return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                   kStencilOpStateFrontOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkStencilOpState kDefault = VkStencilOpState();
+        if (!IsFieldSet(id, kStencilOpStateFrontIndex)) return &kDefault;
+        return &m_stencil_op_state_front_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `StencilOpStateFront(id)` retuns the `StencilOpStateFront` element of the object identified
     // by `id`
@@ -6737,7 +6216,7 @@ class EventStateInfoT
     inline SOA& SetStencilOpStateFront(Id id, VkStencilOpState value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *StencilOpStateFrontPtr(id) = value;
+        m_stencil_op_state_front_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kStencilOpStateFrontIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6758,33 +6237,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD StencilOpStateBack: Back parameter of the stencil test
 
-    // `StencilOpStateBackPtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkStencilOpState* StencilOpStateBackPtr() const
-    {
-        return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                   kStencilOpStateBackOffset * m_cap);
-    }
-    inline VkStencilOpState* StencilOpStateBackPtr()
-    {
-        return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                   kStencilOpStateBackOffset * m_cap);
-    }
-    // `StencilOpStateBackPtr()` returns a shared pointer to an array of `size()` elements
+    // `StencilOpStateBackPtr(id)` returns a pointer to the `StencilOpStateBack` element of the
+    // object identified by `id`, which is only valid until the field is set again
     inline const VkStencilOpState* StencilOpStateBackPtr(Id id) const
     {
-        return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                   kStencilOpStateBackOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline VkStencilOpState* StencilOpStateBackPtr(Id id)
-    {
-        return reinterpret_cast<VkStencilOpState*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                   kStencilOpStateBackOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkStencilOpState kDefault = VkStencilOpState();
+        if (!IsFieldSet(id, kStencilOpStateBackIndex)) return &kDefault;
+        return &m_stencil_op_state_back_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `StencilOpStateBack(id)` retuns the `StencilOpStateBack` element of the object identified by
     // `id`
@@ -6799,7 +6259,7 @@ class EventStateInfoT
     inline SOA& SetStencilOpStateBack(Id id, VkStencilOpState value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *StencilOpStateBackPtr(id) = value;
+        m_stencil_op_state_back_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kStencilOpStateBackIndex);
         return static_cast<SOA&>(*this);
     }
@@ -6820,33 +6280,15 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD LogicOpEnabled: Whether to apply Logical Operations
 
-    // `LogicOpEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* LogicOpEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLogicOpEnabledOffset * m_cap);
-    }
-    inline bool* LogicOpEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLogicOpEnabledOffset * m_cap);
-    }
-    // `LogicOpEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `LogicOpEnabledPtr(id)` returns a pointer to the `LogicOpEnabled` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const bool* LogicOpEnabledPtr(Id id, uint32_t attachment = 0) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLogicOpEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 8 + attachment
-
-            ;
-    }
-    inline bool* LogicOpEnabledPtr(Id id, uint32_t attachment = 0)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLogicOpEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 8 + attachment
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kLogicOpEnabledIndex + attachment)) return &kDefault;
+        return m_logic_op_enabled_runs.Get(static_cast<typename Id::basic_type>(id)).data() +
+               attachment;
     }
     // `LogicOpEnabled(id)` retuns the `LogicOpEnabled` element of the object identified by `id`
     inline bool LogicOpEnabled(Id id, uint32_t attachment) const
@@ -6871,7 +6313,10 @@ class EventStateInfoT
     inline SOA& SetLogicOpEnabled(Id id, uint32_t attachment, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *LogicOpEnabledPtr(id, attachment) = value;
+        std::array<bool, kLogicOpEnabledArrayCount> values =
+            m_logic_op_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
+        values[attachment] = value;
+        m_logic_op_enabled_runs.Set(static_cast<typename Id::basic_type>(id), values);
         MarkFieldSet(id, kLogicOpEnabledIndex + attachment);
         return static_cast<SOA&>(*this);
     }
@@ -6892,33 +6337,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD LogicOp: Which logical operation to apply
 
-    // `LogicOpPtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkLogicOp* LogicOpPtr() const
-    {
-        return reinterpret_cast<VkLogicOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                            kLogicOpOffset * m_cap);
-    }
-    inline VkLogicOp* LogicOpPtr()
-    {
-        return reinterpret_cast<VkLogicOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                            kLogicOpOffset * m_cap);
-    }
-    // `LogicOpPtr()` returns a shared pointer to an array of `size()` elements
+    // `LogicOpPtr(id)` returns a pointer to the `LogicOp` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const VkLogicOp* LogicOpPtr(Id id, uint32_t attachment = 0) const
     {
-        return reinterpret_cast<VkLogicOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                            kLogicOpOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 8 + attachment
-
-            ;
-    }
-    inline VkLogicOp* LogicOpPtr(Id id, uint32_t attachment = 0)
-    {
-        return reinterpret_cast<VkLogicOp*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                            kLogicOpOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 8 + attachment
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkLogicOp kDefault = VkLogicOp();
+        if (!IsFieldSet(id, kLogicOpIndex + attachment)) return &kDefault;
+        return m_logic_op_runs.Get(static_cast<typename Id::basic_type>(id)).data() + attachment;
     }
     // `LogicOp(id)` retuns the `LogicOp` element of the object identified by `id`
     inline VkLogicOp LogicOp(Id id, uint32_t attachment) const
@@ -6939,7 +6365,10 @@ class EventStateInfoT
     inline SOA& SetLogicOp(Id id, uint32_t attachment, VkLogicOp value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *LogicOpPtr(id, attachment) = value;
+        std::array<VkLogicOp, kLogicOpArrayCount> values =
+            m_logic_op_runs.Get(static_cast<typename Id::basic_type>(id));
+        values[attachment] = value;
+        m_logic_op_runs.Set(static_cast<typename Id::basic_type>(id), values);
         MarkFieldSet(id, kLogicOpIndex + attachment);
         return static_cast<SOA&>(*this);
     }
@@ -6957,34 +6386,16 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD Attachment: Per target attachment color blend states
 
-    // `AttachmentPtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkPipelineColorBlendAttachmentState* AttachmentPtr() const
-    {
-        return reinterpret_cast<VkPipelineColorBlendAttachmentState*>(
-            reinterpret_cast<uint8_t*>(m_buffer.get()) + kAttachmentOffset * m_cap);
-    }
-    inline VkPipelineColorBlendAttachmentState* AttachmentPtr()
-    {
-        return reinterpret_cast<VkPipelineColorBlendAttachmentState*>(
-            reinterpret_cast<uint8_t*>(m_buffer.get()) + kAttachmentOffset * m_cap);
-    }
-    // `AttachmentPtr()` returns a shared pointer to an array of `size()` elements
+    // `AttachmentPtr(id)` returns a pointer to the `Attachment` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const VkPipelineColorBlendAttachmentState* AttachmentPtr(Id id,
                                                                     uint32_t attachment = 0) const
     {
-        return reinterpret_cast<VkPipelineColorBlendAttachmentState*>(
-                   reinterpret_cast<uint8_t*>(m_buffer.get()) + kAttachmentOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 8 + attachment
-
-            ;
-    }
-    inline VkPipelineColorBlendAttachmentState* AttachmentPtr(Id id, uint32_t attachment = 0)
-    {
-        return reinterpret_cast<VkPipelineColorBlendAttachmentState*>(
-                   reinterpret_cast<uint8_t*>(m_buffer.get()) + kAttachmentOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 8 + attachment
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkPipelineColorBlendAttachmentState kDefault =
+            VkPipelineColorBlendAttachmentState();
+        if (!IsFieldSet(id, kAttachmentIndex + attachment)) return &kDefault;
+        return m_attachment_runs.Get(static_cast<typename Id::basic_type>(id)).data() + attachment;
     }
     // `Attachment(id)` retuns the `Attachment` element of the object identified by `id`
     inline VkPipelineColorBlendAttachmentState Attachment(Id id, uint32_t attachment) const
@@ -7008,7 +6419,10 @@ class EventStateInfoT
     inline SOA& SetAttachment(Id id, uint32_t attachment, VkPipelineColorBlendAttachmentState value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *AttachmentPtr(id, attachment) = value;
+        std::array<VkPipelineColorBlendAttachmentState, kAttachmentArrayCount> values =
+            m_attachment_runs.Get(static_cast<typename Id::basic_type>(id));
+        values[attachment] = value;
+        m_attachment_runs.Set(static_cast<typename Id::basic_type>(id), values);
         MarkFieldSet(id, kAttachmentIndex + attachment);
         return static_cast<SOA&>(*this);
     }
@@ -7029,33 +6443,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD BlendConstant: A color constant used for blending
 
-    // `BlendConstantPtr()` returns a shared pointer to an array of `size()` elements
-    inline const float* BlendConstantPtr() const
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kBlendConstantOffset * m_cap);
-    }
-    inline float* BlendConstantPtr()
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kBlendConstantOffset * m_cap);
-    }
-    // `BlendConstantPtr()` returns a shared pointer to an array of `size()` elements
+    // `BlendConstantPtr(id)` returns a pointer to the `BlendConstant` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const float* BlendConstantPtr(Id id, uint32_t channel = 0) const
     {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kBlendConstantOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 4 + channel
-
-            ;
-    }
-    inline float* BlendConstantPtr(Id id, uint32_t channel = 0)
-    {
-        return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                        kBlendConstantOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 4 + channel
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const float kDefault = float();
+        if (!IsFieldSet(id, kBlendConstantIndex + channel)) return &kDefault;
+        return m_blend_constant_runs.Get(static_cast<typename Id::basic_type>(id)).data() + channel;
     }
     // `BlendConstant(id)` retuns the `BlendConstant` element of the object identified by `id`
     inline float BlendConstant(Id id, uint32_t channel) const
@@ -7080,7 +6475,10 @@ class EventStateInfoT
     inline SOA& SetBlendConstant(Id id, uint32_t channel, float value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *BlendConstantPtr(id, channel) = value;
+        std::array<float, kBlendConstantArrayCount> values =
+            m_blend_constant_runs.Get(static_cast<typename Id::basic_type>(id));
+        values[channel] = value;
+        m_blend_constant_runs.Set(static_cast<typename Id::basic_type>(id), values);
         MarkFieldSet(id, kBlendConstantIndex + channel);
         return static_cast<SOA&>(*this);
     }
@@ -7101,33 +6499,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD LRZEnabled: Whether LRZ is enabled for depth
 
-    // `LRZEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* LRZEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLRZEnabledOffset * m_cap);
-    }
-    inline bool* LRZEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLRZEnabledOffset * m_cap);
-    }
-    // `LRZEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `LRZEnabledPtr(id)` returns a pointer to the `LRZEnabled` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const bool* LRZEnabledPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLRZEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* LRZEnabledPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLRZEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kLRZEnabledIndex)) return &kDefault;
+        return &m_lrz_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `LRZEnabled(id)` retuns the `LRZEnabled` element of the object identified by `id`
     inline bool LRZEnabled(Id id) const
@@ -7140,7 +6519,7 @@ class EventStateInfoT
     inline SOA& SetLRZEnabled(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *LRZEnabledPtr(id) = value;
+        m_lrz_enabled_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kLRZEnabledIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7161,33 +6540,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD LRZWrite: Whether LRZ write is enabled
 
-    // `LRZWritePtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* LRZWritePtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLRZWriteOffset * m_cap);
-    }
-    inline bool* LRZWritePtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLRZWriteOffset * m_cap);
-    }
-    // `LRZWritePtr()` returns a shared pointer to an array of `size()` elements
+    // `LRZWritePtr(id)` returns a pointer to the `LRZWrite` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const bool* LRZWritePtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLRZWriteOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* LRZWritePtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLRZWriteOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kLRZWriteIndex)) return &kDefault;
+        return &m_lrz_write_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `LRZWrite(id)` retuns the `LRZWrite` element of the object identified by `id`
     inline bool LRZWrite(Id id) const
@@ -7200,7 +6560,7 @@ class EventStateInfoT
     inline SOA& SetLRZWrite(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *LRZWritePtr(id) = value;
+        m_lrz_write_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kLRZWriteIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7218,33 +6578,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD LRZDirStatus: LRZ direction
 
-    // `LRZDirStatusPtr()` returns a shared pointer to an array of `size()` elements
-    inline const a6xx_lrz_dir_status* LRZDirStatusPtr() const
-    {
-        return reinterpret_cast<a6xx_lrz_dir_status*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                      kLRZDirStatusOffset * m_cap);
-    }
-    inline a6xx_lrz_dir_status* LRZDirStatusPtr()
-    {
-        return reinterpret_cast<a6xx_lrz_dir_status*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                      kLRZDirStatusOffset * m_cap);
-    }
-    // `LRZDirStatusPtr()` returns a shared pointer to an array of `size()` elements
+    // `LRZDirStatusPtr(id)` returns a pointer to the `LRZDirStatus` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const a6xx_lrz_dir_status* LRZDirStatusPtr(Id id) const
     {
-        return reinterpret_cast<a6xx_lrz_dir_status*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                      kLRZDirStatusOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline a6xx_lrz_dir_status* LRZDirStatusPtr(Id id)
-    {
-        return reinterpret_cast<a6xx_lrz_dir_status*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                      kLRZDirStatusOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const a6xx_lrz_dir_status kDefault = a6xx_lrz_dir_status();
+        if (!IsFieldSet(id, kLRZDirStatusIndex)) return &kDefault;
+        return &m_lrz_dir_status_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `LRZDirStatus(id)` retuns the `LRZDirStatus` element of the object identified by `id`
     inline a6xx_lrz_dir_status LRZDirStatus(Id id) const
@@ -7257,7 +6598,7 @@ class EventStateInfoT
     inline SOA& SetLRZDirStatus(Id id, a6xx_lrz_dir_status value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *LRZDirStatusPtr(id) = value;
+        m_lrz_dir_status_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kLRZDirStatusIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7275,33 +6616,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD LRZDirWrite: Whether LRZ direction write is enabled
 
-    // `LRZDirWritePtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* LRZDirWritePtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLRZDirWriteOffset * m_cap);
-    }
-    inline bool* LRZDirWritePtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLRZDirWriteOffset * m_cap);
-    }
-    // `LRZDirWritePtr()` returns a shared pointer to an array of `size()` elements
+    // `LRZDirWritePtr(id)` returns a pointer to the `LRZDirWrite` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const bool* LRZDirWritePtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLRZDirWriteOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* LRZDirWritePtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kLRZDirWriteOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kLRZDirWriteIndex)) return &kDefault;
+        return &m_lrz_dir_write_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `LRZDirWrite(id)` retuns the `LRZDirWrite` element of the object identified by `id`
     inline bool LRZDirWrite(Id id) const
@@ -7314,7 +6636,7 @@ class EventStateInfoT
     inline SOA& SetLRZDirWrite(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *LRZDirWritePtr(id) = value;
+        m_lrz_dir_write_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kLRZDirWriteIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7332,36 +6654,17 @@ class EventStateInfoT
         return "Whether LRZ direction write is enabled";
     }
 
-    //-----------------------------------------------
-    // FIELD ZTestMode: Depth test mode
-
-    // `ZTestModePtr()` returns a shared pointer to an array of `size()` elements
-    inline const a6xx_ztest_mode* ZTestModePtr() const
-    {
-        return reinterpret_cast<a6xx_ztest_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                  kZTestModeOffset * m_cap);
-    }
-    inline a6xx_ztest_mode* ZTestModePtr()
-    {
-        return reinterpret_cast<a6xx_ztest_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                  kZTestModeOffset * m_cap);
-    }
-    // `ZTestModePtr()` returns a shared pointer to an array of `size()` elements
-    inline const a6xx_ztest_mode* ZTestModePtr(Id id) const
-    {
-        return reinterpret_cast<a6xx_ztest_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                  kZTestModeOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
+    //-----------------------------------------------
+    // FIELD ZTestMode: Depth test mode
 
-            ;
-    }
-    inline a6xx_ztest_mode* ZTestModePtr(Id id)
+    // `ZTestModePtr(id)` returns a pointer to the `ZTestMode` element of the object identified
+    // by `id`, which is only valid until the field is set again
+    inline const a6xx_ztest_mode* ZTestModePtr(Id id) const
     {
-        return reinterpret_cast<a6xx_ztest_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                  kZTestModeOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const a6xx_ztest_mode kDefault = a6xx_ztest_mode();
+        if (!IsFieldSet(id, kZTestModeIndex)) return &kDefault;
+        return &m_z_test_mode_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `ZTestMode(id)` retuns the `ZTestMode` element of the object identified by `id`
     inline a6xx_ztest_mode ZTestMode(Id id) const
@@ -7374,7 +6677,7 @@ class EventStateInfoT
     inline SOA& SetZTestMode(Id id, a6xx_ztest_mode value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *ZTestModePtr(id) = value;
+        m_z_test_mode_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kZTestModeIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7392,33 +6695,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD BinW: Bin width
 
-    // `BinWPtr()` returns a shared pointer to an array of `size()` elements
-    inline const uint32_t* BinWPtr() const
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kBinWOffset * m_cap);
-    }
-    inline uint32_t* BinWPtr()
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kBinWOffset * m_cap);
-    }
-    // `BinWPtr()` returns a shared pointer to an array of `size()` elements
+    // `BinWPtr(id)` returns a pointer to the `BinW` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const uint32_t* BinWPtr(Id id) const
     {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kBinWOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline uint32_t* BinWPtr(Id id)
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kBinWOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const uint32_t kDefault = uint32_t();
+        if (!IsFieldSet(id, kBinWIndex)) return &kDefault;
+        return &m_bin_w_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `BinW(id)` retuns the `BinW` element of the object identified by `id`
     inline uint32_t BinW(Id id) const
@@ -7431,7 +6715,7 @@ class EventStateInfoT
     inline SOA& SetBinW(Id id, uint32_t value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *BinWPtr(id) = value;
+        m_bin_w_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kBinWIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7449,33 +6733,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD BinH: Bin Height
 
-    // `BinHPtr()` returns a shared pointer to an array of `size()` elements
-    inline const uint32_t* BinHPtr() const
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kBinHOffset * m_cap);
-    }
-    inline uint32_t* BinHPtr()
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kBinHOffset * m_cap);
-    }
-    // `BinHPtr()` returns a shared pointer to an array of `size()` elements
+    // `BinHPtr(id)` returns a pointer to the `BinH` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const uint32_t* BinHPtr(Id id) const
     {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kBinHOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline uint32_t* BinHPtr(Id id)
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kBinHOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const uint32_t kDefault = uint32_t();
+        if (!IsFieldSet(id, kBinHIndex)) return &kDefault;
+        return &m_bin_h_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `BinH(id)` retuns the `BinH` element of the object identified by `id`
     inline uint32_t BinH(Id id) const
@@ -7488,7 +6753,7 @@ class EventStateInfoT
     inline SOA& SetBinH(Id id, uint32_t value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *BinHPtr(id) = value;
+        m_bin_h_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kBinHIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7506,33 +6771,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD WindowScissorTLX: Window scissor Top Left X-coordinate
 
-    // `WindowScissorTLXPtr()` returns a shared pointer to an array of `size()` elements
-    inline const uint16_t* WindowScissorTLXPtr() const
-    {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorTLXOffset * m_cap);
-    }
-    inline uint16_t* WindowScissorTLXPtr()
-    {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorTLXOffset * m_cap);
-    }
-    // `WindowScissorTLXPtr()` returns a shared pointer to an array of `size()` elements
+    // `WindowScissorTLXPtr(id)` returns a pointer to the `WindowScissorTLX` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const uint16_t* WindowScissorTLXPtr(Id id) const
     {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorTLXOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline uint16_t* WindowScissorTLXPtr(Id id)
-    {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorTLXOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const uint16_t kDefault = uint16_t();
+        if (!IsFieldSet(id, kWindowScissorTLXIndex)) return &kDefault;
+        return &m_window_scissor_tlx_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `WindowScissorTLX(id)` retuns the `WindowScissorTLX` element of the object identified by `id`
     inline uint16_t WindowScissorTLX(Id id) const
@@ -7546,7 +6792,7 @@ class EventStateInfoT
     inline SOA& SetWindowScissorTLX(Id id, uint16_t value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *WindowScissorTLXPtr(id) = value;
+        m_window_scissor_tlx_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kWindowScissorTLXIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7567,33 +6813,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD WindowScissorTLY: Window scissor Top Left Y-coordinate
 
-    // `WindowScissorTLYPtr()` returns a shared pointer to an array of `size()` elements
-    inline const uint16_t* WindowScissorTLYPtr() const
-    {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorTLYOffset * m_cap);
-    }
-    inline uint16_t* WindowScissorTLYPtr()
-    {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorTLYOffset * m_cap);
-    }
-    // `WindowScissorTLYPtr()` returns a shared pointer to an array of `size()` elements
+    // `WindowScissorTLYPtr(id)` returns a pointer to the `WindowScissorTLY` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const uint16_t* WindowScissorTLYPtr(Id id) const
     {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorTLYOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline uint16_t* WindowScissorTLYPtr(Id id)
-    {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorTLYOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const uint16_t kDefault = uint16_t();
+        if (!IsFieldSet(id, kWindowScissorTLYIndex)) return &kDefault;
+        return &m_window_scissor_tly_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `WindowScissorTLY(id)` retuns the `WindowScissorTLY` element of the object identified by `id`
     inline uint16_t WindowScissorTLY(Id id) const
@@ -7607,7 +6834,7 @@ class EventStateInfoT
     inline SOA& SetWindowScissorTLY(Id id, uint16_t value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *WindowScissorTLYPtr(id) = value;
+        m_window_scissor_tly_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kWindowScissorTLYIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7628,33 +6855,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD WindowScissorBRX: Window scissor Bottom Right X-coordinate
 
-    // `WindowScissorBRXPtr()` returns a shared pointer to an array of `size()` elements
-    inline const uint16_t* WindowScissorBRXPtr() const
-    {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorBRXOffset * m_cap);
-    }
-    inline uint16_t* WindowScissorBRXPtr()
-    {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorBRXOffset * m_cap);
-    }
-    // `WindowScissorBRXPtr()` returns a shared pointer to an array of `size()` elements
+    // `WindowScissorBRXPtr(id)` returns a pointer to the `WindowScissorBRX` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const uint16_t* WindowScissorBRXPtr(Id id) const
     {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorBRXOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline uint16_t* WindowScissorBRXPtr(Id id)
-    {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorBRXOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const uint16_t kDefault = uint16_t();
+        if (!IsFieldSet(id, kWindowScissorBRXIndex)) return &kDefault;
+        return &m_window_scissor_brx_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `WindowScissorBRX(id)` retuns the `WindowScissorBRX` element of the object identified by `id`
     inline uint16_t WindowScissorBRX(Id id) const
@@ -7668,7 +6876,7 @@ class EventStateInfoT
     inline SOA& SetWindowScissorBRX(Id id, uint16_t value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *WindowScissorBRXPtr(id) = value;
+        m_window_scissor_brx_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kWindowScissorBRXIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7689,33 +6897,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD WindowScissorBRY: Window scissor Bottom Right Y-coordinate
 
-    // `WindowScissorBRYPtr()` returns a shared pointer to an array of `size()` elements
-    inline const uint16_t* WindowScissorBRYPtr() const
-    {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorBRYOffset * m_cap);
-    }
-    inline uint16_t* WindowScissorBRYPtr()
-    {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorBRYOffset * m_cap);
-    }
-    // `WindowScissorBRYPtr()` returns a shared pointer to an array of `size()` elements
+    // `WindowScissorBRYPtr(id)` returns a pointer to the `WindowScissorBRY` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const uint16_t* WindowScissorBRYPtr(Id id) const
     {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorBRYOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline uint16_t* WindowScissorBRYPtr(Id id)
-    {
-        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kWindowScissorBRYOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const uint16_t kDefault = uint16_t();
+        if (!IsFieldSet(id, kWindowScissorBRYIndex)) return &kDefault;
+        return &m_window_scissor_bry_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `WindowScissorBRY(id)` retuns the `WindowScissorBRY` element of the object identified by `id`
     inline uint16_t WindowScissorBRY(Id id) const
@@ -7729,7 +6918,7 @@ class EventStateInfoT
     inline SOA& SetWindowScissorBRY(Id id, uint16_t value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *WindowScissorBRYPtr(id) = value;
+        m_window_scissor_bry_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kWindowScissorBRYIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7750,33 +6939,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD RenderMode: Whether in binning pass or rendering pass
 
-    // `RenderModePtr()` returns a shared pointer to an array of `size()` elements
-    inline const a6xx_render_mode* RenderModePtr() const
-    {
-        return reinterpret_cast<a6xx_render_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                   kRenderModeOffset * m_cap);
-    }
-    inline a6xx_render_mode* RenderModePtr()
-    {
-        return reinterpret_cast<a6xx_render_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                   kRenderModeOffset * m_cap);
-    }
-    // `RenderModePtr()` returns a shared pointer to an array of `size()` elements
+    // `RenderModePtr(id)` returns a pointer to the `RenderMode` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const a6xx_render_mode* RenderModePtr(Id id) const
     {
-        return reinterpret_cast<a6xx_render_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                   kRenderModeOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline a6xx_render_mode* RenderModePtr(Id id)
-    {
-        return reinterpret_cast<a6xx_render_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                   kRenderModeOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const a6xx_render_mode kDefault = a6xx_render_mode();
+        if (!IsFieldSet(id, kRenderModeIndex)) return &kDefault;
+        return &m_render_mode_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `RenderMode(id)` retuns the `RenderMode` element of the object identified by `id`
     inline a6xx_render_mode RenderMode(Id id) const
@@ -7789,7 +6959,7 @@ class EventStateInfoT
     inline SOA& SetRenderMode(Id id, a6xx_render_mode value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *RenderModePtr(id) = value;
+        m_render_mode_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kRenderModeIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7810,33 +6980,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD BuffersLocation: Whether the target buffer is in GMEM or SYSMEM
 
-    // `BuffersLocationPtr()` returns a shared pointer to an array of `size()` elements
-    inline const a6xx_buffers_location* BuffersLocationPtr() const
-    {
-        return reinterpret_cast<a6xx_buffers_location*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                        kBuffersLocationOffset * m_cap);
-    }
-    inline a6xx_buffers_location* BuffersLocationPtr()
-    {
-        return reinterpret_cast<a6xx_buffers_location*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                        kBuffersLocationOffset * m_cap);
-    }
-    // `BuffersLocationPtr()` returns a shared pointer to an array of `size()` elements
+    // `BuffersLocationPtr(id)` returns a pointer to the `BuffersLocation` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const a6xx_buffers_location* BuffersLocationPtr(Id id) const
     {
-        return reinterpret_cast<a6xx_buffers_location*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                        kBuffersLocationOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline a6xx_buffers_location* BuffersLocationPtr(Id id)
-    {
-        return reinterpret_cast<a6xx_buffers_location*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                        kBuffersLocationOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const a6xx_buffers_location kDefault = a6xx_buffers_location();
+        if (!IsFieldSet(id, kBuffersLocationIndex)) return &kDefault;
+        return &m_buffers_location_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `BuffersLocation(id)` retuns the `BuffersLocation` element of the object identified by `id`
     inline a6xx_buffers_location BuffersLocation(Id id) const
@@ -7850,7 +7001,7 @@ class EventStateInfoT
     inline SOA& SetBuffersLocation(Id id, a6xx_buffers_location value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *BuffersLocationPtr(id) = value;
+        m_buffers_location_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kBuffersLocationIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7871,33 +7022,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD ThreadSize: Whether the thread size is 64 or 128
 
-    // `ThreadSizePtr()` returns a shared pointer to an array of `size()` elements
-    inline const a6xx_threadsize* ThreadSizePtr() const
-    {
-        return reinterpret_cast<a6xx_threadsize*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                  kThreadSizeOffset * m_cap);
-    }
-    inline a6xx_threadsize* ThreadSizePtr()
-    {
-        return reinterpret_cast<a6xx_threadsize*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                  kThreadSizeOffset * m_cap);
-    }
-    // `ThreadSizePtr()` returns a shared pointer to an array of `size()` elements
+    // `ThreadSizePtr(id)` returns a pointer to the `ThreadSize` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const a6xx_threadsize* ThreadSizePtr(Id id) const
     {
-        return reinterpret_cast<a6xx_threadsize*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                  kThreadSizeOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline a6xx_threadsize* ThreadSizePtr(Id id)
-    {
-        return reinterpret_cast<a6xx_threadsize*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                  kThreadSizeOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const a6xx_threadsize kDefault = a6xx_threadsize();
+        if (!IsFieldSet(id, kThreadSizeIndex)) return &kDefault;
+        return &m_thread_size_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `ThreadSize(id)` retuns the `ThreadSize` element of the object identified by `id`
     inline a6xx_threadsize ThreadSize(Id id) const
@@ -7910,7 +7042,7 @@ class EventStateInfoT
     inline SOA& SetThreadSize(Id id, a6xx_threadsize value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *ThreadSizePtr(id) = value;
+        m_thread_size_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kThreadSizeIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7932,33 +7064,14 @@ class EventStateInfoT
     // FIELD EnableAllHelperLanes: Whether all helper lanes are enabled of the 2x2 quad for fine
     // derivatives
 
-    // `EnableAllHelperLanesPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* EnableAllHelperLanesPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kEnableAllHelperLanesOffset * m_cap);
-    }
-    inline bool* EnableAllHelperLanesPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kEnableAllHelperLanesOffset * m_cap);
-    }
-    // `EnableAllHelperLanesPtr()` returns a shared pointer to an array of `size()` elements
+    // `EnableAllHelperLanesPtr(id)` returns a pointer to the `EnableAllHelperLanes` element of the
+    // object identified by `id`, which is only valid until the field is set again
     inline const bool* EnableAllHelperLanesPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kEnableAllHelperLanesOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* EnableAllHelperLanesPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kEnableAllHelperLanesOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kEnableAllHelperLanesIndex)) return &kDefault;
+        return &m_enable_all_helper_lanes_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `EnableAllHelperLanes(id)` retuns the `EnableAllHelperLanes` element of the object identified
     // by `id`
@@ -7973,7 +7086,7 @@ class EventStateInfoT
     inline SOA& SetEnableAllHelperLanes(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *EnableAllHelperLanesPtr(id) = value;
+        m_enable_all_helper_lanes_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kEnableAllHelperLanesIndex);
         return static_cast<SOA&>(*this);
     }
@@ -7995,33 +7108,14 @@ class EventStateInfoT
     // FIELD EnablePartialHelperLanes: Whether 3 out of 4 helper lanes are enabled of the 2x2 quad
     // for coarse derivatives
 
-    // `EnablePartialHelperLanesPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* EnablePartialHelperLanesPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kEnablePartialHelperLanesOffset * m_cap);
-    }
-    inline bool* EnablePartialHelperLanesPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kEnablePartialHelperLanesOffset * m_cap);
-    }
-    // `EnablePartialHelperLanesPtr()` returns a shared pointer to an array of `size()` elements
+    // `EnablePartialHelperLanesPtr(id)` returns a pointer to the `EnablePartialHelperLanes` element
+    // of the object identified by `id`, which is only valid until the field is set again
     inline const bool* EnablePartialHelperLanesPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kEnablePartialHelperLanesOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* EnablePartialHelperLanesPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kEnablePartialHelperLanesOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kEnablePartialHelperLanesIndex)) return &kDefault;
+        return &m_enable_partial_helper_lanes_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `EnablePartialHelperLanes(id)` retuns the `EnablePartialHelperLanes` element of the object
     // identified by `id`
@@ -8036,7 +7130,7 @@ class EventStateInfoT
     inline SOA& SetEnablePartialHelperLanes(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *EnablePartialHelperLanesPtr(id) = value;
+        m_enable_partial_helper_lanes_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kEnablePartialHelperLanesIndex);
         return static_cast<SOA&>(*this);
     }
@@ -8060,33 +7154,15 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD UBWCEnabled: Whether UBWC is enabled for this attachment
 
-    // `UBWCEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* UBWCEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCEnabledOffset * m_cap);
-    }
-    inline bool* UBWCEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCEnabledOffset * m_cap);
-    }
-    // `UBWCEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `UBWCEnabledPtr(id)` returns a pointer to the `UBWCEnabled` element of the object identified
+    // by `id`, which is only valid until the field is set again
     inline const bool* UBWCEnabledPtr(Id id, uint32_t attachment = 0) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 8 + attachment
-
-            ;
-    }
-    inline bool* UBWCEnabledPtr(Id id, uint32_t attachment = 0)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 8 + attachment
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kUBWCEnabledIndex + attachment)) return &kDefault;
+        return m_ubwc_enabled_runs.Get(static_cast<typename Id::basic_type>(id)).data() +
+               attachment;
     }
     // `UBWCEnabled(id)` retuns the `UBWCEnabled` element of the object identified by `id`
     inline bool UBWCEnabled(Id id, uint32_t attachment) const
@@ -8110,7 +7186,10 @@ class EventStateInfoT
     inline SOA& SetUBWCEnabled(Id id, uint32_t attachment, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *UBWCEnabledPtr(id, attachment) = value;
+        std::array<bool, kUBWCEnabledArrayCount> values =
+            m_ubwc_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
+        values[attachment] = value;
+        m_ubwc_enabled_runs.Set(static_cast<typename Id::basic_type>(id), values);
         MarkFieldSet(id, kUBWCEnabledIndex + attachment);
         return static_cast<SOA&>(*this);
     }
@@ -8132,33 +7211,15 @@ class EventStateInfoT
     // FIELD UBWCLosslessEnabled: Whether UBWC Lossless compression (A7XX+) is enabled for this
     // attachment
 
-    // `UBWCLosslessEnabledPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* UBWCLosslessEnabledPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCLosslessEnabledOffset * m_cap);
-    }
-    inline bool* UBWCLosslessEnabledPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCLosslessEnabledOffset * m_cap);
-    }
-    // `UBWCLosslessEnabledPtr()` returns a shared pointer to an array of `size()` elements
+    // `UBWCLosslessEnabledPtr(id)` returns a pointer to the `UBWCLosslessEnabled` element of the
+    // object identified by `id`, which is only valid until the field is set again
     inline const bool* UBWCLosslessEnabledPtr(Id id, uint32_t attachment = 0) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCLosslessEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 8 + attachment
-
-            ;
-    }
-    inline bool* UBWCLosslessEnabledPtr(Id id, uint32_t attachment = 0)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCLosslessEnabledOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id) * 8 + attachment
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kUBWCLosslessEnabledIndex + attachment)) return &kDefault;
+        return m_ubwc_lossless_enabled_runs.Get(static_cast<typename Id::basic_type>(id)).data() +
+               attachment;
     }
     // `UBWCLosslessEnabled(id)` retuns the `UBWCLosslessEnabled` element of the object identified
     // by `id`
@@ -8184,7 +7245,10 @@ class EventStateInfoT
     inline SOA& SetUBWCLosslessEnabled(Id id, uint32_t attachment, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *UBWCLosslessEnabledPtr(id, attachment) = value;
+        std::array<bool, kUBWCLosslessEnabledArrayCount> values =
+            m_ubwc_lossless_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
+        values[attachment] = value;
+        m_ubwc_lossless_enabled_runs.Set(static_cast<typename Id::basic_type>(id), values);
         MarkFieldSet(id, kUBWCLosslessEnabledIndex + attachment);
         return static_cast<SOA&>(*this);
     }
@@ -8205,33 +7269,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD UBWCEnabledOnDS: Whether UBWC is enabled for this depth stencil attachment
 
-    // `UBWCEnabledOnDSPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* UBWCEnabledOnDSPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCEnabledOnDSOffset * m_cap);
-    }
-    inline bool* UBWCEnabledOnDSPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCEnabledOnDSOffset * m_cap);
-    }
-    // `UBWCEnabledOnDSPtr()` returns a shared pointer to an array of `size()` elements
+    // `UBWCEnabledOnDSPtr(id)` returns a pointer to the `UBWCEnabledOnDS` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const bool* UBWCEnabledOnDSPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCEnabledOnDSOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* UBWCEnabledOnDSPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCEnabledOnDSOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kUBWCEnabledOnDSIndex)) return &kDefault;
+        return &m_ubwc_enabled_on_ds_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `UBWCEnabledOnDS(id)` retuns the `UBWCEnabledOnDS` element of the object identified by `id`
     inline bool UBWCEnabledOnDS(Id id) const
@@ -8245,7 +7290,7 @@ class EventStateInfoT
     inline SOA& SetUBWCEnabledOnDS(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *UBWCEnabledOnDSPtr(id) = value;
+        m_ubwc_enabled_on_ds_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kUBWCEnabledOnDSIndex);
         return static_cast<SOA&>(*this);
     }
@@ -8267,33 +7312,14 @@ class EventStateInfoT
     // FIELD UBWCLosslessEnabledOnDS: Whether UBWC Lossless compression (A7XX+) is enabled for this
     // depth stencil attachment
 
-    // `UBWCLosslessEnabledOnDSPtr()` returns a shared pointer to an array of `size()` elements
-    inline const bool* UBWCLosslessEnabledOnDSPtr() const
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCLosslessEnabledOnDSOffset * m_cap);
-    }
-    inline bool* UBWCLosslessEnabledOnDSPtr()
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCLosslessEnabledOnDSOffset * m_cap);
-    }
-    // `UBWCLosslessEnabledOnDSPtr()` returns a shared pointer to an array of `size()` elements
+    // `UBWCLosslessEnabledOnDSPtr(id)` returns a pointer to the `UBWCLosslessEnabledOnDS` element
+    // of the object identified by `id`, which is only valid until the field is set again
     inline const bool* UBWCLosslessEnabledOnDSPtr(Id id) const
     {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCLosslessEnabledOnDSOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline bool* UBWCLosslessEnabledOnDSPtr(Id id)
-    {
-        return reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                       kUBWCLosslessEnabledOnDSOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const bool kDefault = bool();
+        if (!IsFieldSet(id, kUBWCLosslessEnabledOnDSIndex)) return &kDefault;
+        return &m_ubwc_lossless_enabled_on_ds_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `UBWCLosslessEnabledOnDS(id)` retuns the `UBWCLosslessEnabledOnDS` element of the object
     // identified by `id`
@@ -8308,7 +7334,7 @@ class EventStateInfoT
     inline SOA& SetUBWCLosslessEnabledOnDS(Id id, bool value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *UBWCLosslessEnabledOnDSPtr(id) = value;
+        m_ubwc_lossless_enabled_on_ds_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kUBWCLosslessEnabledOnDSIndex);
         return static_cast<SOA&>(*this);
     }
@@ -8330,33 +7356,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD ResolveScissor: Defines the rectangular bounds of the resolve operation
 
-    // `ResolveScissorPtr()` returns a shared pointer to an array of `size()` elements
-    inline const VkRect2D* ResolveScissorPtr() const
-    {
-        return reinterpret_cast<VkRect2D*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kResolveScissorOffset * m_cap);
-    }
-    inline VkRect2D* ResolveScissorPtr()
-    {
-        return reinterpret_cast<VkRect2D*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kResolveScissorOffset * m_cap);
-    }
-    // `ResolveScissorPtr()` returns a shared pointer to an array of `size()` elements
+    // `ResolveScissorPtr(id)` returns a pointer to the `ResolveScissor` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const VkRect2D* ResolveScissorPtr(Id id) const
     {
-        return reinterpret_cast<VkRect2D*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kResolveScissorOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline VkRect2D* ResolveScissorPtr(Id id)
-    {
-        return reinterpret_cast<VkRect2D*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kResolveScissorOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const VkRect2D kDefault = VkRect2D();
+        if (!IsFieldSet(id, kResolveScissorIndex)) return &kDefault;
+        return &m_resolve_scissor_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `ResolveScissor(id)` retuns the `ResolveScissor` element of the object identified by `id`
     inline VkRect2D ResolveScissor(Id id) const
@@ -8370,7 +7377,7 @@ class EventStateInfoT
     inline SOA& SetResolveScissor(Id id, VkRect2D value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *ResolveScissorPtr(id) = value;
+        m_resolve_scissor_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kResolveScissorIndex);
         return static_cast<SOA&>(*this);
     }
@@ -8391,33 +7398,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD ResolveBaseGmem: The base offset in Gmem for the resolve operation
 
-    // `ResolveBaseGmemPtr()` returns a shared pointer to an array of `size()` elements
-    inline const uint32_t* ResolveBaseGmemPtr() const
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kResolveBaseGmemOffset * m_cap);
-    }
-    inline uint32_t* ResolveBaseGmemPtr()
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kResolveBaseGmemOffset * m_cap);
-    }
-    // `ResolveBaseGmemPtr()` returns a shared pointer to an array of `size()` elements
+    // `ResolveBaseGmemPtr(id)` returns a pointer to the `ResolveBaseGmem` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const uint32_t* ResolveBaseGmemPtr(Id id) const
     {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kResolveBaseGmemOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline uint32_t* ResolveBaseGmemPtr(Id id)
-    {
-        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kResolveBaseGmemOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const uint32_t kDefault = uint32_t();
+        if (!IsFieldSet(id, kResolveBaseGmemIndex)) return &kDefault;
+        return &m_resolve_base_gmem_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `ResolveBaseGmem(id)` retuns the `ResolveBaseGmem` element of the object identified by `id`
     inline uint32_t ResolveBaseGmem(Id id) const
@@ -8431,7 +7419,7 @@ class EventStateInfoT
     inline SOA& SetResolveBaseGmem(Id id, uint32_t value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *ResolveBaseGmemPtr(id) = value;
+        m_resolve_base_gmem_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kResolveBaseGmemIndex);
         return static_cast<SOA&>(*this);
     }
@@ -8452,33 +7440,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD ResolveBaseSysmem: The base address in system memory for the resolve operation
 
-    // `ResolveBaseSysmemPtr()` returns a shared pointer to an array of `size()` elements
-    inline const uint64_t* ResolveBaseSysmemPtr() const
-    {
-        return reinterpret_cast<uint64_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kResolveBaseSysmemOffset * m_cap);
-    }
-    inline uint64_t* ResolveBaseSysmemPtr()
-    {
-        return reinterpret_cast<uint64_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kResolveBaseSysmemOffset * m_cap);
-    }
-    // `ResolveBaseSysmemPtr()` returns a shared pointer to an array of `size()` elements
+    // `ResolveBaseSysmemPtr(id)` returns a pointer to the `ResolveBaseSysmem` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const uint64_t* ResolveBaseSysmemPtr(Id id) const
     {
-        return reinterpret_cast<uint64_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kResolveBaseSysmemOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline uint64_t* ResolveBaseSysmemPtr(Id id)
-    {
-        return reinterpret_cast<uint64_t*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                           kResolveBaseSysmemOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const uint64_t kDefault = uint64_t();
+        if (!IsFieldSet(id, kResolveBaseSysmemIndex)) return &kDefault;
+        return &m_resolve_base_sysmem_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `ResolveBaseSysmem(id)` retuns the `ResolveBaseSysmem` element of the object identified by
     // `id`
@@ -8493,7 +7462,7 @@ class EventStateInfoT
     inline SOA& SetResolveBaseSysmem(Id id, uint64_t value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *ResolveBaseSysmemPtr(id) = value;
+        m_resolve_base_sysmem_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kResolveBaseSysmemIndex);
         return static_cast<SOA&>(*this);
     }
@@ -8514,33 +7483,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD ResolveFormat: The format of the buffer being resolved
 
-    // `ResolveFormatPtr()` returns a shared pointer to an array of `size()` elements
-    inline const a6xx_format* ResolveFormatPtr() const
-    {
-        return reinterpret_cast<a6xx_format*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                              kResolveFormatOffset * m_cap);
-    }
-    inline a6xx_format* ResolveFormatPtr()
-    {
-        return reinterpret_cast<a6xx_format*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                              kResolveFormatOffset * m_cap);
-    }
-    // `ResolveFormatPtr()` returns a shared pointer to an array of `size()` elements
+    // `ResolveFormatPtr(id)` returns a pointer to the `ResolveFormat` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const a6xx_format* ResolveFormatPtr(Id id) const
     {
-        return reinterpret_cast<a6xx_format*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                              kResolveFormatOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline a6xx_format* ResolveFormatPtr(Id id)
-    {
-        return reinterpret_cast<a6xx_format*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                              kResolveFormatOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const a6xx_format kDefault = a6xx_format();
+        if (!IsFieldSet(id, kResolveFormatIndex)) return &kDefault;
+        return &m_resolve_format_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `ResolveFormat(id)` retuns the `ResolveFormat` element of the object identified by `id`
     inline a6xx_format ResolveFormat(Id id) const
@@ -8554,7 +7504,7 @@ class EventStateInfoT
     inline SOA& SetResolveFormat(Id id, a6xx_format value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *ResolveFormatPtr(id) = value;
+        m_resolve_format_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kResolveFormatIndex);
         return static_cast<SOA&>(*this);
     }
@@ -8575,33 +7525,14 @@ class EventStateInfoT
     //-----------------------------------------------
     // FIELD ResolveTileMode: The tile mode of the buffer being resolved
 
-    // `ResolveTileModePtr()` returns a shared pointer to an array of `size()` elements
-    inline const a6xx_tile_mode* ResolveTileModePtr() const
-    {
-        return reinterpret_cast<a6xx_tile_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                 kResolveTileModeOffset * m_cap);
-    }
-    inline a6xx_tile_mode* ResolveTileModePtr()
-    {
-        return reinterpret_cast<a6xx_tile_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                 kResolveTileModeOffset * m_cap);
-    }
-    // `ResolveTileModePtr()` returns a shared pointer to an array of `size()` elements
+    // `ResolveTileModePtr(id)` returns a pointer to the `ResolveTileMode` element of the object
+    // identified by `id`, which is only valid until the field is set again
     inline const a6xx_tile_mode* ResolveTileModePtr(Id id) const
     {
-        return reinterpret_cast<a6xx_tile_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                 kResolveTileModeOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
-    }
-    inline a6xx_tile_mode* ResolveTileModePtr(Id id)
-    {
-        return reinterpret_cast<a6xx_tile_mode*>(reinterpret_cast<uint8_t*>(m_buffer.get()) +
-                                                 kResolveTileModeOffset * m_cap) +
-               static_cast<typename Id::basic_type>(id)
-
-            ;
+        // The runs hold the value of a previous element where the field is not set
+        static const a6xx_tile_mode kDefault = a6xx_tile_mode();
+        if (!IsFieldSet(id, kResolveTileModeIndex)) return &kDefault;
+        return &m_resolve_tile_mode_runs.Get(static_cast<typename Id::basic_type>(id));
     }
     // `ResolveTileMode(id)` retuns the `ResolveTileMode` element of the object identified by `id`
     inline a6xx_tile_mode ResolveTileMode(Id id) const
@@ -8615,7 +7546,7 @@ class EventStateInfoT
     inline SOA& SetResolveTileMode(Id id, a6xx_tile_mode value)
     {
         DIVE_ASSERT(IsValidId(id));
-        *ResolveTileModePtr(id) = value;
+        m_resolve_tile_mode_runs.Set(static_cast<typename Id::basic_type>(id), value);
         MarkFieldSet(id, kResolveTileModeIndex);
         return static_cast<SOA&>(*this);
     }
@@ -8663,15 +7594,151 @@ class EventStateInfoT
     }
 
     // `Reserve` ensures enough room for *at least* `new_cap` elements
-    // (inluding existing elements). This will re-allocate memory if necessary.
+    // (inluding existing elements). This will allocate chunks if necessary.
     void Reserve(typename Id::basic_type new_cap);
 
     // `Add` adds a single element and returns an iterator referring to the new
-    // element. This will re-allocate memory if necessary
+    // element. This will allocate a chunk if necessary, but never moves the existing elements
     Iterator Add();
 
-    // `Clear` resets size to 0, but keeps the allocated memory.
-    inline void Clear() { m_size = 0; }
+    // `Clear` resets size to 0, but keeps the allocated chunks.
+    inline void Clear()
+    {
+        m_size = 0;
+        m_topology_runs.Clear();
+        m_prim_restart_enabled_runs.Clear();
+        m_patch_control_points_runs.Clear();
+        m_viewport_runs.Clear();
+        m_scissor_runs.Clear();
+        m_depth_clamp_enabled_runs.Clear();
+        m_rasterizer_discard_enabled_runs.Clear();
+        m_polygon_mode_runs.Clear();
+        m_cull_mode_runs.Clear();
+        m_front_face_runs.Clear();
+        m_depth_bias_enabled_runs.Clear();
+        m_depth_bias_constant_factor_runs.Clear();
+        m_depth_bias_clamp_runs.Clear();
+        m_depth_bias_slope_factor_runs.Clear();
+        m_line_width_runs.Clear();
+        m_rasterization_samples_runs.Clear();
+        m_sample_shading_enabled_runs.Clear();
+        m_min_sample_shading_runs.Clear();
+        m_sample_mask_runs.Clear();
+        m_alpha_to_coverage_enabled_runs.Clear();
+        m_depth_test_enabled_runs.Clear();
+        m_depth_write_enabled_runs.Clear();
+        m_depth_compare_op_runs.Clear();
+        m_depth_bounds_test_enabled_runs.Clear();
+        m_min_depth_bounds_runs.Clear();
+        m_max_depth_bounds_runs.Clear();
+        m_stencil_test_enabled_runs.Clear();
+        m_stencil_op_state_front_runs.Clear();
+        m_stencil_op_state_back_runs.Clear();
+        m_logic_op_enabled_runs.Clear();
+        m_logic_op_runs.Clear();
+        m_attachment_runs.Clear();
+        m_blend_constant_runs.Clear();
+        m_lrz_enabled_runs.Clear();
+        m_lrz_write_runs.Clear();
+        m_lrz_dir_status_runs.Clear();
+        m_lrz_dir_write_runs.Clear();
+        m_z_test_mode_runs.Clear();
+        m_bin_w_runs.Clear();
+        m_bin_h_runs.Clear();
+        m_window_scissor_tlx_runs.Clear();
+        m_window_scissor_tly_runs.Clear();
+        m_window_scissor_brx_runs.Clear();
+        m_window_scissor_bry_runs.Clear();
+        m_render_mode_runs.Clear();
+        m_buffers_location_runs.Clear();
+        m_thread_size_runs.Clear();
+        m_enable_all_helper_lanes_runs.Clear();
+        m_enable_partial_helper_lanes_runs.Clear();
+        m_ubwc_enabled_runs.Clear();
+        m_ubwc_lossless_enabled_runs.Clear();
+        m_ubwc_enabled_on_ds_runs.Clear();
+        m_ubwc_lossless_enabled_on_ds_runs.Clear();
+        m_resolve_scissor_runs.Clear();
+        m_resolve_base_gmem_runs.Clear();
+        m_resolve_base_sysmem_runs.Clear();
+        m_resolve_format_runs.Clear();
+        m_resolve_tile_mode_runs.Clear();
+    }
+
+    // `WriteRawData` passes the memory of all elements to `write(data, size)`, a block at a time,
+    // e.g. to save them to a file. The layout depends on the field types, so the data can only be
+    // restored with `SetRawData` by the same build of this class.
+    template <typename WriteFn>
+    void WriteRawData(WriteFn&& write) const
+    {
+        for (size_t i = 0; i < NumUsedChunks(m_size); ++i) write(m_chunks[i].get(), kChunkBytes);
+        m_topology_runs.WriteRawData(write);
+        m_prim_restart_enabled_runs.WriteRawData(write);
+        m_patch_control_points_runs.WriteRawData(write);
+        m_viewport_runs.WriteRawData(write);
+        m_scissor_runs.WriteRawData(write);
+        m_depth_clamp_enabled_runs.WriteRawData(write);
+        m_rasterizer_discard_enabled_runs.WriteRawData(write);
+        m_polygon_mode_runs.WriteRawData(write);
+        m_cull_mode_runs.WriteRawData(write);
+        m_front_face_runs.WriteRawData(write);
+        m_depth_bias_enabled_runs.WriteRawData(write);
+        m_depth_bias_constant_factor_runs.WriteRawData(write);
+        m_depth_bias_clamp_runs.WriteRawData(write);
+        m_depth_bias_slope_factor_runs.WriteRawData(write);
+        m_line_width_runs.WriteRawData(write);
+        m_rasterization_samples_runs.WriteRawData(write);
+        m_sample_shading_enabled_runs.WriteRawData(write);
+        m_min_sample_shading_runs.WriteRawData(write);
+        m_sample_mask_runs.WriteRawData(write);
+        m_alpha_to_coverage_enabled_runs.WriteRawData(write);
+        m_depth_test_enabled_runs.WriteRawData(write);
+        m_depth_write_enabled_runs.WriteRawData(write);
+        m_depth_compare_op_runs.WriteRawData(write);
+        m_depth_bounds_test_enabled_runs.WriteRawData(write);
+        m_min_depth_bounds_runs.WriteRawData(write);
+        m_max_depth_bounds_runs.WriteRawData(write);
+        m_stencil_test_enabled_runs.WriteRawData(write);
+        m_stencil_op_state_front_runs.WriteRawData(write);
+        m_stencil_op_state_back_runs.WriteRawData(write);
+        m_logic_op_enabled_runs.WriteRawData(write);
+        m_logic_op_runs.WriteRawData(write);
+        m_attachment_runs.WriteRawData(write);
+        m_blend_constant_runs.WriteRawData(write);
+        m_lrz_enabled_runs.WriteRawData(write);
+        m_lrz_write_runs.WriteRawData(write);
+        m_lrz_dir_status_runs.WriteRawData(write);
+        m_lrz_dir_write_runs.WriteRawData(write);
+        m_z_test_mode_runs.WriteRawData(write);
+        m_bin_w_runs.WriteRawData(write);
+        m_bin_h_runs.WriteRawData(write);
+        m_window_scissor_tlx_runs.WriteRawData(write);
+        m_window_scissor_tly_runs.WriteRawData(write);
+        m_window_scissor_brx_runs.WriteRawData(write);
+        m_window_scissor_bry_runs.WriteRawData(write);
+        m_render_mode_runs.WriteRawData(write);
+        m_buffers_location_runs.WriteRawData(write);
+        m_thread_size_runs.WriteRawData(write);
+        m_enable_all_helper_lanes_runs.WriteRawData(write);
+        m_enable_partial_helper_lanes_runs.WriteRawData(write);
+        m_ubwc_enabled_runs.WriteRawData(write);
+        m_ubwc_lossless_enabled_runs.WriteRawData(write);
+        m_ubwc_enabled_on_ds_runs.WriteRawData(write);
+        m_ubwc_lossless_enabled_on_ds_runs.WriteRawData(write);
+        m_resolve_scissor_runs.WriteRawData(write);
+        m_resolve_base_gmem_runs.WriteRawData(write);
+        m_resolve_base_sysmem_runs.WriteRawData(write);
+        m_resolve_format_runs.WriteRawData(write);
+        m_resolve_tile_mode_runs.WriteRawData(write);
+    }
+
+    // `RawDataSize` returns the number of bytes passed to `write` by `WriteRawData`
+    size_t RawDataSize() const;
+
+    // `SetRawData` replaces all elements with `size` elements previously obtained from
+    // `WriteRawData`. Returns false, and leaves the elements untouched, if the data is not valid
+    // for `size` elements.
+    bool SetRawData(typename Id::basic_type size, const void* data, size_t data_size);
 
  protected:
     template <typename CONFIG_>
@@ -8682,542 +7749,375 @@ class EventStateInfoT
     // The start of the array for each field will be aligned to `kAlignment`
     static constexpr size_t kAlignment = alignof(std::max_align_t);
 
+    // Number of elements in each chunk. A multiple of `kAlignment`, so that the arrays of the
+    // fields stay aligned, and of 8, so that the is-set bits of each chunk are whole bytes
+    static constexpr size_t kChunkSize = 1024;
+    static_assert(kChunkSize % kAlignment == 0 && kChunkSize % 8 == 0,
+                  "Chunk size must be a multiple of kAlignment and 8");
+
 #define PARTIAL_SIZE_EventStateInfo 0u
 #define PARTIAL_INDEX_EventStateInfo 0u
     static_assert(alignof(uint32_t) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kTopologyIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kTopologyOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kTopologySize = sizeof(uint32_t);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kTopologyOffset + kTopologySize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kTopologyIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kPrimRestartEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kPrimRestartEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kPrimRestartEnabledSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kPrimRestartEnabledOffset + kPrimRestartEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kPrimRestartEnabledIndex + 1
     static_assert(alignof(uint32_t) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kPatchControlPointsIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kPatchControlPointsOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kPatchControlPointsSize = sizeof(uint32_t);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kPatchControlPointsOffset + kPatchControlPointsSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kPatchControlPointsIndex + 1
     static_assert(alignof(VkViewport) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kViewportIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kViewportOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kViewportArrayCount = 16;
     static constexpr size_t kViewportSize = sizeof(VkViewport) * kViewportArrayCount;
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kViewportOffset + kViewportSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kViewportIndex + kViewportArrayCount
     static_assert(alignof(VkRect2D) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kScissorIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kScissorOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kScissorArrayCount = 16;
     static constexpr size_t kScissorSize = sizeof(VkRect2D) * kScissorArrayCount;
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kScissorOffset + kScissorSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kScissorIndex + kScissorArrayCount
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kDepthClampEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kDepthClampEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kDepthClampEnabledSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kDepthClampEnabledOffset + kDepthClampEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kDepthClampEnabledIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kRasterizerDiscardEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kRasterizerDiscardEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kRasterizerDiscardEnabledSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kRasterizerDiscardEnabledOffset + kRasterizerDiscardEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kRasterizerDiscardEnabledIndex + 1
     static_assert(alignof(VkPolygonMode) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kPolygonModeIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kPolygonModeOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kPolygonModeSize = sizeof(VkPolygonMode);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kPolygonModeOffset + kPolygonModeSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kPolygonModeIndex + 1
     static_assert(alignof(VkCullModeFlags) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kCullModeIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kCullModeOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kCullModeSize = sizeof(VkCullModeFlags);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kCullModeOffset + kCullModeSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kCullModeIndex + 1
     static_assert(alignof(VkFrontFace) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kFrontFaceIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kFrontFaceOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kFrontFaceSize = sizeof(VkFrontFace);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kFrontFaceOffset + kFrontFaceSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kFrontFaceIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kDepthBiasEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kDepthBiasEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kDepthBiasEnabledSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kDepthBiasEnabledOffset + kDepthBiasEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kDepthBiasEnabledIndex + 1
     static_assert(alignof(float) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kDepthBiasConstantFactorIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kDepthBiasConstantFactorOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kDepthBiasConstantFactorSize = sizeof(float);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kDepthBiasConstantFactorOffset + kDepthBiasConstantFactorSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kDepthBiasConstantFactorIndex + 1
     static_assert(alignof(float) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kDepthBiasClampIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kDepthBiasClampOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kDepthBiasClampSize = sizeof(float);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kDepthBiasClampOffset + kDepthBiasClampSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kDepthBiasClampIndex + 1
     static_assert(alignof(float) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kDepthBiasSlopeFactorIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kDepthBiasSlopeFactorOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kDepthBiasSlopeFactorSize = sizeof(float);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kDepthBiasSlopeFactorOffset + kDepthBiasSlopeFactorSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kDepthBiasSlopeFactorIndex + 1
     static_assert(alignof(float) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kLineWidthIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kLineWidthOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kLineWidthSize = sizeof(float);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kLineWidthOffset + kLineWidthSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kLineWidthIndex + 1
     static_assert(alignof(VkSampleCountFlagBits) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kRasterizationSamplesIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kRasterizationSamplesOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kRasterizationSamplesSize = sizeof(VkSampleCountFlagBits);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kRasterizationSamplesOffset + kRasterizationSamplesSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kRasterizationSamplesIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kSampleShadingEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kSampleShadingEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kSampleShadingEnabledSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kSampleShadingEnabledOffset + kSampleShadingEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kSampleShadingEnabledIndex + 1
     static_assert(alignof(float) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kMinSampleShadingIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kMinSampleShadingOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kMinSampleShadingSize = sizeof(float);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kMinSampleShadingOffset + kMinSampleShadingSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kMinSampleShadingIndex + 1
     static_assert(alignof(VkSampleMask) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kSampleMaskIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kSampleMaskOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kSampleMaskSize = sizeof(VkSampleMask);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kSampleMaskOffset + kSampleMaskSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kSampleMaskIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kAlphaToCoverageEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kAlphaToCoverageEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kAlphaToCoverageEnabledSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kAlphaToCoverageEnabledOffset + kAlphaToCoverageEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kAlphaToCoverageEnabledIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kDepthTestEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kDepthTestEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kDepthTestEnabledSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kDepthTestEnabledOffset + kDepthTestEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kDepthTestEnabledIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kDepthWriteEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kDepthWriteEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kDepthWriteEnabledSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kDepthWriteEnabledOffset + kDepthWriteEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kDepthWriteEnabledIndex + 1
     static_assert(alignof(VkCompareOp) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kDepthCompareOpIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kDepthCompareOpOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kDepthCompareOpSize = sizeof(VkCompareOp);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kDepthCompareOpOffset + kDepthCompareOpSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kDepthCompareOpIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kDepthBoundsTestEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kDepthBoundsTestEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kDepthBoundsTestEnabledSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kDepthBoundsTestEnabledOffset + kDepthBoundsTestEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kDepthBoundsTestEnabledIndex + 1
     static_assert(alignof(float) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kMinDepthBoundsIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kMinDepthBoundsOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kMinDepthBoundsSize = sizeof(float);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kMinDepthBoundsOffset + kMinDepthBoundsSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kMinDepthBoundsIndex + 1
     static_assert(alignof(float) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kMaxDepthBoundsIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kMaxDepthBoundsOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kMaxDepthBoundsSize = sizeof(float);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kMaxDepthBoundsOffset + kMaxDepthBoundsSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kMaxDepthBoundsIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kStencilTestEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kStencilTestEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kStencilTestEnabledSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kStencilTestEnabledOffset + kStencilTestEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kStencilTestEnabledIndex + 1
     static_assert(alignof(VkStencilOpState) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kStencilOpStateFrontIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kStencilOpStateFrontOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kStencilOpStateFrontSize = sizeof(VkStencilOpState);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kStencilOpStateFrontOffset + kStencilOpStateFrontSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kStencilOpStateFrontIndex + 1
     static_assert(alignof(VkStencilOpState) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kStencilOpStateBackIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kStencilOpStateBackOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kStencilOpStateBackSize = sizeof(VkStencilOpState);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kStencilOpStateBackOffset + kStencilOpStateBackSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kStencilOpStateBackIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kLogicOpEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kLogicOpEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kLogicOpEnabledArrayCount = 8;
     static constexpr size_t kLogicOpEnabledSize = sizeof(bool) * kLogicOpEnabledArrayCount;
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kLogicOpEnabledOffset + kLogicOpEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kLogicOpEnabledIndex + kLogicOpEnabledArrayCount
     static_assert(alignof(VkLogicOp) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kLogicOpIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kLogicOpOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kLogicOpArrayCount = 8;
     static constexpr size_t kLogicOpSize = sizeof(VkLogicOp) * kLogicOpArrayCount;
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kLogicOpOffset + kLogicOpSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kLogicOpIndex + kLogicOpArrayCount
     static_assert(alignof(VkPipelineColorBlendAttachmentState) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kAttachmentIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kAttachmentOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kAttachmentArrayCount = 8;
     static constexpr size_t kAttachmentSize =
         sizeof(VkPipelineColorBlendAttachmentState) * kAttachmentArrayCount;
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kAttachmentOffset + kAttachmentSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kAttachmentIndex + kAttachmentArrayCount
     static_assert(alignof(float) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kBlendConstantIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kBlendConstantOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kBlendConstantArrayCount = 4;
     static constexpr size_t kBlendConstantSize = sizeof(float) * kBlendConstantArrayCount;
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kBlendConstantOffset + kBlendConstantSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kBlendConstantIndex + kBlendConstantArrayCount
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kLRZEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kLRZEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kLRZEnabledSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kLRZEnabledOffset + kLRZEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kLRZEnabledIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kLRZWriteIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kLRZWriteOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kLRZWriteSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kLRZWriteOffset + kLRZWriteSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kLRZWriteIndex + 1
     static_assert(alignof(a6xx_lrz_dir_status) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kLRZDirStatusIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kLRZDirStatusOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kLRZDirStatusSize = sizeof(a6xx_lrz_dir_status);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kLRZDirStatusOffset + kLRZDirStatusSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kLRZDirStatusIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kLRZDirWriteIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kLRZDirWriteOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kLRZDirWriteSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kLRZDirWriteOffset + kLRZDirWriteSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kLRZDirWriteIndex + 1
     static_assert(alignof(a6xx_ztest_mode) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kZTestModeIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kZTestModeOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kZTestModeSize = sizeof(a6xx_ztest_mode);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kZTestModeOffset + kZTestModeSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kZTestModeIndex + 1
     static_assert(alignof(uint32_t) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kBinWIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kBinWOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kBinWSize = sizeof(uint32_t);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kBinWOffset + kBinWSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kBinWIndex + 1
     static_assert(alignof(uint32_t) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kBinHIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kBinHOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kBinHSize = sizeof(uint32_t);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kBinHOffset + kBinHSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kBinHIndex + 1
     static_assert(alignof(uint16_t) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kWindowScissorTLXIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kWindowScissorTLXOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kWindowScissorTLXSize = sizeof(uint16_t);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kWindowScissorTLXOffset + kWindowScissorTLXSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kWindowScissorTLXIndex + 1
     static_assert(alignof(uint16_t) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kWindowScissorTLYIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kWindowScissorTLYOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kWindowScissorTLYSize = sizeof(uint16_t);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kWindowScissorTLYOffset + kWindowScissorTLYSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kWindowScissorTLYIndex + 1
     static_assert(alignof(uint16_t) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kWindowScissorBRXIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kWindowScissorBRXOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kWindowScissorBRXSize = sizeof(uint16_t);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kWindowScissorBRXOffset + kWindowScissorBRXSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kWindowScissorBRXIndex + 1
     static_assert(alignof(uint16_t) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kWindowScissorBRYIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kWindowScissorBRYOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kWindowScissorBRYSize = sizeof(uint16_t);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kWindowScissorBRYOffset + kWindowScissorBRYSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kWindowScissorBRYIndex + 1
     static_assert(alignof(a6xx_render_mode) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kRenderModeIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kRenderModeOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kRenderModeSize = sizeof(a6xx_render_mode);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kRenderModeOffset + kRenderModeSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kRenderModeIndex + 1
     static_assert(alignof(a6xx_buffers_location) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kBuffersLocationIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kBuffersLocationOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kBuffersLocationSize = sizeof(a6xx_buffers_location);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kBuffersLocationOffset + kBuffersLocationSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kBuffersLocationIndex + 1
     static_assert(alignof(a6xx_threadsize) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kThreadSizeIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kThreadSizeOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kThreadSizeSize = sizeof(a6xx_threadsize);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kThreadSizeOffset + kThreadSizeSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kThreadSizeIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kEnableAllHelperLanesIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kEnableAllHelperLanesOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kEnableAllHelperLanesSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kEnableAllHelperLanesOffset + kEnableAllHelperLanesSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kEnableAllHelperLanesIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kEnablePartialHelperLanesIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kEnablePartialHelperLanesOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kEnablePartialHelperLanesSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kEnablePartialHelperLanesOffset + kEnablePartialHelperLanesSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kEnablePartialHelperLanesIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kUBWCEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kUBWCEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kUBWCEnabledArrayCount = 8;
     static constexpr size_t kUBWCEnabledSize = sizeof(bool) * kUBWCEnabledArrayCount;
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kUBWCEnabledOffset + kUBWCEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kUBWCEnabledIndex + kUBWCEnabledArrayCount
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kUBWCLosslessEnabledIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kUBWCLosslessEnabledOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kUBWCLosslessEnabledArrayCount = 8;
     static constexpr size_t kUBWCLosslessEnabledSize =
         sizeof(bool) * kUBWCLosslessEnabledArrayCount;
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kUBWCLosslessEnabledOffset + kUBWCLosslessEnabledSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kUBWCLosslessEnabledIndex + kUBWCLosslessEnabledArrayCount
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kUBWCEnabledOnDSIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kUBWCEnabledOnDSOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kUBWCEnabledOnDSSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kUBWCEnabledOnDSOffset + kUBWCEnabledOnDSSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kUBWCEnabledOnDSIndex + 1
     static_assert(alignof(bool) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kUBWCLosslessEnabledOnDSIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kUBWCLosslessEnabledOnDSOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kUBWCLosslessEnabledOnDSSize = sizeof(bool);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kUBWCLosslessEnabledOnDSOffset + kUBWCLosslessEnabledOnDSSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kUBWCLosslessEnabledOnDSIndex + 1
     static_assert(alignof(VkRect2D) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kResolveScissorIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kResolveScissorOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kResolveScissorSize = sizeof(VkRect2D);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kResolveScissorOffset + kResolveScissorSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kResolveScissorIndex + 1
     static_assert(alignof(uint32_t) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kResolveBaseGmemIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kResolveBaseGmemOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kResolveBaseGmemSize = sizeof(uint32_t);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kResolveBaseGmemOffset + kResolveBaseGmemSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kResolveBaseGmemIndex + 1
     static_assert(alignof(uint64_t) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kResolveBaseSysmemIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kResolveBaseSysmemOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kResolveBaseSysmemSize = sizeof(uint64_t);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kResolveBaseSysmemOffset + kResolveBaseSysmemSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kResolveBaseSysmemIndex + 1
     static_assert(alignof(a6xx_format) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kResolveFormatIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kResolveFormatOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kResolveFormatSize = sizeof(a6xx_format);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kResolveFormatOffset + kResolveFormatSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kResolveFormatIndex + 1
     static_assert(alignof(a6xx_tile_mode) <= kAlignment,
                   "Field type aligment requirement cannot exceed kAlignment");
     static constexpr uint32_t kResolveTileModeIndex = PARTIAL_INDEX_EventStateInfo;
-    static constexpr size_t kResolveTileModeOffset = PARTIAL_SIZE_EventStateInfo;
     static constexpr size_t kResolveTileModeSize = sizeof(a6xx_tile_mode);
-#undef PARTIAL_SIZE_EventStateInfo
-#define PARTIAL_SIZE_EventStateInfo kResolveTileModeOffset + kResolveTileModeSize
 #undef PARTIAL_INDEX_EventStateInfo
 #define PARTIAL_INDEX_EventStateInfo kResolveTileModeIndex + 1
 
-    // Number of bytes required to store each element
+    // Number of bytes required to store each element in a chunk, which excludes the run-length
+    // encoded fields
     static constexpr size_t kElemSize = PARTIAL_SIZE_EventStateInfo;
 #undef PARTIAL_SIZE_EventStateInfo
 
@@ -9225,94 +8125,342 @@ class EventStateInfoT
     static constexpr size_t kNumFields = PARTIAL_INDEX_EventStateInfo;
 #undef PARTIAL_INDEX_EventStateInfo
 
+    // The is-set bits of the elements of a chunk follow the arrays of the fields
+    static constexpr size_t kIsSetOffset = kElemSize * kChunkSize;
+    static constexpr size_t kChunkBytes = kIsSetOffset + (kChunkSize * kNumFields) / 8;
+
+    // `ChunkPtr(id)` returns the memory of the chunk holding the element identified by `id`
+    inline uint8_t* ChunkPtr(Id id) const
+    {
+        return reinterpret_cast<uint8_t*>(
+            m_chunks[static_cast<typename Id::basic_type>(id) / kChunkSize].get());
+    }
+
+    // `NumUsedChunks(size)` returns the number of chunks holding `size` elements
+    static inline size_t NumUsedChunks(size_t size) { return (size + kChunkSize - 1) / kChunkSize; }
+
+    // `NewChunk()` allocates a chunk, with all of its fields and is-set bits set to 0
+    static std::unique_ptr<std::max_align_t[]> NewChunk();
+
     // Current number of elements
     typename Id::basic_type m_size = 0;
 
-    // Maximum number of elements before needing to re-allocate
-    typename Id::basic_type m_cap = 0;
-
-    // Pointer to the memory storing all of the fields.
-    // Stored as a `unique_ptr<max_align_t[]>` because:
-    //   - Allocating a `max_align_t` array ensures the buffer is sufficiently
-    //     aligned for any field type.
-    //   - Using `max_align_t[]` instead of `max_align_t` tells `unique_ptr`
-    //     to deallocate using `operator delete []` instead of
-    //     `operator delete`, which is required because the memory is allocated
-    //     with `operator new []`.
-    std::unique_ptr<std::max_align_t[]> m_buffer;
-
-    // Pointer to a bit-array, where each field is marked with a 1 if set, and 0
-    // if not set. Unlike m_buffer, this bit-array is in a AOS rather than SOA
-    // memory layout. This makes the management of this small buffer simpler.
-    std::vector<uint8_t> m_is_set_buffer;
-
-    // The following fields point to each of the arrays. These are not used,
-    // but are helpful for debugging, saving you from needing to manually
-    // calculate array offsets in `m_buffer`.
-    //
-    // NOTE: If you are debugging in Visual Studio, you can add the generated
-    // ".natvis" file into the Visual Studio project to get an even nicer
-    // debug view.
-#ifndef NDEBUG
-    uint32_t* DBG_topology;
-    bool* DBG_prim_restart_enabled;
-    uint32_t* DBG_patch_control_points;
-    VkViewport* DBG_viewport;
-    VkRect2D* DBG_scissor;
-    bool* DBG_depth_clamp_enabled;
-    bool* DBG_rasterizer_discard_enabled;
-    VkPolygonMode* DBG_polygon_mode;
-    VkCullModeFlags* DBG_cull_mode;
-    VkFrontFace* DBG_front_face;
-    bool* DBG_depth_bias_enabled;
-    float* DBG_depth_bias_constant_factor;
-    float* DBG_depth_bias_clamp;
-    float* DBG_depth_bias_slope_factor;
-    float* DBG_line_width;
-    VkSampleCountFlagBits* DBG_rasterization_samples;
-    bool* DBG_sample_shading_enabled;
-    float* DBG_min_sample_shading;
-    VkSampleMask* DBG_sample_mask;
-    bool* DBG_alpha_to_coverage_enabled;
-    bool* DBG_depth_test_enabled;
-    bool* DBG_depth_write_enabled;
-    VkCompareOp* DBG_depth_compare_op;
-    bool* DBG_depth_bounds_test_enabled;
-    float* DBG_min_depth_bounds;
-    float* DBG_max_depth_bounds;
-    bool* DBG_stencil_test_enabled;
-    VkStencilOpState* DBG_stencil_op_state_front;
-    VkStencilOpState* DBG_stencil_op_state_back;
-    bool* DBG_logic_op_enabled;
-    VkLogicOp* DBG_logic_op;
-    VkPipelineColorBlendAttachmentState* DBG_attachment;
-    float* DBG_blend_constant;
-    bool* DBG_lrz_enabled;
-    bool* DBG_lrz_write;
-    a6xx_lrz_dir_status* DBG_lrz_dir_status;
-    bool* DBG_lrz_dir_write;
-    a6xx_ztest_mode* DBG_z_test_mode;
-    uint32_t* DBG_bin_w;
-    uint32_t* DBG_bin_h;
-    uint16_t* DBG_window_scissor_tlx;
-    uint16_t* DBG_window_scissor_tly;
-    uint16_t* DBG_window_scissor_brx;
-    uint16_t* DBG_window_scissor_bry;
-    a6xx_render_mode* DBG_render_mode;
-    a6xx_buffers_location* DBG_buffers_location;
-    a6xx_threadsize* DBG_thread_size;
-    bool* DBG_enable_all_helper_lanes;
-    bool* DBG_enable_partial_helper_lanes;
-    bool* DBG_ubwc_enabled;
-    bool* DBG_ubwc_lossless_enabled;
-    bool* DBG_ubwc_enabled_on_ds;
-    bool* DBG_ubwc_lossless_enabled_on_ds;
-    VkRect2D* DBG_resolve_scissor;
-    uint32_t* DBG_resolve_base_gmem;
-    uint64_t* DBG_resolve_base_sysmem;
-    a6xx_format* DBG_resolve_format;
-    a6xx_tile_mode* DBG_resolve_tile_mode;
-#endif
+    // Memory storing the fields, `kChunkSize` elements at a time. Each chunk holds the array of
+    // each field at `field_offset * kChunkSize`, followed by the is-set bits of its elements.
+    // Chunks are only ever added, so adding elements never moves the existing ones.
+    std::vector<std::unique_ptr<std::max_align_t[]>> m_chunks;
+
+    // `ViewportValues(id)` returns all the `Viewport` elements of the object identified by `id`
+    inline std::array<VkViewport, kViewportArrayCount> ViewportValues(Id id) const
+    {
+        std::array<VkViewport, kViewportArrayCount> values =
+            m_viewport_runs.Get(static_cast<typename Id::basic_type>(id));
+        for (uint32_t i = 0; i < kViewportArrayCount; ++i)
+        {
+            if (!IsFieldSet(id, kViewportIndex + i)) values[i] = VkViewport();
+        }
+        return values;
+    }
+
+    // `ScissorValues(id)` returns all the `Scissor` elements of the object identified by `id`
+    inline std::array<VkRect2D, kScissorArrayCount> ScissorValues(Id id) const
+    {
+        std::array<VkRect2D, kScissorArrayCount> values =
+            m_scissor_runs.Get(static_cast<typename Id::basic_type>(id));
+        for (uint32_t i = 0; i < kScissorArrayCount; ++i)
+        {
+            if (!IsFieldSet(id, kScissorIndex + i)) values[i] = VkRect2D();
+        }
+        return values;
+    }
+
+    // `LogicOpEnabledValues(id)` returns all the `LogicOpEnabled` elements of the object identified
+    // by `id`
+    inline std::array<bool, kLogicOpEnabledArrayCount> LogicOpEnabledValues(Id id) const
+    {
+        std::array<bool, kLogicOpEnabledArrayCount> values =
+            m_logic_op_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
+        for (uint32_t i = 0; i < kLogicOpEnabledArrayCount; ++i)
+        {
+            if (!IsFieldSet(id, kLogicOpEnabledIndex + i)) values[i] = bool();
+        }
+        return values;
+    }
+
+    // `LogicOpValues(id)` returns all the `LogicOp` elements of the object identified by `id`
+    inline std::array<VkLogicOp, kLogicOpArrayCount> LogicOpValues(Id id) const
+    {
+        std::array<VkLogicOp, kLogicOpArrayCount> values =
+            m_logic_op_runs.Get(static_cast<typename Id::basic_type>(id));
+        for (uint32_t i = 0; i < kLogicOpArrayCount; ++i)
+        {
+            if (!IsFieldSet(id, kLogicOpIndex + i)) values[i] = VkLogicOp();
+        }
+        return values;
+    }
+
+    // `AttachmentValues(id)` returns all the `Attachment` elements of the object identified by `id`
+    inline std::array<VkPipelineColorBlendAttachmentState, kAttachmentArrayCount> AttachmentValues(
+        Id id) const
+    {
+        std::array<VkPipelineColorBlendAttachmentState, kAttachmentArrayCount> values =
+            m_attachment_runs.Get(static_cast<typename Id::basic_type>(id));
+        for (uint32_t i = 0; i < kAttachmentArrayCount; ++i)
+        {
+            if (!IsFieldSet(id, kAttachmentIndex + i))
+                values[i] = VkPipelineColorBlendAttachmentState();
+        }
+        return values;
+    }
+
+    // `BlendConstantValues(id)` returns all the `BlendConstant` elements of the object identified
+    // by `id`
+    inline std::array<float, kBlendConstantArrayCount> BlendConstantValues(Id id) const
+    {
+        std::array<float, kBlendConstantArrayCount> values =
+            m_blend_constant_runs.Get(static_cast<typename Id::basic_type>(id));
+        for (uint32_t i = 0; i < kBlendConstantArrayCount; ++i)
+        {
+            if (!IsFieldSet(id, kBlendConstantIndex + i)) values[i] = float();
+        }
+        return values;
+    }
+
+    // `UBWCEnabledValues(id)` returns all the `UBWCEnabled` elements of the object identified by
+    // `id`
+    inline std::array<bool, kUBWCEnabledArrayCount> UBWCEnabledValues(Id id) const
+    {
+        std::array<bool, kUBWCEnabledArrayCount> values =
+            m_ubwc_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
+        for (uint32_t i = 0; i < kUBWCEnabledArrayCount; ++i)
+        {
+            if (!IsFieldSet(id, kUBWCEnabledIndex + i)) values[i] = bool();
+        }
+        return values;
+    }
+
+    // `UBWCLosslessEnabledValues(id)` returns all the `UBWCLosslessEnabled` elements of the object
+    // identified by `id`
+    inline std::array<bool, kUBWCLosslessEnabledArrayCount> UBWCLosslessEnabledValues(Id id) const
+    {
+        std::array<bool, kUBWCLosslessEnabledArrayCount> values =
+            m_ubwc_lossless_enabled_runs.Get(static_cast<typename Id::basic_type>(id));
+        for (uint32_t i = 0; i < kUBWCLosslessEnabledArrayCount; ++i)
+        {
+            if (!IsFieldSet(id, kUBWCLosslessEnabledIndex + i)) values[i] = bool();
+        }
+        return values;
+    }
+
+    // Values of the Topology field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, uint32_t> m_topology_runs;
+    // Values of the PrimRestartEnabled field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_prim_restart_enabled_runs;
+    // Values of the PatchControlPoints field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, uint32_t> m_patch_control_points_runs;
+    // Values of the Viewport field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, std::array<VkViewport, kViewportArrayCount>>
+        m_viewport_runs;
+    // Values of the Scissor field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, std::array<VkRect2D, kScissorArrayCount>>
+        m_scissor_runs;
+    // Values of the DepthClampEnabled field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_depth_clamp_enabled_runs;
+    // Values of the RasterizerDiscardEnabled field, as runs of equal values. The elements where the
+    // field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_rasterizer_discard_enabled_runs;
+    // Values of the PolygonMode field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, VkPolygonMode> m_polygon_mode_runs;
+    // Values of the CullMode field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, VkCullModeFlags> m_cull_mode_runs;
+    // Values of the FrontFace field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, VkFrontFace> m_front_face_runs;
+    // Values of the DepthBiasEnabled field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_depth_bias_enabled_runs;
+    // Values of the DepthBiasConstantFactor field, as runs of equal values. The elements where the
+    // field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, float> m_depth_bias_constant_factor_runs;
+    // Values of the DepthBiasClamp field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, float> m_depth_bias_clamp_runs;
+    // Values of the DepthBiasSlopeFactor field, as runs of equal values. The elements where the
+    // field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, float> m_depth_bias_slope_factor_runs;
+    // Values of the LineWidth field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, float> m_line_width_runs;
+    // Values of the RasterizationSamples field, as runs of equal values. The elements where the
+    // field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, VkSampleCountFlagBits> m_rasterization_samples_runs;
+    // Values of the SampleShadingEnabled field, as runs of equal values. The elements where the
+    // field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_sample_shading_enabled_runs;
+    // Values of the MinSampleShading field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, float> m_min_sample_shading_runs;
+    // Values of the SampleMask field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, VkSampleMask> m_sample_mask_runs;
+    // Values of the AlphaToCoverageEnabled field, as runs of equal values. The elements where the
+    // field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_alpha_to_coverage_enabled_runs;
+    // Values of the DepthTestEnabled field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_depth_test_enabled_runs;
+    // Values of the DepthWriteEnabled field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_depth_write_enabled_runs;
+    // Values of the DepthCompareOp field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, VkCompareOp> m_depth_compare_op_runs;
+    // Values of the DepthBoundsTestEnabled field, as runs of equal values. The elements where the
+    // field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_depth_bounds_test_enabled_runs;
+    // Values of the MinDepthBounds field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, float> m_min_depth_bounds_runs;
+    // Values of the MaxDepthBounds field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, float> m_max_depth_bounds_runs;
+    // Values of the StencilTestEnabled field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_stencil_test_enabled_runs;
+    // Values of the StencilOpStateFront field, as runs of equal values. The elements where the
+    // field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, VkStencilOpState> m_stencil_op_state_front_runs;
+    // Values of the StencilOpStateBack field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, VkStencilOpState> m_stencil_op_state_back_runs;
+    // Values of the LogicOpEnabled field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, std::array<bool, kLogicOpEnabledArrayCount>>
+        m_logic_op_enabled_runs;
+    // Values of the LogicOp field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, std::array<VkLogicOp, kLogicOpArrayCount>>
+        m_logic_op_runs;
+    // Values of the Attachment field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type,
+                    std::array<VkPipelineColorBlendAttachmentState, kAttachmentArrayCount>>
+        m_attachment_runs;
+    // Values of the BlendConstant field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, std::array<float, kBlendConstantArrayCount>>
+        m_blend_constant_runs;
+    // Values of the LRZEnabled field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_lrz_enabled_runs;
+    // Values of the LRZWrite field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_lrz_write_runs;
+    // Values of the LRZDirStatus field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, a6xx_lrz_dir_status> m_lrz_dir_status_runs;
+    // Values of the LRZDirWrite field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_lrz_dir_write_runs;
+    // Values of the ZTestMode field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, a6xx_ztest_mode> m_z_test_mode_runs;
+    // Values of the BinW field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, uint32_t> m_bin_w_runs;
+    // Values of the BinH field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, uint32_t> m_bin_h_runs;
+    // Values of the WindowScissorTLX field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, uint16_t> m_window_scissor_tlx_runs;
+    // Values of the WindowScissorTLY field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, uint16_t> m_window_scissor_tly_runs;
+    // Values of the WindowScissorBRX field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, uint16_t> m_window_scissor_brx_runs;
+    // Values of the WindowScissorBRY field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, uint16_t> m_window_scissor_bry_runs;
+    // Values of the RenderMode field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, a6xx_render_mode> m_render_mode_runs;
+    // Values of the BuffersLocation field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, a6xx_buffers_location> m_buffers_location_runs;
+    // Values of the ThreadSize field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, a6xx_threadsize> m_thread_size_runs;
+    // Values of the EnableAllHelperLanes field, as runs of equal values. The elements where the
+    // field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_enable_all_helper_lanes_runs;
+    // Values of the EnablePartialHelperLanes field, as runs of equal values. The elements where the
+    // field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_enable_partial_helper_lanes_runs;
+    // Values of the UBWCEnabled field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, std::array<bool, kUBWCEnabledArrayCount>>
+        m_ubwc_enabled_runs;
+    // Values of the UBWCLosslessEnabled field, as runs of equal values. The elements where the
+    // field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, std::array<bool, kUBWCLosslessEnabledArrayCount>>
+        m_ubwc_lossless_enabled_runs;
+    // Values of the UBWCEnabledOnDS field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_ubwc_enabled_on_ds_runs;
+    // Values of the UBWCLosslessEnabledOnDS field, as runs of equal values. The elements where the
+    // field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, bool> m_ubwc_lossless_enabled_on_ds_runs;
+    // Values of the ResolveScissor field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, VkRect2D> m_resolve_scissor_runs;
+    // Values of the ResolveBaseGmem field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, uint32_t> m_resolve_base_gmem_runs;
+    // Values of the ResolveBaseSysmem field, as runs of equal values. The elements where the field
+    // is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, uint64_t> m_resolve_base_sysmem_runs;
+    // Values of the ResolveFormat field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, a6xx_format> m_resolve_format_runs;
+    // Values of the ResolveTileMode field, as runs of equal values. The elements where the field is
+    // not set keep the value of the previous element
+    RunLengthColumn<typename Id::basic_type, a6xx_tile_mode> m_resolve_tile_mode_runs;
 };
 class EventStateInfoRef;
 class EventStateInfoConstRef;
@@ -9,6 +9,54 @@ from common import gatherAllEnums
 from common import GetGPUVariantsBitField
 from common import addMissingDomains
 
+# Registers that Dive reads on hot paths (e.g. for every event), whose offsets are resolved here for
+# every GPU variant so that no name lookup is needed at runtime. See GetRegOffset()
+hot_reg_names = [
+  'GRAS_CL_CNTL',
+  'GRAS_CL_VIEWPORT0_XOFFSET',
+  'GRAS_LRZ_CNTL',
+  'GRAS_SC_BIN_CNTL',
+  'GRAS_SC_RAS_MSAA_CNTL',
+  'GRAS_SC_VIEWPORT_SCISSOR0_TL',
+  'GRAS_SC_WINDOW_SCISSOR_BR',
+  'GRAS_SC_WINDOW_SCISSOR_TL',
+  'GRAS_SU_CNTL',
+  'GRAS_SU_DEPTH_PLANE_CNTL',
+  'GRAS_SU_POLY_OFFSET_OFFSET',
+  'GRAS_SU_POLY_OFFSET_OFFSET_CLAMP',
+  'GRAS_SU_POLY_OFFSET_SCALE',
+  'HLSQ_BINDLESS_BASE0_DESCRIPTOR',
+  'HLSQ_CS_BINDLESS_BASE0_DESCRIPTOR',
+  'PC_CNTL',
+  'PC_DGEN_RAST_CNTL',
+  'PC_HS_PARAM_1',
+  'RB_BLEND_CNTL',
+  'RB_BLEND_CONSTANT_ALPHA_FP32',
+  'RB_BLEND_CONSTANT_BLUE_FP32',
+  'RB_BLEND_CONSTANT_GREEN_FP32',
+  'RB_BLEND_CONSTANT_RED_FP32',
+  'RB_DEPTH_BOUND_MAX',
+  'RB_DEPTH_BOUND_MIN',
+  'RB_DEPTH_BUFFER_INFO',
+  'RB_DEPTH_CNTL',
+  'RB_MRT0_BUF_INFO',
+  'RB_MRT0_CONTROL',
+  'RB_RESOLVE_CNTL_1',
+  'RB_RESOLVE_CNTL_2',
+  'RB_RESOLVE_GMEM_BUFFER_BASE',
+  'RB_RESOLVE_OPERATION',
+  'RB_RESOLVE_SYSTEM_BUFFER_BASE',
+  'RB_STENCIL_CNTL',
+  'RB_STENCIL_MASK',
+  'RB_STENCIL_REF_CNTL',
+  'RB_STENCIL_WRITE_MASK',
+  'SP_PS_CNTL_0',
+  'VPC_RAST_STREAM_CNTL',
+]
+
+# Indexed by the bit index of the GPUVariantType
+gpu_variant_names = ['A2XX', 'A3XX', 'A4XX', 'A5XX', 'A6XX', 'A7XX', 'A8XX']
+
 # ---------------------------------------------------------------------------------------
 def outputHeader(pm4_info_file):
   pm4_info_file.writelines('''
@@ -75,6 +123,9 @@ enum GPUVariantType
 };
 
 constexpr uint32_t kInvalidRegOffset = UINT32_MAX;
+''')
+  outputHotRegEnum(pm4_info_file)
+  pm4_info_file.writelines('''
 // be careful when increase this value
 // this is used in
 // - RegField::m_gpu_variants, so the unused bits needs to be adjusted
@@ -137,6 +188,8 @@ const RegInfo    *GetRegInfo(uint32_t reg);
 const RegInfo    *GetRegByName(const char *);
 const RegField   *GetRegFieldByName(const char *name, const RegInfo *info);
 uint32_t          GetRegOffsetByName(const char *name);
+uint32_t          GetRegOffset(HotReg reg);
+const char       *GetHotRegName(HotReg reg);
 const char       *GetEnumString(uint32_t enum_handle, uint32_t val);
 const PacketInfo *GetPacketInfo(uint32_t op_code);
 const PacketInfo *GetPacketInfo(uint32_t op_code, const char *name);
@@ -146,6 +199,14 @@ GPUVariantType    GetGPUVariantType();
 bool              IsFieldEnabled(const RegField *field);
 ''')
 
+# ---------------------------------------------------------------------------------------
+def outputHotRegEnum(pm4_info_file):
+  pm4_info_file.write('\n// Registers whose offsets are resolved at generation time, see GetRegOffset()\n')
+  pm4_info_file.write('enum class HotReg : uint32_t\n{\n')
+  for name in hot_reg_names:
+    pm4_info_file.write('    %s,\n' % (name))
+  pm4_info_file.write('    kCount\n};\n')
+
 # ---------------------------------------------------------------------------------------
 def outputHeaderCpp(pm4_info_header_file_name, pm4_info_file):
   outputHeader(pm4_info_file)
@@ -213,13 +274,40 @@ void Pm4InfoInit()
 ''')
   outputOpcodes(pm4_info_file, opcode_dict)
   pm4_info_file.write('\n')
-  outputRegisterInfo(pm4_info_file, registers_et_root, enum_index_dict)
+  reg_offsets = RegOffsets()
+  outputRegisterInfo(pm4_info_file, registers_et_root, enum_index_dict, reg_offsets)
   pm4_info_file.write('\n')
   outputEnums(pm4_info_file, enum_list)
   pm4_info_file.write('\n')
   outputPacketInfo(pm4_info_file, registers_et_root, enum_index_dict, opcode_dict)
   pm4_info_file.write('}\n')
-  return
+  return reg_offsets
+
+# ---------------------------------------------------------------------------------------
+def outputHotRegOffsets(pm4_info_file, reg_offsets):
+  name_to_offset = reg_offsets.getNameToOffset()
+
+  pm4_info_file.write('\nstatic constexpr const char *kHotRegNames[] = {\n')
+  for name in hot_reg_names:
+    pm4_info_file.write('    "%s",\n' % (name))
+  pm4_info_file.write('};\n')
+
+  # One row per GPU variant, indexed by the bit index of the GPUVariantType
+  pm4_info_file.write('\nstatic constexpr uint32_t kHotRegOffsets[][static_cast<uint32_t>(HotReg::kCount)] = {\n')
+  for variant_name in gpu_variant_names:
+    pm4_info_file.write('    // %s\n    {\n' % (variant_name))
+    for name in hot_reg_names:
+      offset = name_to_offset.get(name)
+      if offset is None:
+        offset = name_to_offset.get(name + '_' + variant_name)
+      if offset is None:
+        pm4_info_file.write('        kInvalidRegOffset,\n')
+      else:
+        pm4_info_file.write('        0x%x,\n' % (offset))
+    pm4_info_file.write('    },\n')
+  pm4_info_file.write('};\n')
+  pm4_info_file.write('static_assert(sizeof(kHotRegOffsets) / sizeof(kHotRegOffsets[0]) == kGPUVariantsBits);\n')
+  pm4_info_file.write('static const uint32_t *g_sHotRegOffsets = nullptr;\n')
 
 valid_opcodes = {}
 # ---------------------------------------------------------------------------------------
@@ -268,6 +356,30 @@ class RegAttributes():
   bit_width = 0
   radix = 0
 
+# Mirrors how Pm4InfoInit() fills in g_sRegInfo/g_sRegInfoVariant and g_sRegNameToIndex, so that
+# register offsets can be looked up by name the same way GetRegOffsetByName() does
+class RegOffsets():
+  def __init__(self):
+    self.regs = {}
+    self.variant_regs = {}
+
+  def add(self, attributes: RegAttributes):
+    variants_bitfield = GetGPUVariantsBitField(attributes.variants)
+    if variants_bitfield != 0:
+      for i in range(len(gpu_variant_names)):
+        if variants_bitfield & (1<<i):
+          self.variant_regs[(attributes.offset, i)] = attributes.name
+    else:
+      self.regs[attributes.offset] = attributes.name
+
+  def getNameToOffset(self):
+    name_to_offset = {}
+    for offset in sorted(self.regs):
+      name_to_offset[self.regs[offset]] = offset
+    for (offset, variant_index), name in self.variant_regs.items():
+      name_to_offset[name + '_' + gpu_variant_names[variant_index]] = offset
+    return name_to_offset
+
 # ---------------------------------------------------------------------------------------
 def GetBitfieldsOrEnumHandleFromBitset(input_type, input_bitfields, input_name, registers_et_root, enum_index_dict):
   if not isinstance(input_bitfields, list):
@@ -358,7 +470,9 @@ def AppendBitfield(pm4_info_file, enum_index_dict, bitfields, is_64):
         ))
 
 # ---------------------------------------------------------------------------------------
-def outputSingleRegister(pm4_info_file, registers_et_root, enum_index_dict, attributes: RegAttributes):
+def outputSingleRegister(pm4_info_file, registers_et_root, enum_index_dict, attributes: RegAttributes, reg_offsets):
+  reg_offsets.add(attributes)
+
   is_64_string = '0'
   if attributes.is_64 is True:
     is_64_string = '1'
@@ -397,7 +511,7 @@ def getIntAttributeValue(reg, attribute_name):
   return value
 
 # ---------------------------------------------------------------------------------------
-def outputRegisterInfo(pm4_info_file, registers_et_root, enum_index_dict):
+def outputRegisterInfo(pm4_info_file, registers_et_root, enum_index_dict, reg_offsets):
   a6xx_domain = registers_et_root.find('./{http://nouveau.freedesktop.org/}domain[@name="A6XX"]')
 
   # Create a list of 32-bit and 64-bit registers
@@ -445,7 +559,7 @@ def outputRegisterInfo(pm4_info_file, registers_et_root, enum_index_dict):
     reg_attributes.bit_width = bit_width
     reg_attributes.radix = radix
 
-    outputSingleRegister(pm4_info_file, registers_et_root, enum_index_dict, reg_attributes)
+    outputSingleRegister(pm4_info_file, registers_et_root, enum_index_dict, reg_attributes, reg_offsets)
 
   # Iterate and output the arrays as a sequence of reg32s with an index as a suffix
   arrays = a6xx_domain.findall('{http://nouveau.freedesktop.org/}array')
@@ -485,7 +599,7 @@ def outputRegisterInfo(pm4_info_file, registers_et_root, enum_index_dict):
         reg_attributes.shr = 0
         reg_attributes.bit_width = 0
         reg_attributes.radix = 0
-        outputSingleRegister(pm4_info_file, registers_et_root, enum_index_dict, reg_attributes)
+        outputSingleRegister(pm4_info_file, registers_et_root, enum_index_dict, reg_attributes, reg_offsets)
       elif stride == 2 and not array_regs:
         reg_attributes.name = array_name+str(i)+'_LO'
         reg_attributes.offset = offset+i*stride
@@ -496,7 +610,7 @@ def outputRegisterInfo(pm4_info_file, registers_et_root, enum_index_dict):
         reg_attributes.shr = 0
         reg_attributes.bit_width = 0
         reg_attributes.radix = 0
-        outputSingleRegister(pm4_info_file, registers_et_root, enum_index_dict, reg_attributes)
+        outputSingleRegister(pm4_info_file, registers_et_root, enum_index_dict, reg_attributes, reg_offsets)
       else:
         for reg_idx, reg in enumerate(array_regs):
           reg_name = reg.attrib['name']
@@ -526,7 +640,7 @@ def outputRegisterInfo(pm4_info_file, registers_et_root, enum_index_dict):
           # if no register variants, check if there are array-level variants (e.g. GRAS_CL_VIEWPORT)
           if (not reg_attributes.variants) and ('variants' in array.attrib):
             reg_attributes.variants = array.attrib['variants']
-          outputSingleRegister(pm4_info_file, registers_et_root, enum_index_dict, reg_attributes)
+          outputSingleRegister(pm4_info_file, registers_et_root, enum_index_dict, reg_attributes, reg_offsets)
   return
 
 # ---------------------------------------------------------------------------------------
@@ -997,6 +1111,17 @@ uint32_t GetRegOffsetByName(const char *name)
     return i->second;
 }
 
+uint32_t GetRegOffset(HotReg reg)
+{
+    DIVE_ASSERT(g_sHotRegOffsets != nullptr);
+    return g_sHotRegOffsets[static_cast<uint32_t>(reg)];
+}
+
+const char *GetHotRegName(HotReg reg)
+{
+    return kHotRegNames[static_cast<uint32_t>(reg)];
+}
+
 const char *GetEnumString(uint32_t enum_handle, uint32_t val)
 {
     if (g_sEnumReflection.size() <= enum_handle)
@@ -1045,10 +1170,12 @@ void SetGPUID(uint32_t gpu_id)
     if((gpu_series >= 2) && (gpu_series <= 7))
     {
         g_sGPU_variant = static_cast<GPUVariantType>(1 << (gpu_series - 2));
+        g_sHotRegOffsets = kHotRegOffsets[gpu_series - 2];
     }
     else
     {
         g_sGPU_variant = kGPUVariantNone;
+        g_sHotRegOffsets = nullptr;
     }
 }
 
@@ -1129,7 +1256,8 @@ try:
 
   # .CPP file
   outputHeaderCpp(pm4_info_filename_h, pm4_info_file_cpp)
-  outputPm4InfoInitFunc(pm4_info_file_cpp, registers_et_root, opcode_dict)
+  reg_offsets = outputPm4InfoInitFunc(pm4_info_file_cpp, registers_et_root, opcode_dict)
+  outputHotRegOffsets(pm4_info_file_cpp, reg_offsets)
   outputFunctionsCpp(pm4_info_file_cpp)
 
   # close to flush
@@ -84,6 +84,23 @@ EventmarkerInfo &events = marker_data.Events();
 auto it = events.Add();
 it->SetThreadY(7);
 ```
+
+# Chunked storage
+
+By default, the arrays of all the fields are stored in a single buffer, which is re-allocated,
+and copied as a whole, whenever it runs out of room. With the `chunked` option, the elements are
+instead stored in fixed-size chunks, each with the arrays of all the fields for its elements, so
+that `Add()` never copies the existing elements. The fields of mostly constant values can also be
+stored as runs of equal values, with `"compression": "rle"`, rather than as a value per element.
+The compression of a type applies to all of its fields, except the ones with their own (e.g.
+`"compression": "none"`). With the `isSet` option, a new element keeps the run-length encoded
+values of the previous one until its fields are set, while the getters return the default values
+of the fields that are not set, so that elements which set nothing do not split the runs. With all
+the fields compressed, only the values that change from one element to the next are stored, and the
+chunks only hold whether the fields are set.
+The getters and setters are the same in both modes, but there is no pointer to the whole array of
+a field (`MyFieldPtr()`) in chunked mode, and the pointers to the values of the run-length encoded
+fields are const.
 '''
 
 
@@ -120,6 +137,10 @@ def _is_numeric(ty: str) -> str:
     return ty in ['int32_t', 'uint32_t', 'int64_t', 'uint64_t']
 
 
+def _is_rle(field: Dict) -> bool:
+    return field.get('compression') == 'rle'
+
+
 def generate(spec: Dict, gen_name: str) -> None:
     '''
     Generates the header and source files for a loaded spec
@@ -132,6 +153,7 @@ def generate(spec: Dict, gen_name: str) -> None:
                       keep_trailing_newline=True,
                       autoescape=False)
     env.tests['numeric'] = _is_numeric
+    env.tests['rle'] = _is_rle
     env.filters['snake_case'] = snake_case
 
     def gen_file(macro, path, **kwargs):
@@ -148,6 +170,17 @@ def generate(spec: Dict, gen_name: str) -> None:
         spec_options = spec['header']['options']
     env.globals['options'] = spec_options
 
+    for soa in spec['soa_types']:
+        for field in soa['fields']:
+            if 'compression' in soa:
+                field.setdefault('compression', soa['compression'])
+            if field.get('compression', 'none') not in ['none', 'rle']:
+                raise (Exception('Field ' + field['name'] + ' has unknown compression ' +
+                                 field['compression']))
+            if _is_rle(field) and 'chunked' not in spec_options:
+                raise (Exception('Field ' + field['name'] +
+                                 ' is run-length encoded, which needs the chunked option'))
+
     gen_file('{{macros.soa_h(soas, includes, namespace, gen_name)}}',
              spec['header']['path'],
              soas=spec['soa_types'],
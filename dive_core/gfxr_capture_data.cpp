@@ -18,6 +18,7 @@
 
 #include <filesystem>
 #include <iostream>
+#include <optional>
 
 #include "absl/cleanup/cleanup.h"
 #include "absl/status/status.h"
@@ -67,6 +68,32 @@ absl::StatusOr<uint64_t> GetFileSize(const std::filesystem::path& file_path)
     GFXRECON_ASSERT(file_size >= 0);
     return static_cast<uint64_t>(file_size);
 }
+
+// Keeps the args of the command decoded from a given block.
+class CommandArgsCollector : public gfxrecon::decode::AnnotationHandler
+{
+ public:
+    explicit CommandArgsCollector(uint64_t block_index) : m_block_index(block_index) {}
+
+    void WriteBlockEnd(const gfxrecon::util::DiveFunctionData& function_data) override
+    {
+        if (function_data.GetBlockIndex() == m_block_index)
+        {
+            m_args = function_data.GetArgs();
+        }
+    }
+
+    void ProcessAnnotation(uint64_t block_index, gfxrecon::format::AnnotationType type,
+                           const std::string& label, const std::string& data) override
+    {
+    }
+
+    const std::optional<nlohmann::ordered_json>& GetArgs() const { return m_args; }
+
+ private:
+    uint64_t m_block_index;
+    std::optional<nlohmann::ordered_json> m_args;
+};
 }  // namespace
 
 // =================================================================================================
@@ -100,6 +127,7 @@ CaptureData::LoadResult GfxrCaptureData::LoadCaptureFile(const std::string& file
     file_processor.AddDecoder(&decoder);
 
     DiveAnnotationProcessor dive_annotation_processor;
+    dive_annotation_processor.SetLazyArgs(m_lazy_command_args);
     file_processor.SetAnnotationProcessor(&dive_annotation_processor);
     dive_consumer.Initialize(&dive_annotation_processor);
 
@@ -115,6 +143,7 @@ CaptureData::LoadResult GfxrCaptureData::LoadCaptureFile(const std::string& file
     DIVE_ASSERT(!m_gfxr_submits.empty());
     m_gfxr_command_buffers = dive_annotation_processor.TakeVkCommandsCache();
     m_gfxr_draw_call_counts = dive_annotation_processor.TakeDrawCallMap();
+    m_gfxr_arg_store = dive_annotation_processor.GetArgStore();
 
     absl::StatusOr<uint64_t> file_size = GetFileSize(file_name);
     if (!file_size.ok())
@@ -134,6 +163,50 @@ CaptureData::LoadResult GfxrCaptureData::LoadCaptureFile(const std::string& file
     return LoadResult::kSuccess;
 }
 
+//--------------------------------------------------------------------------------------------------
+absl::StatusOr<nlohmann::ordered_json> GfxrCaptureData::GetCommandArgs(
+    const DiveAnnotationProcessor::VulkanCommandInfo& command) const
+{
+    if (!command.args.is_null())
+    {
+        return command.args.ToJson();
+    }
+
+    uint64_t offset = 0;
+    if (m_gfxr_capture_block_data == nullptr ||
+        !m_gfxr_capture_block_data->GetOriginalBlockOffset(command.block_index, offset))
+    {
+        return absl::NotFoundError(
+            absl::StrFormat("No block %d in the loaded GFXR file", command.block_index));
+    }
+
+    // The block limit stops the decoding right after the block of the command.
+    gfxrecon::decode::DiveFileProcessor file_processor(command.block_index);
+    if (!file_processor.Initialize(m_cur_capture_file))
+    {
+        return absl::UnavailableError(
+            absl::StrFormat("Can't open GFXR file: %s", m_cur_capture_file));
+    }
+
+    gfxrecon::decode::VulkanExportDiveConsumer dive_consumer;
+    gfxrecon::decode::VulkanDecoder decoder;
+    decoder.AddConsumer(&dive_consumer);
+    file_processor.AddDecoder(&decoder);
+
+    CommandArgsCollector args_collector(command.block_index);
+    file_processor.SetAnnotationProcessor(&args_collector);
+    dive_consumer.Initialize(&args_collector);
+
+    if (!file_processor.ProcessBlockAt(command.block_index, offset) ||
+        !args_collector.GetArgs().has_value())
+    {
+        return absl::DataLossError(absl::StrFormat("Can't decode %s from block %d of %s",
+                                                   command.name, command.block_index,
+                                                   m_cur_capture_file));
+    }
+    return *args_collector.GetArgs();
+}
+
 //--------------------------------------------------------------------------------------------------
 bool GfxrCaptureData::WriteModifiedGfxrFile(const char* new_file_name)
 {
@@ -15,6 +15,7 @@
 */
 
 #pragma once
+#include "absl/status/statusor.h"
 #include "dive_core/capture_data.h"
 #include "gfxr_ext/decode/dive_annotation_processor.h"
 #include "gfxr_ext/decode/dive_block_data.h"
@@ -40,6 +41,17 @@ class GfxrCaptureData : public CaptureData
     // Sets m_cur_capture_file and m_gfxr_capture_block_data with info from the original GFXR file
     LoadResult LoadCaptureFile(const std::string& file_name) override;
 
+    // When set before LoadCaptureFile, only the args that name the nodes of the command hierarchy
+    // are kept in memory, and GetCommandArgs decodes the others from the file when asked. This
+    // keeps large captures from taking gigabytes of JSON.
+    void SetLazyCommandArgs(bool lazy) { m_lazy_command_args = lazy; }
+    bool HasLazyCommandArgs() const { return m_lazy_command_args; }
+
+    // Returns the args of the command, decoded from its block in the file if they were not kept.
+    // Not thread-safe, as the gfxrecon decoders share global state.
+    absl::StatusOr<nlohmann::ordered_json> GetCommandArgs(
+        const DiveAnnotationProcessor::VulkanCommandInfo& command) const;
+
     // Get the gfxr data
     bool IsDiveBlockDataInitialized() const { return m_gfxr_capture_block_data != nullptr; }
     std::shared_ptr<gfxrecon::decode::DiveBlockData> GetMutableGfxrData()
@@ -60,6 +72,9 @@ class GfxrCaptureData : public CaptureData
     std::unordered_map<uint64_t, std::vector<DiveAnnotationProcessor::VulkanCommandInfo>>
         m_gfxr_command_buffers;
     std::unordered_map<uint64_t, DiveAnnotationProcessor::DrawCallCounts> m_gfxr_draw_call_counts;
+    // Holds the args that the commands of m_gfxr_command_buffers and m_gfxr_submits point to.
+    std::shared_ptr<gfxrecon::decode::DiveArgStore> m_gfxr_arg_store;
+    bool m_lazy_command_args = false;
 };
 
 }  // namespace Dive
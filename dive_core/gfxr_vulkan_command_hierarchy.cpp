@@ -82,7 +82,7 @@ void GfxrVulkanCommandHierarchyCreator::OnCommand(
     std::vector<uint64_t>& render_pass_draw_call_counts)
 {
     const std::string& vulkan_cmd_name = vk_cmd_info.name;
-    const nlohmann::ordered_json& vulkan_cmd_args = vk_cmd_info.args;
+    const gfxrecon::decode::DiveArg& vulkan_cmd_args = vk_cmd_info.args;
     std::ostringstream vk_cmd_string_stream;
     vk_cmd_string_stream << vulkan_cmd_name;
     if (vulkan_cmd_name == "vkBeginCommandBuffer")
@@ -91,7 +91,7 @@ void GfxrVulkanCommandHierarchyCreator::OnCommand(
         uint64_t cmd_buffer_index =
             AddNode(NodeType::kGfxrVulkanBeginCommandBufferNode, vk_cmd_string_stream.str());
         m_cur_command_buffer_node_index = cmd_buffer_index;
-        GetArgs(vulkan_cmd_args, m_cur_command_buffer_node_index);
+        AddArgs(vk_cmd_info, m_cur_command_buffer_node_index);
         AddChild(CommandHierarchy::TopologyType::kAllEventTopology, m_cur_submit_node_index,
                  cmd_buffer_index);
     }
@@ -100,17 +100,18 @@ void GfxrVulkanCommandHierarchyCreator::OnCommand(
         uint64_t cmd_buffer_index =
             AddNode(NodeType::kGfxrVulkanEndCommandBufferNode, vk_cmd_string_stream.str());
 
-        GetArgs(vulkan_cmd_args, cmd_buffer_index);
+        AddArgs(vk_cmd_info, cmd_buffer_index);
         AddChild(CommandHierarchy::TopologyType::kAllEventTopology, m_cur_command_buffer_node_index,
                  cmd_buffer_index);
     }
     else if (vulkan_cmd_name.find("BeginDebugUtilsLabelEXT") != std::string::npos)
     {
-        std::string label_name = vulkan_cmd_args["pLabelInfo"]["pLabelName"];
+        std::string label_name =
+            vulkan_cmd_args["pLabelInfo"]["pLabelName"].get<std::string>();
 
         uint64_t begin_debug_utils_label_cmd_index =
             AddNode(NodeType::kGfxrBeginDebugUtilsLabelCommandNode, label_name.c_str());
-        GetArgs(vulkan_cmd_args, begin_debug_utils_label_cmd_index);
+        AddArgs(vk_cmd_info, begin_debug_utils_label_cmd_index);
         ConditionallyAddChild(begin_debug_utils_label_cmd_index);
         m_cur_parent_node_index_stack.push(begin_debug_utils_label_cmd_index);
     }
@@ -131,7 +132,7 @@ void GfxrVulkanCommandHierarchyCreator::OnCommand(
 
         uint64_t vk_cmd_index =
             AddNode(NodeType::kGfxrVulkanDrawCommandNode, vk_cmd_string_stream.str());
-        GetArgs(vulkan_cmd_args, vk_cmd_index);
+        AddArgs(vk_cmd_info, vk_cmd_index);
         ConditionallyAddChild(vk_cmd_index);
 
         if (vulkan_cmd_name.find("vkCmdDraw") != std::string::npos)
@@ -155,7 +156,7 @@ void GfxrVulkanCommandHierarchyCreator::OnCommand(
         vk_cmd_string_stream << ", Draw Call Count: " << draw_call_count;
         uint64_t vk_cmd_index =
             AddNode(NodeType::kGfxrVulkanBeginRenderPassCommandNode, vk_cmd_string_stream.str());
-        GetArgs(vulkan_cmd_args, vk_cmd_index);
+        AddArgs(vk_cmd_info, vk_cmd_index);
         ConditionallyAddChild(vk_cmd_index);
         m_cur_parent_node_index_stack.push(vk_cmd_index);
     }
@@ -163,7 +164,7 @@ void GfxrVulkanCommandHierarchyCreator::OnCommand(
     {
         uint64_t vk_cmd_index =
             AddNode(NodeType::kGfxrVulkanEndRenderPassCommandNode, vk_cmd_string_stream.str());
-        GetArgs(vulkan_cmd_args, vk_cmd_index);
+        AddArgs(vk_cmd_info, vk_cmd_index);
         ConditionallyAddChild(vk_cmd_index);
         if (!m_cur_parent_node_index_stack.empty())
         {
@@ -200,7 +201,7 @@ void GfxrVulkanCommandHierarchyCreator::OnCommand(
         }
 
         uint64_t vk_cmd_index = AddNode(node_type, vk_cmd_string_stream.str());
-        GetArgs(vulkan_cmd_args, vk_cmd_index);
+        AddArgs(vk_cmd_info, vk_cmd_index);
         ConditionallyAddChild(vk_cmd_index);
     }
 }
@@ -214,7 +215,7 @@ bool GfxrVulkanCommandHierarchyCreator::ProcessVkCmds(
 
     for (uint32_t i = 0; i < vkCmds.size(); ++i)
     {
-        DiveAnnotationProcessor::VulkanCommandInfo vk_cmd_info = vkCmds[i];
+        const DiveAnnotationProcessor::VulkanCommandInfo& vk_cmd_info = vkCmds[i];
         OnCommand(vk_cmd_info, draw_call_count, mutable_render_pass_draw_call_counts);
     }
 
@@ -268,6 +269,7 @@ bool GfxrVulkanCommandHierarchyCreator::CreateTrees(bool used_in_mixed_command_h
     m_used_in_mixed_command_hierarchy = used_in_mixed_command_hierarchy;
     // Clear/Reset internal data structures, just in case
     ClearCreatedDiveIndices();
+    m_lazy_args_commands.clear();
     if (!m_used_in_mixed_command_hierarchy)
     {
         m_command_hierarchy = CommandHierarchy();
@@ -368,7 +370,33 @@ bool GfxrVulkanCommandHierarchyCreator::ParseCurDrawCallInfo(std::string_view ke
     return true;
 }
 
-void GfxrVulkanCommandHierarchyCreator::GetArgs(const nlohmann::ordered_json& json_args,
+void GfxrVulkanCommandHierarchyCreator::AddArgs(
+    const DiveAnnotationProcessor::VulkanCommandInfo& vk_cmd_info, uint64_t curr_index)
+{
+    if (!m_capture_data.HasLazyCommandArgs())
+    {
+        GetArgs(vk_cmd_info.args, curr_index);
+        return;
+    }
+
+    // No arg nodes are created for lazily loaded args. The args kept for a draw are still parsed
+    // for the description of its node.
+    m_lazy_args_commands.emplace_back(curr_index, &vk_cmd_info);
+    if (!vk_cmd_info.args.is_object())
+    {
+        return;
+    }
+    for (auto const& [key, val] : vk_cmd_info.args.items())
+    {
+        if (val.is_primitive() && !ParseCurDrawCallInfo(key, val.dump()))
+        {
+            std::cerr << "GfxrVulkanCommandHierarchyCreator::AddArgs() "
+                      << "could not parse draw call info from: " << key << ":" << val << std::endl;
+        }
+    }
+}
+
+void GfxrVulkanCommandHierarchyCreator::GetArgs(const gfxrecon::decode::DiveArg& json_args,
                                                 uint64_t curr_index)
 {
     // This block processes key-value pairs where keys represent field names
@@ -382,7 +410,7 @@ void GfxrVulkanCommandHierarchyCreator::GetArgs(const nlohmann::ordered_json& js
                 // If the value is another object, create a new node for it
                 // and recursively process it.
                 uint64_t object_node_index =
-                    AddNode(NodeType::kGfxrVulkanCommandArgNode, key.c_str());
+                    AddNode(NodeType::kGfxrVulkanCommandArgNode, std::string(key));
                 AddChild(CommandHierarchy::TopologyType::kAllEventTopology, curr_index,
                          object_node_index);
 
@@ -393,7 +421,7 @@ void GfxrVulkanCommandHierarchyCreator::GetArgs(const nlohmann::ordered_json& js
                 // If the value is an array, create a new node for the array
                 // and then iterate through its elements.
                 uint64_t array_node_index =
-                    AddNode(NodeType::kGfxrVulkanCommandArgNode, key.c_str());
+                    AddNode(NodeType::kGfxrVulkanCommandArgNode, std::string(key));
                 AddChild(CommandHierarchy::TopologyType::kAllEventTopology, curr_index,
                          array_node_index);
                 for (size_t i = 0; i < val.size(); ++i)
@@ -20,6 +20,8 @@
 // =====================================================================================================================
 
 #include <stack>
+#include <utility>
+#include <vector>
 
 #include "dive_core/command_hierarchy.h"
 #include "dive_core/common/emulate_pm4.h"
@@ -58,10 +60,21 @@ class GfxrVulkanCommandHierarchyCreator
 
     void ClearCreatedDiveIndices() { m_dive_indices_to_local_indices_map.clear(); }
 
+    // The commands that have no arg nodes, by the index of their node in increasing order. Filled
+    // when the args are loaded lazily, see GfxrCaptureData::SetLazyCommandArgs.
+    using LazyArgsCommands =
+        std::vector<std::pair<uint64_t, const DiveAnnotationProcessor::VulkanCommandInfo*>>;
+    LazyArgsCommands TakeLazyArgsCommands() { return std::move(m_lazy_args_commands); }
+
  private:
     // Helper function to parse json representation of GFXR file into nodes and make calls to
     // AddNode() and AddChild() in hiearachical order.
-    void GetArgs(const nlohmann::ordered_json& json_args, uint64_t curr_index);
+    void GetArgs(const gfxrecon::decode::DiveArg& json_args, uint64_t curr_index);
+
+    // Adds the arg nodes of the command, unless its args are loaded lazily, see
+    // GfxrCaptureData::SetLazyCommandArgs.
+    void AddArgs(const DiveAnnotationProcessor::VulkanCommandInfo& vk_cmd_info,
+                 uint64_t curr_index);
 
     void CreateTopologies();
 
@@ -88,6 +101,7 @@ class GfxrVulkanCommandHierarchyCreator
     Topology m_topology[CommandHierarchy::kTopologyTypeCount];
     bool m_used_in_mixed_command_hierarchy = false;
     std::unordered_map<uint64_t, uint64_t> m_dive_indices_to_local_indices_map;
+    LazyArgsCommands m_lazy_args_commands;
 
     // Additional info that will be displayed in the description of a draw call node
     struct DrawCallDescInfo
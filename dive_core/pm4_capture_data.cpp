@@ -21,10 +21,23 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <string_view>
+
+#if defined(WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "archive.h"
+#include "dive_core/cache_directory.h"
 #include "dive_core/command_hierarchy.h"
 #include "dive_core/common/common.h"
 #include "freedreno_dev_info.h"
@@ -45,8 +58,126 @@ constexpr const uint32_t kMaxStrLen = 100 << 20;          // 100 MiB
 constexpr const uint32_t kMaxNumWavesPerBlock = 1 << 20;  // 1 MiB
 constexpr const uint32_t kMaxNumSGPRPerWave = 1 << 20;    // 1 MiB
 constexpr const uint32_t kMaxNumVGPRPerWave = 1 << 20;    // 1 MiB
+constexpr const uint32_t kFileChunkSize = 1 << 20;        // 1 MiB
+
+//--------------------------------------------------------------------------------------------------
+// The name of the file that file_name gets decompressed into, within cache_dir. It includes the
+// source file's path, size and modification time, so that a changed capture is not mistaken for
+// the one that was cached
+std::string GetDecompressedCacheFileName(const std::string& cache_dir, const std::string& file_name)
+{
+    std::error_code ec;
+    std::filesystem::path path = std::filesystem::absolute(file_name, ec);
+    uint64_t file_size = std::filesystem::file_size(path, ec);
+    auto write_time = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+
+    std::ostringstream key;
+    key << path.generic_string() << ":" << file_size << ":" << write_time;
+    std::ostringstream cache_file_name;
+    cache_file_name << path.stem().generic_string() << "." << std::hex
+                    << std::hash<std::string>{}(key.str()) << ".rd";
+    return (std::filesystem::path(cache_dir) / cache_file_name.str()).generic_string();
+}
+
+//--------------------------------------------------------------------------------------------------
+// Decompress the whole of file_name into cache_file_name. Writes to a temporary file first, so that
+// an interrupted decompression never leaves a truncated file behind under the final name
+bool DecompressToFile(const std::string& file_name, const std::string& cache_file_name)
+{
+    FileReader reader(file_name.c_str());
+    if (reader.Open() != 0) return false;
+
+    std::string temp_file_name = cache_file_name + ".tmp";
+    {
+        std::ofstream temp_file(temp_file_name, std::ios::out | std::ios::binary);
+        if (!temp_file.is_open()) return false;
+
+        DiveVector<char> buf(kFileChunkSize);
+        int64_t bytes_read;
+        while ((bytes_read = reader.Read(buf.data(), buf.size())) > 0)
+        {
+            if (!temp_file.write(buf.data(), bytes_read)) break;
+        }
+        if (bytes_read != 0 || !temp_file.flush())
+        {
+            temp_file.close();
+            std::filesystem::remove(temp_file_name);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_file_name, cache_file_name, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temp_file_name, ec);
+        return false;
+    }
+    return true;
+}
 }  // namespace
 
+// =================================================================================================
+// MappedFile
+// =================================================================================================
+MappedFile::MappedFile(const uint8_t* data, uint64_t size) : m_data(data), m_size(size) {}
+
+//--------------------------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+#if defined(WIN32)
+    UnmapViewOfFile(m_data);
+#else
+    munmap((void*)m_data, m_size);
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+std::shared_ptr<MappedFile> MappedFile::Open(const char* file_name)
+{
+#if defined(WIN32)
+    HANDLE file = CreateFileA(file_name, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0 ||
+        (uint64_t)file_size.QuadPart > SIZE_MAX)
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    // The view keeps the file and the mapping object alive, so both handles can be closed
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) return nullptr;
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == nullptr) return nullptr;
+
+    uint64_t size = (uint64_t)file_size.QuadPart;
+#else
+    int fd = open(file_name, O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0 ||
+        (uint64_t)file_stat.st_size > SIZE_MAX)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    // The mapping keeps the file alive, so the descriptor can be closed
+    uint64_t size = (uint64_t)file_stat.st_size;
+    void* data = mmap(nullptr, (size_t)size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return nullptr;
+#endif
+    return std::shared_ptr<MappedFile>(new MappedFile((const uint8_t*)data, size));
+}
+
 //--------------------------------------------------------------------------------------------------
 FileReader::FileReader(const char* file_name)
     : m_file_name(file_name),
@@ -105,6 +236,16 @@ int FileReader::Open()
     if (ret != ARCHIVE_OK)
     {
         std::cerr << "error archive_read_next_header: " << archive_error_string(m_handle.get());
+        return ret;
+    }
+
+    // If the data is the file itself, as-is, then map the file instead of streaming it. If that
+    // fails, keep on streaming
+    if (archive_filter_code(m_handle.get(), 0) == ARCHIVE_FILTER_NONE &&
+        archive_format(m_handle.get()) == ARCHIVE_FORMAT_RAW)
+    {
+        m_mapped_file = MappedFile::Open(m_file_name.c_str());
+        if (m_mapped_file != nullptr) m_handle = nullptr;
     }
 
     return ret;
@@ -113,6 +254,15 @@ int FileReader::Open()
 //--------------------------------------------------------------------------------------------------
 int64_t FileReader::Read(char* buf, int64_t nbytes)
 {
+    if (m_mapped_file != nullptr)
+    {
+        uint64_t size = std::min((uint64_t)std::max(nbytes, (int64_t)0),
+                                 m_mapped_file->GetSize() - m_mapped_offset);
+        memcpy(buf, m_mapped_file->GetData() + m_mapped_offset, size);
+        m_mapped_offset += size;
+        return (int64_t)size;
+    }
+
     char* ptr = buf;
     int64_t ret = 0;
     while (nbytes > 0)
@@ -131,10 +281,31 @@ int64_t FileReader::Read(char* buf, int64_t nbytes)
     return ret;
 }
 
+//--------------------------------------------------------------------------------------------------
+bool FileReader::Skip(int64_t nbytes)
+{
+    if (m_mapped_file != nullptr)
+    {
+        if ((uint64_t)nbytes > m_mapped_file->GetSize() - m_mapped_offset) return false;
+        m_mapped_offset += nbytes;
+        return true;
+    }
+
+    char buf[4096];
+    while (nbytes > 0)
+    {
+        int64_t n = Read(buf, std::min(nbytes, (int64_t)sizeof(buf)));
+        if (n <= 0) return false;
+        nbytes -= n;
+    }
+    return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 int FileReader::Close()
 {
     m_handle = nullptr;
+    m_mapped_file = nullptr;
     return 0;
 }
 
@@ -192,19 +363,149 @@ void MemoryAllocationInfo::AddMemoryAllocations(uint32_t submit_index,
 }
 
 // =================================================================================================
-// MemoryManager
+// MemoryArena
 // =================================================================================================
-MemoryManager::~MemoryManager()
+MemoryArena::MemoryArena(MemoryArena&& other) noexcept
+    : m_chunks(std::move(other.m_chunks)),
+      m_next_chunk_size(other.m_next_chunk_size),
+      m_reserved_size(other.m_reserved_size)
 {
-    for (uint32_t i = 0; i < m_memory_blocks.size(); ++i)
+    other.m_next_chunk_size = kMinChunkSize;
+    other.m_reserved_size = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+MemoryArena& MemoryArena::operator=(MemoryArena&& other) noexcept
+{
+    if (&other != this)
+    {
+        Reset();
+        m_chunks = std::move(other.m_chunks);
+        m_next_chunk_size = other.m_next_chunk_size;
+        m_reserved_size = other.m_reserved_size;
+        other.m_next_chunk_size = kMinChunkSize;
+        other.m_reserved_size = 0;
+    }
+    return *this;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint8_t* MemoryArena::Allocate(uint64_t size)
+{
+    constexpr uint64_t kAlignment = 8;
+    if (!m_chunks.empty())
+    {
+        Chunk& chunk = m_chunks.back();
+        uint64_t offset = (chunk.m_used + kAlignment - 1) & ~(kAlignment - 1);
+        if (offset + size <= chunk.m_size)
+        {
+            chunk.m_used = offset + size;
+            return chunk.m_data + offset;
+        }
+    }
+
+    // Whatever is left in the current chunk is wasted, which is at most a small fraction of it,
+    // except for blocks larger than a chunk. Those get a chunk of their own
+    Chunk chunk;
+    chunk.m_size = std::max(m_next_chunk_size, size);
+    chunk.m_data = new uint8_t[chunk.m_size];
+    chunk.m_used = size;
+    m_chunks.push_back(chunk);
+    m_reserved_size += chunk.m_size;
+    m_next_chunk_size = std::min(m_next_chunk_size * 2, kMaxChunkSize);
+    return chunk.m_data;
+}
+
+//--------------------------------------------------------------------------------------------------
+void MemoryArena::FreeLast(const uint8_t* ptr, uint64_t size)
+{
+    if (m_chunks.empty()) return;
+    Chunk& chunk = m_chunks.back();
+    if (ptr >= chunk.m_data && ptr + size == chunk.m_data + chunk.m_used)
+    {
+        chunk.m_used = ptr - chunk.m_data;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+bool MemoryArena::IsLast(const uint8_t* ptr, uint64_t size) const
+{
+    if (m_chunks.empty()) return false;
+    const Chunk& chunk = m_chunks.back();
+    return ptr >= chunk.m_data && ptr + size == chunk.m_data + chunk.m_used;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t MemoryArena::GetUsedSize() const
+{
+    uint64_t used_size = 0;
+    for (uint32_t i = 0; i < m_chunks.size(); ++i)
+    {
+        used_size += m_chunks[i].m_used;
+    }
+    return used_size;
+}
+
+//--------------------------------------------------------------------------------------------------
+void MemoryArena::Reset()
+{
+    for (uint32_t i = 0; i < m_chunks.size(); ++i)
     {
-        delete[] m_memory_blocks[i].m_data_ptr;
+        delete[] m_chunks[i].m_data;
     }
+    m_chunks.clear();
+    m_next_chunk_size = kMinChunkSize;
+    m_reserved_size = 0;
+}
+
+// =================================================================================================
+// MemoryManager
+// =================================================================================================
+MemoryData MemoryManager::AllocateMemoryData(uint32_t size)
+{
+    MemoryData data;
+    data.m_data_size = size;
+    data.m_data_ptr = m_arena.Allocate(size);
+    return data;
+}
+
+//--------------------------------------------------------------------------------------------------
+void MemoryManager::FreeMemoryData(MemoryData&& data)
+{
+    DIVE_ASSERT(m_arena.IsLast(data.m_data_ptr, data.m_data_size));
+    m_arena.FreeLast(data.m_data_ptr, data.m_data_size);
+    data.m_data_size = 0;
+    data.m_data_ptr = nullptr;
 }
 
 //--------------------------------------------------------------------------------------------------
 void MemoryManager::AddMemoryBlock(uint32_t submit_index, uint64_t va_addr, MemoryData&& data)
 {
+    // The same buffers (shader binaries, descriptors, static vertex data, ...) tend to be captured
+    // again for every submit. So store each distinct content only once. Giving back the duplicate
+    // copy relies on it being the most recent arena allocation, so nothing else may have been
+    // allocated since AllocateMemoryData()
+    DIVE_ASSERT(m_arena.IsLast(data.m_data_ptr, data.m_data_size));
+    m_added_data_size += data.m_data_size;
+    uint64_t hash = std::hash<std::string_view>{}(
+        std::string_view((const char*)data.m_data_ptr, data.m_data_size));
+    auto range = m_data_by_hash.equal_range(hash);
+    auto it = std::find_if(range.first, range.second, [&](const auto& entry) {
+        const MemoryData& stored = entry.second;
+        return stored.m_data_size == data.m_data_size &&
+               memcmp(stored.m_data_ptr, data.m_data_ptr, data.m_data_size) == 0;
+    });
+    if (it != range.second)
+    {
+        m_arena.FreeLast(data.m_data_ptr, data.m_data_size);
+        data.m_data_ptr = it->second.m_data_ptr;
+    }
+    else
+    {
+        m_data_by_hash.emplace(hash, data);
+        m_stored_data_size += data.m_data_size;
+    }
+
     MemoryBlock mem_block;
     mem_block.m_submit_index = submit_index;
     mem_block.m_va_addr = va_addr;
@@ -217,6 +518,24 @@ void MemoryManager::AddMemoryBlock(uint32_t submit_index, uint64_t va_addr, Memo
     data.m_data_ptr = nullptr;
 }
 
+//--------------------------------------------------------------------------------------------------
+void MemoryManager::AddMappedMemoryBlock(uint32_t submit_index, uint64_t va_addr, uint32_t size,
+                                         const std::shared_ptr<MappedFile>& mapped_file,
+                                         uint64_t offset)
+{
+    // All mapped blocks are expected to come from the one capture file
+    DIVE_ASSERT(m_mapped_file == nullptr || m_mapped_file == mapped_file);
+    DIVE_ASSERT(offset + size <= mapped_file->GetSize());
+    m_mapped_file = mapped_file;
+
+    MemoryBlock mem_block;
+    mem_block.m_submit_index = submit_index;
+    mem_block.m_va_addr = va_addr;
+    mem_block.m_data_size = size;
+    mem_block.m_data_ptr = mapped_file->GetData() + offset;
+    m_memory_blocks.push_back(mem_block);
+}
+
 //--------------------------------------------------------------------------------------------------
 void MemoryManager::AddMemoryAllocations(uint32_t submit_index,
                                          MemoryAllocationsDataHeader::Type type,
@@ -230,6 +549,9 @@ void MemoryManager::Finalize(bool same_submit_copy_only, bool duplicate_ib_captu
 {
     m_same_submit_only = same_submit_copy_only;
 
+    // No more blocks to be added, so no more need to look up identical data
+    std::unordered_multimap<uint64_t, MemoryData>().swap(m_data_by_hash);
+
     // Sorting required for GetMaxContiguousSize(), GetMemoryOfUnknownSizeViaCallback(), and others
     // Important: Preserve order of equivalent blocks using stable_sort (later blocks have more
     // updated view of memory)
@@ -278,23 +600,21 @@ void MemoryManager::Finalize(bool same_submit_copy_only, bool duplicate_ib_captu
                     // (i.e. whole or partial overwrite)
                     DIVE_ASSERT(memory_block.m_va_addr == prev_addr);
 
-                    // Use whichever one is bigger and get rid of the smaller one
+                    // Use whichever one is bigger and get rid of the smaller one. Its data is
+                    // reclaimed by CompactArena(), if it is worth it
                     if (memory_block.m_data_size >= temp_memory_blocks.back().m_data_size)
                     {
                         // Replace previous memory block with current one
-                        delete[] temp_memory_blocks.back().m_data_ptr;
                         temp_memory_blocks.back() = m_memory_blocks[i];
                     }
-                    else
-                    {
-                        delete[] m_memory_blocks[i].m_data_ptr;
-                    }
                 }
             }
             prev_addr = memory_block.m_va_addr;
             prev_size = memory_block.m_data_size;
         }
+        bool dropped_blocks = temp_memory_blocks.size() != m_memory_blocks.size();
         m_memory_blocks = std::move(temp_memory_blocks);
+        if (dropped_blocks) CompactArena();
     }
 
 #ifndef NDEBUG
@@ -338,6 +658,133 @@ void MemoryManager::Finalize(bool same_submit_copy_only, bool duplicate_ib_captu
         }
     }
 #endif
+
+    m_last_used_block_ptr = nullptr;
+    BuildBlockIndex();
+}
+
+//--------------------------------------------------------------------------------------------------
+void MemoryManager::CompactArena()
+{
+    auto is_mapped = [&](const uint8_t* data_ptr) {
+        return m_mapped_file != nullptr && m_mapped_file->Contains(data_ptr);
+    };
+
+    // Blocks with identical data share it, so each distinct pointer is only counted (and later
+    // copied) once
+    std::unordered_map<const uint8_t*, const uint8_t*> new_data_ptrs;
+    uint64_t live_size = 0;
+    for (uint32_t i = 0; i < m_memory_blocks.size(); ++i)
+    {
+        const MemoryBlock& mem_block = m_memory_blocks[i];
+        if (is_mapped(mem_block.m_data_ptr)) continue;
+        if (new_data_ptrs.emplace(mem_block.m_data_ptr, nullptr).second)
+            live_size += mem_block.m_data_size;
+    }
+    m_stored_data_size = live_size;
+
+    // Copying needs memory for the live data on top of the current arena, so it only pays off if
+    // a good part of the arena is freed by it
+    uint64_t used_size = m_arena.GetUsedSize();
+    if (used_size - live_size < used_size / 4) return;
+
+    MemoryArena arena;
+    for (uint32_t i = 0; i < m_memory_blocks.size(); ++i)
+    {
+        MemoryBlock& mem_block = m_memory_blocks[i];
+        if (is_mapped(mem_block.m_data_ptr)) continue;
+        const uint8_t*& new_data_ptr = new_data_ptrs[mem_block.m_data_ptr];
+        if (new_data_ptr == nullptr)
+        {
+            uint8_t* data_ptr = arena.Allocate(mem_block.m_data_size);
+            memcpy(data_ptr, mem_block.m_data_ptr, mem_block.m_data_size);
+            new_data_ptr = data_ptr;
+        }
+        mem_block.m_data_ptr = new_data_ptr;
+    }
+    m_arena = std::move(arena);
+}
+
+//--------------------------------------------------------------------------------------------------
+void MemoryManager::BuildBlockIndex()
+{
+    uint32_t num_memory_blocks = (uint32_t)m_memory_blocks.size();
+    m_submit_block_ranges.clear();
+    m_max_end_addrs.resize(num_memory_blocks);
+
+    // Blocks are sorted by submit first when m_same_submit_only, so each submit maps to a single
+    // contiguous range of blocks. Submits without any memory block get an empty range.
+    if (m_same_submit_only && num_memory_blocks > 0)
+    {
+        uint32_t num_submits = m_memory_blocks.back().m_submit_index + 1;
+        m_submit_block_ranges.resize(num_submits, BlockRange{ 0, 0 });
+    }
+
+    uint64_t max_end_addr = 0;
+    for (uint32_t i = 0; i < num_memory_blocks; ++i)
+    {
+        const MemoryBlock& mem_block = m_memory_blocks[i];
+        if (m_same_submit_only)
+        {
+            BlockRange& range = m_submit_block_ranges[mem_block.m_submit_index];
+            if (range.m_begin == range.m_end)
+            {
+                range.m_begin = i;
+                max_end_addr = 0;
+            }
+            range.m_end = i + 1;
+        }
+        max_end_addr = std::max(max_end_addr, mem_block.m_va_addr + mem_block.m_data_size);
+        m_max_end_addrs[i] = max_end_addr;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+MemoryManager::BlockRange MemoryManager::GetBlockRange(uint32_t submit_index) const
+{
+    if (!m_same_submit_only) return BlockRange{ 0, (uint32_t)m_memory_blocks.size() };
+    if (submit_index >= m_submit_block_ranges.size()) return BlockRange{ 0, 0 };
+    return m_submit_block_ranges[submit_index];
+}
+
+//--------------------------------------------------------------------------------------------------
+MemoryManager::BlockRange MemoryManager::FindOverlappingBlocks(BlockRange range, uint64_t va_addr,
+                                                               uint64_t end_addr) const
+{
+    if (range.m_begin == range.m_end) return range;
+
+    // Blocks before 'first' all end at or before va_addr
+    const uint64_t* max_end_addrs = m_max_end_addrs.data();
+    const uint64_t* first = std::partition_point(max_end_addrs + range.m_begin,
+                                                 max_end_addrs + range.m_end,
+                                                 [&](uint64_t addr) { return addr <= va_addr; });
+
+    // Blocks from 'last' onwards all start at or after end_addr
+    const MemoryBlock* memory_blocks = m_memory_blocks.data();
+    const MemoryBlock* last = std::partition_point(memory_blocks + range.m_begin,
+                                                   memory_blocks + range.m_end,
+                                                   [&](const MemoryBlock& mem_block) {
+                                                       return mem_block.m_va_addr < end_addr;
+                                                   });
+
+    BlockRange overlapping;
+    overlapping.m_begin = (uint32_t)(first - max_end_addrs);
+    overlapping.m_end = std::max(overlapping.m_begin, (uint32_t)(last - memory_blocks));
+    return overlapping;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t MemoryManager::FindFirstContainingBlock(BlockRange range, uint64_t va_addr) const
+{
+    // Candidates all start at or before va_addr, but might end before it if blocks overlap
+    BlockRange candidates = FindOverlappingBlocks(range, va_addr, va_addr + 1);
+    for (uint32_t i = candidates.m_begin; i < candidates.m_end; ++i)
+    {
+        const MemoryBlock& mem_block = m_memory_blocks[i];
+        uint64_t mem_block_end_addr = mem_block.m_va_addr + mem_block.m_data_size;
+        if (mem_block.m_va_addr <= va_addr && va_addr < mem_block_end_addr) return i;
+    }
+    return range.m_end;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -374,19 +821,18 @@ bool MemoryManager::RetrieveMemoryData(void* buffer_ptr, uint32_t submit_index,
         }
     }
 
-    // Iterate through the memory blocks to find overlapping blocks and do the appropriate memcopies
+    // Only visit the blocks that can overlap the requested range, and do the appropriate memcopies.
+    // Iterate backwards to give priority to later blocks, same as a full scan would
     uint64_t amount_copied = 0;
-    uint32_t num_memory_blocks = (uint32_t)m_memory_blocks.size();
-    const MemoryBlock* memory_blocks = (num_memory_blocks > 0) ? &m_memory_blocks.front() : nullptr;
-    for (uint32_t i = num_memory_blocks - 1; i != UINT32_MAX; --i)
+    uint64_t end_addr = va_addr + size;
+    BlockRange range = FindOverlappingBlocks(GetBlockRange(submit_index), va_addr, end_addr);
+    for (uint32_t i = range.m_end; i-- > range.m_begin;)
     {
-        const MemoryBlock& mem_block = memory_blocks[i];
+        const MemoryBlock& mem_block = m_memory_blocks[i];
 
         uint64_t mem_block_end_addr = mem_block.m_va_addr + mem_block.m_data_size;
-        uint64_t end_addr = va_addr + size;
-        bool valid_submit = m_same_submit_only ? (submit_index == mem_block.m_submit_index) : true;
         bool overlaps = (va_addr < mem_block_end_addr) && (mem_block.m_va_addr < end_addr);
-        if (valid_submit && overlaps)
+        if (overlaps)
         {
             m_last_used_block_ptr = &mem_block;
             uint64_t max_start_addr = std::max(va_addr, mem_block.m_va_addr);
@@ -420,45 +866,34 @@ bool MemoryManager::GetMemoryOfUnknownSizeViaCallback(uint32_t submit_index, uin
                                                       PfnGetMemory data_callback,
                                                       void* user_ptr) const
 {
-    uint64_t cur_addr = va_addr;
-
-    // Iterate through the memory blocks to find the biggest block that contains the passed-in addr
+    // Find the first block that contains the passed-in addr, then keep walking the (sorted) blocks
+    // as long as they are contiguous
     // Note: m_same_submit_only => Blocks are sorted by submit, then by address
     //       otherwise they are just sorted by address
-    for (uint64_t i = 0; i < m_memory_blocks.size(); ++i)
+    BlockRange range = GetBlockRange(submit_index);
+    uint32_t i = FindFirstContainingBlock(range, va_addr);
+    if (i == range.m_end) return true;
+
+    // First block just has to contain this address
+    const MemoryBlock& first_block = m_memory_blocks[i];
+    uint64_t cur_addr = first_block.m_va_addr + first_block.m_data_size;
+    const void* data_ptr = first_block.m_data_ptr + (va_addr - first_block.m_va_addr);
+    if (!data_callback(data_ptr, va_addr, cur_addr - va_addr, user_ptr))
+        return true;  // Callback indicates no more searching is needed
+
+    for (++i; i < range.m_end; ++i)
     {
         const MemoryBlock& mem_block = m_memory_blocks[i];
-        bool valid_submit = m_same_submit_only ? (submit_index == mem_block.m_submit_index) : true;
-        if (valid_submit)
-        {
-            if (cur_addr == va_addr)
-            {
-                // First block just has to contain this address
-                uint64_t mem_block_end_addr = mem_block.m_va_addr + mem_block.m_data_size;
-                if (mem_block.m_va_addr <= va_addr && va_addr < mem_block_end_addr)
-                {
-                    void* data_ptr = mem_block.m_data_ptr + (va_addr - mem_block.m_va_addr);
-                    uint64_t size = mem_block_end_addr - va_addr;
-                    if (!data_callback(data_ptr, va_addr, size, user_ptr))
-                        break;  // Callback indicates no more searching is needed
-                    cur_addr = mem_block_end_addr;
-                }
-            }
-            else if (cur_addr == mem_block.m_va_addr)
-            {
-                if (!data_callback(mem_block.m_data_ptr, cur_addr, mem_block.m_data_size, user_ptr))
-                    break;  // Callback indicates no more searching is needed
 
-                // Is contiguous. Update the cur_addr to reflect this block.
-                cur_addr = mem_block.m_va_addr + mem_block.m_data_size;
-            }
-            else if (cur_addr != va_addr)
-            {
-                // Not contiguous, and found a discountinuity in captured address range
-                // So safe to early out instead of continuing the search
-                return true;
-            }
-        }
+        // Not contiguous, and found a discountinuity in captured address range
+        // So safe to early out instead of continuing the search
+        if (cur_addr != mem_block.m_va_addr) break;
+
+        if (!data_callback(mem_block.m_data_ptr, cur_addr, mem_block.m_data_size, user_ptr))
+            break;  // Callback indicates no more searching is needed
+
+        // Is contiguous. Update the cur_addr to reflect this block.
+        cur_addr = mem_block.m_va_addr + mem_block.m_data_size;
     }
     return true;
 }
@@ -466,36 +901,24 @@ bool MemoryManager::GetMemoryOfUnknownSizeViaCallback(uint32_t submit_index, uin
 //--------------------------------------------------------------------------------------------------
 uint64_t MemoryManager::GetMaxContiguousSize(uint32_t submit_index, uint64_t va_addr) const
 {
-    uint64_t cur_addr = va_addr;
-
-    // Iterate through the memory blocks to find the biggest block that contains the passed-in addr
+    // Find the first block that contains the passed-in addr, then keep walking the (sorted) blocks
+    // as long as they are contiguous
     // Note: m_same_submit_only => Blocks are sorted by submit, then by address
     //       otherwise they are just sorted by address
-    for (uint64_t i = 0; i < m_memory_blocks.size(); ++i)
+    BlockRange range = GetBlockRange(submit_index);
+    uint32_t i = FindFirstContainingBlock(range, va_addr);
+    if (i == range.m_end) return 0;
+
+    uint64_t cur_addr = m_memory_blocks[i].m_va_addr + m_memory_blocks[i].m_data_size;
+    for (++i; i < range.m_end; ++i)
     {
         const MemoryBlock& mem_block = m_memory_blocks[i];
-        bool valid_submit = m_same_submit_only ? (submit_index == mem_block.m_submit_index) : true;
-        if (valid_submit)
-        {
-            if (cur_addr == va_addr)
-            {
-                // First block just has to contain this address
-                uint64_t mem_block_end_addr = mem_block.m_va_addr + mem_block.m_data_size;
-                if (mem_block.m_va_addr <= va_addr && va_addr < mem_block_end_addr)
-                    cur_addr = mem_block_end_addr;
-            }
-            else if (cur_addr == mem_block.m_va_addr)
-            {
-                // Is contiguous. Update the cur_addr to reflect this block.
-                cur_addr = mem_block.m_va_addr + mem_block.m_data_size;
-            }
-            else if (cur_addr != va_addr)
-            {
-                // Not contiguous, and found a discountinuity in captured address range
-                // So safe to early out instead of continuing the search
-                return (cur_addr - va_addr);
-            }
-        }
+
+        // Not contiguous, and found a discountinuity in captured address range
+        if (cur_addr != mem_block.m_va_addr) break;
+
+        // Is contiguous. Update the cur_addr to reflect this block.
+        cur_addr = mem_block.m_va_addr + mem_block.m_data_size;
     }
     return (cur_addr - va_addr);
 }
@@ -765,7 +1188,36 @@ CaptureData::LoadResult Pm4CaptureData::LoadDiveFile(const std::string& file_nam
 //--------------------------------------------------------------------------------------------------
 CaptureData::LoadResult Pm4CaptureData::LoadAdrenoRdFile(const std::string& file_name)
 {
-    FileReader reader(file_name.data());
+    // A compressed file can't be mapped, so read from a decompressed copy of it instead, if there
+    // is a cache to put it in
+    std::string load_file_name = file_name;
+    if (!m_decompression_cache_dir.empty())
+    {
+        FileReader reader(file_name.data());
+        if (reader.Open() == 0 && reader.GetMappedFile() == nullptr)
+        {
+            std::string cache_file_name =
+                GetDecompressedCacheFileName(m_decompression_cache_dir, file_name);
+            if (std::filesystem::exists(cache_file_name))
+            {
+                TouchCacheFile(cache_file_name);
+                load_file_name = cache_file_name;
+            }
+            else if (DecompressToFile(file_name, cache_file_name))
+            {
+                PruneCacheDirectory(m_decompression_cache_dir, m_decompression_cache_max_size,
+                                    cache_file_name);
+                load_file_name = cache_file_name;
+            }
+            else
+            {
+                std::cerr << "Not able to decompress " << file_name << " to " << cache_file_name
+                          << std::endl;
+            }
+        }
+    }
+
+    FileReader reader(load_file_name.data());
     if (reader.Open() != 0)
     {
         std::cerr << "Not able to open: " << file_name << std::endl;
@@ -909,14 +1361,13 @@ CaptureData::LoadResult Pm4CaptureData::LoadAdrenoRdFile(FileReader& capture_fil
             {
                 // Skip parsing commands from system processes
                 skip_commands = false;
-                char* process_name = new char[block_info.m_data_size];
-                if (!capture_file.Read((char*)process_name, block_info.m_data_size))
+                std::string process_name(block_info.m_data_size, '\0');
+                if (!capture_file.Read(process_name.data(), block_info.m_data_size))
                     return LoadResult::kFileIoError;
-                skip_commands |= (strcmp(process_name, "fdperf") == 0);
-                skip_commands |= (strcmp(process_name, "chrome") == 0);
-                skip_commands |= (strcmp(process_name, "surfaceflinger") == 0);
-                skip_commands |= ((char*)process_name)[0] == 'X';
-                delete[] process_name;
+                skip_commands |= (strcmp(process_name.c_str(), "fdperf") == 0);
+                skip_commands |= (strcmp(process_name.c_str(), "chrome") == 0);
+                skip_commands |= (strcmp(process_name.c_str(), "surfaceflinger") == 0);
+                skip_commands |= process_name[0] == 'X';
                 break;
             }
             case RD_NONE:
@@ -928,11 +1379,8 @@ CaptureData::LoadResult Pm4CaptureData::LoadAdrenoRdFile(FileReader& capture_fil
             case RD_PROGRAM:
             case RD_VERT_SHADER:
             case RD_FRAG_SHADER:
-            {
-                DiveVector<char> buf(block_info.m_data_size);
-                capture_file.Read(buf.data(), block_info.m_data_size);
+                capture_file.Skip(block_info.m_data_size);
                 break;
-            }
             case RD_GPU_ID:
             {
                 DIVE_ASSERT(block_info.m_data_size == 4);
@@ -965,9 +1413,18 @@ CaptureData::LoadResult Pm4CaptureData::LoadAdrenoRdFile(FileReader& capture_fil
         }
     }
     m_memory.Finalize(true, true);
+    ReportMemoryDeduplication();
     return LoadResult::kSuccess;
 }
 
+//--------------------------------------------------------------------------------------------------
+void Pm4CaptureData::SetDecompressionCacheDirectory(const std::string& cache_dir,
+                                                    uint64_t max_size)
+{
+    m_decompression_cache_dir = cache_dir;
+    m_decompression_cache_max_size = max_size;
+}
+
 //--------------------------------------------------------------------------------------------------
 CaptureDataHeader::CaptureType Pm4CaptureData::GetCaptureType() const { return m_capture_type; }
 
@@ -1122,12 +1579,10 @@ bool Pm4CaptureData::LoadMemoryBlock(std::istream& capture_file)
         return false;
 
     if (memory_raw_data_header.m_size_in_bytes > kMaxMemAllocSize) return false;
-    MemoryData raw_memory;
-    raw_memory.m_data_size = memory_raw_data_header.m_size_in_bytes;
-    raw_memory.m_data_ptr = new uint8_t[raw_memory.m_data_size];
+    MemoryData raw_memory = m_memory.AllocateMemoryData(memory_raw_data_header.m_size_in_bytes);
     if (!capture_file.read((char*)raw_memory.m_data_ptr, memory_raw_data_header.m_size_in_bytes))
     {
-        delete[] raw_memory.m_data_ptr;
+        m_memory.FreeMemoryData(std::move(raw_memory));
         return false;
     }
 
@@ -1299,17 +1754,26 @@ bool Pm4CaptureData::LoadGpuAddressAndSize(FileReader& capture_file, uint32_t bl
 bool Pm4CaptureData::LoadMemoryBlockAdreno(FileReader& capture_file, uint64_t gpu_addr,
                                            uint32_t size)
 {
-    MemoryData raw_memory;
-    raw_memory.m_data_size = size;
-    raw_memory.m_data_ptr = new uint8_t[raw_memory.m_data_size];
+    // Unlike with Dive, all memory blocks for a submit come *before* the submit
+    uint32_t submit_index = (uint32_t)(m_submits.size());
+
+    // If the file is mapped, point straight into it instead of copying the block
+    if (capture_file.GetMappedFile() != nullptr)
+    {
+        uint64_t offset = capture_file.GetMappedOffset();
+        if (!capture_file.Skip(size)) return false;
+        m_memory.AddMappedMemoryBlock(submit_index, gpu_addr, size, capture_file.GetMappedFile(),
+                                      offset);
+        return true;
+    }
+
+    MemoryData raw_memory = m_memory.AllocateMemoryData(size);
     if (!capture_file.Read((char*)raw_memory.m_data_ptr, size))
     {
-        delete[] raw_memory.m_data_ptr;
+        m_memory.FreeMemoryData(std::move(raw_memory));
         return false;
     }
 
-    // Unlike with Dive, all memory blocks for a submit come *before* the submit
-    uint32_t submit_index = (uint32_t)(m_submits.size());
     m_memory.AddMemoryBlock(submit_index, gpu_addr, std::move(raw_memory));
     return true;
 }
@@ -1365,6 +1829,21 @@ void Pm4CaptureData::Finalize(const CaptureDataHeader& data_header)
     // the reset is only done for certain capture modes.
     bool same_submit_copy_only = data_header.m_reset_memory_tracker;
     m_memory.Finalize(same_submit_copy_only, duplicate_ib_capture);
+    ReportMemoryDeduplication();
+}
+
+//--------------------------------------------------------------------------------------------------
+void Pm4CaptureData::ReportMemoryDeduplication() const
+{
+    uint64_t added_size = m_memory.GetAddedDataSize();
+    if (m_progress_tracker == nullptr || added_size == 0) return;
+
+    uint64_t stored_size = m_memory.GetStoredDataSize();
+    std::ostringstream message;
+    message << "Memory blocks: " << (stored_size >> 10) << " KB stored for "
+            << (added_size >> 10) << " KB captured ("
+            << (100 * (added_size - stored_size) / added_size) << "% shared)";
+    m_progress_tracker->sendMessage(message.str());
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -19,6 +19,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "common.h"
 #include "dive_core/capture_data.h"
@@ -69,6 +70,82 @@ class MemoryAllocationInfo
     DiveVector<MemoryAllocationData> m_global_allocs;
 };
 
+//--------------------------------------------------------------------------------------------------
+// A whole file mapped read-only into memory. Writing through the mapping faults, so the data must
+// be copied before it is modified
+class MappedFile
+{
+ public:
+    ~MappedFile();
+
+    // Returns nullptr if the file could not be mapped (e.g. it is empty, or does not fit in the
+    // address space), in which case it should be read through a FileReader instead
+    static std::shared_ptr<MappedFile> Open(const char* file_name);
+
+    const uint8_t* GetData() const { return m_data; }
+    uint64_t GetSize() const { return m_size; }
+    bool Contains(const uint8_t* ptr) const { return ptr >= m_data && ptr < m_data + m_size; }
+
+ private:
+    MappedFile(const uint8_t* data, uint64_t size);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* m_data;
+    uint64_t m_size;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Bump allocator for data that lives as long as the capture. Allocations are carved out of large
+// chunks, and are only freed all at once, when the arena is reset or destroyed
+class MemoryArena
+{
+ public:
+    MemoryArena() = default;
+    MemoryArena(MemoryArena&& other) noexcept;
+    MemoryArena& operator=(MemoryArena&& other) noexcept;
+    ~MemoryArena() { Reset(); }
+
+    // The returned memory is uninitialized, and aligned to 8 bytes
+    uint8_t* Allocate(uint64_t size);
+
+    // Give back the most recent allocation, so the space can be reused by the next one. Does
+    // nothing if ptr is not the most recent allocation
+    void FreeLast(const uint8_t* ptr, uint64_t size);
+
+    // Whether [ptr, ptr + size) is the most recent allocation
+    bool IsLast(const uint8_t* ptr, uint64_t size) const;
+
+    // Free all allocations at once
+    void Reset();
+
+    // Total size of the chunks allocated so far
+    uint64_t GetReservedSize() const { return m_reserved_size; }
+
+    // Total size of the chunks handed out so far, including alignment padding
+    uint64_t GetUsedSize() const;
+
+ private:
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    struct Chunk
+    {
+        uint8_t* m_data;
+        uint64_t m_size;
+        uint64_t m_used;
+    };
+
+    // Allocations are always from the last chunk. The chunk size doubles up to the maximum, so
+    // small captures do not reserve more than needed
+    static constexpr uint64_t kMinChunkSize = 1 << 20;
+    static constexpr uint64_t kMaxChunkSize = 64 << 20;
+
+    DiveVector<Chunk> m_chunks;
+    uint64_t m_next_chunk_size = kMinChunkSize;
+    uint64_t m_reserved_size = 0;
+};
+
 //--------------------------------------------------------------------------------------------------
 // Container for the memory data of a memory block
 struct MemoryData
@@ -84,12 +161,31 @@ struct MemoryData
 class MemoryManager : public IMemoryManager
 {
  public:
-    virtual ~MemoryManager();
+    MemoryManager() = default;
+    MemoryManager(MemoryManager&&) = default;
+    MemoryManager& operator=(MemoryManager&&) = default;
+
+    // Allocate the data for a memory block. All of it is owned by the MemoryManager, and freed in
+    // one go when the MemoryManager is destroyed
+    MemoryData AllocateMemoryData(uint32_t size);
+
+    // Free data from AllocateMemoryData() that is not going to be added after all, e.g. because it
+    // could not be read. Only possible before any more data is allocated
+    void FreeMemoryData(MemoryData&& data);
 
     // Use an r-value reference instead of normal reference to prevent an extra copy
     // Given the amount of memory potentially in a capture, this can be significant
+    // The data must come from the last AllocateMemoryData() call (asserted), since freeing a
+    // duplicate is only possible for the most recent arena allocation. If the exact same data has
+    // already been added, for this or another submit, the new copy is freed and the block shares
+    // the existing one instead
     void AddMemoryBlock(uint32_t submit_index, uint64_t va_addr, MemoryData&& data);
 
+    // Add a memory block that points into mapped_file at the given offset, rather than owning a
+    // copy of the data. The mapping is kept alive for as long as the MemoryManager is
+    void AddMappedMemoryBlock(uint32_t submit_index, uint64_t va_addr, uint32_t size,
+                              const std::shared_ptr<MappedFile>& mapped_file, uint64_t offset);
+
     // Add memory allocation info to internal MemoryAllocationInfo object
     void AddMemoryAllocations(uint32_t submit_index, MemoryAllocationsDataHeader::Type type,
                               DiveVector<MemoryAllocationData>&& allocations);
@@ -102,6 +198,12 @@ class MemoryManager : public IMemoryManager
 
     const MemoryAllocationInfo& GetMemoryAllocationInfo() const;
 
+    // Total size of the data passed to AddMemoryBlock(), and how much of it is actually stored
+    // once identical data is shared between blocks, and (after Finalize()) superseded blocks are
+    // dropped
+    uint64_t GetAddedDataSize() const { return m_added_data_size; }
+    uint64_t GetStoredDataSize() const { return m_stored_data_size; }
+
     // Load the given va/size from the memory blocks
     virtual bool RetrieveMemoryData(void* buffer_ptr, uint32_t submit_index, uint64_t va_addr,
                                     uint64_t size) const override;
@@ -123,18 +225,62 @@ class MemoryManager : public IMemoryManager
         uint64_t m_va_addr;
         uint32_t m_submit_index;
         uint32_t m_data_size;
-        uint8_t* m_data_ptr;
+        const uint8_t* m_data_ptr;
     };
 
+    // Half-open range [m_begin, m_end) of indices into m_memory_blocks
+    struct BlockRange
+    {
+        uint32_t m_begin;
+        uint32_t m_end;
+    };
+
+    // Move the data of the remaining blocks into a new arena, if a significant part of m_arena is
+    // taken up by data of blocks that were dropped. Called from Finalize()
+    void CompactArena();
+
+    // Build the lookup index over the (sorted) m_memory_blocks. Called from Finalize()
+    void BuildBlockIndex();
+
+    // Range of blocks that are candidates for the given submit. All blocks if !m_same_submit_only
+    BlockRange GetBlockRange(uint32_t submit_index) const;
+
+    // Narrow the given range down to the blocks that can overlap [va_addr, end_addr)
+    BlockRange FindOverlappingBlocks(BlockRange range, uint64_t va_addr, uint64_t end_addr) const;
+
+    // Index of the first block (in sorted order) within range that contains va_addr, or range.m_end
+    uint32_t FindFirstContainingBlock(BlockRange range, uint64_t va_addr) const;
+
     // mutable variable for caching reasons
     mutable const MemoryBlock* m_last_used_block_ptr = nullptr;
 
     // Memory blocks containing all the captured memory data
     DiveVector<MemoryBlock> m_memory_blocks;
 
+    // Per-submit range of m_memory_blocks, indexed by submit index. Only used if m_same_submit_only
+    DiveVector<BlockRange> m_submit_block_ranges;
+
+    // Running maximum of the block end address, restarting at the beginning of each BlockRange.
+    // Since blocks are sorted by start address but can overlap, this allows binary searching for
+    // the first block that can possibly overlap a given address
+    DiveVector<uint64_t> m_max_end_addrs;
+
     // All the captured memory allocation info
     MemoryAllocationInfo m_memory_allocations;
 
+    // Backs the data of all memory blocks, except for those that point into m_mapped_file
+    MemoryArena m_arena;
+
+    // File that mapped memory blocks point into, if any
+    std::shared_ptr<MappedFile> m_mapped_file;
+
+    // Data added via AddMemoryBlock(), by hash of its contents. Only used while loading, to find
+    // identical data, and cleared by Finalize()
+    std::unordered_multimap<uint64_t, MemoryData> m_data_by_hash;
+
+    uint64_t m_added_data_size = 0;
+    uint64_t m_stored_data_size = 0;
+
     // If set, then only memory blocks from same submit are considered
     // Otherwise, all previous submits are considered as well
     bool m_same_submit_only = true;
@@ -291,17 +437,28 @@ class RegisterInfo
 };
 
 //--------------------------------------------------------------------------------------------------
+// Reads a possibly compressed file. An uncompressed file is mapped into memory rather than
+// streamed, so that its contents can be referenced in place (see GetMappedFile())
 class FileReader
 {
  public:
     FileReader(const char* file_name);
     int Open();
     int64_t Read(char* buf, int64_t size);
+    bool Skip(int64_t size);
     int Close();
 
+    // Only set if the file is uncompressed, and was successfully mapped
+    const std::shared_ptr<MappedFile>& GetMappedFile() const { return m_mapped_file; }
+
+    // Offset into the mapped file of the next byte to be read
+    uint64_t GetMappedOffset() const { return m_mapped_offset; }
+
  private:
     std::string m_file_name;
     std::unique_ptr<struct archive, decltype(&archive_read_free)> m_handle;
+    std::shared_ptr<MappedFile> m_mapped_file;
+    uint64_t m_mapped_offset = 0;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -333,6 +490,15 @@ class Pm4CaptureData : public CaptureData
     LoadResult LoadCaptureFileStream(std::istream& capture_file);
     LoadResult LoadAdrenoRdFile(FileReader& capture_file);
 
+    // Compressed .rd files are normally streamed, with every memory block copied into memory. If
+    // a cache directory is set, they are instead decompressed into it once, and the decompressed
+    // file is mapped into memory on this and later loads, like an uncompressed .rd file is.
+    // Whenever a capture is decompressed, the least recently loaded ones are deleted from the
+    // directory until it is back under max_size
+    static constexpr uint64_t kDefaultDecompressionCacheSize = uint64_t(8) << 30;  // 8 GiB
+    void SetDecompressionCacheDirectory(const std::string& cache_dir,
+                                        uint64_t max_size = kDefaultDecompressionCacheSize);
+
     bool HasPm4Data() const { return m_submits.size() > 0; }
     std::string GetFileFormatVersion() const;
 
@@ -358,6 +524,9 @@ class Pm4CaptureData : public CaptureData
 
     void Finalize(const CaptureDataHeader& data_header);
 
+    // Lets the progress tracker know how much memory block data was shared between blocks
+    void ReportMemoryDeduplication() const;
+
     CaptureDataHeader::CaptureType m_capture_type;
     DiveVector<SubmitInfo> m_submits;
     DiveVector<PresentInfo> m_presents;  // More than 1 if multi-frame capture
@@ -368,6 +537,8 @@ class Pm4CaptureData : public CaptureData
     MemoryManager m_memory;
     ProgressTracker* m_progress_tracker;
     std::string m_cur_capture_file;
+    std::string m_decompression_cache_dir;
+    uint64_t m_decompression_cache_max_size = kDefaultDecompressionCacheSize;
     CaptureDataHeader m_data_header;
 };
 
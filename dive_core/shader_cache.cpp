@@ -0,0 +1,377 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "shader_cache.h"
+
+#include <string.h>  // memcmp, memcpy
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+#include "absl/strings/str_format.h"
+#include "dive_core/cache_directory.h"
+#include "dive_core/task_scheduler.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+constexpr char kCacheMagic[8] = { 'D', 'I', 'V', 'E', 'S', 'H', 'D', '\0' };
+
+// Bump whenever anything written to the cache files changes
+constexpr uint32_t kCacheVersion = 1;
+
+constexpr char kDataExtension[] = ".data";
+constexpr char kTextExtension[] = ".text";
+
+struct CacheFileHeader
+{
+    char m_magic[8];
+    uint32_t m_version;
+    uint32_t m_gpu_id;
+    uint64_t m_hash;
+    uint32_t m_size;
+    uint32_t m_reserved;
+};
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void AppendValue(std::string& contents, const T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    contents.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void AppendArray(std::string& contents, const std::vector<T>& array)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    AppendValue<uint64_t>(contents, array.size());
+    contents.append(reinterpret_cast<const char*>(array.data()), array.size() * sizeof(T));
+}
+
+//--------------------------------------------------------------------------------------------------
+std::string CreateFileContents(const ShaderCache::Key& key)
+{
+    CacheFileHeader header = {};
+    memcpy(header.m_magic, kCacheMagic, sizeof(kCacheMagic));
+    header.m_version = kCacheVersion;
+    header.m_gpu_id = key.m_gpu_id;
+    header.m_hash = key.m_hash;
+    header.m_size = key.m_size;
+    std::string contents;
+    AppendValue(contents, header);
+    return contents;
+}
+
+//--------------------------------------------------------------------------------------------------
+// The file is written under a temporary name first, so other processes never see a partially
+// written one. Failing to write it only means that the shader is disassembled again next time
+void WriteCacheFile(const std::string& file_name, const std::string& contents)
+{
+    std::string temp_file_name = absl::StrFormat(
+        "%s.%x.tmp", file_name, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream file(temp_file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), contents.size());
+        if (!file.good())
+        {
+            file.close();
+            std::filesystem::remove(temp_file_name);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_file_name, file_name, error);
+    if (error)
+    {
+        std::filesystem::remove(temp_file_name, error);
+    }
+}
+
+// =================================================================================================
+// CacheFileReader
+// =================================================================================================
+// Every read is bounds checked, and once one fails, all later ones do too, so the result only
+// needs to be checked at the end
+class CacheFileReader
+{
+ public:
+    // Reads the whole file, and checks that it is a cache file for key
+    CacheFileReader(const std::string& file_name, const ShaderCache::Key& key)
+    {
+        std::ifstream file(file_name, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            m_ok = false;
+            return;
+        }
+        m_contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        CacheFileHeader header = ReadValue<CacheFileHeader>();
+        m_ok = m_ok && !file.bad() &&
+               memcmp(header.m_magic, kCacheMagic, sizeof(kCacheMagic)) == 0 &&
+               header.m_version == kCacheVersion && header.m_gpu_id == key.m_gpu_id &&
+               header.m_hash == key.m_hash && header.m_size == key.m_size;
+    }
+
+    // Whether all reads succeeded, and the whole file was read
+    bool IsOk() const { return m_ok && m_offset == m_contents.size(); }
+
+    const char* Read(uint64_t size)
+    {
+        if (!m_ok || size > m_contents.size() - m_offset)
+        {
+            m_ok = false;
+            return nullptr;
+        }
+        const char* ptr = m_contents.data() + m_offset;
+        m_offset += size;
+        return ptr;
+    }
+
+    template <typename T>
+    T ReadValue()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value = {};
+        const char* ptr = Read(sizeof(T));
+        if (ptr != nullptr) memcpy(&value, ptr, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void ReadArray(std::vector<T>& array)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        uint64_t count = ReadValue<uint64_t>();
+        if (!m_ok || count > (m_contents.size() - m_offset) / sizeof(T))
+        {
+            m_ok = false;
+            return;
+        }
+        array.resize(count);
+        memcpy(array.data(), Read(count * sizeof(T)), count * sizeof(T));
+    }
+
+ private:
+    std::string m_contents;
+    size_t m_offset = 0;
+    bool m_ok = true;
+};
+
+}  // namespace
+
+// =================================================================================================
+// ShaderCache
+// =================================================================================================
+bool ShaderCache::Key::operator<(const Key& other) const
+{
+    return std::tie(m_hash, m_size, m_gpu_id) <
+           std::tie(other.m_hash, other.m_size, other.m_gpu_id);
+}
+
+//--------------------------------------------------------------------------------------------------
+ShaderCache::ShaderCache() = default;
+
+//--------------------------------------------------------------------------------------------------
+ShaderCache::~ShaderCache() = default;
+
+//--------------------------------------------------------------------------------------------------
+ShaderCache::Key ShaderCache::CreateKey(const void* code, uint32_t size, uint32_t gpu_id)
+{
+    // FNV-1a, so that the keys of the files written by other builds stay the same
+    const uint8_t* bytes = static_cast<const uint8_t*>(code);
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+
+    Key key;
+    key.m_hash = hash;
+    key.m_size = size;
+    key.m_gpu_id = gpu_id;
+    return key;
+}
+
+//--------------------------------------------------------------------------------------------------
+void ShaderCache::SetDirectory(const std::string& dir, uint64_t max_size)
+{
+    std::error_code error;
+    std::filesystem::create_directories(dir, error);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_dir = dir;
+    }
+
+    // Walking the directory can take a while, eg. on start-up with a cold disk cache. Lookups can
+    // go on meanwhile: at worst, a file that is found is deleted afterwards, as if by another
+    // process
+    m_prune_group = std::make_unique<TaskGroup>();
+    m_prune_group->Run([dir, max_size]() { PruneCacheDirectory(dir, max_size); });
+}
+
+//--------------------------------------------------------------------------------------------------
+std::string ShaderCache::GetFileName(const Key& key, const char* extension) const
+{
+    std::filesystem::path path(m_dir);
+    path /= absl::StrFormat("%016x-%x-%u%s", key.m_hash, key.m_size, key.m_gpu_id, extension);
+    return path.string();
+}
+
+//--------------------------------------------------------------------------------------------------
+std::shared_ptr<const DisassembledData> ShaderCache::FindData(const Key& key, const void* code)
+{
+    auto matches = [&key, code](const DisassembledData& data) {
+        const std::vector<uint64_t>& instructions = data.m_instructions_raw;
+        return instructions.size() * sizeof(uint64_t) <= key.m_size &&
+               memcmp(instructions.data(), code, instructions.size() * sizeof(uint64_t)) == 0;
+    };
+
+    std::string file_name;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_data.find(key);
+        if (it != m_data.end() && matches(*it->second))
+        {
+            ++m_hit_count;
+            return it->second;
+        }
+        if (it != m_data.end() || m_dir.empty())
+        {
+            ++m_miss_count;
+            return nullptr;
+        }
+        file_name = GetFileName(key, kDataExtension);
+    }
+
+    auto data = std::make_shared<DisassembledData>();
+    CacheFileReader reader(file_name, key);
+    data->m_gpr_count = reader.ReadValue<uint32_t>();
+    reader.ReadValue<uint32_t>();
+    reader.ReadArray(data->m_instructions_raw);
+    if (!reader.IsOk() || !matches(*data))
+    {
+        ++m_miss_count;
+        return nullptr;
+    }
+    TouchCacheFile(file_name);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_hit_count;
+    return m_data.try_emplace(key, std::move(data)).first->second;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::shared_ptr<const DisassembledText> ShaderCache::FindText(const Key& key,
+                                                              size_t num_instructions)
+{
+    // A corrupt file could otherwise have offsets past the end of the listing
+    auto matches = [num_instructions](const DisassembledText& text) {
+        const std::vector<size_t>& offsets = text.m_instruction_offsets;
+        return offsets.size() == num_instructions + 1 &&
+               std::is_sorted(offsets.begin(), offsets.end()) &&
+               offsets.back() <= text.m_listing.size();
+    };
+
+    std::string file_name;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_text.find(key);
+        if (it != m_text.end() && matches(*it->second))
+        {
+            ++m_hit_count;
+            return it->second;
+        }
+        if (it != m_text.end() || m_dir.empty())
+        {
+            ++m_miss_count;
+            return nullptr;
+        }
+        file_name = GetFileName(key, kTextExtension);
+    }
+
+    auto text = std::make_shared<DisassembledText>();
+    CacheFileReader reader(file_name, key);
+    std::vector<char> listing;
+    std::vector<uint64_t> offsets;
+    reader.ReadArray(listing);
+    reader.ReadArray(offsets);
+    text->m_listing.assign(listing.begin(), listing.end());
+    text->m_instruction_offsets.assign(offsets.begin(), offsets.end());
+    if (!reader.IsOk() || !matches(*text))
+    {
+        ++m_miss_count;
+        return nullptr;
+    }
+    TouchCacheFile(file_name);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_hit_count;
+    return m_text.try_emplace(key, std::move(text)).first->second;
+}
+
+//--------------------------------------------------------------------------------------------------
+void ShaderCache::AddData(const Key& key, std::shared_ptr<const DisassembledData> data)
+{
+    std::string file_name;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_dir.empty()) file_name = GetFileName(key, kDataExtension);
+        m_data.insert_or_assign(key, data);
+    }
+
+    if (!file_name.empty())
+    {
+        std::string contents = CreateFileContents(key);
+        AppendValue<uint32_t>(contents, data->m_gpr_count);
+        AppendValue<uint32_t>(contents, 0);
+        AppendArray(contents, data->m_instructions_raw);
+        WriteCacheFile(file_name, contents);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void ShaderCache::AddText(const Key& key, std::shared_ptr<const DisassembledText> text)
+{
+    std::string file_name;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_dir.empty()) file_name = GetFileName(key, kTextExtension);
+        m_text.insert_or_assign(key, text);
+    }
+
+    if (!file_name.empty())
+    {
+        std::string contents = CreateFileContents(key);
+        AppendArray(contents, std::vector<char>(text->m_listing.begin(), text->m_listing.end()));
+        AppendArray(contents, std::vector<uint64_t>(text->m_instruction_offsets.begin(),
+                                                    text->m_instruction_offsets.end()));
+        WriteCacheFile(file_name, contents);
+    }
+}
+
+}  // namespace Dive
@@ -0,0 +1,112 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Dive
+{
+
+class TaskGroup;
+
+//--------------------------------------------------------------------------------------------------
+// Instructions and stats of a shader, see Disassembly
+struct DisassembledData
+{
+    std::vector<uint64_t> m_instructions_raw;
+    uint32_t m_gpr_count = 0;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Listing of a shader, see Disassembly
+struct DisassembledText
+{
+    std::string m_listing;
+    // Offsets of the text of each instruction in m_listing, followed by the end offset of the
+    // last one.
+    std::vector<size_t> m_instruction_offsets;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Disassembly results keyed by the bytes of the shaders rather than by their address, so that the
+// same shader binary is only disassembled once, whichever address or submit it is used from. The
+// cache lives as long as the DataCore, so it is shared by the captures loaded one after the other.
+// If it has a directory, the results are also written there, one file per shader binary, and read
+// back by later sessions (eg. reopening a capture, or a capture of the same app).
+// All the methods are thread safe
+class ShaderCache
+{
+ public:
+    struct Key
+    {
+        // Hash of the first m_size bytes of the shader, which have to cover all of its instructions
+        uint64_t m_hash = 0;
+        uint32_t m_size = 0;
+        uint32_t m_gpu_id = 0;
+
+        bool operator<(const Key& other) const;
+    };
+
+    ShaderCache();
+    ~ShaderCache();
+
+    static Key CreateKey(const void* code, uint32_t size, uint32_t gpu_id);
+
+    // Also look up and store the results in this directory, which is created if needed. There are
+    // two files per shader, so the least recently used ones are deleted from it until it is back
+    // under max_size. That runs in the background, and is waited for by the destructor. Files found
+    // by later lookups are marked as used
+    static constexpr uint64_t kDefaultMaxDirectorySize = uint64_t(256) << 20;  // 256 MiB
+    void SetDirectory(const std::string& dir, uint64_t max_size = kDefaultMaxDirectorySize);
+
+    // Returns nullptr if there is no data for the key. The instructions of the data are checked
+    // against code (the bytes the key was created from), so a hash collision is only a miss
+    std::shared_ptr<const DisassembledData> FindData(const Key& key, const void* code);
+    // Returns nullptr if there is no text for the key, or if its offsets do not cover
+    // num_instructions instructions of its listing
+    std::shared_ptr<const DisassembledText> FindText(const Key& key, size_t num_instructions);
+
+    // The instructions of data have to fit in the bytes the key was created from
+    void AddData(const Key& key, std::shared_ptr<const DisassembledData> data);
+    void AddText(const Key& key, std::shared_ptr<const DisassembledText> text);
+
+    // Number of Find*() calls that did and did not find any results
+    uint64_t GetHitCount() const { return m_hit_count; }
+    uint64_t GetMissCount() const { return m_miss_count; }
+
+ private:
+    std::string GetFileName(const Key& key, const char* extension) const;
+
+    std::mutex m_mutex;
+    std::string m_dir;
+    std::map<Key, std::shared_ptr<const DisassembledData>> m_data;
+    std::map<Key, std::shared_ptr<const DisassembledText>> m_text;
+
+    std::atomic<uint64_t> m_hit_count = 0;
+    std::atomic<uint64_t> m_miss_count = 0;
+
+    // Prunes the directory. Last, so that it is waited for before the rest is destroyed
+    std::unique_ptr<TaskGroup> m_prune_group;
+};
+
+}  // namespace Dive
@@ -46,9 +46,94 @@ bool Disassemble(const uint8_t* shader_memory, uint64_t shader_address, size_t s
     return false;
 }
 
+namespace
+{
+
+//--------------------------------------------------------------------------------------------------
+// Keeps the raw dwords of each instruction reported by disasm_a3xx_stat_with_cb.
+void CollectInstruction(void* cb_data, unsigned n, const uint32_t* dwords)
+{
+    auto* instructions_raw = static_cast<std::vector<uint64_t>*>(cb_data);
+    if (dwords == nullptr)
+    {
+        return;
+    }
+    if (n >= instructions_raw->size())
+    {
+        instructions_raw->resize(n + 1);
+    }
+    (*instructions_raw)[n] = (static_cast<uint64_t>(dwords[1]) << 32) | dwords[0];
+}
+
+//--------------------------------------------------------------------------------------------------
+// Number of dwords of the shader at the start of code, going by where the disassembler stops: after
+// the "end" instruction and the nops that follow it, or after a "chsh". Only the opcodes are looked
+// at, so this is a guess, which Disassemble() checks before caching the results under these bytes.
+size_t FindShaderSize(const uint32_t* code, size_t code_size)
+{
+    // Opcodes of cat0 instructions without sources (bits 55-58), see ir3-cat0.xml. These also
+    // have the category (bits 61-63), the low bit of the high opcode (bit 49), and the
+    // unused source and branch type bits (34-39, 45-47 and 52-54) set to 0
+    constexpr uint64_t kCat0NoSrcMask = (7ull << 61) | (1ull << 49) | (0x3full << 34) |
+                                        (7ull << 45) | (7ull << 52);
+    constexpr uint32_t kOpcNop = 0;
+    constexpr uint32_t kOpcEnd = 6;
+    constexpr uint32_t kOpcChsh = 10;
+
+    bool has_end = false;
+    int nop_count = 0;
+    size_t size = 0;
+    while (size + 2 <= code_size)
+    {
+        uint64_t instr = (static_cast<uint64_t>(code[size + 1]) << 32) | code[size];
+        size += 2;
+        bool is_cat0 = (instr & kCat0NoSrcMask) == 0;
+        uint32_t opc = (instr >> 55) & 0xf;
+        if (is_cat0 && opc == kOpcNop)
+        {
+            // Same as disasm_field_cb(): there can be an epilogue after the "end"
+            if (has_end && ++nop_count > 3) break;
+            continue;
+        }
+        nop_count = 0;
+        if (is_cat0 && opc == kOpcEnd)
+        {
+            has_end = true;
+        }
+        else if (is_cat0 && opc == kOpcChsh)
+        {
+            break;
+        }
+    }
+    return size;
+}
+
+// Offsets in the disassembler output where the text of each instruction starts.
+struct InstructionTextOffsets
+{
+    FILE* file = nullptr;
+    std::vector<size_t> offsets;
+};
+
+//--------------------------------------------------------------------------------------------------
+void CollectInstructionTextOffset(void* cb_data, unsigned n, const uint32_t* dwords)
+{
+    auto* text_offsets = static_cast<InstructionTextOffsets*>(cb_data);
+    // The extra lines of an instruction (eg. branch labels) are part of its text, so only its first
+    // line starts it. The last call, past the last instruction, gives the end of the text.
+    if (n < text_offsets->offsets.size())
+    {
+        return;
+    }
+    long offset = ftell(text_offsets->file);
+    DIVE_ASSERT(offset >= 0);
+    text_offsets->offsets.resize(n + 1, static_cast<size_t>(offset));
+}
+
 //--------------------------------------------------------------------------------------------------
-std::string DisassembleA3XX(const uint8_t* data, size_t max_size, struct shader_stats* stats,
-                            enum debug_t debug)
+// Returns the listing of the code, with the stats, and the offsets of the text of each instruction
+// in it.
+std::string DisassembleA3XX(uint32_t* code, size_t code_size, InstructionTextOffsets* text_offsets)
 {
 #ifdef _MSC_VER
     FILE* disasm_file = NULL;
@@ -64,10 +149,12 @@ std::string DisassembleA3XX(const uint8_t* data, size_t max_size, struct shader_
     FILE* disasm_file = open_memstream(&disasm_buf, &disasm_buf_size);
 #endif
 
-    size_t code_size = max_size / sizeof(uint32_t);
-    int res = disasm_a3xx_stat_with_debug(reinterpret_cast<uint32_t*>(const_cast<uint8_t*>(data)),
-                                          static_cast<int>(code_size), 0, disasm_file, GetGPUID(),
-                                          stats, debug);
+    struct shader_stats stats;
+    text_offsets->file = disasm_file;
+    int res = disasm_a3xx_stat_with_cb(code, static_cast<int>(code_size), 0, disasm_file,
+                                       GetGPUID(), &stats, PRINT_STATS,
+                                       &CollectInstructionTextOffset, text_offsets);
+    text_offsets->file = nullptr;
     ((void)(res));  // avoid unused variable
     DIVE_ASSERT(res != -1);
 #ifdef _MSC_VER
@@ -83,84 +170,136 @@ std::string DisassembleA3XX(const uint8_t* data, size_t max_size, struct shader_
     return disasm_output;
 #else
     fflush(disasm_file);
-    disasm_buf[disasm_buf_size] = '\0';
-    std::string disasm(disasm_buf);
+    std::string disasm(disasm_buf, disasm_buf_size);
     fclose(disasm_file);
     free(disasm_buf);
     return disasm;
 #endif
 }
 
+}  // namespace
+
 //--------------------------------------------------------------------------------------------------
 Disassembly::Disassembly(const IMemoryManager& mem_manager, uint32_t submit_index, uint64_t address,
-                         ILog* log)
-    : m_mem_manager(mem_manager), m_submit_index(submit_index), m_address(address), m_log(log)
+                         ILog* log, ShaderCache* shader_cache)
+    : m_mem_manager(mem_manager),
+      m_submit_index(submit_index),
+      m_address(address),
+      m_log(log),
+      m_shader_cache(shader_cache)
 {
     ((void)(m_log));  // avoid unused variable
 }
 
+//--------------------------------------------------------------------------------------------------
+std::string_view Disassembly::GetInstructionText(uint32_t index) const
+{
+    const DisassembledText& text = GetText();
+    if (index + 1 >= text.m_instruction_offsets.size())
+    {
+        return {};
+    }
+    size_t begin = text.m_instruction_offsets[index];
+    size_t end = text.m_instruction_offsets[index + 1];
+    std::string_view instr = std::string_view(text.m_listing).substr(begin, end - begin);
+    size_t first = instr.find_first_not_of(" \t");
+    instr.remove_prefix(first == std::string_view::npos ? instr.size() : first);
+    if (!instr.empty() && instr.back() == '\n')
+    {
+        instr.remove_suffix(1);
+    }
+    return instr;
+}
+
 //--------------------------------------------------------------------------------------------------
 void Disassembly::Disassemble() const
 {
     std::call_once(m_disassembled_flag, [&]() {
-        DisassembledData disassembled_data;
         uint64_t max_size = m_mem_manager.GetMaxContiguousSize(m_submit_index, m_address);
 
         // The disassembler does not early-out when it encounters an "end" instruction (at least not
         // in its "prepass"), so passing it a too-big max_size can make the disassembly very slow!
         // Let's set an arbitrary limit for now. The "correct" fix would be for the disassembler to
-        // early-out.
+        // early-out. Without text there is no prepass, and DisassembleText() only passes the
+        // instructions found here.
         uint64_t kMaxSizeLimit = 64 * 1024;
         if (max_size > kMaxSizeLimit) max_size = kMaxSizeLimit;
 
-        uint8_t* data_ptr = new uint8_t[max_size];
-        DIVE_VERIFY(
-            m_mem_manager.RetrieveMemoryData(data_ptr, m_submit_index, m_address, max_size));
+        // Reused by the shaders disassembled on the same thread.
+        thread_local std::vector<uint32_t> code;
+        code.resize(max_size / sizeof(uint32_t));
+        DIVE_VERIFY(m_mem_manager.RetrieveMemoryData(code.data(), m_submit_index, m_address,
+                                                     code.size() * sizeof(uint32_t)));
 
-        struct shader_stats stats;
-        std::string disasm = DisassembleA3XX(data_ptr, max_size, &stats, PRINT_RAW);
-        std::istringstream disasm_istr(disasm);
-        unsigned opc_cat = 0;
-        unsigned n = 0;
-        unsigned cycles = 0;
-        uint32_t dword0 = 0, dword1 = 0;
-        int prefix_len = 0;
-        for (std::string line; std::getline(disasm_istr, line);)
+        // The key only covers the shader, not whatever follows it in memory, so that the same
+        // shader at another address or in another capture has the same key
+        size_t shader_size = 0;
+        if (m_shader_cache != nullptr)
         {
-            prefix_len = static_cast<int>(line.length());
-#ifdef _MSC_VER
-            sscanf_s(line.c_str(), " :%d:%04d:%04d[%08xx_%08xx] %n", &opc_cat, &n, &cycles, &dword1,
-                     &dword0, &prefix_len);
-#else
-            sscanf(line.c_str(),
-                   " :%d:%04d:%04d[%08xx_%08xx] %n",
-                   &opc_cat,
-                   &n,
-                   &cycles,
-                   &dword1,
-                   &dword0,
-                   &prefix_len);
-#endif
-            DIVE_ASSERT(0 <= prefix_len && prefix_len <= line.length());
-            std::string_view instr = std::string_view(line).substr(prefix_len);
-            if (n >= disassembled_data.m_instructions_text.size())
+            shader_size = FindShaderSize(code.data(), code.size());
+            auto shader_bytes = static_cast<uint32_t>(shader_size * sizeof(uint32_t));
+            m_cache_key = ShaderCache::CreateKey(code.data(), shader_bytes, GetGPUID());
+            m_disassembled_data = m_shader_cache->FindData(m_cache_key, code.data());
+            if (m_disassembled_data != nullptr)
             {
-                disassembled_data.m_instructions_text.resize(n + 1);
-                disassembled_data.m_instructions_raw.resize(n + 1);
+                m_cacheable = true;
+                return;
             }
-            if (disassembled_data.m_instructions_text[n].size() > 0)
+        }
+
+        auto data = std::make_shared<DisassembledData>();
+        struct shader_stats stats;
+        int res = disasm_a3xx_stat_with_cb(code.data(), static_cast<int>(code.size()), 0, nullptr,
+                                           GetGPUID(), &stats, static_cast<debug_t>(0),
+                                           &CollectInstruction, &data->m_instructions_raw);
+        ((void)(res));  // avoid unused variable
+        DIVE_ASSERT(res != -1);
+        data->m_gpr_count = (stats.fullreg + 3) / 4;
+        m_disassembled_data = data;
+
+        // Should the disassembler have gone past the guessed end of the shader, the results depend
+        // on bytes that the key does not cover
+        if (m_shader_cache != nullptr && !data->m_instructions_raw.empty() &&
+            data->m_instructions_raw.size() * 2 <= shader_size)
+        {
+            m_cacheable = true;
+            m_shader_cache->AddData(m_cache_key, data);
+        }
+    });
+}
+
+//--------------------------------------------------------------------------------------------------
+void Disassembly::DisassembleText() const
+{
+    std::call_once(m_disassembled_text_flag, [&]() {
+        const std::vector<uint64_t>& instructions_raw = GetData().m_instructions_raw;
+        if (m_cacheable)
+        {
+            m_disassembled_text = m_shader_cache->FindText(m_cache_key, instructions_raw.size());
+            if (m_disassembled_text != nullptr)
             {
-                disassembled_data.m_instructions_text[n] += "\n";
+                return;
             }
-            disassembled_data.m_instructions_text[n] += instr;
+        }
 
-            disassembled_data.m_instructions_raw[n] =
-                (static_cast<uint64_t>(dword1) << 32) | dword0;
+        std::vector<uint32_t> code;
+        code.reserve(instructions_raw.size() * 2);
+        for (uint64_t instruction : instructions_raw)
+        {
+            code.push_back(static_cast<uint32_t>(instruction));
+            code.push_back(static_cast<uint32_t>(instruction >> 32));
+        }
+
+        auto text = std::make_shared<DisassembledText>();
+        InstructionTextOffsets text_offsets;
+        text->m_listing = DisassembleA3XX(code.data(), code.size(), &text_offsets);
+        text->m_instruction_offsets = std::move(text_offsets.offsets);
+        m_disassembled_text = text;
+
+        if (m_cacheable)
+        {
+            m_shader_cache->AddText(m_cache_key, text);
         }
-        disassembled_data.m_gpr_count = (stats.fullreg + 3) / 4;
-        disassembled_data.m_listing = DisassembleA3XX(data_ptr, max_size, &stats, PRINT_STATS);
-        delete[] data_ptr;
-        m_disassembled_data = disassembled_data;
     });
 }
 
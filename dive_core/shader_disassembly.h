@@ -17,13 +17,16 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "dive_core/common/common.h"
 #include "log.h"
+#include "shader_cache.h"
 
 namespace Dive
 {
@@ -59,49 +62,55 @@ class ShaderInstruction
 class Disassembly
 {
  public:
+    // If shader_cache is set, the results are looked up there first, and added to it otherwise.
+    // It has to outlive the Disassembly
     Disassembly(const IMemoryManager& mem_manager, uint32_t submit_index, uint64_t address,
-                ILog* log = nullptr);
+                ILog* log = nullptr, ShaderCache* shader_cache = nullptr);
 
-    std::string GetListing() const { return GetData().m_listing; }
+    // The listing and the instruction texts are disassembled on first use. The other getters only
+    // need the instructions and stats, which are collected without formatting any text.
+    const std::string& GetListing() const { return GetText().m_listing; }
     uint64_t GetShaderAddr() const { return m_address; }
-    size_t GetNumInstructions() const { return GetData().m_instructions_text.size(); }
-    const std::string& GetInstructionText(uint32_t index) const
-    {
-        return GetData().m_instructions_text[index];
-    }
+    uint32_t GetSubmitIndex() const { return m_submit_index; }
+    size_t GetNumInstructions() const { return GetData().m_instructions_raw.size(); }
+    std::string_view GetInstructionText(uint32_t index) const;
     uint64_t GetInstructionRaw(uint32_t index) const { return GetData().m_instructions_raw[index]; }
-    uint64_t GetShaderSize() const
-    {
-        return sizeof(uint64_t) * GetData().m_instructions_text.size();
-    }
+    uint64_t GetShaderSize() const { return sizeof(uint64_t) * GetNumInstructions(); }
     uint32_t GetGPRCount() const { return GetData().m_gpr_count; }
 
+    // Collects the instructions and stats, not the text.
     void EagerEval() const { Disassemble(); }
 
  private:
-    struct DisassembledData
-    {
-        std::string m_listing;
-        std::vector<std::string> m_instructions_text;
-        std::vector<uint64_t> m_instructions_raw;
-        uint32_t m_gpr_count;
-    };
-
     void Disassemble() const;
+    void DisassembleText() const;
 
     const DisassembledData& GetData() const
     {
         Disassemble();
-        return m_disassembled_data;
+        return *m_disassembled_data;
+    }
+
+    const DisassembledText& GetText() const
+    {
+        DisassembleText();
+        return *m_disassembled_text;
     }
 
     [[maybe_unused]] const IMemoryManager& m_mem_manager;
     [[maybe_unused]] uint32_t m_submit_index;
     uint64_t m_address;
     [[maybe_unused]] ILog* m_log;
+    ShaderCache* m_shader_cache;
 
+    // Shaders with the same bytes share their results through the cache
     mutable std::once_flag m_disassembled_flag;
-    mutable DisassembledData m_disassembled_data;
+    mutable std::shared_ptr<const DisassembledData> m_disassembled_data;
+    mutable std::once_flag m_disassembled_text_flag;
+    mutable std::shared_ptr<const DisassembledText> m_disassembled_text;
+    // Whether the results can be cached under m_cache_key, see Disassemble()
+    mutable bool m_cacheable = false;
+    mutable ShaderCache::Key m_cache_key;
 };
 
 bool Disassemble(const uint8_t* shader_memory, uint64_t shader_address, size_t shader_size,
@@ -14,6 +14,7 @@
  limitations under the License.
 */
 #include <algorithm>
+#include <memory>
 
 #include "common/common.h"
 
@@ -43,7 +44,7 @@ Vector<Type>::Vector(const Vector& a) : m_buffer(nullptr), m_reserved(0)
     // And not all classes have default constructors
     reserve(a.m_size);
     m_size = a.m_size;
-    std::copy(a.m_buffer, a.m_buffer + a.m_size, m_buffer);
+    std::uninitialized_copy(a.m_buffer, a.m_buffer + a.m_size, m_buffer);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -63,7 +64,7 @@ Vector<Type>::Vector(std::initializer_list<Type> a) : m_buffer(nullptr), m_reser
 {
     reserve(a.size());
     m_size = a.size();
-    std::copy(a.begin(), a.end(), m_buffer);
+    std::uninitialized_copy(a.begin(), a.end(), m_buffer);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -89,9 +90,10 @@ Vector<Type>& Vector<Type>::operator=(const Vector<Type>& a)
     {
         // Do not call resize() directly, since it invokes default constructor
         // And not all classes have default constructors
+        clear();
         reserve(a.m_size);
         m_size = a.m_size;
-        std::copy(a.m_buffer, a.m_buffer + a.m_size, m_buffer);
+        std::uninitialized_copy(a.m_buffer, a.m_buffer + a.m_size, m_buffer);
     }
     return *this;
 }
@@ -102,6 +104,7 @@ Vector<Type>& Vector<Type>::operator=(Vector<Type>&& a)
 {
     if (&a != this)
     {
+        internal_clear();
         m_buffer = a.m_buffer;
         m_reserved = a.m_reserved;
         m_size = a.m_size;
@@ -14,9 +14,15 @@
  limitations under the License.
 */
 #pragma once
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <new>
+#include <type_traits>
+#include <vector>
 
 namespace Dive
 {
@@ -318,4 +324,228 @@ class StructOfArraysConstIterator : public StructOfArraysIterator<const Class, I
         return StructOfArraysConstIterator(left) >= right;
     }
 };
-}  // namespace Dive
\ No newline at end of file
+
+//--------------------------------------------------------------------------------------------------
+// RunLengthColumn stores the values of a field of a chunked structure-of-arrays class as runs of
+// equal values (see the "compression" option of generateSOAs.py), for the fields that are mostly
+// the same from one element to the next.
+//
+// The elements are appended, and then usually set, at the end, where both take constant time.
+// Setting an element elsewhere can split a run, which takes time linear in the number of runs.
+//
+// Every kKeyframeInterval elements, a keyframe holds the run of that element, so that finding the
+// run of an element only searches the runs between two keyframes, however long the column is.
+template <typename Index, typename T>
+class RunLengthColumn
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Value type must be trivially copyable");
+
+ public:
+    static constexpr Index kKeyframeInterval = 256;
+
+    Index size() const { return m_size; }
+
+    // Number of runs of equal values
+    size_t NumRuns() const { return m_starts.size(); }
+
+    // The reference is only valid until the column is modified
+    const T& Get(Index index) const
+    {
+        DIVE_ASSERT(index < m_size);
+        return m_values[FindRun(index)].value;
+    }
+
+    void Append(const T& value)
+    {
+        if (m_values.empty() || !Equal(m_values.back().value, value))
+        {
+            m_starts.push_back(m_size);
+            m_values.push_back(Value{value});
+        }
+        if (m_size % kKeyframeInterval == 0) m_keyframes.push_back(m_starts.size() - 1);
+        ++m_size;
+    }
+
+    // Appends an element with the value of the last element, or `value` if the column is empty,
+    // e.g. for a field that is only set when it changes
+    void Extend(const T& value)
+    {
+        if (m_values.empty())
+        {
+            Append(value);
+            return;
+        }
+        if (m_size % kKeyframeInterval == 0) m_keyframes.push_back(m_starts.size() - 1);
+        ++m_size;
+    }
+
+    // `value` can be a value of this column
+    void Set(Index index, const T& value)
+    {
+        DIVE_ASSERT(index < m_size);
+        size_t run = FindRun(index);
+        if (Equal(m_values[run].value, value)) return;
+        size_t num_runs = m_starts.size();
+        bool has_prev = run > 0;
+        bool has_next = run + 1 < m_starts.size();
+        Index run_end = has_next ? m_starts[run + 1] : m_size;
+        bool starts_run = (m_starts[run] == index);
+        bool ends_run = (run_end == index + 1);
+        if (starts_run && ends_run)
+        {
+            m_values[run].value = value;
+            if (has_next && Equal(m_values[run + 1].value, m_values[run].value)) EraseRun(run + 1);
+            if (has_prev && Equal(m_values[run - 1].value, m_values[run].value)) EraseRun(run);
+        }
+        else if (starts_run)
+        {
+            if (has_prev && Equal(m_values[run - 1].value, value))
+            {
+                ++m_starts[run];
+            }
+            else
+            {
+                InsertRun(run, index, value);
+                ++m_starts[run + 1];
+            }
+        }
+        else if (ends_run)
+        {
+            if (has_next && Equal(m_values[run + 1].value, value))
+                --m_starts[run + 1];
+            else
+                InsertRun(run + 1, index, value);
+        }
+        else
+        {
+            // Split the run in 3. `value` is inserted first, since the insertions can move it
+            T run_value = m_values[run].value;
+            InsertRun(run + 1, index, value);
+            InsertRun(run + 2, index + 1, run_value);
+        }
+        // Only the keyframes from `index` on can change: the runs after it move when runs are
+        // inserted or erased, and the element itself can move to the previous or next run
+        if (m_starts.size() != num_runs || index % kKeyframeInterval == 0) UpdateKeyframes(index);
+    }
+
+    void Clear()
+    {
+        m_starts.clear();
+        m_values.clear();
+        m_keyframes.clear();
+        m_size = 0;
+    }
+
+    // `WriteRawData` passes the runs to `write(data, size)`, a block at a time. The data can be
+    // restored with `SetRawData`, for a column of the same size
+    template <typename WriteFn>
+    void WriteRawData(WriteFn&& write) const
+    {
+        uint64_t num_runs = m_starts.size();
+        write(&num_runs, sizeof(num_runs));
+        if (num_runs == 0) return;
+        write(m_starts.data(), m_starts.size() * sizeof(Index));
+        write(m_values.data(), m_values.size() * sizeof(T));
+    }
+
+    size_t RawDataSize() const
+    {
+        return sizeof(uint64_t) + m_starts.size() * (sizeof(Index) + sizeof(T));
+    }
+
+    // `SetRawData` replaces all elements with `size` elements read from the data at `*data`, and
+    // moves `*data` past it. Returns false, and leaves the elements untouched, if the data is not
+    // valid for `size` elements
+    bool SetRawData(Index size, const uint8_t** data, const uint8_t* data_end)
+    {
+        uint64_t num_runs = 0;
+        if (static_cast<size_t>(data_end - *data) < sizeof(num_runs)) return false;
+        memcpy(&num_runs, *data, sizeof(num_runs));
+        if ((num_runs == 0) != (size == 0) || num_runs > size ||
+            num_runs > (static_cast<size_t>(data_end - *data) - sizeof(num_runs)) /
+                           (sizeof(Index) + sizeof(T)))
+            return false;
+        const uint8_t* ptr = *data + sizeof(num_runs);
+        std::vector<Index> starts(num_runs);
+        std::vector<Value> values(num_runs);
+        // An empty vector's data() can be null, which memcpy does not take even for 0 bytes
+        if (num_runs > 0)
+        {
+            memcpy(starts.data(), ptr, num_runs * sizeof(Index));
+            memcpy(values.data(), ptr + num_runs * sizeof(Index), num_runs * sizeof(T));
+        }
+        ptr += num_runs * (sizeof(Index) + sizeof(T));
+        for (size_t i = 0; i < starts.size(); ++i)
+        {
+            if ((i == 0 && starts[i] != 0) || (i > 0 && starts[i] <= starts[i - 1]) ||
+                starts[i] >= size)
+                return false;
+        }
+        m_starts = std::move(starts);
+        m_values = std::move(values);
+        m_size = size;
+        m_keyframes.resize((size + kKeyframeInterval - 1) / kKeyframeInterval);
+        UpdateKeyframes(0);
+        *data = ptr;
+        return true;
+    }
+
+ private:
+    // Wraps the values, so that they are not stored in a std::vector<bool>
+    struct Value
+    {
+        T value;
+    };
+    static_assert(sizeof(Value) == sizeof(T), "Values must be stored without padding");
+
+    static bool Equal(const T& a, const T& b) { return memcmp(&a, &b, sizeof(T)) == 0; }
+
+    // Index of the run holding the element at `index`
+    size_t FindRun(Index index) const
+    {
+        // Elements are mostly accessed at the end, while they are being filled
+        if (index >= m_starts.back()) return m_starts.size() - 1;
+        size_t keyframe = index / kKeyframeInterval;
+        auto first = m_starts.begin() + m_keyframes[keyframe] + 1;
+        auto last = m_starts.end();
+        if (keyframe + 1 < m_keyframes.size())
+            last = m_starts.begin() + m_keyframes[keyframe + 1] + 1;
+        return std::upper_bound(first, last, index) - m_starts.begin() - 1;
+    }
+
+    // Finds the runs of the keyframes of the elements from `index` on again
+    void UpdateKeyframes(Index index)
+    {
+        size_t keyframe = index / kKeyframeInterval;
+        if (keyframe >= m_keyframes.size()) return;
+        Index first_index = static_cast<Index>(keyframe * kKeyframeInterval);
+        size_t run =
+            std::upper_bound(m_starts.begin(), m_starts.end(), first_index) - m_starts.begin() - 1;
+        for (; keyframe < m_keyframes.size(); ++keyframe)
+        {
+            Index keyframe_index = static_cast<Index>(keyframe * kKeyframeInterval);
+            while (run + 1 < m_starts.size() && m_starts[run + 1] <= keyframe_index) ++run;
+            m_keyframes[keyframe] = run;
+        }
+    }
+
+    void InsertRun(size_t run, Index start, const T& value)
+    {
+        m_starts.insert(m_starts.begin() + run, start);
+        m_values.insert(m_values.begin() + run, Value{value});
+    }
+
+    void EraseRun(size_t run)
+    {
+        m_starts.erase(m_starts.begin() + run);
+        m_values.erase(m_values.begin() + run);
+    }
+
+    // Index of the first element of each run, and its value
+    std::vector<Index> m_starts;
+    std::vector<Value> m_values;
+    // Run of every kKeyframeInterval-th element
+    std::vector<size_t> m_keyframes;
+    Index m_size = 0;
+};
+}  // namespace Dive
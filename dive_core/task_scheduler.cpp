@@ -0,0 +1,304 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "task_scheduler.h"
+
+#include <algorithm>
+
+#include "absl/base/no_destructor.h"
+#include "absl/strings/str_format.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+// Scheduler and queue of the worker running on this thread, if any
+thread_local TaskScheduler* t_worker_scheduler = nullptr;
+thread_local uint32_t t_worker_index = 0;
+
+}  // namespace
+
+// =================================================================================================
+// TaskScheduler
+// =================================================================================================
+TaskScheduler::TaskScheduler(uint32_t num_workers)
+{
+    if (num_workers == 0)
+    {
+        num_workers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+    for (uint32_t i = 0; i < num_workers; ++i)
+    {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (uint32_t i = 0; i < num_workers; ++i)
+    {
+        m_workers.emplace_back(&TaskScheduler::WorkerMain, this, i);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_stopping = true;
+    }
+    m_sleep_condition.notify_all();
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+TaskScheduler& TaskScheduler::GetInstance()
+{
+    // Never destroyed, so that tasks still running at exit do not use a destroyed scheduler
+    static absl::NoDestructor<TaskScheduler> scheduler;
+    return *scheduler;
+}
+
+//--------------------------------------------------------------------------------------------------
+void TaskScheduler::Submit(Task&& task)
+{
+    uint32_t queue_index = t_worker_index;
+    if (t_worker_scheduler != this)
+    {
+        queue_index = m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    }
+    {
+        WorkerQueue& queue = *m_queues[queue_index];
+        std::lock_guard<std::mutex> lock(queue.m_mutex);
+        queue.m_tasks.push_back(std::move(task));
+        // Counted while locked, so the count never goes below 0 when the task is taken
+        m_num_queued_tasks.fetch_add(1);
+    }
+
+    // Sleep() counts the thread as sleeping before it checks m_num_queued_tasks, so either it sees
+    // the task, or it is seen here
+    if (m_num_sleeping.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        }
+        m_sleep_condition.notify_one();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+bool TaskScheduler::RunOneTask()
+{
+    if (m_num_queued_tasks.load() == 0)
+    {
+        return false;
+    }
+
+    // Newest task of the worker's own queue first, then the oldest one of the other queues
+    Task task;
+    bool found = false;
+    uint32_t num_queues = static_cast<uint32_t>(m_queues.size());
+    bool is_worker = (t_worker_scheduler == this);
+    uint32_t first_queue = t_worker_index;
+    if (!is_worker)
+    {
+        first_queue = m_next_queue.load(std::memory_order_relaxed) % num_queues;
+    }
+    for (uint32_t i = 0; i < num_queues && !found; ++i)
+    {
+        WorkerQueue& queue = *m_queues[(first_queue + i) % num_queues];
+        std::lock_guard<std::mutex> lock(queue.m_mutex);
+        if (queue.m_tasks.empty())
+        {
+            continue;
+        }
+        if (is_worker && i == 0)
+        {
+            task = std::move(queue.m_tasks.back());
+            queue.m_tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.m_tasks.front());
+            queue.m_tasks.pop_front();
+        }
+        found = true;
+    }
+    if (!found)
+    {
+        return false;
+    }
+    m_num_queued_tasks.fetch_sub(1);
+
+    if (!task.m_group->Cancelled())
+    {
+        task.m_func();
+    }
+    // Release what the task captured before its group can be seen as done
+    task.m_func = nullptr;
+    task.m_group->OnTaskDone();
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+void TaskScheduler::Sleep(const std::function<bool()>& done_waiting)
+{
+    m_num_sleeping.fetch_add(1);
+    {
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_sleep_condition.wait(lock, [&]() {
+            return m_num_queued_tasks.load() > 0 || m_stopping || done_waiting();
+        });
+    }
+    m_num_sleeping.fetch_sub(1);
+}
+
+//--------------------------------------------------------------------------------------------------
+void TaskScheduler::WakeAll()
+{
+    if (m_num_sleeping.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        }
+        m_sleep_condition.notify_all();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void TaskScheduler::WorkerMain(uint32_t worker_index)
+{
+    t_worker_scheduler = this;
+    t_worker_index = worker_index;
+    while (true)
+    {
+        if (RunOneTask())
+        {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            if (m_stopping)
+            {
+                break;
+            }
+        }
+        Sleep([]() { return false; });
+    }
+    t_worker_scheduler = nullptr;
+}
+
+// =================================================================================================
+// TaskGroup
+// =================================================================================================
+TaskGroup::TaskGroup(const Context& context, ProgressTracker* progress_tracker,
+                     std::string progress_message, TaskScheduler& scheduler)
+    : m_context(context),
+      m_scheduler(scheduler),
+      m_progress_tracker(progress_tracker),
+      m_progress_message(std::move(progress_message))
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+TaskGroup::~TaskGroup()
+{
+    Wait();
+}
+
+//--------------------------------------------------------------------------------------------------
+void TaskGroup::Run(std::function<void()> func)
+{
+    m_num_pending.fetch_add(1);
+    m_num_submitted.fetch_add(1, std::memory_order_relaxed);
+    TaskScheduler::Task task;
+    task.m_func = std::move(func);
+    task.m_group = this;
+    m_scheduler.Submit(std::move(task));
+}
+
+//--------------------------------------------------------------------------------------------------
+void TaskGroup::RunForEach(size_t begin, size_t end, size_t grain_size,
+                           std::function<void(size_t index)> func)
+{
+    grain_size = std::max<size_t>(grain_size, 1);
+    // Shared by the tasks rather than copied into each of them
+    auto shared_func = std::make_shared<std::function<void(size_t index)>>(std::move(func));
+    for (size_t task_begin = begin; task_begin < end; task_begin += grain_size)
+    {
+        size_t task_end = task_begin + std::min(grain_size, end - task_begin);
+        Run([this, shared_func, task_begin, task_end]() {
+            for (size_t i = task_begin; i < task_end && !Cancelled(); ++i)
+            {
+                (*shared_func)(i);
+            }
+        });
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+bool TaskGroup::Wait()
+{
+    while (m_num_pending.load() > 0)
+    {
+        if (!m_scheduler.RunOneTask())
+        {
+            m_scheduler.Sleep([this]() { return m_num_pending.load() == 0; });
+        }
+    }
+    return !Cancelled();
+}
+
+//--------------------------------------------------------------------------------------------------
+void TaskGroup::OnTaskDone()
+{
+    if (m_progress_tracker != nullptr && !Cancelled())
+    {
+        // Tasks can be done while others are still being submitted, so the percentage can go down,
+        // and there can be several "done" messages
+        auto needs_message = [this](uint64_t num_done, uint64_t num_submitted) {
+            uint64_t num_reported = m_num_reported.load(std::memory_order_relaxed);
+            num_submitted = std::max<uint64_t>(num_submitted, 1);
+            return num_done != num_reported &&
+                   (num_done * 100 / num_submitted != num_reported * 100 / num_submitted ||
+                    num_done == num_submitted);
+        };
+        if (needs_message(m_num_done.fetch_add(1) + 1, m_num_submitted.load()))
+        {
+            // Counts read again while locked, so that the messages are in order
+            std::lock_guard<std::mutex> lock(m_progress_mutex);
+            uint64_t num_done = m_num_done.load();
+            uint64_t num_submitted = m_num_submitted.load();
+            if (needs_message(num_done, num_submitted))
+            {
+                m_num_reported.store(num_done, std::memory_order_relaxed);
+                m_progress_tracker->sendMessage(
+                    absl::StrFormat("%s (%d/%d)", m_progress_message, num_done, num_submitted));
+            }
+        }
+    }
+
+    // The group can be destroyed by its Wait() as soon as the count reaches 0
+    TaskScheduler& scheduler = m_scheduler;
+    if (m_num_pending.fetch_sub(1) == 1)
+    {
+        scheduler.WakeAll();
+    }
+}
+
+}  // namespace Dive
@@ -0,0 +1,153 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dive/types/context.h"
+#include "progress_tracker.h"
+
+namespace Dive
+{
+
+class TaskGroup;
+
+//--------------------------------------------------------------------------------------------------
+// Pool of worker threads to spread work over the cores, shared by everything in the process (see
+// GetInstance()) so that concurrent stages do not oversubscribe the machine. Tasks are submitted
+// and waited for through a TaskGroup.
+//
+// Each worker has its own queue. Tasks submitted from a worker go to its queue, and are run last in
+// first out, so that nested tasks run while their data is still in the caches. Tasks submitted from
+// other threads are spread over the queues. A worker whose queue is empty steals the oldest task of
+// another queue, which tends to be the largest piece of work left there.
+class TaskScheduler
+{
+ public:
+    // By default, one worker less than the number of cores, since the threads waiting for a
+    // TaskGroup run its tasks too
+    explicit TaskScheduler(uint32_t num_workers = 0);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    static TaskScheduler& GetInstance();
+
+    uint32_t GetNumWorkers() const { return static_cast<uint32_t>(m_workers.size()); }
+
+ private:
+    friend class TaskGroup;
+
+    struct Task
+    {
+        std::function<void()> m_func;
+        TaskGroup* m_group = nullptr;
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex m_mutex;
+        std::deque<Task> m_tasks;
+    };
+
+    void Submit(Task&& task);
+
+    // Runs one task of the current worker's queue, or of another queue. Returns false if all the
+    // queues are empty
+    bool RunOneTask();
+
+    // Sleeps until a task is submitted or done_waiting() is true
+    void Sleep(const std::function<bool()>& done_waiting);
+
+    // Wakes up all the sleeping threads, eg. for them to check done_waiting() again
+    void WakeAll();
+
+    void WorkerMain(uint32_t worker_index);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+
+    // Queue of the next task submitted from outside the workers
+    std::atomic<uint32_t> m_next_queue = 0;
+
+    std::atomic<uint64_t> m_num_queued_tasks = 0;
+    std::atomic<uint32_t> m_num_sleeping = 0;
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_sleep_condition;
+    bool m_stopping = false;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Tasks that are waited for together. Once the context is cancelled, the tasks that have not
+// started yet are skipped. With a progress tracker, "<message> (<done>/<total>)" is sent to it
+// whenever another percent of the tasks is done, and once they are all done.
+// Run() and Wait() can be called from the tasks themselves, to split work further
+class TaskGroup
+{
+ public:
+    explicit TaskGroup(const Context& context = Context::Background(),
+                       ProgressTracker* progress_tracker = nullptr,
+                       std::string progress_message = "",
+                       TaskScheduler& scheduler = TaskScheduler::GetInstance());
+    // Waits for the tasks
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void Run(std::function<void()> func);
+
+    // Calls func(index) for each index in [begin, end), with grain_size indices per task
+    void RunForEach(size_t begin, size_t end, size_t grain_size,
+                    std::function<void(size_t index)> func);
+
+    // Runs tasks, of this group or any other, until all the tasks of this group are done. Returns
+    // false if the context was cancelled, in which case some of the tasks may have been skipped
+    bool Wait();
+
+    bool Cancelled() const { return m_context.Cancelled(); }
+
+ private:
+    friend class TaskScheduler;
+
+    void OnTaskDone();
+
+    Context m_context;
+    TaskScheduler& m_scheduler;
+
+    std::atomic<uint64_t> m_num_pending = 0;
+
+    ProgressTracker* m_progress_tracker;
+    std::string m_progress_message;
+    std::atomic<uint64_t> m_num_submitted = 0;
+    std::atomic<uint64_t> m_num_done = 0;
+    // Number of done tasks in the last message
+    std::atomic<uint64_t> m_num_reported = 0;
+    std::mutex m_progress_mutex;
+};
+
+}  // namespace Dive
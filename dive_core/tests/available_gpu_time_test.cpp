@@ -17,6 +17,7 @@
 #include "dive_core/available_gpu_time.h"
 
 #include <filesystem>
+#include <tuple>
 
 #include "gtest/gtest.h"
 
@@ -56,6 +57,9 @@ TEST(AvailableGpuTiming, GetObjectTypeString_Pass)
     output = g.GetObjectTypeString(AvailableGpuTiming::ObjectType::kRenderPass);
     EXPECT_EQ(output, "RenderPass");
 
+    output = g.GetObjectTypeString(AvailableGpuTiming::ObjectType::kDraw);
+    EXPECT_EQ(output, "Draw");
+
     EXPECT_FALSE(g.IsValid());
 }
 
@@ -92,6 +96,9 @@ TEST(AvailableGpuTiming, GetObjectType_Pass)
     output = g.GetObjectType("RenderPass");
     EXPECT_EQ(output, AvailableGpuTiming::ObjectType::kRenderPass);
 
+    output = g.GetObjectType("Draw");
+    EXPECT_EQ(output, AvailableGpuTiming::ObjectType::kDraw);
+
     EXPECT_FALSE(g.IsValid());
 }
 
@@ -365,6 +372,51 @@ TEST(AvailableGpuTiming, GetStatsByRow_OOBFail)
     EXPECT_EQ(ret, std::nullopt);
 }
 
+TEST(AvailableGpuTiming, GetDrawStats_Pass)
+{
+    AvailableGpuTiming g;
+    std::string s =
+        "Type,Id,Mean [ms],Median [ms]\nFrame,10,0.345,0.341\nCommandBuffer,0,0.101,0.102\n"
+        "Draw,0,0.001,0.002\nRenderPass,0,0.050,0.051\nDraw,1,0.003,0.004\n"
+        "CommandBuffer,1,0.201,0.202\nCommandBuffer,2,0.301,0.302\nDraw,2,0.005,0.006\n";
+    EXPECT_TRUE(g.LoadFromString(s));
+    EXPECT_TRUE(g.HasDrawStats());
+    EXPECT_EQ(g.GetRows(), 8);
+
+    const std::vector<std::tuple<uint32_t, uint32_t, float>> test_cases = {
+        {0, 0, 0.001f},
+        {0, 1, 0.003f},
+        {2, 0, 0.005f},
+    };
+    for (const auto& [command_buffer_id, draw_index, mean] : test_cases)
+    {
+        auto ret = g.GetDrawStats(command_buffer_id, draw_index);
+        ASSERT_NE(ret, std::nullopt);
+        EXPECT_FLOAT_EQ(ret->mean_ms, mean);
+    }
+
+    EXPECT_EQ(g.GetDrawStats(0, 2), std::nullopt);
+    EXPECT_EQ(g.GetDrawStats(1, 0), std::nullopt);
+    EXPECT_EQ(g.GetDrawStats(3, 0), std::nullopt);
+    EXPECT_EQ(g.GetCell(2, 0), "Draw");
+}
+
+TEST(AvailableGpuTiming, GetDrawStats_NoDrawsFail)
+{
+    AvailableGpuTiming g;
+    EXPECT_TRUE(g.LoadFromCsv(fp / "mock_gpu_time.csv"));
+    EXPECT_FALSE(g.HasDrawStats());
+    EXPECT_EQ(g.GetDrawStats(0, 0), std::nullopt);
+}
+
+TEST(AvailableGpuTiming, LoadFromString_DrawOutsideCommandBufferFail)
+{
+    AvailableGpuTiming g;
+    std::string s = "Type,Id,Mean [ms],Median [ms]\nFrame,10,0.345,0.341\nDraw,0,0.001,0.002\n";
+    EXPECT_FALSE(g.LoadFromString(s));
+    EXPECT_FALSE(g.IsValid());
+}
+
 TEST(AvailableGpuTiming, SimpleUI_Pass)
 {
     AvailableGpuTiming g;
@@ -0,0 +1,327 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/capture_index.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "adreno.h"
+#include "dive_core/data_core.h"
+#include "gtest/gtest.h"
+#include "pm4_info.h"
+
+namespace Dive
+{
+namespace
+{
+
+// Subset of the .rd block types, see Pm4CaptureData::LoadAdrenoRdFile()
+constexpr uint32_t kRdCmd = 2;
+constexpr uint32_t kRdGpuAddr = 3;
+constexpr uint32_t kRdCmdStreamAddr = 6;
+constexpr uint32_t kRdBufferContents = 12;
+constexpr uint32_t kRdGpuId = 13;
+
+constexpr uint64_t kIbAddr = 0x100000000ull;
+constexpr uint32_t kNumSubmits = 3;
+
+uint32_t OddParity(uint32_t val)
+{
+    val ^= val >> 16;
+    val ^= val >> 8;
+    val ^= val >> 4;
+    val &= 0xf;
+    return (~0x6996 >> val) & 1;
+}
+
+uint32_t Type4Header(uint32_t reg_offset, uint32_t count)
+{
+    Pm4Header header;
+    header.u32All = 0;
+    header.type4.type = 4;
+    header.type4.offset = reg_offset;
+    header.type4.offset_parity = OddParity(reg_offset);
+    header.type4.count = count;
+    header.type4.count_parity = OddParity(count);
+    return header.u32All;
+}
+
+uint32_t Type7Header(uint32_t opcode, uint32_t count)
+{
+    Pm4Header header;
+    header.u32All = 0;
+    header.type7.type = 7;
+    header.type7.opcode = opcode;
+    header.type7.opcode_parity = OddParity(opcode);
+    header.type7.count = count;
+    header.type7.count_parity = OddParity(count);
+    return header.u32All;
+}
+
+void AppendBlock(std::vector<uint8_t>& rd, uint32_t type, const void* data, uint32_t size)
+{
+    uint32_t header[2] = { type, size };
+    const uint8_t* header_bytes = reinterpret_cast<const uint8_t*>(header);
+    rd.insert(rd.end(), header_bytes, header_bytes + sizeof(header));
+    const uint8_t* data_bytes = reinterpret_cast<const uint8_t*>(data);
+    rd.insert(rd.end(), data_bytes, data_bytes + size);
+}
+
+void AppendGpuAddr(std::vector<uint8_t>& rd, uint32_t type, uint64_t va_addr, uint32_t size)
+{
+    uint32_t data[3] = { (uint32_t)va_addr, size, (uint32_t)(va_addr >> 32) };
+    AppendBlock(rd, type, data, sizeof(data));
+}
+
+// Each submit has a single IB that sets some registers and draws in direct rendering mode
+std::vector<uint8_t> CreateRdFile()
+{
+    std::vector<uint8_t> rd;
+    const char process_name[] = "test_app";
+    AppendBlock(rd, kRdCmd, process_name, sizeof(process_name));
+    const uint32_t gpu_id = 740;
+    AppendBlock(rd, kRdGpuId, &gpu_id, sizeof(gpu_id));
+    for (uint32_t submit_index = 0; submit_index < kNumSubmits; ++submit_index)
+    {
+        std::vector<uint32_t> ib = { Type4Header(0x8000, 2), submit_index, submit_index + 1,
+                                     Type7Header(CP_SET_MARKER, 1), RM6_DIRECT_RENDER };
+        for (uint32_t draw = 0; draw <= submit_index; ++draw)
+        {
+            PM4_CP_DRAW_INDX_OFFSET packet = {};
+            packet.bitfields0.PRIM_TYPE = DI_PT_TRILIST;
+            packet.bitfields0.SOURCE_SELECT = DI_SRC_SEL_AUTO_INDEX;
+            packet.bitfields1.NUM_INSTANCES = 1;
+            packet.bitfields2.NUM_INDICES = 3 * (draw + 1);
+            ib.push_back(Type7Header(CP_DRAW_INDX_OFFSET, 3));
+            ib.push_back(packet.u32All0);
+            ib.push_back(packet.u32All1);
+            ib.push_back(packet.u32All2);
+            ib.push_back(Type7Header(CP_NOP, 1));
+            ib.push_back(draw);
+        }
+        uint32_t ib_size = (uint32_t)(ib.size() * sizeof(uint32_t));
+        AppendGpuAddr(rd, kRdGpuAddr, kIbAddr, ib_size);
+        AppendBlock(rd, kRdBufferContents, ib.data(), ib_size);
+        AppendGpuAddr(rd, kRdCmdStreamAddr, kIbAddr, (uint32_t)ib.size());
+    }
+    return rd;
+}
+
+void WriteFile(const std::string& file_name, const std::vector<uint8_t>& data)
+{
+    std::ofstream file(file_name, std::ios::out | std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+void ExpectSameTopology(const Topology& expected, const Topology& actual)
+{
+    ASSERT_EQ(expected.GetNumNodes(), actual.GetNumNodes());
+    for (uint64_t node_index = 0; node_index < expected.GetNumNodes(); ++node_index)
+    {
+        EXPECT_EQ(expected.GetParentNodeIndex(node_index), actual.GetParentNodeIndex(node_index));
+        ASSERT_EQ(expected.GetNumChildren(node_index), actual.GetNumChildren(node_index));
+        for (uint64_t i = 0; i < expected.GetNumChildren(node_index); ++i)
+        {
+            EXPECT_EQ(expected.GetChildNodeIndex(node_index, i),
+                      actual.GetChildNodeIndex(node_index, i));
+        }
+    }
+}
+
+std::string EventStateRawData(const EventStateInfo& event_state)
+{
+    std::string data;
+    event_state.WriteRawData([&data](const void* block, size_t size) {
+        data.append(static_cast<const char*>(block), size);
+    });
+    return data;
+}
+
+void ExpectSameMetadata(const CaptureMetadata& expected, const CaptureMetadata& actual)
+{
+    const CommandHierarchy& expected_hierarchy = expected.m_command_hierarchy;
+    const CommandHierarchy& actual_hierarchy = actual.m_command_hierarchy;
+    ASSERT_EQ(expected_hierarchy.size(), actual_hierarchy.size());
+    for (uint64_t node_index = 0; node_index < expected_hierarchy.size(); ++node_index)
+    {
+        EXPECT_EQ(expected_hierarchy.GetNodeType(node_index),
+                  actual_hierarchy.GetNodeType(node_index));
+        EXPECT_EQ(expected_hierarchy.GetNodeDesc(node_index),
+                  actual_hierarchy.GetNodeDesc(node_index));
+        EXPECT_EQ(expected_hierarchy.GetEventIndex(node_index),
+                  actual_hierarchy.GetEventIndex(node_index));
+    }
+    ExpectSameTopology(expected_hierarchy.GetSubmitHierarchyTopology(),
+                       actual_hierarchy.GetSubmitHierarchyTopology());
+    ExpectSameTopology(expected_hierarchy.GetAllEventHierarchyTopology(),
+                       actual_hierarchy.GetAllEventHierarchyTopology());
+
+    EXPECT_EQ(expected.m_num_pm4_packets, actual.m_num_pm4_packets);
+    ASSERT_EQ(expected.m_event_info.size(), actual.m_event_info.size());
+    for (size_t i = 0; i < expected.m_event_info.size(); ++i)
+    {
+        EXPECT_EQ(expected.m_event_info[i].m_num_indices, actual.m_event_info[i].m_num_indices);
+        EXPECT_EQ(expected.m_event_info[i].m_submit_index, actual.m_event_info[i].m_submit_index);
+        EXPECT_EQ(expected.m_event_info[i].m_type, actual.m_event_info[i].m_type);
+        EXPECT_EQ(expected.m_event_info[i].m_str, actual.m_event_info[i].m_str);
+    }
+
+    ASSERT_EQ(expected.m_event_state.size(), actual.m_event_state.size());
+    EXPECT_EQ(expected.m_event_state.RawDataSize(), actual.m_event_state.RawDataSize());
+    EXPECT_EQ(EventStateRawData(expected.m_event_state), EventStateRawData(actual.m_event_state));
+}
+
+class CaptureIndexTest : public testing::Test
+{
+ protected:
+    static void SetUpTestSuite() { Pm4InfoInit(); }
+
+    void SetUp() override
+    {
+        m_dir = std::filesystem::path(testing::TempDir()) / "capture_index_test";
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(m_dir);
+        m_file_name = (m_dir / "capture.rd").string();
+        WriteFile(m_file_name, CreateRdFile());
+    }
+    void TearDown() override { std::filesystem::remove_all(m_dir); }
+
+    std::filesystem::path m_dir;
+    std::string m_file_name;
+};
+
+TEST_F(CaptureIndexTest, IndexReproducesParsedMetadata)
+{
+    DataCore parsed;
+    ASSERT_EQ(parsed.LoadPm4CaptureData(m_file_name), CaptureData::LoadResult::kSuccess);
+    ASSERT_TRUE(parsed.ParsePm4CaptureData());
+    ASSERT_FALSE(parsed.GetCaptureMetadata().m_event_info.empty());
+    ASSERT_TRUE(CaptureIndex::Save(m_file_name, parsed.GetCaptureMetadata()));
+
+    CaptureMetadata loaded;
+    ASSERT_TRUE(CaptureIndex::Load(m_file_name, parsed.GetPm4CaptureData(), loaded));
+    ExpectSameMetadata(parsed.GetCaptureMetadata(), loaded);
+}
+
+TEST_F(CaptureIndexTest, DataCoreWritesAndReusesIndex)
+{
+    for (int load = 0; load < 2; ++load)
+    {
+        DataCore data_core;
+        data_core.SetUseCaptureIndex(true);
+        ASSERT_EQ(data_core.LoadPm4CaptureData(m_file_name), CaptureData::LoadResult::kSuccess);
+        ASSERT_TRUE(data_core.ParsePm4CaptureData());
+        EXPECT_TRUE(std::filesystem::exists(CaptureIndex::GetIndexFileName(m_file_name)));
+
+        DataCore reference;
+        ASSERT_EQ(reference.LoadPm4CaptureData(m_file_name), CaptureData::LoadResult::kSuccess);
+        ASSERT_TRUE(reference.ParsePm4CaptureData());
+        ExpectSameMetadata(reference.GetCaptureMetadata(), data_core.GetCaptureMetadata());
+    }
+}
+
+TEST_F(CaptureIndexTest, ChangedCaptureInvalidatesIndex)
+{
+    DataCore data_core;
+    ASSERT_EQ(data_core.LoadPm4CaptureData(m_file_name), CaptureData::LoadResult::kSuccess);
+    ASSERT_TRUE(data_core.ParsePm4CaptureData());
+    ASSERT_TRUE(CaptureIndex::Save(m_file_name, data_core.GetCaptureMetadata()));
+
+    // Same size, different contents
+    std::vector<uint8_t> rd = CreateRdFile();
+    rd.back() ^= 1;
+    WriteFile(m_file_name, rd);
+
+    CaptureMetadata loaded;
+    EXPECT_FALSE(CaptureIndex::Load(m_file_name, data_core.GetPm4CaptureData(), loaded));
+    EXPECT_EQ(loaded.m_command_hierarchy.size(), 0u);
+    EXPECT_TRUE(loaded.m_event_info.empty());
+}
+
+TEST_F(CaptureIndexTest, TouchedCaptureInvalidatesIndex)
+{
+    DataCore data_core;
+    ASSERT_EQ(data_core.LoadPm4CaptureData(m_file_name), CaptureData::LoadResult::kSuccess);
+    ASSERT_TRUE(data_core.ParsePm4CaptureData());
+    ASSERT_TRUE(CaptureIndex::Save(m_file_name, data_core.GetCaptureMetadata()));
+
+    // Same contents, but the capture may have been changed in between hash samples since
+    auto mtime = std::filesystem::last_write_time(m_file_name);
+    std::filesystem::last_write_time(m_file_name, mtime + std::chrono::seconds(1));
+
+    CaptureMetadata loaded;
+    EXPECT_FALSE(CaptureIndex::Load(m_file_name, data_core.GetPm4CaptureData(), loaded));
+}
+
+TEST_F(CaptureIndexTest, CorruptIndexIsRejected)
+{
+    DataCore data_core;
+    ASSERT_EQ(data_core.LoadPm4CaptureData(m_file_name), CaptureData::LoadResult::kSuccess);
+    ASSERT_TRUE(data_core.ParsePm4CaptureData());
+    ASSERT_TRUE(CaptureIndex::Save(m_file_name, data_core.GetCaptureMetadata()));
+
+    std::string index_file_name = CaptureIndex::GetIndexFileName(m_file_name);
+    std::filesystem::resize_file(index_file_name,
+                                 std::filesystem::file_size(index_file_name) / 2);
+
+    CaptureMetadata loaded;
+    EXPECT_FALSE(CaptureIndex::Load(m_file_name, data_core.GetPm4CaptureData(), loaded));
+    EXPECT_EQ(loaded.m_command_hierarchy.size(), 0u);
+}
+
+TEST_F(CaptureIndexTest, CorruptCountsAreRejected)
+{
+    DataCore data_core;
+    ASSERT_EQ(data_core.LoadPm4CaptureData(m_file_name), CaptureData::LoadResult::kSuccess);
+    ASSERT_TRUE(data_core.ParsePm4CaptureData());
+    ASSERT_TRUE(CaptureIndex::Save(m_file_name, data_core.GetCaptureMetadata()));
+
+    std::string index_file_name = CaptureIndex::GetIndexFileName(m_file_name);
+    std::ifstream index_file(index_file_name, std::ios::in | std::ios::binary);
+    std::vector<char> index((std::istreambuf_iterator<char>(index_file)),
+                            std::istreambuf_iterator<char>());
+    index_file.close();
+
+    // Every count in the file is 8 byte aligned, and no larger than the file. Whichever of them is
+    // replaced by a huge value, the load must fail cleanly, rather than try to allocate that many
+    // entries
+    for (size_t offset = 0; offset + sizeof(uint64_t) <= index.size(); offset += sizeof(uint64_t))
+    {
+        uint64_t value = 0;
+        memcpy(&value, index.data() + offset, sizeof(value));
+        if (value > index.size()) continue;
+
+        std::vector<char> corrupt_index = index;
+        const uint64_t count = UINT32_MAX;
+        memcpy(corrupt_index.data() + offset, &count, sizeof(count));
+        std::ofstream file(index_file_name, std::ios::out | std::ios::binary);
+        file.write(corrupt_index.data(), corrupt_index.size());
+        file.close();
+
+        CaptureMetadata loaded;
+        EXPECT_NO_THROW(CaptureIndex::Load(m_file_name, data_core.GetPm4CaptureData(), loaded))
+            << "offset " << offset;
+    }
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,217 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/command_hierarchy.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "adreno.h"
+#include "dive_core/pm4_capture_data.h"
+#include "gtest/gtest.h"
+#include "pm4_info.h"
+
+namespace Dive
+{
+namespace
+{
+
+// Subset of the .rd block types, see Pm4CaptureData::LoadAdrenoRdFile()
+constexpr uint32_t kRdCmd = 2;
+constexpr uint32_t kRdGpuAddr = 3;
+constexpr uint32_t kRdCmdStreamAddr = 6;
+constexpr uint32_t kRdBufferContents = 12;
+constexpr uint32_t kRdGpuId = 13;
+
+constexpr uint64_t kIbAddr = 0x100000000ull;
+
+uint32_t OddParity(uint32_t val)
+{
+    val ^= val >> 16;
+    val ^= val >> 8;
+    val ^= val >> 4;
+    val &= 0xf;
+    return (~0x6996 >> val) & 1;
+}
+
+uint32_t Type4Header(uint32_t reg_offset, uint32_t count)
+{
+    Pm4Header header;
+    header.u32All = 0;
+    header.type4.type = 4;
+    header.type4.offset = reg_offset;
+    header.type4.offset_parity = OddParity(reg_offset);
+    header.type4.count = count;
+    header.type4.count_parity = OddParity(count);
+    return header.u32All;
+}
+
+uint32_t Type7Header(uint32_t opcode, uint32_t count)
+{
+    Pm4Header header;
+    header.u32All = 0;
+    header.type7.type = 7;
+    header.type7.opcode = opcode;
+    header.type7.opcode_parity = OddParity(opcode);
+    header.type7.count = count;
+    header.type7.count_parity = OddParity(count);
+    return header.u32All;
+}
+
+void AppendBlock(std::vector<uint8_t>& rd, uint32_t type, const void* data, uint32_t size)
+{
+    uint32_t header[2] = { type, size };
+    const uint8_t* header_bytes = reinterpret_cast<const uint8_t*>(header);
+    rd.insert(rd.end(), header_bytes, header_bytes + sizeof(header));
+    const uint8_t* data_bytes = reinterpret_cast<const uint8_t*>(data);
+    rd.insert(rd.end(), data_bytes, data_bytes + size);
+}
+
+void AppendGpuAddr(std::vector<uint8_t>& rd, uint32_t type, uint64_t va_addr, uint32_t size)
+{
+    uint32_t data[3] = { (uint32_t)va_addr, size, (uint32_t)(va_addr >> 32) };
+    AppendBlock(rd, type, data, sizeof(data));
+}
+
+// A single submit with one IB, covering each kind of description that is formatted on demand:
+// registers with and without fields and enums, packet fields, array indices and extra dwords
+std::vector<uint8_t> CreateRdFile()
+{
+    std::vector<uint8_t> rd;
+    const char process_name[] = "test_app";
+    AppendBlock(rd, kRdCmd, process_name, sizeof(process_name));
+    const uint32_t gpu_id = 740;
+    AppendBlock(rd, kRdGpuId, &gpu_id, sizeof(gpu_id));
+
+    std::vector<uint32_t> ib = { Type4Header(0x8871, 1),  // RB_DEPTH_CNTL
+                                 0x17,
+                                 Type4Header(0xa00e, 2),  // VFD_INDEX_OFFSET
+                                 42,
+                                 7,
+                                 Type7Header(CP_SET_MARKER, 2),
+                                 RM6_BIN_VISIBILITY,
+                                 0xdeadbeef,
+                                 Type7Header(CP_SET_PSEUDO_REG, 6),
+                                 SMMU_INFO,
+                                 0x1000,
+                                 0,
+                                 NON_SECURE_SAVE_ADDR,
+                                 0x2000,
+                                 0x1 };
+    uint32_t ib_size = (uint32_t)(ib.size() * sizeof(uint32_t));
+    AppendGpuAddr(rd, kRdGpuAddr, kIbAddr, ib_size);
+    AppendBlock(rd, kRdBufferContents, ib.data(), ib_size);
+    AppendGpuAddr(rd, kRdCmdStreamAddr, kIbAddr, (uint32_t)ib.size());
+    return rd;
+}
+
+class CommandHierarchyTest : public testing::Test
+{
+ protected:
+    static void SetUpTestSuite() { Pm4InfoInit(); }
+
+    void SetUp() override
+    {
+        m_dir = std::filesystem::path(testing::TempDir()) / "command_hierarchy_test";
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(m_dir);
+        std::string file_name = (m_dir / "capture.rd").string();
+        std::vector<uint8_t> rd = CreateRdFile();
+        std::ofstream file(file_name, std::ios::out | std::ios::binary);
+        file.write(reinterpret_cast<const char*>(rd.data()), rd.size());
+        file.close();
+
+        ASSERT_EQ(m_capture_data.LoadCaptureFile(file_name), CaptureData::LoadResult::kSuccess);
+        auto creator = CommandHierarchyCreator::Create(m_command_hierarchy, m_capture_data);
+        ASSERT_TRUE(creator->CreateTrees(false, std::nullopt));
+    }
+    void TearDown() override { std::filesystem::remove_all(m_dir); }
+
+    std::filesystem::path m_dir;
+    Pm4CaptureData m_capture_data;
+    CommandHierarchy m_command_hierarchy;
+};
+
+TEST_F(CommandHierarchyTest, DescriptionsMatchEagerlyFormattedStrings)
+{
+    // Recorded from the hierarchy creator before descriptions were formatted on demand
+    const std::vector<std::string> expected = {
+        "",
+        "Submit: 0, Num IBs: 1, Engine: Universal, Queue: Universal, Engine Index: 0, "
+        "Dummy Submit: 0",
+        "IB: 0, Address: 0x100000000, Size (DWORDS): 15",
+        "TYPE4 REGWRITE 0x48887101",
+        "RB_DEPTH_CNTL: 0x17",
+        "Z_TEST_ENABLE: True",
+        "Z_WRITE_ENABLE: True",
+        "ZFUNC: FUNC_NOTEQUAL",
+        "Z_CLAMP_ENABLE: False",
+        "Z_READ_ENABLE: False",
+        "Z_BOUNDS_ENABLE: False",
+        "O_DEPTH_01_CLAMP_EN: False",
+        "TYPE4 REGWRITE 0x40a00e02",
+        "VFD_INDEX_OFFSET: 0x2a",
+        "VFD_INSTANCE_START_OFFSET: 0x7",
+        "CP_SET_MARKER 0x70e50002",
+        "MARKER_MODE: SET_RENDER_MODE",
+        "USES_GMEM: False",
+        "MODE: RM6_BIN_VISIBILITY",
+        "IFPC_MODE: IFPC_ENABLE",
+        "(DWORD 2): 0x70d68006",
+        "Binning Visibility Pass",
+        "CP_SET_PSEUDO_REG 0x70d68006",
+        "0",
+        "PSEUDO_REG: SMMU_INFO",
+        "LO: 0x1000",
+        "HI: 0x0",
+        "1",
+        "PSEUDO_REG: NON_SECURE_SAVE_ADDR",
+        "LO: 0x2000",
+        "HI: 0x1",
+    };
+
+    ASSERT_EQ(m_command_hierarchy.size(), expected.size());
+    for (uint64_t node_index = 0; node_index < expected.size(); ++node_index)
+    {
+        EXPECT_EQ(m_command_hierarchy.GetNodeDesc(node_index), expected[node_index])
+            << "node " << node_index;
+    }
+}
+
+TEST_F(CommandHierarchyTest, SetNodeDescOverridesFormattedDescription)
+{
+    uint64_t reg_node_index = UINT64_MAX;
+    for (uint64_t node_index = 0; node_index < m_command_hierarchy.size(); ++node_index)
+    {
+        if (m_command_hierarchy.GetNodeType(node_index) == NodeType::kRegNode)
+        {
+            reg_node_index = node_index;
+            break;
+        }
+    }
+    ASSERT_NE(reg_node_index, UINT64_MAX);
+
+    m_command_hierarchy.SetNodeDesc(reg_node_index, "renamed");
+    EXPECT_EQ(m_command_hierarchy.GetNodeDesc(reg_node_index), "renamed");
+    m_command_hierarchy.SetNodeDesc(reg_node_index, "renamed again");
+    EXPECT_EQ(m_command_hierarchy.GetNodeDesc(reg_node_index), "renamed again");
+}
+
+}  // namespace
+}  // namespace Dive
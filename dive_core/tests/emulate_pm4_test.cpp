@@ -0,0 +1,466 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "dive_core/common/emulate_pm4.h"
+#include "dive_core/pm4_capture_data.h"
+#include "gtest/gtest.h"
+#include "pm4_info.h"
+
+namespace Dive
+{
+namespace
+{
+
+constexpr uint64_t kIb1Addr = 0x10000;
+constexpr uint64_t kIb2Addr = 0x20000;
+
+uint32_t OddParity(uint32_t val)
+{
+    val ^= val >> 16;
+    val ^= val >> 8;
+    val ^= val >> 4;
+    val &= 0xf;
+    return (~0x6996 >> val) & 1;
+}
+
+uint32_t Type4Header(uint32_t reg_offset, uint32_t count)
+{
+    Pm4Header header;
+    header.u32All = 0;
+    header.type4.type = 4;
+    header.type4.offset = reg_offset;
+    header.type4.offset_parity = OddParity(reg_offset);
+    header.type4.count = count;
+    header.type4.count_parity = OddParity(count);
+    return header.u32All;
+}
+
+uint32_t Type7Header(uint32_t opcode, uint32_t count)
+{
+    Pm4Header header;
+    header.u32All = 0;
+    header.type7.type = 7;
+    header.type7.opcode = opcode;
+    header.type7.opcode_parity = OddParity(opcode);
+    header.type7.count = count;
+    header.type7.count_parity = OddParity(count);
+    return header.u32All;
+}
+
+void AddBlock(MemoryManager& mem_manager, uint32_t submit_index, uint64_t va_addr,
+              const std::vector<uint32_t>& dwords)
+{
+    MemoryData data =
+        mem_manager.AllocateMemoryData((uint32_t)(dwords.size() * sizeof(uint32_t)));
+    memcpy(data.m_data_ptr, dwords.data(), data.m_data_size);
+    mem_manager.AddMemoryBlock(submit_index, va_addr, std::move(data));
+}
+
+// Every submit has an IB1 that writes some registers, calls an IB2, and then pads with NOPs. The
+// number of packets differs per submit
+void AddSubmit(MemoryManager& mem_manager, DiveVector<SubmitInfo>& submits,
+               const std::vector<uint32_t>& ib1_prefix = {})
+{
+    uint32_t submit_index = (uint32_t)submits.size();
+
+    std::vector<uint32_t> ib2 = { Type4Header(0x8000, 2), submit_index, submit_index + 1 };
+    AddBlock(mem_manager, submit_index, kIb2Addr, ib2);
+
+    std::vector<uint32_t> ib1 = ib1_prefix;
+    ib1.push_back(Type4Header(0x8100 + submit_index, 1));
+    ib1.push_back(submit_index);
+    ib1.push_back(Type7Header(CP_INDIRECT_BUFFER_PFE, 3));
+    ib1.push_back((uint32_t)kIb2Addr);
+    ib1.push_back((uint32_t)(kIb2Addr >> 32));
+    ib1.push_back((uint32_t)ib2.size());
+    for (uint32_t i = 0; i < (submit_index * 37) % 200; ++i)
+    {
+        ib1.push_back(Type7Header(CP_NOP, 1));
+        ib1.push_back(i);
+    }
+    AddBlock(mem_manager, submit_index, kIb1Addr, ib1);
+
+    IndirectBufferInfo ib_info = {};
+    ib_info.m_va_addr = kIb1Addr;
+    ib_info.m_size_in_dwords = (uint32_t)ib1.size();
+    ib_info.m_enable_mask = 7;
+    DiveVector<IndirectBufferInfo> ibs;
+    ibs.push_back(ib_info);
+
+    // Sprinkle in submits that are not emulated
+    bool is_dummy = (submit_index % 7) == 3;
+    EngineType engine = (submit_index % 11) == 5 ? EngineType::kDma : EngineType::kUniversal;
+    submits.push_back(SubmitInfo(engine, QueueType::kUniversal, 0, is_dummy, std::move(ibs)));
+}
+
+// Logs every callback, along with the register state visible at the time
+class TraceCallbacks : public EmulateCallbacksBase
+{
+ public:
+    ~TraceCallbacks() override = default;
+
+    void OnSubmitStart(uint32_t submit_index, const SubmitInfo& submit_info) override
+    {
+        m_state_tracker.Reset();
+        m_trace << "SubmitStart " << submit_index << "\n";
+    }
+
+    void OnSubmitEnd(uint32_t submit_index, const SubmitInfo& submit_info) override
+    {
+        m_trace << "SubmitEnd " << submit_index << "\n";
+    }
+
+    bool OnIbStart(uint32_t submit_index, uint32_t ib_index, const IndirectBufferInfo& ib_info,
+                   IbType type) override
+    {
+        m_trace << "IbStart " << submit_index << " " << ib_index << " " << ib_info.m_va_addr << " "
+                << ib_info.m_size_in_dwords << " " << (uint32_t)type << "\n";
+        return EmulateCallbacksBase::OnIbStart(submit_index, ib_index, ib_info, type);
+    }
+
+    bool OnIbEnd(uint32_t submit_index, uint32_t ib_index,
+                 const IndirectBufferInfo& ib_info) override
+    {
+        m_trace << "IbEnd " << submit_index << " " << ib_index << " " << ib_info.m_va_addr << "\n";
+        return EmulateCallbacksBase::OnIbEnd(submit_index, ib_index, ib_info);
+    }
+
+    bool OnPacket(const IMemoryManager& mem_manager, uint32_t submit_index, uint32_t ib_index,
+                  uint64_t va_addr, Pm4Header header) override
+    {
+        if (!EmulateCallbacksBase::OnPacket(mem_manager, submit_index, ib_index, va_addr, header))
+            return false;
+        uint32_t payload = 0;
+        EXPECT_TRUE(mem_manager.RetrieveMemoryData(&payload, submit_index, va_addr + 4, 4));
+        m_trace << "Packet " << submit_index << " " << ib_index << " " << va_addr << " "
+                << header.u32All << " " << payload << " "
+                << m_state_tracker.GetRegValue(0x8000, ShaderEnableBit::kGMEM) << "\n";
+        return ++m_num_packets != m_abort_at_packet;
+    }
+
+    std::string GetTrace() const { return m_trace.str(); }
+
+    uint32_t m_abort_at_packet = UINT32_MAX;
+
+ private:
+    std::ostringstream m_trace;
+    uint32_t m_num_packets = 0;
+};
+
+std::string Trace(const DiveVector<SubmitInfo>& submits, const MemoryManager& mem_manager,
+                  bool expected_result, uint32_t abort_at_packet = UINT32_MAX)
+{
+    auto callbacks = std::make_unique<TraceCallbacks>();
+    callbacks->m_abort_at_packet = abort_at_packet;
+    EXPECT_EQ(callbacks->ProcessSubmits(submits, mem_manager), expected_result);
+    return callbacks->GetTrace();
+}
+
+// Logs the callbacks of one of several consumers to a trace they share, to check the order they
+// are called in
+class NamedCallbacks : public EmulateCallbacksBase
+{
+ public:
+    NamedCallbacks(std::string name, std::ostringstream& trace) : m_name(name), m_trace(trace) {}
+    ~NamedCallbacks() override = default;
+
+    void OnSubmitStart(uint32_t submit_index, const SubmitInfo& submit_info) override
+    {
+        m_state_tracker.Reset();
+        m_trace << m_name << " SubmitStart " << submit_index << "\n";
+    }
+
+    void OnSubmitEnd(uint32_t submit_index, const SubmitInfo& submit_info) override
+    {
+        m_trace << m_name << " SubmitEnd " << submit_index << "\n";
+    }
+
+    bool OnIbStart(uint32_t submit_index, uint32_t ib_index, const IndirectBufferInfo& ib_info,
+                   IbType type) override
+    {
+        m_trace << m_name << " IbStart " << submit_index << " " << ib_info.m_va_addr << "\n";
+        return EmulateCallbacksBase::OnIbStart(submit_index, ib_index, ib_info, type);
+    }
+
+    bool OnIbEnd(uint32_t submit_index, uint32_t ib_index,
+                 const IndirectBufferInfo& ib_info) override
+    {
+        m_trace << m_name << " IbEnd " << submit_index << " " << ib_info.m_va_addr << "\n";
+        return EmulateCallbacksBase::OnIbEnd(submit_index, ib_index, ib_info);
+    }
+
+    bool OnPacket(const IMemoryManager& mem_manager, uint32_t submit_index, uint32_t ib_index,
+                  uint64_t va_addr, Pm4Header header) override
+    {
+        if (!EmulateCallbacksBase::OnPacket(mem_manager, submit_index, ib_index, va_addr, header))
+            return false;
+        m_trace << m_name << " Packet " << submit_index << " " << va_addr << " "
+                << m_state_tracker.GetRegValue(0x8000, ShaderEnableBit::kGMEM) << "\n";
+        return ++m_num_packets != m_abort_at_packet;
+    }
+
+    uint32_t m_abort_at_packet = UINT32_MAX;
+
+ private:
+    std::string m_name;
+    std::ostringstream& m_trace;
+    uint32_t m_num_packets = 0;
+};
+
+// Lines of trace that start with prefix, without it
+std::string Lines(const std::string& trace, const std::string& prefix)
+{
+    std::istringstream lines(trace);
+    std::string result;
+    for (std::string line; std::getline(lines, line);)
+    {
+        if (line.compare(0, prefix.size(), prefix) == 0)
+        {
+            result += line.substr(prefix.size()) + "\n";
+        }
+    }
+    return result;
+}
+
+class EmulatePM4Test : public ::testing::Test
+{
+ protected:
+    static void SetUpTestSuite() { Pm4InfoInit(); }
+};
+
+TEST_F(EmulatePM4Test, EmulatesOnlyGfxAndComputeSubmits)
+{
+    MemoryManager mem_manager;
+    DiveVector<SubmitInfo> submits;
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        AddSubmit(mem_manager, submits);
+    }
+    mem_manager.Finalize(true, false);
+
+    std::string trace = Trace(submits, mem_manager, true);
+    EXPECT_NE(trace.find("SubmitEnd 63"), std::string::npos);
+    EXPECT_NE(trace.find("IbStart 63 0 65536"), std::string::npos);
+    // Dummy and DMA submits
+    EXPECT_NE(trace.find("SubmitStart 3\nSubmitEnd 3\n"), std::string::npos);
+    EXPECT_NE(trace.find("SubmitStart 5\nSubmitEnd 5\n"), std::string::npos);
+    // The IB2 is called from the IB1, and sets the register it then sees
+    std::string ib2_trace = "IbStart 62 0 131072 3 1\nPacket 62 0 131072 " +
+                            std::to_string(Type4Header(0x8000, 2)) + " 62 62\n";
+    EXPECT_NE(trace.find(ib2_trace), std::string::npos);
+}
+
+TEST_F(EmulatePM4Test, StopsAtFirstFailure)
+{
+    MemoryManager mem_manager;
+    DiveVector<SubmitInfo> submits;
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        // Submit 12 has a packet with a bad parity bit partway through its IB1
+        std::vector<uint32_t> prefix;
+        if (i == 12)
+        {
+            prefix = { Type7Header(CP_NOP, 1), 0, Type7Header(CP_NOP, 1) ^ (1u << 15), 0 };
+        }
+        AddSubmit(mem_manager, submits, prefix);
+    }
+    mem_manager.Finalize(true, false);
+
+    // Emulation failure
+    std::string trace = Trace(submits, mem_manager, false);
+    EXPECT_NE(trace.find("SubmitEnd 11"), std::string::npos);
+    EXPECT_NE(trace.find("SubmitStart 12"), std::string::npos);
+    EXPECT_EQ(trace.find("SubmitEnd 12"), std::string::npos);
+
+    // Callback failure
+    trace = Trace(submits, mem_manager, false, 3);
+    EXPECT_EQ(trace.find("SubmitEnd 0"), std::string::npos);
+    EXPECT_EQ(trace.find("SubmitStart 1"), std::string::npos);
+}
+
+TEST_F(EmulatePM4Test, MultiplexerCallsConsumersInOrder)
+{
+    MemoryManager mem_manager;
+    DiveVector<SubmitInfo> submits;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        AddSubmit(mem_manager, submits);
+    }
+    mem_manager.Finalize(true, false);
+
+    std::ostringstream alone_trace;
+    auto alone = std::make_unique<NamedCallbacks>("a", alone_trace);
+    EXPECT_TRUE(alone->ProcessSubmits(submits, mem_manager));
+
+    std::ostringstream trace;
+    auto first = std::make_unique<NamedCallbacks>("a", trace);
+    auto second = std::make_unique<NamedCallbacks>("b", trace);
+    auto multiplexer = std::make_unique<EmulateCallbacksMultiplexer>();
+    multiplexer->AddCallbacks(first.get());
+    multiplexer->AddCallbacks(second.get());
+    EXPECT_TRUE(multiplexer->ProcessSubmits(submits, mem_manager));
+
+    // Each consumer sees what it would see on its own, including the registers its own state
+    // tracker has, and the first one sees each callback right before the second one
+    std::string alone_lines = Lines(alone_trace.str(), "a ");
+    EXPECT_EQ(Lines(trace.str(), "a "), alone_lines);
+    std::istringstream lines(trace.str());
+    uint32_t num_lines = 0;
+    for (std::string first_line, second_line;
+         std::getline(lines, first_line) && std::getline(lines, second_line);)
+    {
+        ASSERT_EQ(first_line.substr(0, 2), "a ");
+        ASSERT_EQ(second_line, "b " + first_line.substr(2));
+        num_lines += 2;
+    }
+    EXPECT_EQ(num_lines, 2 * std::count(alone_lines.begin(), alone_lines.end(), '\n'));
+}
+
+TEST_F(EmulatePM4Test, MultiplexerStopsWhenAnyConsumerFails)
+{
+    MemoryManager mem_manager;
+    DiveVector<SubmitInfo> submits;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        AddSubmit(mem_manager, submits);
+    }
+    mem_manager.Finalize(true, false);
+
+    for (uint32_t failing = 0; failing < 2; ++failing)
+    {
+        std::ostringstream trace;
+        auto first = std::make_unique<NamedCallbacks>("a", trace);
+        auto second = std::make_unique<NamedCallbacks>("b", trace);
+        (failing == 0 ? first : second)->m_abort_at_packet = 3;
+        auto multiplexer = std::make_unique<EmulateCallbacksMultiplexer>();
+        multiplexer->AddCallbacks(first.get());
+        multiplexer->AddCallbacks(second.get());
+        EXPECT_FALSE(multiplexer->ProcessSubmits(submits, mem_manager));
+
+        // Neither consumer gets any further callbacks, and a consumer after the failing one does
+        // not get the packet it failed on
+        std::string a_packets = Lines(trace.str(), "a Packet ");
+        std::string b_packets = Lines(trace.str(), "b Packet ");
+        EXPECT_EQ(std::count(a_packets.begin(), a_packets.end(), '\n'), 3);
+        EXPECT_EQ(std::count(b_packets.begin(), b_packets.end(), '\n'), failing == 0 ? 2 : 3);
+        EXPECT_EQ(trace.str().find("SubmitEnd"), std::string::npos);
+    }
+}
+
+TEST_F(EmulatePM4Test, CountPm4PacketsMatchesEmulation)
+{
+    MemoryManager mem_manager;
+    DiveVector<SubmitInfo> submits;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        AddSubmit(mem_manager, submits);
+    }
+    mem_manager.Finalize(true, false);
+
+    std::string trace = Trace(submits, mem_manager, true);
+    uint64_t num_packets = 0;
+    for (size_t pos = trace.find("Packet "); pos != std::string::npos;
+         pos = trace.find("Packet ", pos + 1))
+    {
+        ++num_packets;
+    }
+    EXPECT_EQ(CountPm4Packets(submits, mem_manager), num_packets);
+}
+
+TEST(EmulateStateTracker, SetRegHonorsEnableMask)
+{
+    auto tracker = std::make_unique<EmulateStateTracker>();
+    tracker->Reset();
+    EXPECT_FALSE(tracker->IsRegSet(0x8000, ShaderEnableBit::kGMEM));
+    EXPECT_EQ(tracker->GetRegValue(0x8000, ShaderEnableBit::kGMEM), 0u);
+
+    tracker->PushEnableMask((uint32_t)ShaderEnableBitMask::kGMEM);
+    tracker->SetReg(0x8000, 0x1234);
+    tracker->SetReg(0xffff, 0x5678);
+    tracker->PopEnableMask();
+    tracker->SetReg(0x80ff, 0xaaaaaaaa);
+    tracker->SetReg(0x8100, 0xbbbbbbbb);
+
+    EXPECT_TRUE(tracker->IsRegSet(0x8000, ShaderEnableBit::kGMEM));
+    EXPECT_FALSE(tracker->IsRegSet(0x8000, ShaderEnableBit::kBINNING));
+    EXPECT_FALSE(tracker->IsRegSet(0x8001, ShaderEnableBit::kGMEM));
+    EXPECT_EQ(tracker->GetRegValue(0x8000, ShaderEnableBit::kGMEM), 0x1234u);
+    EXPECT_EQ(tracker->GetRegValue(0x8000, ShaderEnableBit::kSYSMEM), 0u);
+    EXPECT_EQ(tracker->GetRegValue(0xffff, ShaderEnableBit::kGMEM), 0x5678u);
+    EXPECT_EQ(tracker->GetReg64Value(0x80ff, ShaderEnableBit::kSYSMEM), 0xbbbbbbbbaaaaaaaaull);
+
+    // Copies are independent snapshots
+    auto snapshot = std::make_unique<EmulateStateTracker>(*tracker);
+    tracker->Reset();
+    EXPECT_FALSE(tracker->IsRegSet(0x8000, ShaderEnableBit::kGMEM));
+    EXPECT_EQ(tracker->GetRegValue(0xffff, ShaderEnableBit::kGMEM), 0u);
+    EXPECT_EQ(snapshot->GetRegValue(0x8000, ShaderEnableBit::kGMEM), 0x1234u);
+    EXPECT_TRUE(snapshot->IsRegSet(0x8100, ShaderEnableBit::kBINNING));
+
+    tracker->SetReg(0x8000, 1);
+    *snapshot = *tracker;
+    EXPECT_EQ(snapshot->GetRegValue(0x8000, ShaderEnableBit::kBINNING), 1u);
+    EXPECT_FALSE(snapshot->IsRegSet(0x8100, ShaderEnableBit::kBINNING));
+}
+
+// Manual benchmark, run with --gtest_also_run_disabled_tests
+// Mimics emulation of a capture: per submit, a reset followed by packets that each write a burst
+// of consecutive registers in one of a few clustered register ranges
+double MeasureRegisterWrites(uint32_t num_submits, uint32_t packets_per_submit)
+{
+    constexpr uint32_t kRegsPerPacket = 8;
+    const uint32_t kRangeStarts[] = { 0x8000, 0x8800, 0x9100, 0xa800, 0xa980, 0xb180, 0xb800 };
+
+    auto tracker = std::make_unique<EmulateStateTracker>();
+    uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t submit = 0; submit < num_submits; ++submit)
+    {
+        tracker->Reset();
+        for (uint32_t packet = 0; packet < packets_per_submit; ++packet)
+        {
+            uint32_t offset = kRangeStarts[packet % 7] + ((packet * 13) % 0xf8);
+            for (uint32_t i = 0; i < kRegsPerPacket; ++i)
+            {
+                tracker->SetReg(offset + i, packet);
+            }
+            checksum += tracker->GetRegValue(offset ^ 0x10, ShaderEnableBit::kGMEM);
+        }
+    }
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_NE(checksum, 0u);
+    return (double)num_submits * packets_per_submit * kRegsPerPacket / seconds / 1e6;
+}
+
+TEST(EmulateStateTracker, DISABLED_RegisterWriteThroughput)
+{
+    // Reported in M register writes/s through the test properties, see --gtest_output
+    RecordProperty("large_submits", static_cast<int>(MeasureRegisterWrites(500, 10000)));
+    RecordProperty("small_submits", static_cast<int>(MeasureRegisterWrites(100000, 50)));
+}
+
+}  // namespace
+}  // namespace Dive
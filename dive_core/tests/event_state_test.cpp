@@ -0,0 +1,235 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/event_state.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+// More than a chunk of elements
+constexpr uint32_t kNumEvents = 3000;
+
+std::string RawData(const EventStateInfo& event_state)
+{
+    std::string data;
+    event_state.WriteRawData([&data](const void* block, size_t size) {
+        data.append(static_cast<const char*>(block), size);
+    });
+    return data;
+}
+
+VkViewport MakeViewport(float width)
+{
+    VkViewport viewport = {};
+    viewport.width = width;
+    viewport.height = width / 2;
+    viewport.maxDepth = 1.0f;
+    return viewport;
+}
+
+// The state changes every 100 events, like in a capture where most draws share their state
+void FillEvents(EventStateInfo* event_state)
+{
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        auto it = event_state->Add();
+        it->SetBinW(i);
+        it->SetDepthTestEnabled(i % 2 == 0);
+        it->SetViewport(0, MakeViewport(static_cast<float>(i / 100)));
+        it->SetBlendConstant(2, static_cast<float>(i / 100));
+        if (i % 100 == 0)
+        {
+            VkStencilOpState stencil = {};
+            stencil.compareMask = i;
+            it->SetStencilOpStateFront(stencil);
+        }
+    }
+}
+
+void ExpectFilledEvents(const EventStateInfo& event_state)
+{
+    ASSERT_EQ(event_state.size(), kNumEvents);
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventStateId id(i);
+        EXPECT_EQ(event_state.BinW(id), i);
+        EXPECT_EQ(event_state.DepthTestEnabled(id), i % 2 == 0);
+        EXPECT_EQ(event_state.Viewport(id, 0).width, static_cast<float>(i / 100));
+        EXPECT_EQ(event_state.Viewport(id, 1).width, 0.0f);
+        EXPECT_EQ(event_state.BlendConstant(id, 2), static_cast<float>(i / 100));
+        EXPECT_EQ(event_state.StencilOpStateFront(id).compareMask, i % 100 == 0 ? i : 0);
+        EXPECT_TRUE(event_state.IsViewportSet(id, 0));
+        EXPECT_FALSE(event_state.IsViewportSet(id, 1));
+        EXPECT_EQ(event_state.IsStencilOpStateFrontSet(id), i % 100 == 0);
+        EXPECT_FALSE(event_state.IsLineWidthSet(id));
+    }
+}
+
+TEST(EventStateInfo, AddsElementsAcrossChunks)
+{
+    EventStateInfo event_state;
+    FillEvents(&event_state);
+    ExpectFilledEvents(event_state);
+    EXPECT_GE(event_state.capacity(), kNumEvents);
+}
+
+TEST(EventStateInfo, ElementsAreSetInAnyOrder)
+{
+    EventStateInfo event_state;
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        event_state.Add();
+    }
+    // Split a run, and merge it back
+    event_state.SetViewport(EventStateId(5), 3, MakeViewport(1.0f));
+    event_state.SetViewport(EventStateId(4), 3, MakeViewport(1.0f));
+    event_state.SetViewport(EventStateId(6), 3, MakeViewport(1.0f));
+    event_state.SetViewport(EventStateId(0), 3, MakeViewport(2.0f));
+    event_state.SetViewport(EventStateId(5), 3, MakeViewport(0.0f));
+    event_state.SetViewport(EventStateId(5), 3, MakeViewport(1.0f));
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        float expected_width = (i == 0) ? 2.0f : (i >= 4 && i <= 6) ? 1.0f : 0.0f;
+        EXPECT_EQ(event_state.Viewport(EventStateId(i), 3).width, expected_width) << i;
+    }
+}
+
+TEST(EventStateInfo, SetsMatchPlainArray)
+{
+    EventStateInfo event_state;
+    std::vector<uint32_t> expected(kNumEvents, 0);
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        event_state.Add();
+    }
+    // Few distinct values, so that the runs are split and merged all over the keyframes
+    std::mt19937 random(1);
+    for (uint32_t n = 0; n < 20000; ++n)
+    {
+        uint32_t i = random() % kNumEvents;
+        uint32_t value = random() % 3;
+        event_state.SetBinW(EventStateId(i), value);
+        expected[i] = value;
+    }
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EXPECT_EQ(event_state.BinW(EventStateId(i)), expected[i]) << i;
+    }
+}
+
+TEST(EventStateInfo, UnsetFieldsHaveDefaultValues)
+{
+    // Every other event sets the state, like draws between events that set none of it
+    EventStateInfo event_state;
+    EventStateInfo all_set;
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        auto it = event_state.Add();
+        if (i % 2 == 0)
+        {
+            it->SetLineWidth(2.0f);
+            it->SetViewport(0, MakeViewport(3.0f));
+        }
+        auto all_set_it = all_set.Add();
+        all_set_it->SetLineWidth(2.0f);
+        all_set_it->SetViewport(0, MakeViewport(3.0f));
+    }
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        EventStateId id(i);
+        bool is_set = (i % 2 == 0);
+        EXPECT_EQ(event_state.IsLineWidthSet(id), is_set);
+        EXPECT_EQ(event_state.LineWidth(id), is_set ? 2.0f : 0.0f);
+        EXPECT_EQ(*event_state.LineWidthPtr(id), is_set ? 2.0f : 0.0f);
+        EXPECT_EQ(event_state.Viewport(id, 0).width, is_set ? 3.0f : 0.0f);
+        EXPECT_EQ(event_state.Viewport(id, 1).width, 0.0f);
+    }
+    // The events that do not set the state do not split its runs
+    EXPECT_EQ(event_state.RawDataSize(), all_set.RawDataSize());
+
+    // Copying an element copies the default values of its unset fields
+    all_set[EventStateId(0)] = event_state[EventStateId(1)];
+    EXPECT_EQ(all_set.Viewport(EventStateId(0), 0).width, 0.0f);
+}
+
+TEST(EventStateInfo, RefsAssignAndSwap)
+{
+    EventStateInfo event_state;
+    FillEvents(&event_state);
+    auto first = event_state[EventStateId(100)];
+    auto second = event_state[EventStateId(2500)];
+    swap(first, second);
+    EXPECT_EQ(first.BinW(), 2500u);
+    EXPECT_EQ(first.Viewport(0).width, 25.0f);
+    EXPECT_EQ(first.StencilOpStateFront().compareMask, 2500u);
+    EXPECT_EQ(second.BinW(), 100u);
+    EXPECT_EQ(second.Viewport(0).width, 1.0f);
+    EXPECT_EQ(second.StencilOpStateFront().compareMask, 100u);
+
+    event_state[EventStateId(0)] = event_state[EventStateId(2999)];
+    EXPECT_EQ(event_state.BinW(EventStateId(0)), 2999u);
+    EXPECT_EQ(event_state.Viewport(EventStateId(0), 0).width, 29.0f);
+    EXPECT_EQ(event_state.BlendConstant(EventStateId(0), 2), 29.0f);
+}
+
+TEST(EventStateInfo, RawDataRoundTrip)
+{
+    EventStateInfo event_state;
+    FillEvents(&event_state);
+    std::string data = RawData(event_state);
+    EXPECT_EQ(data.size(), event_state.RawDataSize());
+    // Most of the large fields are the same from one event to the next
+    EXPECT_LT(data.size(), kNumEvents * (sizeof(VkViewport) * 16));
+
+    EventStateInfo loaded;
+    ASSERT_TRUE(loaded.SetRawData(kNumEvents, data.data(), data.size()));
+    ExpectFilledEvents(loaded);
+    EXPECT_EQ(RawData(loaded), data);
+
+    EXPECT_FALSE(loaded.SetRawData(kNumEvents, data.data(), data.size() - 1));
+    EXPECT_FALSE(loaded.SetRawData(kNumEvents + 1024, data.data(), data.size()));
+    EXPECT_FALSE(loaded.SetRawData(0, data.data(), data.size()));
+    ExpectFilledEvents(loaded);
+}
+
+TEST(EventStateInfo, ClearKeepsChunks)
+{
+    EventStateInfo event_state;
+    FillEvents(&event_state);
+    auto capacity = event_state.capacity();
+    event_state.Clear();
+    EXPECT_EQ(event_state.size(), 0u);
+    EXPECT_EQ(event_state.capacity(), capacity);
+
+    auto it = event_state.Add();
+    EXPECT_EQ(it->BinW(), 0u);
+    EXPECT_FALSE(it->IsBinWSet());
+    EXPECT_FALSE(it->IsViewportSet(0));
+    EXPECT_EQ(it->Viewport(0).width, 0.0f);
+    EXPECT_EQ(event_state.capacity(), capacity);
+}
+
+}  // namespace
+}  // namespace Dive
@@ -18,10 +18,12 @@ limitations under the License.
 
 #include <fstream>
 #include <iostream>
+#include <string>
 
 #include "absl/functional/any_invocable.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "dive_core/data_core.h"
 #include "gfxr_ext/decode/dive_block_data.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -179,5 +181,89 @@ TEST(GfxrCaptureDataTest, AllLoadedBlocksAreValid)
     ASSERT_TRUE(capture_data.GetMutableGfxrData()->TraverseBlocks(block_validator));
 }
 
+// Runs over every capture in the test data that loads on its own, to cover as many commands as
+// possible. The graphics_pipeline capture needs an asset file that isn't checked in.
+class LazyCommandArgsTest : public ::testing::TestWithParam<const char*>
+{};
+
+TEST_P(LazyCommandArgsTest, LazyCommandArgsMatchEagerOnes)
+{
+    const std::string test_file = std::string(TEST_DATA_DIR "/") + GetParam();
+    GfxrCaptureData eager_capture_data;
+    ASSERT_EQ(eager_capture_data.LoadCaptureFile(test_file), CaptureData::LoadResult::kSuccess);
+    GfxrCaptureData lazy_capture_data;
+    lazy_capture_data.SetLazyCommandArgs(true);
+    ASSERT_EQ(lazy_capture_data.LoadCaptureFile(test_file), CaptureData::LoadResult::kSuccess);
+
+    const auto& eager_submits = eager_capture_data.GetGfxrSubmits();
+    const auto& lazy_submits = lazy_capture_data.GetGfxrSubmits();
+    ASSERT_EQ(lazy_submits.size(), eager_submits.size());
+
+    int decoded_count = 0;
+    for (size_t submit_index = 0; submit_index < eager_submits.size(); ++submit_index)
+    {
+        const auto& handles = eager_submits[submit_index]->vk_command_buffer_handles;
+        ASSERT_EQ(lazy_submits[submit_index]->vk_command_buffer_handles, handles);
+        for (uint64_t handle : handles)
+        {
+            const auto& eager_commands = eager_capture_data.GetGfxrCommandBuffers(handle);
+            const auto& lazy_commands = lazy_capture_data.GetGfxrCommandBuffers(handle);
+            ASSERT_EQ(lazy_commands.size(), eager_commands.size());
+            for (size_t i = 0; i < eager_commands.size(); ++i)
+            {
+                ASSERT_EQ(lazy_commands[i].name, eager_commands[i].name);
+                ASSERT_EQ(lazy_commands[i].block_index, eager_commands[i].block_index);
+                if (lazy_commands[i].args.is_null())
+                {
+                    ++decoded_count;
+                }
+                absl::StatusOr<nlohmann::ordered_json> args =
+                    lazy_capture_data.GetCommandArgs(lazy_commands[i]);
+                ASSERT_TRUE(args.ok()) << args.status().message();
+                EXPECT_EQ(*args, eager_commands[i].args.ToJson()) << lazy_commands[i].name;
+            }
+        }
+    }
+    EXPECT_GT(decoded_count, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    , LazyCommandArgsTest,
+    ::testing::Values(
+        "com.google.bigwheels.project_sample_01_triangle.debug_trim_trigger_20250625T180445.gfxr",
+        "com.google.bigwheels.project_sample_01_triangle.debug_trim_trigger_20250718T132545.gfxr",
+        "vs_triangle_300_20221211T232110.gfxr"));
+
+TEST(GfxrCaptureDataTest, DataCoreDecodesArgsOfLazyCommandNodes)
+{
+    constexpr const char* kTestFile = TEST_DATA_DIR
+        "/com.google.bigwheels.project_sample_01_triangle.debug_"
+        "trim_trigger_20250718T132545.gfxr";
+    DataCore data_core;
+    data_core.SetLazyGfxrCommandArgs(true);
+    ASSERT_EQ(data_core.LoadGfxrCaptureData(kTestFile), CaptureData::LoadResult::kSuccess);
+    ASSERT_TRUE(data_core.ParseGfxrCaptureData());
+
+    const CommandHierarchy& command_hierarchy = data_core.GetCommandHierarchy();
+    int command_count = 0;
+    for (uint64_t node_index = 0; node_index < command_hierarchy.size(); ++node_index)
+    {
+        NodeType node_type = command_hierarchy.GetNodeType(node_index);
+        ASSERT_NE(node_type, NodeType::kGfxrVulkanCommandArgNode);
+
+        absl::StatusOr<nlohmann::ordered_json> args = data_core.GetGfxrCommandArgs(node_index);
+        if (node_type == NodeType::kRootNode || node_type == NodeType::kGfxrRootFrameNode ||
+            node_type == NodeType::kGfxrVulkanSubmitNode)
+        {
+            EXPECT_TRUE(absl::IsNotFound(args.status())) << node_index;
+            continue;
+        }
+        ASSERT_TRUE(args.ok()) << args.status().message();
+        EXPECT_TRUE(args->is_object()) << command_hierarchy.GetNodeDesc(node_index);
+        ++command_count;
+    }
+    EXPECT_GT(command_count, 0);
+}
+
 }  // namespace
 }  // namespace Dive
@@ -0,0 +1,261 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <cstdint>
+#include <vector>
+
+#include "dive_core/pm4_capture_data.h"
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+// Content of every captured byte is derived from its submit and address, so that reads can be
+// verified against which block they were served from
+uint8_t ExpectedByte(uint32_t submit_index, uint64_t va_addr)
+{
+    return (uint8_t)((va_addr * 31) ^ (submit_index * 7));
+}
+
+// The block's content is the one expected for content_submit_index, which allows adding the same
+// content for several submits
+void AddBlock(MemoryManager& mem_manager, uint32_t submit_index, uint64_t va_addr, uint32_t size,
+              uint32_t content_submit_index)
+{
+    MemoryData data = mem_manager.AllocateMemoryData(size);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        data.m_data_ptr[i] = ExpectedByte(content_submit_index, va_addr + i);
+    }
+    mem_manager.AddMemoryBlock(submit_index, va_addr, std::move(data));
+}
+
+void AddBlock(MemoryManager& mem_manager, uint32_t submit_index, uint64_t va_addr, uint32_t size)
+{
+    AddBlock(mem_manager, submit_index, va_addr, size, submit_index);
+}
+
+struct ContiguousCallbackData
+{
+    uint64_t m_next_addr = 0;
+    uint64_t m_total_size = 0;
+};
+
+bool ContiguousCallback(const void* data_ptr, uint64_t va_addr, uint64_t size, void* user_ptr)
+{
+    auto* callback_data = reinterpret_cast<ContiguousCallbackData*>(user_ptr);
+    EXPECT_EQ(callback_data->m_next_addr, va_addr);
+    callback_data->m_next_addr = va_addr + size;
+    callback_data->m_total_size += size;
+    return true;
+}
+
+TEST(MemoryArena, AllocationsAreAlignedAndReused)
+{
+    MemoryArena arena;
+    uint8_t* first = arena.Allocate(3);
+    uint8_t* second = arena.Allocate(5);
+    EXPECT_EQ((uintptr_t)second % 8, 0u);
+    EXPECT_EQ(second, first + 8);
+
+    EXPECT_FALSE(arena.IsLast(first, 3));
+    EXPECT_TRUE(arena.IsLast(second, 5));
+    EXPECT_EQ(arena.GetUsedSize(), 13u);
+
+    // Only the most recent allocation can be given back
+    arena.FreeLast(first, 3);
+    EXPECT_EQ(arena.Allocate(5) - second, 8);
+    arena.FreeLast(second + 8, 5);
+    EXPECT_EQ(arena.Allocate(5), second + 8);
+
+    // Allocations larger than a chunk get their own
+    uint64_t reserved_size = arena.GetReservedSize();
+    uint64_t large_size = 4 * reserved_size + 1;
+    uint8_t* large = arena.Allocate(large_size);
+    large[large_size - 1] = 0xFF;
+    EXPECT_EQ(arena.GetReservedSize(), reserved_size + large_size);
+
+    arena.Reset();
+    EXPECT_EQ(arena.GetReservedSize(), 0u);
+}
+
+TEST(MemoryManager, SameSubmitOnly_RetrievesFromMatchingSubmit)
+{
+    MemoryManager mem_manager;
+    AddBlock(mem_manager, 0, 0x1000, 0x100);
+    AddBlock(mem_manager, 2, 0x1000, 0x100);
+    AddBlock(mem_manager, 2, 0x1100, 0x100);
+    mem_manager.Finalize(true, false);
+
+    uint8_t buffer[0x40];
+    ASSERT_TRUE(mem_manager.RetrieveMemoryData(buffer, 2, 0x10E0, sizeof(buffer)));
+    for (uint32_t i = 0; i < sizeof(buffer); ++i)
+    {
+        EXPECT_EQ(buffer[i], ExpectedByte(2, 0x10E0 + i));
+    }
+
+    // Submit 0 only has the first block, and submit 1 has no blocks at all
+    EXPECT_FALSE(mem_manager.RetrieveMemoryData(buffer, 0, 0x10E0, sizeof(buffer)));
+    EXPECT_FALSE(mem_manager.RetrieveMemoryData(buffer, 1, 0x1000, sizeof(buffer)));
+    EXPECT_FALSE(mem_manager.RetrieveMemoryData(buffer, 3, 0x1000, sizeof(buffer)));
+
+    EXPECT_EQ(mem_manager.GetMaxContiguousSize(0, 0x1010), 0xF0u);
+    EXPECT_EQ(mem_manager.GetMaxContiguousSize(2, 0x1010), 0x1F0u);
+    EXPECT_EQ(mem_manager.GetMaxContiguousSize(1, 0x1010), 0u);
+    EXPECT_EQ(mem_manager.GetMaxContiguousSize(2, 0x1200), 0u);
+    EXPECT_TRUE(mem_manager.IsValid(2, 0x1000, 0x200));
+    EXPECT_FALSE(mem_manager.IsValid(2, 0x1000, 0x201));
+
+    ContiguousCallbackData callback_data;
+    callback_data.m_next_addr = 0x1080;
+    EXPECT_TRUE(mem_manager.GetMemoryOfUnknownSizeViaCallback(2, 0x1080, ContiguousCallback,
+                                                              &callback_data));
+    EXPECT_EQ(callback_data.m_total_size, 0x180u);
+}
+
+TEST(MemoryManager, AnySubmit_UsesBlocksFromAllSubmits)
+{
+    MemoryManager mem_manager;
+    AddBlock(mem_manager, 1, 0x2100, 0x100);
+    AddBlock(mem_manager, 0, 0x2000, 0x100);
+    AddBlock(mem_manager, 3, 0x3000, 0x10);
+    mem_manager.Finalize(false, false);
+
+    uint8_t buffer[0x20];
+    ASSERT_TRUE(mem_manager.RetrieveMemoryData(buffer, 5, 0x20F0, sizeof(buffer)));
+    for (uint32_t i = 0; i < 0x10; ++i)
+    {
+        EXPECT_EQ(buffer[i], ExpectedByte(0, 0x20F0 + i));
+        EXPECT_EQ(buffer[i + 0x10], ExpectedByte(1, 0x2100 + i));
+    }
+    EXPECT_EQ(mem_manager.GetMaxContiguousSize(0, 0x2000), 0x200u);
+    EXPECT_EQ(mem_manager.GetMaxContiguousSize(0, 0x2FFF), 0u);
+    EXPECT_TRUE(mem_manager.IsValid(7, 0x3000, 0x10));
+}
+
+TEST(MemoryManager, AnySubmit_OverlappingBlocks)
+{
+    // Duplicate IB captures can produce overlapping blocks when memory is not per-submit
+    MemoryManager mem_manager;
+    AddBlock(mem_manager, 0, 0x1000, 0x1000);
+    AddBlock(mem_manager, 1, 0x1100, 0x10);
+    AddBlock(mem_manager, 1, 0x1800, 0x10);
+    mem_manager.Finalize(false, true);
+
+    // An address past a short block must still be found in the earlier, larger block
+    uint8_t buffer[0x10];
+    ASSERT_TRUE(mem_manager.RetrieveMemoryData(buffer, 0, 0x1900, sizeof(buffer)));
+    for (uint32_t i = 0; i < sizeof(buffer); ++i)
+    {
+        EXPECT_EQ(buffer[i], ExpectedByte(0, 0x1900 + i));
+    }
+    EXPECT_EQ(mem_manager.GetMaxContiguousSize(0, 0x1900), 0x700u);
+}
+
+TEST(MemoryManager, IdenticalContentIsStoredOnce)
+{
+    MemoryManager mem_manager;
+    for (uint32_t submit = 0; submit <= 4; ++submit)
+    {
+        AddBlock(mem_manager, submit, 0x1000, 0x100, 0);
+    }
+    // Same size, but different content
+    AddBlock(mem_manager, 4, 0x2000, 0x100, 4);
+    mem_manager.Finalize(true, false);
+
+    EXPECT_EQ(mem_manager.GetAddedDataSize(), 6u * 0x100);
+    EXPECT_EQ(mem_manager.GetStoredDataSize(), 2u * 0x100);
+
+    uint8_t buffer[0x100];
+    for (uint32_t submit = 0; submit <= 4; ++submit)
+    {
+        ASSERT_TRUE(mem_manager.RetrieveMemoryData(buffer, submit, 0x1000, sizeof(buffer)));
+        for (uint32_t i = 0; i < sizeof(buffer); ++i)
+        {
+            EXPECT_EQ(buffer[i], ExpectedByte(0, 0x1000 + i));
+        }
+    }
+    ASSERT_TRUE(mem_manager.RetrieveMemoryData(buffer, 4, 0x2000, sizeof(buffer)));
+    for (uint32_t i = 0; i < sizeof(buffer); ++i)
+    {
+        EXPECT_EQ(buffer[i], ExpectedByte(4, 0x2000 + i));
+    }
+}
+
+TEST(MemoryManager, SupersededBlocksAreReclaimed)
+{
+    MemoryManager mem_manager;
+    AddBlock(mem_manager, 0, 0x1000, 0x400);
+    AddBlock(mem_manager, 1, 0x1000, 0x400);
+    // Re-captured with a larger size, which supersedes the first block of submit 1
+    AddBlock(mem_manager, 1, 0x1000, 0x800);
+    mem_manager.Finalize(true, false);
+
+    EXPECT_EQ(mem_manager.GetAddedDataSize(), 0x1000u);
+    EXPECT_EQ(mem_manager.GetStoredDataSize(), 0xC00u);
+
+    uint8_t buffer[0x800];
+    ASSERT_TRUE(mem_manager.RetrieveMemoryData(buffer, 0, 0x1000, 0x400));
+    for (uint32_t i = 0; i < 0x400; ++i)
+    {
+        EXPECT_EQ(buffer[i], ExpectedByte(0, 0x1000 + i));
+    }
+    ASSERT_TRUE(mem_manager.RetrieveMemoryData(buffer, 1, 0x1000, sizeof(buffer)));
+    for (uint32_t i = 0; i < sizeof(buffer); ++i)
+    {
+        EXPECT_EQ(buffer[i], ExpectedByte(1, 0x1000 + i));
+    }
+}
+
+TEST(MemoryManager, ManySubmitsManyBlocks)
+{
+    // Lookups scale with log(#blocks) rather than #blocks. A linear scan over this many blocks for
+    // every lookup would make this test take minutes
+    constexpr uint32_t kNumSubmits = 100;
+    constexpr uint32_t kBlocksPerSubmit = 1000;
+    constexpr uint32_t kBlockSize = 0x40;
+    constexpr uint64_t kBaseAddr = 0x100000000ull;
+
+    MemoryManager mem_manager;
+    for (uint32_t submit = 0; submit < kNumSubmits; ++submit)
+    {
+        // Every other block is left out to create holes in the captured address range
+        for (uint32_t block = 0; block < kBlocksPerSubmit; ++block)
+        {
+            uint64_t addr = kBaseAddr + (uint64_t)block * 2 * kBlockSize;
+            AddBlock(mem_manager, submit, addr, kBlockSize);
+        }
+    }
+    mem_manager.Finalize(true, false);
+
+    std::vector<uint8_t> buffer(kBlockSize);
+    for (uint32_t submit = 0; submit < kNumSubmits; ++submit)
+    {
+        for (uint32_t block = 0; block < kBlocksPerSubmit; ++block)
+        {
+            uint64_t addr = kBaseAddr + (uint64_t)block * 2 * kBlockSize;
+            ASSERT_TRUE(mem_manager.RetrieveMemoryData(buffer.data(), submit, addr, kBlockSize));
+            ASSERT_EQ(buffer[kBlockSize - 1], ExpectedByte(submit, addr + kBlockSize - 1));
+            ASSERT_EQ(mem_manager.GetMaxContiguousSize(submit, addr + 1), kBlockSize - 1);
+            ASSERT_FALSE(mem_manager.IsValid(submit, addr + kBlockSize, 4));
+        }
+    }
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,231 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/pm4_capture_data.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "archive.h"
+#include "archive_entry.h"
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+// Subset of the .rd block types, see Pm4CaptureData::LoadAdrenoRdFile()
+constexpr uint32_t kRdCmd = 2;
+constexpr uint32_t kRdGpuAddr = 3;
+constexpr uint32_t kRdCmdStreamAddr = 6;
+constexpr uint32_t kRdBufferContents = 12;
+
+constexpr uint32_t kNumSubmits = 3;
+constexpr uint32_t kBlockSize = 0x300;
+
+uint8_t ExpectedByte(uint32_t submit_index, uint64_t va_addr)
+{
+    return (uint8_t)((va_addr * 31) ^ (submit_index * 7));
+}
+
+void AppendBlock(std::vector<uint8_t>& rd, uint32_t type, const void* data, uint32_t size)
+{
+    uint32_t header[2] = { type, size };
+    const uint8_t* header_bytes = reinterpret_cast<const uint8_t*>(header);
+    rd.insert(rd.end(), header_bytes, header_bytes + sizeof(header));
+    const uint8_t* data_bytes = reinterpret_cast<const uint8_t*>(data);
+    rd.insert(rd.end(), data_bytes, data_bytes + size);
+}
+
+void AppendGpuAddr(std::vector<uint8_t>& rd, uint32_t type, uint64_t va_addr, uint32_t size)
+{
+    uint32_t data[3] = { (uint32_t)va_addr, size, (uint32_t)(va_addr >> 32) };
+    AppendBlock(rd, type, data, sizeof(data));
+}
+
+// Each submit has a couple of memory blocks, the first of which holds its IB
+std::vector<uint8_t> CreateRdFile()
+{
+    std::vector<uint8_t> rd;
+    const char process_name[] = "test_app";
+    AppendBlock(rd, kRdCmd, process_name, sizeof(process_name));
+    for (uint32_t submit_index = 0; submit_index < kNumSubmits; ++submit_index)
+    {
+        for (uint64_t va_addr : { 0x100000000ull, 0x100001000ull })
+        {
+            std::vector<uint8_t> contents(kBlockSize);
+            for (uint32_t i = 0; i < kBlockSize; ++i)
+            {
+                contents[i] = ExpectedByte(submit_index, va_addr + i);
+            }
+            AppendGpuAddr(rd, kRdGpuAddr, va_addr, kBlockSize);
+            AppendBlock(rd, kRdBufferContents, contents.data(), kBlockSize);
+        }
+        AppendGpuAddr(rd, kRdCmdStreamAddr, 0x100000000ull, kBlockSize / sizeof(uint32_t));
+    }
+    return rd;
+}
+
+void WriteFile(const std::string& file_name, const std::vector<uint8_t>& data)
+{
+    std::ofstream file(file_name, std::ios::out | std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+void WriteGzipFile(const std::string& file_name, const std::vector<uint8_t>& data)
+{
+    struct archive* a = archive_write_new();
+    ASSERT_EQ(archive_write_add_filter_gzip(a), ARCHIVE_OK);
+    ASSERT_EQ(archive_write_set_format_raw(a), ARCHIVE_OK);
+    ASSERT_EQ(archive_write_open_filename(a, file_name.c_str()), ARCHIVE_OK);
+    struct archive_entry* entry = archive_entry_new();
+    archive_entry_set_filetype(entry, AE_IFREG);
+    ASSERT_EQ(archive_write_header(a, entry), ARCHIVE_OK);
+    ASSERT_EQ(archive_write_data(a, data.data(), data.size()), (la_ssize_t)data.size());
+    archive_entry_free(entry);
+    archive_write_close(a);
+    archive_write_free(a);
+}
+
+void ExpectCaptureContents(const Pm4CaptureData& capture_data)
+{
+    ASSERT_EQ(capture_data.GetNumSubmits(), kNumSubmits);
+    const MemoryManager& mem_manager = capture_data.GetMemoryManager();
+    for (uint32_t submit_index = 0; submit_index < kNumSubmits; ++submit_index)
+    {
+        const SubmitInfo& submit_info = capture_data.GetSubmitInfo(submit_index);
+        ASSERT_EQ(submit_info.GetNumIndirectBuffers(), 1u);
+        EXPECT_EQ(submit_info.GetIndirectBufferInfo(0).m_va_addr, 0x100000000ull);
+
+        std::vector<uint8_t> buffer(0x80);
+        for (uint64_t va_addr : { 0x100000000ull, 0x100000280ull, 0x100001100ull })
+        {
+            ASSERT_TRUE(mem_manager.RetrieveMemoryData(buffer.data(), submit_index, va_addr,
+                                                       buffer.size()));
+            for (uint32_t i = 0; i < buffer.size(); ++i)
+            {
+                EXPECT_EQ(buffer[i], ExpectedByte(submit_index, va_addr + i));
+            }
+        }
+    }
+}
+
+class Pm4CaptureDataTest : public testing::Test
+{
+ protected:
+    void SetUp() override
+    {
+        m_dir = std::filesystem::path(testing::TempDir()) / "pm4_capture_data_test";
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(m_dir);
+    }
+    void TearDown() override { std::filesystem::remove_all(m_dir); }
+
+    std::string GetPath(const char* file_name) const { return (m_dir / file_name).string(); }
+
+    std::filesystem::path m_dir;
+};
+
+TEST_F(Pm4CaptureDataTest, UncompressedRdFileIsMapped)
+{
+    std::string file_name = GetPath("capture.rd");
+    WriteFile(file_name, CreateRdFile());
+
+    FileReader reader(file_name.c_str());
+    ASSERT_EQ(reader.Open(), 0);
+    EXPECT_NE(reader.GetMappedFile(), nullptr);
+    reader.Close();
+
+    Pm4CaptureData capture_data;
+    ASSERT_EQ(capture_data.LoadCaptureFile(file_name), CaptureData::LoadResult::kSuccess);
+    ExpectCaptureContents(capture_data);
+}
+
+TEST_F(Pm4CaptureDataTest, CompressedRdFileIsStreamed)
+{
+    std::string file_name = GetPath("capture.rd");
+    WriteGzipFile(file_name, CreateRdFile());
+
+    FileReader reader(file_name.c_str());
+    ASSERT_EQ(reader.Open(), 0);
+    EXPECT_EQ(reader.GetMappedFile(), nullptr);
+    reader.Close();
+
+    Pm4CaptureData capture_data;
+    ASSERT_EQ(capture_data.LoadCaptureFile(file_name), CaptureData::LoadResult::kSuccess);
+    ExpectCaptureContents(capture_data);
+}
+
+TEST_F(Pm4CaptureDataTest, CompressedRdFileIsDecompressedOnceIntoCache)
+{
+    std::string file_name = GetPath("capture.rd");
+    std::filesystem::path cache_dir = m_dir / "cache";
+    std::filesystem::create_directories(cache_dir);
+    WriteGzipFile(file_name, CreateRdFile());
+
+    for (int load = 0; load < 2; ++load)
+    {
+        Pm4CaptureData capture_data;
+        capture_data.SetDecompressionCacheDirectory(cache_dir.string());
+        ASSERT_EQ(capture_data.LoadCaptureFile(file_name), CaptureData::LoadResult::kSuccess);
+        ExpectCaptureContents(capture_data);
+
+        // A single, fully decompressed file
+        std::vector<std::filesystem::path> cache_files;
+        for (const auto& entry : std::filesystem::directory_iterator(cache_dir))
+        {
+            cache_files.push_back(entry.path());
+        }
+        ASSERT_EQ(cache_files.size(), 1u);
+        EXPECT_EQ(std::filesystem::file_size(cache_files[0]), CreateRdFile().size());
+    }
+}
+
+TEST_F(Pm4CaptureDataTest, DecompressionCacheKeepsMostRecentlyLoadedCaptures)
+{
+    std::filesystem::path cache_dir = m_dir / "cache";
+    std::filesystem::create_directories(cache_dir);
+    std::vector<std::string> file_names = { GetPath("a.rd"), GetPath("b.rd"), GetPath("c.rd") };
+    for (const std::string& file_name : file_names) WriteGzipFile(file_name, CreateRdFile());
+
+    // Room for two decompressed captures. Loading "a" again makes "b" the least recently used
+    uint64_t max_size = 2 * CreateRdFile().size();
+    for (size_t i : { 0, 1, 0, 2 })
+    {
+        const std::string& file_name = file_names[i];
+        Pm4CaptureData capture_data;
+        capture_data.SetDecompressionCacheDirectory(cache_dir.string(), max_size);
+        ASSERT_EQ(capture_data.LoadCaptureFile(file_name), CaptureData::LoadResult::kSuccess);
+        ExpectCaptureContents(capture_data);
+    }
+
+    std::vector<std::string> cached_stems;
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir))
+    {
+        std::string stem = entry.path().filename().string();
+        cached_stems.push_back(stem.substr(0, stem.find('.')));
+    }
+    std::sort(cached_stems.begin(), cached_stems.end());
+    EXPECT_EQ(cached_stems, (std::vector<std::string>{ "a", "c" }));
+}
+
+}  // namespace
+}  // namespace Dive
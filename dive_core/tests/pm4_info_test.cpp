@@ -0,0 +1,59 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "pm4_info.h"
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+class Pm4InfoTest : public testing::Test
+{
+ protected:
+    static void SetUpTestSuite() { Pm4InfoInit(); }
+    void TearDown() override { SetGPUID(0); }
+};
+
+TEST_F(Pm4InfoTest, HotRegOffsetsMatchNameLookup)
+{
+    for (uint32_t gpu_id : { 200, 300, 400, 500, 600, 700, 750 })
+    {
+        SetGPUID(gpu_id);
+        for (uint32_t i = 0; i < static_cast<uint32_t>(HotReg::kCount); ++i)
+        {
+            HotReg reg = static_cast<HotReg>(i);
+            EXPECT_EQ(GetRegOffset(reg), GetRegOffsetByName(GetHotRegName(reg)))
+                << GetHotRegName(reg) << " on GPU " << gpu_id;
+        }
+    }
+}
+
+TEST_F(Pm4InfoTest, HotRegOffsetsFollowGpuVariant)
+{
+    // PC_DGEN_RAST_CNTL moved between A6XX and A7XX
+    SetGPUID(640);
+    uint32_t a6xx_offset = GetRegOffset(HotReg::PC_DGEN_RAST_CNTL);
+    SetGPUID(740);
+    uint32_t a7xx_offset = GetRegOffset(HotReg::PC_DGEN_RAST_CNTL);
+    EXPECT_NE(a6xx_offset, kInvalidRegOffset);
+    EXPECT_NE(a7xx_offset, kInvalidRegOffset);
+    EXPECT_NE(a6xx_offset, a7xx_offset);
+}
+
+}  // namespace
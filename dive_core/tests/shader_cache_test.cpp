@@ -0,0 +1,229 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/shader_cache.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+constexpr uint32_t kGpuId = 640;
+
+// Some instructions, followed by bytes that are not part of the shader
+const std::vector<uint64_t> kCode = { 0x2000000000000001ull, 0x4000000000000002ull,
+                                      0x0300000000000000ull, 0x1234567812345678ull };
+constexpr uint32_t kNumInstructions = 3;
+constexpr uint32_t kShaderSize = kNumInstructions * sizeof(uint64_t);
+
+std::shared_ptr<DisassembledData> CreateData()
+{
+    auto data = std::make_shared<DisassembledData>();
+    data->m_instructions_raw.assign(kCode.begin(), kCode.begin() + kNumInstructions);
+    data->m_gpr_count = 7;
+    return data;
+}
+
+std::shared_ptr<DisassembledText> CreateText()
+{
+    auto text = std::make_shared<DisassembledText>();
+    text->m_listing = "mov\nadd\nend\n; stats\n";
+    text->m_instruction_offsets = { 0, 4, 8, 12 };
+    return text;
+}
+
+class ShaderCacheTest : public testing::Test
+{
+ protected:
+    void SetUp() override
+    {
+        m_dir = std::filesystem::path(testing::TempDir()) / "shader_cache_test";
+        std::filesystem::remove_all(m_dir);
+    }
+    void TearDown() override { std::filesystem::remove_all(m_dir); }
+
+    std::filesystem::path m_dir;
+};
+
+TEST_F(ShaderCacheTest, KeyOnlyCoversTheShader)
+{
+    ShaderCache::Key key = ShaderCache::CreateKey(kCode.data(), kShaderSize, kGpuId);
+    std::vector<uint64_t> moved_code = kCode;
+    moved_code[3] = 0;
+    ShaderCache::Key moved_key = ShaderCache::CreateKey(moved_code.data(), kShaderSize, kGpuId);
+    EXPECT_FALSE(key < moved_key);
+    EXPECT_FALSE(moved_key < key);
+
+    ShaderCache::Key other_gpu_key = ShaderCache::CreateKey(kCode.data(), kShaderSize, 750);
+    EXPECT_TRUE(key < other_gpu_key || other_gpu_key < key);
+    std::vector<uint64_t> other_code = kCode;
+    other_code[1] = 0;
+    ShaderCache::Key other_code_key = ShaderCache::CreateKey(other_code.data(), kShaderSize,
+                                                             kGpuId);
+    EXPECT_NE(key.m_hash, other_code_key.m_hash);
+}
+
+TEST_F(ShaderCacheTest, SharesResultsOfTheSameCode)
+{
+    ShaderCache cache;
+    ShaderCache::Key key = ShaderCache::CreateKey(kCode.data(), kShaderSize, kGpuId);
+    EXPECT_EQ(cache.FindData(key, kCode.data()), nullptr);
+    EXPECT_EQ(cache.FindText(key, kNumInstructions), nullptr);
+
+    std::shared_ptr<DisassembledData> data = CreateData();
+    std::shared_ptr<DisassembledText> text = CreateText();
+    cache.AddData(key, data);
+    cache.AddText(key, text);
+    EXPECT_EQ(cache.FindData(key, kCode.data()), data);
+    EXPECT_EQ(cache.FindText(key, kNumInstructions), text);
+
+    // Same key, but other instructions, as for a hash collision
+    std::vector<uint64_t> other_code = kCode;
+    other_code[0] = 0;
+    EXPECT_EQ(cache.FindData(key, other_code.data()), nullptr);
+
+    EXPECT_EQ(cache.GetHitCount(), 2u);
+    EXPECT_EQ(cache.GetMissCount(), 3u);
+}
+
+TEST_F(ShaderCacheTest, ResultsAreReadBackFromTheDirectory)
+{
+    ShaderCache::Key key = ShaderCache::CreateKey(kCode.data(), kShaderSize, kGpuId);
+    {
+        ShaderCache cache;
+        cache.SetDirectory(m_dir.string());
+        cache.AddData(key, CreateData());
+        cache.AddText(key, CreateText());
+    }
+
+    ShaderCache cache;
+    cache.SetDirectory(m_dir.string());
+    std::shared_ptr<const DisassembledData> data = cache.FindData(key, kCode.data());
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(data->m_instructions_raw, CreateData()->m_instructions_raw);
+    EXPECT_EQ(data->m_gpr_count, CreateData()->m_gpr_count);
+    std::shared_ptr<const DisassembledText> text = cache.FindText(key, kNumInstructions);
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ(text->m_listing, CreateText()->m_listing);
+    EXPECT_EQ(text->m_instruction_offsets, CreateText()->m_instruction_offsets);
+    EXPECT_EQ(cache.GetHitCount(), 2u);
+
+    // Files of other gpus are not used
+    ShaderCache::Key other_gpu_key = ShaderCache::CreateKey(kCode.data(), kShaderSize, 750);
+    EXPECT_EQ(cache.FindData(other_gpu_key, kCode.data()), nullptr);
+}
+
+TEST_F(ShaderCacheTest, TruncatedFilesAreMisses)
+{
+    ShaderCache::Key key = ShaderCache::CreateKey(kCode.data(), kShaderSize, kGpuId);
+    {
+        ShaderCache cache;
+        cache.SetDirectory(m_dir.string());
+        cache.AddData(key, CreateData());
+        cache.AddText(key, CreateText());
+    }
+    for (const auto& entry : std::filesystem::directory_iterator(m_dir))
+    {
+        std::filesystem::resize_file(entry.path(), std::filesystem::file_size(entry.path()) - 1);
+    }
+
+    ShaderCache cache;
+    cache.SetDirectory(m_dir.string());
+    EXPECT_EQ(cache.FindData(key, kCode.data()), nullptr);
+    EXPECT_EQ(cache.FindText(key, kNumInstructions), nullptr);
+    EXPECT_EQ(cache.GetMissCount(), 2u);
+}
+
+TEST_F(ShaderCacheTest, TextWithBadOffsetsIsAMiss)
+{
+    ShaderCache::Key key = ShaderCache::CreateKey(kCode.data(), kShaderSize, kGpuId);
+    std::vector<std::vector<size_t>> bad_offsets = {
+        { 0, 4, 8 },           // Too few
+        { 0, 8, 4, 12 },       // Decreasing
+        { 0, 4, 8, 12, 16 },   // Too many
+        { 0, 4, 8, 1000000 },  // Past the end of the listing
+    };
+    for (const std::vector<size_t>& offsets : bad_offsets)
+    {
+        std::filesystem::remove_all(m_dir);
+        {
+            ShaderCache cache;
+            cache.SetDirectory(m_dir.string());
+            std::shared_ptr<DisassembledText> text = CreateText();
+            text->m_instruction_offsets = offsets;
+            cache.AddText(key, text);
+            EXPECT_EQ(cache.FindText(key, kNumInstructions), nullptr);
+        }
+
+        ShaderCache cache;
+        cache.SetDirectory(m_dir.string());
+        EXPECT_EQ(cache.FindText(key, kNumInstructions), nullptr);
+        EXPECT_EQ(cache.GetMissCount(), 1u);
+    }
+}
+
+TEST_F(ShaderCacheTest, LeastRecentlyUsedFilesArePrunedOnStartUp)
+{
+    ShaderCache::Key key = ShaderCache::CreateKey(kCode.data(), kShaderSize, kGpuId);
+    std::vector<uint64_t> other_code = kCode;
+    other_code[0] = 0;
+    ShaderCache::Key other_key = ShaderCache::CreateKey(other_code.data(), kShaderSize, kGpuId);
+    {
+        ShaderCache cache;
+        cache.SetDirectory(m_dir.string());
+        cache.AddData(key, CreateData());
+        cache.AddData(other_key, CreateData());
+    }
+
+    // Make both files old, then use the one of key
+    uint64_t file_size = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(m_dir))
+    {
+        file_size = entry.file_size();
+        std::filesystem::last_write_time(entry.path(),
+                                         entry.last_write_time() - std::chrono::hours(1));
+    }
+    {
+        ShaderCache cache;
+        cache.SetDirectory(m_dir.string());
+        EXPECT_NE(cache.FindData(key, kCode.data()), nullptr);
+    }
+
+    // Only room for one of the files. The cache waits for the pruning when it is destroyed
+    {
+        ShaderCache cache;
+        cache.SetDirectory(m_dir.string(), file_size);
+    }
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(m_dir),
+                            std::filesystem::directory_iterator()),
+              1);
+    ShaderCache cache;
+    cache.SetDirectory(m_dir.string());
+    EXPECT_NE(cache.FindData(key, kCode.data()), nullptr);
+    EXPECT_EQ(cache.FindData(other_key, other_code.data()), nullptr);
+}
+
+}  // namespace
+}  // namespace Dive
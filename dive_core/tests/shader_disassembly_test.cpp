@@ -0,0 +1,178 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/shader_disassembly.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "dive_core/common/memory_manager_base.h"
+#include "dive_core/shader_cache.h"
+#include "gtest/gtest.h"
+#include "pm4_info.h"
+
+namespace Dive
+{
+namespace
+{
+
+// A shader with a backward jump, a forward jump and a jump past its "end", followed by bytes that
+// are not part of the shader. The jump past the "end" targets those bytes.
+const std::vector<uint64_t> kCode = {
+    0x2004400800000001ull,  // mov.f32f32 r2.x, r0.y
+    0x2004400500000004ull,  // mov.f32f32 r1.y, r1.x
+    0x0100000000000003ull,  // jump +3, to the "end"
+    0x0100000000000008ull,  // jump +8, past the "end"
+    0x01000000fffffffcull,  // jump -4, to the first instruction
+    0x0300000000000000ull,  // end
+    0,
+    0,
+    0,
+    0,
+    0x1234567812345678ull,
+    0x0100000000000002ull,
+    0x4000000000000002ull,
+    0x2004400800000001ull,
+};
+
+// Recorded from the two-pass disassembly, which ran the disassembler with PRINT_RAW and parsed the
+// instructions back from its output, before running it again for the listing
+const std::vector<std::string> kTwoPassInstructionTexts = {
+    "l0:\nmov.f32f32 r2.x, r0.y",
+    "mov.f32f32 r1.y, r1.x",
+    "jump #l5",
+    "jump #l11",
+    "jump #l0",
+    "l5:\nend",
+    "nop",
+    "nop",
+    "nop",
+    "nop",
+};
+constexpr uint32_t kTwoPassGprCount = 2;
+const char kTwoPassListing[] =
+    "l0:\n"
+    "mov.f32f32 r2.x, r0.y\n"
+    "mov.f32f32 r1.y, r1.x\n"
+    "jump #l5\n"
+    "jump #l11\n"
+    "jump #l0\n"
+    "l5:\n"
+    "end\n"
+    "nop\n"
+    "nop\n"
+    "nop\n"
+    "nop\n"
+    "Stats:\n"
+    "- shaderdb: 10 instr, 4 nops, 6 non-nops, 2 mov, 0 cov\n"
+    "- shaderdb: 0 last-baryf, 0 half, 2 full, 0 constlen\n"
+    "- shaderdb: 8 cat0, 2 cat1, 0 cat2, 0 cat3, 0 cat4, 0 cat5, 0 cat6, 0 cat7\n"
+    "- shaderdb: 0 sstall, 0 (ss), 0 (sy)\n";
+
+// The two-pass label prepass ran over the bytes after the shader, so the jump past the "end" got
+// a label, which the listing never defined. Only the shader is disassembled now, so it is printed
+// as an offset instead.
+std::string WithoutLabelPastEnd(std::string text)
+{
+    size_t pos = text.find("#l11");
+    if (pos != std::string::npos)
+    {
+        text.replace(pos, 4, "#8");
+    }
+    return text;
+}
+
+class ShaderMemory : public IMemoryManager
+{
+ public:
+    explicit ShaderMemory(const std::vector<uint64_t>& code) : m_code(code) {}
+
+    bool RetrieveMemoryData(void* buffer_ptr, uint32_t submit_index, uint64_t va_addr,
+                            uint64_t size) const override
+    {
+        if (va_addr + size > m_code.size() * sizeof(uint64_t)) return false;
+        std::memcpy(buffer_ptr, reinterpret_cast<const uint8_t*>(m_code.data()) + va_addr, size);
+        return true;
+    }
+    bool GetMemoryOfUnknownSizeViaCallback(uint32_t submit_index, uint64_t va_addr,
+                                           PfnGetMemory data_callback,
+                                           void* user_ptr) const override
+    {
+        return false;
+    }
+    uint64_t GetMaxContiguousSize(uint32_t submit_index, uint64_t va_addr) const override
+    {
+        return m_code.size() * sizeof(uint64_t) - va_addr;
+    }
+    bool IsValid(uint32_t submit_index, uint64_t addr, uint64_t size) const override
+    {
+        return addr + size <= m_code.size() * sizeof(uint64_t);
+    }
+
+ private:
+    std::vector<uint64_t> m_code;
+};
+
+class ShaderDisassemblyTest : public testing::Test
+{
+ protected:
+    void SetUp() override { SetGPUID(740); }
+    void TearDown() override { SetGPUID(0); }
+
+    void ExpectSameAsTwoPass(const Disassembly& disassembly)
+    {
+        ASSERT_EQ(disassembly.GetNumInstructions(), kTwoPassInstructionTexts.size());
+        EXPECT_EQ(disassembly.GetShaderSize(), kTwoPassInstructionTexts.size() * sizeof(uint64_t));
+        EXPECT_EQ(disassembly.GetGPRCount(), kTwoPassGprCount);
+        for (uint32_t i = 0; i < disassembly.GetNumInstructions(); ++i)
+        {
+            EXPECT_EQ(disassembly.GetInstructionRaw(i), kCode[i]) << "instruction " << i;
+            EXPECT_EQ(disassembly.GetInstructionText(i),
+                      WithoutLabelPastEnd(kTwoPassInstructionTexts[i]))
+                << "instruction " << i;
+        }
+        EXPECT_EQ(disassembly.GetListing(), WithoutLabelPastEnd(kTwoPassListing));
+    }
+};
+
+TEST_F(ShaderDisassemblyTest, MatchesTwoPassDisassembly)
+{
+    ShaderMemory memory(kCode);
+    Disassembly disassembly(memory, 0, 0);
+    ExpectSameAsTwoPass(disassembly);
+}
+
+TEST_F(ShaderDisassemblyTest, CachedResultsMatchTwoPassDisassembly)
+{
+    ShaderCache shader_cache;
+    ShaderMemory memory(kCode);
+    Disassembly first(memory, 0, 0, nullptr, &shader_cache);
+    ExpectSameAsTwoPass(first);
+
+    // The same shader followed by other bytes
+    std::vector<uint64_t> moved_code = kCode;
+    moved_code.back() = 0;
+    ShaderMemory moved_memory(moved_code);
+    Disassembly moved(moved_memory, 0, 0, nullptr, &shader_cache);
+    ExpectSameAsTwoPass(moved);
+    // Both the data and the text of the moved shader come from the cache
+    EXPECT_EQ(shader_cache.GetHitCount(), 2u);
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,184 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/task_scheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+class RecordingProgressTracker : public ProgressTracker
+{
+ public:
+    void sendMessage(std::string message) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_messages.push_back(std::move(message));
+    }
+
+    std::mutex m_mutex;
+    std::vector<std::string> m_messages;
+};
+
+TEST(TaskScheduler, RunsAllTasks)
+{
+    TaskScheduler scheduler(4);
+    std::vector<std::atomic<uint32_t>> counts(1000);
+    TaskGroup group(Context::Background(), nullptr, "", scheduler);
+    group.RunForEach(0, counts.size(), 7, [&counts](size_t index) { counts[index]++; });
+    group.Run([&counts]() { counts[0]++; });
+    EXPECT_TRUE(group.Wait());
+
+    EXPECT_EQ(counts[0], 2u);
+    for (size_t i = 1; i < counts.size(); ++i)
+    {
+        EXPECT_EQ(counts[i], 1u) << i;
+    }
+}
+
+TEST(TaskScheduler, TasksCanWaitForNestedTasks)
+{
+    TaskScheduler scheduler(2);
+    std::atomic<uint32_t> count = 0;
+    TaskGroup group(Context::Background(), nullptr, "", scheduler);
+    // More tasks waiting than workers, so the waiting tasks have to run the nested ones
+    for (int i = 0; i < 16; ++i)
+    {
+        group.Run([&scheduler, &count]() {
+            TaskGroup nested_group(Context::Background(), nullptr, "", scheduler);
+            nested_group.RunForEach(0, 100, 1, [&count](size_t) { count++; });
+            EXPECT_TRUE(nested_group.Wait());
+        });
+    }
+    EXPECT_TRUE(group.Wait());
+    EXPECT_EQ(count, 1600u);
+}
+
+TEST(TaskScheduler, GroupsCanBeWaitedForFromManyThreads)
+{
+    TaskScheduler scheduler(3);
+    std::atomic<uint32_t> count = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&scheduler, &count]() {
+            for (int j = 0; j < 50; ++j)
+            {
+                TaskGroup group(Context::Background(), nullptr, "", scheduler);
+                group.RunForEach(0, 20, 1, [&count](size_t) { count++; });
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(count, 4u * 50u * 20u);
+}
+
+TEST(TaskScheduler, CancelledTasksAreSkipped)
+{
+    TaskScheduler scheduler(2);
+    SimpleContext context = SimpleContext::Create();
+    std::atomic<uint32_t> count = 0;
+    TaskGroup group(context, nullptr, "", scheduler);
+    group.RunForEach(0, 10000, 1, [&context, &count](size_t index) {
+        if (index == 100)
+        {
+            context->Cancel();
+        }
+        count++;
+    });
+    EXPECT_FALSE(group.Wait());
+    EXPECT_TRUE(group.Cancelled());
+    EXPECT_LT(count, 10000u);
+}
+
+TEST(TaskScheduler, ReportsProgress)
+{
+    TaskScheduler scheduler(2);
+    RecordingProgressTracker progress_tracker;
+    {
+        TaskGroup group(Context::Background(), &progress_tracker, "Working", scheduler);
+        group.RunForEach(0, 10, 1, [](size_t) {});
+    }
+    ASSERT_FALSE(progress_tracker.m_messages.empty());
+    EXPECT_LE(progress_tracker.m_messages.size(), 10u);
+    EXPECT_EQ(progress_tracker.m_messages.back(), "Working (10/10)");
+}
+
+// Manual benchmark, run with --gtest_also_run_disabled_tests
+// Overhead of scheduling tasks that each only do a few hundred nanoseconds of work
+double MeasureTaskOverhead(TaskScheduler* scheduler, size_t num_tasks, size_t grain_size)
+{
+    std::vector<uint64_t> results(num_tasks);
+    auto work = [&results](size_t index) {
+        uint64_t value = index;
+        for (int i = 0; i < 100; ++i)
+        {
+            value = value * 6364136223846793005ull + 1442695040888963407ull;
+        }
+        results[index] = value;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    if (scheduler == nullptr)
+    {
+        for (size_t i = 0; i < num_tasks; ++i)
+        {
+            work(i);
+        }
+    }
+    else
+    {
+        TaskGroup group(Context::Background(), nullptr, "", *scheduler);
+        group.RunForEach(0, num_tasks, grain_size, work);
+    }
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t checksum = 0;
+    for (uint64_t result : results)
+    {
+        checksum ^= result;
+    }
+    EXPECT_NE(checksum, 0u);
+    return seconds * 1e9 / num_tasks;
+}
+
+TEST(TaskScheduler, DISABLED_FineGrainedTaskOverhead)
+{
+    constexpr size_t kNumTasks = 1000000;
+    TaskScheduler& scheduler = TaskScheduler::GetInstance();
+    printf("Workers: %u\n", scheduler.GetNumWorkers());
+    printf("Serial loop:       %.1f ns/item\n", MeasureTaskOverhead(nullptr, kNumTasks, 1));
+    printf("1 item per task:   %.1f ns/item\n", MeasureTaskOverhead(&scheduler, kNumTasks, 1));
+    printf("64 items per task: %.1f ns/item\n", MeasureTaskOverhead(&scheduler, kNumTasks, 64));
+}
+
+}  // namespace
+}  // namespace Dive
@@ -23,6 +23,12 @@
 #include "util/logging.h"
 #include "util/output_stream.h"
 
+bool DiveAnnotationProcessor::IsArgsKeptWhenLazy(const std::string& function_name)
+{
+    return function_name.find("vkCmdDraw") != std::string::npos ||
+           function_name.find("BeginDebugUtilsLabelEXT") != std::string::npos;
+}
+
 void DiveAnnotationProcessor::WriteBlockEnd(const gfxrecon::util::DiveFunctionData& function_data)
 {
     std::string function_name = function_data.GetFunctionName();
@@ -52,7 +58,12 @@ void DiveAnnotationProcessor::WriteBlockEnd(const gfxrecon::util::DiveFunctionDa
     }
     else
     {
-        VulkanCommandInfo vkCmd(function_data);
+        gfxrecon::decode::DiveArg command_args;
+        if (!m_lazy_args || IsArgsKeptWhenLazy(function_name))
+        {
+            command_args = m_arg_store->Add(args);
+        }
+        VulkanCommandInfo vkCmd(function_data, command_args);
         if (args.count("commandBuffer") != 0)
         {
             uint64_t cmd_handle = args["commandBuffer"];
@@ -67,8 +78,6 @@ void DiveAnnotationProcessor::WriteBlockEnd(const gfxrecon::util::DiveFunctionDa
                 m_draw_call_counts_map[cmd_handle].render_pass_draw_call_counts.push_back(0);
             }
 
-            m_cmd_vk_commands_cache[cmd_handle].push_back(vkCmd);
-
             if (vkCmd.name.find("vkCmdDraw") != std::string::npos)
             {
                 m_draw_call_counts_map[cmd_handle].begin_command_buffer_draw_call_count++;
@@ -77,10 +86,12 @@ void DiveAnnotationProcessor::WriteBlockEnd(const gfxrecon::util::DiveFunctionDa
                     m_draw_call_counts_map[cmd_handle].render_pass_draw_call_counts.back()++;
                 }
             }
+
+            m_cmd_vk_commands_cache[cmd_handle].push_back(std::move(vkCmd));
         }
         else
         {
-            m_none_cmd_vk_commands_per_submit_cache.push_back(vkCmd);
+            m_none_cmd_vk_commands_per_submit_cache.push_back(std::move(vkCmd));
         }
     }
 }
@@ -14,10 +14,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 
 #include "decode/annotation_handler.h"
+#include "dive_arg_store.h"
 #include "util/defines.h"
 #include "util/platform.h"
 
@@ -33,14 +35,22 @@ class DiveAnnotationProcessor : public gfxrecon::decode::AnnotationHandler
  public:
     struct VulkanCommandInfo
     {
-        explicit VulkanCommandInfo(const gfxrecon::util::DiveFunctionData& data)
-            : args(data.GetArgs()), name(data.GetFunctionName()), index(data.GetCmdBufferIndex())
+        explicit VulkanCommandInfo(const gfxrecon::util::DiveFunctionData& data,
+                                   gfxrecon::decode::DiveArg command_args = {})
+            : args(command_args),
+              name(data.GetFunctionName()),
+              index(data.GetCmdBufferIndex()),
+              block_index(data.GetBlockIndex())
         {
         }
 
-        nlohmann::ordered_json args = {};
+        // Null when the args were not kept, see SetLazyArgs. Only valid as long as the
+        // DiveArgStore of the DiveAnnotationProcessor that made the command, see GetArgStore.
+        gfxrecon::decode::DiveArg args = {};
         std::string name = "";
         uint32_t index = 0;
+        // Index of the block of the command in the capture file, to decode its args from.
+        uint64_t block_index = 0;
     };
 
     struct SubmitInfo
@@ -66,6 +76,14 @@ class DiveAnnotationProcessor : public gfxrecon::decode::AnnotationHandler
     DiveAnnotationProcessor() {}
     ~DiveAnnotationProcessor() {}
 
+    // In lazy mode, the args of a command are only kept if the command hierarchy names the
+    // command after them (draws and debug labels). The others can be decoded again from the capture
+    // file with VulkanCommandInfo::block_index, which saves holding the JSON of every command.
+    void SetLazyArgs(bool lazy_args) { m_lazy_args = lazy_args; }
+
+    // Returns whether a command's args are kept in lazy mode.
+    static bool IsArgsKeptWhenLazy(const std::string& function_name);
+
     // Finalize the current block and stream it out.
     void WriteBlockEnd(const gfxrecon::util::DiveFunctionData& function_data) override;
 
@@ -84,6 +102,8 @@ class DiveAnnotationProcessor : public gfxrecon::decode::AnnotationHandler
     {
         return std::move(m_draw_call_counts_map);
     }
+    // The store of the args of the commands, to keep for as long as the commands are used.
+    std::shared_ptr<gfxrecon::decode::DiveArgStore> GetArgStore() const { return m_arg_store; }
 
  private:
     // This is a per submit cache that keeps all vk commands that are not in any command buffer
@@ -92,4 +112,7 @@ class DiveAnnotationProcessor : public gfxrecon::decode::AnnotationHandler
     std::unordered_map<uint64_t, std::vector<VulkanCommandInfo>> m_cmd_vk_commands_cache = {};
     std::unordered_map<uint64_t, DrawCallCounts> m_draw_call_counts_map = {};
     std::vector<std::unique_ptr<SubmitInfo>> m_submits = {};
+    std::shared_ptr<gfxrecon::decode::DiveArgStore> m_arg_store =
+        std::make_shared<gfxrecon::decode::DiveArgStore>();
+    bool m_lazy_args = false;
 };
@@ -31,7 +31,7 @@ MATCHER_P3(VulkanCommandInfoEqual, expected_name, expected_index, expected_args,
 {
     EXPECT_EQ(arg.name, expected_name);
     EXPECT_EQ(arg.index, expected_index);
-    EXPECT_EQ(arg.args, expected_args);
+    EXPECT_EQ(arg.args.ToJson(), expected_args);
     return true;
 }
 
@@ -351,5 +351,34 @@ TEST(WriteBlockEndTest, DrawCallsAreCorrectlyCountedInMultipleRenderPasses)
                 testing::ElementsAre(2, 3));
 }
 
+TEST(WriteBlockEndTest, LazyArgsAreOnlyKeptForNamedCommands)
+{
+    DiveAnnotationProcessor processor;
+    processor.SetLazyArgs(true);
+    uint64_t handle = 1001;
+
+    processor.WriteBlockEnd(CreateCommandData("vkBeginCommandBuffer", handle, 0, 1));
+    processor.WriteBlockEnd(CreateCommandData("vkCmdBeginDebugUtilsLabelEXT", handle, 1, 2));
+    processor.WriteBlockEnd(CreateCommandData("vkCmdDraw", handle, 2, 3));
+    processor.WriteBlockEnd(CreateCommandData("vkEndCommandBuffer", handle, 0, 4));
+
+    auto vk_commands_cache = processor.TakeVkCommandsCache();
+    ASSERT_TRUE(vk_commands_cache.count(handle));
+    const auto& commands = vk_commands_cache[handle];
+    ASSERT_THAT(commands, SizeIs(4));
+
+    nlohmann::ordered_json kept_args = {{"commandBuffer", handle}};
+    EXPECT_THAT(commands[0], VulkanCommandInfoEqual("vkBeginCommandBuffer", 0,
+                                                    nlohmann::ordered_json()));
+    EXPECT_THAT(commands[1], VulkanCommandInfoEqual("vkCmdBeginDebugUtilsLabelEXT", 1, kept_args));
+    EXPECT_THAT(commands[2], VulkanCommandInfoEqual("vkCmdDraw", 2, kept_args));
+    EXPECT_THAT(commands[3],
+                VulkanCommandInfoEqual("vkEndCommandBuffer", 0, nlohmann::ordered_json()));
+
+    // The block index is what the args are decoded from again.
+    EXPECT_EQ(commands[0].block_index, 1);
+    EXPECT_EQ(commands[3].block_index, 4);
+}
+
 }  // namespace
 }  // namespace gfxrecon::decode
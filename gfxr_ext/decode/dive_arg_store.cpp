@@ -0,0 +1,528 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "dive_arg_store.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "util/logging.h"
+
+GFXRECON_BEGIN_NAMESPACE(gfxrecon)
+GFXRECON_BEGIN_NAMESPACE(decode)
+
+DiveArg::Item DiveArg::ItemIterator::operator*() const
+{
+    const DiveArgStore::Node& node = m_store->GetNode(m_index);
+    std::string_view key;
+    if (node.key != DiveArgStore::kNoKey)
+    {
+        key = m_store->m_keys[node.key];
+    }
+    return Item{key, DiveArg(m_store, m_index)};
+}
+
+bool DiveArg::is_null() const
+{
+    return m_store == nullptr || m_store->GetNode(m_index).type == DiveArgStore::Type::kNull;
+}
+
+bool DiveArg::is_boolean() const
+{
+    return m_store != nullptr && m_store->GetNode(m_index).type == DiveArgStore::Type::kBool;
+}
+
+bool DiveArg::is_number() const
+{
+    return is_number_integer() || is_number_float();
+}
+
+bool DiveArg::is_number_integer() const
+{
+    if (m_store == nullptr)
+    {
+        return false;
+    }
+    DiveArgStore::Type type = m_store->GetNode(m_index).type;
+    return type == DiveArgStore::Type::kInt || type == DiveArgStore::Type::kUint;
+}
+
+bool DiveArg::is_number_unsigned() const
+{
+    return m_store != nullptr && m_store->GetNode(m_index).type == DiveArgStore::Type::kUint;
+}
+
+bool DiveArg::is_number_float() const
+{
+    return m_store != nullptr && m_store->GetNode(m_index).type == DiveArgStore::Type::kFloat;
+}
+
+bool DiveArg::is_string() const
+{
+    return m_store != nullptr && m_store->GetNode(m_index).type == DiveArgStore::Type::kString;
+}
+
+bool DiveArg::is_object() const
+{
+    return m_store != nullptr && m_store->GetNode(m_index).type == DiveArgStore::Type::kObject;
+}
+
+bool DiveArg::is_array() const
+{
+    return m_store != nullptr && m_store->GetNode(m_index).type == DiveArgStore::Type::kArray;
+}
+
+size_t DiveArg::size() const
+{
+    if (is_null())
+    {
+        return 0;
+    }
+    if (is_structured())
+    {
+        return m_store->GetNode(m_index).value.children.count;
+    }
+    return 1;
+}
+
+bool DiveArg::contains(std::string_view key) const
+{
+    // A member with a null value is still a member, unlike a missing key, which has no store.
+    return (*this)[key].m_store != nullptr;
+}
+
+DiveArg DiveArg::operator[](std::string_view key) const
+{
+    if (!is_object())
+    {
+        return DiveArg();
+    }
+
+    // Keys are interned, so that the members can be matched by key index.
+    auto it = m_store->m_key_indices.find(key);
+    if (it == m_store->m_key_indices.end())
+    {
+        return DiveArg();
+    }
+
+    const DiveArgStore::Node& node = m_store->GetNode(m_index);
+    for (uint32_t i = 0; i < node.value.children.count; ++i)
+    {
+        uint32_t child_index = node.value.children.first + i;
+        if (m_store->GetNode(child_index).key == it->second)
+        {
+            return DiveArg(m_store, child_index);
+        }
+    }
+    return DiveArg();
+}
+
+DiveArg DiveArg::At(size_t index) const
+{
+    if (!is_structured() || index >= size())
+    {
+        return DiveArg();
+    }
+    return DiveArg(m_store, m_store->GetNode(m_index).value.children.first + index);
+}
+
+DiveArg::ItemRange DiveArg::items() const
+{
+    if (!is_structured())
+    {
+        return ItemRange{ItemIterator(m_store, 0), ItemIterator(m_store, 0)};
+    }
+    const DiveArgStore::Node& node = m_store->GetNode(m_index);
+    uint32_t first = node.value.children.first;
+    return ItemRange{ItemIterator(m_store, first),
+                      ItemIterator(m_store, first + node.value.children.count)};
+}
+
+std::string_view DiveArg::GetString() const
+{
+    if (!is_string())
+    {
+        return {};
+    }
+    const DiveArgStore::Node& node = m_store->GetNode(m_index);
+    if (node.string_size <= DiveArgStore::kInlineStringSize)
+    {
+        return std::string_view(node.value.chars, node.string_size);
+    }
+    uint32_t size = 0;
+    std::memcpy(&size, node.value.long_string, sizeof(size));
+    return std::string_view(node.value.long_string + sizeof(size), size);
+}
+
+bool DiveArg::GetBool() const
+{
+    return is_boolean() && m_store->GetNode(m_index).value.b;
+}
+
+int64_t DiveArg::GetInt() const
+{
+    if (is_number_float())
+    {
+        return static_cast<int64_t>(GetFloat());
+    }
+    if (!is_number_integer())
+    {
+        return 0;
+    }
+    return m_store->GetNode(m_index).value.i;
+}
+
+uint64_t DiveArg::GetUint() const
+{
+    if (is_number_float())
+    {
+        return static_cast<uint64_t>(GetFloat());
+    }
+    if (!is_number_integer())
+    {
+        return 0;
+    }
+    return m_store->GetNode(m_index).value.u;
+}
+
+double DiveArg::GetFloat() const
+{
+    if (m_store == nullptr)
+    {
+        return 0.0;
+    }
+    const DiveArgStore::Node& node = m_store->GetNode(m_index);
+    switch (node.type)
+    {
+        case DiveArgStore::Type::kInt:
+            return static_cast<double>(node.value.i);
+        case DiveArgStore::Type::kUint:
+            return static_cast<double>(node.value.u);
+        case DiveArgStore::Type::kFloat:
+            return node.value.f;
+        default:
+            return 0.0;
+    }
+}
+
+std::string DiveArg::dump() const
+{
+    std::string out;
+    DumpTo(out);
+    return out;
+}
+
+void DiveArg::DumpTo(std::string& out) const
+{
+    if (m_store == nullptr)
+    {
+        out += "null";
+        return;
+    }
+
+    // Writes the json directly rather than building a nlohmann::json to dump, which would copy
+    // every key and string of the value.
+    const DiveArgStore::Node& node = m_store->GetNode(m_index);
+    switch (node.type)
+    {
+        case DiveArgStore::Type::kNull:
+            out += "null";
+            break;
+        case DiveArgStore::Type::kBool:
+            out += node.value.b ? "true" : "false";
+            break;
+        case DiveArgStore::Type::kInt:
+            out += std::to_string(node.value.i);
+            break;
+        case DiveArgStore::Type::kUint:
+            out += std::to_string(node.value.u);
+            break;
+        case DiveArgStore::Type::kFloat:
+            // Keeps the exact float formatting of nlohmann::json.
+            out += nlohmann::ordered_json(node.value.f).dump();
+            break;
+        case DiveArgStore::Type::kString:
+            DumpString(GetString(), out);
+            break;
+        case DiveArgStore::Type::kObject:
+        case DiveArgStore::Type::kArray:
+        {
+            bool is_object = node.type == DiveArgStore::Type::kObject;
+            out += is_object ? '{' : '[';
+            bool first = true;
+            for (const auto& [key, value] : items())
+            {
+                if (!first)
+                {
+                    out += ',';
+                }
+                first = false;
+                if (is_object)
+                {
+                    DumpString(key, out);
+                    out += ':';
+                }
+                value.DumpTo(out);
+            }
+            out += is_object ? '}' : ']';
+            break;
+        }
+    }
+}
+
+void DiveArg::DumpString(std::string_view str, std::string& out)
+{
+    // Enum names, flags and the like need no escaping. Leave anything else, such as control chars
+    // and UTF-8, to nlohmann::json.
+    for (char c : str)
+    {
+        if (c < 0x20 || c == 0x7f || c == '"' || c == '\\')
+        {
+            out += nlohmann::ordered_json(std::string(str)).dump();
+            return;
+        }
+    }
+    out += '"';
+    out += str;
+    out += '"';
+}
+
+nlohmann::ordered_json DiveArg::ToJson() const
+{
+    if (m_store == nullptr)
+    {
+        return nlohmann::ordered_json();
+    }
+
+    const DiveArgStore::Node& node = m_store->GetNode(m_index);
+    switch (node.type)
+    {
+        case DiveArgStore::Type::kNull:
+            return nlohmann::ordered_json();
+        case DiveArgStore::Type::kBool:
+            return node.value.b;
+        case DiveArgStore::Type::kInt:
+            return node.value.i;
+        case DiveArgStore::Type::kUint:
+            return node.value.u;
+        case DiveArgStore::Type::kFloat:
+            return node.value.f;
+        case DiveArgStore::Type::kString:
+            return std::string(GetString());
+        case DiveArgStore::Type::kObject:
+        {
+            nlohmann::ordered_json json = nlohmann::ordered_json::object();
+            for (const auto& [key, value] : items())
+            {
+                json[std::string(key)] = value.ToJson();
+            }
+            return json;
+        }
+        case DiveArgStore::Type::kArray:
+        {
+            nlohmann::ordered_json json = nlohmann::ordered_json::array();
+            for (const auto& item : items())
+            {
+                json.push_back(item.value.ToJson());
+            }
+            return json;
+        }
+    }
+    return nlohmann::ordered_json();
+}
+
+std::ostream& operator<<(std::ostream& os, const DiveArg& arg)
+{
+    return os << arg.dump();
+}
+
+DiveArg DiveArgStore::Add(const nlohmann::ordered_json& value)
+{
+    uint32_t index = AllocateNodes(1);
+    Fill(index, kNoKey, value);
+    return DiveArg(this, index);
+}
+
+size_t DiveArgStore::GetAllocatedSize() const
+{
+    size_t size = m_node_blocks.size() * kNodesPerBlock * sizeof(Node) + m_allocated_chars;
+    for (const std::string& key : m_keys)
+    {
+        size += sizeof(std::string) + (key.size() > sizeof(std::string) ? key.capacity() : 0);
+    }
+    return size;
+}
+
+uint32_t DiveArgStore::AllocateNodes(uint32_t count)
+{
+    GFXRECON_ASSERT(m_node_count + count <= UINT32_MAX);
+
+    // The nodes only need consecutive indices, so a range can span several blocks.
+    uint32_t first = static_cast<uint32_t>(m_node_count);
+    m_node_count += count;
+    while (m_node_blocks.size() * kNodesPerBlock < m_node_count)
+    {
+        m_node_blocks.push_back(std::make_unique<Node[]>(kNodesPerBlock));
+    }
+    return first;
+}
+
+DiveArgStore::Node& DiveArgStore::GetNode(uint32_t index)
+{
+    return m_node_blocks[index / kNodesPerBlock][index % kNodesPerBlock];
+}
+
+const DiveArgStore::Node& DiveArgStore::GetNode(uint32_t index) const
+{
+    return m_node_blocks[index / kNodesPerBlock][index % kNodesPerBlock];
+}
+
+uint32_t DiveArgStore::InternKey(const std::string& key)
+{
+    auto it = m_key_indices.find(key);
+    if (it != m_key_indices.end())
+    {
+        return it->second;
+    }
+
+    uint32_t key_index = static_cast<uint32_t>(m_keys.size());
+    m_keys.push_back(key);
+    m_key_indices.emplace(m_keys.back(), key_index);
+    return key_index;
+}
+
+const char* DiveArgStore::StoreLongString(const std::string& str)
+{
+    // Most long strings are the names of enum values and flags, which repeat across commands.
+    auto it = m_long_strings.find(str);
+    if (it != m_long_strings.end())
+    {
+        return it->second;
+    }
+
+    uint32_t size = static_cast<uint32_t>(str.size());
+    size_t needed = sizeof(size) + size;
+
+    char* chars = nullptr;
+    if (needed > kMaxCharsPerBlock)
+    {
+        // Too large for a shared block, keep filling the current one afterwards.
+        m_char_blocks.push_back(std::make_unique<char[]>(needed));
+        chars = m_char_blocks.back().get();
+        m_allocated_chars += needed;
+    }
+    else
+    {
+        if (m_cur_char_block == nullptr || m_cur_char_block_used + needed > m_cur_char_block_size)
+        {
+            // The blocks grow, so that small captures don't pay for a large block.
+            m_cur_char_block_size = std::min(std::max(2 * m_cur_char_block_size, kMinCharsPerBlock),
+                                             kMaxCharsPerBlock);
+            m_cur_char_block_size = std::max(m_cur_char_block_size, needed);
+            m_char_blocks.push_back(std::make_unique<char[]>(m_cur_char_block_size));
+            m_cur_char_block = m_char_blocks.back().get();
+            m_cur_char_block_used = 0;
+            m_allocated_chars += m_cur_char_block_size;
+        }
+        chars = m_cur_char_block + m_cur_char_block_used;
+        m_cur_char_block_used += needed;
+    }
+
+    std::memcpy(chars, &size, sizeof(size));
+    std::memcpy(chars + sizeof(size), str.data(), size);
+    m_long_strings.emplace(std::string_view(chars + sizeof(size), size), chars);
+    return chars;
+}
+
+void DiveArgStore::Fill(uint32_t index, uint32_t key, const nlohmann::ordered_json& value)
+{
+    // Nodes never move once allocated, so the reference stays valid while children are added.
+    Node& node = GetNode(index);
+    node.key = key;
+
+    switch (value.type())
+    {
+        case nlohmann::ordered_json::value_t::boolean:
+            node.type = Type::kBool;
+            node.value.b = value.get<bool>();
+            break;
+        case nlohmann::ordered_json::value_t::number_integer:
+            node.type = Type::kInt;
+            node.value.i = value.get<int64_t>();
+            break;
+        case nlohmann::ordered_json::value_t::number_unsigned:
+            node.type = Type::kUint;
+            node.value.u = value.get<uint64_t>();
+            break;
+        case nlohmann::ordered_json::value_t::number_float:
+            node.type = Type::kFloat;
+            node.value.f = value.get<double>();
+            break;
+        case nlohmann::ordered_json::value_t::string:
+        {
+            const std::string& str = value.get_ref<const std::string&>();
+            node.type = Type::kString;
+            if (str.size() <= kInlineStringSize)
+            {
+                node.string_size = static_cast<uint8_t>(str.size());
+                std::memcpy(node.value.chars, str.data(), str.size());
+            }
+            else
+            {
+                node.string_size = kInlineStringSize + 1;
+                node.value.long_string = StoreLongString(str);
+            }
+            break;
+        }
+        case nlohmann::ordered_json::value_t::object:
+        case nlohmann::ordered_json::value_t::array:
+        {
+            bool is_object = value.is_object();
+            uint32_t count = static_cast<uint32_t>(value.size());
+            uint32_t first = AllocateNodes(count);
+            node.type = is_object ? Type::kObject : Type::kArray;
+            node.value.children.first = first;
+            node.value.children.count = count;
+
+            uint32_t child_index = first;
+            if (is_object)
+            {
+                for (const auto& [child_key, child_value] : value.items())
+                {
+                    Fill(child_index++, InternKey(child_key), child_value);
+                }
+            }
+            else
+            {
+                for (const auto& child_value : value)
+                {
+                    Fill(child_index++, kNoKey, child_value);
+                }
+            }
+            break;
+        }
+        case nlohmann::ordered_json::value_t::binary:
+            GFXRECON_LOG_WARNING("DiveArgStore does not keep binary values, storing null");
+            node.type = Type::kNull;
+            break;
+        default:
+            node.type = Type::kNull;
+            break;
+    }
+}
+
+GFXRECON_END_NAMESPACE(decode)
+GFXRECON_END_NAMESPACE(gfxrecon)
@@ -0,0 +1,280 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// The DiveArgStore keeps the args of all the vulkan commands of a capture in a compact form. A
+// nlohmann::ordered_json object costs a heap allocated vector, plus a std::string key and a 16 byte
+// value per member, which adds up to gigabytes for large captures. The store instead packs every
+// value in a 16 byte node of a chunked arena, with the children of a container in consecutive
+// nodes, the keys and longer strings interned once for all the commands and the strings of up to 8
+// chars inline.
+//
+// Values are read through DiveArg, a view exposing the part of the nlohmann::json read API that the
+// command hierarchy needs.
+
+// NOLINT(build/header_guard)
+#ifndef GFXRECON_DECODE_DIVE_ARG_STORE_H
+#define GFXRECON_DECODE_DIVE_ARG_STORE_H
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+#include "util/defines.h"
+
+GFXRECON_BEGIN_NAMESPACE(gfxrecon)
+GFXRECON_BEGIN_NAMESPACE(decode)
+
+class DiveArgStore;
+
+// Read-only view of a value of a DiveArgStore. It is only valid as long as the store is. A default
+// constructed DiveArg is null.
+class DiveArg
+{
+ public:
+    struct Item;
+    class ItemIterator;
+    struct ItemRange;
+
+    DiveArg() = default;
+    DiveArg(const DiveArgStore* store, uint32_t index) : m_store(store), m_index(index) {}
+
+    bool is_null() const;
+    bool is_boolean() const;
+    bool is_number() const;
+    bool is_number_integer() const;
+    bool is_number_unsigned() const;
+    bool is_number_float() const;
+    bool is_string() const;
+    bool is_object() const;
+    bool is_array() const;
+    bool is_primitive() const { return !is_object() && !is_array(); }
+    bool is_structured() const { return is_object() || is_array(); }
+
+    // Same as nlohmann::json: the number of children of a container, 0 for null and 1 otherwise.
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+
+    bool contains(std::string_view key) const;
+    size_t count(std::string_view key) const { return contains(key) ? 1 : 0; }
+
+    // Unlike nlohmann::json, returns a null value rather than asserting when the key or the index
+    // is not there.
+    DiveArg operator[](std::string_view key) const;
+    DiveArg operator[](const char* key) const { return (*this)[std::string_view(key)]; }
+    template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    DiveArg operator[](T index) const
+    {
+        return At(static_cast<size_t>(index));
+    }
+
+    ItemRange items() const;
+
+    // Converts the value like nlohmann::json::get, with a default value (0, false or an empty
+    // string) rather than an exception when the types do not match.
+    template <typename T>
+    T get() const;
+
+    // Returns the chars of a string value without copying them.
+    std::string_view GetString() const;
+
+    // Same output as nlohmann::json::dump() with the default arguments.
+    std::string dump() const;
+
+    nlohmann::ordered_json ToJson() const;
+
+ private:
+    DiveArg At(size_t index) const;
+    void DumpTo(std::string& out) const;
+    static void DumpString(std::string_view str, std::string& out);
+
+    bool GetBool() const;
+    int64_t GetInt() const;
+    uint64_t GetUint() const;
+    double GetFloat() const;
+
+    const DiveArgStore* m_store = nullptr;
+    uint32_t m_index = 0;
+};
+
+struct DiveArg::Item
+{
+    std::string_view key;
+    DiveArg value;
+};
+
+// Iterates over the members of an object, or the elements of an array with empty keys.
+class DiveArg::ItemIterator
+{
+ public:
+    ItemIterator(const DiveArgStore* store, uint32_t index) : m_store(store), m_index(index) {}
+
+    Item operator*() const;
+    ItemIterator& operator++()
+    {
+        ++m_index;
+        return *this;
+    }
+    bool operator==(const ItemIterator& other) const { return m_index == other.m_index; }
+    bool operator!=(const ItemIterator& other) const { return m_index != other.m_index; }
+
+ private:
+    const DiveArgStore* m_store;
+    uint32_t m_index;
+};
+
+struct DiveArg::ItemRange
+{
+    ItemIterator begin() const { return first; }
+    ItemIterator end() const { return last; }
+
+    ItemIterator first;
+    ItemIterator last;
+};
+
+std::ostream& operator<<(std::ostream& os, const DiveArg& arg);
+
+class DiveArgStore
+{
+ public:
+    DiveArgStore() = default;
+    DiveArgStore(const DiveArgStore&) = delete;
+    DiveArgStore& operator=(const DiveArgStore&) = delete;
+
+    // Copies the value into the store. Binary values are stored as null, as the vulkan consumers
+    // never produce them.
+    DiveArg Add(const nlohmann::ordered_json& value);
+
+    // Number of values and distinct keys in the store.
+    size_t GetNodeCount() const { return m_node_count; }
+    size_t GetKeyCount() const { return m_keys.size(); }
+
+    // Bytes allocated by the store, not counting the key and string indices.
+    size_t GetAllocatedSize() const;
+
+ private:
+    friend class DiveArg;
+
+    enum class Type : uint8_t
+    {
+        kNull,
+        kBool,
+        kInt,
+        kUint,
+        kFloat,
+        kString,
+        kObject,
+        kArray,
+    };
+
+    static constexpr uint32_t kNoKey = UINT32_MAX;
+    static constexpr uint8_t kInlineStringSize = 8;
+    static constexpr uint32_t kNodesPerBlock = 1024;
+    static constexpr size_t kMinCharsPerBlock = 4 * 1024;
+    static constexpr size_t kMaxCharsPerBlock = 64 * 1024;
+
+    struct Node
+    {
+        union
+        {
+            bool b;
+            int64_t i;
+            uint64_t u;
+            double f;
+            char chars[kInlineStringSize];
+            // Strings longer than kInlineStringSize, prefixed by their uint32_t size.
+            const char* long_string;
+            struct
+            {
+                uint32_t first;
+                uint32_t count;
+            } children;
+        } value;
+        uint32_t key = kNoKey;
+        Type type = Type::kNull;
+        // Size of an inline string.
+        uint8_t string_size = 0;
+    };
+    static_assert(sizeof(Node) == 16);
+    static_assert(std::is_trivially_destructible_v<Node>);
+
+    // Returns the index of the first of count consecutive nodes.
+    uint32_t AllocateNodes(uint32_t count);
+    Node& GetNode(uint32_t index);
+    const Node& GetNode(uint32_t index) const;
+
+    uint32_t InternKey(const std::string& key);
+    const char* StoreLongString(const std::string& str);
+
+    void Fill(uint32_t index, uint32_t key, const nlohmann::ordered_json& value);
+
+    std::vector<std::unique_ptr<Node[]>> m_node_blocks;
+    size_t m_node_count = 0;
+
+    std::vector<std::unique_ptr<char[]>> m_char_blocks;
+    // The block that strings are appended to, strings larger than a block get their own one.
+    char* m_cur_char_block = nullptr;
+    size_t m_cur_char_block_size = 0;
+    size_t m_cur_char_block_used = 0;
+    size_t m_allocated_chars = 0;
+    // Long strings are stored once, and looked up by their chars in the blocks.
+    std::unordered_map<std::string_view, const char*> m_long_strings;
+
+    // A deque so that the string_view keys of m_key_indices stay valid.
+    std::deque<std::string> m_keys;
+    std::unordered_map<std::string_view, uint32_t> m_key_indices;
+};
+
+template <typename T>
+T DiveArg::get() const
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        return std::string(GetString());
+    }
+    else if constexpr (std::is_same_v<T, std::string_view>)
+    {
+        return GetString();
+    }
+    else if constexpr (std::is_same_v<T, bool>)
+    {
+        return GetBool();
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        return static_cast<T>(GetFloat());
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+    {
+        return static_cast<T>(GetInt());
+    }
+    else
+    {
+        static_assert(std::is_integral_v<T>, "Unsupported DiveArg::get type");
+        return static_cast<T>(GetUint());
+    }
+}
+
+GFXRECON_END_NAMESPACE(decode)
+GFXRECON_END_NAMESPACE(gfxrecon)
+
+#endif  // GFXRECON_DECODE_DIVE_ARG_STORE_H
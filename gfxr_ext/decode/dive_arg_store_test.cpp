@@ -0,0 +1,164 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_arg_store.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace gfxrecon::decode
+{
+namespace
+{
+
+nlohmann::ordered_json CreateRenderPassArgs()
+{
+    return {
+        {"commandBuffer", 1001},
+        {"pRenderPassBegin",
+         {{"sType", "VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO"},
+          {"pNext", nullptr},
+          {"renderArea", {{"offset", {{"x", 0}, {"y", -4}}}, {"extent", 1.5}}},
+          {"clearValueCount", 2u},
+          {"pClearValues", {{{"color", "red"}}, {{"depth", 1.0}}}}}},
+        {"contents", "VK_SUBPASS_CONTENTS_INLINE"},
+        {"enabled", true},
+    };
+}
+
+TEST(DiveArgStoreTest, RoundTripsJson)
+{
+    DiveArgStore store;
+    nlohmann::ordered_json args = CreateRenderPassArgs();
+    DiveArg arg = store.Add(args);
+
+    EXPECT_EQ(arg.ToJson(), args);
+    EXPECT_EQ(arg.dump(), args.dump());
+    EXPECT_EQ(store.Add(nlohmann::ordered_json()).ToJson(), nlohmann::ordered_json());
+    EXPECT_EQ(store.Add(nlohmann::ordered_json::object()).ToJson(),
+              nlohmann::ordered_json::object());
+    EXPECT_EQ(store.Add(nlohmann::ordered_json::array()).ToJson(), nlohmann::ordered_json::array());
+}
+
+TEST(DiveArgStoreTest, DumpsLikeJson)
+{
+    DiveArgStore store;
+    nlohmann::ordered_json args = {
+        {"pLabelName", "quote \" backslash \\ tab \t"},
+        {"pApplicationName", "caf\u00e9"},
+        {"control", std::string("\x01\x1f", 2)},
+        {"floats", {0.0, -2.5, 1e-7, 3.0e20}},
+        {"nested",
+         {{{"empty", nlohmann::ordered_json::object()}}, nlohmann::ordered_json::array()}},
+    };
+    DiveArg arg = store.Add(args);
+
+    EXPECT_EQ(arg.dump(), args.dump());
+    for (const auto& [key, value] : arg.items())
+    {
+        EXPECT_EQ(value.dump(), args[std::string(key)].dump()) << key;
+    }
+}
+
+TEST(DiveArgStoreTest, ReadsLikeJson)
+{
+    DiveArgStore store;
+    DiveArg arg = store.Add(CreateRenderPassArgs());
+
+    ASSERT_TRUE(arg.is_object());
+    EXPECT_EQ(arg.size(), 4);
+    EXPECT_EQ(arg.count("commandBuffer"), 1);
+    EXPECT_EQ(arg["commandBuffer"].get<uint64_t>(), 1001);
+
+    DiveArg begin = arg["pRenderPassBegin"];
+    EXPECT_TRUE(begin.contains("pNext"));
+    EXPECT_TRUE(begin["pNext"].is_null());
+    EXPECT_FALSE(begin.contains("missing"));
+    EXPECT_TRUE(begin["missing"].is_null());
+    EXPECT_TRUE(begin["missing"]["deeper"].is_null());
+    EXPECT_EQ(begin["renderArea"]["offset"]["y"].get<int32_t>(), -4);
+    EXPECT_TRUE(begin["clearValueCount"].is_number_unsigned());
+    EXPECT_DOUBLE_EQ(begin["renderArea"]["extent"].get<double>(), 1.5);
+
+    DiveArg clear_values = begin["pClearValues"];
+    ASSERT_TRUE(clear_values.is_array());
+    ASSERT_EQ(clear_values.size(), 2);
+    EXPECT_EQ(clear_values[0]["color"].get<std::string>(), "red");
+    EXPECT_TRUE(clear_values[2].is_null());
+
+    // Strings longer than the inline size live in the char blocks.
+    EXPECT_EQ(begin["sType"].get<std::string>(), "VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO");
+    EXPECT_TRUE(arg["enabled"].get<bool>());
+
+    std::vector<std::string> keys;
+    for (const auto& [key, value] : arg.items())
+    {
+        EXPECT_FALSE(value.is_null());
+        keys.emplace_back(key);
+    }
+    EXPECT_EQ(keys, std::vector<std::string>(
+                        {"commandBuffer", "pRenderPassBegin", "contents", "enabled"}));
+
+    std::ostringstream stream;
+    stream << arg["contents"] << " " << arg["commandBuffer"];
+    EXPECT_EQ(stream.str(), "\"VK_SUBPASS_CONTENTS_INLINE\" 1001");
+}
+
+TEST(DiveArgStoreTest, InternsKeysAcrossValues)
+{
+    DiveArgStore store;
+    std::vector<DiveArg> args;
+    for (int i = 0; i < 10000; ++i)
+    {
+        args.push_back(store.Add({{"commandBuffer", i}, {"firstVertex", i * 3}}));
+    }
+
+    EXPECT_EQ(store.GetKeyCount(), 2);
+    EXPECT_EQ(store.GetNodeCount(), 30000);
+    // Values added earlier stay valid as the store grows past several blocks.
+    for (int i = 0; i < 10000; ++i)
+    {
+        EXPECT_EQ(args[i]["firstVertex"].get<int>(), i * 3);
+    }
+}
+
+TEST(DiveArgStoreTest, StoresStringsLargerThanABlock)
+{
+    DiveArgStore store;
+    std::string small(100, 's');
+    std::string large(200 * 1024, 'l');
+    DiveArg small_arg = store.Add(small);
+    DiveArg large_arg = store.Add(large);
+    DiveArg next_arg = store.Add(small + "next");
+
+    EXPECT_EQ(small_arg.GetString(), small);
+    EXPECT_EQ(large_arg.GetString(), large);
+    EXPECT_EQ(next_arg.GetString(), small + "next");
+}
+
+TEST(DiveArgStoreTest, StoresRepeatedStringsOnce)
+{
+    DiveArgStore store;
+    DiveArg first = store.Add("VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL");
+    DiveArg second = store.Add("VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL");
+
+    EXPECT_EQ(first.GetString(), second.GetString());
+    EXPECT_EQ(first.GetString().data(), second.GetString().data());
+}
+
+}  // namespace
+}  // namespace gfxrecon::decode
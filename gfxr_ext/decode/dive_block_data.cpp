@@ -109,6 +109,19 @@ bool DiveBlockData::AddOriginalBlock(size_t index, uint64_t offset)
     return true;
 }
 
+bool DiveBlockData::GetOriginalBlockOffset(size_t index, uint64_t& offset) const
+{
+    if (index >= original_blocks_map_.size())
+    {
+        GFXRECON_LOG_ERROR("Original block with id (%d) does not exist, block count: %d", index,
+                           original_blocks_map_.size());
+        return false;
+    }
+
+    offset = original_blocks_map_[index]->offset_;
+    return true;
+}
+
 bool DiveBlockData::FinalizeOriginalBlocksMapSizes(uint64_t file_size)
 {
     if (original_blocks_map_locked_)
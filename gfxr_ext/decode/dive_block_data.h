@@ -121,6 +121,9 @@ class DiveBlockData
     bool FinalizeOriginalBlocksMapSizes(uint64_t file_size);
     bool IsOriginalBlocksMapLocked() const { return original_blocks_map_locked_; }
 
+    // Get the offset of a block in the original GFXR file, e.g. to decode it again later
+    bool GetOriginalBlockOffset(size_t index, uint64_t& offset) const;
+
     // Add or edit modifications
     bool ModificationExists(uint32_t primary_id, int32_t secondary_id) const;
     bool AddModification(uint32_t primary_id, int32_t secondary_id,
@@ -89,6 +89,27 @@ bool DiveFileProcessor::WriteFile(const std::string& name, const std::string& co
     return true;
 }
 
+bool DiveFileProcessor::ProcessBlockAt(uint64_t block_index, uint64_t offset)
+{
+    if (file_stack_.empty() || block_index == 0)
+    {
+        GFXRECON_LOG_ERROR("Cannot process block %d: no file or invalid block index", block_index);
+        return false;
+    }
+
+    if (!SeekActiveFile(file_stack_.back().active_file, static_cast<int64_t>(offset),
+                        util::platform::FileSeekSet))
+    {
+        GFXRECON_LOG_ERROR("Failed to seek to block %d at offset %d", block_index, offset);
+        return false;
+    }
+
+    block_index_ = block_index;
+    // Returns false once the block limit is passed, so only the error state tells about failures.
+    ProcessNextFrame();
+    return GetErrorState() == kErrorNone;
+}
+
 bool DiveFileProcessor::ProcessFrameDelimiter(const FrameEndMarkerArgs& end_frame)
 {
     // current_frame_number_ increments during single frame looping despite the frame number staying
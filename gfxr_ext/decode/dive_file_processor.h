@@ -33,6 +33,12 @@ GFXRECON_BEGIN_NAMESPACE(decode)
 class DiveFileProcessor : public FileProcessor
 {
  public:
+    DiveFileProcessor() = default;
+
+    // Decoding stops after the block at index block_limit, see ProcessBlockAt. A limit of 0 means
+    // no limit.
+    explicit DiveFileProcessor(uint64_t block_limit) : FileProcessor(block_limit) {}
+
     void SetLoopSingleFrameCount(uint64_t loop_single_frame_count);
 
     void SetDiveBlockData(std::shared_ptr<DiveBlockData> p_block_data);
@@ -41,6 +47,11 @@ class DiveFileProcessor : public FileProcessor
     // overwriting existing file if present
     bool WriteFile(const std::string& name, const std::string& content);
 
+    // Decodes the block at the given index and offset of the file passed to Initialize(). The
+    // processor must have been created with that index as block limit, so that decoding stops
+    // after the block; block_index must therefore not be 0.
+    bool ProcessBlockAt(uint64_t block_index, uint64_t offset);
+
  protected:
     bool ProcessFrameDelimiter(const FrameEndMarkerArgs& end_frame) override;
 
@@ -164,6 +164,7 @@ void DiveVulkanReplayConsumer::Process_vkCreateDevice(
     }
 
     gpu_time_.SetEnable(enable_gpu_time_);
+    gpu_time_.SetDrawTimingEnable(enable_gpu_draw_timing_);
 
     VkDevice device = MapHandle<VulkanDeviceInfo>(*(pDevice->GetPointer()),
                                                   &CommonObjectInfoTable::GetVkDeviceInfo);
@@ -633,6 +634,101 @@ void DiveVulkanReplayConsumer::Process_vkCmdEndRenderPass2KHR(
     }
 }
 
+VkCommandBuffer DiveVulkanReplayConsumer::BeginDrawTiming(format::HandleId commandBuffer)
+{
+    VkCommandBuffer in_commandBuffer = MapHandle<VulkanCommandBufferInfo>(
+        commandBuffer, &CommonObjectInfoTable::GetVkCommandBufferInfo);
+
+    Dive::GPUTime::GpuTimeStatus status =
+        gpu_time_.OnCmdDrawBegin(in_commandBuffer, pfn_vkCmdWriteTimestamp_);
+    if (!status.success)
+    {
+        GFXRECON_LOG_ERROR(status.message.c_str());
+    }
+    return in_commandBuffer;
+}
+
+void DiveVulkanReplayConsumer::EndDrawTiming(VkCommandBuffer commandBuffer)
+{
+    Dive::GPUTime::GpuTimeStatus status =
+        gpu_time_.OnCmdDrawEnd(commandBuffer, pfn_vkCmdWriteTimestamp_);
+    if (!status.success)
+    {
+        GFXRECON_LOG_ERROR(status.message.c_str());
+    }
+}
+
+void DiveVulkanReplayConsumer::Process_vkCmdDraw(const ApiCallInfo& call_info,
+                                                 format::HandleId commandBuffer,
+                                                 uint32_t vertexCount, uint32_t instanceCount,
+                                                 uint32_t firstVertex, uint32_t firstInstance)
+{
+    VkCommandBuffer in_commandBuffer = BeginDrawTiming(commandBuffer);
+    VulkanReplayConsumer::Process_vkCmdDraw(call_info, commandBuffer, vertexCount, instanceCount,
+                                            firstVertex, firstInstance);
+    EndDrawTiming(in_commandBuffer);
+}
+
+void DiveVulkanReplayConsumer::Process_vkCmdDrawIndexed(const ApiCallInfo& call_info,
+                                                        format::HandleId commandBuffer,
+                                                        uint32_t indexCount,
+                                                        uint32_t instanceCount,
+                                                        uint32_t firstIndex, int32_t vertexOffset,
+                                                        uint32_t firstInstance)
+{
+    VkCommandBuffer in_commandBuffer = BeginDrawTiming(commandBuffer);
+    VulkanReplayConsumer::Process_vkCmdDrawIndexed(call_info, commandBuffer, indexCount,
+                                                   instanceCount, firstIndex, vertexOffset,
+                                                   firstInstance);
+    EndDrawTiming(in_commandBuffer);
+}
+
+void DiveVulkanReplayConsumer::Process_vkCmdDrawIndirect(const ApiCallInfo& call_info,
+                                                         format::HandleId commandBuffer,
+                                                         format::HandleId buffer,
+                                                         VkDeviceSize offset, uint32_t drawCount,
+                                                         uint32_t stride)
+{
+    VkCommandBuffer in_commandBuffer = BeginDrawTiming(commandBuffer);
+    VulkanReplayConsumer::Process_vkCmdDrawIndirect(call_info, commandBuffer, buffer, offset,
+                                                    drawCount, stride);
+    EndDrawTiming(in_commandBuffer);
+}
+
+void DiveVulkanReplayConsumer::Process_vkCmdDrawIndexedIndirect(const ApiCallInfo& call_info,
+                                                                format::HandleId commandBuffer,
+                                                                format::HandleId buffer,
+                                                                VkDeviceSize offset,
+                                                                uint32_t drawCount,
+                                                                uint32_t stride)
+{
+    VkCommandBuffer in_commandBuffer = BeginDrawTiming(commandBuffer);
+    VulkanReplayConsumer::Process_vkCmdDrawIndexedIndirect(call_info, commandBuffer, buffer,
+                                                           offset, drawCount, stride);
+    EndDrawTiming(in_commandBuffer);
+}
+
+void DiveVulkanReplayConsumer::Process_vkCmdDispatch(const ApiCallInfo& call_info,
+                                                     format::HandleId commandBuffer,
+                                                     uint32_t groupCountX, uint32_t groupCountY,
+                                                     uint32_t groupCountZ)
+{
+    VkCommandBuffer in_commandBuffer = BeginDrawTiming(commandBuffer);
+    VulkanReplayConsumer::Process_vkCmdDispatch(call_info, commandBuffer, groupCountX, groupCountY,
+                                                groupCountZ);
+    EndDrawTiming(in_commandBuffer);
+}
+
+void DiveVulkanReplayConsumer::Process_vkCmdDispatchIndirect(const ApiCallInfo& call_info,
+                                                             format::HandleId commandBuffer,
+                                                             format::HandleId buffer,
+                                                             VkDeviceSize offset)
+{
+    VkCommandBuffer in_commandBuffer = BeginDrawTiming(commandBuffer);
+    VulkanReplayConsumer::Process_vkCmdDispatchIndirect(call_info, commandBuffer, buffer, offset);
+    EndDrawTiming(in_commandBuffer);
+}
+
 void DiveVulkanReplayConsumer::Process_vkCreateFence(
     const ApiCallInfo& call_info, VkResult returnValue, format::HandleId device,
     StructPointerDecoder<Decoded_VkFenceCreateInfo>* pCreateInfo,
@@ -133,6 +133,31 @@ class DiveVulkanReplayConsumer : public VulkanReplayConsumer
         const ApiCallInfo& call_info, format::HandleId commandBuffer,
         StructPointerDecoder<Decoded_VkSubpassEndInfo>* pSubpassEndInfo) override;
 
+    void Process_vkCmdDraw(const ApiCallInfo& call_info, format::HandleId commandBuffer,
+                           uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex,
+                           uint32_t firstInstance) override;
+
+    void Process_vkCmdDrawIndexed(const ApiCallInfo& call_info, format::HandleId commandBuffer,
+                                  uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+                                  int32_t vertexOffset, uint32_t firstInstance) override;
+
+    void Process_vkCmdDrawIndirect(const ApiCallInfo& call_info, format::HandleId commandBuffer,
+                                   format::HandleId buffer, VkDeviceSize offset,
+                                   uint32_t drawCount, uint32_t stride) override;
+
+    void Process_vkCmdDrawIndexedIndirect(const ApiCallInfo& call_info,
+                                          format::HandleId commandBuffer,
+                                          format::HandleId buffer, VkDeviceSize offset,
+                                          uint32_t drawCount, uint32_t stride) override;
+
+    void Process_vkCmdDispatch(const ApiCallInfo& call_info, format::HandleId commandBuffer,
+                               uint32_t groupCountX, uint32_t groupCountY,
+                               uint32_t groupCountZ) override;
+
+    void Process_vkCmdDispatchIndirect(const ApiCallInfo& call_info,
+                                       format::HandleId commandBuffer, format::HandleId buffer,
+                                       VkDeviceSize offset) override;
+
     void Process_vkCreateFence(const ApiCallInfo& call_info, VkResult returnValue,
                                format::HandleId device,
                                StructPointerDecoder<Decoded_VkFenceCreateInfo>* pCreateInfo,
@@ -164,12 +189,23 @@ class DiveVulkanReplayConsumer : public VulkanReplayConsumer
 
     void SetEnableGPUTime(bool enable) { enable_gpu_time_ = enable; }
 
+    // Also time every draw and dispatch, on top of the cmds and render passes. Only used if gpu
+    // time is enabled, and needs to be set before the device is created
+    void SetEnableGPUDrawTiming(bool enable) { enable_gpu_draw_timing_ = enable; }
+
+    // Clears the gpu time metrics collected so far, so it is meant to be set before replay starts
+    void SetGPUTimeMetricsMode(Dive::GPUTime::MetricsMode mode) { gpu_time_.SetMetricsMode(mode); }
+
     std::string GetGPUTimeStatsCSVStr() const
     {
         return gpu_time_stats_csv_header_str_ + gpu_time_stats_csv_str_;
     }
 
  private:
+    // Wrap the replay of a draw or dispatch with timestamps, if draw timing is enabled
+    VkCommandBuffer BeginDrawTiming(format::HandleId commandBuffer);
+    void EndDrawTiming(VkCommandBuffer commandBuffer);
+
     // Keeps the fences status after setup phase
     enum class FenceStatus
     {
@@ -201,6 +237,7 @@ class DiveVulkanReplayConsumer : public VulkanReplayConsumer
     PFN_vkResetFences pfn_vkResetFences_ = nullptr;
     PFN_vkGetFenceFdKHR pfn_vkGetFenceFdKHR_ = nullptr;
     bool enable_gpu_time_ = false;
+    bool enable_gpu_draw_timing_ = false;
     // This is a flag that indicates if the Setup Phase is finised or not for gfx Replay
     // The Setup Phase is done when StateEndMarker is triggered
     bool setup_finished_ = false;
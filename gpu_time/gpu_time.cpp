@@ -39,6 +39,7 @@ GPUTime::~GPUTime()
     {
         m_destroy_query_pool(m_device, m_query_pool, m_allocator);
     }
+    DestroyDrawQueryPools();
 }
 
 GPUTime::TimeStampSlotAllocator::TimeStampSlotAllocator() { Reset(); }
@@ -113,21 +114,273 @@ void GPUTime::TimeStampSlotAllocator::FreeSlots(const std::vector<uint32_t>& slo
     }
 }
 
+thread_local GPUTime::CommandBufferTable::ThreadCache
+    GPUTime::CommandBufferTable::s_thread_cache;
+std::atomic<uint64_t> GPUTime::CommandBufferTable::s_next_table_id = 1;
+
+GPUTime::CommandBufferTable::CommandBufferTable() :
+    m_table_id(s_next_table_id.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+GPUTime::CommandBufferInfo* GPUTime::CommandBufferTable::Find(VkCommandBuffer cmd)
+{
+    // Recording a cmd looks it up for every command, usually from the same thread
+    ThreadCache& cache = s_thread_cache;
+    const uint64_t generation = m_generation.load(std::memory_order_acquire);
+    if ((cache.table_id == m_table_id) && (cache.cmd == cmd) && (cache.generation == generation))
+    {
+        return cache.info;
+    }
+
+    Shard& shard = GetShard(cmd);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.cmds.find(cmd);
+    if (it == shard.cmds.end())
+    {
+        return nullptr;
+    }
+    cache = ThreadCache{m_table_id, generation, cmd, it->second.get()};
+    return it->second.get();
+}
+
+bool GPUTime::CommandBufferTable::Insert(VkCommandBuffer cmd, const CommandBufferInfo& info)
+{
+    Shard& shard = GetShard(cmd);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.cmds.emplace(cmd, std::make_unique<CommandBufferInfo>(info)).second;
+}
+
+void GPUTime::CommandBufferTable::Erase(VkCommandBuffer cmd)
+{
+    Shard& shard = GetShard(cmd);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (shard.cmds.erase(cmd) != 0)
+    {
+        m_generation.fetch_add(1, std::memory_order_release);
+    }
+}
+
+std::vector<VkCommandBuffer> GPUTime::CommandBufferTable::GetPoolCmds(VkCommandPool pool)
+{
+    std::vector<VkCommandBuffer> cmds;
+    for (Shard& shard : m_shards)
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto& [cmd, info] : shard.cmds)
+        {
+            if (info->pool == pool)
+            {
+                cmds.push_back(cmd);
+            }
+        }
+    }
+    return cmds;
+}
+
+void GPUTime::CommandBufferTable::ErasePoolCmds(VkCommandPool pool)
+{
+    for (Shard& shard : m_shards)
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        const size_t erased =
+            std::erase_if(shard.cmds, [pool](const auto& it) { return it.second->pool == pool; });
+        if (erased != 0)
+        {
+            m_generation.fetch_add(1, std::memory_order_release);
+        }
+    }
+}
+
+GPUTime::CommandBufferTable::Shard& GPUTime::CommandBufferTable::GetShard(VkCommandBuffer cmd)
+{
+    // Handles are aligned pointers, so mix the bits before picking a shard
+    const uint64_t hash = reinterpret_cast<uintptr_t>(cmd) * 0x9E3779B97F4A7C15ull;
+    return m_shards[(hash >> 32) % kNumShards];
+}
+
+StreamingStatistics::StreamingStatistics()
+{
+    const double gamma = (1.0 + kRelativeAccuracy) / (1.0 - kRelativeAccuracy);
+    m_log_gamma = std::log(gamma);
+}
+
+void StreamingStatistics::Add(double value)
+{
+    // Welford's online algorithm
+    ++m_count;
+    const double delta = value - m_mean;
+    m_mean += delta / m_count;
+    m_m2 += delta * (value - m_mean);
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+
+    if (value <= std::numeric_limits<double>::min())
+    {
+        ++m_zero_count;
+        return;
+    }
+    ++m_buckets[GetBucketIndex(value)];
+    if (m_buckets.size() > kMaxBuckets)
+    {
+        CollapseLowestBuckets();
+    }
+}
+
+void StreamingStatistics::Merge(const StreamingStatistics& other)
+{
+    if (other.m_count == 0)
+    {
+        return;
+    }
+
+    // Chan et al. parallel variant of Welford's algorithm
+    const uint64_t count = m_count + other.m_count;
+    const double delta = other.m_mean - m_mean;
+    m_mean += delta * other.m_count / count;
+    m_m2 += other.m_m2 + delta * delta * m_count * other.m_count / count;
+    m_count = count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+
+    m_zero_count += other.m_zero_count;
+    for (const auto& [index, bucket_count] : other.m_buckets)
+    {
+        m_buckets[index] += bucket_count;
+    }
+    while (m_buckets.size() > kMaxBuckets)
+    {
+        CollapseLowestBuckets();
+    }
+}
+
+void StreamingStatistics::Reset()
+{
+    m_zero_count = 0;
+    m_buckets.clear();
+    m_count = 0;
+    m_mean = 0.0;
+    m_m2 = 0.0;
+    m_min = std::numeric_limits<double>::max();
+    m_max = std::numeric_limits<double>::lowest();
+}
+
+double StreamingStatistics::GetStdDev() const
+{
+    if (m_count < 2)
+    {
+        return 0.0;
+    }
+    return std::sqrt(m_m2 / (m_count - 1));
+}
+
+double StreamingStatistics::GetQuantile(double q) const
+{
+    if (m_count == 0)
+    {
+        return 0.0;
+    }
+
+    const double rank = std::clamp(q, 0.0, 1.0) * (m_count - 1);
+    uint64_t cumulative_count = m_zero_count;
+    double value = 0.0;
+    if (static_cast<double>(cumulative_count) <= rank)
+    {
+        for (const auto& [index, bucket_count] : m_buckets)
+        {
+            cumulative_count += bucket_count;
+            if (static_cast<double>(cumulative_count) > rank)
+            {
+                value = GetBucketValue(index);
+                break;
+            }
+        }
+    }
+    // The exact min and max are known, which also makes a constant stream exact
+    return std::clamp(value, m_min, m_max);
+}
+
+int32_t StreamingStatistics::GetBucketIndex(double value) const
+{
+    return static_cast<int32_t>(std::ceil(std::log(value) / m_log_gamma));
+}
+
+double StreamingStatistics::GetBucketValue(int32_t index) const
+{
+    // Bucket i covers (gamma^(i-1), gamma^i], so this is within kRelativeAccuracy of both ends
+    const double gamma = std::exp(m_log_gamma);
+    return 2.0 * std::pow(gamma, index) / (gamma + 1.0);
+}
+
+void StreamingStatistics::CollapseLowestBuckets()
+{
+    // Keeps the accuracy of the higher quantiles, which matter the most for timings
+    auto lowest = m_buckets.begin();
+    auto next = std::next(lowest);
+    next->second += lowest->second;
+    m_buckets.erase(lowest);
+}
+
+void GPUTime::FrameMetrics::SetMode(MetricsMode mode)
+{
+    Reset();
+    m_mode = mode;
+}
+
 void GPUTime::FrameMetrics::AddFrameData(double frame_time, const std::vector<double>& cmd_time_vec,
                                          const std::vector<double>& renderpass_time_vec,
-                                         const std::vector<size_t>& cmd_renderpass_count_vec)
+                                         const std::vector<size_t>& cmd_renderpass_count_vec,
+                                         const std::vector<double>& draw_time_vec,
+                                         const std::vector<size_t>& cmd_draw_count_vec,
+                                         const std::vector<size_t>& draw_renderpass_count_vec)
 {
     // TODO(wangra): reset when there is a difference in number of cmds per frame
     // maybe we should expose the Reset and let the app decide when to reset
     size_t new_frame_cmd_count = cmd_time_vec.size();
     size_t new_frame_renderpass_count = renderpass_time_vec.size();
-    if ((m_cmd_time_vec.size() != new_frame_cmd_count) ||
-        (m_renderpass_time_vec.size() != new_frame_renderpass_count))
+    size_t new_frame_draw_count = draw_time_vec.size();
+    if ((GetFrameCmdCount() != new_frame_cmd_count) ||
+        (GetFrameRenderPassCount() != new_frame_renderpass_count) ||
+        (GetFrameDrawCount() != new_frame_draw_count) ||
+        (m_cmd_draw_count_vec != cmd_draw_count_vec))
     {
         Reset();
-        m_cmd_time_vec.resize(new_frame_cmd_count);
-        m_renderpass_time_vec.resize(new_frame_renderpass_count);
+        if (m_mode == MetricsMode::kStreaming)
+        {
+            m_streaming_cmd_time_vec.resize(new_frame_cmd_count);
+            m_streaming_renderpass_time_vec.resize(new_frame_renderpass_count);
+            m_streaming_draw_time_vec.resize(new_frame_draw_count);
+        }
+        else
+        {
+            m_cmd_time_vec.resize(new_frame_cmd_count);
+            m_renderpass_time_vec.resize(new_frame_renderpass_count);
+            m_draw_time_vec.resize(new_frame_draw_count);
+        }
         m_cmd_renderpass_count_vec = cmd_renderpass_count_vec;
+        m_cmd_draw_count_vec = cmd_draw_count_vec;
+        m_draw_renderpass_count_vec = draw_renderpass_count_vec;
+        m_cmd_draw_offset_vec.resize(cmd_draw_count_vec.size());
+        std::exclusive_scan(cmd_draw_count_vec.begin(), cmd_draw_count_vec.end(),
+                            m_cmd_draw_offset_vec.begin(), size_t{0});
+    }
+
+    if (m_mode == MetricsMode::kStreaming)
+    {
+        m_streaming_frame_time.Add(frame_time);
+        for (size_t i = 0; i < new_frame_cmd_count; ++i)
+        {
+            m_streaming_cmd_time_vec[i].Add(cmd_time_vec[i]);
+        }
+        for (size_t i = 0; i < new_frame_renderpass_count; ++i)
+        {
+            m_streaming_renderpass_time_vec[i].Add(renderpass_time_vec[i]);
+        }
+        for (size_t i = 0; i < new_frame_draw_count; ++i)
+        {
+            m_streaming_draw_time_vec[i].Add(draw_time_vec[i]);
+        }
+        return;
     }
 
     if (m_frame_time.size() == TimeStampSlotAllocator::kFrameMetricsLimit)
@@ -143,6 +396,11 @@ void GPUTime::FrameMetrics::AddFrameData(double frame_time, const std::vector<do
         {
             r.pop_front();
         }
+
+        for (auto& d : m_draw_time_vec)
+        {
+            d.pop_front();
+        }
     }
     m_frame_time.push_back(frame_time);
     for (size_t i = 0; i < new_frame_cmd_count; ++i)
@@ -153,6 +411,10 @@ void GPUTime::FrameMetrics::AddFrameData(double frame_time, const std::vector<do
     {
         m_renderpass_time_vec[i].push_back(renderpass_time_vec[i]);
     }
+    for (size_t i = 0; i < new_frame_draw_count; ++i)
+    {
+        m_draw_time_vec[i].push_back(draw_time_vec[i]);
+    }
 }
 
 GPUTime::Stats GPUTime::FrameMetrics::GetStatistics(const std::deque<double>& data) const
@@ -167,13 +429,32 @@ GPUTime::Stats GPUTime::FrameMetrics::GetStatistics(const std::deque<double>& da
         stats.max = std::max(stats.max, d);
     }
 
+    // Sort a copy once for all the percentiles, since data is const here
+    std::vector<double> sorted_data(data.begin(), data.end());
+    std::sort(sorted_data.begin(), sorted_data.end());
+
     stats.average = CalculateAverage(data);
-    stats.median = CalculateMedian(data);
+    stats.median = CalculatePercentile(sorted_data, 0.5);
+    stats.p90 = CalculatePercentile(sorted_data, 0.9);
+    stats.p99 = CalculatePercentile(sorted_data, 0.99);
     stats.stddev = CalculateStdDev(data, stats.average);
 
     return stats;
 }
 
+GPUTime::Stats GPUTime::FrameMetrics::GetStatistics(const StreamingStatistics& data) const
+{
+    Stats stats;
+    stats.min = data.GetMin();
+    stats.max = data.GetMax();
+    stats.average = data.GetAverage();
+    stats.median = data.GetQuantile(0.5);
+    stats.p90 = data.GetQuantile(0.9);
+    stats.p99 = data.GetQuantile(0.99);
+    stats.stddev = data.GetStdDev();
+    return stats;
+}
+
 double GPUTime::FrameMetrics::CalculateAverage(const std::deque<double>& data) const
 {
     if (data.empty())
@@ -189,31 +470,21 @@ double GPUTime::FrameMetrics::CalculateAverage(const std::deque<double>& data) c
     return sum / data.size();
 }
 
-double GPUTime::FrameMetrics::CalculateMedian(const std::deque<double>& data) const
+double GPUTime::FrameMetrics::CalculatePercentile(const std::vector<double>& sorted_data,
+                                                  double q) const
 {
-    if (data.empty())
+    if (sorted_data.empty())
     {
         return 0.0;
     }
 
-    // Create a mutable copy of the data to sort it,
-    // as the original m_frame_data is const in this const member function.
-    std::deque<double> sorted_data = data;
-    std::sort(sorted_data.begin(), sorted_data.end());
-
-    size_t size = sorted_data.size();
-    if (size % 2 == 0)
-    {
-        // Even number of elements: average of the two middle elements
-        double mid1 = sorted_data[(size / 2) - 1];
-        double mid2 = sorted_data[size / 2];
-        return (mid1 + mid2) / 2.0;
-    }
-    else
-    {
-        // Odd number of elements: the middle element
-        return sorted_data[size / 2];
-    }
+    // Interpolate between the closest ranks, so the median of an even number of elements is the
+    // average of the two middle elements
+    const double rank = q * (sorted_data.size() - 1);
+    const size_t lower = static_cast<size_t>(std::floor(rank));
+    const size_t upper = std::min(lower + 1, sorted_data.size() - 1);
+    const double fraction = rank - lower;
+    return sorted_data[lower] + (sorted_data[upper] - sorted_data[lower]) * fraction;
 }
 
 double GPUTime::FrameMetrics::CalculateStdDev(const std::deque<double>& data, double average) const
@@ -236,38 +507,93 @@ void GPUTime::FrameMetrics::Reset()
     m_frame_time.clear();
     m_cmd_time_vec.clear();
     m_renderpass_time_vec.clear();
+    m_draw_time_vec.clear();
+    m_cmd_draw_count_vec.clear();
+    m_cmd_draw_offset_vec.clear();
+    m_draw_renderpass_count_vec.clear();
+    m_streaming_frame_time.Reset();
+    m_streaming_cmd_time_vec.clear();
+    m_streaming_renderpass_time_vec.clear();
+    m_streaming_draw_time_vec.clear();
 }
 
 GPUTime::Stats GPUTime::FrameMetrics::GetFrameTimeStats() const
 {
+    if (m_mode == MetricsMode::kStreaming)
+    {
+        return GetStatistics(m_streaming_frame_time);
+    }
     return GetStatistics(m_frame_time);
 }
 
 GPUTime::Stats GPUTime::FrameMetrics::GetFrameCmdTimeStats(size_t index) const
 {
-    if (index >= m_cmd_time_vec.size())
+    if (index >= GetFrameCmdCount())
     {
         return GPUTime::Stats();
     }
+    if (m_mode == MetricsMode::kStreaming)
+    {
+        return GetStatistics(m_streaming_cmd_time_vec[index]);
+    }
     return GetStatistics(m_cmd_time_vec[index]);
 }
 
 GPUTime::Stats GPUTime::FrameMetrics::GetFrameRenderPassTimeStats(size_t index) const
 {
-    if (index >= m_renderpass_time_vec.size())
+    if (index >= GetFrameRenderPassCount())
     {
         return GPUTime::Stats();
     }
+    if (m_mode == MetricsMode::kStreaming)
+    {
+        return GetStatistics(m_streaming_renderpass_time_vec[index]);
+    }
     return GetStatistics(m_renderpass_time_vec[index]);
 }
 
-size_t GPUTime::FrameMetrics::GetFrameCmdCount() const { return m_cmd_time_vec.size(); }
+GPUTime::Stats GPUTime::FrameMetrics::GetFrameDrawTimeStats(size_t cmd_index,
+                                                            size_t draw_index) const
+{
+    if (draw_index >= GetCmdDrawCount(cmd_index))
+    {
+        return GPUTime::Stats();
+    }
+    const size_t index = m_cmd_draw_offset_vec[cmd_index] + draw_index;
+    if (m_mode == MetricsMode::kStreaming)
+    {
+        return GetStatistics(m_streaming_draw_time_vec[index]);
+    }
+    return GetStatistics(m_draw_time_vec[index]);
+}
+
+size_t GPUTime::FrameMetrics::GetFrameCmdCount() const
+{
+    if (m_mode == MetricsMode::kStreaming)
+    {
+        return m_streaming_cmd_time_vec.size();
+    }
+    return m_cmd_time_vec.size();
+}
 
 size_t GPUTime::FrameMetrics::GetFrameRenderPassCount() const
 {
+    if (m_mode == MetricsMode::kStreaming)
+    {
+        return m_streaming_renderpass_time_vec.size();
+    }
     return m_renderpass_time_vec.size();
 }
 
+size_t GPUTime::FrameMetrics::GetFrameDrawCount() const
+{
+    if (m_mode == MetricsMode::kStreaming)
+    {
+        return m_streaming_draw_time_vec.size();
+    }
+    return m_draw_time_vec.size();
+}
+
 size_t GPUTime::FrameMetrics::GetCmdRenderPassCount(size_t index) const
 {
     if (index >= m_cmd_renderpass_count_vec.size())
@@ -277,6 +603,24 @@ size_t GPUTime::FrameMetrics::GetCmdRenderPassCount(size_t index) const
     return m_cmd_renderpass_count_vec[index];
 }
 
+size_t GPUTime::FrameMetrics::GetCmdDrawCount(size_t index) const
+{
+    if (index >= m_cmd_draw_count_vec.size())
+    {
+        return 0;
+    }
+    return m_cmd_draw_count_vec[index];
+}
+
+size_t GPUTime::FrameMetrics::GetDrawRenderPassCount(size_t cmd_index, size_t draw_index) const
+{
+    if (draw_index >= GetCmdDrawCount(cmd_index))
+    {
+        return kInvalidRenderPassCount;
+    }
+    return m_draw_renderpass_count_vec[m_cmd_draw_offset_vec[cmd_index] + draw_index];
+}
+
 std::string GPUTime::GetStatsString() const
 {
     const Stats& stats = GetFrameTimeStats();
@@ -286,7 +630,9 @@ std::string GPUTime::GetStatsString() const
     auto PopulateStatsString = [&](std::stringstream& ss, const Stats& stats, int nLevel) {
         std::string indent(nLevel, '\t');
         ss << std::fixed << std::setprecision(2) << indent << "  Mean: " << stats.average << " ms\n"
-           << indent << "  Median: " << stats.median << " ms\n";
+           << indent << "  Median: " << stats.median << " ms\n"
+           << indent << "  P90: " << stats.p90 << " ms\n"
+           << indent << "  P99: " << stats.p99 << " ms\n";
     };
     PopulateStatsString(ss, stats, 0);
 
@@ -299,6 +645,21 @@ std::string GPUTime::GetStatsString() const
         ss << "\tCommandBuffer" << i << ": \n";
         PopulateStatsString(ss, cmd_stats, 1);
 
+        // Draws are listed under the render pass they follow, and are numbered per cmd
+        size_t draw_index = 0;
+        size_t draw_count = GetCmdDrawCount(i);
+        auto PopulateDrawsString = [&](size_t renderpass_count_before, int nLevel) {
+            std::string indent(nLevel, '\t');
+            while ((draw_index < draw_count) &&
+                   (m_metrics.GetDrawRenderPassCount(i, draw_index) == renderpass_count_before))
+            {
+                ss << indent << "Draw" << draw_index << ": \n";
+                PopulateStatsString(ss, GetFrameDrawTimeStats(i, draw_index), nLevel);
+                draw_index++;
+            }
+        };
+        PopulateDrawsString(0, 2);
+
         size_t renderpass_count = GetCmdRenderPassCount(i);
         for (size_t j = 0; j < renderpass_count; ++j)
         {
@@ -306,6 +667,7 @@ std::string GPUTime::GetStatsString() const
             ss << "\t\tRenderPass" << renderpass_index << ": \n";
             PopulateStatsString(ss, renderpass_stats, 2);
             renderpass_index++;
+            PopulateDrawsString(j + 1, 3);
         }
     }
 
@@ -323,6 +685,7 @@ std::string GPUTime::GetStatsCSVString() const
        << stats.average << "," << stats.median << "\n";
 
     size_t rp_index = 0;
+    size_t draw_id = 0;
     size_t cmd_count = m_metrics.GetFrameCmdCount();
     for (size_t cmd_index = 0; cmd_index < cmd_count; ++cmd_index)
     {
@@ -330,6 +693,24 @@ std::string GPUTime::GetStatsCSVString() const
         ss << std::fixed << std::setprecision(3) << "CommandBuffer," << std::to_string(cmd_index)
            << "," << cmd_stats.average << "," << cmd_stats.median << "\n";
 
+        // Rows follow the order of the commands in the cmd, so that they can be correlated with
+        // the capture. Draw ids are per frame, like the ids of the other objects
+        size_t draw_index = 0;
+        size_t draw_count = GetCmdDrawCount(cmd_index);
+        auto AddDrawRows = [&](size_t renderpass_count_before) {
+            while ((draw_index < draw_count) &&
+                   (m_metrics.GetDrawRenderPassCount(cmd_index, draw_index) ==
+                    renderpass_count_before))
+            {
+                const Stats& draw_stats = GetFrameDrawTimeStats(cmd_index, draw_index);
+                ss << std::fixed << std::setprecision(3) << "Draw," << std::to_string(draw_id)
+                   << "," << draw_stats.average << "," << draw_stats.median << "\n";
+                draw_index++;
+                draw_id++;
+            }
+        };
+        AddDrawRows(0);
+
         size_t rp_count = GetCmdRenderPassCount(cmd_index);
         for (size_t j = 0; j < rp_count; ++j)
         {
@@ -337,11 +718,17 @@ std::string GPUTime::GetStatsCSVString() const
             ss << std::fixed << std::setprecision(3) << "RenderPass," << std::to_string(rp_index)
                << "," << rp_stats.average << "," << rp_stats.median << "\n";
             rp_index++;
+            AddDrawRows(j + 1);
         }
     }
     return ss.str();
 }
 
+void GPUTime::SetFramesInFlight(uint32_t frames_in_flight)
+{
+    m_frames_in_flight = std::clamp(frames_in_flight, 1u, kMaxFramesInFlight);
+}
+
 GPUTime::GpuTimeStatus GPUTime::OnCreateDevice(VkDevice device,
                                                const VkAllocationCallbacks* allocator_ptr,
                                                float timestamp_period,
@@ -357,13 +744,14 @@ GPUTime::GpuTimeStatus GPUTime::OnCreateDevice(VkDevice device,
     m_allocator = allocator_ptr;
     m_device = device;
     m_timestamp_period = timestamp_period;
+    m_create_query_pool = pfn_create_query_pool;
     m_destroy_query_pool = pfn_destroy_query_pool;
 
     // Create a query pool for timestamps
     VkQueryPoolCreateInfo queryPoolInfo{};
     queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
     queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
-    queryPoolInfo.queryCount = TimeStampSlotAllocator::kTotalSlots;
+    queryPoolInfo.queryCount = TimeStampSlotAllocator::kTotalSlots * m_frames_in_flight;
 
     VkResult result = pfn_create_query_pool(m_device, &queryPoolInfo, m_allocator, &m_query_pool);
     if (result != VK_SUCCESS)
@@ -374,7 +762,7 @@ GPUTime::GpuTimeStatus GPUTime::OnCreateDevice(VkDevice device,
             false};
     }
 
-    pfn_reset_query_pool(m_device, m_query_pool, 0, TimeStampSlotAllocator::kTotalSlots);
+    pfn_reset_query_pool(m_device, m_query_pool, 0, queryPoolInfo.queryCount);
     return GPUTime::GpuTimeStatus();
 }
 
@@ -398,9 +786,11 @@ GPUTime::GpuTimeStatus GPUTime::OnDestroyDevice(VkDevice device,
             pfn_queue_wait_idle(q);
         }
         m_queues.clear();
+        m_pending_frames.clear();
 
         m_destroy_query_pool(m_device, m_query_pool, m_allocator);
         m_query_pool = VK_NULL_HANDLE;
+        DestroyDrawQueryPools();
         m_allocator = nullptr;
     }
     m_device = VK_NULL_HANDLE;
@@ -415,18 +805,7 @@ GPUTime::GpuTimeStatus GPUTime::OnDestroyCommandPool(VkCommandPool command_pool)
         return GPUTime::GpuTimeStatus();
     }
 
-    auto it = m_cmds.begin();
-    while (it != m_cmds.end())
-    {
-        if (it->second.pool == command_pool)
-        {
-            it = m_cmds.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
-    }
+    m_cmds.ErasePoolCmds(command_pool);
     return GPUTime::GpuTimeStatus();
 }
 
@@ -441,14 +820,6 @@ GPUTime::GpuTimeStatus GPUTime::OnAllocateCommandBuffers(
 
     for (uint32_t i = 0; i < allocate_info_ptr->commandBufferCount; ++i)
     {
-        if (m_cmds.find(command_buffers_ptr[i]) != m_cmds.end())
-        {
-            m_valid_frame = false;
-            std::stringstream ss;
-            ss << static_cast<void*>(command_buffers_ptr[i]) << " has been already added!";
-            return GPUTime::GpuTimeStatus{ss.str(), false};
-        }
-
         uint32_t begin_slot = m_timestamp_allocator.AllocateSlot();
         uint32_t end_slot = m_timestamp_allocator.AllocateSlot();
 
@@ -458,9 +829,18 @@ GPUTime::GpuTimeStatus GPUTime::OnAllocateCommandBuffers(
             return GPUTime::GpuTimeStatus{"Exceeded maximum number of query slots.", false};
         }
 
-        m_cmds.insert(
-            {command_buffers_ptr[i],
-             {{}, allocate_info_ptr->commandPool, begin_slot, end_slot, false, false, false}});
+        CommandBufferInfo info;
+        info.pool = allocate_info_ptr->commandPool;
+        info.begin_timestamp_offset = begin_slot;
+        info.end_timestamp_offset = end_slot;
+        if (!m_cmds.Insert(command_buffers_ptr[i], info))
+        {
+            m_timestamp_allocator.FreeSlots({begin_slot, end_slot});
+            m_valid_frame = false;
+            std::stringstream ss;
+            ss << static_cast<void*>(command_buffers_ptr[i]) << " has been already added!";
+            return GPUTime::GpuTimeStatus{ss.str(), false};
+        }
     }
     return GPUTime::GpuTimeStatus();
 }
@@ -470,22 +850,22 @@ GPUTime::GpuTimeStatus GPUTime::OnFreeCommandBuffers(uint32_t command_buffer_cou
 {
     for (uint32_t i = 0; i < command_buffer_count; ++i)
     {
-        if (m_cmds.find(command_buffers_ptr[i]) == m_cmds.end())
+        CommandBufferInfo* info = m_cmds.Find(command_buffers_ptr[i]);
+        if (info == nullptr)
         {
             // The cache doesn't contain secondary command buffers
             continue;
         }
-        m_timestamp_allocator.FreeSlots({m_cmds[command_buffers_ptr[i]].begin_timestamp_offset,
-                                         m_cmds[command_buffers_ptr[i]].end_timestamp_offset});
+        m_timestamp_allocator.FreeSlots({info->begin_timestamp_offset, info->end_timestamp_offset});
         RemoveCmdFromFrameCache(command_buffers_ptr[i]);
-        m_cmds.erase(command_buffers_ptr[i]);
+        m_cmds.Erase(command_buffers_ptr[i]);
     }
     return GPUTime::GpuTimeStatus();
 }
 
 GPUTime::GpuTimeStatus GPUTime::OnResetCommandBuffer(VkCommandBuffer command_buffer)
 {
-    if (m_cmds.find(command_buffer) == m_cmds.end())
+    if (m_cmds.Find(command_buffer) == nullptr)
     {
         // The cache doesn't contain secondary command buffers
         return GPUTime::GpuTimeStatus();
@@ -496,12 +876,9 @@ GPUTime::GpuTimeStatus GPUTime::OnResetCommandBuffer(VkCommandBuffer command_buf
 
 GPUTime::GpuTimeStatus GPUTime::OnResetCommandPool(VkCommandPool command_pool)
 {
-    for (auto& cmd : m_cmds)
+    for (VkCommandBuffer cmd : m_cmds.GetPoolCmds(command_pool))
     {
-        if (cmd.second.pool == command_pool)
-        {
-            RemoveCmdFromFrameCache(cmd.first);
-        }
+        RemoveCmdFromFrameCache(cmd);
     }
     return GPUTime::GpuTimeStatus();
 }
@@ -514,27 +891,31 @@ GPUTime::GpuTimeStatus GPUTime::OnBeginCommandBuffer(
     {
         return GPUTime::GpuTimeStatus();
     }
-    m_timestamp_allocator.FreeSlots(m_cmds[command_buffer].renderpass_slots);
-    m_cmds[command_buffer].renderpass_slots.clear();
-
-    if (m_cmds.find(command_buffer) == m_cmds.end())
+    CommandBufferInfo* info = m_cmds.Find(command_buffer);
+    if (info == nullptr)
     {
         // We do not insert timestamps into secondary command buffers
         return GPUTime::GpuTimeStatus();
     }
 
-    if (m_cmds[command_buffer].usage_one_submit)
+    m_timestamp_allocator.FreeSlots(info->renderpass_slots);
+    info->renderpass_slots.clear();
+    info->draw_queries.clear();
+    info->draw_renderpass_counts.clear();
+    info->draw_query_epoch = m_draw_query_epoch;
+
+    if (info->usage_one_submit)
     {
-        m_cmds[command_buffer].Reset();
+        info->Reset();
     }
 
-    m_cmds[command_buffer].usage_one_submit =
-        ((flags & VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT) != 0);
+    info->usage_one_submit = ((flags & VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT) != 0);
 
-    m_cmds[command_buffer].reusable = ((flags & VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT) != 0);
+    info->reusable = ((flags & VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT) != 0);
+    info->query_segment = m_query_segment;
 
     pfn_cmd_write_timestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_query_pool,
-                            m_cmds[command_buffer].begin_timestamp_offset);
+                            GetQueryIndex(info->begin_timestamp_offset));
     return GPUTime::GpuTimeStatus();
 }
 
@@ -546,14 +927,15 @@ GPUTime::GpuTimeStatus GPUTime::OnEndCommandBuffer(VkCommandBuffer command_buffe
         return GPUTime::GpuTimeStatus();
     }
 
-    if (m_cmds.find(command_buffer) == m_cmds.end())
+    const CommandBufferInfo* info = m_cmds.Find(command_buffer);
+    if (info == nullptr)
     {
         // We do not insert timestamps into secondary command buffers
         return GPUTime::GpuTimeStatus();
     }
 
     pfn_cmd_write_timestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_query_pool,
-                            m_cmds[command_buffer].end_timestamp_offset);
+                            GetQueryIndex(info->end_timestamp_offset));
     return GPUTime::GpuTimeStatus();
 }
 
@@ -561,6 +943,12 @@ GPUTime::GpuTimeStatus GPUTime::OnFrameBoundary(
     PFN_vkDeviceWaitIdle pfn_device_wait_idle, PFN_vkResetQueryPool pfn_reset_query_pool,
     PFN_vkGetQueryPoolResults pfn_get_query_pool_results)
 {
+    if (m_frames_in_flight > 1)
+    {
+        return OnPipelinedFrameBoundary(pfn_device_wait_idle, pfn_reset_query_pool,
+                                        pfn_get_query_pool_results);
+    }
+
     //  force sync to make sure the gpu is done with this frame
     pfn_device_wait_idle(m_device);
 
@@ -574,8 +962,9 @@ GPUTime::GpuTimeStatus GPUTime::OnFrameBoundary(
     m_frame_cmds.clear();
 
     pfn_reset_query_pool(m_device, m_query_pool, 0, TimeStampSlotAllocator::kTotalSlots);
+    GPUTime::GpuTimeStatus draw_status = ResetDrawQueries(pfn_reset_query_pool);
     m_valid_frame = true;
-    return update_status;
+    return update_status.success ? draw_status : update_status;
 }
 
 GPUTime::GpuTimeStatus GPUTime::UpdateFrameMetrics(
@@ -615,10 +1004,10 @@ GPUTime::GpuTimeStatus GPUTime::UpdateFrameMetrics(
                 {
                     // cmd may not be in the m_cmds when some cmds got deleted before submitting the
                     // frame boundary cmd
-                    if (m_cmds.find(cmd) != m_cmds.end())
+                    if (const CommandBufferInfo* info = m_cmds.Find(cmd))
                     {
-                        const uint32_t begin_timestamp_offset = m_cmds[cmd].begin_timestamp_offset;
-                        const uint32_t end_timestamp_offset = m_cmds[cmd].end_timestamp_offset;
+                        const uint32_t begin_timestamp_offset = info->begin_timestamp_offset;
+                        const uint32_t end_timestamp_offset = info->end_timestamp_offset;
                         uint64_t availability_end =
                             m_timestamps_with_availability[end_timestamp_offset * 2 + 1];
                         uint64_t availability_begin =
@@ -658,8 +1047,14 @@ GPUTime::GpuTimeStatus GPUTime::UpdateFrameMetrics(
                 size_t cmd_index = 0;
                 for (const auto& cmd : m_frame_cmds)
                 {
-                    const uint32_t begin_timestamp_offset = m_cmds[cmd].begin_timestamp_offset;
-                    const uint32_t end_timestamp_offset = m_cmds[cmd].end_timestamp_offset;
+                    const CommandBufferInfo* info = m_cmds.Find(cmd);
+                    if (info == nullptr)
+                    {
+                        ++cmd_index;
+                        continue;
+                    }
+                    const uint32_t begin_timestamp_offset = info->begin_timestamp_offset;
+                    const uint32_t end_timestamp_offset = info->end_timestamp_offset;
 
                     uint64_t availability_end =
                         m_timestamps_with_availability[end_timestamp_offset * 2 + 1];
@@ -693,44 +1088,34 @@ GPUTime::GpuTimeStatus GPUTime::UpdateFrameMetrics(
         }
     }
 
+    if (m_enable_draw_timing)
+    {
+        GPUTime::GpuTimeStatus draw_status = ReadDrawQueryResults(pfn_get_query_pool_results);
+        if (!draw_status.success)
+        {
+            m_valid_frame = false;
+            return draw_status;
+        }
+    }
+
     double frame_time = 0.0;
     std::vector<double> cmds_time;
     std::vector<double> renderpasses_time;
     std::vector<size_t> cmd_renderpass_count_vec;
-
-    auto GetTimeDuration = [&](uint32_t begin_offset, uint32_t end_offset,
-                               uint64_t timestamps_with_availability[]) -> std::optional<double> {
-        uint64_t availability_end = timestamps_with_availability[end_offset * 2 + 1];
-        uint64_t availability_begin = timestamps_with_availability[begin_offset * 2 + 1];
-
-        if ((availability_begin == 0) || (availability_end == 0))
-        {
-            // Return an empty optional to signal an invalid result
-            return std::nullopt;
-        }
-
-        // Calculate the elapsed time in nanoseconds
-        uint64_t elapsed_timestamp_increments = timestamps_with_availability[end_offset * 2] -
-                                                timestamps_with_availability[begin_offset * 2];
-        // m_timestamp_period is the number of nanoseconds per timestamp increment.
-        const double kNanoToMilli = 1.0 / 1000000.0;
-        double elapsed_time_in_ms =
-            static_cast<double>(elapsed_timestamp_increments) * m_timestamp_period * kNanoToMilli;
-
-        return elapsed_time_in_ms;
-    };
+    std::vector<double> draws_time;
+    std::vector<size_t> cmd_draw_count_vec;
+    std::vector<size_t> draw_renderpass_count_vec;
 
     for (const auto& cmd : m_frame_cmds)
     {
         // cmd may not be in the m_cmds when some cmds got deleted before submitting the frame
         // boundary cmd
-        if (m_cmds.find(cmd) != m_cmds.end())
+        if (const CommandBufferInfo* info = m_cmds.Find(cmd))
         {
-            const uint32_t begin_timestamp_offset = m_cmds[cmd].begin_timestamp_offset;
-            const uint32_t end_timestamp_offset = m_cmds[cmd].end_timestamp_offset;
+            const uint32_t begin_timestamp_offset = info->begin_timestamp_offset;
+            const uint32_t end_timestamp_offset = info->end_timestamp_offset;
 
-            auto elapsed_time_in_ms = GetTimeDuration(begin_timestamp_offset, end_timestamp_offset,
-                                                      m_timestamps_with_availability);
+            auto elapsed_time_in_ms = GetTimeDuration(begin_timestamp_offset, end_timestamp_offset);
 
             if (!elapsed_time_in_ms)
             {
@@ -746,17 +1131,15 @@ GPUTime::GpuTimeStatus GPUTime::UpdateFrameMetrics(
             cmds_time.push_back(elapsed_time_in_ms.value());
             frame_time += elapsed_time_in_ms.value();
 
-            const size_t renderpass_count = m_cmds[cmd].renderpass_slots.size();
+            const size_t renderpass_count = info->renderpass_slots.size();
             cmd_renderpass_count_vec.push_back(renderpass_count / 2);
             for (size_t r = 0; r < renderpass_count; r = r + 2)
             {
-                const uint32_t renderpass_begin_timestamp_offset = m_cmds[cmd].renderpass_slots[r];
-                const uint32_t renderpass_end_timestamp_offset =
-                    m_cmds[cmd].renderpass_slots[r + 1];
+                const uint32_t renderpass_begin_timestamp_offset = info->renderpass_slots[r];
+                const uint32_t renderpass_end_timestamp_offset = info->renderpass_slots[r + 1];
 
                 auto renderpass_elapsed_time_in_ms = GetTimeDuration(
-                    renderpass_begin_timestamp_offset, renderpass_end_timestamp_offset,
-                    m_timestamps_with_availability);
+                    renderpass_begin_timestamp_offset, renderpass_end_timestamp_offset);
 
                 if (!renderpass_elapsed_time_in_ms)
                 {
@@ -770,23 +1153,310 @@ GPUTime::GpuTimeStatus GPUTime::UpdateFrameMetrics(
                 }
                 renderpasses_time.push_back(renderpass_elapsed_time_in_ms.value());
             }
+
+            if (!m_enable_draw_timing)
+            {
+                continue;
+            }
+            if ((info->draw_query_epoch != m_draw_query_epoch) && !info->draw_queries.empty())
+            {
+                m_valid_frame = false;
+                std::stringstream ss;
+                ss << static_cast<void*>(cmd)
+                   << " is not recorded in the frame it is submitted in, which is not supported "
+                      "with draw timing!";
+                return GPUTime::GpuTimeStatus{ss.str(), false};
+            }
+            cmd_draw_count_vec.push_back(info->draw_queries.size());
+            for (size_t d = 0; d < info->draw_queries.size(); ++d)
+            {
+                const uint32_t draw_query = info->draw_queries[d];
+                if (draw_query == TimeStampSlotAllocator::kInvalidIndex)
+                {
+                    // The ring is grown at this frame boundary, so only this frame is lost
+                    m_valid_frame = false;
+                    return GPUTime::GpuTimeStatus{
+                        "Growing the draw query ring to " +
+                            std::to_string(m_draw_query_counter.load()) + " queries",
+                        false};
+                }
+                auto draw_elapsed_time_in_ms = GetTimeDuration(
+                    m_draw_timestamps_with_availability.data(), draw_query, draw_query + 1);
+                if (!draw_elapsed_time_in_ms)
+                {
+                    m_valid_frame = false;
+                    std::stringstream ss;
+                    ss << "Query result is not available for draw " << d << " in the cmd "
+                       << static_cast<void*>(cmd) << " Query:" << draw_query;
+                    return GPUTime::GpuTimeStatus{ss.str(), false};
+                }
+                draws_time.push_back(draw_elapsed_time_in_ms.value());
+                draw_renderpass_count_vec.push_back(info->draw_renderpass_counts[d]);
+            }
         }
     }
 
     if (m_valid_frame)
     {
-        m_metrics.AddFrameData(frame_time, cmds_time, renderpasses_time, cmd_renderpass_count_vec);
+        m_metrics.AddFrameData(frame_time, cmds_time, renderpasses_time, cmd_renderpass_count_vec,
+                               draws_time, cmd_draw_count_vec, draw_renderpass_count_vec);
+        m_last_measured_frame_index = m_frame_index;
     }
 
     return GPUTime::GpuTimeStatus();
 }
 
+GPUTime::GpuTimeStatus GPUTime::OnPipelinedFrameBoundary(
+    PFN_vkDeviceWaitIdle pfn_device_wait_idle, PFN_vkResetQueryPool pfn_reset_query_pool,
+    PFN_vkGetQueryPoolResults pfn_get_query_pool_results)
+{
+    // Invalid frames are kept as well, so that their segment is not reset while the gpu may still
+    // be writing to it
+    GPUTime::GpuTimeStatus status = AddPendingFrame();
+
+    m_frame_index++;
+    m_frame_cmds.clear();
+    m_query_segment = (m_query_segment + 1) % m_frames_in_flight;
+    m_valid_frame = true;
+
+    GPUTime::GpuTimeStatus read_status = ReadPendingFrames(pfn_get_query_pool_results);
+    if (!m_pending_frames.empty() && (m_pending_frames.front().query_segment == m_query_segment))
+    {
+        // The gpu is behind by all the segments, so wait for it before reusing the oldest one
+        pfn_device_wait_idle(m_device);
+        read_status = ReadPendingFrames(pfn_get_query_pool_results);
+        if (!m_pending_frames.empty() &&
+            (m_pending_frames.front().query_segment == m_query_segment))
+        {
+            read_status = GPUTime::GpuTimeStatus{
+                "Query results are not available for frame " +
+                    std::to_string(m_pending_frames.front().frame_index),
+                false};
+            m_pending_frames.pop_front();
+        }
+    }
+
+    pfn_reset_query_pool(m_device, m_query_pool,
+                         m_query_segment * TimeStampSlotAllocator::kTotalSlots,
+                         TimeStampSlotAllocator::kTotalSlots);
+    return status.success ? read_status : status;
+}
+
+GPUTime::GpuTimeStatus GPUTime::AddPendingFrame()
+{
+    PendingFrame frame;
+    frame.frame_index = m_frame_index;
+    frame.query_segment = m_query_segment;
+    frame.valid = m_valid_frame;
+
+    GPUTime::GpuTimeStatus status;
+    for (const auto& cmd : m_frame_cmds)
+    {
+        // cmd may not be in the m_cmds when some cmds got deleted before submitting the frame
+        // boundary cmd
+        const CommandBufferInfo* info = m_cmds.Find(cmd);
+        if (info == nullptr)
+        {
+            continue;
+        }
+
+        // The timestamps of a cmd recorded in an earlier frame are in a segment that may have been
+        // reset already
+        if (info->query_segment != m_query_segment)
+        {
+            frame.valid = false;
+            std::stringstream ss;
+            ss << static_cast<void*>(cmd)
+               << " is not recorded in the frame it is submitted in, which is not supported with "
+                  "multiple frames in flight!";
+            status = GPUTime::GpuTimeStatus{ss.str(), false};
+        }
+        frame.cmd_slots.push_back(info->begin_timestamp_offset);
+        frame.cmd_slots.push_back(info->end_timestamp_offset);
+        frame.cmd_renderpass_slots.push_back(info->renderpass_slots);
+    }
+    m_pending_frames.push_back(std::move(frame));
+    return status;
+}
+
+GPUTime::GpuTimeStatus GPUTime::ReadPendingFrames(
+    PFN_vkGetQueryPoolResults pfn_get_query_pool_results)
+{
+    constexpr size_t data_per_query = sizeof(uint64_t);          // For the result itself
+    constexpr size_t availability_per_query = sizeof(uint64_t);  // For the availability status
+    VkDeviceSize data_size =
+        TimeStampSlotAllocator::kTotalSlots * (data_per_query + availability_per_query);
+    constexpr VkDeviceSize stride = data_per_query + availability_per_query;
+
+    // Frames are completed by the gpu in order, so stop at the first one that is not available
+    while (!m_pending_frames.empty())
+    {
+        const PendingFrame& frame = m_pending_frames.front();
+        VkResult result = pfn_get_query_pool_results(
+            m_device, m_query_pool, frame.query_segment * TimeStampSlotAllocator::kTotalSlots,
+            TimeStampSlotAllocator::kTotalSlots, data_size, m_timestamps_with_availability, stride,
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+        // VK_NOT_READY is expected, since only the slots used in the frame are written
+        if ((result != VK_SUCCESS) && (result != VK_NOT_READY))
+        {
+            m_pending_frames.pop_front();
+            return GPUTime::GpuTimeStatus{"vkGetQueryPoolResults failed with VkResult: " +
+                                              std::to_string(static_cast<int>(result)),
+                                          false};
+        }
+
+        double frame_time = 0.0;
+        std::vector<double> cmds_time;
+        std::vector<double> renderpasses_time;
+        std::vector<size_t> cmd_renderpass_count_vec;
+        for (size_t c = 0; c < frame.cmd_renderpass_slots.size(); ++c)
+        {
+            auto elapsed_time_in_ms =
+                GetTimeDuration(frame.cmd_slots[c * 2], frame.cmd_slots[c * 2 + 1]);
+            if (!elapsed_time_in_ms)
+            {
+                return GPUTime::GpuTimeStatus();
+            }
+            cmds_time.push_back(elapsed_time_in_ms.value());
+            frame_time += elapsed_time_in_ms.value();
+
+            const std::vector<uint32_t>& renderpass_slots = frame.cmd_renderpass_slots[c];
+            cmd_renderpass_count_vec.push_back(renderpass_slots.size() / 2);
+            for (size_t r = 0; r + 1 < renderpass_slots.size(); r = r + 2)
+            {
+                auto renderpass_elapsed_time_in_ms =
+                    GetTimeDuration(renderpass_slots[r], renderpass_slots[r + 1]);
+                if (!renderpass_elapsed_time_in_ms)
+                {
+                    return GPUTime::GpuTimeStatus();
+                }
+                renderpasses_time.push_back(renderpass_elapsed_time_in_ms.value());
+            }
+        }
+
+        if (frame.valid)
+        {
+            m_metrics.AddFrameData(frame_time, cmds_time, renderpasses_time,
+                                   cmd_renderpass_count_vec);
+            m_last_measured_frame_index = frame.frame_index;
+        }
+        m_pending_frames.pop_front();
+    }
+    return GPUTime::GpuTimeStatus();
+}
+
+GPUTime::GpuTimeStatus GPUTime::ReadDrawQueryResults(
+    PFN_vkGetQueryPoolResults pfn_get_query_pool_results)
+{
+    constexpr VkDeviceSize stride = sizeof(uint64_t) * 2;  // The result and the availability status
+    const uint32_t query_count = std::min(m_draw_query_counter.load(), GetDrawQueryCapacity());
+    m_draw_timestamps_with_availability.resize(query_count * 2);
+
+    for (uint32_t first_query = 0; first_query < query_count; first_query += kDrawQueriesPerPool)
+    {
+        const uint32_t pool_query_count = std::min(kDrawQueriesPerPool, query_count - first_query);
+        VkResult result = pfn_get_query_pool_results(
+            m_device, m_draw_query_pools[first_query / kDrawQueriesPerPool], 0, pool_query_count,
+            pool_query_count * stride, m_draw_timestamps_with_availability.data() + first_query * 2,
+            stride, VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+        // VK_NOT_READY is checked per draw with the availability status
+        if ((result != VK_SUCCESS) && (result != VK_NOT_READY))
+        {
+            return GPUTime::GpuTimeStatus{"vkGetQueryPoolResults failed with VkResult: " +
+                                              std::to_string(static_cast<int>(result)),
+                                          false};
+        }
+    }
+    return GPUTime::GpuTimeStatus();
+}
+
+GPUTime::GpuTimeStatus GPUTime::ResetDrawQueries(PFN_vkResetQueryPool pfn_reset_query_pool)
+{
+    const uint32_t query_count = m_draw_query_counter.exchange(0);
+    const uint32_t pool_count = m_draw_query_pool_count.load(std::memory_order_relaxed);
+    const uint32_t required_pool_count =
+        (query_count + kDrawQueriesPerPool - 1) / kDrawQueriesPerPool;
+
+    for (uint32_t p = 0; p < std::min(pool_count, required_pool_count); ++p)
+    {
+        pfn_reset_query_pool(m_device, m_draw_query_pools[p], 0, kDrawQueriesPerPool);
+    }
+    m_draw_query_epoch++;
+
+    // Grow the ring for the next frames
+    for (uint32_t p = pool_count; p < std::min(required_pool_count, kMaxDrawQueryPools); ++p)
+    {
+        VkQueryPoolCreateInfo queryPoolInfo{};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount = kDrawQueriesPerPool;
+
+        VkQueryPool query_pool = VK_NULL_HANDLE;
+        VkResult result = m_create_query_pool(m_device, &queryPoolInfo, m_allocator, &query_pool);
+        if (result != VK_SUCCESS)
+        {
+            return GPUTime::GpuTimeStatus{
+                "vkCreateQueryPool failed for draw queries with VkResult: " +
+                    std::to_string(static_cast<int>(result)),
+                false};
+        }
+        pfn_reset_query_pool(m_device, query_pool, 0, kDrawQueriesPerPool);
+        m_draw_query_pools[p] = query_pool;
+        m_draw_query_pool_count.store(p + 1, std::memory_order_release);
+    }
+
+    if (required_pool_count > kMaxDrawQueryPools)
+    {
+        return GPUTime::GpuTimeStatus{
+            std::to_string(query_count / 2) + " draws exceed the maximum of " +
+                std::to_string(kMaxDrawQueryPools * kDrawQueriesPerPool / 2) + " timed draws",
+            false};
+    }
+    return GPUTime::GpuTimeStatus();
+}
+
+std::optional<double> GPUTime::GetTimeDuration(uint32_t begin_offset, uint32_t end_offset) const
+{
+    return GetTimeDuration(m_timestamps_with_availability, begin_offset, end_offset);
+}
+
+std::optional<double> GPUTime::GetTimeDuration(const uint64_t* timestamps_with_availability,
+                                               uint32_t begin_offset, uint32_t end_offset) const
+{
+    uint64_t availability_end = timestamps_with_availability[end_offset * 2 + 1];
+    uint64_t availability_begin = timestamps_with_availability[begin_offset * 2 + 1];
+
+    if ((availability_begin == 0) || (availability_end == 0))
+    {
+        // Return an empty optional to signal an invalid result
+        return std::nullopt;
+    }
+
+    // Calculate the elapsed time in nanoseconds
+    uint64_t elapsed_timestamp_increments = timestamps_with_availability[end_offset * 2] -
+                                            timestamps_with_availability[begin_offset * 2];
+    // m_timestamp_period is the number of nanoseconds per timestamp increment.
+    const double kNanoToMilli = 1.0 / 1000000.0;
+    double elapsed_time_in_ms =
+        static_cast<double>(elapsed_timestamp_increments) * m_timestamp_period * kNanoToMilli;
+
+    return elapsed_time_in_ms;
+}
+
 void GPUTime::RemoveCmdFromFrameCache(VkCommandBuffer cmd)
 {
     // Free any slots that were used for render pass timings within this command buffer
-    m_timestamp_allocator.FreeSlots(m_cmds[cmd].renderpass_slots);
-    m_cmds[cmd].renderpass_slots.clear();
-    m_cmds[cmd].Reset();
+    if (CommandBufferInfo* info = m_cmds.Find(cmd))
+    {
+        m_timestamp_allocator.FreeSlots(info->renderpass_slots);
+        info->renderpass_slots.clear();
+        info->draw_queries.clear();
+        info->draw_renderpass_counts.clear();
+        info->Reset();
+    }
+    std::lock_guard<std::mutex> lock(m_frame_mutex);
     auto& vec = m_frame_cmds;
     vec.erase(std::remove(vec.begin(), vec.end(), cmd), vec.end());
 }
@@ -801,6 +1471,7 @@ GPUTime::SubmitStatus GPUTime::OnQueueSubmit(uint32_t submit_count, const VkSubm
         return {GPUTime::GpuTimeStatus(), false};
     }
 
+    std::lock_guard<std::mutex> lock(m_frame_mutex);
     bool is_frame_boundary = false;
 
     if ((submits_ptr != nullptr) && (submits_ptr->pCommandBuffers != nullptr))
@@ -811,7 +1482,8 @@ GPUTime::SubmitStatus GPUTime::OnQueueSubmit(uint32_t submit_count, const VkSubm
             for (uint32_t c = 0; c < num_command_buffers; ++c)
             {
                 const auto& cmd = submits_ptr[i].pCommandBuffers[c];
-                if (m_cmds.find(cmd) == m_cmds.end())
+                const CommandBufferInfo* info = m_cmds.Find(cmd);
+                if (info == nullptr)
                 {
                     // We do not submit secondary command buffer
                     // All primary command buffers should be in the cache
@@ -821,15 +1493,15 @@ GPUTime::SubmitStatus GPUTime::OnQueueSubmit(uint32_t submit_count, const VkSubm
                     return {GPUTime::GpuTimeStatus{ss.str(), false}, false};
                 }
 
-                if (m_cmds[cmd].reusable)
+                if (info->reusable)
                 {
                     m_valid_frame = false;
                     std::stringstream ss;
                     ss << static_cast<void*>(cmd) << " Reusable cmd is not supported!";
-                    return {GPUTime::GpuTimeStatus{ss.str(), false}, m_cmds[cmd].is_frameboundary};
+                    return {GPUTime::GpuTimeStatus{ss.str(), false}, info->is_frameboundary};
                 }
 
-                if (m_cmds[cmd].is_frameboundary)
+                if (info->is_frameboundary)
                 {
                     is_frame_boundary = true;
                 }
@@ -875,6 +1547,7 @@ GPUTime::GpuTimeStatus GPUTime::OnQueuePresent(PFN_vkDeviceWaitIdle pfn_device_w
         return GPUTime::GpuTimeStatus();
     }
 
+    std::lock_guard<std::mutex> lock(m_frame_mutex);
     return OnFrameBoundary(pfn_device_wait_idle, pfn_reset_query_pool, pfn_get_query_pool_results);
 }
 
@@ -901,14 +1574,15 @@ GPUTime::GpuTimeStatus GPUTime::OnCmdInsertDebugUtilsLabelEXT(
     if (strcmp(kVulkanVrFrameDelimiterString, label_info_ptr->pLabelName) == 0)
     {
         // the Frame boundary should be always in a primary command buffer
-        if (m_cmds.find(command_buffer) == m_cmds.end())
+        CommandBufferInfo* info = m_cmds.Find(command_buffer);
+        if (info == nullptr)
         {
             m_valid_frame = false;
             std::stringstream ss;
             ss << static_cast<void*>(command_buffer) << " is not in the cmd cache!";
             return GPUTime::GpuTimeStatus{ss.str(), false};
         }
-        m_cmds[command_buffer].is_frameboundary = true;
+        info->is_frameboundary = true;
     }
     return GPUTime::GpuTimeStatus();
 }
@@ -949,7 +1623,79 @@ GPUTime::GpuTimeStatus GPUTime::OnCmdEndRenderPass2KHR(
     return EndRenderPass(command_buffer, pfn_cmd_write_timestamp);
 }
 
-void GPUTime::ClearFrameCache() { m_frame_cmds.clear(); }
+GPUTime::GpuTimeStatus GPUTime::OnCmdDrawBegin(VkCommandBuffer command_buffer,
+                                               PFN_vkCmdWriteTimestamp pfn_cmd_write_timestamp)
+{
+    if (!m_enable || !m_enable_draw_timing || (m_frames_in_flight > 1))
+    {
+        return GPUTime::GpuTimeStatus();
+    }
+    CommandBufferInfo* info = m_cmds.Find(command_buffer);
+    if (info == nullptr)
+    {
+        // We do not insert timestamps into secondary command buffers
+        return GPUTime::GpuTimeStatus();
+    }
+
+    const uint32_t draw_query = m_draw_query_counter.fetch_add(2);
+    info->draw_renderpass_counts.push_back((info->renderpass_slots.size() + 1) / 2);
+    if (draw_query + 2 > GetDrawQueryCapacity())
+    {
+        // Still counted, so that the ring is grown to fit the draws of this frame
+        info->draw_queries.push_back(TimeStampSlotAllocator::kInvalidIndex);
+        return GPUTime::GpuTimeStatus();
+    }
+    info->draw_queries.push_back(draw_query);
+    pfn_cmd_write_timestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                            m_draw_query_pools[draw_query / kDrawQueriesPerPool],
+                            draw_query % kDrawQueriesPerPool);
+    return GPUTime::GpuTimeStatus();
+}
+
+GPUTime::GpuTimeStatus GPUTime::OnCmdDrawEnd(VkCommandBuffer command_buffer,
+                                             PFN_vkCmdWriteTimestamp pfn_cmd_write_timestamp)
+{
+    if (!m_enable || !m_enable_draw_timing || (m_frames_in_flight > 1))
+    {
+        return GPUTime::GpuTimeStatus();
+    }
+    const CommandBufferInfo* info = m_cmds.Find(command_buffer);
+    if (info == nullptr)
+    {
+        // We do not insert timestamps into secondary command buffers
+        return GPUTime::GpuTimeStatus();
+    }
+    if (info->draw_queries.empty())
+    {
+        return GPUTime::GpuTimeStatus{"OnCmdDrawEnd is called before OnCmdDrawBegin!", false};
+    }
+
+    const uint32_t draw_query = info->draw_queries.back();
+    if (draw_query == TimeStampSlotAllocator::kInvalidIndex)
+    {
+        return GPUTime::GpuTimeStatus();
+    }
+    pfn_cmd_write_timestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                            m_draw_query_pools[draw_query / kDrawQueriesPerPool],
+                            (draw_query + 1) % kDrawQueriesPerPool);
+    return GPUTime::GpuTimeStatus();
+}
+
+void GPUTime::DestroyDrawQueryPools()
+{
+    const uint32_t pool_count = m_draw_query_pool_count.exchange(0);
+    for (uint32_t p = 0; p < pool_count; ++p)
+    {
+        m_destroy_query_pool(m_device, m_draw_query_pools[p], m_allocator);
+        m_draw_query_pools[p] = VK_NULL_HANDLE;
+    }
+}
+
+void GPUTime::ClearFrameCache()
+{
+    std::lock_guard<std::mutex> lock(m_frame_mutex);
+    m_frame_cmds.clear();
+}
 
 GPUTime::GpuTimeStatus GPUTime::BeginRenderPass(VkCommandBuffer command_buffer,
                                                 PFN_vkCmdWriteTimestamp pfn_cmd_write_timestamp)
@@ -958,9 +1704,16 @@ GPUTime::GpuTimeStatus GPUTime::BeginRenderPass(VkCommandBuffer command_buffer,
     {
         return GPUTime::GpuTimeStatus();
     }
+    CommandBufferInfo* info = m_cmds.Find(command_buffer);
+    if (info == nullptr)
+    {
+        // Render passes are only recorded in primary command buffers, which are all in the cache
+        return GPUTime::GpuTimeStatus();
+    }
     uint32_t slot = m_timestamp_allocator.AllocateSlot();
-    m_cmds[command_buffer].renderpass_slots.push_back(slot);
-    pfn_cmd_write_timestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_query_pool, slot);
+    info->renderpass_slots.push_back(slot);
+    pfn_cmd_write_timestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_query_pool,
+                            GetQueryIndex(slot));
     return GPUTime::GpuTimeStatus();
 }
 
@@ -971,10 +1724,16 @@ GPUTime::GpuTimeStatus GPUTime::EndRenderPass(VkCommandBuffer command_buffer,
     {
         return GPUTime::GpuTimeStatus();
     }
+    CommandBufferInfo* info = m_cmds.Find(command_buffer);
+    if (info == nullptr)
+    {
+        // Render passes are only recorded in primary command buffers, which are all in the cache
+        return GPUTime::GpuTimeStatus();
+    }
     uint32_t slot = m_timestamp_allocator.AllocateSlot();
-    m_cmds[command_buffer].renderpass_slots.push_back(slot);
+    info->renderpass_slots.push_back(slot);
     pfn_cmd_write_timestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_query_pool,
-                            slot);
+                            GetQueryIndex(slot));
     return GPUTime::GpuTimeStatus();
 }
 
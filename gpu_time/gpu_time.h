@@ -18,10 +18,16 @@ limitations under the License.
 
 #include <vulkan/vulkan_core.h>
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -29,15 +35,63 @@ limitations under the License.
 namespace Dive
 {
 
+// Bounded memory statistics over a stream of non-negative samples
+// Mean and stddev are exact (Welford), while quantiles come from a log-bucketed sketch (DDSketch),
+// so they are within kRelativeAccuracy of an actual sample value. Sketches can be merged
+class StreamingStatistics
+{
+ public:
+    static constexpr double kRelativeAccuracy = 0.01;
+    static constexpr size_t kMaxBuckets = 2048;
+
+    StreamingStatistics();
+    void Add(double value);
+    void Merge(const StreamingStatistics& other);
+    void Reset();
+
+    uint64_t GetCount() const { return m_count; }
+    double GetAverage() const { return m_mean; }
+    double GetStdDev() const;
+    double GetMin() const { return m_min; }
+    double GetMax() const { return m_max; }
+    // q is in [0, 1], e.g. 0.5 for the median
+    double GetQuantile(double q) const;
+
+ private:
+    int32_t GetBucketIndex(double value) const;
+    double GetBucketValue(int32_t index) const;
+    void CollapseLowestBuckets();
+
+    // Samples too small for a bucket, including 0
+    uint64_t m_zero_count = 0;
+    std::map<int32_t, uint64_t> m_buckets;
+    double m_log_gamma = 0.0;
+
+    uint64_t m_count = 0;
+    double m_mean = 0.0;
+    double m_m2 = 0.0;
+    double m_min = std::numeric_limits<double>::max();
+    double m_max = std::numeric_limits<double>::lowest();
+};
+
 // To use GPUTime, make sure to
 //     - Disable system gpu preemption
 //     - Insert "vr-marker,frame_end,type,application" as frame boundary
-// Note that the performance will drop due to vkDeviceWaitIdle
+// Note that the performance will drop due to vkDeviceWaitIdle, unless multiple frames in flight
+// are enabled with SetFramesInFlight()
+// Command buffers can be allocated, recorded and submitted from multiple threads, following the
+// external synchronization rules of Vulkan
 class GPUTime
 {
  public:
     static constexpr const char* kVulkanVrFrameDelimiterString =
         "vr-marker,frame_end,type,application";
+    static constexpr uint32_t kMaxFramesInFlight = 4;
+    static constexpr uint64_t kInvalidFrameIndex = static_cast<uint64_t>(-1);
+    // Each draw takes 2 consecutive queries of the draw query ring, which never straddle a pool
+    static constexpr uint32_t kDrawQueriesPerPool = 4096;
+    static constexpr uint32_t kMaxDrawQueryPools = 16;
+    static_assert(kDrawQueriesPerPool % 2 == 0);
     struct GpuTimeStatus
     {
         std::string message;
@@ -64,6 +118,40 @@ class GPUTime
     void SetEnable(bool enable) { m_enable = enable; }
     bool IsEnabled() const { return m_enable; }
 
+    // By default, every frame boundary waits for the device to be idle and reads the timestamps of
+    // the frame back right away. With more than 1 frame in flight, the query pool is split into one
+    // segment per frame in flight instead. The timestamps of a frame are read back at a later frame
+    // boundary, once their availability bits are set, so the device only has to be waited on when
+    // the gpu falls behind by all the segments.
+    // This needs to be set before OnCreateDevice(), and the cmd buffers have to be recorded in the
+    // frame they are submitted in
+    void SetFramesInFlight(uint32_t frames_in_flight);
+    uint32_t GetFramesInFlight() const { return m_frames_in_flight; }
+
+    // The index of the frame that the latest metrics were added for, or kInvalidFrameIndex
+    // With multiple frames in flight, this lags behind the frame currently being recorded
+    uint64_t GetLastMeasuredFrameIndex() const { return m_last_measured_frame_index; }
+
+    // When enabled, every draw and dispatch recorded in a primary cmd is timed as well.
+    // Their timestamps go to a ring of query pools, which is grown at the frame boundary from the
+    // number of draws recorded in the frame. A frame that records more draws than the ring holds
+    // (e.g. the first one) is not measured.
+    // Only supported with 1 frame in flight, the cmds have to be recorded in the frame they are
+    // submitted in, and it needs to be set before recording any command buffer
+    void SetDrawTimingEnable(bool enable) { m_enable_draw_timing = enable; }
+    bool IsDrawTimingEnabled() const { return m_enable_draw_timing; }
+
+    enum class MetricsMode
+    {
+        // Keeps the samples of the last kFrameMetricsLimit frames, for exact statistics
+        kExact,
+        // Keeps a StreamingStatistics per object instead, for long runs
+        kStreaming,
+    };
+    // Changing the mode clears the metrics collected so far
+    void SetMetricsMode(MetricsMode mode) { m_metrics.SetMode(mode); }
+    MetricsMode GetMetricsMode() const { return m_metrics.GetMode(); }
+
     GpuTimeStatus OnCreateDevice(VkDevice device, const VkAllocationCallbacks* allocator_ptr,
                                  float timestamp_period,
                                  PFN_vkCreateQueryPool pfn_create_query_pool,
@@ -124,10 +212,19 @@ class GPUTime
     GpuTimeStatus OnCmdEndRenderPass2KHR(VkCommandBuffer command_buffer,
                                          PFN_vkCmdWriteTimestamp pfn_cmd_write_timestamp);
 
+    // Called before and after recording a draw or dispatch (direct or indirect)
+    GpuTimeStatus OnCmdDrawBegin(VkCommandBuffer command_buffer,
+                                 PFN_vkCmdWriteTimestamp pfn_cmd_write_timestamp);
+
+    GpuTimeStatus OnCmdDrawEnd(VkCommandBuffer command_buffer,
+                               PFN_vkCmdWriteTimestamp pfn_cmd_write_timestamp);
+
     struct Stats
     {
         double average = 0.0;
         double median = 0.0;
+        double p90 = 0.0;
+        double p99 = 0.0;
         double min = std::numeric_limits<double>::max();
         double max = std::numeric_limits<double>::lowest();
         double stddev = 0.0;
@@ -142,6 +239,13 @@ class GPUTime
     {
         return m_metrics.GetCmdRenderPassCount(index);
     }
+    // Draws are keyed by the index of their cmd in the frame and their index in the cmd, which is
+    // the order they are recorded in
+    Stats GetFrameDrawTimeStats(size_t cmd_index, size_t draw_index) const
+    {
+        return m_metrics.GetFrameDrawTimeStats(cmd_index, draw_index);
+    }
+    size_t GetCmdDrawCount(size_t index) const { return m_metrics.GetCmdDrawCount(index); }
     std::string GetStatsString() const;
     // Gives a CSV format string representing the GPU timing data for objects in the current frame
     // Type, id, mean [ms], median [ms]
@@ -154,27 +258,51 @@ class GPUTime
      public:
         static constexpr size_t kInvalidRenderPassCount = static_cast<size_t>(-1);
         FrameMetrics() = default;
+        void SetMode(MetricsMode mode);
+        MetricsMode GetMode() const { return m_mode; }
+        // draw_renderpass_count_vec is the number of render passes begun in the cmd before each
+        // draw
         void AddFrameData(double frame_time, const std::vector<double>& cmd_time_vec,
                           const std::vector<double>& renderpass_time_vec,
-                          const std::vector<size_t>& cmd_renderpass_count_vec);
+                          const std::vector<size_t>& cmd_renderpass_count_vec,
+                          const std::vector<double>& draw_time_vec = {},
+                          const std::vector<size_t>& cmd_draw_count_vec = {},
+                          const std::vector<size_t>& draw_renderpass_count_vec = {});
         Stats GetFrameTimeStats() const;
         Stats GetFrameCmdTimeStats(size_t index) const;
         Stats GetFrameRenderPassTimeStats(size_t index) const;
+        Stats GetFrameDrawTimeStats(size_t cmd_index, size_t draw_index) const;
         size_t GetFrameCmdCount() const;
         size_t GetFrameRenderPassCount() const;
+        size_t GetFrameDrawCount() const;
         size_t GetCmdRenderPassCount(size_t index) const;
+        size_t GetCmdDrawCount(size_t index) const;
+        size_t GetDrawRenderPassCount(size_t cmd_index, size_t draw_index) const;
 
      private:
         Stats GetStatistics(const std::deque<double>& data) const;
+        Stats GetStatistics(const StreamingStatistics& data) const;
         double CalculateAverage(const std::deque<double>& data) const;
-        double CalculateMedian(const std::deque<double>& data) const;
+        double CalculatePercentile(const std::vector<double>& sorted_data, double q) const;
         double CalculateStdDev(const std::deque<double>& data, double average) const;
         void Reset();
 
+        MetricsMode m_mode = MetricsMode::kExact;
         std::deque<double> m_frame_time;
         std::vector<size_t> m_cmd_renderpass_count_vec;
         std::vector<std::deque<double>> m_cmd_time_vec;
         std::vector<std::deque<double>> m_renderpass_time_vec;
+        // Draws of all the cmds, flattened in cmd order
+        std::vector<size_t> m_cmd_draw_count_vec;
+        std::vector<size_t> m_cmd_draw_offset_vec;
+        std::vector<size_t> m_draw_renderpass_count_vec;
+        std::vector<std::deque<double>> m_draw_time_vec;
+
+        // Used instead of the deques in MetricsMode::kStreaming
+        StreamingStatistics m_streaming_frame_time;
+        std::vector<StreamingStatistics> m_streaming_cmd_time_vec;
+        std::vector<StreamingStatistics> m_streaming_renderpass_time_vec;
+        std::vector<StreamingStatistics> m_streaming_draw_time_vec;
     };
 
     class TimeStampSlotAllocator
@@ -210,18 +338,102 @@ class GPUTime
         static constexpr uint32_t kInvalidTimeStampOffset = static_cast<uint32_t>(-1);
 
         std::vector<uint32_t> renderpass_slots;
+        // First of the 2 draw queries of each draw, or kInvalidIndex if the draw query ring was
+        // full
+        std::vector<uint32_t> draw_queries;
+        // Number of render passes begun before each draw
+        std::vector<size_t> draw_renderpass_counts;
+        // The frame boundaries passed when the draw queries were taken
+        uint64_t draw_query_epoch = 0;
         VkCommandPool pool = VK_NULL_HANDLE;
         uint32_t begin_timestamp_offset = kInvalidTimeStampOffset;
         uint32_t end_timestamp_offset = kInvalidTimeStampOffset;
+        // The query pool segment the cmd has been recorded for
+        uint32_t query_segment = 0;
         bool is_frameboundary = false;
         bool usage_one_submit = false;
         bool reusable = false;
     };
 
+    // Map from primary cmds to their CommandBufferInfo, which can be used from multiple threads
+    // The map is split into shards with their own lock, so that threads recording different cmds
+    // rarely contend, and each thread caches the last cmd it has looked up.
+    // The returned CommandBufferInfo is stable until the cmd is erased, and as in Vulkan, the
+    // caller has to make sure a cmd is not used by another thread while it is being erased
+    class CommandBufferTable
+    {
+     public:
+        static constexpr size_t kNumShards = 16;
+
+        CommandBufferTable();
+        // Returns nullptr if the cmd is not in the table (e.g. secondary cmds)
+        CommandBufferInfo* Find(VkCommandBuffer cmd);
+        // Returns false if the cmd is already in the table
+        bool Insert(VkCommandBuffer cmd, const CommandBufferInfo& info);
+        void Erase(VkCommandBuffer cmd);
+        // Returns the cmds allocated from the pool
+        std::vector<VkCommandBuffer> GetPoolCmds(VkCommandPool pool);
+        // Erases the cmds allocated from the pool
+        void ErasePoolCmds(VkCommandPool pool);
+
+     private:
+        struct Shard
+        {
+            std::shared_mutex mutex;
+            std::unordered_map<VkCommandBuffer, std::unique_ptr<CommandBufferInfo>> cmds;
+        };
+        struct ThreadCache
+        {
+            uint64_t table_id = 0;
+            uint64_t generation = 0;
+            VkCommandBuffer cmd = VK_NULL_HANDLE;
+            CommandBufferInfo* info = nullptr;
+        };
+        Shard& GetShard(VkCommandBuffer cmd);
+
+        static thread_local ThreadCache s_thread_cache;
+        static std::atomic<uint64_t> s_next_table_id;
+
+        std::array<Shard, kNumShards> m_shards;
+        // Bumped whenever a cmd is erased, which invalidates the thread caches
+        std::atomic<uint64_t> m_generation = 0;
+        const uint64_t m_table_id;
+    };
+
+    // Timestamp slots of a submitted frame, waiting for its results to be available
+    struct PendingFrame
+    {
+        uint64_t frame_index = 0;
+        uint32_t query_segment = 0;
+        // Begin and end slot of each cmd, and the render pass slots of each cmd
+        std::vector<uint32_t> cmd_slots;
+        std::vector<std::vector<uint32_t>> cmd_renderpass_slots;
+        bool valid = true;
+    };
+
     GpuTimeStatus OnFrameBoundary(PFN_vkDeviceWaitIdle pfn_device_wait_idle,
                                   PFN_vkResetQueryPool pfn_reset_query_pool,
                                   PFN_vkGetQueryPoolResults pfn_get_query_pool_results);
     GpuTimeStatus UpdateFrameMetrics(PFN_vkGetQueryPoolResults pfn_get_query_pool_results);
+    GpuTimeStatus OnPipelinedFrameBoundary(PFN_vkDeviceWaitIdle pfn_device_wait_idle,
+                                           PFN_vkResetQueryPool pfn_reset_query_pool,
+                                           PFN_vkGetQueryPoolResults pfn_get_query_pool_results);
+    GpuTimeStatus AddPendingFrame();
+    GpuTimeStatus ReadPendingFrames(PFN_vkGetQueryPoolResults pfn_get_query_pool_results);
+    std::optional<double> GetTimeDuration(uint32_t begin_offset, uint32_t end_offset) const;
+    std::optional<double> GetTimeDuration(const uint64_t* timestamps_with_availability,
+                                          uint32_t begin_offset, uint32_t end_offset) const;
+    GpuTimeStatus ReadDrawQueryResults(PFN_vkGetQueryPoolResults pfn_get_query_pool_results);
+    GpuTimeStatus ResetDrawQueries(PFN_vkResetQueryPool pfn_reset_query_pool);
+    void DestroyDrawQueryPools();
+    uint32_t GetDrawQueryCapacity() const
+    {
+        return m_draw_query_pool_count.load(std::memory_order_acquire) * kDrawQueriesPerPool;
+    }
+    uint32_t GetQueryIndex(uint32_t slot) const
+    {
+        return m_query_segment * TimeStampSlotAllocator::kTotalSlots + slot;
+    }
     void RemoveCmdFromFrameCache(VkCommandBuffer cmd);
     GpuTimeStatus BeginRenderPass(VkCommandBuffer command_buffer,
                                   PFN_vkCmdWriteTimestamp pfn_cmd_write_timestamp);
@@ -230,22 +442,38 @@ class GPUTime
 
     // Keep the timestamp results *2 for VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
     uint64_t m_timestamps_with_availability[TimeStampSlotAllocator::kTotalSlots * 2];
+    std::vector<uint64_t> m_draw_timestamps_with_availability;
     FrameMetrics m_metrics;
 
     std::set<VkQueue> m_queues;
-    std::unordered_map<VkCommandBuffer, CommandBufferInfo> m_cmds;
+    CommandBufferTable m_cmds;
+    // Guards m_frame_cmds, which is also changed when cmds are reset or freed
+    std::mutex m_frame_mutex;
     std::vector<VkCommandBuffer> m_frame_cmds;
+    std::deque<PendingFrame> m_pending_frames;
     TimeStampSlotAllocator m_timestamp_allocator;
 
     VkDevice m_device = VK_NULL_HANDLE;
     const VkAllocationCallbacks* m_allocator = nullptr;
     VkQueryPool m_query_pool = VK_NULL_HANDLE;
+    PFN_vkCreateQueryPool m_create_query_pool = nullptr;
     PFN_vkDestroyQueryPool m_destroy_query_pool = nullptr;
+    // Ring of draw query pools, only appended to at the frame boundary. The count is published
+    // after the pool, so that recording threads can read the pools without a lock
+    std::array<VkQueryPool, kMaxDrawQueryPools> m_draw_query_pools = {};
+    std::atomic<uint32_t> m_draw_query_pool_count = 0;
+    // Number of draw queries taken in the frame, which can exceed the capacity of the ring
+    std::atomic<uint32_t> m_draw_query_counter = 0;
+    std::atomic<uint64_t> m_draw_query_epoch = 0;
     uint64_t m_frame_index = 0;
+    uint64_t m_last_measured_frame_index = kInvalidFrameIndex;
+    uint32_t m_frames_in_flight = 1;
+    std::atomic<uint32_t> m_query_segment = 0;
     uint32_t m_timestamp_counter = 0;
     float m_timestamp_period = 0.0f;
-    bool m_valid_frame = true;
+    std::atomic<bool> m_valid_frame = true;
     bool m_enable = false;
+    bool m_enable_draw_timing = false;
 };
 
 }  // namespace Dive
@@ -19,6 +19,17 @@ limitations under the License.
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 namespace Dive
 {
 namespace
@@ -413,5 +424,612 @@ TEST(GPUTimeTest, MultipleFramesUpdateMetricsCorrectly)
     ASSERT_NO_FATAL_FAILURE(DestroyGPUTime(gpu_time));
 }
 
+// --- Multithreaded Recording ---
+// Every query written by vkCmdWriteTimestamp on the current thread, with its cmd
+thread_local std::vector<std::pair<VkCommandBuffer, uint32_t>> t_written_queries;
+
+void RecordingCmdWriteTimestamp(VkCommandBuffer commandBuffer,
+                                VkPipelineStageFlagBits pipelineStage, VkQueryPool queryPool,
+                                uint32_t query)
+{
+    t_written_queries.emplace_back(commandBuffer, query);
+}
+
+VkResult AllAvailableGetQueryPoolResults(VkDevice device, VkQueryPool queryPool,
+                                         uint32_t firstQuery, uint32_t queryCount, size_t dataSize,
+                                         void* pData, VkDeviceSize stride,
+                                         VkQueryResultFlags flags)
+{
+    uint64_t* timestamps = static_cast<uint64_t*>(pData);
+    for (uint32_t i = 0; i < queryCount; ++i)
+    {
+        timestamps[i * 2] = (firstQuery + i) * 1000;
+        timestamps[i * 2 + 1] = 1;
+    }
+    return VK_SUCCESS;
+}
+
+// Test that recording from many threads at once, each with its own command pool, keeps the
+// timestamp slots of every command buffer separate.
+TEST(GPUTimeTest, RecordingFromMultipleThreads)
+{
+    constexpr uint32_t kNumThreads = 8;
+    constexpr uint32_t kCmdsPerThread = 4;
+    constexpr uint32_t kNumIterations = 200;
+    constexpr uint32_t kRenderPassesPerCmd = 3;
+
+    GPUTime gpu_time;
+    gpu_time.SetEnable(true);
+    ASSERT_NO_FATAL_FAILURE(CreateGPUTime(gpu_time, kMockTimestampPeriod));
+
+    // The begin and end query of each cmd in its last recording
+    std::vector<std::map<VkCommandBuffer, std::pair<uint32_t, uint32_t>>> thread_queries(
+        kNumThreads);
+    std::vector<std::vector<VkCommandBuffer>> thread_cmds(kNumThreads);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kNumThreads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            VkCommandBufferAllocateInfo alloc_info = {};
+            alloc_info.commandPool =
+                reinterpret_cast<VkCommandPool>(static_cast<uintptr_t>(0x1000 + t));
+            alloc_info.commandBufferCount = kCmdsPerThread;
+            std::vector<VkCommandBuffer>& cmds = thread_cmds[t];
+            for (uint32_t c = 0; c < kCmdsPerThread; ++c)
+            {
+                cmds.push_back(reinterpret_cast<VkCommandBuffer>(
+                    static_cast<uintptr_t>(((t + 1) << 16) | ((c + 1) << 4))));
+            }
+
+            for (uint32_t i = 0; i < kNumIterations; ++i)
+            {
+                // Reallocating the same handles has to invalidate any cached lookups
+                if (i % 50 == 0)
+                {
+                    if (i != 0)
+                    {
+                        EXPECT_TRUE(gpu_time.OnFreeCommandBuffers(kCmdsPerThread, cmds.data())
+                                        .success);
+                    }
+                    EXPECT_TRUE(gpu_time.OnAllocateCommandBuffers(&alloc_info, cmds.data())
+                                    .success);
+                }
+
+                for (VkCommandBuffer cmd : cmds)
+                {
+                    t_written_queries.clear();
+                    EXPECT_TRUE(
+                        gpu_time.OnBeginCommandBuffer(cmd, 0, RecordingCmdWriteTimestamp).success);
+                    for (uint32_t r = 0; r < kRenderPassesPerCmd; ++r)
+                    {
+                        gpu_time.OnCmdBeginRenderPass(cmd, RecordingCmdWriteTimestamp);
+                        gpu_time.OnCmdEndRenderPass(cmd, RecordingCmdWriteTimestamp);
+                    }
+                    EXPECT_TRUE(gpu_time.OnEndCommandBuffer(cmd, RecordingCmdWriteTimestamp).success);
+
+                    ASSERT_EQ(t_written_queries.size(), 2 + kRenderPassesPerCmd * 2);
+                    for (const auto& [written_cmd, query] : t_written_queries)
+                    {
+                        EXPECT_EQ(written_cmd, cmd);
+                    }
+                    thread_queries[t][cmd] = {t_written_queries.front().second,
+                                              t_written_queries.back().second};
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // No two cmds share a timestamp slot
+    std::set<uint32_t> used_queries;
+    for (const auto& queries : thread_queries)
+    {
+        for (const auto& [cmd, begin_end] : queries)
+        {
+            EXPECT_TRUE(used_queries.insert(begin_end.first).second);
+            EXPECT_TRUE(used_queries.insert(begin_end.second).second);
+        }
+    }
+    EXPECT_EQ(used_queries.size(), kNumThreads * kCmdsPerThread * 2);
+
+    // Submit everything as a single frame
+    std::vector<VkCommandBuffer> all_cmds;
+    for (const auto& cmds : thread_cmds)
+    {
+        all_cmds.insert(all_cmds.end(), cmds.begin(), cmds.end());
+    }
+    VkDebugUtilsLabelEXT label = {};
+    label.pLabelName = GPUTime::kVulkanVrFrameDelimiterString;
+    ASSERT_TRUE(gpu_time.OnCmdInsertDebugUtilsLabelEXT(all_cmds.back(), &label).success);
+    VkSubmitInfo submit_info = {};
+    submit_info.commandBufferCount = static_cast<uint32_t>(all_cmds.size());
+    submit_info.pCommandBuffers = all_cmds.data();
+    ASSERT_TRUE(gpu_time
+                    .OnQueueSubmit(1, &submit_info, MockDeviceWaitIdle, MockResetQueryPool,
+                                   AllAvailableGetQueryPoolResults)
+                    .gpu_time_status.success);
+    EXPECT_NE(gpu_time.GetFrameCmdTimeStats(all_cmds.size() - 1).average, 0.0);
+    EXPECT_EQ(gpu_time.GetCmdRenderPassCount(0), kRenderPassesPerCmd);
+
+    ASSERT_NO_FATAL_FAILURE(DestroyGPUTime(gpu_time));
+}
+
+// --- Streaming Statistics ---
+// Test that the quantiles of the sketch are within the relative accuracy of the exact ones.
+TEST(StreamingStatisticsTest, QuantilesAreWithinRelativeAccuracy)
+{
+    std::mt19937 generator(42);
+    std::lognormal_distribution<double> distribution(2.0, 0.5);
+    std::vector<double> samples(10000);
+    StreamingStatistics stats;
+    for (auto& sample : samples)
+    {
+        sample = distribution(generator);
+        stats.Add(sample);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    for (double q : {0.5, 0.9, 0.99})
+    {
+        const double exact = samples[static_cast<size_t>(q * (samples.size() - 1))];
+        EXPECT_NEAR(stats.GetQuantile(q), exact, exact * StreamingStatistics::kRelativeAccuracy)
+            << "q = " << q;
+    }
+    EXPECT_DOUBLE_EQ(stats.GetMin(), samples.front());
+    EXPECT_DOUBLE_EQ(stats.GetMax(), samples.back());
+    EXPECT_EQ(stats.GetCount(), samples.size());
+}
+
+// Test that merging two sketches is the same as adding all samples to one.
+TEST(StreamingStatisticsTest, MergeMatchesSingleStream)
+{
+    StreamingStatistics all;
+    StreamingStatistics first_half;
+    StreamingStatistics second_half;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const double sample = 1.0 + (i % 97) * 0.25;
+        all.Add(sample);
+        (i < 500 ? first_half : second_half).Add(sample);
+    }
+    first_half.Merge(second_half);
+
+    EXPECT_EQ(first_half.GetCount(), all.GetCount());
+    EXPECT_NEAR(first_half.GetAverage(), all.GetAverage(), 1e-9);
+    EXPECT_NEAR(first_half.GetStdDev(), all.GetStdDev(), 1e-9);
+    for (double q : {0.0, 0.5, 0.9, 0.99, 1.0})
+    {
+        EXPECT_DOUBLE_EQ(first_half.GetQuantile(q), all.GetQuantile(q)) << "q = " << q;
+    }
+}
+
+// Test that a sketch of constant or zero samples is exact, and memory stays bounded.
+TEST(StreamingStatisticsTest, HandlesZeroAndBoundsBuckets)
+{
+    StreamingStatistics stats;
+    EXPECT_EQ(stats.GetQuantile(0.5), 0.0);
+    stats.Add(0.0);
+    stats.Add(0.0);
+    EXPECT_EQ(stats.GetQuantile(0.5), 0.0);
+
+    StreamingStatistics constant;
+    for (int i = 0; i < 100; ++i)
+    {
+        constant.Add(16.6);
+    }
+    EXPECT_DOUBLE_EQ(constant.GetQuantile(0.99), 16.6);
+    EXPECT_DOUBLE_EQ(constant.GetStdDev(), 0.0);
+
+    // Spread samples over far more buckets than kept, the highest quantiles stay accurate
+    StreamingStatistics wide;
+    double sample = 1e-6;
+    for (int i = 0; i < 5000; ++i)
+    {
+        wide.Add(sample);
+        sample *= 1.05;
+    }
+    const double expected_p99 = 1e-6 * std::pow(1.05, 0.99 * 4999);
+    EXPECT_NEAR(wide.GetQuantile(0.99), expected_p99,
+                expected_p99 * StreamingStatistics::kRelativeAccuracy);
+}
+
+// Test that the streaming mode reports the same statistics as the exact mode for a short run.
+TEST(GPUTimeTest, StreamingMetricsMatchExactMetrics)
+{
+    GPUTime gpu_time;
+    gpu_time.SetEnable(true);
+    gpu_time.SetMetricsMode(GPUTime::MetricsMode::kStreaming);
+    ASSERT_NO_FATAL_FAILURE(CreateGPUTime(gpu_time, kMockTimestampPeriod));
+
+    VkCommandBufferAllocateInfo alloc_info = {};
+    alloc_info.commandPool = MOCK_COMMAND_POOL;
+    alloc_info.commandBufferCount = 3;
+    VkCommandBuffer cmdBufs[] = {MOCK_COMMAND_BUFFER_1, MOCK_COMMAND_BUFFER_2,
+                                 MOCK_COMMAND_BUFFER_3};
+    gpu_time.OnAllocateCommandBuffers(&alloc_info, cmdBufs);
+
+    VkDebugUtilsLabelEXT label = {};
+    label.pLabelName = GPUTime::kVulkanVrFrameDelimiterString;
+    VkSubmitInfo submit_info = {};
+    submit_info.commandBufferCount = 1;
+
+    // Frames of 10ms, 20ms and 30ms, see MockGetQueryPoolResults
+    for (const VkCommandBuffer& cmd : cmdBufs)
+    {
+        gpu_time.OnCmdInsertDebugUtilsLabelEXT(cmd, &label);
+        submit_info.pCommandBuffers = &cmd;
+        ASSERT_TRUE(gpu_time
+                        .OnQueueSubmit(1, &submit_info, MockDeviceWaitIdle, MockResetQueryPool,
+                                       MockGetQueryPoolResults)
+                        .gpu_time_status.success);
+    }
+
+    auto stats = gpu_time.GetFrameTimeStats();
+    const double tolerance = 30.0 * StreamingStatistics::kRelativeAccuracy;
+    EXPECT_DOUBLE_EQ(stats.average, 20.0);
+    EXPECT_NEAR(stats.stddev, 10.0, 1e-9);
+    EXPECT_DOUBLE_EQ(stats.min, 10.0);
+    EXPECT_DOUBLE_EQ(stats.max, 30.0);
+    EXPECT_NEAR(stats.median, 20.0, tolerance);
+
+    ASSERT_NO_FATAL_FAILURE(DestroyGPUTime(gpu_time));
+}
+
+// --- Multiple Frames In Flight ---
+// State for the mocks used with multiple frames in flight, where the results of each query are
+// only available once the test says so.
+struct PipelinedMockState
+{
+    // Query indices in the order they were written by vkCmdWriteTimestamp
+    std::vector<uint32_t> written_queries;
+    // Timestamp of each available query
+    std::map<uint32_t, uint64_t> available_queries;
+    std::vector<uint32_t> reset_first_queries;
+    uint32_t device_wait_idle_count = 0;
+    bool wait_idle_completes_queries = false;
+};
+PipelinedMockState g_pipelined_state;
+
+void PipelinedCmdWriteTimestamp(VkCommandBuffer commandBuffer,
+                                VkPipelineStageFlagBits pipelineStage, VkQueryPool queryPool,
+                                uint32_t query)
+{
+    g_pipelined_state.written_queries.push_back(query);
+}
+
+void PipelinedResetQueryPool(VkDevice device, VkQueryPool queryPool, uint32_t firstQuery,
+                             uint32_t queryCount)
+{
+    g_pipelined_state.reset_first_queries.push_back(firstQuery);
+    auto& available_queries = g_pipelined_state.available_queries;
+    available_queries.erase(available_queries.lower_bound(firstQuery),
+                            available_queries.lower_bound(firstQuery + queryCount));
+}
+
+VkResult PipelinedGetQueryPoolResults(VkDevice device, VkQueryPool queryPool, uint32_t firstQuery,
+                                      uint32_t queryCount, size_t dataSize, void* pData,
+                                      VkDeviceSize stride, VkQueryResultFlags flags)
+{
+    uint64_t* timestamps = static_cast<uint64_t*>(pData);
+    bool all_available = true;
+    for (uint32_t i = 0; i < queryCount; ++i)
+    {
+        auto it = g_pipelined_state.available_queries.find(firstQuery + i);
+        timestamps[i * 2] = (it != g_pipelined_state.available_queries.end()) ? it->second : 0;
+        timestamps[i * 2 + 1] = (it != g_pipelined_state.available_queries.end()) ? 1 : 0;
+        all_available = all_available && (timestamps[i * 2 + 1] != 0);
+    }
+    return all_available ? VK_SUCCESS : VK_NOT_READY;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL PipelinedDeviceWaitIdle(VkDevice device)
+{
+    ++g_pipelined_state.device_wait_idle_count;
+    if (g_pipelined_state.wait_idle_completes_queries)
+    {
+        for (uint32_t query : g_pipelined_state.written_queries)
+        {
+            g_pipelined_state.available_queries.emplace(query, 0);
+        }
+    }
+    return VK_SUCCESS;
+}
+
+class GPUTimePipelinedTest : public testing::Test
+{
+ protected:
+    void SetUp() override
+    {
+        g_pipelined_state = PipelinedMockState();
+        m_gpu_time.SetEnable(true);
+    }
+
+    void CreateWithFramesInFlight(uint32_t frames_in_flight)
+    {
+        m_gpu_time.SetFramesInFlight(frames_in_flight);
+        ASSERT_NO_FATAL_FAILURE(CreateGPUTime(m_gpu_time, kMockTimestampPeriod));
+
+        VkCommandBufferAllocateInfo alloc_info = {};
+        alloc_info.commandPool = MOCK_COMMAND_POOL;
+        alloc_info.commandBufferCount = 1;
+        ASSERT_TRUE(m_gpu_time.OnAllocateCommandBuffers(&alloc_info, &m_cmd).success);
+    }
+
+    // Records and submits a frame with a single cmd, and returns the queries it wrote
+    std::vector<uint32_t> SubmitFrame(bool expect_success = true)
+    {
+        const size_t first_query = g_pipelined_state.written_queries.size();
+        EXPECT_TRUE(m_gpu_time.OnBeginCommandBuffer(m_cmd, 0, PipelinedCmdWriteTimestamp).success);
+        VkDebugUtilsLabelEXT label = {};
+        label.pLabelName = GPUTime::kVulkanVrFrameDelimiterString;
+        EXPECT_TRUE(m_gpu_time.OnCmdInsertDebugUtilsLabelEXT(m_cmd, &label).success);
+        EXPECT_TRUE(m_gpu_time.OnEndCommandBuffer(m_cmd, PipelinedCmdWriteTimestamp).success);
+        std::vector<uint32_t> queries(g_pipelined_state.written_queries.begin() + first_query,
+                                      g_pipelined_state.written_queries.end());
+
+        VkSubmitInfo submit_info = {};
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers = &m_cmd;
+        auto status = m_gpu_time.OnQueueSubmit(1, &submit_info, PipelinedDeviceWaitIdle,
+                                               PipelinedResetQueryPool,
+                                               PipelinedGetQueryPoolResults);
+        EXPECT_EQ(status.gpu_time_status.success, expect_success);
+        EXPECT_TRUE(status.contains_frame_boundary);
+        return queries;
+    }
+
+    // Makes the begin and end queries of a cmd available, duration_ms apart
+    void CompleteQueries(const std::vector<uint32_t>& queries, uint64_t duration_ms)
+    {
+        ASSERT_EQ(queries.size(), 2u);
+        g_pipelined_state.available_queries[queries[0]] = 1000000000;
+        g_pipelined_state.available_queries[queries[1]] = 1000000000 + duration_ms * 1000000;
+    }
+
+    void TearDown() override { ASSERT_NO_FATAL_FAILURE(DestroyGPUTime(m_gpu_time)); }
+
+    GPUTime m_gpu_time;
+    VkCommandBuffer m_cmd = MOCK_COMMAND_BUFFER_1;
+};
+
+// Test that results are read back at a later frame boundary without waiting for the device, and
+// are added for the frame they were recorded in.
+TEST_F(GPUTimePipelinedTest, ReadsBackCompletedFramesWithoutWaiting)
+{
+    ASSERT_NO_FATAL_FAILURE(CreateWithFramesInFlight(3));
+
+    // The gpu has not finished frame 0 or 1 yet
+    std::vector<uint32_t> frame_0_queries = SubmitFrame();
+    std::vector<uint32_t> frame_1_queries = SubmitFrame();
+    EXPECT_EQ(m_gpu_time.GetLastMeasuredFrameIndex(), GPUTime::kInvalidFrameIndex);
+    EXPECT_EQ(m_gpu_time.GetFrameTimeStats().average, 0.0);
+
+    // Each frame in flight writes to its own segment of the query pool
+    EXPECT_NE(frame_0_queries[0], frame_1_queries[0]);
+
+    // Only frame 0 is done by the time frame 2 is submitted
+    CompleteQueries(frame_0_queries, 10);
+    std::vector<uint32_t> frame_2_queries = SubmitFrame();
+    EXPECT_EQ(m_gpu_time.GetLastMeasuredFrameIndex(), 0u);
+    EXPECT_DOUBLE_EQ(m_gpu_time.GetFrameTimeStats().average, 10.0);
+
+    CompleteQueries(frame_1_queries, 20);
+    CompleteQueries(frame_2_queries, 30);
+    SubmitFrame();
+    EXPECT_EQ(m_gpu_time.GetLastMeasuredFrameIndex(), 2u);
+
+    GPUTime::Stats expected_stats;
+    expected_stats.average = 20.0;
+    expected_stats.median = 20.0;
+    expected_stats.min = 10.0;
+    expected_stats.max = 30.0;
+    expected_stats.stddev = 10.0;
+    EXPECT_THAT(m_gpu_time.GetFrameTimeStats(), StatsEq(expected_stats));
+    EXPECT_EQ(g_pipelined_state.device_wait_idle_count, 0u);
+}
+
+// Test that only the segment of the next frame is reset at a frame boundary.
+TEST_F(GPUTimePipelinedTest, ResetsOnlyTheNextSegment)
+{
+    ASSERT_NO_FATAL_FAILURE(CreateWithFramesInFlight(2));
+    g_pipelined_state.reset_first_queries.clear();
+
+    std::vector<uint32_t> frame_0_queries = SubmitFrame();
+    CompleteQueries(frame_0_queries, 10);
+    SubmitFrame();
+
+    EXPECT_THAT(g_pipelined_state.reset_first_queries, testing::ElementsAre(1024u, 0u));
+}
+
+// Test that the device is only waited on when the gpu falls behind by all the segments.
+TEST_F(GPUTimePipelinedTest, WaitsWhenAllSegmentsArePending)
+{
+    ASSERT_NO_FATAL_FAILURE(CreateWithFramesInFlight(2));
+    g_pipelined_state.wait_idle_completes_queries = true;
+
+    SubmitFrame();
+    EXPECT_EQ(g_pipelined_state.device_wait_idle_count, 0u);
+
+    // Frame 1 needs the segment of frame 0, which is still pending
+    SubmitFrame();
+    EXPECT_EQ(g_pipelined_state.device_wait_idle_count, 1u);
+    EXPECT_EQ(m_gpu_time.GetLastMeasuredFrameIndex(), 1u);
+}
+
+// Test that a frame whose results never become available is dropped rather than blocking.
+TEST_F(GPUTimePipelinedTest, DropsFrameThatNeverCompletes)
+{
+    ASSERT_NO_FATAL_FAILURE(CreateWithFramesInFlight(2));
+
+    SubmitFrame();
+    SubmitFrame(/*expect_success=*/false);
+    EXPECT_EQ(g_pipelined_state.device_wait_idle_count, 1u);
+    EXPECT_EQ(m_gpu_time.GetLastMeasuredFrameIndex(), GPUTime::kInvalidFrameIndex);
+}
+
+// Mocks for draw timing, where every query is available as soon as it is written, 1ms after the
+// previous one, and the draw query pools are told apart by their handle
+struct DrawTimingMockState
+{
+    std::map<std::pair<VkQueryPool, uint32_t>, uint64_t> available_queries;
+    uint64_t next_timestamp = 0;
+    uint32_t created_pool_count = 0;
+    std::set<VkQueryPool> written_pools;
+};
+DrawTimingMockState g_draw_timing_state;
+
+VkResult DrawTimingCreateQueryPool(VkDevice device, const VkQueryPoolCreateInfo* pCreateInfo,
+                                   const VkAllocationCallbacks* pAllocator, VkQueryPool* pQueryPool)
+{
+    const uintptr_t handle = 0x100 + g_draw_timing_state.created_pool_count++;
+    *pQueryPool = reinterpret_cast<VkQueryPool>(handle);
+    return VK_SUCCESS;
+}
+
+void DrawTimingResetQueryPool(VkDevice device, VkQueryPool queryPool, uint32_t firstQuery,
+                              uint32_t queryCount)
+{
+    auto& available_queries = g_draw_timing_state.available_queries;
+    available_queries.erase(available_queries.lower_bound({queryPool, firstQuery}),
+                            available_queries.lower_bound({queryPool, firstQuery + queryCount}));
+}
+
+void DrawTimingCmdWriteTimestamp(VkCommandBuffer commandBuffer,
+                                 VkPipelineStageFlagBits pipelineStage, VkQueryPool queryPool,
+                                 uint32_t query)
+{
+    g_draw_timing_state.next_timestamp += 1000000;
+    g_draw_timing_state.available_queries[{queryPool, query}] = g_draw_timing_state.next_timestamp;
+    g_draw_timing_state.written_pools.insert(queryPool);
+}
+
+VkResult DrawTimingGetQueryPoolResults(VkDevice device, VkQueryPool queryPool, uint32_t firstQuery,
+                                       uint32_t queryCount, size_t dataSize, void* pData,
+                                       VkDeviceSize stride, VkQueryResultFlags flags)
+{
+    uint64_t* timestamps = static_cast<uint64_t*>(pData);
+    bool all_available = true;
+    for (uint32_t i = 0; i < queryCount; ++i)
+    {
+        auto it = g_draw_timing_state.available_queries.find({queryPool, firstQuery + i});
+        const bool available = (it != g_draw_timing_state.available_queries.end());
+        timestamps[i * 2] = available ? it->second : 0;
+        timestamps[i * 2 + 1] = available ? 1 : 0;
+        all_available = all_available && available;
+    }
+    return all_available ? VK_SUCCESS : VK_NOT_READY;
+}
+
+class GPUTimeDrawTimingTest : public testing::Test
+{
+ protected:
+    void SetUp() override
+    {
+        g_draw_timing_state = DrawTimingMockState();
+        m_gpu_time.SetEnable(true);
+        m_gpu_time.SetDrawTimingEnable(true);
+        ASSERT_TRUE(m_gpu_time
+                        .OnCreateDevice(MOCK_DEVICE, /*allocator=*/nullptr, kMockTimestampPeriod,
+                                        DrawTimingCreateQueryPool, DrawTimingResetQueryPool,
+                                        MockDestroyQueryPool)
+                        .success);
+
+        VkCommandBufferAllocateInfo alloc_info = {};
+        alloc_info.commandPool = MOCK_COMMAND_POOL;
+        alloc_info.commandBufferCount = 1;
+        ASSERT_TRUE(m_gpu_time.OnAllocateCommandBuffers(&alloc_info, &m_cmd).success);
+    }
+
+    // Records and submits a frame with a single cmd, with draws_before_renderpass draws followed
+    // by a render pass with renderpass_draws draws
+    bool SubmitFrame(uint32_t draws_before_renderpass, uint32_t renderpass_draws)
+    {
+        EXPECT_TRUE(
+            m_gpu_time.OnBeginCommandBuffer(m_cmd, 0, DrawTimingCmdWriteTimestamp).success);
+        VkDebugUtilsLabelEXT label = {};
+        label.pLabelName = GPUTime::kVulkanVrFrameDelimiterString;
+        EXPECT_TRUE(m_gpu_time.OnCmdInsertDebugUtilsLabelEXT(m_cmd, &label).success);
+        auto RecordDraws = [&](uint32_t draw_count) {
+            for (uint32_t i = 0; i < draw_count; ++i)
+            {
+                EXPECT_TRUE(m_gpu_time.OnCmdDrawBegin(m_cmd, DrawTimingCmdWriteTimestamp).success);
+                EXPECT_TRUE(m_gpu_time.OnCmdDrawEnd(m_cmd, DrawTimingCmdWriteTimestamp).success);
+            }
+        };
+        RecordDraws(draws_before_renderpass);
+        EXPECT_TRUE(m_gpu_time.OnCmdBeginRenderPass(m_cmd, DrawTimingCmdWriteTimestamp).success);
+        RecordDraws(renderpass_draws);
+        EXPECT_TRUE(m_gpu_time.OnCmdEndRenderPass(m_cmd, DrawTimingCmdWriteTimestamp).success);
+        EXPECT_TRUE(m_gpu_time.OnEndCommandBuffer(m_cmd, DrawTimingCmdWriteTimestamp).success);
+
+        VkSubmitInfo submit_info = {};
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers = &m_cmd;
+        auto status = m_gpu_time.OnQueueSubmit(1, &submit_info, MockDeviceWaitIdle,
+                                               DrawTimingResetQueryPool,
+                                               DrawTimingGetQueryPoolResults);
+        EXPECT_TRUE(status.contains_frame_boundary);
+        return status.gpu_time_status.success;
+    }
+
+    void TearDown() override { ASSERT_NO_FATAL_FAILURE(DestroyGPUTime(m_gpu_time)); }
+
+    GPUTime m_gpu_time;
+    VkCommandBuffer m_cmd = MOCK_COMMAND_BUFFER_1;
+};
+
+// Test that the draw query ring is sized from the first frame, and that the draws of the next
+// frames are timed and listed in recording order.
+TEST_F(GPUTimeDrawTimingTest, TimesDrawsOnceTheRingIsSized)
+{
+    // The ring is empty until the first frame boundary, so the first frame is not measured
+    EXPECT_FALSE(SubmitFrame(1, 2));
+    EXPECT_EQ(g_draw_timing_state.created_pool_count, 2u);
+    EXPECT_EQ(m_gpu_time.GetLastMeasuredFrameIndex(), GPUTime::kInvalidFrameIndex);
+
+    EXPECT_TRUE(SubmitFrame(1, 2));
+    EXPECT_EQ(m_gpu_time.GetLastMeasuredFrameIndex(), 1u);
+    ASSERT_EQ(m_gpu_time.GetCmdDrawCount(0), 3u);
+    for (size_t d = 0; d < 3; ++d)
+    {
+        // Each draw is between 2 consecutive timestamps
+        EXPECT_DOUBLE_EQ(m_gpu_time.GetFrameDrawTimeStats(0, d).average, 1.0);
+    }
+    EXPECT_EQ(m_gpu_time.GetFrameDrawTimeStats(0, 3).average, 0.0);
+    // begin, 3 draws, render pass begin and end, end
+    EXPECT_DOUBLE_EQ(m_gpu_time.GetFrameCmdTimeStats(0).average, 9.0);
+
+    std::stringstream csv(m_gpu_time.GetStatsCSVString());
+    std::vector<std::string> rows;
+    for (std::string line; std::getline(csv, line);)
+    {
+        rows.push_back(line.substr(0, line.find(',', line.find(',') + 1)));
+    }
+    EXPECT_THAT(rows, testing::ElementsAre("Frame,2", "CommandBuffer,0", "Draw,0", "RenderPass,0",
+                                           "Draw,1", "Draw,2"));
+}
+
+// Test that a frame with more draws than the ring holds grows it by whole pools.
+TEST_F(GPUTimeDrawTimingTest, GrowsTheRingWithTheDrawCount)
+{
+    const uint32_t draw_count = GPUTime::kDrawQueriesPerPool / 2 + 1;
+    EXPECT_FALSE(SubmitFrame(0, 1));
+    EXPECT_TRUE(SubmitFrame(0, 1));
+    EXPECT_EQ(g_draw_timing_state.created_pool_count, 2u);
+
+    EXPECT_FALSE(SubmitFrame(0, draw_count));
+    EXPECT_EQ(g_draw_timing_state.created_pool_count, 3u);
+
+    g_draw_timing_state.written_pools.clear();
+    EXPECT_TRUE(SubmitFrame(0, draw_count));
+    EXPECT_EQ(m_gpu_time.GetCmdDrawCount(0), draw_count);
+    EXPECT_DOUBLE_EQ(m_gpu_time.GetFrameDrawTimeStats(0, draw_count - 1).average, 1.0);
+    // The main pool and both draw pools
+    EXPECT_EQ(g_draw_timing_state.written_pools.size(), 3u);
+}
+
 }  // namespace
 }  // namespace Dive
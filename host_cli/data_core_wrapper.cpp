@@ -38,8 +38,11 @@ absl::Status DataCoreWrapper::LoadGfxrFile(const std::string& original_gfxr_file
 {
     assert(m_data_core != nullptr);
 
+    GfxrCaptureData& gfxr_capture_data = m_data_core->GetMutableGfxrCaptureData();
+    // The CLI only rewrites blocks, so the args of the commands are decoded on demand.
+    gfxr_capture_data.SetLazyCommandArgs(true);
     CaptureData::LoadResult load_result =
-        m_data_core->GetMutableGfxrCaptureData().LoadCaptureFile(original_gfxr_file_path.c_str());
+        gfxr_capture_data.LoadCaptureFile(original_gfxr_file_path.c_str());
     if (load_result != CaptureData::LoadResult::kSuccess)
     {
         return absl::UnknownError(
@@ -162,6 +162,7 @@ int main(int argc, char** argv)
 
     // Load capture
     std::unique_ptr<Dive::DataCore> data_core = std::make_unique<Dive::DataCore>();
+    data_core->SetUseCaptureIndex(true);
     Dive::CaptureData::LoadResult load_res = data_core->LoadPm4CaptureData(input_file_name);
     if (load_res != Dive::CaptureData::LoadResult::kSuccess)
     {
@@ -170,8 +171,8 @@ int main(int argc, char** argv)
     }
     std::cout << "Capture file \"" << input_file_name << "\" is loaded!\n";
 
-    // Create meta data
-    if (!data_core->CreatePm4MetaData())
+    // Create meta data, or load it from the capture index of an earlier run
+    if (!data_core->ParsePm4CaptureData())
     {
         std::cout << "Failed to create meta data!";
         return 0;
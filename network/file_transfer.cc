@@ -0,0 +1,281 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "file_transfer.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "dive/common/status.h"
+
+namespace Network
+{
+
+namespace
+{
+
+constexpr uint32_t kCrc32Polynomial = 0xedb88320;
+constexpr size_t kChecksumChunkSize = 1 << 20;
+// Largest part of a file in a FileDataMessage. Deflating can grow a chunk slightly, so this leaves
+// room below kMaxPayloadSize.
+constexpr size_t kMaxFileDataChunkSize = 4 << 20;
+
+// Tables for the slicing-by-8 CRC-32: table[k][b] is the CRC of byte b followed by k zero bytes.
+using Crc32Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+constexpr Crc32Tables MakeCrc32Tables()
+{
+    Crc32Tables tables = {};
+    for (uint32_t b = 0; b < 256; ++b)
+    {
+        uint32_t crc = b;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) ? kCrc32Polynomial : 0);
+        }
+        tables[0][b] = crc;
+    }
+    for (uint32_t b = 0; b < 256; ++b)
+    {
+        for (size_t k = 1; k < tables.size(); ++k)
+        {
+            tables[k][b] = (tables[k - 1][b] >> 8) ^ tables[0][tables[k - 1][b] & 0xff];
+        }
+    }
+    return tables;
+}
+
+constexpr Crc32Tables kCrc32Tables = MakeCrc32Tables();
+
+// Returns the size of the file if [offset, offset + length) is within it.
+absl::StatusOr<uint64_t> GetFileSizeForRange(const std::string& file_path, uint64_t offset,
+                                             uint64_t length)
+{
+    std::error_code ec;
+    uint64_t file_size = std::filesystem::file_size(file_path, ec);
+    if (ec)
+    {
+        return Dive::NotFoundError(ec.message());
+    }
+    if (offset > file_size || length > file_size - offset)
+    {
+        return Dive::OutOfRangeError(absl::StrCat("Range [", offset, ", ", offset + length,
+                                                  ") is outside of the file of size ", file_size));
+    }
+    return file_size;
+}
+
+}  // namespace
+
+uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc)
+{
+    crc = ~crc;
+    while (size >= 8)
+    {
+        uint32_t low = (static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+                        (static_cast<uint32_t>(data[2]) << 16) |
+                        (static_cast<uint32_t>(data[3]) << 24)) ^
+                       crc;
+        crc = kCrc32Tables[7][low & 0xff] ^ kCrc32Tables[6][(low >> 8) & 0xff] ^
+              kCrc32Tables[5][(low >> 16) & 0xff] ^ kCrc32Tables[4][low >> 24] ^
+              kCrc32Tables[3][data[4]] ^ kCrc32Tables[2][data[5]] ^ kCrc32Tables[1][data[6]] ^
+              kCrc32Tables[0][data[7]];
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0)
+    {
+        crc = (crc >> 8) ^ kCrc32Tables[0][(crc ^ *data++) & 0xff];
+    }
+    return ~crc;
+}
+
+absl::StatusOr<uint32_t> ComputeFileCrc32(const std::string& file_path, uint64_t offset,
+                                          uint64_t length)
+{
+    std::ifstream file_stream(file_path, std::ios::binary);
+    if (!file_stream)
+    {
+        return Dive::NotFoundError(
+            absl::StrCat("ComputeFileCrc32: Failed to open file '", file_path, "'"));
+    }
+    if (!file_stream.seekg(static_cast<std::streamoff>(offset)))
+    {
+        return Dive::OutOfRangeError(
+            absl::StrCat("ComputeFileCrc32: Failed to seek to ", offset, " in '", file_path, "'"));
+    }
+
+    std::vector<char> buffer(static_cast<size_t>(std::min<uint64_t>(kChecksumChunkSize, length)));
+    uint32_t crc = 0;
+    uint64_t total_read = 0;
+    while (total_read < length)
+    {
+        std::streamsize to_read =
+            static_cast<std::streamsize>(std::min<uint64_t>(buffer.size(), length - total_read));
+        if (!file_stream.read(buffer.data(), to_read))
+        {
+            return Dive::OutOfRangeError(absl::StrCat(
+                "ComputeFileCrc32: Failed to read ", length, " bytes at ", offset, " in '",
+                file_path, "'"));
+        }
+        crc = Crc32(reinterpret_cast<const uint8_t*>(buffer.data()), static_cast<size_t>(to_read),
+                    crc);
+        total_read += static_cast<uint64_t>(to_read);
+    }
+    return crc;
+}
+
+FileCompression GetFileCompressionForCapabilities(uint32_t capabilities)
+{
+    return (capabilities & kCapabilityDeflateFiles) ? FileCompression::kDeflate
+                                                    : FileCompression::kNone;
+}
+
+absl::Status SendHandshakeResponse(const HandshakeRequest& request, SocketConnection* client_conn)
+{
+    HandshakeResponse response;
+    response.SetMajorVersion(request.GetMajorVersion());
+    response.SetMinorVersion(request.GetMinorVersion());
+    response.SetCapabilities(request.GetCapabilities() & kSupportedCapabilities);
+    response.SetRequestId(request.GetRequestId());
+    // The client may send multiplexed requests as soon as it gets the response, so the connection
+    // is set up before.
+    client_conn->SetFileCompression(GetFileCompressionForCapabilities(response.GetCapabilities()));
+    client_conn->SetMultiplexed((response.GetCapabilities() & kCapabilityMultiplexing) != 0);
+    return SendSocketMessage(client_conn, response);
+}
+
+absl::Status SendFileContent(SocketConnection* client_conn, uint32_t request_id,
+                             const std::string& file_path, uint64_t offset, uint64_t length)
+{
+    if (!client_conn->IsMultiplexed())
+    {
+        return client_conn->SendFileRange(file_path, offset, length);
+    }
+    // The FileDataMessages are framed here rather than serialized, so that the chunks are not
+    // copied, or not at all when sendfile() is used.
+    auto frame_header = [request_id](size_t chunk_size) {
+        MessageHeader header;
+        header.type = static_cast<uint32_t>(MessageType::FILE_DATA);
+        header.payload_size = static_cast<uint32_t>(chunk_size);
+        header.request_id = request_id;
+        Buffer frame;
+        WriteMessageHeader(header, frame);
+        return frame;
+    };
+    return client_conn->SendFileRangeFrames(file_path, offset, length, kMaxFileDataChunkSize,
+                                            frame_header);
+}
+
+absl::Status SendDownloadFileResponse(const DownloadFileRequest& request,
+                                      SocketConnection* client_conn)
+{
+    DownloadFileResponse response;
+    response.SetRequestId(request.GetRequestId());
+    const std::string& file_path = request.GetString();
+
+    std::error_code ec;
+    auto file_size = std::filesystem::file_size(file_path, ec);
+    if (!ec)
+    {
+        response.SetFound(true);
+        response.SetFilePath(file_path);
+        response.SetFileSize(file_size);
+    }
+    else
+    {
+        response.SetFound(false);
+        response.SetErrorReason(ec.message());
+    }
+
+    auto status = SendSocketMessage(client_conn, response);
+    if (!status.ok())
+    {
+        return status;
+    }
+    if (!response.GetFound())
+    {
+        return Dive::NotFoundError(response.GetErrorReason());
+    }
+    return SendFileContent(client_conn, request.GetRequestId(), file_path, 0, file_size);
+}
+
+absl::Status SendFileRangeResponse(const DownloadFileRangeRequest& request,
+                                   SocketConnection* client_conn)
+{
+    DownloadFileRangeResponse response;
+    response.SetRequestId(request.GetRequestId());
+    absl::StatusOr<uint64_t> file_size =
+        GetFileSizeForRange(request.GetFilePath(), request.GetOffset(), request.GetLength());
+    if (file_size.ok())
+    {
+        response.SetFound(true);
+        response.SetFileSize(*file_size);
+        response.SetOffset(request.GetOffset());
+        response.SetLength(request.GetLength());
+    }
+    else
+    {
+        response.SetFound(false);
+        response.SetErrorReason(std::string(file_size.status().message()));
+    }
+
+    auto status = SendSocketMessage(client_conn, response);
+    if (!status.ok())
+    {
+        return status;
+    }
+    if (!response.GetFound())
+    {
+        return file_size.status();
+    }
+    return SendFileContent(client_conn, request.GetRequestId(), request.GetFilePath(),
+                           request.GetOffset(), request.GetLength());
+}
+
+absl::Status SendFileChecksumResponse(const FileChecksumRequest& request,
+                                      SocketConnection* client_conn)
+{
+    FileChecksumResponse response;
+    response.SetRequestId(request.GetRequestId());
+    absl::StatusOr<uint64_t> file_size =
+        GetFileSizeForRange(request.GetFilePath(), request.GetOffset(), request.GetLength());
+    absl::StatusOr<uint32_t> checksum = 0;
+    if (file_size.ok())
+    {
+        checksum =
+            ComputeFileCrc32(request.GetFilePath(), request.GetOffset(), request.GetLength());
+    }
+    if (file_size.ok() && checksum.ok())
+    {
+        response.SetFound(true);
+        response.SetFileSize(*file_size);
+        response.SetChecksum(*checksum);
+    }
+    else
+    {
+        const absl::Status& status = file_size.ok() ? checksum.status() : file_size.status();
+        response.SetFound(false);
+        response.SetErrorReason(std::string(status.message()));
+    }
+    return SendSocketMessage(client_conn, response);
+}
+
+}  // namespace Network
@@ -0,0 +1,60 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "messages.h"
+
+namespace Network
+{
+
+// Returns the CRC-32 of the data, continuing from crc. It is the same checksum as zlib's crc32().
+uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0);
+
+// Returns the CRC-32 of the [offset, offset + length) range of the file.
+absl::StatusOr<uint32_t> ComputeFileCrc32(const std::string& file_path, uint64_t offset,
+                                          uint64_t length);
+
+// Returns the compression of the files sent on a connection with these handshake capabilities.
+FileCompression GetFileCompressionForCapabilities(uint32_t capabilities);
+
+// Server side of a HandshakeRequest: sends a HandshakeResponse with the requested capabilities the
+// server supports, and applies them to the connection.
+absl::Status SendHandshakeResponse(const HandshakeRequest& request, SocketConnection* client_conn);
+
+// Sends the [offset, offset + length) range of the file that follows the response to a request:
+// as FileDataMessages of the request on a multiplexed connection, raw otherwise.
+absl::Status SendFileContent(SocketConnection* client_conn, uint32_t request_id,
+                             const std::string& file_path, uint64_t offset, uint64_t length);
+
+// Server side of a DownloadFileRequest: sends a DownloadFileResponse, followed by the file if it
+// exists.
+absl::Status SendDownloadFileResponse(const DownloadFileRequest& request,
+                                      SocketConnection* client_conn);
+
+// Server side of a DownloadFileRangeRequest: sends a DownloadFileRangeResponse, followed by the
+// requested range if it is within the file.
+absl::Status SendFileRangeResponse(const DownloadFileRangeRequest& request,
+                                   SocketConnection* client_conn);
+
+// Server side of a FileChecksumRequest: sends a FileChecksumResponse.
+absl::Status SendFileChecksumResponse(const FileChecksumRequest& request,
+                                      SocketConnection* client_conn);
+
+}  // namespace Network
@@ -0,0 +1,413 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "file_transfer.h"
+
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/status/status_matchers.h"
+#include "tcp_client.h"
+#include "unix_domain_server.h"
+
+namespace
+{
+
+using ::absl_testing::IsOk;
+using ::absl_testing::IsOkAndHolds;
+
+// When enabled, the server holds the downloads halfway until it answers a file size request, and
+// holds the file size requests until a download is halfway. Both only complete without timing out
+// if the server handles the requests of a client concurrently.
+struct InterleavingCheck
+{
+    bool WaitFor(const bool& flag)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(10), [&] { return flag; });
+    }
+
+    void Set(bool& flag)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            flag = true;
+        }
+        cv.notify_all();
+    }
+
+    std::atomic<bool> enabled = false;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool download_paused = false;
+    bool size_answered = false;
+    // Whether the file size request was answered while a download was halfway.
+    std::atomic<bool> interleaved = false;
+};
+
+// Serves the file requests of a TcpClient, and counts the ranges it downloads.
+class FileServerHandler : public Network::DefaultMessageHandler
+{
+ public:
+    FileServerHandler(std::atomic<int>* range_requests, InterleavingCheck* interleaving) :
+        m_range_requests(range_requests),
+        m_interleaving(interleaving)
+    {
+    }
+
+    void HandleMessage(std::unique_ptr<Network::ISerializable> message,
+                       Network::SocketConnection* client_conn) override
+    {
+        switch (message->GetMessageType())
+        {
+            case Network::MessageType::FILE_SIZE_REQUEST:
+            {
+                if (m_interleaving->enabled.load())
+                {
+                    m_interleaving->interleaved.store(
+                        m_interleaving->WaitFor(m_interleaving->download_paused));
+                }
+                auto* request = dynamic_cast<Network::FileSizeRequest*>(message.get());
+                Network::FileSizeResponse response;
+                response.SetRequestId(request->GetRequestId());
+                std::error_code ec;
+                auto file_size = std::filesystem::file_size(request->GetString(), ec);
+                response.SetFound(!ec);
+                response.SetErrorReason(ec.message());
+                response.SetFileSize(ec ? 0 : file_size);
+                (void)Network::SendSocketMessage(client_conn, response);
+                if (m_interleaving->enabled.load())
+                {
+                    m_interleaving->Set(m_interleaving->size_answered);
+                }
+                break;
+            }
+            case Network::MessageType::DOWNLOAD_FILE_REQUEST:
+            {
+                auto* request = dynamic_cast<Network::DownloadFileRequest*>(message.get());
+                if (m_interleaving->enabled.load())
+                {
+                    SendDownloadInHalves(*request, client_conn);
+                }
+                else
+                {
+                    (void)Network::SendDownloadFileResponse(*request, client_conn);
+                }
+                break;
+            }
+            case Network::MessageType::DOWNLOAD_FILE_RANGE_REQUEST:
+                ++*m_range_requests;
+                (void)Network::SendFileRangeResponse(
+                    *dynamic_cast<Network::DownloadFileRangeRequest*>(message.get()), client_conn);
+                break;
+            case Network::MessageType::FILE_CHECKSUM_REQUEST:
+                (void)Network::SendFileChecksumResponse(
+                    *dynamic_cast<Network::FileChecksumRequest*>(message.get()), client_conn);
+                break;
+            default:
+                Network::DefaultMessageHandler::HandleMessage(std::move(message), client_conn);
+        }
+    }
+
+ private:
+    void SendDownloadInHalves(const Network::DownloadFileRequest& request,
+                              Network::SocketConnection* client_conn)
+    {
+        const std::string& file_path = request.GetString();
+        const uint64_t file_size = std::filesystem::file_size(file_path);
+        Network::DownloadFileResponse response;
+        response.SetRequestId(request.GetRequestId());
+        response.SetFound(true);
+        response.SetFilePath(file_path);
+        response.SetFileSize(file_size);
+        (void)Network::SendSocketMessage(client_conn, response);
+
+        const uint64_t half = file_size / 2;
+        (void)Network::SendFileContent(client_conn, request.GetRequestId(), file_path, 0, half);
+        m_interleaving->Set(m_interleaving->download_paused);
+        m_interleaving->WaitFor(m_interleaving->size_answered);
+        (void)Network::SendFileContent(client_conn, request.GetRequestId(), file_path, half,
+                                       file_size - half);
+    }
+
+    std::atomic<int>* m_range_requests;
+    InterleavingCheck* m_interleaving;
+};
+
+// Forwards TCP connections on a local port to the abstract Unix domain socket of the server, the
+// same way `adb forward` does for the capture service.
+class TcpToUnixForwarder
+{
+ public:
+    explicit TcpToUnixForwarder(const std::string& server_address) :
+        m_server_address(server_address)
+    {
+        m_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addr_len = sizeof(addr);
+        if (bind(m_listen_fd, reinterpret_cast<sockaddr*>(&addr), addr_len) != 0 ||
+            listen(m_listen_fd, SOMAXCONN) != 0 ||
+            getsockname(m_listen_fd, reinterpret_cast<sockaddr*>(&addr), &addr_len) != 0)
+        {
+            return;
+        }
+        m_port = ntohs(addr.sin_port);
+        m_accept_thread = std::thread(&TcpToUnixForwarder::AcceptLoop, this);
+    }
+
+    ~TcpToUnixForwarder()
+    {
+        m_running.store(false);
+        shutdown(m_listen_fd, SHUT_RDWR);
+        if (m_accept_thread.joinable())
+        {
+            m_accept_thread.join();
+        }
+        close(m_listen_fd);
+        for (auto& thread : m_pump_threads)
+        {
+            thread.join();
+        }
+    }
+
+    int GetPort() const { return m_port; }
+
+ private:
+    void AcceptLoop()
+    {
+        while (m_running.load())
+        {
+            int tcp_fd = accept(m_listen_fd, nullptr, nullptr);
+            if (tcp_fd < 0)
+            {
+                return;
+            }
+            int unix_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            sockaddr_un addr = {};
+            addr.sun_family = AF_UNIX;
+            memcpy(addr.sun_path + 1, m_server_address.data(), m_server_address.size());
+            socklen_t addr_len =
+                static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 +
+                                       m_server_address.size());
+            if (connect(unix_fd, reinterpret_cast<sockaddr*>(&addr), addr_len) != 0)
+            {
+                close(tcp_fd);
+                close(unix_fd);
+                continue;
+            }
+            m_pump_threads.emplace_back(&TcpToUnixForwarder::Pump, this, tcp_fd, unix_fd);
+        }
+    }
+
+    void Pump(int tcp_fd, int unix_fd)
+    {
+        std::vector<char> buffer(1 << 16);
+        pollfd fds[2] = {{tcp_fd, POLLIN, 0}, {unix_fd, POLLIN, 0}};
+        while (m_running.load())
+        {
+            if (poll(fds, 2, 100) < 0)
+            {
+                break;
+            }
+            bool closed = false;
+            for (int i = 0; i < 2; ++i)
+            {
+                if (fds[i].revents == 0)
+                {
+                    continue;
+                }
+                ssize_t n = read(fds[i].fd, buffer.data(), buffer.size());
+                if (n <= 0 || send(fds[1 - i].fd, buffer.data(), n, MSG_NOSIGNAL) != n)
+                {
+                    closed = true;
+                }
+            }
+            if (closed)
+            {
+                break;
+            }
+        }
+        close(tcp_fd);
+        close(unix_fd);
+    }
+
+    std::string m_server_address;
+    int m_listen_fd = -1;
+    int m_port = 0;
+    std::atomic<bool> m_running = true;
+    std::thread m_accept_thread;
+    std::vector<std::thread> m_pump_threads;
+};
+
+class ParallelDownloadTest : public ::testing::Test
+{
+ protected:
+    void SetUp() override
+    {
+        std::string suffix = std::to_string(getpid());
+        m_dir = std::filesystem::temp_directory_path() / ("file_transfer_test_" + suffix);
+        std::filesystem::create_directories(m_dir);
+
+        std::string server_address = "file_transfer_test_" + suffix;
+        m_server = std::make_unique<Network::UnixDomainServer>(
+            std::make_unique<FileServerHandler>(&m_range_requests, &m_interleaving));
+        ASSERT_THAT(m_server->Start(server_address), IsOk());
+        m_forwarder = std::make_unique<TcpToUnixForwarder>(server_address);
+        ASSERT_NE(m_forwarder->GetPort(), 0);
+        ASSERT_THAT(m_client.Connect("127.0.0.1", m_forwarder->GetPort()), IsOk());
+    }
+
+    void TearDown() override
+    {
+        m_client.Disconnect();
+        m_server->Stop();
+        m_forwarder.reset();
+        std::filesystem::remove_all(m_dir);
+    }
+
+    std::vector<char> WriteRemoteFile(size_t size)
+    {
+        std::vector<char> content(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            content[i] = static_cast<char>((i * 131) ^ (i >> 12));
+        }
+        std::ofstream out(RemotePath(), std::ios::binary);
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return content;
+    }
+
+    std::vector<char> ReadLocalFile()
+    {
+        std::ifstream in(LocalPath(), std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in),
+                                 std::istreambuf_iterator<char>());
+    }
+
+    std::string RemotePath() const { return (m_dir / "remote.rd").string(); }
+    std::string LocalPath() const { return (m_dir / "local.rd").string(); }
+
+    std::filesystem::path m_dir;
+    std::atomic<int> m_range_requests = 0;
+    InterleavingCheck m_interleaving;
+    std::unique_ptr<Network::UnixDomainServer> m_server;
+    std::unique_ptr<TcpToUnixForwarder> m_forwarder;
+    Network::TcpClient m_client;
+};
+
+TEST(FileTransferTest, Crc32)
+{
+    const std::string check = "123456789";
+    EXPECT_EQ(Network::Crc32(reinterpret_cast<const uint8_t*>(check.data()), check.size()),
+              0xcbf43926u);
+    EXPECT_EQ(Network::Crc32(nullptr, 0), 0u);
+
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+    uint32_t crc = Network::Crc32(data.data(), 13);
+    crc = Network::Crc32(data.data() + 13, data.size() - 13, crc);
+    EXPECT_EQ(crc, Network::Crc32(data.data(), data.size()));
+}
+
+TEST_F(ParallelDownloadTest, DownloadsOverSeveralConnections)
+{
+    constexpr size_t kFileSize = (5 << 20) + 7;
+    std::vector<char> content = WriteRemoteFile(kFileSize);
+
+    Network::ParallelDownloadOptions options;
+    options.stream_count = 4;
+    options.range_size = 256 << 10;
+    size_t last_progress = 0;
+    ASSERT_THAT(m_client.DownloadFileFromServerParallel(RemotePath(), LocalPath(), options,
+                                                        [&](size_t size) { last_progress = size; }),
+                IsOk());
+    EXPECT_EQ(ReadLocalFile(), content);
+    EXPECT_EQ(last_progress, kFileSize);
+    EXPECT_EQ(m_range_requests.load(), 21);
+    EXPECT_TRUE(m_client.IsConnected());
+}
+
+TEST_F(ParallelDownloadTest, ResumesFromPartialFile)
+{
+    constexpr size_t kRangeSize = 64 << 10;
+    constexpr size_t kFileSize = 16 * kRangeSize;
+    std::vector<char> content = WriteRemoteFile(kFileSize);
+
+    // A previous download got the first 10 ranges, but the 4th one is corrupted.
+    std::vector<char> partial(content.begin(), content.begin() + 10 * kRangeSize);
+    partial[3 * kRangeSize + 5] ^= 0x5a;
+    {
+        std::ofstream out(LocalPath(), std::ios::binary);
+        out.write(partial.data(), static_cast<std::streamsize>(partial.size()));
+    }
+
+    Network::ParallelDownloadOptions options;
+    options.stream_count = 3;
+    options.range_size = kRangeSize;
+    ASSERT_THAT(m_client.DownloadFileFromServerParallel(RemotePath(), LocalPath(), options),
+                IsOk());
+    EXPECT_EQ(ReadLocalFile(), content);
+    EXPECT_EQ(m_range_requests.load(), 7);
+}
+
+TEST_F(ParallelDownloadTest, AnswersRequestsDuringDownload)
+{
+    constexpr size_t kFileSize = (3 << 20) + 11;
+    std::vector<char> content = WriteRemoteFile(kFileSize);
+    m_interleaving.enabled.store(true);
+
+    absl::Status download_status;
+    std::thread download(
+        [&] { download_status = m_client.DownloadFileFromServer(RemotePath(), LocalPath()); });
+    auto file_size = m_client.GetCaptureFileSize(RemotePath());
+    download.join();
+
+    EXPECT_THAT(file_size, IsOkAndHolds(kFileSize));
+    ASSERT_THAT(download_status, IsOk());
+    EXPECT_EQ(ReadLocalFile(), content);
+    EXPECT_TRUE(m_interleaving.interleaved.load());
+}
+
+TEST_F(ParallelDownloadTest, FailsForMissingFile)
+{
+    EXPECT_FALSE(m_client.DownloadFileFromServerParallel((m_dir / "missing.rd").string(),
+                                                         LocalPath())
+                     .ok());
+}
+
+}  // namespace
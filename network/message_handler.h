@@ -32,7 +32,10 @@ class IMessageHandler
     // Callback for when a new client connects.
     virtual void OnConnect() = 0;
 
-    // Processes a message received from the client.
+    // Processes a message received from the client. The callbacks are called on the handler
+    // threads of the server, so they may run concurrently, even for the same client when it is
+    // multiplexed. The responses must carry the request id of the message. The server reads all
+    // the messages of the client, so the callbacks must not receive on client_conn.
     virtual void HandleMessage(std::unique_ptr<ISerializable> message,
                                SocketConnection* client_conn) = 0;
 
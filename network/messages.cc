@@ -20,8 +20,6 @@ limitations under the License.
 #include "dive/common/macros.h"
 #include "dive/common/status.h"
 
-constexpr uint32_t kMaxPayloadSize = 16 * 1024 * 1024;
-
 namespace Network
 {
 
@@ -32,6 +30,12 @@ void WriteUint32ToBuffer(uint32_t value, Buffer& dest)
     dest.insert(dest.end(), p_val, p_val + sizeof(uint32_t));
 }
 
+void WriteUint64ToBuffer(uint64_t value, Buffer& dest)
+{
+    WriteUint32ToBuffer(static_cast<uint32_t>(value >> 32), dest);
+    WriteUint32ToBuffer(static_cast<uint32_t>(value), dest);
+}
+
 void WriteStringToBuffer(const std::string& str, Buffer& dest)
 {
     WriteUint32ToBuffer(static_cast<uint32_t>(str.length()), dest);
@@ -50,6 +54,18 @@ absl::StatusOr<uint32_t> ReadUint32FromBuffer(const Buffer& src, size_t& offset)
     return ntohl(net_val);
 }
 
+absl::StatusOr<uint64_t> ReadUint64FromBuffer(const Buffer& src, size_t& offset)
+{
+    if (src.size() < offset + sizeof(uint64_t))
+    {
+        return Dive::InvalidArgumentError("Buffer too small to read an uint64_t.");
+    }
+    uint32_t high, low;
+    ASSIGN_OR_RETURN(high, ReadUint32FromBuffer(src, offset));
+    ASSIGN_OR_RETURN(low, ReadUint32FromBuffer(src, offset));
+    return (static_cast<uint64_t>(high) << 32) | low;
+}
+
 absl::StatusOr<std::string> ReadStringFromBuffer(const Buffer& src, size_t& offset)
 {
     uint32_t len;
@@ -68,6 +84,7 @@ absl::Status HandshakeMessage::Serialize(Buffer& dest) const
     dest.clear();
     WriteUint32ToBuffer(m_major_version, dest);
     WriteUint32ToBuffer(m_minor_version, dest);
+    WriteUint32ToBuffer(m_capabilities, dest);
     return Dive::OkStatus();
 }
 
@@ -76,6 +93,11 @@ absl::Status HandshakeMessage::Deserialize(const Buffer& src)
     size_t offset = 0;
     ASSIGN_OR_RETURN(m_major_version, ReadUint32FromBuffer(src, offset));
     ASSIGN_OR_RETURN(m_minor_version, ReadUint32FromBuffer(src, offset));
+    m_capabilities = 0;
+    if (offset != src.size())
+    {
+        ASSIGN_OR_RETURN(m_capabilities, ReadUint32FromBuffer(src, offset));
+    }
     if (offset != src.size())
     {
         return Dive::InvalidArgumentError("Handshake message has unexpected trailing data.");
@@ -101,12 +123,34 @@ absl::Status StringMessage::Deserialize(const Buffer& src)
     return Dive::OkStatus();
 }
 
+absl::Status FileRangeMessage::Serialize(Buffer& dest) const
+{
+    dest.clear();
+    WriteStringToBuffer(m_file_path, dest);
+    WriteUint64ToBuffer(m_offset, dest);
+    WriteUint64ToBuffer(m_length, dest);
+    return Dive::OkStatus();
+}
+
+absl::Status FileRangeMessage::Deserialize(const Buffer& src)
+{
+    size_t offset = 0;
+    ASSIGN_OR_RETURN(m_file_path, ReadStringFromBuffer(src, offset));
+    ASSIGN_OR_RETURN(m_offset, ReadUint64FromBuffer(src, offset));
+    ASSIGN_OR_RETURN(m_length, ReadUint64FromBuffer(src, offset));
+    if (offset != src.size())
+    {
+        return Dive::InvalidArgumentError("File range message has unexpected trailing data.");
+    }
+    return Dive::OkStatus();
+}
+
 absl::Status DownloadFileResponse::Serialize(Buffer& dest) const
 {
     dest.push_back(static_cast<uint8_t>(m_found));
     WriteStringToBuffer(m_error_reason, dest);
     WriteStringToBuffer(m_file_path, dest);
-    WriteStringToBuffer(m_file_size_str, dest);
+    WriteUint64ToBuffer(m_file_size, dest);
 
     return Dive::OkStatus();
 }
@@ -124,7 +168,7 @@ absl::Status DownloadFileResponse::Deserialize(const Buffer& src)
 
     ASSIGN_OR_RETURN(m_error_reason, ReadStringFromBuffer(src, offset));
     ASSIGN_OR_RETURN(m_file_path, ReadStringFromBuffer(src, offset));
-    ASSIGN_OR_RETURN(m_file_size_str, ReadStringFromBuffer(src, offset));
+    ASSIGN_OR_RETURN(m_file_size, ReadUint64FromBuffer(src, offset));
     if (offset != src.size())
     {
         return Dive::InvalidArgumentError("Message has unexpected trailing data.");
@@ -136,7 +180,7 @@ absl::Status FileSizeResponse::Serialize(Buffer& dest) const
 {
     dest.push_back(static_cast<uint8_t>(m_found));
     WriteStringToBuffer(m_error_reason, dest);
-    WriteStringToBuffer(m_file_size_str, dest);
+    WriteUint64ToBuffer(m_file_size, dest);
 
     return Dive::OkStatus();
 }
@@ -153,7 +197,71 @@ absl::Status FileSizeResponse::Deserialize(const Buffer& src)
     offset += sizeof(uint8_t);
 
     ASSIGN_OR_RETURN(m_error_reason, ReadStringFromBuffer(src, offset));
-    ASSIGN_OR_RETURN(m_file_size_str, ReadStringFromBuffer(src, offset));
+    ASSIGN_OR_RETURN(m_file_size, ReadUint64FromBuffer(src, offset));
+    if (offset != src.size())
+    {
+        return Dive::InvalidArgumentError("Message has unexpected trailing data.");
+    }
+    return Dive::OkStatus();
+}
+
+absl::Status DownloadFileRangeResponse::Serialize(Buffer& dest) const
+{
+    dest.push_back(static_cast<uint8_t>(m_found));
+    WriteStringToBuffer(m_error_reason, dest);
+    WriteUint64ToBuffer(m_file_size, dest);
+    WriteUint64ToBuffer(m_offset, dest);
+    WriteUint64ToBuffer(m_length, dest);
+
+    return Dive::OkStatus();
+}
+
+absl::Status DownloadFileRangeResponse::Deserialize(const Buffer& src)
+{
+    size_t offset = 0;
+    // Deserialize the 'found' boolean.
+    if (src.size() < offset + sizeof(uint8_t))
+    {
+        return Dive::InvalidArgumentError("Buffer too small for 'found' field.");
+    }
+    m_found = (src[offset] != 0);
+    offset += sizeof(uint8_t);
+
+    ASSIGN_OR_RETURN(m_error_reason, ReadStringFromBuffer(src, offset));
+    ASSIGN_OR_RETURN(m_file_size, ReadUint64FromBuffer(src, offset));
+    ASSIGN_OR_RETURN(m_offset, ReadUint64FromBuffer(src, offset));
+    ASSIGN_OR_RETURN(m_length, ReadUint64FromBuffer(src, offset));
+    if (offset != src.size())
+    {
+        return Dive::InvalidArgumentError("Message has unexpected trailing data.");
+    }
+    return Dive::OkStatus();
+}
+
+absl::Status FileChecksumResponse::Serialize(Buffer& dest) const
+{
+    dest.push_back(static_cast<uint8_t>(m_found));
+    WriteStringToBuffer(m_error_reason, dest);
+    WriteUint64ToBuffer(m_file_size, dest);
+    WriteUint32ToBuffer(m_checksum, dest);
+
+    return Dive::OkStatus();
+}
+
+absl::Status FileChecksumResponse::Deserialize(const Buffer& src)
+{
+    size_t offset = 0;
+    // Deserialize the 'found' boolean.
+    if (src.size() < offset + sizeof(uint8_t))
+    {
+        return Dive::InvalidArgumentError("Buffer too small for 'found' field.");
+    }
+    m_found = (src[offset] != 0);
+    offset += sizeof(uint8_t);
+
+    ASSIGN_OR_RETURN(m_error_reason, ReadStringFromBuffer(src, offset));
+    ASSIGN_OR_RETURN(m_file_size, ReadUint64FromBuffer(src, offset));
+    ASSIGN_OR_RETURN(m_checksum, ReadUint32FromBuffer(src, offset));
     if (offset != src.size())
     {
         return Dive::InvalidArgumentError("Message has unexpected trailing data.");
@@ -161,6 +269,18 @@ absl::Status FileSizeResponse::Deserialize(const Buffer& src)
     return Dive::OkStatus();
 }
 
+absl::Status FileDataMessage::Serialize(Buffer& dest) const
+{
+    dest = m_data;
+    return Dive::OkStatus();
+}
+
+absl::Status FileDataMessage::Deserialize(const Buffer& src)
+{
+    m_data = src;
+    return Dive::OkStatus();
+}
+
 absl::Status ReceiveBuffer(SocketConnection* conn, uint8_t* buffer, size_t size, int timeout_ms)
 {
     if (!conn)
@@ -190,49 +310,35 @@ absl::Status SendBuffer(SocketConnection* conn, const uint8_t* buffer, size_t si
     return conn->Send(buffer, size);
 }
 
-absl::StatusOr<std::unique_ptr<ISerializable>> ReceiveSocketMessage(SocketConnection* conn,
-                                                                    int timeout_ms)
+void WriteMessageHeader(const MessageHeader& header, Buffer& dest)
 {
-    if (!conn)
-    {
-        return Dive::InvalidArgumentError("Provided SocketConnection is null.");
-    }
-
-    constexpr size_t kHeaderSize = sizeof(uint32_t) * 2;
-    uint8_t header_buffer[kHeaderSize];
-
-    // Receive the message header.
-    absl::Status status = ReceiveBuffer(conn, header_buffer, kHeaderSize, timeout_ms);
-    if (!status.ok())
-    {
-        return status;
-    }
-
-    // Parse header.
-    uint32_t net_type, net_length;
-    std::memcpy(&net_type, header_buffer, sizeof(uint32_t));
-    std::memcpy(&net_length, header_buffer + sizeof(uint32_t), sizeof(uint32_t));
-    uint32_t type = ntohl(net_type);
-    uint32_t payload_length = ntohl(net_length);
+    WriteUint32ToBuffer(header.type, dest);
+    WriteUint32ToBuffer(header.payload_size, dest);
+    WriteUint32ToBuffer(header.request_id, dest);
+}
 
-    if (payload_length > kMaxPayloadSize)
+absl::StatusOr<MessageHeader> ParseMessageHeader(const uint8_t* data)
+{
+    uint32_t net_values[3];
+    std::memcpy(net_values, data, kMessageHeaderSize);
+    MessageHeader header;
+    header.type = ntohl(net_values[0]);
+    header.payload_size = ntohl(net_values[1]);
+    header.request_id = ntohl(net_values[2]);
+    if (header.payload_size > kMaxPayloadSize)
     {
-        conn->Close();
         return Dive::InvalidArgumentError(
-            absl::StrCat("Payload size ", payload_length, " exceeds limit."));
-    }
-
-    // Receive the message payload.
-    Buffer payload_buffer(payload_length);
-    status = ReceiveBuffer(conn, payload_buffer.data(), payload_length, timeout_ms);
-    if (!status.ok())
-    {
-        return status;
+            absl::StrCat("Payload size ", header.payload_size, " exceeds limit."));
     }
+    return header;
+}
 
+absl::StatusOr<std::unique_ptr<ISerializable>> DeserializeMessage(const MessageHeader& header,
+                                                                  Buffer payload)
+{
     // Create and deserialize the message object.
     std::unique_ptr<ISerializable> message;
-    switch (static_cast<MessageType>(type))
+    switch (static_cast<MessageType>(header.type))
     {
         case MessageType::HANDSHAKE_REQUEST:
             message = std::make_unique<HandshakeRequest>();
@@ -264,62 +370,108 @@ absl::StatusOr<std::unique_ptr<ISerializable>> ReceiveSocketMessage(SocketConnec
         case MessageType::FILE_SIZE_RESPONSE:
             message = std::make_unique<FileSizeResponse>();
             break;
+        case MessageType::DOWNLOAD_FILE_RANGE_REQUEST:
+            message = std::make_unique<DownloadFileRangeRequest>();
+            break;
+        case MessageType::DOWNLOAD_FILE_RANGE_RESPONSE:
+            message = std::make_unique<DownloadFileRangeResponse>();
+            break;
+        case MessageType::FILE_CHECKSUM_REQUEST:
+            message = std::make_unique<FileChecksumRequest>();
+            break;
+        case MessageType::FILE_CHECKSUM_RESPONSE:
+            message = std::make_unique<FileChecksumResponse>();
+            break;
+        case MessageType::FILE_DATA:
+        {
+            // The chunks of a file are most of the data received, so they are not copied.
+            auto file_data = std::make_unique<FileDataMessage>();
+            file_data->SetData(std::move(payload));
+            file_data->SetRequestId(header.request_id);
+            return file_data;
+        }
         default:
-            conn->Close();
-            return Dive::InvalidArgumentError(absl::StrCat("Unknown message type: ", type));
+            return Dive::InvalidArgumentError(absl::StrCat("Unknown message type: ", header.type));
     }
 
-    status = message->Deserialize(payload_buffer);
+    absl::Status status = message->Deserialize(payload);
     if (!status.ok())
     {
-        conn->Close();
         return status;
     }
+    message->SetRequestId(header.request_id);
 
     return message;
 }
 
-absl::Status SendSocketMessage(SocketConnection* conn, const ISerializable& message)
+absl::StatusOr<std::unique_ptr<ISerializable>> ReceiveSocketMessage(SocketConnection* conn,
+                                                                    int timeout_ms)
 {
     if (!conn)
     {
         return Dive::InvalidArgumentError("Provided SocketConnection is null.");
     }
 
-    // Serialize the message payload.
-    Buffer payload_buffer;
-    absl::Status status = message.Serialize(payload_buffer);
+    // Receive and parse the message header.
+    uint8_t header_buffer[kMessageHeaderSize];
+    absl::Status status = ReceiveBuffer(conn, header_buffer, kMessageHeaderSize, timeout_ms);
     if (!status.ok())
     {
         return status;
     }
-    if (payload_buffer.size() > kMaxPayloadSize)
+    absl::StatusOr<MessageHeader> header = ParseMessageHeader(header_buffer);
+    if (!header.ok())
     {
-        return Dive::InvalidArgumentError("Serialized payload size exceeds limit.");
+        conn->Close();
+        return header.status();
     }
 
-    // Construct and send the header.
-    uint32_t net_type = htonl(static_cast<uint32_t>(message.GetMessageType()));
-    uint32_t net_payload_length = htonl(static_cast<uint32_t>(payload_buffer.size()));
-    constexpr size_t kHeaderSize = sizeof(net_type) + sizeof(net_payload_length);
-    uint8_t header_buffer[kHeaderSize];
-    std::memcpy(header_buffer, &net_type, sizeof(uint32_t));
-    std::memcpy(header_buffer + sizeof(uint32_t), &net_payload_length, sizeof(uint32_t));
-
-    status = SendBuffer(conn, header_buffer, kHeaderSize);
+    // Receive the message payload.
+    Buffer payload_buffer(header->payload_size);
+    status = ReceiveBuffer(conn, payload_buffer.data(), payload_buffer.size(), timeout_ms);
     if (!status.ok())
     {
         return status;
     }
 
-    // Send the payload.
-    status = SendBuffer(conn, payload_buffer.data(), payload_buffer.size());
+    auto message = DeserializeMessage(*header, std::move(payload_buffer));
+    if (!message.ok())
+    {
+        conn->Close();
+    }
+    return message;
+}
+
+absl::Status SendSocketMessage(SocketConnection* conn, const ISerializable& message)
+{
+    if (!conn)
+    {
+        return Dive::InvalidArgumentError("Provided SocketConnection is null.");
+    }
+
+    // Serialize the message payload.
+    Buffer payload_buffer;
+    absl::Status status = message.Serialize(payload_buffer);
     if (!status.ok())
     {
         return status;
     }
+    if (payload_buffer.size() > kMaxPayloadSize)
+    {
+        return Dive::InvalidArgumentError("Serialized payload size exceeds limit.");
+    }
 
-    return Dive::OkStatus();
+    // Send the header and the payload at once, so that the messages other threads send on the
+    // connection cannot go in between.
+    MessageHeader header;
+    header.type = static_cast<uint32_t>(message.GetMessageType());
+    header.payload_size = static_cast<uint32_t>(payload_buffer.size());
+    header.request_id = message.GetRequestId();
+    Buffer message_buffer;
+    message_buffer.reserve(kMessageHeaderSize + payload_buffer.size());
+    WriteMessageHeader(header, message_buffer);
+    message_buffer.insert(message_buffer.end(), payload_buffer.begin(), payload_buffer.end());
+    return SendBuffer(conn, message_buffer.data(), message_buffer.size());
 }
 
 }  // namespace Network
@@ -26,12 +26,18 @@ namespace Network
 // Helper to write a uint32_t to a buffer.
 void WriteUint32ToBuffer(uint32_t value, Buffer& dest);
 
+// Helper to write a uint64_t to a buffer, as its high and low 32 bits.
+void WriteUint64ToBuffer(uint64_t value, Buffer& dest);
+
 // Helper to write a string (length + data) to the buffer.
 void WriteStringToBuffer(const std::string& str, Buffer& dest);
 
 // Helper to read a uint32_t from a buffer.
 absl::StatusOr<uint32_t> ReadUint32FromBuffer(const Buffer& src, size_t& offset);
 
+// Helper to read a uint64_t from a buffer.
+absl::StatusOr<uint64_t> ReadUint64FromBuffer(const Buffer& src, size_t& offset);
+
 // Helper to read a string (length + data) from the buffer.
 absl::StatusOr<std::string> ReadStringFromBuffer(const Buffer& src, size_t& offset);
 
@@ -46,9 +52,27 @@ enum class MessageType : uint32_t
     DOWNLOAD_FILE_REQUEST = 7,
     DOWNLOAD_FILE_RESPONSE = 8,
     FILE_SIZE_REQUEST = 9,
-    FILE_SIZE_RESPONSE = 10
+    FILE_SIZE_RESPONSE = 10,
+    DOWNLOAD_FILE_RANGE_REQUEST = 11,
+    DOWNLOAD_FILE_RANGE_RESPONSE = 12,
+    FILE_CHECKSUM_REQUEST = 13,
+    FILE_CHECKSUM_RESPONSE = 14,
+    FILE_DATA = 15
 };
 
+// Optional features a client requests in its HandshakeRequest. The HandshakeResponse holds the
+// ones the server accepted.
+
+// Files are sent with FileCompression::kDeflate.
+constexpr uint32_t kCapabilityDeflateFiles = 1u << 0;
+// The client may send requests without waiting for the responses of the previous ones. The server
+// handles them concurrently, and sends the files as FileDataMessages of the request instead of raw
+// bytes, so that the messages of other requests can go in between.
+constexpr uint32_t kCapabilityMultiplexing = 1u << 1;
+
+// The capabilities implemented by this version of the protocol.
+constexpr uint32_t kSupportedCapabilities = kCapabilityDeflateFiles | kCapabilityMultiplexing;
+
 class HandshakeMessage : public ISerializable
 {
  public:
@@ -59,10 +83,14 @@ class HandshakeMessage : public ISerializable
     uint32_t GetMinorVersion() const { return m_minor_version; }
     void SetMajorVersion(uint32_t major) { m_major_version = major; }
     void SetMinorVersion(uint32_t minor) { m_minor_version = minor; }
+    uint32_t GetCapabilities() const { return m_capabilities; }
+    void SetCapabilities(uint32_t capabilities) { m_capabilities = capabilities; }
 
  private:
     uint32_t m_major_version;
     uint32_t m_minor_version;
+    // kCapability* bits. Handshakes without it have no capabilities.
+    uint32_t m_capabilities = 0;
 };
 
 class EmptyMessage : public ISerializable
@@ -85,6 +113,28 @@ class StringMessage : public ISerializable
     std::string m_str;
 };
 
+// A [offset, offset + length) byte range of a file.
+class FileRangeMessage : public ISerializable
+{
+ public:
+    absl::Status Serialize(Buffer& dest) const override;
+    absl::Status Deserialize(const Buffer& src) override;
+
+    const std::string& GetFilePath() const { return m_file_path; }
+    void SetFilePath(std::string file_path) { m_file_path = std::move(file_path); }
+
+    uint64_t GetOffset() const { return m_offset; }
+    void SetOffset(uint64_t offset) { m_offset = offset; }
+
+    uint64_t GetLength() const { return m_length; }
+    void SetLength(uint64_t length) { m_length = length; }
+
+ private:
+    std::string m_file_path;
+    uint64_t m_offset = 0;
+    uint64_t m_length = 0;
+};
+
 class HandshakeRequest : public HandshakeMessage
 {
  public:
@@ -147,8 +197,8 @@ class DownloadFileResponse : public ISerializable
     const std::string& GetFilePath() const { return m_file_path; }
     void SetFilePath(std::string file_path) { m_file_path = std::move(file_path); }
 
-    const std::string& GetFileSizeStr() const { return m_file_size_str; }
-    void SetFileSizeStr(std::string file_size_str) { m_file_size_str = std::move(file_size_str); }
+    uint64_t GetFileSize() const { return m_file_size; }
+    void SetFileSize(uint64_t file_size) { m_file_size = file_size; }
 
  private:
     // Flag indicating whether the requested file was found on the server.
@@ -158,9 +208,8 @@ class DownloadFileResponse : public ISerializable
     // The local path where the downloaded file has been saved on the server.
     // It can be the same as the requested file path from client.
     std::string m_file_path;
-    // A string representation of the downloaded file's size.
-    // It avoids to use uint64_t which requires custom implementation for htonll/ntohll.
-    std::string m_file_size_str;
+    // The size of the downloaded file.
+    uint64_t m_file_size = 0;
 };
 
 // FileSizeRequest uses the string message as the file path for which we want to determine the size.
@@ -185,21 +234,150 @@ class FileSizeResponse : public ISerializable
     const std::string& GetErrorReason() const { return m_error_reason; }
     void SetErrorReason(std::string error_reason) { m_error_reason = std::move(error_reason); }
 
-    const std::string& GetFileSizeStr() const { return m_file_size_str; }
-    void SetFileSizeStr(std::string file_size_str) { m_file_size_str = std::move(file_size_str); }
+    uint64_t GetFileSize() const { return m_file_size; }
+    void SetFileSize(uint64_t file_size) { m_file_size = file_size; }
 
  private:
     // Flag indicating whether the file was found on the server.
     bool m_found = false;
     // A description of the error. Empty if successful.
     std::string m_error_reason;
-    // A string representation of the downloaded file's size.
-    // It avoids to use uint64_t which requires custom implementation for htonll/ntohll.
-    std::string m_file_size_str;
+    // The size of the requested file.
+    uint64_t m_file_size = 0;
+};
+
+// DownloadFileRangeRequest asks for a byte range of a file, so that a download can be resumed or
+// split across several connections.
+class DownloadFileRangeRequest : public FileRangeMessage
+{
+ public:
+    MessageType GetMessageType() const override
+    {
+        return MessageType::DOWNLOAD_FILE_RANGE_REQUEST;
+    }
+};
+
+// If successful, DownloadFileRangeResponse is followed by the GetLength() bytes of the range;
+// otherwise, it returns an error and nothing follows.
+class DownloadFileRangeResponse : public ISerializable
+{
+ public:
+    MessageType GetMessageType() const override
+    {
+        return MessageType::DOWNLOAD_FILE_RANGE_RESPONSE;
+    }
+    absl::Status Serialize(Buffer& dest) const override;
+    absl::Status Deserialize(const Buffer& src) override;
+
+    bool GetFound() const { return m_found; }
+    void SetFound(bool found) { m_found = found; }
+
+    const std::string& GetErrorReason() const { return m_error_reason; }
+    void SetErrorReason(std::string error_reason) { m_error_reason = std::move(error_reason); }
+
+    uint64_t GetFileSize() const { return m_file_size; }
+    void SetFileSize(uint64_t file_size) { m_file_size = file_size; }
+
+    uint64_t GetOffset() const { return m_offset; }
+    void SetOffset(uint64_t offset) { m_offset = offset; }
+
+    uint64_t GetLength() const { return m_length; }
+    void SetLength(uint64_t length) { m_length = length; }
+
+ private:
+    // Flag indicating whether the requested range could be served.
+    bool m_found = false;
+    // A description of the error. Empty if successful.
+    std::string m_error_reason;
+    // The size of the whole file.
+    uint64_t m_file_size = 0;
+    // The range that follows the response.
+    uint64_t m_offset = 0;
+    uint64_t m_length = 0;
+};
+
+// FileChecksumRequest asks for the CRC-32 of a byte range of a file.
+class FileChecksumRequest : public FileRangeMessage
+{
+ public:
+    MessageType GetMessageType() const override { return MessageType::FILE_CHECKSUM_REQUEST; }
+};
+
+// If successful, FileChecksumResponse returns the CRC-32 of the requested range; otherwise, it
+// returns an error.
+class FileChecksumResponse : public ISerializable
+{
+ public:
+    MessageType GetMessageType() const override { return MessageType::FILE_CHECKSUM_RESPONSE; }
+    absl::Status Serialize(Buffer& dest) const override;
+    absl::Status Deserialize(const Buffer& src) override;
+
+    bool GetFound() const { return m_found; }
+    void SetFound(bool found) { m_found = found; }
+
+    const std::string& GetErrorReason() const { return m_error_reason; }
+    void SetErrorReason(std::string error_reason) { m_error_reason = std::move(error_reason); }
+
+    uint64_t GetFileSize() const { return m_file_size; }
+    void SetFileSize(uint64_t file_size) { m_file_size = file_size; }
+
+    uint32_t GetChecksum() const { return m_checksum; }
+    void SetChecksum(uint32_t checksum) { m_checksum = checksum; }
+
+ private:
+    // Flag indicating whether the checksum could be computed.
+    bool m_found = false;
+    // A description of the error. Empty if successful.
+    std::string m_error_reason;
+    // The size of the whole file.
+    uint64_t m_file_size = 0;
+    // CRC-32 of the requested range.
+    uint32_t m_checksum = 0;
+};
+
+// A chunk of the file sent for a DownloadFileRequest or a DownloadFileRangeRequest on a multiplexed
+// connection. The chunks follow the response, in order, and hold the bytes that would otherwise be
+// sent raw, i.e. encoded with the FileCompression of the connection.
+class FileDataMessage : public ISerializable
+{
+ public:
+    MessageType GetMessageType() const override { return MessageType::FILE_DATA; }
+    absl::Status Serialize(Buffer& dest) const override;
+    absl::Status Deserialize(const Buffer& src) override;
+
+    const Buffer& GetData() const { return m_data; }
+    void SetData(const uint8_t* data, size_t size) { m_data.assign(data, data + size); }
+    void SetData(Buffer data) { m_data = std::move(data); }
+
+ private:
+    Buffer m_data;
 };
 
 // Message Helper Functions (TLV Framing).
 
+// Every message is a header, followed by the serialized message.
+struct MessageHeader
+{
+    uint32_t type = 0;
+    uint32_t payload_size = 0;
+    uint32_t request_id = 0;
+};
+
+constexpr size_t kMessageHeaderSize = 3 * sizeof(uint32_t);
+
+// Largest payload accepted for a message.
+constexpr uint32_t kMaxPayloadSize = 16 * 1024 * 1024;
+
+// Appends the kMessageHeaderSize bytes of the header.
+void WriteMessageHeader(const MessageHeader& header, Buffer& dest);
+
+// Parses the kMessageHeaderSize bytes of a header.
+absl::StatusOr<MessageHeader> ParseMessageHeader(const uint8_t* data);
+
+// Creates the message of the header from its payload.
+absl::StatusOr<std::unique_ptr<ISerializable>> DeserializeMessage(const MessageHeader& header,
+                                                                  Buffer payload);
+
 // Helper to receive an exact number of bytes.
 absl::Status ReceiveBuffer(SocketConnection* conn, uint8_t* buffer, size_t size,
                            int timeout_ms = kNoTimeout);
@@ -53,6 +53,26 @@ TEST(MessagesTest, WriteAndReadUint32)
     ASSERT_EQ(write_value, *read_value);
 }
 
+TEST(MessagesTest, WriteAndReadUint64)
+{
+    Network::Buffer buf;
+    const uint64_t write_values[] = {0, 123456703, 0x123456789abcdef0,
+                                     std::numeric_limits<uint64_t>::max()};
+    for (uint64_t write_value : write_values)
+    {
+        buf.clear();
+        Network::WriteUint64ToBuffer(write_value, buf);
+        ASSERT_EQ(buf.size(), sizeof(uint64_t));
+        size_t offset = 0;
+        ASSERT_THAT(Network::ReadUint64FromBuffer(buf, offset), IsOkAndHolds(write_value));
+        ASSERT_EQ(offset, sizeof(uint64_t));
+    }
+
+    buf.resize(sizeof(uint64_t) - 1);
+    size_t offset = 0;
+    ASSERT_FALSE(Network::ReadUint64FromBuffer(buf, offset).ok());
+}
+
 TEST(MessagesTest, WriteAndReadString)
 {
     Network::Buffer buf;
@@ -77,6 +97,7 @@ TEST(MessagesTest, HandShakeMessage)
     Network::HandshakeRequest request;
     request.SetMajorVersion(345612);
     request.SetMinorVersion(567348);
+    request.SetCapabilities(Network::kCapabilityDeflateFiles);
     Network::Buffer buf;
     auto status = request.Serialize(buf);
     ASSERT_TRUE(status.ok());
@@ -89,6 +110,14 @@ TEST(MessagesTest, HandShakeMessage)
 
     ASSERT_EQ(request.GetMajorVersion(), response.GetMajorVersion());
     ASSERT_EQ(request.GetMinorVersion(), response.GetMinorVersion());
+    ASSERT_EQ(request.GetCapabilities(), response.GetCapabilities());
+
+    // A handshake from a peer that predates capabilities has none.
+    buf.resize(2 * sizeof(uint32_t));
+    status = response.Deserialize(buf);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(response.GetMajorVersion(), request.GetMajorVersion());
+    ASSERT_EQ(response.GetCapabilities(), 0u);
 }
 
 TEST(MessagesTest, PingPongMessage)
@@ -146,7 +175,7 @@ TEST(MessagesTest, DownloadFileMessage)
     res_serialize.SetFound(false);
     res_serialize.SetErrorReason("File not found!");
     res_serialize.SetFilePath("/sdcard/captures/other_capture_0456.rd");
-    res_serialize.SetFileSizeStr("234512340012367880000000000000");
+    res_serialize.SetFileSize(std::numeric_limits<uint64_t>::max() - 1234);
     buf.clear();
     status = res_serialize.Serialize(buf);
     ASSERT_TRUE(status.ok());
@@ -158,7 +187,7 @@ TEST(MessagesTest, DownloadFileMessage)
     ASSERT_EQ(res_serialize.GetFound(), res_deserialize.GetFound());
     ASSERT_EQ(res_serialize.GetErrorReason(), res_deserialize.GetErrorReason());
     ASSERT_EQ(res_serialize.GetFilePath(), res_deserialize.GetFilePath());
-    ASSERT_EQ(res_serialize.GetFileSizeStr(), res_deserialize.GetFileSizeStr());
+    ASSERT_EQ(res_serialize.GetFileSize(), res_deserialize.GetFileSize());
 }
 
 TEST(MessagesTest, FileSizeMessage)
@@ -178,7 +207,7 @@ TEST(MessagesTest, FileSizeMessage)
     Network::FileSizeResponse res_serialize;
     res_serialize.SetFound(false);
     res_serialize.SetErrorReason("File not found!");
-    res_serialize.SetFileSizeStr("256000000000000");
+    res_serialize.SetFileSize(256000000000000ull);
     buf.clear();
     status = res_serialize.Serialize(buf);
     ASSERT_TRUE(status.ok());
@@ -189,7 +218,131 @@ TEST(MessagesTest, FileSizeMessage)
     ASSERT_EQ(res_deserialize.GetMessageType(), Network::MessageType::FILE_SIZE_RESPONSE);
     ASSERT_EQ(res_serialize.GetFound(), res_deserialize.GetFound());
     ASSERT_EQ(res_serialize.GetErrorReason(), res_deserialize.GetErrorReason());
-    ASSERT_EQ(res_serialize.GetFileSizeStr(), res_deserialize.GetFileSizeStr());
+    ASSERT_EQ(res_serialize.GetFileSize(), res_deserialize.GetFileSize());
+}
+
+TEST(MessagesTest, DownloadFileRangeMessage)
+{
+    Network::DownloadFileRangeRequest req_serialize;
+    req_serialize.SetFilePath("/sdcard/captures/dive_capture_0789.rd");
+    req_serialize.SetOffset(5000000000ull);
+    req_serialize.SetLength(64ull << 20);
+    Network::Buffer buf;
+    auto status = req_serialize.Serialize(buf);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(req_serialize.GetMessageType(), Network::MessageType::DOWNLOAD_FILE_RANGE_REQUEST);
+    Network::DownloadFileRangeRequest req_deserialize;
+    status = req_deserialize.Deserialize(buf);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(req_serialize.GetFilePath(), req_deserialize.GetFilePath());
+    ASSERT_EQ(req_serialize.GetOffset(), req_deserialize.GetOffset());
+    ASSERT_EQ(req_serialize.GetLength(), req_deserialize.GetLength());
+
+    Network::DownloadFileRangeResponse res_serialize;
+    res_serialize.SetFound(true);
+    res_serialize.SetFileSize(6000000000ull);
+    res_serialize.SetOffset(5000000000ull);
+    res_serialize.SetLength(64ull << 20);
+    buf.clear();
+    status = res_serialize.Serialize(buf);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(res_serialize.GetMessageType(), Network::MessageType::DOWNLOAD_FILE_RANGE_RESPONSE);
+    Network::DownloadFileRangeResponse res_deserialize;
+    status = res_deserialize.Deserialize(buf);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(res_serialize.GetFound(), res_deserialize.GetFound());
+    ASSERT_EQ(res_serialize.GetErrorReason(), res_deserialize.GetErrorReason());
+    ASSERT_EQ(res_serialize.GetFileSize(), res_deserialize.GetFileSize());
+    ASSERT_EQ(res_serialize.GetOffset(), res_deserialize.GetOffset());
+    ASSERT_EQ(res_serialize.GetLength(), res_deserialize.GetLength());
+}
+
+TEST(MessagesTest, FileChecksumMessage)
+{
+    Network::FileChecksumRequest req_serialize;
+    req_serialize.SetFilePath("/sdcard/captures/dive_capture_0789.rd");
+    req_serialize.SetOffset(0);
+    req_serialize.SetLength(4096);
+    Network::Buffer buf;
+    auto status = req_serialize.Serialize(buf);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(req_serialize.GetMessageType(), Network::MessageType::FILE_CHECKSUM_REQUEST);
+    Network::FileChecksumRequest req_deserialize;
+    status = req_deserialize.Deserialize(buf);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(req_serialize.GetFilePath(), req_deserialize.GetFilePath());
+    ASSERT_EQ(req_serialize.GetOffset(), req_deserialize.GetOffset());
+    ASSERT_EQ(req_serialize.GetLength(), req_deserialize.GetLength());
+
+    Network::FileChecksumResponse res_serialize;
+    res_serialize.SetFound(false);
+    res_serialize.SetErrorReason("Range is out of bounds!");
+    res_serialize.SetFileSize(1024);
+    res_serialize.SetChecksum(0xcbf43926);
+    buf.clear();
+    status = res_serialize.Serialize(buf);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(res_serialize.GetMessageType(), Network::MessageType::FILE_CHECKSUM_RESPONSE);
+    Network::FileChecksumResponse res_deserialize;
+    status = res_deserialize.Deserialize(buf);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(res_serialize.GetFound(), res_deserialize.GetFound());
+    ASSERT_EQ(res_serialize.GetErrorReason(), res_deserialize.GetErrorReason());
+    ASSERT_EQ(res_serialize.GetFileSize(), res_deserialize.GetFileSize());
+    ASSERT_EQ(res_serialize.GetChecksum(), res_deserialize.GetChecksum());
+}
+
+TEST(MessagesTest, FileDataMessage)
+{
+    const uint8_t data[] = {0, 1, 2, 3, 255, 254, 253};
+    Network::FileDataMessage msg_serialize;
+    msg_serialize.SetData(data, sizeof(data));
+    Network::Buffer buf;
+    auto status = msg_serialize.Serialize(buf);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(msg_serialize.GetMessageType(), Network::MessageType::FILE_DATA);
+    ASSERT_EQ(buf.size(), sizeof(data));
+    Network::FileDataMessage msg_deserialize;
+    status = msg_deserialize.Deserialize(buf);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(msg_serialize.GetData(), msg_deserialize.GetData());
+}
+
+TEST(MessagesTest, MessageHeader)
+{
+    Network::MessageHeader header;
+    header.type = static_cast<uint32_t>(Network::MessageType::FILE_SIZE_REQUEST);
+    header.request_id = 0x12345678;
+    Network::FileSizeRequest request;
+    request.SetString("/sdcard/captures/dive_capture_0789.rd");
+    Network::Buffer payload;
+    ASSERT_TRUE(request.Serialize(payload).ok());
+    header.payload_size = static_cast<uint32_t>(payload.size());
+
+    Network::Buffer buf;
+    Network::WriteMessageHeader(header, buf);
+    ASSERT_EQ(buf.size(), Network::kMessageHeaderSize);
+    auto parsed = Network::ParseMessageHeader(buf.data());
+    ASSERT_TRUE(parsed.ok());
+    ASSERT_EQ(parsed->type, header.type);
+    ASSERT_EQ(parsed->payload_size, header.payload_size);
+    ASSERT_EQ(parsed->request_id, header.request_id);
+
+    auto message = Network::DeserializeMessage(*parsed, payload);
+    ASSERT_TRUE(message.ok());
+    ASSERT_EQ((*message)->GetMessageType(), Network::MessageType::FILE_SIZE_REQUEST);
+    ASSERT_EQ((*message)->GetRequestId(), header.request_id);
+    auto* deserialized = dynamic_cast<Network::FileSizeRequest*>(message->get());
+    ASSERT_NE(deserialized, nullptr);
+    ASSERT_EQ(deserialized->GetString(), request.GetString());
+
+    header.payload_size = Network::kMaxPayloadSize + 1;
+    buf.clear();
+    Network::WriteMessageHeader(header, buf);
+    ASSERT_FALSE(Network::ParseMessageHeader(buf.data()).ok());
+
+    header.type = 0xffff;
+    ASSERT_FALSE(Network::DeserializeMessage(header, payload).ok());
 }
 
 }  // namespace
\ No newline at end of file
@@ -0,0 +1,157 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "multiplexed_connection.h"
+
+#include <chrono>
+
+#include "absl/strings/str_cat.h"
+#include "dive/common/status.h"
+
+namespace Network
+{
+
+MultiplexedConnection::MultiplexedConnection(SocketConnection* connection) :
+    m_connection(connection)
+{
+}
+
+MultiplexedConnection::~MultiplexedConnection() { Stop(); }
+
+void MultiplexedConnection::Start()
+{
+    m_reader_thread = std::thread(&MultiplexedConnection::ReaderLoop, this);
+}
+
+void MultiplexedConnection::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    m_connection->Shutdown();
+    if (m_reader_thread.joinable())
+    {
+        m_reader_thread.join();
+    }
+}
+
+absl::StatusOr<uint32_t> MultiplexedConnection::SendRequest(ISerializable& request)
+{
+    uint32_t request_id;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_reader_done)
+        {
+            return m_reader_status;
+        }
+        // 0 is for the messages that are not part of a request.
+        request_id = m_next_request_id++;
+        if (m_next_request_id == 0)
+        {
+            m_next_request_id = 1;
+        }
+        m_requests[request_id];
+    }
+
+    request.SetRequestId(request_id);
+    absl::Status status = SendSocketMessage(m_connection, request);
+    if (!status.ok())
+    {
+        EndRequest(request_id);
+        return status;
+    }
+    return request_id;
+}
+
+absl::StatusOr<std::unique_ptr<ISerializable>> MultiplexedConnection::ReceiveMessage(
+    uint32_t request_id, int timeout_ms)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_requests.find(request_id);
+    if (it == m_requests.end())
+    {
+        return Dive::FailedPreconditionError(
+            absl::StrCat("ReceiveMessage: Unknown request ", request_id));
+    }
+    auto& messages = it->second;
+    auto ready = [&] { return !messages.empty() || m_reader_done; };
+    if (timeout_ms < 0)
+    {
+        m_cv.wait(lock, ready);
+    }
+    else if (!m_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready))
+    {
+        return Dive::DeadlineExceededError("ReceiveMessage: Timeout waiting for response.");
+    }
+    if (messages.empty())
+    {
+        return m_reader_status;
+    }
+
+    std::unique_ptr<ISerializable> message = std::move(messages.front());
+    messages.pop_front();
+    lock.unlock();
+    m_cv.notify_all();
+    return message;
+}
+
+void MultiplexedConnection::EndRequest(uint32_t request_id)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.erase(request_id);
+    }
+    m_cv.notify_all();
+}
+
+void MultiplexedConnection::ReaderLoop()
+{
+    while (true)
+    {
+        auto message = ReceiveSocketMessage(m_connection);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!message.ok())
+        {
+            m_reader_status = m_stopping ? Dive::CancelledError("Connection stopped.")
+                                         : message.status();
+            m_reader_done = true;
+            lock.unlock();
+            m_cv.notify_all();
+            return;
+        }
+
+        // Wait for the request to take its previous messages. The messages of a request that was
+        // ended, e.g. the rest of a download that failed, are dropped.
+        const uint32_t request_id = (*message)->GetRequestId();
+        auto it = m_requests.end();
+        m_cv.wait(lock, [&] {
+            it = m_requests.find(request_id);
+            return m_stopping || it == m_requests.end() ||
+                   it->second.size() < kMaxQueuedMessages;
+        });
+        if (!m_stopping && it != m_requests.end())
+        {
+            it->second.push_back(*std::move(message));
+            lock.unlock();
+            m_cv.notify_all();
+        }
+    }
+}
+
+}  // namespace Network
@@ -0,0 +1,81 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "messages.h"
+
+namespace Network
+{
+
+// Client side of a connection on which kCapabilityMultiplexing was negotiated. Any thread may send
+// a request, and a reader thread receives all the messages and routes each of them to the request
+// whose id it carries, so that a ping is not held behind the file of a download.
+class MultiplexedConnection
+{
+ public:
+    // Received messages that a request has not taken yet, past which the reader waits for it. This
+    // bounds the memory held when a download is written slower than it is received.
+    static constexpr size_t kMaxQueuedMessages = 32;
+
+    // The connection must outlive the MultiplexedConnection.
+    explicit MultiplexedConnection(SocketConnection* connection);
+    ~MultiplexedConnection();
+
+    MultiplexedConnection(const MultiplexedConnection&) = delete;
+    MultiplexedConnection& operator=(const MultiplexedConnection&) = delete;
+
+    // Starts the reader thread.
+    void Start();
+
+    // Shuts the connection down and joins the reader thread. The pending and future requests fail.
+    void Stop();
+
+    // Gives the request a new id and sends it. Returns the id.
+    absl::StatusOr<uint32_t> SendRequest(ISerializable& request);
+
+    // Waits for the next message of the request.
+    absl::StatusOr<std::unique_ptr<ISerializable>> ReceiveMessage(uint32_t request_id,
+                                                                  int timeout_ms = kNoTimeout);
+
+    // Forgets the request. Its messages still to come are dropped.
+    void EndRequest(uint32_t request_id);
+
+ private:
+    void ReaderLoop();
+
+    SocketConnection* m_connection;
+    std::thread m_reader_thread;
+
+    std::mutex m_mutex;
+    // Notified when a message is queued or taken, and when the reader stops.
+    std::condition_variable m_cv;
+    std::unordered_map<uint32_t, std::deque<std::unique_ptr<ISerializable>>> m_requests;
+    uint32_t m_next_request_id = 1;
+    bool m_stopping = false;
+    // Set when the reader stops, with the error the requests then fail with.
+    bool m_reader_done = false;
+    absl::Status m_reader_status;
+};
+
+}  // namespace Network
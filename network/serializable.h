@@ -42,6 +42,15 @@ class ISerializable
     // Deserializes the object's state from the source buffer.
     // Returns absl::OkStatus() on success, or an error status on failure.
     virtual absl::Status Deserialize(const Buffer& src) = 0;
+
+    // Identifies the request a message belongs to, so that the messages of several requests can
+    // be interleaved on a connection. Responses carry the id of their request. 0 is for messages
+    // that are not part of a multiplexed request.
+    uint32_t GetRequestId() const { return m_request_id; }
+    void SetRequestId(uint32_t request_id) { m_request_id = request_id; }
+
+ private:
+    uint32_t m_request_id = 0;
 };
 
 }  // namespace Network
\ No newline at end of file
@@ -16,16 +16,149 @@ limitations under the License.
 
 #include "socket_connection.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <string>
 #include <vector>
 
+#if defined(__linux__)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#endif
+
 #include "absl/strings/str_cat.h"
 #include "dive/common/status.h"
+#include "zlib.h"
 
 namespace Network
 {
 
+namespace
+{
+
+// A deflated file is sent as a sequence of blocks, each made of the size of the raw chunk, the
+// size of the payload and the payload. The payload is the raw chunk when deflating does not make
+// it smaller.
+constexpr size_t kDeflateBlockHeaderSize = sizeof(uint32_t) * 2;
+constexpr size_t kMaxDeflateBlockSize = 64 << 20;
+// Favor throughput: the device CPU deflates while the file is being sent.
+constexpr int kDeflateLevel = Z_BEST_SPEED;
+
+void WriteBlockHeader(uint32_t raw_size, uint32_t payload_size, uint8_t* dest)
+{
+    uint32_t net_raw_size = htonl(raw_size);
+    uint32_t net_payload_size = htonl(payload_size);
+    std::memcpy(dest, &net_raw_size, sizeof(uint32_t));
+    std::memcpy(dest + sizeof(uint32_t), &net_payload_size, sizeof(uint32_t));
+}
+
+void ReadBlockHeader(const uint8_t* src, size_t* raw_size, size_t* payload_size)
+{
+    uint32_t net_raw_size, net_payload_size;
+    std::memcpy(&net_raw_size, src, sizeof(uint32_t));
+    std::memcpy(&net_payload_size, src + sizeof(uint32_t), sizeof(uint32_t));
+    *raw_size = ntohl(net_raw_size);
+    *payload_size = ntohl(net_payload_size);
+}
+
+// Returns the raw chunk of the block payload, which is either the payload itself or its inflated
+// content in chunk. Returns nullptr if the payload cannot be inflated.
+const uint8_t* InflateBlock(const uint8_t* payload, size_t payload_size, size_t raw_size,
+                            std::vector<uint8_t>& chunk)
+{
+    if (payload_size == raw_size)
+    {
+        return payload;
+    }
+    chunk.resize(raw_size);
+    uLongf inflated_size = static_cast<uLongf>(raw_size);
+    if (uncompress(chunk.data(), &inflated_size, payload, static_cast<uLong>(payload_size)) !=
+            Z_OK ||
+        inflated_size != raw_size)
+    {
+        return nullptr;
+    }
+    return chunk.data();
+}
+
+}  // namespace
+
+#if defined(__linux__)
+namespace
+{
+
+// sendfile() has no MSG_NOSIGNAL, so SIGPIPE is blocked on the calling thread while sending, and
+// the SIGPIPE raised when the peer has closed the connection is discarded afterwards
+class ScopedSigpipeBlock
+{
+ public:
+    ScopedSigpipeBlock()
+    {
+        sigemptyset(&m_sigpipe_set);
+        sigaddset(&m_sigpipe_set, SIGPIPE);
+        sigset_t pending_set;
+        sigemptyset(&pending_set);
+        m_was_pending = (sigpending(&pending_set) == 0) && sigismember(&pending_set, SIGPIPE);
+        m_blocked = (pthread_sigmask(SIG_BLOCK, &m_sigpipe_set, &m_old_set) == 0);
+    }
+
+    ~ScopedSigpipeBlock()
+    {
+        if (!m_blocked)
+        {
+            return;
+        }
+        sigset_t pending_set;
+        sigemptyset(&pending_set);
+        if (!m_was_pending && (sigpending(&pending_set) == 0) &&
+            sigismember(&pending_set, SIGPIPE))
+        {
+            timespec no_wait = {};
+            sigtimedwait(&m_sigpipe_set, nullptr, &no_wait);
+        }
+        pthread_sigmask(SIG_SETMASK, &m_old_set, nullptr);
+    }
+
+    ScopedSigpipeBlock(const ScopedSigpipeBlock&) = delete;
+    ScopedSigpipeBlock& operator=(const ScopedSigpipeBlock&) = delete;
+
+ private:
+    sigset_t m_sigpipe_set;
+    sigset_t m_old_set;
+    bool m_was_pending = false;
+    bool m_blocked = false;
+};
+
+// Closes the file descriptor when going out of scope
+class ScopedFileDescriptor
+{
+ public:
+    explicit ScopedFileDescriptor(int fd) : m_fd(fd) {}
+    ~ScopedFileDescriptor()
+    {
+        if (m_fd >= 0)
+        {
+            ::close(m_fd);
+        }
+    }
+
+    ScopedFileDescriptor(const ScopedFileDescriptor&) = delete;
+    ScopedFileDescriptor& operator=(const ScopedFileDescriptor&) = delete;
+
+    int Get() const { return m_fd; }
+
+ private:
+    int m_fd;
+};
+
+}  // namespace
+#endif
+
 NetworkInitializer::NetworkInitializer() : m_initialized(false)
 {
 #ifdef WIN32
@@ -67,10 +200,31 @@ absl::StatusOr<std::unique_ptr<SocketConnection>> SocketConnection::Create(
 SocketConnection::~SocketConnection() { Close(); }
 
 SocketConnection::SocketConnection(SocketType initial_socket_value)
-    : m_socket(initial_socket_value), m_is_listening(false), m_accept_timout_ms(kAcceptTimeout)
+    : m_socket(initial_socket_value),
+      m_is_listening(false),
+      m_accept_timout_ms(kAcceptTimeout),
+      m_file_chunk_size(kDefaultFileChunkSize),
+      m_file_compression(FileCompression::kNone),
+      m_multiplexed(false)
 {
 }
 
+void SocketConnection::SetFileChunkSize(size_t chunk_size)
+{
+    m_file_chunk_size = std::max<size_t>(chunk_size, 1);
+}
+
+void SocketConnection::SetFileCompression(FileCompression compression)
+{
+    m_file_compression = compression;
+}
+
+FileCompression SocketConnection::GetFileCompression() const { return m_file_compression; }
+
+void SocketConnection::SetMultiplexed(bool multiplexed) { m_multiplexed.store(multiplexed); }
+
+bool SocketConnection::IsMultiplexed() const { return m_multiplexed.load(); }
+
 absl::Status SocketConnection::BindAndListenOnUnixDomain(const std::string& server_address)
 {
 #ifdef WIN32
@@ -215,6 +369,12 @@ absl::Status SocketConnection::Send(const uint8_t* data, size_t size)
         return Dive::FailedPreconditionError(
             "Send: Socket is invalid or operation not supported on a listening socket.");
     }
+    std::lock_guard<std::mutex> lock(m_send_mutex);
+    return SendLocked(data, size);
+}
+
+absl::Status SocketConnection::SendLocked(const uint8_t* data, size_t size)
+{
     if (size == 0)
     {
         return Dive::OkStatus();
@@ -392,6 +552,43 @@ absl::StatusOr<size_t> SocketConnection::Recv(uint8_t* data, size_t size, int ti
     return total_received;
 }
 
+absl::StatusOr<size_t> SocketConnection::RecvAvailable(uint8_t* data, size_t size)
+{
+#ifdef WIN32
+    return Dive::UnimplementedError(
+        "RecvAvailable: This POSIX method is not supported/implemented on Windows.");
+#else
+    if (!IsOpen() || m_is_listening)
+    {
+        return Dive::FailedPreconditionError(
+            "RecvAvailable: Socket is invalid or operation not supported on a listening socket.");
+    }
+    if (size == 0)
+    {
+        return 0;
+    }
+    ssize_t received = ::recv(m_socket, data, size, MSG_DONTWAIT);
+    if (received == -1)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        {
+            return 0;
+        }
+        if (errno == ECONNRESET)
+        {
+            return Dive::AbortedError("RecvAvailable: Connection reset by peer.");
+        }
+        return Dive::InternalError(
+            absl::StrCat("RecvAvailable: recv() system call failed: ", strerror(errno)));
+    }
+    if (received == 0)
+    {
+        return Dive::OutOfRangeError("RecvAvailable: Connection gracefully closed by peer.");
+    }
+    return static_cast<size_t>(received);
+#endif
+}
+
 absl::Status SocketConnection::SendString(const std::string& s)
 {
     // Include null terminator.
@@ -424,6 +621,179 @@ absl::StatusOr<std::string> SocketConnection::ReceiveString()
 }
 
 absl::Status SocketConnection::SendFile(const std::string& file_path)
+{
+    std::error_code ec;
+    uint64_t file_size = std::filesystem::file_size(file_path, ec);
+    if (ec)
+    {
+        return Dive::NotFoundError(
+            absl::StrCat("SendFile: Failed to open file '", file_path, "': ", ec.message()));
+    }
+    return SendFileRange(file_path, 0, file_size);
+}
+
+absl::Status SocketConnection::SendFileRange(const std::string& file_path, uint64_t offset,
+                                             uint64_t length)
+{
+    return SendFileRangeFrames(file_path, offset, length, m_file_chunk_size, nullptr);
+}
+
+absl::Status SocketConnection::SendFileRangeFrames(const std::string& file_path, uint64_t offset,
+                                                   uint64_t length, size_t max_chunk_size,
+                                                   const FrameHeaderCallback& frame_header)
+{
+#if defined(__linux__)
+    if (m_file_compression == FileCompression::kNone)
+    {
+        return SendFileZeroCopy(file_path, offset, length, max_chunk_size, frame_header);
+    }
+#endif
+    auto send_chunk = [this, &file_path, &frame_header](const uint8_t* chunk, size_t size) {
+        std::lock_guard<std::mutex> lock(m_send_mutex);
+        absl::Status ret;
+        if (frame_header)
+        {
+            std::vector<uint8_t> header = frame_header(size);
+            ret = SendLocked(header.data(), header.size());
+        }
+        if (ret.ok())
+        {
+            ret = SendLocked(chunk, size);
+        }
+        if (!ret.ok())
+        {
+            return Dive::StatusWithContext(
+                ret, absl::StrCat("SendFile: Failed to send chunk for file '", file_path, "'"));
+        }
+        return ret;
+    };
+    return ReadFileRangeChunks(file_path, offset, length, max_chunk_size, send_chunk);
+}
+
+absl::Status SocketConnection::SendFileZeroCopy(const std::string& file_path, uint64_t offset,
+                                                uint64_t length, size_t max_chunk_size,
+                                                const FrameHeaderCallback& frame_header)
+{
+#if defined(__linux__)
+    if (!IsOpen() || m_is_listening)
+    {
+        return Dive::FailedPreconditionError(
+            "SendFile: Socket is invalid or operation not supported on a listening socket.");
+    }
+
+    ScopedFileDescriptor file_fd(::open(file_path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (file_fd.Get() < 0)
+    {
+        return Dive::NotFoundError(absl::StrCat("SendFile: Failed to open file '", file_path, "'"));
+    }
+
+    struct stat file_stat;
+    if (::fstat(file_fd.Get(), &file_stat) != 0)
+    {
+        return Dive::InternalError(
+            absl::StrCat("SendFile: Failed to determine size of file '", file_path, "'"));
+    }
+    const uint64_t file_size = static_cast<uint64_t>(file_stat.st_size);
+    if (offset > file_size || length > file_size - offset)
+    {
+        return Dive::OutOfRangeError(absl::StrCat("SendFile: Range [", offset, ", ",
+                                                  offset + length, ") is outside of file '",
+                                                  file_path, "' of size ", file_size));
+    }
+
+    ScopedSigpipeBlock sigpipe_block;
+    const size_t chunk_size = std::min(m_file_chunk_size, std::max<size_t>(max_chunk_size, 1));
+    off_t file_offset = static_cast<off_t>(offset);
+    const off_t end_offset = static_cast<off_t>(offset + length);
+    // Filled once sendfile() turns out not to support the file. The frame whose header is already
+    // sent is then completed, and the rest of the file follows, through it.
+    std::vector<uint8_t> read_buffer;
+    while (file_offset < end_offset)
+    {
+        const size_t frame_size =
+            static_cast<size_t>(std::min<uint64_t>(chunk_size, end_offset - file_offset));
+        const off_t frame_end = file_offset + static_cast<off_t>(frame_size);
+        // Held for the whole frame, so that the data of concurrent Send calls goes between frames.
+        std::lock_guard<std::mutex> lock(m_send_mutex);
+        if (frame_header)
+        {
+            std::vector<uint8_t> header = frame_header(frame_size);
+            absl::Status ret = SendLocked(header.data(), header.size());
+            if (!ret.ok())
+            {
+                return ret;
+            }
+        }
+        while (file_offset < frame_end)
+        {
+            const size_t to_send = static_cast<size_t>(frame_end - file_offset);
+            if (!read_buffer.empty())
+            {
+                ssize_t read = ::pread(file_fd.Get(), read_buffer.data(),
+                                       std::min(to_send, read_buffer.size()), file_offset);
+                if (read == -1 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (read <= 0)
+                {
+                    return Dive::DataLossError(absl::StrCat(
+                        "SendFile: Failed to read chunk from file '", file_path, "'"));
+                }
+                absl::Status ret = SendLocked(read_buffer.data(), static_cast<size_t>(read));
+                if (!ret.ok())
+                {
+                    return ret;
+                }
+                file_offset += static_cast<off_t>(read);
+                continue;
+            }
+
+            ssize_t sent = ::sendfile(m_socket, file_fd.Get(), &file_offset, to_send);
+            if (sent == -1)
+            {
+                int e = errno;
+                if (e == EINTR)
+                {
+                    continue;
+                }
+                if (e == EINVAL || e == ENOSYS)
+                {
+                    read_buffer.resize(chunk_size);
+                    continue;
+                }
+                if (e == EAGAIN || e == EWOULDBLOCK)
+                {
+                    return Dive::UnavailableError("SendFile: Operation would block.");
+                }
+                if (e == EPIPE || e == ECONNRESET)
+                {
+                    Close();
+                    return Dive::AbortedError(
+                        "SendFile: Connection reset by peer (EPIPE/ECONNRESET).");
+                }
+                return Dive::InternalError(
+                    absl::StrCat("SendFile: sendfile() failed for file '", file_path,
+                                 "': ", strerror(e)));
+            }
+            if (sent == 0)
+            {
+                return Dive::DataLossError(
+                    absl::StrCat("SendFile: File size mismatch. Read 0 bytes "
+                                 "before reaching expected end of file '",
+                                 file_path, "'"));
+            }
+        }
+    }
+    return Dive::OkStatus();
+#else
+    return Dive::UnimplementedError("SendFile: sendfile() is not available on this platform.");
+#endif
+}
+
+absl::Status SocketConnection::ReadFileRangeChunks(const std::string& file_path, uint64_t offset,
+                                                   uint64_t length, size_t max_chunk_size,
+                                                   const FileChunkCallback& chunk_callback)
 {
     std::ifstream file_stream(file_path, std::ios::binary | std::ios::ate);
     if (!file_stream)
@@ -433,46 +803,99 @@ absl::Status SocketConnection::SendFile(const std::string& file_path)
     std::streamsize file_size = file_stream.tellg();
     if (file_size < 0)
     {
-        file_stream.close();
         return Dive::InternalError(
             absl::StrCat("SendFile: Failed to determine size of file '", file_path, "'"));
     }
+    if (offset > static_cast<uint64_t>(file_size) ||
+        length > static_cast<uint64_t>(file_size) - offset)
+    {
+        return Dive::OutOfRangeError(absl::StrCat("SendFile: Range [", offset, ", ",
+                                                  offset + length, ") is outside of file '",
+                                                  file_path, "' of size ", file_size));
+    }
 
-    file_stream.seekg(0);
-    const size_t CHUNK_SIZE = 4096;
-    std::vector<char> buffer(CHUNK_SIZE);
-    std::streamsize total_sent = 0;
-    while (total_sent < file_size)
+    file_stream.seekg(static_cast<std::streamoff>(offset));
+    const bool deflate = (m_file_compression == FileCompression::kDeflate);
+    size_t chunk_size = std::min(m_file_chunk_size, std::max<size_t>(max_chunk_size, 1));
+    if (deflate)
+    {
+        chunk_size = std::min(chunk_size, kMaxDeflateBlockSize);
+    }
+    chunk_size = static_cast<size_t>(std::min<uint64_t>(chunk_size, length));
+    std::vector<char> chunk(chunk_size);
+    std::vector<uint8_t> block(deflate ? kDeflateBlockHeaderSize + compressBound(chunk_size) : 0);
+    uint64_t total_read = 0;
+    while (total_read < length)
     {
-        std::streamsize to_read =
-            std::min(static_cast<std::streamsize>(CHUNK_SIZE), file_size - total_sent);
-        if (!file_stream.read(buffer.data(), to_read))
+        size_t to_read = static_cast<size_t>(std::min<uint64_t>(chunk_size, length - total_read));
+        if (!file_stream.read(chunk.data(), static_cast<std::streamsize>(to_read)))
         {
-            file_stream.close();
             return Dive::InternalError(
                 absl::StrCat("SendFile: Failed to read chunk from file '", file_path, "'"));
         }
-        size_t current_read = static_cast<size_t>(file_stream.gcount());
-        if (current_read == 0)
+
+        absl::Status ret;
+        if (!deflate)
         {
-            file_stream.close();
-            return Dive::DataLossError(
-                absl::StrCat("SendFile: File size mismatch. Read 0 bytes "
-                             "before reaching expected end of file '",
-                             file_path, "'"));
+            ret = chunk_callback(reinterpret_cast<const uint8_t*>(chunk.data()), to_read);
+        }
+        else
+        {
+            uint8_t* payload = block.data() + kDeflateBlockHeaderSize;
+            uLongf payload_size = static_cast<uLongf>(block.size() - kDeflateBlockHeaderSize);
+            if (compress2(payload, &payload_size, reinterpret_cast<const Bytef*>(chunk.data()),
+                          static_cast<uLong>(to_read), kDeflateLevel) != Z_OK ||
+                payload_size >= to_read)
+            {
+                std::memcpy(payload, chunk.data(), to_read);
+                payload_size = static_cast<uLongf>(to_read);
+            }
+            WriteBlockHeader(static_cast<uint32_t>(to_read), static_cast<uint32_t>(payload_size),
+                             block.data());
+            ret = chunk_callback(block.data(), kDeflateBlockHeaderSize + payload_size);
         }
-        absl::Status ret = this->Send(reinterpret_cast<uint8_t*>(buffer.data()), current_read);
         if (!ret.ok())
         {
-            return Dive::StatusWithContext(
-                ret, absl::StrCat("SendFile: Failed to send chunk for file '", file_path, "'"));
+            return ret;
         }
-        total_sent += static_cast<std::streamsize>(current_read);
+        total_read += to_read;
     }
-    file_stream.close();
     return Dive::OkStatus();
 }
 
+absl::StatusOr<size_t> SocketConnection::WriteFileChunk(const uint8_t* chunk, size_t size,
+                                                        std::ostream& file_stream)
+{
+    const uint8_t* raw = chunk;
+    size_t raw_size = size;
+    std::vector<uint8_t> inflated;
+    if (m_file_compression == FileCompression::kDeflate)
+    {
+        size_t payload_size = 0;
+        if (size >= kDeflateBlockHeaderSize)
+        {
+            ReadBlockHeader(chunk, &raw_size, &payload_size);
+        }
+        if (size < kDeflateBlockHeaderSize || raw_size == 0 || raw_size > kMaxDeflateBlockSize ||
+            payload_size > raw_size || payload_size != size - kDeflateBlockHeaderSize)
+        {
+            return Dive::DataLossError(
+                absl::StrCat("ReceiveFile: Invalid chunk of ", size, " bytes"));
+        }
+        raw = InflateBlock(chunk + kDeflateBlockHeaderSize, payload_size, raw_size, inflated);
+        if (raw == nullptr)
+        {
+            return Dive::DataLossError("ReceiveFile: Failed to inflate chunk");
+        }
+    }
+    if (!file_stream.write(reinterpret_cast<const char*>(raw),
+                           static_cast<std::streamsize>(raw_size)))
+    {
+        return Dive::InternalError("ReceiveFile: Failed to write chunk to file");
+    }
+    return raw_size;
+}
+
 absl::Status SocketConnection::ReceiveFile(const std::string& file_path, size_t file_size,
                                            std::function<void(size_t)> progress_callback)
 {
@@ -482,16 +905,50 @@ absl::Status SocketConnection::ReceiveFile(const std::string& file_path, size_t
         return Dive::PermissionDeniedError(
             absl::StrCat("ReceiveFile: Failed to open file '", file_path, "' for writing."));
     }
-    const size_t CHUNK_SIZE = 4096;
-    std::vector<uint8_t> buffer(CHUNK_SIZE);
+    absl::Status status = ReceiveToStream(file_stream, file_path, file_size, progress_callback);
+    file_stream.close();
+    return status;
+}
+
+absl::Status SocketConnection::ReceiveFileRange(const std::string& file_path, uint64_t offset,
+                                                uint64_t length,
+                                                std::function<void(size_t)> progress_callback)
+{
+    std::fstream file_stream(file_path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file_stream)
+    {
+        return Dive::PermissionDeniedError(
+            absl::StrCat("ReceiveFile: Failed to open file '", file_path, "' for writing."));
+    }
+    if (!file_stream.seekp(static_cast<std::streamoff>(offset)))
+    {
+        return Dive::InternalError(
+            absl::StrCat("ReceiveFile: Failed to seek to ", offset, " in file '", file_path, "'"));
+    }
+    absl::Status status =
+        ReceiveToStream(file_stream, file_path, static_cast<size_t>(length), progress_callback);
+    file_stream.close();
+    return status;
+}
+
+absl::Status SocketConnection::ReceiveToStream(std::ostream& file_stream,
+                                               const std::string& file_path, size_t size,
+                                               const std::function<void(size_t)>& progress_callback)
+{
+    if (m_file_compression == FileCompression::kDeflate)
+    {
+        return ReceiveDeflatedToStream(file_stream, file_path, size, progress_callback);
+    }
+    const size_t chunk_size = std::min(m_file_chunk_size, size);
+    std::vector<uint8_t> buffer(chunk_size);
     size_t total_received = 0;
-    while (total_received < file_size)
+    auto last_progress_time = std::chrono::steady_clock::now();
+    while (total_received < size)
     {
-        size_t to_receive = std::min(CHUNK_SIZE, file_size - total_received);
+        size_t to_receive = std::min(chunk_size, size - total_received);
         auto ret = this->Recv(buffer.data(), to_receive);
         if (!ret.ok())
         {
-            file_stream.close();
             return Dive::StatusWithContext(
                 ret.status(),
                 absl::StrCat("ReceiveFile: Failed to receive chunk for '", file_path, "'"));
@@ -499,20 +956,99 @@ absl::Status SocketConnection::ReceiveFile(const std::string& file_path, size_t
         size_t current_received = ret.value();
         if (!file_stream.write(reinterpret_cast<char*>(buffer.data()), current_received))
         {
-            file_stream.close();
             return Dive::InternalError(
                 absl::StrCat("ReceiveFile: Failed to write to file '", file_path, "'"));
         }
         total_received += current_received;
         if (progress_callback)
         {
-            progress_callback(total_received);
+            auto now = std::chrono::steady_clock::now();
+            if ((total_received == size) ||
+                (now - last_progress_time >= std::chrono::milliseconds(kFileProgressIntervalMs)))
+            {
+                progress_callback(total_received);
+                last_progress_time = now;
+            }
+        }
+    }
+    return Dive::OkStatus();
+}
+
+absl::Status SocketConnection::ReceiveDeflatedToStream(
+    std::ostream& file_stream, const std::string& file_path, size_t size,
+    const std::function<void(size_t)>& progress_callback)
+{
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> chunk;
+    size_t total_received = 0;
+    auto last_progress_time = std::chrono::steady_clock::now();
+    while (total_received < size)
+    {
+        uint8_t header[kDeflateBlockHeaderSize];
+        auto ret = this->Recv(header, kDeflateBlockHeaderSize);
+        if (!ret.ok())
+        {
+            return Dive::StatusWithContext(
+                ret.status(),
+                absl::StrCat("ReceiveFile: Failed to receive chunk for '", file_path, "'"));
+        }
+        size_t raw_size, payload_size;
+        ReadBlockHeader(header, &raw_size, &payload_size);
+        if (raw_size == 0 || raw_size > kMaxDeflateBlockSize ||
+            raw_size > size - total_received || payload_size > raw_size)
+        {
+            Close();
+            return Dive::DataLossError(absl::StrCat("ReceiveFile: Invalid chunk of ", raw_size,
+                                                    " bytes for '", file_path, "'"));
+        }
+
+        payload.resize(payload_size);
+        ret = this->Recv(payload.data(), payload_size);
+        if (!ret.ok())
+        {
+            return Dive::StatusWithContext(
+                ret.status(),
+                absl::StrCat("ReceiveFile: Failed to receive chunk for '", file_path, "'"));
+        }
+        const uint8_t* raw = InflateBlock(payload.data(), payload_size, raw_size, chunk);
+        if (raw == nullptr)
+        {
+            Close();
+            return Dive::DataLossError(
+                absl::StrCat("ReceiveFile: Failed to inflate chunk for '", file_path, "'"));
+        }
+        if (!file_stream.write(reinterpret_cast<const char*>(raw), raw_size))
+        {
+            return Dive::InternalError(
+                absl::StrCat("ReceiveFile: Failed to write to file '", file_path, "'"));
+        }
+        total_received += raw_size;
+        if (progress_callback)
+        {
+            auto now = std::chrono::steady_clock::now();
+            if ((total_received == size) ||
+                (now - last_progress_time >= std::chrono::milliseconds(kFileProgressIntervalMs)))
+            {
+                progress_callback(total_received);
+                last_progress_time = now;
+            }
         }
     }
-    file_stream.close();
     return Dive::OkStatus();
 }
 
+void SocketConnection::Shutdown()
+{
+    if (m_socket != kInvalidSocketValue)
+    {
+#ifdef WIN32
+        ::shutdown(static_cast<SOCKET>(m_socket), SD_BOTH);
+#else
+        ::shutdown(m_socket, SHUT_RDWR);
+#endif
+    }
+}
+
 void SocketConnection::Close()
 {
     if (m_socket != kInvalidSocketValue)
@@ -16,18 +16,42 @@ limitations under the License.
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <ostream>
 #include <system_error>
+#include <vector>
 
 #include "absl/status/statusor.h"
 #include "platform_net.h"
 
 constexpr int kNoTimeout = -1;
 constexpr int kAcceptTimeout = 2000;
+// Size of the chunks files are transferred in by default. Captures can be several GB, so this
+// keeps the transfer from being bound by the number of syscalls
+constexpr size_t kDefaultFileChunkSize = 1 << 20;
+// Minimum time between 2 calls to the progress callback of ReceiveFile
+constexpr int kFileProgressIntervalMs = 100;
 
 namespace Network
 {
 
+// Compression of the file content sent by SendFile and SendFileRange. Both ends of a connection
+// must use the same setting, which the client negotiates during the handshake.
+enum class FileCompression : uint32_t
+{
+    kNone = 0,
+    // Each chunk of the file is deflated on its own, so memory stays bounded by the chunk size.
+    kDeflate = 1
+};
+
+// Receives the successive chunks of a file, encoded with the FileCompression of the connection.
+using FileChunkCallback = std::function<absl::Status(const uint8_t* chunk, size_t size)>;
+// Returns the header that precedes a chunk of chunk_size bytes of a file.
+using FrameHeaderCallback = std::function<std::vector<uint8_t>(size_t chunk_size)>;
+
 class NetworkInitializer
 {
  public:
@@ -61,23 +85,76 @@ class SocketConnection
     absl::Status Connect(const std::string& host, int port);
 
     // Data transfer methods.
+    // Concurrent calls to Send do not interleave their data.
     absl::Status Send(const uint8_t* data, size_t size);
     absl::StatusOr<size_t> Recv(uint8_t* data, size_t size, int timeout_ms = kNoTimeout);
+    // Receives what is available, without waiting. Returns 0 when nothing is.
+    absl::StatusOr<size_t> RecvAvailable(uint8_t* data, size_t size);
     absl::Status SendString(const std::string& s);
     absl::StatusOr<std::string> ReceiveString();
+    // On Linux, the file is sent with sendfile() so that it is not copied through user space
     absl::Status SendFile(const std::string& file_path);
+    // Sends the [offset, offset + length) range of the file.
+    absl::Status SendFileRange(const std::string& file_path, uint64_t offset, uint64_t length);
+    // The progress callback is called at most every kFileProgressIntervalMs, and once the whole
+    // file is received
     absl::Status ReceiveFile(const std::string& file_path, size_t file_size,
                              std::function<void(size_t)> progress_callback = nullptr);
-
+    // Writes the received range at offset in an existing file, leaving the rest of the file as is,
+    // so that the ranges of a file can be received concurrently on different connections.
+    absl::Status ReceiveFileRange(const std::string& file_path, uint64_t offset, uint64_t length,
+                                  std::function<void(size_t)> progress_callback = nullptr);
+    // Sends the range of the file in chunks of at most max_chunk_size bytes, encoded as
+    // SendFileRange would send them, each preceded by the header frame_header returns for its
+    // size. The data of concurrent Send calls goes between two frames, never within one.
+    absl::Status SendFileRangeFrames(const std::string& file_path, uint64_t offset,
+                                     uint64_t length, size_t max_chunk_size,
+                                     const FrameHeaderCallback& frame_header);
+    // Writes a chunk sent by SendFileRangeFrames on the other end of the connection to the
+    // stream. Returns the number of bytes of the file it holds.
+    absl::StatusOr<size_t> WriteFileChunk(const uint8_t* chunk, size_t size,
+                                          std::ostream& file_stream);
+    void SetFileChunkSize(size_t chunk_size);
+    void SetFileCompression(FileCompression compression);
+    FileCompression GetFileCompression() const;
+    // Set once the client negotiated kCapabilityMultiplexing.
+    void SetMultiplexed(bool multiplexed);
+    bool IsMultiplexed() const;
+
+    // Makes the pending and future transfers on the connection fail, without closing it, so that
+    // the threads blocked on the connection return.
+    void Shutdown();
     void Close();
     bool IsOpen() const;
+    // For waiting on the socket along with others, e.g. with poll().
+    SocketType GetSocket() const { return m_socket; }
 
  private:
     explicit SocketConnection(SocketType initial_socket_value);
 
+    // Sends with Send, the caller holding m_send_mutex.
+    absl::Status SendLocked(const uint8_t* data, size_t size);
+    // If sendfile() is not supported for the file, it is read and sent through a buffer instead.
+    absl::Status SendFileZeroCopy(const std::string& file_path, uint64_t offset, uint64_t length,
+                                  size_t max_chunk_size, const FrameHeaderCallback& frame_header);
+    // Reads the range of the file in chunks of at most max_chunk_size bytes, and passes them,
+    // encoded as SendFileRange would send them, to chunk_callback.
+    absl::Status ReadFileRangeChunks(const std::string& file_path, uint64_t offset,
+                                     uint64_t length, size_t max_chunk_size,
+                                     const FileChunkCallback& chunk_callback);
+    absl::Status ReceiveToStream(std::ostream& file_stream, const std::string& file_path,
+                                 size_t size, const std::function<void(size_t)>& progress_callback);
+    absl::Status ReceiveDeflatedToStream(std::ostream& file_stream, const std::string& file_path,
+                                         size_t size,
+                                         const std::function<void(size_t)>& progress_callback);
+
     SocketType m_socket;
     bool m_is_listening;
     int m_accept_timout_ms;
+    size_t m_file_chunk_size;
+    FileCompression m_file_compression;
+    std::atomic<bool> m_multiplexed;
+    std::mutex m_send_mutex;
 };
 
 }  // namespace Network
\ No newline at end of file
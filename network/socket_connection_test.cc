@@ -0,0 +1,136 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "socket_connection.h"
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/status/status_matchers.h"
+
+namespace
+{
+
+using ::absl_testing::IsOk;
+
+class SocketConnectionFileTest : public ::testing::Test
+{
+ protected:
+    void SetUp() override
+    {
+        int fds[2];
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+        auto sender = Network::SocketConnection::Create(fds[0]);
+        auto receiver = Network::SocketConnection::Create(fds[1]);
+        ASSERT_THAT(sender, IsOk());
+        ASSERT_THAT(receiver, IsOk());
+        m_sender = *std::move(sender);
+        m_receiver = *std::move(receiver);
+
+        m_dir = std::filesystem::temp_directory_path() /
+                ("socket_connection_test_" + std::to_string(getpid()));
+        std::filesystem::create_directories(m_dir);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(m_dir); }
+
+    std::vector<char> WriteSourceFile(size_t size, bool compressible = false)
+    {
+        std::vector<char> content(size);
+        uint32_t random = 12345;
+        for (size_t i = 0; i < size; ++i)
+        {
+            random = random * 1103515245 + 12345;
+            content[i] = compressible ? static_cast<char>((i / 64) % 7)
+                                      : static_cast<char>(random >> 24);
+        }
+        std::ofstream out(m_dir / "source.bin", std::ios::binary);
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return content;
+    }
+
+    std::vector<char> ReadReceivedFile()
+    {
+        std::ifstream in(m_dir / "received.bin", std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in),
+                                 std::istreambuf_iterator<char>());
+    }
+
+    void TransferFile(size_t size, std::vector<size_t>* progress = nullptr,
+                      bool compressible = false)
+    {
+        std::vector<char> content = WriteSourceFile(size, compressible);
+        absl::Status send_status;
+        std::thread sender_thread(
+            [&]() { send_status = m_sender->SendFile((m_dir / "source.bin").string()); });
+        absl::Status receive_status =
+            m_receiver->ReceiveFile((m_dir / "received.bin").string(), size,
+                                    [progress](size_t received) {
+                                        if (progress)
+                                        {
+                                            progress->push_back(received);
+                                        }
+                                    });
+        sender_thread.join();
+        ASSERT_THAT(send_status, IsOk());
+        ASSERT_THAT(receive_status, IsOk());
+        EXPECT_EQ(ReadReceivedFile(), content);
+    }
+
+    std::unique_ptr<Network::SocketConnection> m_sender;
+    std::unique_ptr<Network::SocketConnection> m_receiver;
+    std::filesystem::path m_dir;
+};
+
+TEST_F(SocketConnectionFileTest, TransfersFileLargerThanChunk)
+{
+    m_sender->SetFileChunkSize(4096);
+    m_receiver->SetFileChunkSize(1000);
+    std::vector<size_t> progress;
+    TransferFile(3 * kDefaultFileChunkSize + 123, &progress);
+    ASSERT_FALSE(progress.empty());
+    EXPECT_EQ(progress.back(), 3 * kDefaultFileChunkSize + 123);
+}
+
+TEST_F(SocketConnectionFileTest, TransfersEmptyFile) { TransferFile(0); }
+
+TEST_F(SocketConnectionFileTest, TransfersDeflatedFile)
+{
+    m_sender->SetFileCompression(Network::FileCompression::kDeflate);
+    m_receiver->SetFileCompression(Network::FileCompression::kDeflate);
+    m_sender->SetFileChunkSize(100000);
+    std::vector<size_t> progress;
+    TransferFile(2 * kDefaultFileChunkSize + 77, &progress, /*compressible=*/true);
+    ASSERT_FALSE(progress.empty());
+    EXPECT_EQ(progress.back(), 2 * kDefaultFileChunkSize + 77);
+
+    // Chunks that do not compress are sent as is.
+    TransferFile(kDefaultFileChunkSize + 5, nullptr, /*compressible=*/false);
+}
+
+TEST_F(SocketConnectionFileTest, SendFileFailsForMissingFile)
+{
+    EXPECT_FALSE(m_sender->SendFile((m_dir / "missing.bin").string()).ok());
+}
+
+}  // namespace
@@ -15,22 +15,231 @@ limitations under the License.
 */
 #include "tcp_client.h"
 
+#include <algorithm>
 #include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "dive/common/status.h"
+#include "file_transfer.h"
 
 namespace
 {
 constexpr uint32_t kKeepAliveIntervalSec = 2;
 constexpr uint32_t kPingTimeoutMs = 5000;
-constexpr uint32_t kHandshakeMajorVersion = 1;
+constexpr uint32_t kHandshakeMajorVersion = 2;
 constexpr uint32_t kHandshakeMinorVersion = 0;
 }  // namespace
 
 namespace Network
 {
 
+namespace
+{
+
+// State shared by the connections of a parallel download.
+struct ParallelDownloadState
+{
+    std::string remote_file_path;
+    std::string local_save_path;
+    uint64_t file_size = 0;
+    // Size of the local file before the download. Ranges within it are verified before being
+    // downloaded again.
+    uint64_t resume_size = 0;
+    uint64_t range_size = 0;
+    uint64_t range_count = 0;
+    // Handshake capabilities requested on each connection.
+    uint32_t capabilities = 0;
+    std::atomic<uint64_t> next_range = 0;
+    std::atomic<uint64_t> downloaded_size = 0;
+    std::atomic<bool> failed = false;
+
+    std::mutex progress_mutex;
+    uint64_t reported_size = 0;
+    std::function<void(size_t)> progress_callback;
+};
+
+void AddDownloadProgress(ParallelDownloadState& state, uint64_t size)
+{
+    uint64_t downloaded_size = state.downloaded_size.fetch_add(size) + size;
+    if (state.progress_callback)
+    {
+        std::lock_guard<std::mutex> lock(state.progress_mutex);
+        if (downloaded_size > state.reported_size)
+        {
+            state.reported_size = downloaded_size;
+            state.progress_callback(static_cast<size_t>(downloaded_size));
+        }
+    }
+}
+
+// Checks that the message is of type ResponseType.
+template<typename ResponseType>
+absl::StatusOr<std::unique_ptr<ResponseType>> CastResponse(std::unique_ptr<ISerializable> message,
+                                                           MessageType response_type,
+                                                           const char* context)
+{
+    if (message->GetMessageType() != response_type)
+    {
+        return Dive::FailedPreconditionError(
+            absl::StrCat(context, ": Unexpected message type in response (Expected: ",
+                         response_type, ", Got: ", message->GetMessageType(), ")."));
+    }
+    auto* response = dynamic_cast<ResponseType*>(message.get());
+    if (!response)
+    {
+        return Dive::InternalError(
+            absl::StrCat(context, ": Failed to cast received message to its response type."));
+    }
+    message.release();
+    return std::unique_ptr<ResponseType>(response);
+}
+
+// Sends the request and receives its response, which must be of type ResponseType.
+template<typename ResponseType>
+absl::StatusOr<std::unique_ptr<ResponseType>> SendRequest(SocketConnection* conn,
+                                                          const ISerializable& request,
+                                                          MessageType response_type,
+                                                          const char* context)
+{
+    auto send_status = SendSocketMessage(conn, request);
+    if (!send_status.ok())
+    {
+        return Dive::StatusWithContext(send_status,
+                                       absl::StrCat(context, ": SendSocketMessage fail"));
+    }
+
+    auto receive = ReceiveSocketMessage(conn);
+    if (!receive.ok())
+    {
+        return Dive::StatusWithContext(receive.status(),
+                                       absl::StrCat(context, ": ReceiveSocketMessage fail"));
+    }
+    return CastResponse<ResponseType>(*std::move(receive), response_type, context);
+}
+
+// Downloads ranges of the file on a new connection, until all ranges are taken or another
+// connection failed.
+absl::Status DownloadFileRanges(const std::string& host, int port, ParallelDownloadState& state)
+{
+    auto connection = SocketConnection::Create();
+    if (!connection.ok())
+    {
+        return Dive::StatusWithContext(connection.status(), "DownloadFileRanges");
+    }
+    std::unique_ptr<SocketConnection> conn = *std::move(connection);
+    // Range connections only carry range and checksum requests, so they skip the keep-alive of
+    // the main connection.
+    auto conn_status = conn->Connect(host, port);
+    if (!conn_status.ok())
+    {
+        return Dive::StatusWithContext(conn_status, "DownloadFileRanges: Connect fail");
+    }
+
+    HandshakeRequest hs_request;
+    hs_request.SetMajorVersion(kHandshakeMajorVersion);
+    hs_request.SetMinorVersion(kHandshakeMinorVersion);
+    hs_request.SetCapabilities(state.capabilities);
+    auto hs_response = SendRequest<HandshakeResponse>(conn.get(), hs_request,
+                                                      MessageType::HANDSHAKE_RESPONSE,
+                                                      "DownloadFileRanges");
+    if (!hs_response.ok())
+    {
+        return hs_response.status();
+    }
+    conn->SetFileCompression(GetFileCompressionForCapabilities(
+        (*hs_response)->GetCapabilities() & state.capabilities));
+
+    uint64_t range = 0;
+    while (!state.failed.load() && (range = state.next_range.fetch_add(1)) < state.range_count)
+    {
+        const uint64_t offset = range * state.range_size;
+        const uint64_t length = std::min(state.range_size, state.file_size - offset);
+
+        FileChecksumRequest checksum_request;
+        checksum_request.SetFilePath(state.remote_file_path);
+        checksum_request.SetOffset(offset);
+        checksum_request.SetLength(length);
+        auto checksum_response =
+            SendRequest<FileChecksumResponse>(conn.get(), checksum_request,
+                                              MessageType::FILE_CHECKSUM_RESPONSE,
+                                              "DownloadFileRanges");
+        if (!checksum_response.ok())
+        {
+            return checksum_response.status();
+        }
+        if (!(*checksum_response)->GetFound())
+        {
+            return Dive::NotFoundError(
+                absl::StrCat("DownloadFileRanges: Server could not checksum range. Reason: ",
+                             (*checksum_response)->GetErrorReason()));
+        }
+        const uint32_t server_checksum = (*checksum_response)->GetChecksum();
+
+        if (offset + length <= state.resume_size)
+        {
+            auto local_checksum = ComputeFileCrc32(state.local_save_path, offset, length);
+            if (local_checksum.ok() && (*local_checksum == server_checksum))
+            {
+                AddDownloadProgress(state, length);
+                continue;
+            }
+        }
+
+        DownloadFileRangeRequest range_request;
+        range_request.SetFilePath(state.remote_file_path);
+        range_request.SetOffset(offset);
+        range_request.SetLength(length);
+        auto range_response =
+            SendRequest<DownloadFileRangeResponse>(conn.get(), range_request,
+                                                   MessageType::DOWNLOAD_FILE_RANGE_RESPONSE,
+                                                   "DownloadFileRanges");
+        if (!range_response.ok())
+        {
+            return range_response.status();
+        }
+        if (!(*range_response)->GetFound())
+        {
+            return Dive::NotFoundError(
+                absl::StrCat("DownloadFileRanges: Server could not provide range. Reason: ",
+                             (*range_response)->GetErrorReason()));
+        }
+        if ((*range_response)->GetOffset() != offset || (*range_response)->GetLength() != length)
+        {
+            return Dive::InternalError("DownloadFileRanges: Server sent a different range.");
+        }
+
+        uint64_t range_received = 0;
+        auto recv_status =
+            conn->ReceiveFileRange(state.local_save_path, offset, length, [&](size_t received) {
+                AddDownloadProgress(state, received - range_received);
+                range_received = received;
+            });
+        if (!recv_status.ok())
+        {
+            return Dive::StatusWithContext(recv_status,
+                                           "DownloadFileRanges: ReceiveFileRange fail");
+        }
+
+        auto local_checksum = ComputeFileCrc32(state.local_save_path, offset, length);
+        if (!local_checksum.ok())
+        {
+            return local_checksum.status();
+        }
+        if (*local_checksum != server_checksum)
+        {
+            return Dive::DataLossError(absl::StrCat("DownloadFileRanges: Checksum mismatch for "
+                                                    "range [",
+                                                    offset, ", ", offset + length, ")."));
+        }
+    }
+    return Dive::OkStatus();
+}
+
+}  // namespace
+
 TcpClient::TcpClient() : m_status(ClientStatus::DISCONNECTED)
 {
     m_keep_alive.running = false;
@@ -49,7 +258,7 @@ absl::Status TcpClient::Connect(const std::string& host, int port)
     }
 
     StopKeepAlive();
-    m_connection.reset();
+    CloseConnection();
 
     SetClientStatus(ClientStatus::CONNECTING);
     auto connection = SocketConnection::Create();
@@ -68,12 +277,14 @@ absl::Status TcpClient::Connect(const std::string& host, int port)
             Dive::StatusWithContext(conn_status, "Connect: Connect fail"));
     }
     SetClientStatus(ClientStatus::CONNECTED);
+    m_host = host;
+    m_port = port;
 
     std::cout << "Client: Connected & handshaking." << std::endl;
     auto handshake_status = PerformHandshake();
     if (!handshake_status.ok())
     {
-        m_connection.reset();
+        CloseConnection();
         return SetStatusAndReturnError(
             ClientStatus::CONNECTION_FAILED,
             Dive::StatusWithContext(handshake_status, "Connect: Handshake failed"));
@@ -89,7 +300,7 @@ absl::Status TcpClient::Connect(const std::string& host, int port)
         }
         else
         {
-            m_connection.reset();
+            CloseConnection();
             return SetStatusAndReturnError(
                 ClientStatus::CONNECTION_FAILED,
                 Dive::StatusWithContext(keep_alive_status, "Connect: KeepAlive fail"));
@@ -102,7 +313,7 @@ absl::Status TcpClient::Connect(const std::string& host, int port)
 void TcpClient::Disconnect()
 {
     StopKeepAlive();
-    m_connection.reset();
+    CloseConnection();
     SetClientStatus(ClientStatus::DISCONNECTED);
     std::cout << "Client: Disconnected." << std::endl;
 }
@@ -112,60 +323,111 @@ bool TcpClient::IsConnected() const
     return GetClientStatus() == ClientStatus::CONNECTED && m_connection && m_connection->IsOpen();
 }
 
-absl::StatusOr<std::string> TcpClient::StartPm4Capture()
+absl::StatusOr<uint32_t> TcpClient::SendRequest(ISerializable& request, const char* context)
 {
-    std::lock_guard<std::mutex> lock(m_connection_mutex);
-    if (!IsConnected())
+    absl::Status send_status;
+    uint32_t request_id = 0;
+    if (m_multiplexed)
     {
-        return Dive::FailedPreconditionError("StartPm4Capture: Client is not connected.");
+        auto sent = m_multiplexed->SendRequest(request);
+        send_status = sent.status();
+        request_id = sent.value_or(0);
+    }
+    else
+    {
+        send_status = SendSocketMessage(m_connection.get(), request);
     }
-
-    Pm4CaptureRequest pm4_request;
-    std::cout << "Client: StartPm4Capture request." << std::endl;
-    auto send_status = SendSocketMessage(m_connection.get(), pm4_request);
     if (!send_status.ok())
     {
-        return SetStatusAndReturnError(ClientStatus::CONNECTION_FAILED,
-                                       Dive::StatusWithContext(send_status,
-                                                               "StartPm4Capture: SendSocketMessage "
-                                                               "fail"));
+        return SetStatusAndReturnError(
+            ClientStatus::CONNECTION_FAILED,
+            Dive::StatusWithContext(send_status,
+                                    absl::StrCat(context, ": SendSocketMessage fail")));
     }
+    return request_id;
+}
 
-    auto receive = ReceiveSocketMessage(m_connection.get());
+absl::StatusOr<std::unique_ptr<ISerializable>> TcpClient::ReceiveMessage(uint32_t request_id,
+                                                                         const char* context,
+                                                                         int timeout_ms)
+{
+    auto receive = m_multiplexed ? m_multiplexed->ReceiveMessage(request_id, timeout_ms)
+                                 : ReceiveSocketMessage(m_connection.get(), timeout_ms);
     if (!receive.ok())
     {
-        return SetStatusAndReturnError(ClientStatus::CONNECTION_FAILED,
-                                       Dive::StatusWithContext(receive.status(),
-                                                               "StartPm4Capture: "
-                                                               "ReceiveSocketMessage fail"));
+        return SetStatusAndReturnError(
+            ClientStatus::CONNECTION_FAILED,
+            Dive::StatusWithContext(receive.status(),
+                                    absl::StrCat(context, ": ReceiveSocketMessage fail")));
     }
+    return receive;
+}
 
-    auto response = *std::move(receive);
-    if (response->GetMessageType() != MessageType::PM4_CAPTURE_RESPONSE)
+void TcpClient::EndRequest(uint32_t request_id)
+{
+    if (m_multiplexed)
     {
-        return Dive::FailedPreconditionError(absl::StrCat(
-            "StartPm4Capture: Unexpected message type in Capture response "
-            "(Expected: ",
-            MessageType::PM4_CAPTURE_RESPONSE, ", Got: ", response->GetMessageType(), ")."));
+        m_multiplexed->EndRequest(request_id);
     }
+}
 
-    auto* pm4_response = dynamic_cast<Pm4CaptureResponse*>(response.get());
-    if (!pm4_response)
+template<typename ResponseType>
+absl::StatusOr<std::unique_ptr<ResponseType>> TcpClient::Request(ISerializable& request,
+                                                                 MessageType response_type,
+                                                                 const char* context,
+                                                                 int timeout_ms)
+{
+    std::unique_lock<std::mutex> lock(m_connection_mutex, std::defer_lock);
+    if (!m_multiplexed)
     {
-        return Dive::InternalError(
-            "StartPm4Capture: Failed to cast received message to Pm4CaptureResponse.");
+        lock.lock();
+    }
+    if (!IsConnected())
+    {
+        return Dive::FailedPreconditionError(absl::StrCat(context, ": Client is not connected."));
+    }
+
+    auto request_id = SendRequest(request, context);
+    if (!request_id.ok())
+    {
+        return request_id.status();
+    }
+    auto receive = ReceiveMessage(*request_id, context, timeout_ms);
+    EndRequest(*request_id);
+    if (!receive.ok())
+    {
+        return receive.status();
+    }
+    return CastResponse<ResponseType>(*std::move(receive), response_type, context);
+}
+
+absl::StatusOr<std::string> TcpClient::StartPm4Capture()
+{
+    Pm4CaptureRequest pm4_request;
+    std::cout << "Client: StartPm4Capture request." << std::endl;
+    auto pm4_response = Request<Pm4CaptureResponse>(pm4_request, MessageType::PM4_CAPTURE_RESPONSE,
+                                                    "StartPm4Capture");
+    if (!pm4_response.ok())
+    {
+        return pm4_response.status();
     }
 
     std::cout << "Client: StartPm4Capture response OK (remote_file_path: "
-              << pm4_response->GetString() << ")." << std::endl;
-    return pm4_response->GetString();
+              << (*pm4_response)->GetString() << ")." << std::endl;
+    return (*pm4_response)->GetString();
 }
 
 absl::Status TcpClient::DownloadFileFromServer(const std::string& remote_file_path,
                                                const std::string& local_save_path,
                                                std::function<void(size_t)> progress_callback)
 {
-    std::lock_guard<std::mutex> lock(m_connection_mutex);
+    // On a multiplexed connection, the file comes as messages of the request, so the keep-alive
+    // and the other requests go on during the download.
+    std::unique_lock<std::mutex> lock(m_connection_mutex, std::defer_lock);
+    if (!m_multiplexed)
+    {
+        lock.lock();
+    }
     if (!IsConnected())
     {
         return Dive::FailedPreconditionError("DownloadFileFromServer: Client is not connected.");
@@ -176,62 +438,48 @@ absl::Status TcpClient::DownloadFileFromServer(const std::string& remote_file_pa
 
     std::cout << "Client: Requesting to download file from server '" << remote_file_path << "' to '"
               << local_save_path << "'." << std::endl;
-    auto send_status = SendSocketMessage(m_connection.get(), download_request);
-    if (!send_status.ok())
+    auto request_id = SendRequest(download_request, "DownloadFileFromServer");
+    if (!request_id.ok())
     {
-        return SetStatusAndReturnError(ClientStatus::CONNECTION_FAILED,
-                                       Dive::StatusWithContext(send_status,
-                                                               "DownloadFileFromServer: "
-                                                               "SendSocketMessage fail"));
+        return request_id.status();
     }
 
-    auto receive = ReceiveSocketMessage(m_connection.get());
+    auto receive = ReceiveMessage(*request_id, "DownloadFileFromServer");
     if (!receive.ok())
     {
-        return SetStatusAndReturnError(ClientStatus::CONNECTION_FAILED,
-                                       Dive::StatusWithContext(receive.status(),
-                                                               "DownloadFileFromServer: "
-                                                               "ReceiveSocketMessage fail"));
-    }
-
-    auto response = *std::move(receive);
-    if (response->GetMessageType() != MessageType::DOWNLOAD_FILE_RESPONSE)
-    {
-        return Dive::FailedPreconditionError(absl::StrCat(
-            "DownloadFileFromServer: Unexpected message type in Download response "
-            "(Expected: ",
-            MessageType::DOWNLOAD_FILE_RESPONSE, ", Got: ", response->GetMessageType(), ")."));
+        EndRequest(*request_id);
+        return receive.status();
     }
-
-    auto* download_response = dynamic_cast<DownloadFileResponse*>(response.get());
-    if (!download_response)
+    auto download_response = CastResponse<DownloadFileResponse>(
+        *std::move(receive), MessageType::DOWNLOAD_FILE_RESPONSE, "DownloadFileFromServer");
+    if (!download_response.ok())
     {
-        return Dive::InternalError(
-            "DownloadFileFromServer: Failed to cast received message to DownloadFileResponse.");
+        EndRequest(*request_id);
+        return download_response.status();
     }
 
-    if (!download_response->GetFound())
+    if (!(*download_response)->GetFound())
     {
+        EndRequest(*request_id);
         return Dive::NotFoundError(
             absl::StrCat("DownloadFileFromServer: Server could not provide file. Reason: ",
-                         download_response->GetErrorReason()));
+                         (*download_response)->GetErrorReason()));
     }
 
-    std::cout << "Client: Server offering file (size = " << download_response->GetFileSizeStr()
+    std::cout << "Client: Server offering file (size = " << (*download_response)->GetFileSize()
               << " bytes). Starting download." << std::endl;
-    size_t file_size = 0;
-    try
+    size_t file_size = static_cast<size_t>((*download_response)->GetFileSize());
+
+    absl::Status recv_status;
+    if (m_multiplexed)
     {
-        file_size = std::stoull(download_response->GetFileSizeStr());
+        recv_status = ReceiveFileData(*request_id, local_save_path, file_size, progress_callback);
     }
-    catch (const std::exception& e)
+    else
     {
-        return Dive::InvalidArgumentError(
-            absl::StrCat("DownloadFileFromServer: Invalid file size from server: '",
-                         download_response->GetFileSizeStr(), "'. Message error: ", e.what()));
+        recv_status = m_connection->ReceiveFile(local_save_path, file_size, progress_callback);
     }
-
-    auto recv_status = m_connection->ReceiveFile(local_save_path, file_size, progress_callback);
+    EndRequest(*request_id);
     if (!recv_status.ok())
     {
         return SetStatusAndReturnError(ClientStatus::CONNECTION_FAILED,
@@ -245,112 +493,170 @@ absl::Status TcpClient::DownloadFileFromServer(const std::string& remote_file_pa
     return Dive::OkStatus();
 }
 
-absl::StatusOr<size_t> TcpClient::GetCaptureFileSize(const std::string& remote_file_path)
+absl::Status TcpClient::ReceiveFileData(uint32_t request_id, const std::string& local_save_path,
+                                        size_t file_size,
+                                        const std::function<void(size_t)>& progress)
 {
-    std::lock_guard<std::mutex> lock(m_connection_mutex);
-    if (!IsConnected())
+    std::ofstream file_stream(local_save_path, std::ios::binary | std::ios::trunc);
+    if (!file_stream)
     {
-        return Dive::FailedPreconditionError("GetCaptureFileSize: Client is not connected.");
+        return Dive::PermissionDeniedError(
+            absl::StrCat("ReceiveFile: Failed to open file '", local_save_path, "' for writing."));
     }
-
-    FileSizeRequest file_size_request;
-    file_size_request.SetString(remote_file_path);
-    std::cout << "Client: Requesting file size of " << remote_file_path << std::endl;
-    auto send_status = SendSocketMessage(m_connection.get(), file_size_request);
-    if (!send_status.ok())
+    size_t total_received = 0;
+    auto last_progress_time = std::chrono::steady_clock::now();
+    while (total_received < file_size)
     {
-        return SetStatusAndReturnError(ClientStatus::CONNECTION_FAILED,
-                                       Dive::StatusWithContext(send_status,
-                                                               "GetCaptureFileSize: "
-                                                               "SendSocketMessage fail"));
+        auto receive = ReceiveMessage(request_id, "ReceiveFile");
+        if (!receive.ok())
+        {
+            return receive.status();
+        }
+        auto file_data =
+            CastResponse<FileDataMessage>(*std::move(receive), MessageType::FILE_DATA,
+                                          "ReceiveFile");
+        if (!file_data.ok())
+        {
+            return file_data.status();
+        }
+        const Buffer& chunk = (*file_data)->GetData();
+        auto written = m_connection->WriteFileChunk(chunk.data(), chunk.size(), file_stream);
+        if (!written.ok())
+        {
+            return Dive::StatusWithContext(written.status(),
+                                           absl::StrCat("ReceiveFile: '", local_save_path, "'"));
+        }
+        if (*written > file_size - total_received)
+        {
+            return Dive::DataLossError(
+                absl::StrCat("ReceiveFile: Received more than ", file_size, " bytes."));
+        }
+        total_received += *written;
+        if (progress)
+        {
+            auto now = std::chrono::steady_clock::now();
+            if ((total_received == file_size) ||
+                (now - last_progress_time >= std::chrono::milliseconds(kFileProgressIntervalMs)))
+            {
+                progress(total_received);
+                last_progress_time = now;
+            }
+        }
     }
+    return Dive::OkStatus();
+}
 
-    auto receive = ReceiveSocketMessage(m_connection.get());
-    if (!receive.ok())
+absl::Status TcpClient::DownloadFileFromServerParallel(
+    const std::string& remote_file_path, const std::string& local_save_path,
+    const ParallelDownloadOptions& options, std::function<void(size_t)> progress_callback)
+{
+    if (options.stream_count == 0 || options.range_size == 0)
     {
-        return SetStatusAndReturnError(ClientStatus::CONNECTION_FAILED,
-                                       Dive::StatusWithContext(receive.status(),
-                                                               "GetCaptureFileSize: "
-                                                               "ReceiveSocketMessage fail"));
+        return Dive::InvalidArgumentError(
+            "DownloadFileFromServerParallel: stream_count and range_size must not be 0.");
     }
-
-    auto response = *std::move(receive);
-    if (response->GetMessageType() != MessageType::FILE_SIZE_RESPONSE)
+    auto file_size = GetCaptureFileSize(remote_file_path);
+    if (!file_size.ok())
     {
-        return Dive::FailedPreconditionError(absl::StrCat(
-            "GetCaptureFileSize: Unexpected message type in response "
-            "(Expected: ",
-            MessageType::FILE_SIZE_RESPONSE, ", Got: ", response->GetMessageType(), ")."));
+        return Dive::StatusWithContext(file_size.status(), "DownloadFileFromServerParallel");
     }
 
-    auto* file_size_response = dynamic_cast<FileSizeResponse*>(response.get());
-    if (!file_size_response)
+    ParallelDownloadState state;
+    state.remote_file_path = remote_file_path;
+    state.local_save_path = local_save_path;
+    state.file_size = *file_size;
+    state.range_size = options.range_size;
+    state.range_count = (state.file_size + state.range_size - 1) / state.range_size;
+    state.capabilities = m_file_compression_enabled ? kCapabilityDeflateFiles : 0;
+    state.progress_callback = std::move(progress_callback);
+
+    std::error_code ec;
+    if (options.resume && std::filesystem::exists(local_save_path, ec))
     {
-        return Dive::InternalError(
-            "GetCaptureFileSize: Failed to cast received message to FileSizeResponse.");
+        state.resume_size = std::filesystem::file_size(local_save_path, ec);
+        if (ec)
+        {
+            state.resume_size = 0;
+        }
     }
-    if (!file_size_response->GetFound())
+    else if (!std::ofstream(local_save_path, std::ios::binary | std::ios::trunc))
     {
-        return Dive::NotFoundError(
-            absl::StrCat("GetCaptureFileSize: Server could not find file. Reason: ",
-                         file_size_response->GetErrorReason()));
+        return Dive::PermissionDeniedError(
+            absl::StrCat("DownloadFileFromServerParallel: Failed to create file '",
+                         local_save_path, "'"));
     }
-
-    size_t file_size = 0;
-    try
+    std::filesystem::resize_file(local_save_path, state.file_size, ec);
+    if (ec)
     {
-        file_size = std::stoull(file_size_response->GetFileSizeStr());
+        return Dive::InternalError(
+            absl::StrCat("DownloadFileFromServerParallel: Failed to resize file '",
+                         local_save_path, "': ", ec.message()));
     }
-    catch (const std::exception& e)
+
+    std::cout << "Client: Downloading file from server '" << remote_file_path << "' (size = "
+              << state.file_size << " bytes) to '" << local_save_path << "' in "
+              << state.range_count << " ranges." << std::endl;
+
+    const uint64_t stream_count = std::min<uint64_t>(options.stream_count, state.range_count);
+    std::vector<absl::Status> stream_status(stream_count);
+    std::vector<std::thread> streams;
+    for (uint64_t i = 0; i < stream_count; ++i)
     {
-        return Dive::InvalidArgumentError(
-            absl::StrCat("GetCaptureFileSize: Invalid file size from server: '",
-                         file_size_response->GetFileSizeStr(), "'. Message error: ", e.what()));
+        streams.emplace_back([this, &state, &stream_status, i]() {
+            stream_status[i] = DownloadFileRanges(m_host, m_port, state);
+            if (!stream_status[i].ok())
+            {
+                state.failed.store(true);
+            }
+        });
     }
-    return file_size;
-}
-
-absl::Status TcpClient::PingServer()
-{
-    std::lock_guard<std::mutex> lock(m_connection_mutex);
-    if (!IsConnected())
+    for (auto& stream : streams)
     {
-        return Dive::FailedPreconditionError(absl::StrCat("PingServer: Client is not connected."));
+        stream.join();
     }
-
-    PingMessage ping_request;
-    std::cout << "Client: Send PING." << std::endl;
-    auto send_status = SendSocketMessage(m_connection.get(), ping_request);
-    if (!send_status.ok())
+    for (const auto& status : stream_status)
     {
-        return SetStatusAndReturnError(ClientStatus::CONNECTION_FAILED,
-                                       Dive::StatusWithContext(send_status,
-                                                               "PingServer: "
-                                                               "SendSocketMessage fail"));
+        if (!status.ok())
+        {
+            return Dive::StatusWithContext(status, "DownloadFileFromServerParallel");
+        }
     }
 
-    auto receive = ReceiveSocketMessage(m_connection.get(), kPingTimeoutMs);
-    if (!receive.ok())
+    std::cout << "Client: File from server '" << remote_file_path
+              << "' downloaded successfully to '" << local_save_path << "'." << std::endl;
+    return Dive::OkStatus();
+}
+
+absl::StatusOr<size_t> TcpClient::GetCaptureFileSize(const std::string& remote_file_path)
+{
+    FileSizeRequest file_size_request;
+    file_size_request.SetString(remote_file_path);
+    std::cout << "Client: Requesting file size of " << remote_file_path << std::endl;
+    auto file_size_response = Request<FileSizeResponse>(
+        file_size_request, MessageType::FILE_SIZE_RESPONSE, "GetCaptureFileSize");
+    if (!file_size_response.ok())
     {
-        return SetStatusAndReturnError(ClientStatus::CONNECTION_FAILED,
-                                       Dive::StatusWithContext(receive.status(),
-                                                               "PingServer: ReceiveSocketMessage "
-                                                               "fail"));
+        return file_size_response.status();
     }
-
-    auto response = *std::move(receive);
-    if (response->GetMessageType() != MessageType::PONG_MESSAGE)
+    if (!(*file_size_response)->GetFound())
     {
-        return Dive::FailedPreconditionError(
-            absl::StrCat("PingServer: Unexpected message type in Ping response "
-                         "(Expected: ",
-                         MessageType::PONG_MESSAGE, ", Got: ", response->GetMessageType(), ")."));
+        return Dive::NotFoundError(
+            absl::StrCat("GetCaptureFileSize: Server could not find file. Reason: ",
+                         (*file_size_response)->GetErrorReason()));
     }
 
-    auto* pong_response = dynamic_cast<PongMessage*>(response.get());
-    if (!pong_response)
+    return static_cast<size_t>((*file_size_response)->GetFileSize());
+}
+
+absl::Status TcpClient::PingServer()
+{
+    PingMessage ping_request;
+    std::cout << "Client: Send PING." << std::endl;
+    auto pong_response = Request<PongMessage>(ping_request, MessageType::PONG_MESSAGE,
+                                              "PingServer", kPingTimeoutMs);
+    if (!pong_response.ok())
     {
-        return Dive::InternalError("PingServer: Failed to cast received message to PongMessage.");
+        return pong_response.status();
     }
     std::cout << "Client: Ping successful." << std::endl;
     return Dive::OkStatus();
@@ -358,66 +664,60 @@ absl::Status TcpClient::PingServer()
 
 absl::Status TcpClient::PerformHandshake()
 {
-    std::lock_guard<std::mutex> lock(m_connection_mutex);
-    if (!IsConnected())
-    {
-        return Dive::FailedPreconditionError(
-            absl::StrCat("PerformHandshake: Client is not connected."));
-    }
-
     HandshakeRequest hs_request;
     hs_request.SetMajorVersion(kHandshakeMajorVersion);
     hs_request.SetMinorVersion(kHandshakeMinorVersion);
+    hs_request.SetCapabilities((m_file_compression_enabled ? kCapabilityDeflateFiles : 0) |
+                               kCapabilityMultiplexing);
     std::cout << "Client: Sending Handshake (Client v" << hs_request.GetMajorVersion() << "."
               << hs_request.GetMinorVersion() << ")" << std::endl;
 
-    auto send_status = SendSocketMessage(m_connection.get(), hs_request);
-    if (!send_status.ok())
+    auto hs_response = Request<HandshakeResponse>(hs_request, MessageType::HANDSHAKE_RESPONSE,
+                                                  "PerformHandshake");
+    if (!hs_response.ok())
     {
-        return SetStatusAndReturnError(ClientStatus::CONNECTION_FAILED,
-                                       Dive::StatusWithContext(send_status,
-                                                               "PerformHandshake: "
-                                                               "SendSocketMessage fail"));
+        return hs_response.status();
     }
 
-    auto receive = ReceiveSocketMessage(m_connection.get());
-    if (!receive.ok())
-    {
-        return SetStatusAndReturnError(ClientStatus::CONNECTION_FAILED,
-                                       Dive::StatusWithContext(receive.status(),
-                                                               "PerformHandshake: "
-                                                               "ReceiveSocketMessage failed"));
-    }
+    std::cout << "Client: Server Handshake (Server v" << (*hs_response)->GetMajorVersion() << "."
+              << (*hs_response)->GetMinorVersion() << ")" << std::endl;
 
-    auto response = *std::move(receive);
-    if (response->GetMessageType() != MessageType::HANDSHAKE_RESPONSE)
+    if ((*hs_response)->GetMajorVersion() != hs_request.GetMajorVersion() ||
+        (*hs_response)->GetMinorVersion() != hs_request.GetMinorVersion())
     {
-        return Dive::FailedPreconditionError(absl::StrCat(
-            "PerformHandshake: Unexpected message type in Handshake response "
-            "(Expected: ",
-            MessageType::HANDSHAKE_RESPONSE, ", Got: ", response->GetMessageType(), ")."));
+        return Dive::FailedPreconditionError(
+            absl::StrCat("PerformHandshake: Handshake version mismatch. Server is v",
+                         (*hs_response)->GetMajorVersion(), ".",
+                         (*hs_response)->GetMinorVersion(), " Client requires v",
+                         hs_request.GetMajorVersion(), ".", hs_request.GetMinorVersion()));
     }
+    std::cout << "Client: Handshake versions compatible." << std::endl;
 
-    auto* hs_response = dynamic_cast<HandshakeResponse*>(response.get());
-    if (!hs_response)
+    const uint32_t capabilities = (*hs_response)->GetCapabilities() & hs_request.GetCapabilities();
+    FileCompression file_compression = GetFileCompressionForCapabilities(capabilities);
+    m_connection->SetFileCompression(file_compression);
+    std::cout << "Client: File compression "
+              << (file_compression == FileCompression::kDeflate ? "enabled." : "disabled.")
+              << std::endl;
+
+    if (capabilities & kCapabilityMultiplexing)
     {
-        return Dive::InternalError(
-            "PerformHandshake: Failed to cast received message to HandShakeResponse.");
+        m_connection->SetMultiplexed(true);
+        m_multiplexed = std::make_unique<MultiplexedConnection>(m_connection.get());
+        m_multiplexed->Start();
+        std::cout << "Client: Requests multiplexed." << std::endl;
     }
+    return Dive::OkStatus();
+}
 
-    std::cout << "Client: Server Handshake (Server v" << hs_response->GetMajorVersion() << "."
-              << hs_response->GetMinorVersion() << ")" << std::endl;
-
-    if (hs_response->GetMajorVersion() != hs_request.GetMajorVersion() ||
-        hs_response->GetMinorVersion() != hs_request.GetMinorVersion())
+void TcpClient::CloseConnection()
+{
+    if (m_multiplexed)
     {
-        return Dive::FailedPreconditionError(absl::StrCat(
-            "PerformHandshake: Handshake version mismatch. Server is v",
-            hs_response->GetMajorVersion(), ".", hs_response->GetMinorVersion(),
-            " Client requires v", hs_request.GetMajorVersion(), ".", hs_request.GetMinorVersion()));
+        m_multiplexed->Stop();
+        m_multiplexed.reset();
     }
-    std::cout << "Client: Handshake versions compatible." << std::endl;
-    return Dive::OkStatus();
+    m_connection.reset();
 }
 
 absl::Status TcpClient::StartKeepAlive()
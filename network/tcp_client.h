@@ -24,6 +24,7 @@ limitations under the License.
 #include <thread>
 
 #include "messages.h"
+#include "multiplexed_connection.h"
 
 namespace Network
 {
@@ -36,6 +37,17 @@ enum class ClientStatus
     CONNECTION_FAILED
 };
 
+struct ParallelDownloadOptions
+{
+    // Number of connections the file is downloaded over concurrently.
+    uint32_t stream_count = 4;
+    // Size of the ranges the file is split into. Each range is fetched and verified on its own.
+    uint64_t range_size = 32 << 20;
+    // Keeps the ranges of an existing local file that match the server's checksum, instead of
+    // downloading them again.
+    bool resume = true;
+};
+
 class TcpClient
 {
  public:
@@ -62,13 +74,53 @@ class TcpClient
                                         const std::string& local_save_path,
                                         std::function<void(size_t)> progress_callback = nullptr);
 
+    // Downloads a file from the server over several connections, each fetching ranges of the
+    // file. Every range is verified against the CRC-32 computed by the server. If the download
+    // fails, the partial local file is kept, so that downloading it again with options.resume
+    // only fetches the ranges that are missing or corrupted.
+    absl::Status DownloadFileFromServerParallel(
+        const std::string& remote_file_path, const std::string& local_save_path,
+        const ParallelDownloadOptions& options = ParallelDownloadOptions(),
+        std::function<void(size_t)> progress_callback = nullptr);
+
     // Gets the capture file size from the server.
     absl::StatusOr<size_t> GetCaptureFileSize(const std::string& remote_file_path);
 
+    // Requests, in the handshake of the next connections, that the server deflates the files it
+    // sends. It is enabled by default.
+    void SetFileCompressionEnabled(bool enabled) { m_file_compression_enabled = enabled; }
+
  private:
     // Performs a ping-pong check with the server.
     absl::Status PingServer();
 
+    // Sends the request and returns its id. Unless the connection is multiplexed, the id is 0 and
+    // m_connection_mutex must be held until the last message of the request is received.
+    absl::StatusOr<uint32_t> SendRequest(ISerializable& request, const char* context);
+
+    // Receives the next message of the request.
+    absl::StatusOr<std::unique_ptr<ISerializable>> ReceiveMessage(uint32_t request_id,
+                                                                  const char* context,
+                                                                  int timeout_ms = kNoTimeout);
+
+    // Releases the request once all its messages are received.
+    void EndRequest(uint32_t request_id);
+
+    // Sends the request and receives its response, of type ResponseType. Unless the connection is
+    // multiplexed, it is held until the response arrives.
+    template<typename ResponseType>
+    absl::StatusOr<std::unique_ptr<ResponseType>> Request(ISerializable& request,
+                                                          MessageType response_type,
+                                                          const char* context,
+                                                          int timeout_ms = kNoTimeout);
+
+    // Receives the file that follows a DownloadFileResponse on a multiplexed connection.
+    absl::Status ReceiveFileData(uint32_t request_id, const std::string& local_save_path,
+                                 size_t file_size, const std::function<void(size_t)>& progress);
+
+    // Stops the multiplexing and closes the connection.
+    void CloseConnection();
+
     // Performs a handshake with the server.
     absl::Status PerformHandshake();
 
@@ -87,6 +139,13 @@ class TcpClient
 
     std::unique_ptr<SocketConnection> m_connection;
     std::mutex m_connection_mutex;
+    // Set when the server accepted kCapabilityMultiplexing. Requests then run concurrently, and
+    // m_connection_mutex is not used.
+    std::unique_ptr<MultiplexedConnection> m_multiplexed;
+    // Server address, used to open the additional connections of a parallel download.
+    std::string m_host;
+    int m_port = 0;
+    bool m_file_compression_enabled = true;
     ClientStatus m_status;
     mutable std::mutex m_status_mutex;
 
@@ -16,9 +16,13 @@ limitations under the License.
 
 #include "unix_domain_server.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "absl/strings/str_cat.h"
 #include "dive/common/log.h"
 #include "dive/common/status.h"
+#include "file_transfer.h"
 
 namespace Network
 {
@@ -48,10 +52,7 @@ void DefaultMessageHandler::HandleMessage(std::unique_ptr<ISerializable> message
             auto* request = dynamic_cast<HandshakeRequest*>(message.get());
             if (request)
             {
-                HandshakeResponse response;
-                response.SetMajorVersion(request->GetMajorVersion());
-                response.SetMinorVersion(request->GetMinorVersion());
-                auto status = SendSocketMessage(client_conn, response);
+                auto status = SendHandshakeResponse(*request, client_conn);
                 if (!status.ok())
                 {
                     LOGW("DefaultMessageHandler::HandleMessage: SendSocketMessage fail: %.*s",
@@ -70,6 +71,7 @@ void DefaultMessageHandler::HandleMessage(std::unique_ptr<ISerializable> message
             if (request)
             {
                 PongMessage response;
+                response.SetRequestId(request->GetRequestId());
                 auto status = SendSocketMessage(client_conn, response);
                 if (!status.ok())
                 {
@@ -102,6 +104,10 @@ UnixDomainServer::~UnixDomainServer() { Stop(); }
 
 absl::Status UnixDomainServer::Start(const std::string& server_address)
 {
+#ifdef WIN32
+    return Dive::UnimplementedError(
+        "Start: This POSIX server is not supported/implemented on Windows.");
+#else
     if (m_is_running.load())
     {
         return Dive::AlreadyExistsError("Start: Server is already running.");
@@ -117,11 +123,22 @@ absl::Status UnixDomainServer::Start(const std::string& server_address)
     {
         return Dive::StatusWithContext(conn_status, "Start: Failed to bind and listen socket");
     }
+    if (::pipe(m_wakeup_fds) != 0)
+    {
+        return Dive::InternalError(
+            absl::StrCat("Start: Failed to create wakeup pipe: ", strerror(errno)));
+    }
 
     m_listen_connection = *std::move(connection);
     m_is_running.store(true);
-    m_server_thread = std::thread(&UnixDomainServer::AcceptAndHandleClientLoop, this);
+    m_stopping_handlers = false;
+    for (size_t i = 0; i < kHandlerThreadCount; ++i)
+    {
+        m_handler_threads.emplace_back(&UnixDomainServer::HandlerLoop, this);
+    }
+    m_server_thread = std::thread(&UnixDomainServer::ServerLoop, this);
     return Dive::OkStatus();
+#endif
 }
 
 void UnixDomainServer::Wait()
@@ -133,99 +150,267 @@ void UnixDomainServer::Wait()
 void UnixDomainServer::Stop()
 {
     m_is_running.store(false);
-    m_listen_connection.reset();
-    ResetClientConnection();
+    WakeServerThread();
     if (m_server_thread.joinable())
     {
         m_server_thread.join();
     }
 
+    // The server thread has shut down the client connections, so the handlers that are still
+    // sending fail quickly.
+    {
+        std::lock_guard<std::mutex> lock(m_task_mutex);
+        m_stopping_handlers = true;
+        m_tasks.clear();
+    }
+    m_task_cv.notify_all();
+    for (auto& thread : m_handler_threads)
+    {
+        thread.join();
+    }
+    m_handler_threads.clear();
+    m_listen_connection.reset();
+#ifndef WIN32
+    for (int& fd : m_wakeup_fds)
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+#endif
+
     m_wait_cv.notify_one();
     LOGI("UnixDomainServer: Stopped completely.");
 }
 
-void UnixDomainServer::AcceptAndHandleClientLoop()
+void UnixDomainServer::WakeServerThread()
 {
+#ifndef WIN32
+    if (m_wakeup_fds[1] >= 0)
+    {
+        uint8_t byte = 0;
+        (void)::write(m_wakeup_fds[1], &byte, sizeof(byte));
+    }
+#endif
+}
+
+void UnixDomainServer::ServerLoop()
+{
+#ifndef WIN32
+    std::vector<pollfd> fds;
     while (m_is_running.load())
     {
-        // We only accept one client connection at a time.
-        if (!m_client_connection)
+        // poll() rather than epoll: there are at most kMaxClientConnections + 2 descriptors.
+        fds.clear();
+        fds.push_back({m_wakeup_fds[0], POLLIN, 0});
+        // New clients wait in the listen backlog while the server is full.
+        short listen_events = (m_clients.size() < kMaxClientConnections) ? POLLIN : 0;
+        fds.push_back({m_listen_connection->GetSocket(), listen_events, 0});
+        for (const auto& session : m_clients)
         {
-            if (!m_listen_connection || !m_listen_connection->IsOpen())
-            {
-                LOGI(m_is_running.load()
-                         ? "AcceptAndHandleClientLoop: Listen socket closed unexpectedly. Stopping."
-                         : "AcceptAndHandleClientLoop: Listen socket closed for shutdown.");
-                break;
-            }
+            fds.push_back({session->connection->GetSocket(), POLLIN, 0});
+        }
 
-            auto acc_connection = m_listen_connection->Accept();
-            if (!acc_connection.ok())
+        if (::poll(fds.data(), static_cast<nfds_t>(fds.size()), -1) < 0)
+        {
+            if (errno == EINTR)
             {
-                if (!m_is_running.load())
-                {
-                    LOGI("AcceptAndHandleClientLoop: Accept: Exiting loop due to shutdown.");
-                    break;
-                }
-                LOGI("AcceptAndHandleClientLoop: Error accepting new client: %.*s",
-                     static_cast<int>(acc_connection.status().message().length()),
-                     acc_connection.status().message().data());
                 continue;
             }
-
-            {
-                std::lock_guard<std::mutex> lk(m_client_mutex);
-                m_client_connection = *std::move(acc_connection);
-            }
-            LOGI("AcceptAndHandleClientLoop: New client accepted.");
-            m_handler->OnConnect();
+            LOGI("ServerLoop: poll() failed: %s", strerror(errno));
+            break;
+        }
+        if (fds[0].revents != 0)
+        {
+            continue;
+        }
+        if (fds[1].revents & (POLLERR | POLLHUP | POLLNVAL))
+        {
+            LOGI("ServerLoop: Listen socket closed unexpectedly. Stopping.");
+            break;
         }
 
-        // Having accepted the only client connection, we're now ready to receive messages from it.
-        if (m_client_connection)
+        // Accepting may add clients, so the clients that were polled are handled first.
+        std::vector<std::shared_ptr<ClientSession>> polled_clients = m_clients;
+        for (size_t i = 0; i < polled_clients.size(); ++i)
         {
-            if (!m_client_connection->IsOpen())
+            if (fds[i + 2].revents == 0)
             {
-                LOGI("AcceptAndHandleClientLoop: Client connection is closed.");
-                m_handler->OnDisconnect();
-                ResetClientConnection();
                 continue;
             }
-
-            auto recv_message = ReceiveSocketMessage(m_client_connection.get());
-            if (!recv_message.ok())
+            absl::Status status = ReadClientMessages(polled_clients[i]);
+            if (!status.ok())
             {
-                if (!m_is_running.load())
+                if (!absl::IsOutOfRange(status))
                 {
-                    LOGI(
-                        "AcceptAndHandleClientLoop: ReceiveSocketMessage: Exiting loop due to "
-                        "shutdown.");
-                    m_handler->OnDisconnect();
-                    break;
+                    LOGI("ServerLoop: Failed to read client message: %.*s",
+                         static_cast<int>(status.message().length()), status.message().data());
                 }
-
-                LOGI("AcceptAndHandleClientLoop: ReceiveSocketMessage failed: %.*s",
-                     static_cast<int>(recv_message.status().message().length()),
-                     recv_message.status().message().data());
-                m_handler->OnDisconnect();
-                ResetClientConnection();
-            }
-            else
-            {
-                m_handler->HandleMessage(*std::move(recv_message), m_client_connection.get());
+                DisconnectClient(polled_clients[i]);
             }
         }
+        if (fds[1].revents & POLLIN)
+        {
+            AcceptClient();
+        }
     }
 
-    LOGI("AcceptAndHandleClientLoop: Exiting loop.");
+    LOGI("ServerLoop: Exiting loop.");
+    while (!m_clients.empty())
+    {
+        DisconnectClient(m_clients.back());
+    }
     m_is_running.store(false);
     m_wait_cv.notify_one();
+#endif
 }
 
-void UnixDomainServer::ResetClientConnection()
+void UnixDomainServer::AcceptClient()
 {
-    std::lock_guard<std::mutex> lk(m_client_mutex);
-    m_client_connection.reset();
+    auto acc_connection = m_listen_connection->Accept();
+    if (!acc_connection.ok())
+    {
+        LOGI("AcceptClient: Error accepting new client: %.*s",
+             static_cast<int>(acc_connection.status().message().length()),
+             acc_connection.status().message().data());
+        return;
+    }
+    LOGI("AcceptClient: New client accepted.");
+    auto session = std::make_shared<ClientSession>();
+    session->connection = *std::move(acc_connection);
+    m_clients.push_back(std::move(session));
+    m_handler->OnConnect();
+}
+
+absl::Status UnixDomainServer::ReadClientMessages(const std::shared_ptr<ClientSession>& session)
+{
+    constexpr size_t kReadChunkSize = 64 << 10;
+
+    // A handler closes the connection when sending fails.
+    if (!session->connection->IsOpen())
+    {
+        return Dive::OutOfRangeError("ReadClientMessages: Connection closed.");
+    }
+
+    // Read what is available, without waiting, so that a slow client does not hold the others.
+    Buffer& buffer = session->read_buffer;
+    const size_t buffered_size = buffer.size();
+    buffer.resize(buffered_size + kReadChunkSize);
+    absl::StatusOr<size_t> received =
+        session->connection->RecvAvailable(buffer.data() + buffered_size, kReadChunkSize);
+    buffer.resize(buffered_size + (received.ok() ? *received : 0));
+    if (!received.ok())
+    {
+        return received.status();
+    }
+
+    size_t offset = 0;
+    while (buffer.size() - offset >= kMessageHeaderSize)
+    {
+        absl::StatusOr<MessageHeader> header = ParseMessageHeader(buffer.data() + offset);
+        if (!header.ok())
+        {
+            return header.status();
+        }
+        const size_t message_size = kMessageHeaderSize + header->payload_size;
+        if (buffer.size() - offset < message_size)
+        {
+            break;
+        }
+        Buffer payload(buffer.begin() + offset + kMessageHeaderSize,
+                       buffer.begin() + offset + message_size);
+        auto message = DeserializeMessage(*header, std::move(payload));
+        if (!message.ok())
+        {
+            return message.status();
+        }
+        DispatchMessage(session, *std::move(message));
+        offset += message_size;
+    }
+    buffer.erase(buffer.begin(), buffer.begin() + offset);
+    return Dive::OkStatus();
+}
+
+void UnixDomainServer::DispatchMessage(const std::shared_ptr<ClientSession>& session,
+                                       std::unique_ptr<ISerializable> message)
+{
+    HandlerTask task;
+    task.session = session;
+    if (session->connection->IsMultiplexed())
+    {
+        task.message = std::move(message);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->pending_messages.push_back(std::move(message));
+        if (session->handling)
+        {
+            return;
+        }
+        session->handling = true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_task_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_task_cv.notify_one();
+}
+
+void UnixDomainServer::DisconnectClient(const std::shared_ptr<ClientSession>& session)
+{
+    LOGI("DisconnectClient: Client connection is closed.");
+    session->connection->Shutdown();
+    m_clients.erase(std::remove(m_clients.begin(), m_clients.end(), session), m_clients.end());
+    m_handler->OnDisconnect();
+}
+
+void UnixDomainServer::HandlerLoop()
+{
+    while (true)
+    {
+        HandlerTask task;
+        {
+            std::unique_lock<std::mutex> lock(m_task_mutex);
+            m_task_cv.wait(lock, [this] { return m_stopping_handlers || !m_tasks.empty(); });
+            if (m_stopping_handlers)
+            {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        if (task.message)
+        {
+            m_handler->HandleMessage(std::move(task.message), task.session->connection.get());
+        }
+        else
+        {
+            HandlePendingMessages(*task.session);
+        }
+    }
+}
+
+void UnixDomainServer::HandlePendingMessages(ClientSession& session)
+{
+    while (true)
+    {
+        std::unique_ptr<ISerializable> message;
+        {
+            std::lock_guard<std::mutex> lock(session.mutex);
+            if (session.pending_messages.empty())
+            {
+                session.handling = false;
+                return;
+            }
+            message = std::move(session.pending_messages.front());
+            session.pending_messages.pop_front();
+        }
+        m_handler->HandleMessage(std::move(message), session.connection.get());
+    }
 }
 
-}  // namespace Network
\ No newline at end of file
+}  // namespace Network
@@ -18,10 +18,12 @@ limitations under the License.
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "message_handler.h"
 #include "messages.h"
@@ -40,13 +42,20 @@ class DefaultMessageHandler : public IMessageHandler
     void OnDisconnect() override;
 };
 
-// The UnixDomainServer is designed to run two threads. One thread accepts and handles a single
-// client connection, while the main thread starts the server and waits for the first thread to
-// finish or for an unexpected error to occur that necessitates stopping the server.
-// The server is designed to accept only one client connection at a time.
+// The UnixDomainServer waits on the listen socket and on all the client connections at once on its
+// server thread, which accepts the clients and reads their messages, and hands the messages to a
+// pool of kHandlerThreadCount handler threads. The messages of a client that negotiated
+// kCapabilityMultiplexing are handled concurrently, so that a ping or a file size request is
+// answered while a file is being sent to the same client. The messages of other clients are
+// handled one at a time, in order. The main thread starts the server and waits for the server
+// thread to finish or for an unexpected error to occur that necessitates stopping the server.
+// At most kMaxClientConnections clients are served at a time.
 class UnixDomainServer
 {
  public:
+    static constexpr size_t kMaxClientConnections = 16;
+    static constexpr size_t kHandlerThreadCount = 8;
+
     // Constructs the server, taking ownership of the provided IMessageHandler.
     explicit UnixDomainServer(
         std::unique_ptr<IMessageHandler> handler = std::make_unique<DefaultMessageHandler>());
@@ -64,23 +73,70 @@ class UnixDomainServer
     void Stop();
 
  private:
+    struct ClientSession
+    {
+        std::unique_ptr<SocketConnection> connection;
+        // The received bytes of the messages that are not complete yet.
+        Buffer read_buffer;
+        // For a client that is not multiplexed, the messages waiting for the previous ones to be
+        // handled, and whether a handler thread is handling them.
+        std::mutex mutex;
+        std::deque<std::unique_ptr<ISerializable>> pending_messages;
+        bool handling = false;
+    };
+
+    // A message to handle. For a client that is not multiplexed, the message is null and the
+    // pending messages of the client are handled instead.
+    struct HandlerTask
+    {
+        std::shared_ptr<ClientSession> session;
+        std::unique_ptr<ISerializable> message;
+    };
+
     // The primary run loop for the server's worker thread.
-    void AcceptAndHandleClientLoop();
+    void ServerLoop();
+
+    // Accepts a new client.
+    void AcceptClient();
+
+    // Reads what the client sent, and dispatches the messages that are complete.
+    absl::Status ReadClientMessages(const std::shared_ptr<ClientSession>& session);
+
+    // Queues the message for the handler threads.
+    void DispatchMessage(const std::shared_ptr<ClientSession>& session,
+                         std::unique_ptr<ISerializable> message);
 
-    // Resets the client connection to prepare for a new client.
-    void ResetClientConnection();
+    // Shuts down the connection of the client and stops waiting on it. The connection is closed
+    // once the handler threads no longer use it.
+    void DisconnectClient(const std::shared_ptr<ClientSession>& session);
+
+    // The run loop of a handler thread.
+    void HandlerLoop();
+
+    // Handles the pending messages of a client that is not multiplexed, until there is none left.
+    void HandlePendingMessages(ClientSession& session);
+
+    // Makes the server thread return from poll().
+    void WakeServerThread();
 
     // Server connection.
     std::unique_ptr<SocketConnection> m_listen_connection;
-    // The only one client connection at a time.
-    std::unique_ptr<SocketConnection> m_client_connection;
-    // The thread that accepts and handles the only one client connection at a time.
+    // The connected clients. Only used by the server thread.
+    std::vector<std::shared_ptr<ClientSession>> m_clients;
+    // The thread that accepts the clients and reads their messages.
     std::thread m_server_thread;
+    // Written to by Stop() to wake up the server thread.
+    int m_wakeup_fds[2] = {-1, -1};
+
+    std::vector<std::thread> m_handler_threads;
+    std::deque<HandlerTask> m_tasks;
+    bool m_stopping_handlers = false;
+    std::mutex m_task_mutex;
+    std::condition_variable m_task_cv;
 
     std::unique_ptr<IMessageHandler> m_handler;
     std::atomic<bool> m_is_running;
-    std::mutex m_client_mutex;
     std::mutex m_wait_mutex;
     std::condition_variable m_wait_cv;
 };
-}  // namespace Network
\ No newline at end of file
+}  // namespace Network
@@ -0,0 +1,178 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace DiveLayer
+{
+
+// Map from dispatch key to layer data, which is looked up without a lock
+// Every intercepted call does a lookup, possibly from many threads, while inserts and erases only
+// happen on instance/device creation and destruction. The first kCapacity live keys are kept in a
+// lock-free open-addressing table, any more in a map under a shared lock
+// Data is freed when its key is erased, or inserted again for a new object. Vulkan does not allow
+// using an object while it is being destroyed, so no other thread can be looking up its key then.
+// Caches of lookups have to check GetGeneration(), which changes whenever data is freed
+template <typename Data, size_t kCapacity>
+class LayerDataTable
+{
+ public:
+    ~LayerDataTable()
+    {
+        for (size_t i = 0; i < kCapacity; ++i)
+        {
+            delete m_data[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    // Returns nullptr if the key is not in the table
+    Data* Find(uintptr_t key) const
+    {
+        for (size_t i = 0; i < kCapacity; ++i)
+        {
+            const size_t slot = (Hash(key) + i) % kCapacity;
+            const uintptr_t slot_key = m_keys[slot].load(std::memory_order_acquire);
+            if (slot_key == key)
+            {
+                return m_data[slot].load(std::memory_order_acquire);
+            }
+            if (slot_key == kEmptyKey)
+            {
+                break;
+            }
+        }
+        if (m_overflow_count.load(std::memory_order_acquire) == 0)
+        {
+            return nullptr;
+        }
+        std::shared_lock<std::shared_mutex> lock(m_overflow_mutex);
+        auto it = m_overflow.find(key);
+        return (it != m_overflow.end()) ? it->second.get() : nullptr;
+    }
+
+    // Needs to be externally synchronized with other Insert() and Erase() calls
+    void Insert(uintptr_t key, std::unique_ptr<Data> data)
+    {
+        // A key that is already in the table belongs to an object that was destroyed without the
+        // layer seeing it, so its data is not in use anymore
+        Erase(key);
+        for (size_t i = 0; i < kCapacity; ++i)
+        {
+            const size_t slot = (Hash(key) + i) % kCapacity;
+            const uintptr_t slot_key = m_keys[slot].load(std::memory_order_relaxed);
+            if ((slot_key != kEmptyKey) && (slot_key != kErasedKey))
+            {
+                continue;
+            }
+            // Publish the data before the key, so a lookup that finds the key also finds the data
+            m_data[slot].store(data.release(), std::memory_order_release);
+            m_keys[slot].store(key, std::memory_order_release);
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(m_overflow_mutex);
+        m_overflow[key] = std::move(data);
+        m_overflow_count.store(m_overflow.size(), std::memory_order_release);
+    }
+
+    // Needs to be externally synchronized with other Insert() and Erase() calls
+    void Erase(uintptr_t key)
+    {
+        for (size_t i = 0; i < kCapacity; ++i)
+        {
+            const size_t slot = (Hash(key) + i) % kCapacity;
+            const uintptr_t slot_key = m_keys[slot].load(std::memory_order_relaxed);
+            if (slot_key == key)
+            {
+                // Keep the slot marked as used, so lookups of keys further down the probe
+                // sequence still find them
+                m_keys[slot].store(kErasedKey, std::memory_order_release);
+                m_generation.fetch_add(1, std::memory_order_acq_rel);
+                delete m_data[slot].exchange(nullptr, std::memory_order_acq_rel);
+                return;
+            }
+            if (slot_key == kEmptyKey)
+            {
+                break;
+            }
+        }
+        if (m_overflow_count.load(std::memory_order_relaxed) == 0)
+        {
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(m_overflow_mutex);
+        auto it = m_overflow.find(key);
+        if (it != m_overflow.end())
+        {
+            m_generation.fetch_add(1, std::memory_order_acq_rel);
+            m_overflow.erase(it);
+            m_overflow_count.store(m_overflow.size(), std::memory_order_release);
+        }
+    }
+
+    uint64_t GetGeneration() const { return m_generation.load(std::memory_order_acquire); }
+
+ private:
+    // Dispatch keys are pointers, so these never collide with a real key
+    static constexpr uintptr_t kEmptyKey = 0;
+    static constexpr uintptr_t kErasedKey = 1;
+
+    static size_t Hash(uintptr_t key) { return (key >> 4) * 0x9E3779B97F4A7C15ull >> 32; }
+
+    std::array<std::atomic<uintptr_t>, kCapacity> m_keys = {};
+    std::array<std::atomic<Data*>, kCapacity> m_data = {};
+    std::atomic<uint64_t> m_generation = 0;
+
+    mutable std::shared_mutex m_overflow_mutex;
+    std::unordered_map<uintptr_t, std::unique_ptr<Data>> m_overflow;
+    std::atomic<size_t> m_overflow_count = 0;
+};
+
+// Last lookup of a thread, only valid while the table's generation is unchanged
+template <typename Data>
+struct LayerDataCache
+{
+    uintptr_t key = 0;
+    Data* data = nullptr;
+    uint64_t generation = 0;
+};
+
+// Looks key up in the table, unless it is the last lookup of cache, and that is still valid
+template <typename Data, size_t kCapacity>
+Data* GetLayerData(const LayerDataTable<Data, kCapacity>& table, LayerDataCache<Data>& cache,
+                   uintptr_t key)
+{
+    const uint64_t generation = table.GetGeneration();
+    if (cache.data && cache.key == key && cache.generation == generation)
+    {
+        return cache.data;
+    }
+
+    cache.key = key;
+    cache.data = table.Find(key);
+    cache.generation = generation;
+    return cache.data;
+}
+
+}  // namespace DiveLayer
@@ -0,0 +1,226 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "layer_data_table.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace DiveLayer
+{
+namespace
+{
+
+struct TestData
+{
+    uintptr_t key;
+    // Different for every object, including objects that reuse a key
+    uint64_t serial;
+};
+
+// Few slots, so that the probe sequences collide, slots are reused after erases, and the overflow
+// map is used
+constexpr size_t kCapacity = 8;
+using TestTable = LayerDataTable<TestData, kCapacity>;
+
+// Dispatch keys are pointers to the dispatch tables, so they are aligned
+uintptr_t GetKey(size_t index) { return 0x10000 + index * 16; }
+
+TEST(LayerDataTableTest, FindsInsertedKeys)
+{
+    constexpr size_t kNumKeys = 3 * kCapacity;
+    TestTable table;
+    for (size_t i = 0; i < kNumKeys; ++i)
+    {
+        table.Insert(GetKey(i), std::make_unique<TestData>(TestData{ GetKey(i), i }));
+    }
+    for (size_t i = 0; i < kNumKeys; ++i)
+    {
+        TestData* data = table.Find(GetKey(i));
+        ASSERT_NE(data, nullptr);
+        EXPECT_EQ(data->serial, i);
+    }
+
+    // Erase every other key, in and out of the lock-free slots
+    for (size_t i = 0; i < kNumKeys; i += 2)
+    {
+        table.Erase(GetKey(i));
+    }
+    for (size_t i = 0; i < kNumKeys; ++i)
+    {
+        TestData* data = table.Find(GetKey(i));
+        if (i % 2 == 0)
+        {
+            EXPECT_EQ(data, nullptr);
+        }
+        else
+        {
+            ASSERT_NE(data, nullptr);
+            EXPECT_EQ(data->serial, i);
+        }
+    }
+    EXPECT_EQ(table.Find(GetKey(kNumKeys)), nullptr);
+}
+
+TEST(LayerDataTableTest, CachedLookupsSeeRecreatedObjects)
+{
+    TestTable table;
+    LayerDataCache<TestData> cache;
+    const uintptr_t key = GetKey(0);
+    table.Insert(key, std::make_unique<TestData>(TestData{ key, 1 }));
+    ASSERT_NE(GetLayerData(table, cache, key), nullptr);
+    EXPECT_EQ(GetLayerData(table, cache, key)->serial, 1u);
+
+    // Destroyed, then created again with the same handle
+    table.Erase(key);
+    EXPECT_EQ(GetLayerData(table, cache, key), nullptr);
+    table.Insert(key, std::make_unique<TestData>(TestData{ key, 2 }));
+    ASSERT_NE(GetLayerData(table, cache, key), nullptr);
+    EXPECT_EQ(GetLayerData(table, cache, key)->serial, 2u);
+
+    // Created again without the layer seeing it destroyed
+    table.Insert(key, std::make_unique<TestData>(TestData{ key, 3 }));
+    ASSERT_NE(GetLayerData(table, cache, key), nullptr);
+    EXPECT_EQ(GetLayerData(table, cache, key)->serial, 3u);
+}
+
+// Threads create, use and destroy objects all at once, as the layer sees them. The handles of
+// destroyed objects are reused by any thread, so the caches of the other threads hold stale lookups
+// of them. As Vulkan requires, an object is only used by threads while it exists
+TEST(LayerDataTableTest, ConcurrentCreateUseDestroy)
+{
+    constexpr size_t kNumThreads = 8;
+    constexpr size_t kNumKeys = 4 * kCapacity;
+    constexpr int kNumObjectsPerThread = 2000;
+    constexpr int kNumLookupsPerObject = 20;
+
+    TestTable table;
+    // Inserts and erases are externally synchronized, as in the layer
+    std::mutex table_mutex;
+    std::atomic<uint64_t> next_serial = 1;
+
+    // Handles that are not in use, shared by all the threads
+    std::mutex free_keys_mutex;
+    std::deque<uintptr_t> free_keys;
+    for (size_t i = 0; i < kNumKeys; ++i)
+    {
+        free_keys.push_back(GetKey(i));
+    }
+
+    std::atomic<int> num_failures = 0;
+    auto run_thread = [&](size_t thread_index) {
+        LayerDataCache<TestData> cache;
+        std::vector<TestData> objects;
+        auto check = [&](const TestData& object) {
+            TestData* data = GetLayerData(table, cache, object.key);
+            if (data == nullptr || data->key != object.key || data->serial != object.serial)
+            {
+                ++num_failures;
+            }
+        };
+
+        for (int i = 0; i < kNumObjectsPerThread; ++i)
+        {
+            // Create an object, with a handle that may have been used by any thread
+            TestData object;
+            {
+                std::lock_guard<std::mutex> lock(free_keys_mutex);
+                if (free_keys.empty())
+                {
+                    continue;
+                }
+                object.key = free_keys.front();
+                free_keys.pop_front();
+            }
+            object.serial = next_serial++;
+            {
+                std::lock_guard<std::mutex> lock(table_mutex);
+                table.Insert(object.key, std::make_unique<TestData>(object));
+            }
+            objects.push_back(object);
+
+            // Use all the objects of the thread, mostly the last one, as the layer would
+            for (int j = 0; j < kNumLookupsPerObject; ++j)
+            {
+                check(objects[(j % 4 == 0) ? (j / 4) % objects.size() : objects.size() - 1]);
+            }
+
+            // Keep up to 3 objects, destroying the oldest one. Some of them are destroyed and
+            // created again with the same handle right away
+            if (objects.size() > 3 || (i + thread_index) % 7 == 0)
+            {
+                TestData destroyed = objects.front();
+                objects.erase(objects.begin());
+                if ((i + thread_index) % 5 == 0)
+                {
+                    TestData recreated = destroyed;
+                    recreated.serial = next_serial++;
+                    {
+                        std::lock_guard<std::mutex> lock(table_mutex);
+                        table.Erase(destroyed.key);
+                        table.Insert(recreated.key, std::make_unique<TestData>(recreated));
+                    }
+                    check(recreated);
+                    destroyed = recreated;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(table_mutex);
+                    table.Erase(destroyed.key);
+                }
+                if (GetLayerData(table, cache, destroyed.key) != nullptr)
+                {
+                    ++num_failures;
+                }
+                std::lock_guard<std::mutex> lock(free_keys_mutex);
+                free_keys.push_back(destroyed.key);
+            }
+        }
+
+        for (const TestData& object : objects)
+        {
+            check(object);
+            std::lock_guard<std::mutex> lock(table_mutex);
+            table.Erase(object.key);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kNumThreads; ++i)
+    {
+        threads.emplace_back(run_thread, i);
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(num_failures, 0);
+    for (size_t i = 0; i < kNumKeys; ++i)
+    {
+        EXPECT_EQ(table.Find(GetKey(i)), nullptr);
+    }
+}
+
+}  // namespace
+}  // namespace DiveLayer
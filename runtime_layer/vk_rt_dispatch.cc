@@ -28,6 +28,7 @@ void InitInstanceDispatchTable(VkInstance instance, PFN_vkGetInstanceProcAddr pa
 
     dt->pfn_get_instance_proc_addr = pa;
     dt->CreateDevice = (PFN_vkCreateDevice)pa(instance, "vkCreateDevice");
+    dt->DestroyInstance = (PFN_vkDestroyInstance)pa(instance, "vkDestroyInstance");
     dt->EnumerateDeviceLayerProperties =
         (PFN_vkEnumerateDeviceLayerProperties)pa(instance, "vkEnumerateDeviceLayerProperties");
 
@@ -42,6 +43,12 @@ void InitDeviceDispatchTable(VkDevice device, PFN_vkGetDeviceProcAddr pa, Device
     dt->QueuePresentKHR = (PFN_vkQueuePresentKHR)pa(device, "vkQueuePresentKHR");
     dt->CreateImage = (PFN_vkCreateImage)pa(device, "vkCreateImage");
     dt->CmdDrawIndexed = (PFN_vkCmdDrawIndexed)pa(device, "vkCmdDrawIndexed");
+    dt->CmdDraw = (PFN_vkCmdDraw)pa(device, "vkCmdDraw");
+    dt->CmdDrawIndirect = (PFN_vkCmdDrawIndirect)pa(device, "vkCmdDrawIndirect");
+    dt->CmdDrawIndexedIndirect =
+        (PFN_vkCmdDrawIndexedIndirect)pa(device, "vkCmdDrawIndexedIndirect");
+    dt->CmdDispatch = (PFN_vkCmdDispatch)pa(device, "vkCmdDispatch");
+    dt->CmdDispatchIndirect = (PFN_vkCmdDispatchIndirect)pa(device, "vkCmdDispatchIndirect");
     dt->CmdResetQueryPool = (PFN_vkCmdResetQueryPool)pa(device, "vkCmdResetQueryPool");
     dt->CmdWriteTimestamp = (PFN_vkCmdWriteTimestamp)pa(device, "vkCmdWriteTimestamp");
     dt->GetQueryPoolResults = (PFN_vkGetQueryPoolResults)pa(device, "vkGetQueryPoolResults");
@@ -26,6 +26,7 @@ struct InstanceDispatchTable
 {
     PFN_vkGetInstanceProcAddr pfn_get_instance_proc_addr = nullptr;
     PFN_vkCreateDevice CreateDevice = nullptr;
+    PFN_vkDestroyInstance DestroyInstance = nullptr;
     PFN_vkEnumerateDeviceLayerProperties EnumerateDeviceLayerProperties = nullptr;
     PFN_vkEnumerateDeviceExtensionProperties EnumerateDeviceExtensionProperties = nullptr;
 };
@@ -36,6 +37,11 @@ struct DeviceDispatchTable
     PFN_vkQueuePresentKHR QueuePresentKHR = nullptr;
     PFN_vkCreateImage CreateImage = nullptr;
     PFN_vkCmdDrawIndexed CmdDrawIndexed = nullptr;
+    PFN_vkCmdDraw CmdDraw = nullptr;
+    PFN_vkCmdDrawIndirect CmdDrawIndirect = nullptr;
+    PFN_vkCmdDrawIndexedIndirect CmdDrawIndexedIndirect = nullptr;
+    PFN_vkCmdDispatch CmdDispatch = nullptr;
+    PFN_vkCmdDispatchIndirect CmdDispatchIndirect = nullptr;
     PFN_vkCmdResetQueryPool CmdResetQueryPool = nullptr;
     PFN_vkCmdWriteTimestamp CmdWriteTimestamp = nullptr;
     PFN_vkGetQueryPoolResults GetQueryPoolResults = nullptr;
@@ -27,6 +27,7 @@ limitations under the License.
 #include <vector>
 
 #include "common/log.h"
+#include "layer_data_table.h"
 #include "vk_rt_dispatch.h"
 #include "vk_rt_layer_impl.h"
 
@@ -60,14 +61,16 @@ namespace
 {
 // Generally we expect to get the same device and instance, so we keep them
 // handy
-static thread_local InstanceData* last_used_instance_data = nullptr;
-static thread_local DeviceData* last_used_device_data = nullptr;
+static thread_local LayerDataCache<InstanceData> last_used_instance_data;
+static thread_local LayerDataCache<DeviceData> last_used_device_data;
 
+// Only taken when inserting or erasing
+constexpr size_t kLockFreeLayerDataCount = 64;
 std::mutex g_instance_mutex;
-std::unordered_map<uintptr_t, std::unique_ptr<InstanceData>> g_instance_data;
+LayerDataTable<InstanceData, kLockFreeLayerDataCount> g_instance_data;
 
 std::mutex g_device_mutex;
-std::unordered_map<uintptr_t, std::unique_ptr<DeviceData>> g_device_data;
+LayerDataTable<DeviceData, kLockFreeLayerDataCount> g_device_data;
 
 constexpr VkLayerProperties layer_properties = {
     "VK_LAYER_Dive", VK_MAKE_VERSION(1, 0, VK_HEADER_VERSION), 1, "Dive capture layer for xr."};
@@ -85,26 +88,12 @@ static constexpr std::array<VkExtensionProperties, 1> device_extensions{{
 
 InstanceData* GetInstanceLayerData(uintptr_t key)
 {
-    if (last_used_instance_data && DataKey(last_used_instance_data->instance) == key)
-    {
-        return last_used_instance_data;
-    }
-
-    std::lock_guard<std::mutex> lock(g_instance_mutex);
-    last_used_instance_data = g_instance_data[key].get();
-    return last_used_instance_data;
+    return GetLayerData(g_instance_data, last_used_instance_data, key);
 }
 
 DeviceData* GetDeviceLayerData(uintptr_t key)
 {
-    if (last_used_device_data && DataKey(last_used_device_data->device) == key)
-    {
-        return last_used_device_data;
-    }
-
-    std::lock_guard<std::mutex> lock(g_device_mutex);
-    last_used_device_data = g_device_data[key].get();
-    return last_used_device_data;
+    return GetLayerData(g_device_data, last_used_device_data, key);
 }
 
 struct VkStruct
@@ -188,6 +177,63 @@ void DiveInterceptCmdDrawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCo
                                             firstIndex, vertexOffset, firstInstance);
 }
 
+void DiveInterceptCmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount,
+                          uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+    PFN_vkCmdDraw pfn = nullptr;
+
+    auto layer_data = GetDeviceLayerData(DataKey(commandBuffer));
+
+    pfn = layer_data->dispatch_table.CmdDraw;
+    return sDiveRuntimeLayer.CmdDraw(pfn, commandBuffer, vertexCount, instanceCount, firstVertex,
+                                     firstInstance);
+}
+
+void DiveInterceptCmdDrawIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer,
+                                  VkDeviceSize offset, uint32_t drawCount, uint32_t stride)
+{
+    PFN_vkCmdDrawIndirect pfn = nullptr;
+
+    auto layer_data = GetDeviceLayerData(DataKey(commandBuffer));
+
+    pfn = layer_data->dispatch_table.CmdDrawIndirect;
+    return sDiveRuntimeLayer.CmdDrawIndirect(pfn, commandBuffer, buffer, offset, drawCount, stride);
+}
+
+void DiveInterceptCmdDrawIndexedIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer,
+                                         VkDeviceSize offset, uint32_t drawCount, uint32_t stride)
+{
+    PFN_vkCmdDrawIndexedIndirect pfn = nullptr;
+
+    auto layer_data = GetDeviceLayerData(DataKey(commandBuffer));
+
+    pfn = layer_data->dispatch_table.CmdDrawIndexedIndirect;
+    return sDiveRuntimeLayer.CmdDrawIndexedIndirect(pfn, commandBuffer, buffer, offset, drawCount,
+                                                    stride);
+}
+
+void DiveInterceptCmdDispatch(VkCommandBuffer commandBuffer, uint32_t groupCountX,
+                              uint32_t groupCountY, uint32_t groupCountZ)
+{
+    PFN_vkCmdDispatch pfn = nullptr;
+
+    auto layer_data = GetDeviceLayerData(DataKey(commandBuffer));
+
+    pfn = layer_data->dispatch_table.CmdDispatch;
+    return sDiveRuntimeLayer.CmdDispatch(pfn, commandBuffer, groupCountX, groupCountY, groupCountZ);
+}
+
+void DiveInterceptCmdDispatchIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer,
+                                      VkDeviceSize offset)
+{
+    PFN_vkCmdDispatchIndirect pfn = nullptr;
+
+    auto layer_data = GetDeviceLayerData(DataKey(commandBuffer));
+
+    pfn = layer_data->dispatch_table.CmdDispatchIndirect;
+    return sDiveRuntimeLayer.CmdDispatchIndirect(pfn, commandBuffer, buffer, offset);
+}
+
 void DiveInterceptCmdResetQueryPool(VkCommandBuffer commandBuffer, VkQueryPool queryPool,
                                     uint32_t firstQuery, uint32_t queryCount)
 {
@@ -373,12 +419,32 @@ VkResult DiveInterceptCreateInstance(const VkInstanceCreateInfo* pCreateInfo,
     {
         std::lock_guard<std::mutex> lock(g_instance_mutex);
         auto key = (uintptr_t)(*(void**)(*pInstance));
-        g_instance_data[key] = std::move(id);
+        g_instance_data.Insert(key, std::move(id));
     }
 
     return result;
 }
 
+void DiveInterceptDestroyInstance(VkInstance instance, const VkAllocationCallbacks* pAllocator)
+{
+    if (instance == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    // The dispatch key is not readable anymore once the instance is destroyed
+    auto key = DataKey(instance);
+    auto layer_data = GetInstanceLayerData(key);
+    if (layer_data == nullptr)
+    {
+        return;
+    }
+    layer_data->dispatch_table.DestroyInstance(instance, pAllocator);
+
+    std::lock_guard<std::mutex> lock(g_instance_mutex);
+    g_instance_data.Erase(key);
+}
+
 VkResult DiveInterceptCreateDevice(VkPhysicalDevice gpu, const VkDeviceCreateInfo* pCreateInfo,
                                    const VkAllocationCallbacks* pAllocator, VkDevice* pDevice)
 {
@@ -388,6 +454,11 @@ VkResult DiveInterceptCreateDevice(VkPhysicalDevice gpu, const VkDeviceCreateInf
 
     // Get the instance data.
     auto instance_data = GetInstanceLayerData(DataKey(gpu));
+    if (instance_data == nullptr)
+    {
+        LOGE("vkCreateDevice called for an instance unknown to the layer!\n");
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
 
     // Get the proc addr pointers for this layer and update the chain for the next
     // layer.
@@ -433,7 +504,7 @@ VkResult DiveInterceptCreateDevice(VkPhysicalDevice gpu, const VkDeviceCreateInf
     {
         std::lock_guard<std::mutex> lock(g_device_mutex);
         auto key = (uintptr_t)(*(void**)(*pDevice));
-        g_device_data[key] = std::move(dd);
+        g_device_data.Insert(key, std::move(dd));
     }
 
     return result;
@@ -443,9 +514,19 @@ void DiveInterceptDestroyDevice(VkDevice device, const VkAllocationCallbacks* pA
 {
     PFN_vkDestroyDevice pfn = nullptr;
 
-    auto layer_data = GetDeviceLayerData(DataKey(device));
+    if (device == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    // The dispatch key is not readable anymore once the device is destroyed
+    auto key = DataKey(device);
+    auto layer_data = GetDeviceLayerData(key);
     pfn = layer_data->dispatch_table.DestroyDevice;
-    return sDiveRuntimeLayer.DestroyDevice(pfn, device, pAllocator);
+    sDiveRuntimeLayer.DestroyDevice(pfn, device, pAllocator);
+
+    std::lock_guard<std::mutex> lock(g_device_mutex);
+    g_device_data.Erase(key);
 }
 
 void DiveInterceptCmdInsertDebugUtilsLabel(VkCommandBuffer commandBuffer,
@@ -732,6 +813,14 @@ extern "C"
         if (0 == strcmp(func, "vkCreateImage")) return (PFN_vkVoidFunction)DiveInterceptCreateImage;
         if (0 == strcmp(func, "vkCmdDrawIndexed"))
             return (PFN_vkVoidFunction)DiveInterceptCmdDrawIndexed;
+        if (0 == strcmp(func, "vkCmdDraw")) return (PFN_vkVoidFunction)DiveInterceptCmdDraw;
+        if (0 == strcmp(func, "vkCmdDrawIndirect"))
+            return (PFN_vkVoidFunction)DiveInterceptCmdDrawIndirect;
+        if (0 == strcmp(func, "vkCmdDrawIndexedIndirect"))
+            return (PFN_vkVoidFunction)DiveInterceptCmdDrawIndexedIndirect;
+        if (0 == strcmp(func, "vkCmdDispatch")) return (PFN_vkVoidFunction)DiveInterceptCmdDispatch;
+        if (0 == strcmp(func, "vkCmdDispatchIndirect"))
+            return (PFN_vkVoidFunction)DiveInterceptCmdDispatchIndirect;
         if (0 == strcmp(func, "vkCmdResetQueryPool"))
             return (PFN_vkVoidFunction)DiveInterceptCmdResetQueryPool;
         if (0 == strcmp(func, "vkCmdWriteTimestamp"))
@@ -802,6 +891,8 @@ extern "C"
             return (PFN_vkVoidFunction)&DiveInterceptEnumerateInstanceLayerProperties;
         if (0 == strcmp(func, "vkCreateDevice"))
             return (PFN_vkVoidFunction)&DiveInterceptCreateDevice;
+        if (0 == strcmp(func, "vkDestroyInstance"))
+            return (PFN_vkVoidFunction)&DiveInterceptDestroyInstance;
         auto instance_data = GetInstanceLayerData(DataKey(inst));
         return instance_data->dispatch_table.pfn_get_instance_proc_addr(inst, func);
     }
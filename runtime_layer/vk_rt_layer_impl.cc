@@ -40,6 +40,10 @@ static bool sEnableDrawcallFilter = false;
 
 // For OpenXR Apps, this requires enabling the frame delimiter
 static bool sEnableGPUTiming = false;
+// Frames whose timestamps are read back later instead of waiting for the device every frame
+static uint32_t sGPUTimingFramesInFlight = 1;
+// Also times every draw and dispatch, only with 1 frame in flight
+static bool sEnableGPUDrawTiming = false;
 static bool sRemoveImageFlagFDMOffset = false;
 static bool sRemoveImageFlagSubSampled = false;
 static bool sDisableTimestamp = false;
@@ -129,7 +133,74 @@ void DiveRuntimeLayer::CmdDrawIndexed(PFN_vkCmdDrawIndexed pfn, VkCommandBuffer
         return;
     }
 
-    return pfn(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    BeginDrawTiming(commandBuffer);
+    pfn(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    EndDrawTiming(commandBuffer);
+}
+
+void DiveRuntimeLayer::CmdDraw(PFN_vkCmdDraw pfn, VkCommandBuffer commandBuffer,
+                               uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex,
+                               uint32_t firstInstance)
+{
+    BeginDrawTiming(commandBuffer);
+    pfn(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+    EndDrawTiming(commandBuffer);
+}
+
+void DiveRuntimeLayer::CmdDrawIndirect(PFN_vkCmdDrawIndirect pfn, VkCommandBuffer commandBuffer,
+                                       VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount,
+                                       uint32_t stride)
+{
+    BeginDrawTiming(commandBuffer);
+    pfn(commandBuffer, buffer, offset, drawCount, stride);
+    EndDrawTiming(commandBuffer);
+}
+
+void DiveRuntimeLayer::CmdDrawIndexedIndirect(PFN_vkCmdDrawIndexedIndirect pfn,
+                                              VkCommandBuffer commandBuffer, VkBuffer buffer,
+                                              VkDeviceSize offset, uint32_t drawCount,
+                                              uint32_t stride)
+{
+    BeginDrawTiming(commandBuffer);
+    pfn(commandBuffer, buffer, offset, drawCount, stride);
+    EndDrawTiming(commandBuffer);
+}
+
+void DiveRuntimeLayer::CmdDispatch(PFN_vkCmdDispatch pfn, VkCommandBuffer commandBuffer,
+                                   uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    BeginDrawTiming(commandBuffer);
+    pfn(commandBuffer, groupCountX, groupCountY, groupCountZ);
+    EndDrawTiming(commandBuffer);
+}
+
+void DiveRuntimeLayer::CmdDispatchIndirect(PFN_vkCmdDispatchIndirect pfn,
+                                           VkCommandBuffer commandBuffer, VkBuffer buffer,
+                                           VkDeviceSize offset)
+{
+    BeginDrawTiming(commandBuffer);
+    pfn(commandBuffer, buffer, offset);
+    EndDrawTiming(commandBuffer);
+}
+
+void DiveRuntimeLayer::BeginDrawTiming(VkCommandBuffer commandBuffer)
+{
+    Dive::GPUTime::GpuTimeStatus status =
+        m_gpu_time.OnCmdDrawBegin(commandBuffer, m_pfn_vkCmdWriteTimestamp);
+    if (!status.success)
+    {
+        LOGE("%s", status.message.c_str());
+    }
+}
+
+void DiveRuntimeLayer::EndDrawTiming(VkCommandBuffer commandBuffer)
+{
+    Dive::GPUTime::GpuTimeStatus status =
+        m_gpu_time.OnCmdDrawEnd(commandBuffer, m_pfn_vkCmdWriteTimestamp);
+    if (!status.success)
+    {
+        LOGE("%s", status.message.c_str());
+    }
 }
 
 void DiveRuntimeLayer::CmdResetQueryPool(PFN_vkCmdResetQueryPool pfn, VkCommandBuffer commandBuffer,
@@ -289,6 +360,8 @@ VkResult DiveRuntimeLayer::CreateDevice(PFN_vkGetDeviceProcAddr pa, PFN_vkCreate
     }
 
     m_gpu_time.SetEnable(sEnableGPUTiming);
+    m_gpu_time.SetFramesInFlight(sGPUTimingFramesInFlight);
+    m_gpu_time.SetDrawTimingEnable(sEnableGPUDrawTiming);
 
     // Initialize all vk func pointers
     PFN_vkCreateQueryPool CreateQueryPool =
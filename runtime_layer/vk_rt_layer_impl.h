@@ -47,6 +47,22 @@ class DiveRuntimeLayer
                         uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
                         int32_t vertexOffset, uint32_t firstInstance);
 
+    void CmdDraw(PFN_vkCmdDraw pfn, VkCommandBuffer commandBuffer, uint32_t vertexCount,
+                 uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
+
+    void CmdDrawIndirect(PFN_vkCmdDrawIndirect pfn, VkCommandBuffer commandBuffer, VkBuffer buffer,
+                         VkDeviceSize offset, uint32_t drawCount, uint32_t stride);
+
+    void CmdDrawIndexedIndirect(PFN_vkCmdDrawIndexedIndirect pfn, VkCommandBuffer commandBuffer,
+                                VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount,
+                                uint32_t stride);
+
+    void CmdDispatch(PFN_vkCmdDispatch pfn, VkCommandBuffer commandBuffer, uint32_t groupCountX,
+                     uint32_t groupCountY, uint32_t groupCountZ);
+
+    void CmdDispatchIndirect(PFN_vkCmdDispatchIndirect pfn, VkCommandBuffer commandBuffer,
+                             VkBuffer buffer, VkDeviceSize offset);
+
     void CmdResetQueryPool(PFN_vkCmdResetQueryPool pfn, VkCommandBuffer commandBuffer,
                            VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount);
 
@@ -119,6 +135,10 @@ class DiveRuntimeLayer
                            const VkSubpassEndInfo* pSubpassEndInfo);
 
  private:
+    // Wrap a draw or dispatch with GPU timestamps, when draw timing is enabled
+    void BeginDrawTiming(VkCommandBuffer commandBuffer);
+    void EndDrawTiming(VkCommandBuffer commandBuffer);
+
     Dive::GPUTime m_gpu_time;
     PFN_vkGetDeviceProcAddr m_device_proc_addr = nullptr;
 
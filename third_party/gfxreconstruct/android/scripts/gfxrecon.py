@@ -148,6 +148,12 @@ def CreateReplayParser():
 
     # GOOGLE: [enable-gpu-time] Usage message
     parser.add_argument('--enable-gpu-time', action='store_true', default=False, help='Enable GPU Time measurement on Replay.')
+
+    # GOOGLE: [gpu-time-per-draw] Usage message
+    parser.add_argument('--gpu-time-per-draw', action='store_true', default=False, help='Also measure the GPU time of every draw and dispatch. Only used with --enable-gpu-time.')
+
+    # GOOGLE: [gpu-time-streaming-metrics] Usage message
+    parser.add_argument('--gpu-time-streaming-metrics', action='store_true', default=False, help='Keep running statistics of the GPU time instead of the samples of the most recent frames, for long replays. Only used with --enable-gpu-time.')
     
     return parser
 
@@ -336,6 +342,14 @@ def MakeExtrasString(args):
     if args.enable_gpu_time:
         arg_list.append('--enable-gpu-time')
 
+    # GOOGLE: [gpu-time-streaming-metrics] Translating flags for the replay library
+    if args.gpu_time_streaming_metrics:
+        arg_list.append('--gpu-time-streaming-metrics')
+
+    # GOOGLE: [gpu-time-per-draw] Translating flags for the replay library
+    if args.gpu_time_per_draw:
+        arg_list.append('--gpu-time-per-draw')
+
     if args.file:
         arg_list.append(args.file)
     elif not args.version:
@@ -171,6 +171,12 @@ struct VulkanReplayOptions : public ReplayOptions
 
     // GOOGLE: [enable-gpu-time]
     bool enable_gpu_time;
+
+    // GOOGLE: [gpu-time-streaming-metrics]
+    bool gpu_time_streaming_metrics{ false };
+
+    // GOOGLE: [gpu-time-per-draw]
+    bool gpu_time_per_draw{ false };
 };
 
 GFXRECON_END_NAMESPACE(decode)
@@ -33,7 +33,7 @@ class DiveFunctionData
     const std::string& GetFunctionName() const;
     uint32_t GetCmdBufferIndex() const;
     uint64_t GetBlockIndex() const;
-    const nlohmann::ordered_json GetArgs() const;
+    const nlohmann::ordered_json& GetArgs() const;
 private:
     nlohmann::ordered_json m_args;
     uint64_t m_block_index;
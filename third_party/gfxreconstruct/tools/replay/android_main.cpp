@@ -196,6 +196,14 @@ void android_main(struct android_app* app)
                 {
                     vulkan_replay_consumer.SetEnableGPUTime(replay_options.enable_gpu_time);
                 }
+                if (replay_options.gpu_time_per_draw)
+                {
+                    vulkan_replay_consumer.SetEnableGPUDrawTiming(true);
+                }
+                if (replay_options.gpu_time_streaming_metrics)
+                {
+                    vulkan_replay_consumer.SetGPUTimeMetricsMode(Dive::GPUTime::MetricsMode::kStreaming);
+                }
 
                 if (replay_options.capture)
                 {
@@ -28,6 +28,8 @@
 
 // GOOGLE: [single-frame-looping] Adding flags to usage message
 // GOOGLE: [enable-gpu-time] Adding flags to usage message
+// GOOGLE: [gpu-time-streaming-metrics] Adding flags to usage message
+// GOOGLE: [gpu-time-per-draw] Adding flags to usage message
 const char kOptions[] =
     "-h|--help,--version,--log-debugview,--no-debug-popup,--paused,--sync,--sfa|--skip-failed-allocations,--opcd|--"
     "omit-pipeline-cache-data,--remove-unsupported,--validate,--debug-device-lost,--create-dummy-allocations,--"
@@ -36,7 +38,8 @@ const char kOptions[] =
     "indices,--dcp,--discard-cached-psos,--use-colorspace-fallback,--use-cached-psos,--dx12-override-object-names,--"
     "dx12-ags-inject-markers,--offscreen-swapchain-frame-boundary,--wait-before-present,--dump-resources-before-draw,"
     "--dump-resources-modifiable-state-only,--pbi-all,--preload-measurement-range,--add-new-pipeline-caches,--"
-    "screenshot-ignore-FrameBoundaryANDROID,--deduplicate-device,--log-timestamps,--capture,--enable-gpu-time";
+    "screenshot-ignore-FrameBoundaryANDROID,--deduplicate-device,--log-timestamps,--capture,--enable-gpu-time,--gpu-time-"
+    "streaming-metrics,--gpu-time-per-draw";
 const char kArguments[] =
     "--log-level,--log-file,--cpu-mask,--gpu,--gpu-group,--pause-frame,--wsi,--surface-index,-m|--memory-translation,"
     "--replace-shaders,--screenshots,--screenshot-interval,--denied-messages,--allowed-messages,--screenshot-format,--"
@@ -94,6 +97,10 @@ static void PrintUsage(const char* exe_name)
     GFXRECON_WRITE_CONSOLE("\t\t\t[--loop-single-frame-count <n>]");
     // GOOGLE: [enable-gpu-time] Usage message
     GFXRECON_WRITE_CONSOLE("\t\t\t[--enable-gpu-time]");
+    // GOOGLE: [gpu-time-streaming-metrics] Usage message
+    GFXRECON_WRITE_CONSOLE("\t\t\t[--gpu-time-streaming-metrics]");
+    // GOOGLE: [gpu-time-per-draw] Usage message
+    GFXRECON_WRITE_CONSOLE("\t\t\t[--gpu-time-per-draw]");
 
 #if defined(WIN32)
     GFXRECON_WRITE_CONSOLE("\t\t\t[--dump-resources <submit-index,command-index,drawcall-index>]");
@@ -199,6 +206,15 @@ static void PrintUsage(const char* exe_name)
     // GOOGLE: [enable-gpu-time] Usage message details
     GFXRECON_WRITE_CONSOLE("  --enable-gpu-time");
     GFXRECON_WRITE_CONSOLE("          \t\tWhen enabled, gpu time measurement will be enabled for replay.");
+    // GOOGLE: [gpu-time-streaming-metrics] Usage message details
+    GFXRECON_WRITE_CONSOLE("  --gpu-time-streaming-metrics");
+    GFXRECON_WRITE_CONSOLE("          \t\tKeep running statistics of the gpu time instead of the samples of ");
+    GFXRECON_WRITE_CONSOLE("          \t\tthe most recent frames, so memory use does not grow with long ");
+    GFXRECON_WRITE_CONSOLE("          \t\treplays. Medians are estimated. Only used with --enable-gpu-time.");
+    // GOOGLE: [gpu-time-per-draw] Usage message details
+    GFXRECON_WRITE_CONSOLE("  --gpu-time-per-draw");
+    GFXRECON_WRITE_CONSOLE("          \t\tAlso measure the gpu time of every draw and dispatch. Only used ");
+    GFXRECON_WRITE_CONSOLE("          \t\twith --enable-gpu-time.");
 #if defined(WIN32)
     GFXRECON_WRITE_CONSOLE("")
     GFXRECON_WRITE_CONSOLE("Windows only:")
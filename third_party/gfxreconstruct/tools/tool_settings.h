@@ -168,6 +168,12 @@ const char kLoopSingleFrameCount[] = "--loop-single-frame-count";
 // GOOGLE: [enable-gpu-time]
 const char kEnableGPUTime[] = "--enable-gpu-time";
 
+// GOOGLE: [gpu-time-streaming-metrics]
+const char kGPUTimeStreamingMetrics[] = "--gpu-time-streaming-metrics";
+
+// GOOGLE: [gpu-time-per-draw]
+const char kGPUTimePerDraw[] = "--gpu-time-per-draw";
+
 enum class WsiPlatform
 {
     kAuto,
@@ -1256,6 +1262,12 @@ GetVulkanReplayOptions(const gfxrecon::util::ArgumentParser&           arg_parse
         replay_options.enable_gpu_time = true;
     }
 
+    // GOOGLE: [gpu-time-streaming-metrics] Parse additional parameters
+    replay_options.gpu_time_streaming_metrics = arg_parser.IsOptionSet(kGPUTimeStreamingMetrics);
+
+    // GOOGLE: [gpu-time-per-draw] Parse additional parameters
+    replay_options.gpu_time_per_draw = arg_parser.IsOptionSet(kGPUTimePerDraw);
+
     // GOOGLE: [single-frame-looping] Parse additional parameters
     replay_options.loop_single_frame_count = GetLoopSingleFrameCount(arg_parser);
     if ((replay_options.preload_measurement_range) && (replay_options.loop_single_frame_count.has_value()))
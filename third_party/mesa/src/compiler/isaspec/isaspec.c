@@ -35,6 +35,16 @@ isa_print(struct isa_print_state *state, const char *fmt, ...)
 	va_list args;
 	int ret;
 
+	// GOOGLE: without output, only keep the column up to date for the alignment of fields.
+	if (!state->out) {
+		va_start(args, fmt);
+		ret = vsnprintf(NULL, 0, fmt, args);
+		va_end(args);
+		if (ret > 0)
+			state->line_column += ret;
+		return;
+	}
+
 	va_start(args, fmt);
 	ret = vasprintf(&buffer, fmt, args);
 	va_end(args);
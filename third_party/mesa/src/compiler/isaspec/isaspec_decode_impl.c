@@ -722,7 +722,8 @@ display(struct decode_scope *scope)
 
 			p = e;
 		} else {
-			fputc(*p, scope->state->print.out);
+			if (scope->state->print.out) // GOOGLE: see isa_print
+				fputc(*p, scope->state->print.out);
 			scope->state->print.line_column++;
 		}
 		p++;
@@ -49,6 +49,18 @@ int disasm_a3xx_stat_with_debug(uint32_t *dwords, int sizedwords,
                                 int level, FILE *out, unsigned gpu_id,
                                 struct shader_stats *stats, enum debug_t debug);
 
+// GOOGLE: called before each line of the disassembly is written, with the index and the raw dwords
+// of the instruction the line belongs to (an instruction can have extra lines, eg. branch labels),
+// and once more after the last instruction with dwords NULL, before the stats are written.
+typedef void (*disasm_instr_cb_t)(void *cb_data, unsigned n, const uint32_t *dwords);
+
+// GOOGLE: disasm_a3xx_stat_with_debug for callers that collect the instructions through instr_cb
+// rather than parsing the text back. When out is NULL no text is formatted, and neither the
+// branch labels nor the debug output are computed, which only leaves the stats.
+int disasm_a3xx_stat_with_cb(uint32_t *dwords, int sizedwords, int level, FILE *out,
+                             unsigned gpu_id, struct shader_stats *stats, enum debug_t debug,
+                             disasm_instr_cb_t instr_cb, void *cb_data);
+
 void disasm_a2xx_set_debug(enum debug_t debug);
 void disasm_a3xx_set_debug(enum debug_t debug);
 
@@ -96,6 +96,10 @@ struct disasm_ctx {
 
    struct shader_stats *stats;
    enum debug_t debug; // GOOGLE: add debug flag to current context
+
+   // GOOGLE: see disasm_a3xx_stat_with_cb
+   disasm_instr_cb_t instr_cb;
+   void *cb_data;
 };
 
 static void
@@ -598,6 +602,9 @@ disasm_instr_cb(void *d, unsigned n, void *instr)
 
    ctx->cur_opc_cat = opc_cat;
 
+   if (ctx->instr_cb) // GOOGLE: see disasm_a3xx_stat_with_cb
+      ctx->instr_cb(ctx->cb_data, n, dwords);
+
    if (ctx->debug & PRINT_RAW) { // GOOGLE: use debug flag from current context
       fprintf(ctx->out, "%s:%d:%04d:%04d[%08xx_%08xx] ", levels[ctx->level],
               opc_cat, n, ctx->extra_cycles + n, dwords[1], dwords[0]);
@@ -615,13 +622,22 @@ disasm_a3xx_stat(uint32_t *dwords, int sizedwords, int level, FILE *out,
 int disasm_a3xx_stat_with_debug(uint32_t *dwords, int sizedwords,
                                 int level, FILE *out, unsigned gpu_id,
                                 struct shader_stats *stats, enum debug_t debug) {
+   return disasm_a3xx_stat_with_cb(dwords, sizedwords, level, out, gpu_id, stats, debug,
+                                   NULL, NULL);
+}
+
+// GOOGLE: see disasm.h
+int disasm_a3xx_stat_with_cb(uint32_t *dwords, int sizedwords, int level, FILE *out,
+                             unsigned gpu_id, struct shader_stats *stats, enum debug_t debug,
+                             disasm_instr_cb_t instr_cb, void *cb_data) {
 
    struct isa_decode_options decode_options = {
       .gpu_id = gpu_id,
       .show_errors = true,
       // GOOGLE: bump this value from 5 to 50 to show the full shaders
       .max_errors = 50,
-      .branch_labels = true,
+      // GOOGLE: the labels are only printed, skip their decoding prepass without text
+      .branch_labels = out != NULL,
       .field_cb = disasm_field_cb,
       .pre_instr_cb = disasm_instr_cb,
    };
@@ -631,7 +647,9 @@ int disasm_a3xx_stat_with_debug(uint32_t *dwords, int sizedwords,
       .options = &decode_options,
       .stats = stats,
       .cur_n = -1,
-      .debug = debug, // GOOGLE: add debug flag to current context
+      .debug = out ? debug : 0, // GOOGLE: add debug flag to current context
+      .instr_cb = instr_cb,
+      .cb_data = cb_data,
    };
 
    memset(&ctx.full_aliases, 0, sizeof(ctx.full_aliases));
@@ -644,6 +662,9 @@ int disasm_a3xx_stat_with_debug(uint32_t *dwords, int sizedwords,
 
    disasm_handle_last(&ctx);
 
+   if (instr_cb)
+      instr_cb(cb_data, ctx.cur_n + 1, NULL);
+
    if (ctx.debug & PRINT_STATS) // GOOGLE: use debug flag from current context
       print_stats(&ctx);
 
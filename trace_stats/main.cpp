@@ -31,22 +31,27 @@ int main(int argc, char** argv)
     Pm4InfoInit();
 
     // Handle args
-    if ((argc != 2) && (argc != 3))
+    if ((argc < 2) || (argc > 4))
     {
         std::cout << "You need to call: lrz_validator <input_file_name.rd> "
-                     "<output_details_file_name.txt>(optional)";
+                     "<output_details_file_name.txt>(optional) <shader_cache_dir>(optional)";
         return 0;
     }
     char* input_file_name = argv[1];
 
     std::string output_file_name = "";
-    if (argc == 3)
+    if (argc >= 3)
     {
         output_file_name = argv[2];
     }
 
     // Load capture
     std::unique_ptr<Dive::DataCore> data_core = std::make_unique<Dive::DataCore>();
+    if (argc == 4)
+    {
+        data_core->SetShaderCacheDirectory(argv[3]);
+    }
+    data_core->SetUseCaptureIndex(true);
     Dive::CaptureData::LoadResult load_res = data_core->LoadPm4CaptureData(input_file_name);
     if (load_res != Dive::CaptureData::LoadResult::kSuccess)
     {
@@ -55,8 +60,8 @@ int main(int argc, char** argv)
     }
     std::cout << "Capture file \"" << input_file_name << "\" is loaded!\n";
 
-    // Create meta data
-    if (!data_core->CreatePm4MetaData())
+    // Create meta data, or load it from the capture index of an earlier run
+    if (!data_core->ParsePm4CaptureData())
     {
         std::cout << "Failed to create meta data!";
         return 0;
@@ -80,5 +85,9 @@ int main(int argc, char** argv)
     trace_stats.GatherTraceStats(Dive::Context::Background(), meta_data, capture_stats);
     trace_stats.PrintTraceStats(capture_stats, *ostream);
 
+    const Dive::ShaderCache& shader_cache = data_core->GetShaderCache();
+    std::cout << "Shader cache: " << shader_cache.GetHitCount() << " hits, "
+              << shader_cache.GetMissCount() << " misses\n";
+
     return 1;
 }
@@ -175,14 +175,23 @@ AnalyzeDialog::AnalyzeDialog(ApplicationController& controller,
         frame_count_layout->addWidget(frame_count_label);
         frame_count_layout->addWidget(frame_count_box);
 
+        auto per_draw_box = new QCheckBox();
+        per_draw_box->setText(tr("Time Individual Draws and Dispatches"));
+        per_draw_box->setCheckState(Qt::Unchecked);
+
+        auto gpu_time_layout = new QVBoxLayout();
+        gpu_time_layout->addLayout(frame_count_layout);
+        gpu_time_layout->addWidget(per_draw_box);
+
         auto group_box = new QGroupBox();
         group_box->setTitle("Enable GPU Time");
         group_box->setCheckable(true);
         group_box->setChecked(false);
-        group_box->setLayout(frame_count_layout);
+        group_box->setLayout(gpu_time_layout);
 
         m_gpu_time_replay_box = group_box;
         m_gpu_time_replay_frame_count = frame_count_box;
+        m_gpu_time_replay_per_draw_box = per_draw_box;
     }
 
     // Enable RenderDoc capture
@@ -546,6 +555,10 @@ absl::Status AnalyzeDialog::GpuTimeReplay(Dive::DeviceManager& device_manager,
 
     // Variant-specific config
     replay_settings.loop_single_frame_count = m_gpu_time_replay_frame_count->value();
+    if (m_gpu_time_replay_per_draw_box->isChecked())
+    {
+        replay_settings.replay_flags_str = "--gpu-time-per-draw";
+    }
 
     return device_manager.RunReplayApk(replay_settings);
 }
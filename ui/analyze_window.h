@@ -179,6 +179,7 @@ class AnalyzeDialog : public DeviceDialog
     QCheckBox* m_dump_pm4_box = nullptr;
     QCheckBox* m_perf_counter_box = nullptr;
     QGroupBox* m_gpu_time_replay_box = nullptr;
+    QCheckBox* m_gpu_time_replay_per_draw_box = nullptr;
     QCheckBox* m_renderdoc_capture_box = nullptr;
 
     QSpinBox* m_gpu_time_replay_frame_count = nullptr;
@@ -111,8 +111,9 @@ void CaptureWorker::run()
     auto progress = [this, total_size](size_t size) {
         emit DownloadedSize(static_cast<qlonglong>(size), total_size);
     };
-    status = client.DownloadFileFromServer(*capture_file_path, host_download_path.generic_string(),
-                                           progress);
+    status = client.DownloadFileFromServerParallel(*capture_file_path,
+                                                   host_download_path.generic_string(),
+                                                   Network::ParallelDownloadOptions(), progress);
     if (status.ok())
     {
         qDebug() << "Capture saved at "
@@ -96,7 +96,7 @@ QVariant CommandModel::data(const QModelIndex& index, int role) const
     }
 
     // 1st column
-    return QString(m_command_hierarchy.GetNodeDesc(node_index));
+    return QString::fromStdString(m_command_hierarchy.GetNodeDesc(node_index));
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -267,8 +267,8 @@ void DiveTreeViewDelegate::paint(QPainter* painter, const QStyleOptionViewItem&
         QStyleOptionViewItem options = option;
         initStyleOption(&options, index);
 
-        options.text =
-            QString(m_dive_tree_view_ptr->GetCommandHierarchy().GetNodeDesc(source_node_index));
+        options.text = QString::fromStdString(
+            m_dive_tree_view_ptr->GetCommandHierarchy().GetNodeDesc(source_node_index));
 
         // Call to the base class function is needed to handle hover effects correctly
         if (options.state & QStyle::State_MouseOver || options.state & QStyle::State_Selected)
@@ -21,10 +21,14 @@
 #include <QHeaderView>
 #include <QLineEdit>
 #include <QPushButton>
+#include <QStandardItemModel>
+#include <QTreeView>
 #include <QVBoxLayout>
 #include <iostream>
 #include <string>
 
+#include "absl/status/statusor.h"
+#include "dive_core/data_core.h"
 #include "dive_core/gfxr_vulkan_command_hierarchy.h"
 #include "gfxr_vulkan_command_arguments_filter_proxy_model.h"
 #include "gfxr_vulkan_command_filter_proxy_model.h"
@@ -32,22 +36,100 @@
 #include "search_bar.h"
 #include "shortcuts.h"
 
+namespace
+{
+
+QStandardItem* NewArgItem(const std::string& desc)
+{
+    QStandardItem* item = new QStandardItem(QString::fromStdString(desc));
+    item->setEditable(false);
+    return item;
+}
+
+// Same layout as the arg nodes, see GfxrVulkanCommandHierarchyCreator::GetArgs()
+void AddArgItems(const nlohmann::ordered_json& args, QStandardItem* parent)
+{
+    if (args.is_object())
+    {
+        for (const auto& [key, val] : args.items())
+        {
+            if (val.is_object())
+            {
+                QStandardItem* object_item = NewArgItem(key);
+                parent->appendRow(object_item);
+                AddArgItems(val, object_item);
+            }
+            else if (val.is_array())
+            {
+                QStandardItem* array_item = NewArgItem(key);
+                parent->appendRow(array_item);
+                for (size_t i = 0; i < val.size(); ++i)
+                {
+                    const auto& element = val[i];
+                    if (element.is_object())
+                    {
+                        AddArgItems(element, array_item);
+                    }
+                    else if (element.is_array())
+                    {
+                        QStandardItem* nested_array_item =
+                            NewArgItem("element_" + std::to_string(i));
+                        array_item->appendRow(nested_array_item);
+                        AddArgItems(element, nested_array_item);
+                    }
+                    else
+                    {
+                        array_item->appendRow(NewArgItem(element.dump()));
+                    }
+                }
+            }
+            else
+            {
+                parent->appendRow(NewArgItem(key + ":" + val.dump()));
+            }
+        }
+    }
+    else if (args.is_array())
+    {
+        for (const auto& element : args)
+        {
+            if (element.is_object() || element.is_array())
+            {
+                AddArgItems(element, parent);
+            }
+            else
+            {
+                parent->appendRow(NewArgItem(element.dump()));
+            }
+        }
+    }
+}
+
+}  // namespace
+
 // =================================================================================================
 // GfxrVulkanCommandArgumentsTabView
 // =================================================================================================
 GfxrVulkanCommandArgumentsTabView::GfxrVulkanCommandArgumentsTabView(
-    const Dive::CommandHierarchy& vulkan_command_hierarchy,
+    const Dive::DataCore& data_core, const Dive::CommandHierarchy& vulkan_command_hierarchy,
     GfxrVulkanCommandArgumentsFilterProxyModel* proxy_model,
     GfxrVulkanCommandModel* command_hierarchy_model, QWidget* parent)
     : m_vulkan_command_hierarchy(vulkan_command_hierarchy),
       m_arg_proxy_model(proxy_model),
-      m_command_hierarchy_model(command_hierarchy_model)
+      m_command_hierarchy_model(command_hierarchy_model),
+      m_data_core(data_core)
 {
     m_command_hierarchy_view = new DiveTreeView(m_vulkan_command_hierarchy);
 
     m_arg_proxy_model->setSourceModel(m_command_hierarchy_model);
     m_command_hierarchy_view->setModel(m_arg_proxy_model);
 
+    m_lazy_args_model = new QStandardItemModel(this);
+    m_lazy_args_view = new QTreeView();
+    m_lazy_args_view->setHeaderHidden(true);
+    m_lazy_args_view->setModel(m_lazy_args_model);
+    m_lazy_args_view->hide();
+
     m_search_trigger_button = new QPushButton;
     m_search_trigger_button->setObjectName(kGfxrVulkanCommandArgumentsSearchButtonName);
     m_search_trigger_button->setIcon(QIcon(":/images/search.png"));
@@ -64,6 +146,7 @@ GfxrVulkanCommandArgumentsTabView::GfxrVulkanCommandArgumentsTabView(
     main_layout->addLayout(options_layout);
     main_layout->addWidget(m_search_bar);
     main_layout->addWidget(m_command_hierarchy_view);
+    main_layout->addWidget(m_lazy_args_view);
     setLayout(main_layout);
     m_search_bar->setView(m_command_hierarchy_view);
 
@@ -83,6 +166,8 @@ void GfxrVulkanCommandArgumentsTabView::SetTopologyToView(const Dive::Topology*
 void GfxrVulkanCommandArgumentsTabView::ResetModel()
 {
     m_command_hierarchy_model->Reset();
+    m_lazy_args_model->clear();
+    ShowLazyArgsView(false);
     // Reset search results
     m_command_hierarchy_view->reset();
     if (m_search_bar->isVisible())
@@ -96,6 +181,8 @@ void GfxrVulkanCommandArgumentsTabView::OnSelectionChanged(const QModelIndex& in
 {
     if (!index.isValid())
     {
+        m_lazy_args_model->clear();
+        ShowLazyArgsView(false);
         m_arg_proxy_model->SetTargetParentSourceIndex(QModelIndex());
         return;
     }
@@ -116,6 +203,31 @@ void GfxrVulkanCommandArgumentsTabView::OnSelectionChanged(const QModelIndex& in
         }
     }
 
+    // Commands without arg nodes have their args decoded from the capture file instead.
+    absl::StatusOr<nlohmann::ordered_json> lazy_args =
+        m_data_core.GetGfxrCommandArgs(source_index.internalId());
+    if (!absl::IsNotFound(lazy_args.status()))
+    {
+        m_lazy_args_model->clear();
+        if (lazy_args.ok())
+        {
+            AddArgItems(*lazy_args, m_lazy_args_model->invisibleRootItem());
+        }
+        else
+        {
+            m_lazy_args_model->appendRow(
+                NewArgItem(std::string(lazy_args.status().message())));
+        }
+        ShowLazyArgsView(true);
+        if (m_search_bar->isVisible())
+        {
+            m_search_bar->clearSearch();
+        }
+        m_lazy_args_view->expandAll();
+        return;
+    }
+    ShowLazyArgsView(false);
+
     // Always use the source_index, regardless of whether a proxy was involved.
     m_arg_proxy_model->SetTargetParentSourceIndex(source_index);
 
@@ -167,9 +279,92 @@ void GfxrVulkanCommandArgumentsTabView::OnSearchBarVisibilityChange(bool isHidde
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+void GfxrVulkanCommandArgumentsTabView::ShowLazyArgsView(bool show)
+{
+    if (show == m_showing_lazy_args)
+    {
+        return;
+    }
+
+    // The search bar stays connected to the view it was opened on
+    bool searching = m_search_bar->isVisible();
+    if (searching)
+    {
+        DisconnectSearchBar();
+    }
+    m_showing_lazy_args = show;
+    m_command_hierarchy_view->setVisible(!show);
+    m_lazy_args_view->setVisible(show);
+    m_search_bar->setView(show ? static_cast<QAbstractItemView*>(m_lazy_args_view) :
+                                 m_command_hierarchy_view);
+    if (searching)
+    {
+        ConnectSearchBar();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void GfxrVulkanCommandArgumentsTabView::OnLazyArgsSearch(const QString& search_text)
+{
+    m_lazy_args_search_indexes.clear();
+    m_lazy_args_search_pos = 0;
+    if (!search_text.isEmpty())
+    {
+        m_lazy_args_search_indexes = m_lazy_args_model->match(
+            m_lazy_args_model->index(0, 0), Qt::DisplayRole, QVariant::fromValue(search_text), -1,
+            Qt::MatchContains | Qt::MatchRecursive | Qt::MatchWrap);
+    }
+    SelectLazyArgsSearchResult();
+}
+
+//--------------------------------------------------------------------------------------------------
+void GfxrVulkanCommandArgumentsTabView::OnLazyArgsNextSearch()
+{
+    if (m_lazy_args_search_indexes.isEmpty()) return;
+
+    m_lazy_args_search_pos = (m_lazy_args_search_pos + 1) % m_lazy_args_search_indexes.size();
+    SelectLazyArgsSearchResult();
+}
+
+//--------------------------------------------------------------------------------------------------
+void GfxrVulkanCommandArgumentsTabView::OnLazyArgsPrevSearch()
+{
+    if (m_lazy_args_search_indexes.isEmpty()) return;
+
+    int count = m_lazy_args_search_indexes.size();
+    m_lazy_args_search_pos = (m_lazy_args_search_pos + count - 1) % count;
+    SelectLazyArgsSearchResult();
+}
+
+//--------------------------------------------------------------------------------------------------
+void GfxrVulkanCommandArgumentsTabView::SelectLazyArgsSearchResult()
+{
+    if (m_lazy_args_search_indexes.isEmpty())
+    {
+        m_search_bar->updateSearchResults(0, 0);
+        return;
+    }
+
+    const QModelIndex& index = m_lazy_args_search_indexes[m_lazy_args_search_pos];
+    m_lazy_args_view->setCurrentIndex(index);
+    m_lazy_args_view->scrollTo(index);
+    m_search_bar->updateSearchResults(m_lazy_args_search_pos, m_lazy_args_search_indexes.size());
+}
+
 //--------------------------------------------------------------------------------------------------
 void GfxrVulkanCommandArgumentsTabView::ConnectSearchBar()
 {
+    if (m_showing_lazy_args)
+    {
+        QObject::connect(m_search_bar, &SearchBar::new_search, this,
+                         &GfxrVulkanCommandArgumentsTabView::OnLazyArgsSearch);
+        QObject::connect(m_search_bar, &SearchBar::next_search, this,
+                         &GfxrVulkanCommandArgumentsTabView::OnLazyArgsNextSearch);
+        QObject::connect(m_search_bar, &SearchBar::prev_search, this,
+                         &GfxrVulkanCommandArgumentsTabView::OnLazyArgsPrevSearch);
+        return;
+    }
     QObject::connect(m_search_bar, SIGNAL(new_search(const QString&)), m_command_hierarchy_view,
                      SLOT(searchNodeByText(const QString&)));
     QObject::connect(m_search_bar, &SearchBar::next_search, m_command_hierarchy_view,
@@ -183,6 +378,16 @@ void GfxrVulkanCommandArgumentsTabView::ConnectSearchBar()
 //--------------------------------------------------------------------------------------------------
 void GfxrVulkanCommandArgumentsTabView::DisconnectSearchBar()
 {
+    if (m_showing_lazy_args)
+    {
+        QObject::disconnect(m_search_bar, &SearchBar::new_search, this,
+                            &GfxrVulkanCommandArgumentsTabView::OnLazyArgsSearch);
+        QObject::disconnect(m_search_bar, &SearchBar::next_search, this,
+                            &GfxrVulkanCommandArgumentsTabView::OnLazyArgsNextSearch);
+        QObject::disconnect(m_search_bar, &SearchBar::prev_search, this,
+                            &GfxrVulkanCommandArgumentsTabView::OnLazyArgsPrevSearch);
+        return;
+    }
     QObject::disconnect(m_search_bar, SIGNAL(new_search(const QString&)), m_command_hierarchy_view,
                         SLOT(searchNodeByText(const QString&)));
     QObject::disconnect(m_search_bar, &SearchBar::next_search, m_command_hierarchy_view,
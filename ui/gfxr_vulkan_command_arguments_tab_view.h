@@ -22,6 +22,8 @@
 class QGroupBox;
 class QLineEdit;
 class QPushButton;
+class QStandardItemModel;
+class QTreeView;
 class SearchBar;
 class GfxrVulkanCommandFilterProxyModel;
 class GfxrVulkanCommandArgumentsFilterProxyModel;
@@ -30,6 +32,7 @@ class GfxrVulkanCommandModel;
 namespace Dive
 {
 class CommandHierarchy;
+class DataCore;
 class Topology;
 };  // namespace Dive
 
@@ -39,7 +42,8 @@ class GfxrVulkanCommandArgumentsTabView : public QFrame
     Q_OBJECT
 
  public:
-    GfxrVulkanCommandArgumentsTabView(const Dive::CommandHierarchy& vulkan_command_hierarchy,
+    GfxrVulkanCommandArgumentsTabView(const Dive::DataCore& data_core,
+                                      const Dive::CommandHierarchy& vulkan_command_hierarchy,
                                       GfxrVulkanCommandArgumentsFilterProxyModel* proxy_model,
                                       GfxrVulkanCommandModel* command_hierarchy_model,
                                       QWidget* parent = nullptr);
@@ -54,6 +58,9 @@ class GfxrVulkanCommandArgumentsTabView : public QFrame
     void OnSearchBarVisibilityChange(bool isHidden);
     void ConnectSearchBar();
     void DisconnectSearchBar();
+    void OnLazyArgsSearch(const QString& search_text);
+    void OnLazyArgsNextSearch();
+    void OnLazyArgsPrevSearch();
 
  signals:
     // Update property panel for node information.
@@ -61,6 +68,10 @@ class GfxrVulkanCommandArgumentsTabView : public QFrame
     void HideOtherSearchBars();
 
  private:
+    // Switches between the arg nodes of the command hierarchy and the lazily loaded args
+    void ShowLazyArgsView(bool show);
+    void SelectLazyArgsSearchResult();
+
     DiveTreeView* m_command_hierarchy_view;
     QPushButton* m_search_trigger_button;
     SearchBar* m_search_bar = nullptr;
@@ -68,4 +79,13 @@ class GfxrVulkanCommandArgumentsTabView : public QFrame
     const Dive::CommandHierarchy& m_vulkan_command_hierarchy;
     GfxrVulkanCommandArgumentsFilterProxyModel* m_arg_proxy_model;
     GfxrVulkanCommandModel* m_command_hierarchy_model;
+
+    // Shows the args of the selected command when they have no arg nodes, because they are
+    // loaded lazily. See Dive::DataCore::SetLazyGfxrCommandArgs
+    const Dive::DataCore& m_data_core;
+    QTreeView* m_lazy_args_view = nullptr;
+    QStandardItemModel* m_lazy_args_model = nullptr;
+    bool m_showing_lazy_args = false;
+    QModelIndexList m_lazy_args_search_indexes;
+    int m_lazy_args_search_pos = 0;
 };
@@ -68,7 +68,7 @@ QVariant GfxrVulkanCommandModel::data(const QModelIndex& index, int role) const
     if (!index.isValid()) return QVariant();
 
     uint64_t node_index = index.internalId();
-    QString full_node_desc = QString(m_command_hierarchy.GetNodeDesc(node_index));
+    QString full_node_desc = QString::fromStdString(m_command_hierarchy.GetNodeDesc(node_index));
     QString command_name = full_node_desc;
 
     int pos_colon = full_node_desc.indexOf(':');
@@ -35,6 +35,9 @@ class GpuTimingModel : public QAbstractItemModel
     QVariant headerData(int section, Qt::Orientation orientation,
                         int role = Qt::DisplayRole) const override;
 
+    // If true, the rows include draws and dispatches
+    bool HasDrawTiming() const { return m_available_gpu_timing_data.HasDrawStats(); }
+
  public slots:
     void OnGpuTimingResultsGenerated(const QString& file_path);
 
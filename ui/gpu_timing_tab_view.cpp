@@ -51,6 +51,7 @@ void GpuTimingTabView::CollectIndicesFromModel(const QAbstractItemModel& command
     {
         qDebug() << "GpuTimingTabView::CollectIndicesFromModel()";
         m_timed_event_indices.clear();
+        m_timed_event_with_draw_indices.clear();
     }
 
     for (int row = 0; row < command_hierarchy_model.rowCount(parent_index); ++row)
@@ -90,12 +91,26 @@ void GpuTimingTabView::CollectTimingIndex(Dive::NodeType node_type, const std::s
         {
             uint64_t index_address = model_index.internalId();
             m_timed_event_indices.push_back(index_address);
+            m_timed_event_with_draw_indices.push_back(index_address);
+            return;
+        }
+        case Dive::NodeType::kGfxrVulkanDrawCommandNode:  // AvailableGpuTiming::ObjectType::kDraw
+        {
+            uint64_t index_address = model_index.internalId();
+            m_timed_event_with_draw_indices.push_back(index_address);
+            return;
         }
         default:
             return;
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+const std::vector<uint64_t>& GpuTimingTabView::GetTimedEventIndices() const
+{
+    return m_model.HasDrawTiming() ? m_timed_event_with_draw_indices : m_timed_event_indices;
+}
+
 //--------------------------------------------------------------------------------------------------
 void GpuTimingTabView::ResizeColumns()
 {
@@ -118,14 +133,15 @@ int GpuTimingTabView::EventIndexToRow(const QModelIndex& model_index)
 
     uint64_t index_address = model_index.internalId();
 
+    const std::vector<uint64_t>& timed_event_indices = GetTimedEventIndices();
     const auto it =
-        std::find(m_timed_event_indices.cbegin(), m_timed_event_indices.cend(), index_address);
-    if (it == m_timed_event_indices.cend())
+        std::find(timed_event_indices.cbegin(), timed_event_indices.cend(), index_address);
+    if (it == timed_event_indices.cend())
     {
         return -1;
     }
 
-    return std::distance(m_timed_event_indices.cbegin(), it);
+    return std::distance(timed_event_indices.cbegin(), it);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -142,13 +158,13 @@ void GpuTimingTabView::OnEventSelectionChanged(const QModelIndex& model_index)
     QItemSelectionModel* selection_model = m_table_view->selectionModel();
     QSignalBlocker blocker(selection_model);
     // Verify that the number of rows in the model is consistent with the rows of
-    // m_timed_event_indices
-    if (row_count != static_cast<int>(m_timed_event_indices.size()))
+    // GetTimedEventIndices()
+    if (row_count != static_cast<int>(GetTimedEventIndices().size()))
     {
         qDebug()
             << "GpuTimingTabView::OnEventSelectionChanged() ERROR: inconsistent model row count ("
             << row_count << ") and count of collected indices of timed Vulkan events: "
-            << m_timed_event_indices.size();
+            << GetTimedEventIndices().size();
     }
 
     int row = EventIndexToRow(model_index);
@@ -168,15 +184,16 @@ void GpuTimingTabView::OnSelectionChanged(const QModelIndex& index)
     // Resize columns to fit the content
     ResizeColumns();
     int selected_row = index.row();
-    if (static_cast<size_t>(selected_row) < m_timed_event_indices.size() && selected_row >= 0)
+    const std::vector<uint64_t>& timed_event_indices = GetTimedEventIndices();
+    if (static_cast<size_t>(selected_row) < timed_event_indices.size() && selected_row >= 0)
     {
-        emit GpuTimingDataSelected(m_timed_event_indices.at(selected_row));
+        emit GpuTimingDataSelected(timed_event_indices.at(selected_row));
     }
     else
     {
         qDebug() << "GpuTimingTabView::OnSelectionChanged() ERROR: selected row (" << selected_row
                  << ") is out of range of collected indices of timed Vulkan events: "
-                 << m_timed_event_indices.size() << ". Non-gpu timed event selected.";
+                 << timed_event_indices.size() << ". Non-gpu timed event selected.";
     }
 }
 
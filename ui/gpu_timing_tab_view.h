@@ -55,7 +55,11 @@ class GpuTimingTabView : public QWidget
     void CollectTimingIndex(Dive::NodeType node_type, const std::string& node_desc,
                             const QModelIndex& model_index);
 
-    // Using m_timed_event_indices, converts Qt model index of an element to the id of the
+    // The indices matching the rows of the model, which only has rows for draws if the draws were
+    // timed
+    const std::vector<uint64_t>& GetTimedEventIndices() const;
+
+    // Using GetTimedEventIndices(), converts Qt model index of an element to the id of the
     // corresponding row in this GPU timing info table
     int EventIndexToRow(const QModelIndex& model_index);
 
@@ -69,4 +73,6 @@ class GpuTimingTabView : public QWidget
     //
     // The Qt index of all events for which there is GPU timing data
     std::vector<uint64_t> m_timed_event_indices = {};
+    // Same as m_timed_event_indices, but including the draw and dispatch events
+    std::vector<uint64_t> m_timed_event_with_draw_indices = {};
 };
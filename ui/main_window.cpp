@@ -36,6 +36,7 @@
 #include <QShortcut>
 #include <QSplitter>
 #include <QStandardItemModel>
+#include <QStandardPaths>
 #include <QStatusBar>
 #include <QTabWidget>
 #include <QTemporaryDir>
@@ -190,6 +191,15 @@ MainWindow::MainWindow(ApplicationController& controller) : m_controller(control
     m_error_dialog = new ErrorDialog(this);
 
     m_data_core = std::make_shared<Dive::DataCore>(&m_progress_tracker);
+    m_data_core->SetUseCaptureIndex(true);
+    // The arguments tab decodes the args of the selected command from the file
+    m_data_core->SetLazyGfxrCommandArgs(true);
+    QString cache_dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cache_dir.isEmpty())
+    {
+        m_data_core->SetShaderCacheDirectory((cache_dir + "/shaders").toStdString());
+        m_data_core->SetRdDecompressionCacheDirectory((cache_dir + "/captures").toStdString());
+    }
 
     m_capture_manager = new CaptureFileManager(this);
     m_capture_manager->Start(m_data_core);
@@ -454,7 +464,8 @@ MainWindow::MainWindow(ApplicationController& controller) : m_controller(control
 
         m_perf_counter_tab_view = new PerfCounterTabView(*m_perf_counter_model, this);
         m_gfxr_vulkan_command_arguments_tab_view = new GfxrVulkanCommandArgumentsTabView(
-            m_data_core->GetCommandHierarchy(), m_gfxr_vulkan_commands_arguments_filter_proxy_model,
+            *m_data_core, m_data_core->GetCommandHierarchy(),
+            m_gfxr_vulkan_commands_arguments_filter_proxy_model,
             m_gfxr_vulkan_command_hierarchy_model);
         m_gpu_timing_tab_view =
             new GpuTimingTabView(*m_gpu_timing_model, m_data_core->GetCommandHierarchy(), this);